@@ -22,6 +22,43 @@ void time_add_op() {
   }
 }
 
+// Find the size where the gpu overtakes the cpu for an op and print the
+// matching set_placement_cost call, so the placement pass (enabled with
+// MLX_COMPILE_PLACEMENT) can be calibrated for this machine.
+template <typename F>
+void find_crossover(const char* name, F op) {
+  int size = 1 << 8;
+  for (; size <= (1 << 24); size *= 2) {
+    auto a = mx::random::uniform({size});
+    auto b = mx::random::uniform({size});
+    mx::eval(a, b);
+    double cpu = time_fn(op, a, b, mx::Device::cpu);
+    double gpu = time_fn(op, a, b, mx::Device::gpu);
+    if (gpu <= cpu) {
+      break;
+    }
+  }
+  std::cout << "set_placement_cost(\"" << name << "\", " << size << ");"
+            << std::endl;
+}
+
+void time_placement_crossovers() {
+  find_crossover("Add", [](const mx::array& a, const mx::array& b, auto d) {
+    return mx::add(a, b, d);
+  });
+  find_crossover(
+      "Multiply", [](const mx::array& a, const mx::array& b, auto d) {
+        return mx::multiply(a, b, d);
+      });
+  find_crossover("Exp", [](const mx::array& a, const mx::array&, auto d) {
+    return mx::exp(a, d);
+  });
+  find_crossover("Sqrt", [](const mx::array& a, const mx::array&, auto d) {
+    return mx::sqrt(a, d);
+  });
+}
+
 int main() {
   time_add_op();
+  time_placement_crossovers();
 }
@@ -0,0 +1,357 @@
+// Copyright © 2025 Apple Inc.
+
+// Collective bring-up probe. Run one instance per node with the same
+// MLX_HOSTFILE / MLX_RANK environment the ring backend uses (mlx.launch
+// sets both). Every pair of ranks measures small message latency and
+// large message bandwidth over direct TCP connections, rank 0 gathers
+// the matrices, derives a ring permutation with a greedy
+// best-neighbor pass and emits a reordered hostfile, so cluster ring
+// order and socket tuning starts from measurements instead of guesses.
+//
+// The probe listens next to the backend's ports (first port + 1000) and
+// can run before any distributed backend is initialized.
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int PORT_OFFSET = 1000;
+constexpr int PING_ITERS = 200;
+constexpr size_t PING_SIZE = 64;
+constexpr size_t BW_SIZE = 64 * 1024 * 1024;
+
+[[noreturn]] void fail(const std::string& what) {
+  std::cerr << "[probe] " << what << " (errno " << errno << ")" << std::endl;
+  std::exit(1);
+}
+
+/** Extract the per-rank address lists from the ring hostfile. The format
+ * is a json list of lists of "ip:port" strings; this walks the brackets
+ * directly so the probe has no json dependency. */
+std::vector<std::vector<std::string>> parse_hostfile(const char* path) {
+  std::ifstream f(path);
+  if (!f.good()) {
+    fail("Couldn't open hostfile");
+  }
+  std::stringstream ss;
+  ss << f.rdbuf();
+  auto text = ss.str();
+
+  std::vector<std::vector<std::string>> nodes;
+  int depth = 0;
+  std::string current;
+  bool in_string = false;
+  for (char c : text) {
+    if (in_string) {
+      if (c == '"') {
+        in_string = false;
+        if (depth == 2) {
+          nodes.back().push_back(current);
+        }
+      } else {
+        current += c;
+      }
+    } else if (c == '"') {
+      in_string = true;
+      current.clear();
+    } else if (c == '[') {
+      if (++depth == 2) {
+        nodes.push_back({});
+      }
+    } else if (c == ']') {
+      depth--;
+    }
+  }
+  if (nodes.empty()) {
+    fail("Hostfile has no nodes");
+  }
+  return nodes;
+}
+
+std::pair<std::string, std::string> split_address(const std::string& ip_port) {
+  auto colon = ip_port.find(":");
+  if (colon == std::string::npos) {
+    fail("Can't parse address " + ip_port);
+  }
+  return {ip_port.substr(0, colon), ip_port.substr(colon + 1)};
+}
+
+int probe_port(const std::vector<std::vector<std::string>>& nodes, int rank) {
+  auto [ip, port] = split_address(nodes[rank][0]);
+  return std::atoi(port.c_str()) + PORT_OFFSET;
+}
+
+int listen_once(int port) {
+  int sock = socket(AF_INET, SOCK_STREAM, 0);
+  if (sock < 0) {
+    fail("socket");
+  }
+  int enable = 1;
+  setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(int));
+  sockaddr_in addr;
+  std::memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = INADDR_ANY;
+  addr.sin_port = htons(port);
+  if (bind(sock, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+      listen(sock, 1) < 0) {
+    fail("bind/listen");
+  }
+  int peer = accept(sock, nullptr, nullptr);
+  close(sock);
+  if (peer < 0) {
+    fail("accept");
+  }
+  return peer;
+}
+
+int connect_retry(const std::string& ip, int port) {
+  // The pairs run in a fixed global order without a barrier; retrying
+  // until the peer reaches this pair and listens provides the ordering.
+  for (int attempt = 0; attempt < 600; attempt++) {
+    int sock = socket(AF_INET, SOCK_STREAM, 0);
+    if (sock < 0) {
+      fail("socket");
+    }
+    sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    struct addrinfo hints, *res;
+    std::memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    if (getaddrinfo(ip.c_str(), nullptr, &hints, &res) == 0) {
+      addr.sin_addr = reinterpret_cast<sockaddr_in*>(res->ai_addr)->sin_addr;
+      freeaddrinfo(res);
+    }
+    if (connect(sock, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0) {
+      return sock;
+    }
+    close(sock);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+  fail("connect timed out");
+}
+
+void send_all(int sock, const char* data, size_t n) {
+  while (n > 0) {
+    ssize_t r = ::send(sock, data, n, 0);
+    if (r <= 0) {
+      fail("send");
+    }
+    data += r;
+    n -= r;
+  }
+}
+
+void recv_all(int sock, char* data, size_t n) {
+  while (n > 0) {
+    ssize_t r = ::recv(sock, data, n, 0);
+    if (r <= 0) {
+      fail("recv");
+    }
+    data += r;
+    n -= r;
+  }
+}
+
+double now() {
+  return std::chrono::duration<double>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+/** Measure RTT latency and both bandwidth directions over one connection.
+ * The side with `lead` set drives the protocol; both sides end up with
+ * (latency_us, bw_to_peer_gbps, bw_from_peer_gbps). */
+void measure(int sock, bool lead, double& lat_us, double& bw_out, double& bw_in) {
+  int one = 1;
+  setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  std::vector<char> ping(PING_SIZE, 1);
+  std::vector<char> bulk(BW_SIZE, 2);
+
+  // Ping-pong latency
+  double start = now();
+  for (int i = 0; i < PING_ITERS; i++) {
+    if (lead) {
+      send_all(sock, ping.data(), PING_SIZE);
+      recv_all(sock, ping.data(), PING_SIZE);
+    } else {
+      recv_all(sock, ping.data(), PING_SIZE);
+      send_all(sock, ping.data(), PING_SIZE);
+    }
+  }
+  lat_us = (now() - start) / PING_ITERS / 2 * 1e6;
+
+  // Bandwidth, one direction at a time with a one byte ack
+  auto timed_send = [&]() {
+    double t = now();
+    send_all(sock, bulk.data(), BW_SIZE);
+    recv_all(sock, ping.data(), 1);
+    return BW_SIZE * 8.0 / (now() - t) / 1e9;
+  };
+  auto timed_recv = [&]() {
+    double t = now();
+    recv_all(sock, bulk.data(), BW_SIZE);
+    send_all(sock, ping.data(), 1);
+    return BW_SIZE * 8.0 / (now() - t) / 1e9;
+  };
+  if (lead) {
+    bw_out = timed_send();
+    bw_in = timed_recv();
+  } else {
+    bw_in = timed_recv();
+    bw_out = timed_send();
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  const char* hostfile = std::getenv("MLX_HOSTFILE");
+  const char* rank_str = std::getenv("MLX_RANK");
+  if (!hostfile || !rank_str) {
+    std::cerr << "Usage: MLX_HOSTFILE=<file> MLX_RANK=<rank> "
+              << (argc > 0 ? argv[0] : "distributed_probe")
+              << " [output_hostfile]" << std::endl;
+    return 1;
+  }
+  auto nodes = parse_hostfile(hostfile);
+  int rank = std::atoi(rank_str);
+  int n = nodes.size();
+
+  std::vector<double> lat(n * n, 0.0), bw(n * n, 0.0);
+
+  // Every unordered pair, in a fixed global order. The lower rank
+  // listens, the higher one connects.
+  for (int i = 0; i < n; i++) {
+    for (int j = i + 1; j < n; j++) {
+      if (rank != i && rank != j) {
+        continue;
+      }
+      int sock, peer;
+      if (rank == i) {
+        sock = listen_once(probe_port(nodes, i));
+        peer = j;
+      } else {
+        auto [ip, port] = split_address(nodes[i][0]);
+        sock = connect_retry(ip, probe_port(nodes, i));
+        peer = i;
+      }
+      double l, out, in;
+      measure(sock, /* lead = */ rank == i, l, out, in);
+      lat[rank * n + peer] = l;
+      bw[rank * n + peer] = out;
+      lat[peer * n + rank] = l;
+      bw[peer * n + rank] = in;
+      close(sock);
+    }
+  }
+
+  // Rank 0 gathers every rank's rows over one more connection each.
+  if (rank != 0) {
+    auto [ip, port] = split_address(nodes[0][0]);
+    int sock = connect_retry(ip, probe_port(nodes, 0) + rank);
+    send_all(
+        sock,
+        reinterpret_cast<char*>(lat.data() + rank * n),
+        n * sizeof(double));
+    send_all(
+        sock,
+        reinterpret_cast<char*>(bw.data() + rank * n),
+        n * sizeof(double));
+    close(sock);
+    return 0;
+  }
+  for (int r = 1; r < n; r++) {
+    int sock = listen_once(probe_port(nodes, 0) + r);
+    recv_all(
+        sock, reinterpret_cast<char*>(lat.data() + r * n), n * sizeof(double));
+    recv_all(
+        sock, reinterpret_cast<char*>(bw.data() + r * n), n * sizeof(double));
+    close(sock);
+  }
+
+  std::cout << "Pairwise latency (us) / bandwidth (Gb/s):" << std::endl;
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      if (i == j) {
+        printf("      --       ");
+      } else {
+        printf("%6.1f/%-7.2f", lat[i * n + j], bw[i * n + j]);
+      }
+    }
+    printf("\n");
+  }
+
+  // Greedy ring: start at 0 and repeatedly hop to the unvisited node
+  // with the highest symmetric bandwidth from the current one. The ring
+  // all reduce is limited by its slowest link, so maximizing each hop is
+  // a good proxy for maximizing the minimum.
+  auto sym_bw = [&](int i, int j) {
+    return std::min(bw[i * n + j], bw[j * n + i]);
+  };
+  std::vector<int> order{0};
+  std::vector<bool> used(n, false);
+  used[0] = true;
+  for (int step = 1; step < n; step++) {
+    int cur = order.back();
+    int best = -1;
+    for (int j = 0; j < n; j++) {
+      if (!used[j] && (best < 0 || sym_bw(cur, j) > sym_bw(cur, best))) {
+        best = j;
+      }
+    }
+    order.push_back(best);
+    used[best] = true;
+  }
+
+  double worst = sym_bw(order.back(), order[0]);
+  for (int i = 0; i + 1 < n; i++) {
+    worst = std::min(worst, sym_bw(order[i], order[i + 1]));
+  }
+  std::cout << "\nSuggested ring order:";
+  for (auto r : order) {
+    std::cout << " " << r;
+  }
+  std::cout << "  (slowest link " << worst << " Gb/s)" << std::endl;
+
+  // Emit the reordered hostfile.
+  std::ostream* out = &std::cout;
+  std::ofstream file;
+  if (argc > 1) {
+    file.open(argv[1]);
+    out = &file;
+    std::cout << "Writing reordered hostfile to " << argv[1] << std::endl;
+  } else {
+    std::cout << "\nReordered hostfile:" << std::endl;
+  }
+  *out << "[" << std::endl;
+  for (int i = 0; i < n; i++) {
+    *out << "  [";
+    auto& addrs = nodes[order[i]];
+    for (size_t a = 0; a < addrs.size(); a++) {
+      *out << "\"" << addrs[a] << "\"" << (a + 1 < addrs.size() ? ", " : "");
+    }
+    *out << "]" << (i + 1 < n ? "," : "") << std::endl;
+  }
+  *out << "]" << std::endl;
+
+  return 0;
+}
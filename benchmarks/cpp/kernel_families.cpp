@@ -0,0 +1,237 @@
+// Copyright © 2025 Apple Inc.
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <tuple>
+#include <vector>
+
+#include "mlx/mlx.h"
+#include "time_utils.h"
+
+namespace mx = mlx::core;
+
+// Parameterized sweeps over the kernel families that regress most often.
+// Results can be written as JSON with --json and compared against a
+// previous run with --baseline, so a nightly
+//
+//   kernel_families --json today.json --baseline yesterday.json
+//
+// fails with the offending benchmarks when any of them slows down by more
+// than --threshold percent (default 20).
+
+struct Result {
+  std::string name;
+  double msec;
+};
+
+std::vector<Result>& results() {
+  static std::vector<Result> results_;
+  return results_;
+}
+
+template <typename F>
+void bench(const std::string& name, F fn) {
+  double msec = time_fn(fn);
+  std::cout << "Timing " << name << " ... " << std::setprecision(5) << msec
+            << " msec" << std::endl;
+  results().push_back({name, msec});
+}
+
+std::string dtype_name(mx::Dtype dtype) {
+  std::ostringstream os;
+  os << dtype;
+  return os.str();
+}
+
+void time_reductions() {
+  int M = 4096;
+  int N = 4096;
+  for (auto dtype : {mx::float32, mx::float16, mx::int32}) {
+    auto a = mx::astype(mx::random::uniform({M, N}), dtype);
+    mx::eval(a);
+    for (int axis : {0, 1}) {
+      std::ostringstream tag;
+      tag << dtype_name(dtype) << "/axis" << axis;
+      bench("sum/" + tag.str(), [&, axis]() { return mx::sum(a, axis); });
+      bench("max/" + tag.str(), [&, axis]() { return mx::max(a, axis); });
+      bench("argmax/" + tag.str(), [&, axis]() {
+        return mx::argmax(a, axis);
+      });
+    }
+    bench("sum/" + dtype_name(dtype) + "/all", [&]() { return mx::sum(a); });
+    bench("mean/" + dtype_name(dtype) + "/all", [&]() { return mx::mean(a); });
+  }
+}
+
+void time_indexing() {
+  int M = 1 << 20;
+  int N = 64;
+  auto a = mx::random::uniform({M, N});
+  auto idx = mx::random::randint(0, M, {M / 4});
+  auto updates = mx::random::uniform({M / 4, 1, N});
+  mx::eval(a, idx, updates);
+
+  bench("take/axis0", [&]() { return mx::take(a, idx, 0); });
+  bench("gather/rows", [&]() {
+    return mx::gather(a, {idx}, {0}, {1, N});
+  });
+  bench("scatter_add/rows", [&]() {
+    return mx::scatter_add(a, idx, updates, 0);
+  });
+  auto sorted_ids = mx::sort(mx::random::randint(0, 1024, {M}));
+  mx::eval(sorted_ids);
+  bench("segment_sum/rows", [&]() {
+    return mx::segment_sum(a, sorted_ids, 1024);
+  });
+}
+
+void time_sort_topk() {
+  for (int n : {1 << 14, 1 << 18}) {
+    auto a = mx::random::uniform({16, n});
+    mx::eval(a);
+    std::string tag = "/n" + std::to_string(n);
+    bench("sort" + tag, [&]() { return mx::sort(a, -1); });
+    bench("argsort" + tag, [&]() { return mx::argsort(a, -1); });
+    bench("topk50" + tag, [&]() { return mx::topk(a, 50, -1); });
+    bench("partition50" + tag, [&]() { return mx::partition(a, -50, -1); });
+  }
+}
+
+void time_sdpa() {
+  int D = 128;
+  for (auto [B, H, L] : std::vector<std::tuple<int, int, int>>{
+           {1, 32, 1}, {1, 32, 512}, {4, 32, 2048}}) {
+    auto q = mx::random::uniform({B, H, L, D}, mx::float16);
+    auto k = mx::random::uniform({B, H, 2048, D}, mx::float16);
+    auto v = mx::random::uniform({B, H, 2048, D}, mx::float16);
+    mx::eval(q, k, v);
+    float scale = 1.0f / std::sqrt(static_cast<float>(D));
+    std::ostringstream tag;
+    tag << "sdpa/b" << B << "_h" << H << "_l" << L;
+    bench(tag.str(), [&]() {
+      return mx::fast::scaled_dot_product_attention(q, k, v, scale);
+    });
+  }
+}
+
+void time_quantized_matmul() {
+  int M = 4096;
+  int N = 4096;
+  auto w = mx::random::uniform({M, N});
+  mx::eval(w);
+  for (int bits : {4, 8}) {
+    auto wq = mx::quantize(w, /* group_size = */ 64, bits);
+    for (int L : {1, 512}) {
+      auto x = mx::random::uniform({L, N}, mx::float16);
+      mx::eval(x, wq[0], wq[1], wq[2]);
+      std::ostringstream tag;
+      tag << "qmm/b" << bits << "_l" << L;
+      bench(tag.str(), [&]() {
+        return mx::quantized_matmul(
+            x, wq[0], wq[1], wq[2], /* transpose = */ true, 64, bits);
+      });
+    }
+  }
+}
+
+void write_json(const std::string& file) {
+  std::ofstream f(file);
+  if (!f.is_open()) {
+    std::cerr << "Unable to open " << file << " for writing." << std::endl;
+    std::exit(1);
+  }
+  f << "{\"benchmarks\":[\n";
+  for (size_t i = 0; i < results().size(); ++i) {
+    auto& r = results()[i];
+    f << "  {\"name\":\"" << r.name << "\",\"msec\":" << std::setprecision(8)
+      << r.msec << "}" << (i + 1 < results().size() ? "," : "") << "\n";
+  }
+  f << "]}\n";
+}
+
+// Parse a file written by write_json above: one benchmark per line
+std::vector<Result> read_json(const std::string& file) {
+  std::ifstream f(file);
+  if (!f.is_open()) {
+    std::cerr << "Unable to open baseline " << file << "." << std::endl;
+    std::exit(1);
+  }
+  std::vector<Result> baseline;
+  std::string line;
+  while (std::getline(f, line)) {
+    auto name_pos = line.find("\"name\":\"");
+    auto msec_pos = line.find("\"msec\":");
+    if (name_pos == std::string::npos || msec_pos == std::string::npos) {
+      continue;
+    }
+    name_pos += std::strlen("\"name\":\"");
+    auto name_end = line.find('"', name_pos);
+    msec_pos += std::strlen("\"msec\":");
+    baseline.push_back(
+        {line.substr(name_pos, name_end - name_pos),
+         std::stod(line.substr(msec_pos))});
+  }
+  return baseline;
+}
+
+int check_regressions(const std::string& file, double threshold_pct) {
+  auto baseline = read_json(file);
+  int regressions = 0;
+  for (auto& r : results()) {
+    for (auto& b : baseline) {
+      if (b.name != r.name) {
+        continue;
+      }
+      if (r.msec > b.msec * (1.0 + threshold_pct / 100.0)) {
+        std::cout << "REGRESSION " << r.name << ": " << std::setprecision(5)
+                  << b.msec << " -> " << r.msec << " msec" << std::endl;
+        regressions++;
+      }
+      break;
+    }
+  }
+  if (regressions == 0) {
+    std::cout << "No regressions above " << threshold_pct << "%" << std::endl;
+  }
+  return regressions;
+}
+
+int main(int argc, char** argv) {
+  std::string json_file;
+  std::string baseline_file;
+  double threshold_pct = 20.0;
+  for (int i = 1; i < argc; ++i) {
+    if (!std::strcmp(argv[i], "--json") && i + 1 < argc) {
+      json_file = argv[++i];
+    } else if (!std::strcmp(argv[i], "--baseline") && i + 1 < argc) {
+      baseline_file = argv[++i];
+    } else if (!std::strcmp(argv[i], "--threshold") && i + 1 < argc) {
+      threshold_pct = std::stod(argv[++i]);
+    } else if (!std::strcmp(argv[i], "cpu")) {
+      mx::set_default_device(mx::Device::cpu);
+    } else if (!std::strcmp(argv[i], "gpu")) {
+      mx::set_default_device(mx::Device::gpu);
+    } else {
+      std::cerr << "Usage: " << argv[0]
+                << " [cpu|gpu] [--json FILE] [--baseline FILE]"
+                << " [--threshold PCT]" << std::endl;
+      return 1;
+    }
+  }
+
+  time_reductions();
+  time_indexing();
+  time_sort_topk();
+  time_sdpa();
+  time_quantized_matmul();
+
+  if (!json_file.empty()) {
+    write_json(json_file);
+  }
+  if (!baseline_file.empty()) {
+    return check_regressions(baseline_file, threshold_pct) > 0;
+  }
+  return 0;
+}
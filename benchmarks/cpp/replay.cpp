@@ -0,0 +1,92 @@
+// Copyright © 2025 Apple Inc.
+
+#include <cstring>
+#include <vector>
+
+#include "mlx/mlx.h"
+#include "time_utils.h"
+
+namespace mx = mlx::core;
+
+// Replay a function exported with mx::export_function (or mx::exporter)
+// using synthetic inputs, re-executing it N times with per-iteration
+// timing. Capture a repro in the serving stack with
+//
+//   mx::export_function("repro.mlxfn", fun, args);
+//
+// and hand over the file; replaying it needs nothing but
+//
+//   replay repro.mlxfn [-n ITERS] [cpu|gpu]
+//
+// The exported format carries shapes, dtypes and the stream assignment
+// of every primitive, so scheduling pathologies reproduce as recorded.
+
+mx::array synthesize(const mx::Shape& shape, mx::Dtype dtype) {
+  if (mx::issubdtype(dtype, mx::floating)) {
+    return mx::astype(mx::random::normal(shape), dtype);
+  } else if (dtype == mx::bool_) {
+    return mx::astype(mx::random::bernoulli(0.5, shape), mx::bool_);
+  }
+  return mx::astype(mx::random::randint(0, 2, shape), dtype);
+}
+
+int main(int argc, char** argv) {
+  std::string file;
+  int iters = 100;
+  for (int i = 1; i < argc; ++i) {
+    if (!std::strcmp(argv[i], "-n") && i + 1 < argc) {
+      iters = std::atoi(argv[++i]);
+    } else if (!std::strcmp(argv[i], "cpu")) {
+      mx::set_default_device(mx::Device::cpu);
+    } else if (!std::strcmp(argv[i], "gpu")) {
+      mx::set_default_device(mx::Device::gpu);
+    } else if (file.empty()) {
+      file = argv[i];
+    } else {
+      file.clear();
+      break;
+    }
+  }
+  if (file.empty()) {
+    std::cerr << "Usage: " << argv[0] << " FILE [-n ITERS] [cpu|gpu]"
+              << std::endl;
+    return 1;
+  }
+
+  auto fun = mx::import_function(file);
+  auto specs = fun.input_specs();
+  if (specs.empty()) {
+    std::cerr << "No traces found in " << file << "." << std::endl;
+    return 1;
+  }
+
+  // Replay the first exported trace
+  std::vector<mx::array> inputs;
+  std::cout << "Inputs:" << std::endl;
+  for (auto& [shape, dtype] : specs[0]) {
+    std::cout << "  " << shape << " " << dtype << std::endl;
+    inputs.push_back(synthesize(shape, dtype));
+  }
+  mx::eval(inputs);
+
+  // Warmup
+  for (int i = 0; i < 5; ++i) {
+    mx::eval(fun(inputs));
+  }
+
+  double total = 0;
+  double best = 0;
+  double worst = 0;
+  for (int i = 0; i < iters; ++i) {
+    auto start = time_now();
+    mx::eval(fun(inputs));
+    double msec = milliseconds(time_now() - start);
+    total += msec;
+    best = (i == 0) ? msec : std::min(best, msec);
+    worst = std::max(worst, msec);
+  }
+  std::cout << std::setprecision(5) << "Replayed " << iters << " iterations: "
+            << "mean " << total / iters << " msec, min " << best
+            << " msec, max " << worst << " msec" << std::endl;
+  return 0;
+}
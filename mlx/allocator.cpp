@@ -1,24 +1,358 @@
 // Copyright © 2023 Apple Inc.
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstdlib>
+#include <fstream>
+#include <map>
+#include <mutex>
 #include <sstream>
+#include <unordered_map>
 
 #include "mlx/allocator.h"
+#include "mlx/memory.h"
 
 namespace mlx::core::allocator {
 
+namespace {
+
+// Accumulated allocation telemetry keyed on (primitive name, stream).
+// Primitive names are static strings so the pointer identifies the site.
+struct Telemetry {
+  std::atomic<bool> enabled{false};
+  std::mutex mtx;
+  std::map<std::pair<const void*, uint32_t>, AllocationSite> sites;
+
+  void record(const char* primitive, uint32_t stream, size_t bytes) {
+    std::lock_guard<std::mutex> lk(mtx);
+    auto& site =
+        sites[{static_cast<const void*>(primitive), stream}];
+    if (site.count == 0) {
+      site.primitive = primitive ? primitive : "<unattributed>";
+      site.stream = stream;
+    }
+    site.bytes += bytes;
+    site.count++;
+  }
+};
+
+Telemetry& telemetry() {
+  static Telemetry telemetry_;
+  return telemetry_;
+}
+
+// Ordered allocation/free events so the live set at any point — the peak
+// in particular — can be reconstructed after the fact.
+struct Timeline {
+  std::atomic<bool> enabled{false};
+  std::chrono::steady_clock::time_point origin{
+      std::chrono::steady_clock::now()};
+  std::mutex mtx;
+  std::vector<MemoryEvent> events;
+  // Buffer pointer to the index of its allocation event
+  std::unordered_map<uintptr_t, size_t> live;
+  size_t active_bytes{0};
+
+  uint64_t now_us() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now() - origin)
+        .count();
+  }
+
+  void record_alloc(
+      void* ptr,
+      size_t bytes,
+      const char* primitive,
+      uint32_t stream) {
+    std::lock_guard<std::mutex> lk(mtx);
+    active_bytes += bytes;
+    live[reinterpret_cast<uintptr_t>(ptr)] = events.size();
+    events.push_back(
+        {primitive ? primitive : "<unattributed>",
+         stream,
+         now_us(),
+         reinterpret_cast<uintptr_t>(ptr),
+         bytes,
+         /* is_free = */ false,
+         active_bytes});
+  }
+
+  void record_free(void* ptr) {
+    std::lock_guard<std::mutex> lk(mtx);
+    auto it = live.find(reinterpret_cast<uintptr_t>(ptr));
+    if (it == live.end()) {
+      // Allocated before recording started
+      return;
+    }
+    auto& alloc = events[it->second];
+    active_bytes -= alloc.bytes;
+    events.push_back(
+        {alloc.primitive,
+         alloc.stream,
+         now_us(),
+         alloc.buffer,
+         alloc.bytes,
+         /* is_free = */ true,
+         active_bytes});
+    live.erase(it);
+  }
+};
+
+Timeline& timeline() {
+  static Timeline timeline_;
+  return timeline_;
+}
+
+// Named memory groups (see ScopedMemoryGroup in mlx/memory.h). Buffers
+// allocated while a group is active on the thread stay accounted to it
+// until they are freed.
+struct MemoryGroups {
+  std::mutex mtx;
+  std::unordered_map<std::string, std::pair<size_t, size_t>> groups;
+  // Owning group of every live accounted buffer; the count lets free
+  // skip the map lookup when no buffer is accounted to any group
+  std::unordered_map<const void*, std::string> owners;
+  std::atomic<size_t> owner_count{0};
+};
+
+MemoryGroups& memory_groups() {
+  static MemoryGroups groups_;
+  return groups_;
+}
+
+thread_local const char* tl_site_primitive = nullptr;
+thread_local uint32_t tl_site_stream = 0;
+
+// Memory group active on this thread; empty means unaccounted
+thread_local std::string tl_memory_group;
+
+// Depth of nested ScopedWired guards on this thread
+thread_local int tl_wired_depth = 0;
+
+} // namespace
+
+ScopedWired::ScopedWired() {
+  tl_wired_depth++;
+}
+
+ScopedWired::~ScopedWired() {
+  tl_wired_depth--;
+}
+
+void set_allocation_site(const char* primitive, uint32_t stream_index) {
+  tl_site_primitive = primitive;
+  tl_site_stream = stream_index;
+}
+
+bool allocation_telemetry_enabled() {
+  return telemetry().enabled.load(std::memory_order_relaxed);
+}
+
 Buffer malloc(size_t size) {
-  auto buffer = allocator().malloc(size);
+  auto buffer = tl_wired_depth > 0 ? allocator().malloc_wired(size)
+                                   : allocator().malloc(size);
   if (size && !buffer.ptr()) {
     std::ostringstream msg;
     msg << "[malloc] Unable to allocate " << size << " bytes.";
     throw std::runtime_error(msg.str());
   }
+  if (size && allocation_telemetry_enabled()) {
+    telemetry().record(
+        tl_site_primitive, tl_site_stream, allocator().size(buffer));
+  }
+  if (size && timeline().enabled.load(std::memory_order_relaxed)) {
+    timeline().record_alloc(
+        buffer.ptr(), allocator().size(buffer), tl_site_primitive, tl_site_stream);
+  }
+  if (size && !tl_memory_group.empty()) {
+    auto& groups = memory_groups();
+    bool over_budget = false;
+    {
+      std::lock_guard<std::mutex> lk(groups.mtx);
+      auto& [limit, active] = groups.groups[tl_memory_group];
+      active += allocator().size(buffer);
+      groups.owners.emplace(buffer.ptr(), tl_memory_group);
+      groups.owner_count.fetch_add(1, std::memory_order_release);
+      over_budget = limit > 0 && active > limit;
+    }
+    // An over-budget group gives the cached buffers back to the system so
+    // its overflow costs itself recycling misses rather than squeezing
+    // the other groups through the global gc limit
+    if (over_budget && get_cache_memory() > 0) {
+      clear_cache();
+    }
+  }
   return buffer;
 }
 
 void free(Buffer buffer) {
+  if (buffer.ptr() && timeline().enabled.load(std::memory_order_relaxed)) {
+    timeline().record_free(buffer.ptr());
+  }
+  if (buffer.ptr() &&
+      memory_groups().owner_count.load(std::memory_order_acquire) > 0) {
+    auto& groups = memory_groups();
+    std::lock_guard<std::mutex> lk(groups.mtx);
+    if (auto it = groups.owners.find(buffer.ptr()); it != groups.owners.end()) {
+      auto& [limit, active] = groups.groups[it->second];
+      active -= std::min(active, allocator().size(buffer));
+      groups.owners.erase(it);
+      groups.owner_count.fetch_sub(1, std::memory_order_release);
+    }
+  }
   allocator().free(buffer);
 }
 
+Buffer malloc_wired(size_t size) {
+  auto buffer = allocator().malloc_wired(size);
+  if (size && !buffer.ptr()) {
+    std::ostringstream msg;
+    msg << "[malloc_wired] Unable to allocate " << size << " bytes.";
+    throw std::runtime_error(msg.str());
+  }
+  return buffer;
+}
+
+Buffer wrap_external(void* ptr, size_t size) {
+  auto buffer = allocator().wrap_external(ptr, size);
+  if (size && !buffer.ptr()) {
+    std::ostringstream msg;
+    msg << "[wrap_external] Unable to wrap " << size << " bytes.";
+    throw std::runtime_error(msg.str());
+  }
+  return buffer;
+}
+
 } // namespace mlx::core::allocator
+
+namespace mlx::core {
+
+ScopedMemoryGroup::ScopedMemoryGroup(const std::string& name) {
+  previous_ = std::move(allocator::tl_memory_group);
+  allocator::tl_memory_group = name;
+}
+
+ScopedMemoryGroup::~ScopedMemoryGroup() {
+  allocator::tl_memory_group = std::move(previous_);
+}
+
+size_t set_memory_group_limit(const std::string& name, size_t limit) {
+  auto& groups = allocator::memory_groups();
+  std::lock_guard<std::mutex> lk(groups.mtx);
+  auto& group = groups.groups[name];
+  std::swap(limit, group.first);
+  return limit;
+}
+
+size_t get_memory_group_active(const std::string& name) {
+  auto& groups = allocator::memory_groups();
+  std::lock_guard<std::mutex> lk(groups.mtx);
+  if (auto it = groups.groups.find(name); it != groups.groups.end()) {
+    return it->second.second;
+  }
+  return 0;
+}
+
+void enable_allocation_telemetry(bool enable) {
+  allocator::telemetry().enabled.store(enable, std::memory_order_relaxed);
+}
+
+std::vector<AllocationSite> allocation_telemetry_snapshot() {
+  auto& t = allocator::telemetry();
+  std::vector<AllocationSite> out;
+  {
+    std::lock_guard<std::mutex> lk(t.mtx);
+    out.reserve(t.sites.size());
+    for (auto& [key, site] : t.sites) {
+      out.push_back(site);
+    }
+  }
+  std::sort(out.begin(), out.end(), [](const auto& a, const auto& b) {
+    return a.bytes > b.bytes;
+  });
+  return out;
+}
+
+void clear_allocation_telemetry() {
+  auto& t = allocator::telemetry();
+  std::lock_guard<std::mutex> lk(t.mtx);
+  t.sites.clear();
+}
+
+void enable_memory_timeline(bool enable /* = true */) {
+  allocator::timeline().enabled.store(enable, std::memory_order_relaxed);
+}
+
+std::vector<MemoryEvent> memory_timeline_snapshot() {
+  auto& t = allocator::timeline();
+  std::lock_guard<std::mutex> lk(t.mtx);
+  return t.events;
+}
+
+void clear_memory_timeline() {
+  auto& t = allocator::timeline();
+  std::lock_guard<std::mutex> lk(t.mtx);
+  t.events.clear();
+  t.live.clear();
+  t.active_bytes = 0;
+}
+
+std::vector<AllocationSite> live_set_at_peak() {
+  auto events = memory_timeline_snapshot();
+
+  // The peak is the event with the highest running total; everything
+  // allocated at or before it and not yet freed was live at the peak.
+  size_t peak = 0;
+  for (size_t i = 0; i < events.size(); ++i) {
+    if (events[i].active_bytes > events[peak].active_bytes) {
+      peak = i;
+    }
+  }
+
+  std::map<std::pair<std::string, uint32_t>, AllocationSite> sites;
+  std::unordered_map<std::uintptr_t, size_t> live;
+  for (size_t i = 0; i < events.size() && i <= peak; ++i) {
+    if (events[i].is_free) {
+      live.erase(events[i].buffer);
+    } else {
+      live[events[i].buffer] = i;
+    }
+  }
+  for (auto& [buffer, i] : live) {
+    auto& event = events[i];
+    auto& site = sites[{event.primitive, event.stream}];
+    if (site.count == 0) {
+      site.primitive = event.primitive;
+      site.stream = event.stream;
+    }
+    site.bytes += event.bytes;
+    site.count++;
+  }
+
+  std::vector<AllocationSite> out;
+  out.reserve(sites.size());
+  for (auto& [key, site] : sites) {
+    out.push_back(site);
+  }
+  std::sort(out.begin(), out.end(), [](const auto& a, const auto& b) {
+    return a.bytes > b.bytes;
+  });
+  return out;
+}
+
+void write_memory_flamegraph(const std::string& file) {
+  std::ofstream os(file);
+  if (!os.good()) {
+    std::ostringstream msg;
+    msg << "[write_memory_flamegraph] Unable to open " << file
+        << " for writing.";
+    throw std::runtime_error(msg.str());
+  }
+  for (auto& site : live_set_at_peak()) {
+    os << "stream_" << site.stream << ";" << site.primitive << " "
+       << site.bytes << "\n";
+  }
+}
+
+} // namespace mlx::core
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <cstdlib>
 
 namespace mlx::core::allocator {
@@ -32,12 +33,58 @@ Buffer malloc(size_t size);
 
 void free(Buffer buffer);
 
+/**
+ * Wrap an external allocation in a Buffer without copying.
+ *
+ * The memory stays owned by the caller and must outlive the buffer;
+ * freeing the buffer through the allocator releases only the wrapper's
+ * bookkeeping. Wrapped buffers are never recycled into the buffer cache.
+ * Alignment requirements are backend specific: the Metal backend requires
+ * a page aligned pointer (e.g. an mmap'd region) so the memory can back an
+ * MTL::Buffer with no copy.
+ */
+Buffer wrap_external(void* ptr, size_t size);
+
+/**
+ * Allocate a buffer from the wired allocation class.
+ *
+ * Wired buffers are meant for long-lived data such as model weights: they
+ * are backed by large pages where the platform supports it, pinned so they
+ * are not evicted under memory pressure (mlock on CPU, the residency set
+ * on Metal, a device-preferred-location advise on CUDA), and they are
+ * never recycled through the buffer cache. Pinning is best effort and may
+ * be capped by system limits.
+ */
+Buffer malloc_wired(size_t size);
+
+/**
+ * While alive, allocations made on the calling thread go through
+ * malloc_wired. Wrap the eval that materializes long-lived arrays:
+ *
+ *   { ScopedWired wired; eval(weights); }
+ */
+struct ScopedWired {
+  ScopedWired();
+  ~ScopedWired();
+};
+
+// Label allocations made on the calling thread with the primitive and
+// stream being evaluated; used by eval while allocation telemetry is
+// enabled. Pass nullptr to clear the label.
+void set_allocation_site(const char* primitive, uint32_t stream_index);
+
+// True while allocation telemetry is enabled (see
+// enable_allocation_telemetry in mlx/memory.h).
+bool allocation_telemetry_enabled();
+
 class Allocator {
   /** Abstract base class for a memory allocator. */
  public:
   virtual Buffer malloc(size_t size) = 0;
   virtual void free(Buffer buffer) = 0;
   virtual size_t size(Buffer buffer) const = 0;
+  virtual Buffer wrap_external(void* ptr, size_t size) = 0;
+  virtual Buffer malloc_wired(size_t size) = 0;
 
   Allocator() = default;
   Allocator(const Allocator& other) = delete;
@@ -1,5 +1,6 @@
 // Copyright © 2023-2024 Apple Inc.
 #include <functional>
+#include <mutex>
 #include <unordered_map>
 
 #include "mlx/array.h"
@@ -10,8 +11,105 @@
 
 namespace mlx::core {
 
+namespace {
+
+// std::allocate_shared packs the control block and the ArrayDesc into one
+// fixed-size node. Recycle those nodes through a free list carved from
+// larger slabs so that steady-state graph construction (build, eval, drop,
+// rebuild every step) does not touch malloc: a released node is handed
+// straight to the next array built.
+class DescNodePool {
+ public:
+  void* alloc(size_t size) {
+    std::lock_guard<std::mutex> lk(mtx_);
+    if (node_size_ == 0) {
+      node_size_ = size;
+    }
+    if (size != node_size_) {
+      return ::operator new(size);
+    }
+    if (free_list_.empty()) {
+      auto slab =
+          static_cast<char*>(::operator new(node_size_ * nodes_per_slab));
+      free_list_.reserve(free_list_.size() + nodes_per_slab);
+      for (int i = 0; i < nodes_per_slab; ++i) {
+        free_list_.push_back(slab + i * node_size_);
+      }
+    }
+    auto p = free_list_.back();
+    free_list_.pop_back();
+    return p;
+  }
+
+  void release(void* p, size_t size) {
+    std::lock_guard<std::mutex> lk(mtx_);
+    if (size != node_size_) {
+      ::operator delete(p);
+      return;
+    }
+    free_list_.push_back(static_cast<char*>(p));
+  }
+
+ private:
+  static constexpr int nodes_per_slab = 1024;
+  std::mutex mtx_;
+  size_t node_size_{0};
+  std::vector<char*> free_list_;
+};
+
+DescNodePool& desc_pool() {
+  // Intentionally leaked: arrays held by scheduler threads can be released
+  // during static destruction
+  static DescNodePool* pool = new DescNodePool();
+  return *pool;
+}
+
+template <typename T>
+struct DescAllocator {
+  using value_type = T;
+  DescAllocator() = default;
+  template <typename U>
+  DescAllocator(const DescAllocator<U>&) {}
+  T* allocate(size_t n) {
+    return static_cast<T*>(desc_pool().alloc(n * sizeof(T)));
+  }
+  void deallocate(T* p, size_t n) {
+    desc_pool().release(p, n * sizeof(T));
+  }
+  template <typename U>
+  bool operator==(const DescAllocator<U>&) const {
+    return true;
+  }
+  template <typename U>
+  bool operator!=(const DescAllocator<U>&) const {
+    return false;
+  }
+};
+
+} // namespace
+
+std::shared_ptr<array::ArrayDesc> array::ArrayDesc::alloc(
+    Shape shape,
+    Dtype dtype) {
+  return std::allocate_shared<ArrayDesc>(
+      DescAllocator<ArrayDesc>{}, std::move(shape), dtype);
+}
+
+std::shared_ptr<array::ArrayDesc> array::ArrayDesc::alloc(
+    Shape shape,
+    Dtype dtype,
+    std::shared_ptr<Primitive> primitive,
+    std::vector<array> inputs) {
+  return std::allocate_shared<ArrayDesc>(
+      DescAllocator<ArrayDesc>{},
+      std::move(shape),
+      dtype,
+      std::move(primitive),
+      std::move(inputs));
+}
+
 array::array(const std::complex<float>& val, Dtype dtype /* = complex64 */)
-    : array_desc_(std::make_shared<ArrayDesc>(Shape{}, dtype)) {
+    : array_desc_(ArrayDesc::alloc(Shape{}, dtype)) {
   auto cval = static_cast<complex64_t>(val);
   init(&cval);
 }
@@ -21,7 +119,7 @@ array::array(
     Dtype dtype,
     std::shared_ptr<Primitive> primitive,
     std::vector<array> inputs)
-    : array_desc_(std::make_shared<ArrayDesc>(
+    : array_desc_(ArrayDesc::alloc(
           std::move(shape),
           dtype,
           std::move(primitive),
@@ -69,14 +167,14 @@ array array::unsafe_weak_copy(const array& other) {
 }
 
 array::array(std::initializer_list<float> data)
-    : array_desc_(std::make_shared<ArrayDesc>(
+    : array_desc_(ArrayDesc::alloc(
           Shape{static_cast<ShapeElem>(data.size())},
           float32)) {
   init(data.begin());
 }
 
 array::array(std::initializer_list<int> data, Dtype dtype)
-    : array_desc_(std::make_shared<ArrayDesc>(
+    : array_desc_(ArrayDesc::alloc(
           Shape{static_cast<ShapeElem>(data.size())},
           dtype)) {
   init(data.begin());
@@ -84,7 +182,7 @@ array::array(std::initializer_list<int> data, Dtype dtype)
 
 /* Build an array from a shared buffer */
 array::array(allocator::Buffer data, Shape shape, Dtype dtype, Deleter deleter)
-    : array_desc_(std::make_shared<ArrayDesc>(std::move(shape), dtype)) {
+    : array_desc_(ArrayDesc::alloc(std::move(shape), dtype)) {
   set_data(data, deleter);
 }
 
@@ -149,6 +247,16 @@ void array::set_data(allocator::Buffer buffer, Deleter d) {
   array_desc_->flags.col_contiguous = size() <= 1 || size() == *max_dim;
 }
 
+void array::set_data_shared(std::shared_ptr<Data> data) {
+  array_desc_->data_ptr = data->buffer.raw_ptr();
+  array_desc_->data = std::move(data);
+  array_desc_->data_size = size();
+  array_desc_->flags.contiguous = true;
+  array_desc_->flags.row_contiguous = true;
+  auto max_dim = std::max_element(shape().begin(), shape().end());
+  array_desc_->flags.col_contiguous = size() <= 1 || size() == *max_dim;
+}
+
 void array::set_data(
     allocator::Buffer buffer,
     size_t data_size,
@@ -247,6 +355,66 @@ array::ArrayDesc::ArrayDesc(
   init();
 }
 
+namespace {
+
+// With MLX_ASYNC_TEARDOWN set, dead ArrayDesc chains are handed to this
+// recycler and destroyed on a background thread instead of inline when the
+// last array reference drops, so tearing down a large evaluated graph does
+// not stall the dispatching thread. The recycler thread tears chains down
+// with the same iterative walk as the inline path (flagged through
+// inline_teardown below), so sibling cycles are still broken correctly.
+template <typename T>
+class DescRecycler {
+ public:
+  static DescRecycler& instance() {
+    // Intentionally leaked so chains released during static destruction
+    // still have somewhere to go; the thread is never joined.
+    static DescRecycler* recycler = new DescRecycler();
+    return *recycler;
+  }
+
+  static bool& inline_teardown() {
+    thread_local bool inline_teardown_ = false;
+    return inline_teardown_;
+  }
+
+  void recycle(std::vector<std::shared_ptr<T>> descs) {
+    {
+      std::lock_guard<std::mutex> lk(mtx_);
+      queue_.insert(
+          queue_.end(),
+          std::make_move_iterator(descs.begin()),
+          std::make_move_iterator(descs.end()));
+    }
+    cond_.notify_one();
+  }
+
+ private:
+  DescRecycler() : thread_(&DescRecycler::run, this) {}
+
+  void run() {
+    inline_teardown() = true;
+    while (true) {
+      std::vector<std::shared_ptr<T>> batch;
+      {
+        std::unique_lock<std::mutex> lk(mtx_);
+        cond_.wait(lk, [this] { return !queue_.empty(); });
+        batch = std::move(queue_);
+        queue_.clear();
+      }
+      // Dropping the batch runs the iterative teardown in ~ArrayDesc
+      batch.clear();
+    }
+  }
+
+  std::mutex mtx_;
+  std::condition_variable cond_;
+  std::vector<std::shared_ptr<T>> queue_;
+  std::thread thread_;
+};
+
+} // namespace
+
 array::ArrayDesc::~ArrayDesc() {
   // When an array description is destroyed it will delete a bunch of arrays
   // that may also destroy their corresponding descriptions and so on and so
@@ -293,6 +461,12 @@ array::ArrayDesc::~ArrayDesc() {
 
   append_deletable_inputs(*this);
 
+  if (env::async_teardown() && !DescRecycler<ArrayDesc>::inline_teardown() &&
+      !for_deletion.empty()) {
+    DescRecycler<ArrayDesc>::instance().recycle(std::move(for_deletion));
+    return;
+  }
+
   while (!for_deletion.empty()) {
     // top is going to be deleted at the end of the block *after* the arrays
     // with inputs have been moved into the vector
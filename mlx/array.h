@@ -220,12 +220,15 @@ class array {
   struct Data {
     allocator::Buffer buffer;
     Deleter d;
+    // False when the buffer aliases externally owned memory (see
+    // allocator::wrap_external) which must never be reused for outputs
+    bool donatable{true};
     Data(allocator::Buffer buffer, Deleter d = allocator::free)
         : buffer(buffer), d(d) {}
     // Not copyable
     Data(const Data& d) = delete;
     Data& operator=(const Data& d) = delete;
-    Data(Data&& o) : buffer(o.buffer), d(o.d) {
+    Data(Data&& o) : buffer(o.buffer), d(o.d), donatable(o.donatable) {
       o.buffer = allocator::Buffer(nullptr);
       o.d = [](allocator::Buffer) {};
     }
@@ -281,7 +284,45 @@ class array {
 
   /** True indicates the arrays buffer is safe to reuse */
   bool is_donatable() const {
-    return array_desc_.use_count() == 1 && (array_desc_->data.use_count() == 1);
+    auto extra = array_desc_->consumable ? 1 : 0;
+    return array_desc_.use_count() <= 1 + extra &&
+        (array_desc_->data.use_count() == 1) && array_desc_->data->donatable;
+  }
+
+  /**
+   * Mark the array as consumable so its buffer can be donated even though
+   * the caller still holds a handle to it.
+   *
+   * Donation normally requires the runtime's reference to be the only one,
+   * which can never hold for arrays kept across eval boundaries (e.g.
+   * optimizer state fed into the next step). Marking such an array
+   * consumable forgives exactly one external handle when checking
+   * donatability. The caller promises to keep a single handle and to not
+   * read the array's data after it has been consumed; doing either is
+   * undefined behavior. Assigning a new array to the handle is fine.
+   */
+  void set_consumable(bool consumable = true) {
+    array_desc_->consumable = consumable;
+  }
+
+  /** True if the array was marked consumable. */
+  bool is_consumable() const {
+    return array_desc_->consumable;
+  }
+
+  /**
+   * Mark the underlying buffer as aliasing externally owned memory so it
+   * is never donated to an op's output. The mark lives on the data, so
+   * views made with copy_shared_buffer inherit it. Only valid once the
+   * array has data.
+   */
+  void set_data_not_donatable() {
+    array_desc_->data->donatable = false;
+  }
+
+  /** The number of references to this array's graph node. */
+  long use_count() const {
+    return array_desc_.use_count();
   }
 
   /** The array's siblings. */
@@ -414,6 +455,10 @@ class array {
 
   void set_data(allocator::Buffer buffer, Deleter d = allocator::free);
 
+  /** Set the data to an existing data buffer shared with another array.
+   * The buffer must hold this array's size laid out row contiguously. */
+  void set_data_shared(std::shared_ptr<Data> data);
+
   void set_data(
       allocator::Buffer buffer,
       size_t data_size,
@@ -457,6 +502,10 @@ class array {
     // and should not be detached from the graph
     bool is_tracer{false};
 
+    // Indicates the holder of an external handle allows the buffer to be
+    // donated (see set_consumable)
+    bool consumable{false};
+
     // This is a shared pointer so that *different* arrays
     // can share the underlying data buffer.
     std::shared_ptr<Data> data;
@@ -487,6 +536,16 @@ class array {
 
     ~ArrayDesc();
 
+    // Make a descriptor from the recycled node pool. All graph nodes are
+    // built through these so steady-state graph construction does not
+    // touch malloc.
+    static std::shared_ptr<ArrayDesc> alloc(Shape shape, Dtype dtype);
+    static std::shared_ptr<ArrayDesc> alloc(
+        Shape shape,
+        Dtype dtype,
+        std::shared_ptr<Primitive> primitive,
+        std::vector<array> inputs);
+
    private:
     // Initialize size, strides, and other metadata
     void init();
@@ -501,7 +560,7 @@ class array {
 
 template <typename T>
 array::array(T val, Dtype dtype /* = TypeToDtype<T>() */)
-    : array_desc_(std::make_shared<ArrayDesc>(Shape{}, dtype)) {
+    : array_desc_(ArrayDesc::alloc(Shape{}, dtype)) {
   init(&val);
 }
 
@@ -510,7 +569,7 @@ array::array(
   It data,
   Shape shape,
   Dtype dtype /* = TypeToDtype<typename std::iterator_traits<It>::value_type>() */) :
-    array_desc_(std::make_shared<ArrayDesc>(std::move(shape), dtype)) {
+    array_desc_(ArrayDesc::alloc(std::move(shape), dtype)) {
   init(data);
 }
 
@@ -518,7 +577,7 @@ template <typename T>
 array::array(
     std::initializer_list<T> data,
     Dtype dtype /* = TypeToDtype<T>() */)
-    : array_desc_(std::make_shared<ArrayDesc>(
+    : array_desc_(ArrayDesc::alloc(
           Shape{static_cast<ShapeElem>(data.size())},
           dtype)) {
   init(data.begin());
@@ -529,7 +588,7 @@ array::array(
     std::initializer_list<T> data,
     Shape shape,
     Dtype dtype /* = TypeToDtype<T>() */)
-    : array_desc_(std::make_shared<ArrayDesc>(std::move(shape), dtype)) {
+    : array_desc_(ArrayDesc::alloc(std::move(shape), dtype)) {
   if (data.size() != size()) {
     throw std::invalid_argument(
         "Data size and provided shape mismatch in array construction.");
@@ -2,9 +2,12 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <functional>
-#include <map>
+
+#include "mlx/memory.h"
 
 namespace mlx::core {
 
@@ -27,70 +30,80 @@ class BufferCache {
   BufferCache& operator=(const BufferCache&) = delete;
 
   T* reuse_from_cache(size_t size) {
-    // Find the closest buffer in pool.
-    auto it = buffer_pool_.lower_bound(size);
-    if (it == buffer_pool_.end() ||
-        it->first >= std::min(2 * size, size + 2 * page_size_)) {
-      return nullptr;
+    size_t limit = std::min(2 * size, size + 2 * page_size_);
+
+    // A buffer in [size, limit) can only live in the size class of `size`
+    // or the one above it, so the search never touches other classes.
+    int cls = size_class(size);
+    for (int c = cls; c < std::min(cls + 2, num_classes); ++c) {
+      for (BufferHolder* bh = classes_[c].head; bh; bh = bh->cls_next) {
+        if (bh->size >= size && bh->size < limit) {
+          T* buf = bh->buf;
+          stats_.hits++;
+          stats_.bytes_recycled += bh->size;
+          pool_size_ -= bh->size;
+          remove_from_class(bh);
+          remove_from_list(bh);
+          return buf;
+        }
+      }
     }
-
-    // Collect from the cache.
-    T* buf = it->second->buf;
-    pool_size_ -= it->first;
-
-    // Remove from record.
-    remove_from_list(it->second);
-    buffer_pool_.erase(it);
-    return buf;
+    stats_.misses++;
+    stats_.bytes_missed += size;
+    if (pool_size_ >= size) {
+      stats_.fragmented_misses++;
+    }
+    return nullptr;
   }
 
   void recycle_to_cache(T* buf) {
     assert(buf);
     // Add to cache.
-    BufferHolder* bh = new BufferHolder(buf);
+    BufferHolder* bh = new BufferHolder(buf, get_size_(buf));
     add_at_head(bh);
-    size_t size = get_size_(buf);
-    pool_size_ += size;
-    buffer_pool_.emplace(size, bh);
+    add_to_class(bh);
+    pool_size_ += bh->size;
   }
 
   int release_cached_buffers(size_t min_bytes_to_free) {
     if (min_bytes_to_free >= 0.9 * pool_size_) {
-      return clear();
+      int n_release = clear();
+      stats_.evictions += n_release;
+      return n_release;
     } else {
       int n_release = 0;
       size_t total_bytes_freed = 0;
 
+      // Evict from the global LRU tail; each holder is unlinked from its
+      // size class in constant time.
       while (tail_ && (total_bytes_freed < min_bytes_to_free)) {
-        // Release buffer.
-        size_t size = get_size_(tail_->buf);
-        total_bytes_freed += size;
+        total_bytes_freed += tail_->size;
         free_(tail_->buf);
         n_release++;
 
-        // Remove from record.
-        auto its = buffer_pool_.equal_range(size);
-        auto it = std::find_if(its.first, its.second, [this](const auto& el) {
-          return el.second == tail_;
-        });
-        assert(it != buffer_pool_.end());
-        buffer_pool_.erase(it);
+        remove_from_class(tail_);
         remove_from_list(tail_);
       }
 
       pool_size_ -= total_bytes_freed;
+      stats_.evictions += n_release;
       return n_release;
     }
   }
 
   int clear() {
     int n_release = 0;
-    for (auto& [size, holder] : buffer_pool_) {
-      free_(holder->buf);
+    for (BufferHolder* bh = head_; bh;) {
+      BufferHolder* next = bh->next;
+      free_(bh->buf);
       n_release++;
-      delete holder;
+      delete bh;
+      bh = next;
+    }
+    for (auto& cls : classes_) {
+      cls.head = nullptr;
+      cls.tail = nullptr;
     }
-    buffer_pool_.clear();
     pool_size_ = 0;
     head_ = nullptr;
     tail_ = nullptr;
@@ -105,16 +118,45 @@ class BufferCache {
     return page_size_;
   }
 
+  const CacheStats& stats() const {
+    return stats_;
+  }
+
+  void reset_stats() {
+    stats_ = CacheStats{};
+  }
+
  private:
   struct BufferHolder {
    public:
-    explicit BufferHolder(T* buf_) : buf(buf_) {}
+    BufferHolder(T* buf_, size_t size_) : buf(buf_), size(size_) {}
 
+    // Global LRU order across all size classes.
     BufferHolder* prev{nullptr};
     BufferHolder* next{nullptr};
+    // LRU order within the buffer's size class.
+    BufferHolder* cls_prev{nullptr};
+    BufferHolder* cls_next{nullptr};
     T* buf;
+    size_t size;
   };
 
+  struct SizeClass {
+    BufferHolder* head{nullptr};
+    BufferHolder* tail{nullptr};
+  };
+
+  // Power-of-two size classes: class c holds buffers in [2^c, 2^(c+1)).
+  static constexpr int num_classes = 64;
+
+  static int size_class(size_t size) {
+    int c = 0;
+    while ((size >> c) > 1) {
+      c++;
+    }
+    return c;
+  }
+
   void add_at_head(BufferHolder* to_add) {
     if (!head_) {
       head_ = to_add;
@@ -126,6 +168,32 @@ class BufferCache {
     }
   }
 
+  void add_to_class(BufferHolder* to_add) {
+    auto& cls = classes_[size_class(to_add->size)];
+    if (!cls.head) {
+      cls.head = to_add;
+      cls.tail = to_add;
+    } else {
+      cls.head->cls_prev = to_add;
+      to_add->cls_next = cls.head;
+      cls.head = to_add;
+    }
+  }
+
+  void remove_from_class(BufferHolder* to_remove) {
+    auto& cls = classes_[size_class(to_remove->size)];
+    if (to_remove->cls_prev) {
+      to_remove->cls_prev->cls_next = to_remove->cls_next;
+    } else {
+      cls.head = to_remove->cls_next;
+    }
+    if (to_remove->cls_next) {
+      to_remove->cls_next->cls_prev = to_remove->cls_prev;
+    } else {
+      cls.tail = to_remove->cls_prev;
+    }
+  }
+
   void remove_from_list(BufferHolder* to_remove) {
     if (to_remove->prev && to_remove->next) { // if middle
       to_remove->prev->next = to_remove->next;
@@ -144,10 +212,11 @@ class BufferCache {
     delete to_remove;
   }
 
-  std::multimap<size_t, BufferHolder*> buffer_pool_;
+  SizeClass classes_[num_classes];
   BufferHolder* head_{nullptr};
   BufferHolder* tail_{nullptr};
   size_t pool_size_{0};
+  CacheStats stats_;
 
   const size_t page_size_;
   std::function<size_t(T*)> get_size_;
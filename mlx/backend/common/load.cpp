@@ -1,10 +1,13 @@
 // Copyright © 2023 Apple Inc.
 
 #include <algorithm>
+#include <mutex>
+#include <unordered_map>
 #include <utility>
 
 #include "mlx/primitives.h"
 #include "mlx/scheduler.h"
+#include "mlx/utils.h"
 
 namespace {
 
@@ -23,11 +26,49 @@ void swap_endianness(uint8_t* data_bytes, size_t N) {
   }
 }
 
+// Live buffers previously loaded from the same file extent, so loading
+// identical weights twice (e.g. one base model under two adapters) costs
+// their memory once. Entries hold weak references — dropping every array
+// releases the memory — plus the read's future so a second load on a
+// different stream still waits for the bytes.
+struct LoadRegistry {
+  struct Entry {
+    std::weak_ptr<mlx::core::array::Data> data;
+    std::shared_future<void> fut;
+  };
+  std::mutex mtx;
+  std::unordered_map<std::string, Entry> entries;
+};
+
+LoadRegistry& load_registry() {
+  static LoadRegistry registry;
+  return registry;
+}
+
 } // namespace
 
 namespace mlx::core {
 
 void Load::eval_cpu(const std::vector<array>& inputs, array& out) {
+  // With MLX_LOAD_DEDUP set, share one immutable buffer between loads of
+  // the same extent. Shared buffers are marked not-donatable so an op
+  // mutating one "copy" writes a fresh output instead (copy on write).
+  std::string key;
+  if (env::load_dedup()) {
+    key = reader_->label() + "@" + std::to_string(offset_) + "+" +
+        std::to_string(out.nbytes()) + (swap_endianness_ ? "s" : "");
+    auto& registry = load_registry();
+    std::lock_guard<std::mutex> lk(registry.mtx);
+    if (auto it = registry.entries.find(key); it != registry.entries.end()) {
+      if (auto data = it->second.data.lock()) {
+        out.set_data_shared(std::move(data));
+        scheduler::enqueue(
+            stream(), [fut = it->second.fut]() { fut.wait(); });
+        return;
+      }
+    }
+  }
+
   out.set_data(allocator::malloc(out.nbytes()));
   auto read_task = [out_ptr = out.data<char>(),
                     size = out.size(),
@@ -51,6 +92,12 @@ void Load::eval_cpu(const std::vector<array>& inputs, array& out) {
     }
   };
   auto fut = io::thread_pool().enqueue(std::move(read_task)).share();
+  if (!key.empty()) {
+    out.set_data_not_donatable();
+    auto& registry = load_registry();
+    std::lock_guard<std::mutex> lk(registry.mtx);
+    registry.entries[key] = {out.data_shared_ptr(), fut};
+  }
   scheduler::enqueue(stream(), [fut = std::move(fut)]() { fut.wait(); });
 }
 
@@ -0,0 +1,116 @@
+// Copyright © 2025 Apple Inc.
+
+#pragma once
+
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#endif
+
+#include "mlx/utils.h"
+
+namespace mlx::core {
+
+/** The online CPU ids of each NUMA node. Platforms that do not expose a
+ * topology (and single socket machines) report one node holding every CPU. */
+inline const std::vector<std::vector<int>>& numa_node_cpus() {
+  static std::vector<std::vector<int>> nodes = []() {
+    std::vector<std::vector<int>> nodes;
+#if defined(__linux__)
+    for (int n = 0;; ++n) {
+      std::ifstream f(
+          "/sys/devices/system/node/node" + std::to_string(n) + "/cpulist");
+      if (!f.good()) {
+        break;
+      }
+      // The cpulist is ranges like "0-15,32-47"
+      std::string list;
+      std::getline(f, list);
+      std::vector<int> cpus;
+      std::stringstream ss(list);
+      std::string range;
+      while (std::getline(ss, range, ',')) {
+        if (range.empty()) {
+          continue;
+        }
+        auto dash = range.find('-');
+        int first = std::stoi(range.substr(0, dash));
+        int last = (dash == std::string::npos)
+            ? first
+            : std::stoi(range.substr(dash + 1));
+        for (int c = first; c <= last; ++c) {
+          cpus.push_back(c);
+        }
+      }
+      if (!cpus.empty()) {
+        nodes.push_back(std::move(cpus));
+      }
+    }
+#endif
+    if (nodes.empty()) {
+      int n_cpus =
+          std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+      nodes.emplace_back();
+      for (int c = 0; c < n_cpus; ++c) {
+        nodes.back().push_back(c);
+      }
+    }
+    return nodes;
+  }();
+  return nodes;
+}
+
+/** The NUMA node CPU worker threads should stay on (MLX_NUMA_NODE sets it).
+ * Negative means unpinned; out of range values are ignored. */
+inline int numa_node() {
+  static int node = []() {
+    int node = env::get_var("MLX_NUMA_NODE", -1);
+    if (node >= static_cast<int>(numa_node_cpus().size())) {
+      node = -1;
+    }
+    return node;
+  }();
+  return node;
+}
+
+/** The CPUs worker threads should be pinned to; empty means no pinning. */
+inline const std::vector<int>& thread_affinity_cpus() {
+  static std::vector<int> cpus = numa_node() < 0
+      ? std::vector<int>{}
+      : numa_node_cpus()[numa_node()];
+  return cpus;
+}
+
+/** Restrict the calling thread to the CPUs of the configured node. A no-op
+ * when MLX_NUMA_NODE is unset or on platforms without affinity control. */
+inline void bind_current_thread_to_numa_node() {
+#if defined(__linux__)
+  auto& cpus = thread_affinity_cpus();
+  if (cpus.empty()) {
+    return;
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (int c : cpus) {
+    CPU_SET(c, &set);
+  }
+  sched_setaffinity(0, sizeof(set), &set);
+#endif
+}
+
+/** Whether the pages of large buffers should be spread round-robin across
+ * the nodes instead of staying on the node that first touches them
+ * (MLX_NUMA_INTERLEAVE enables it; a single node machine never interleaves).
+ */
+inline bool numa_interleave() {
+  static bool interleave =
+      env::get_var("MLX_NUMA_INTERLEAVE", 0) && numa_node_cpus().size() > 1;
+  return interleave;
+}
+
+} // namespace mlx::core
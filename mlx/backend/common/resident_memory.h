@@ -0,0 +1,47 @@
+// Copyright © 2025 Apple Inc.
+
+#pragma once
+
+#include <cstddef>
+
+#ifdef __APPLE__
+#include <mach/mach.h>
+#elif defined(__linux__)
+#include <unistd.h>
+#include <cstdio>
+#endif
+
+namespace mlx::core {
+
+/** The resident set size of the calling process in bytes. */
+inline size_t get_resident_memory() {
+#ifdef __APPLE__
+  task_vm_info_data_t info;
+  mach_msg_type_number_t count = TASK_VM_INFO_COUNT;
+  if (task_info(
+          mach_task_self(),
+          TASK_VM_INFO,
+          reinterpret_cast<task_info_t>(&info),
+          &count) != KERN_SUCCESS) {
+    return 0;
+  }
+  return info.phys_footprint;
+#elif defined(__linux__)
+  FILE* f = std::fopen("/proc/self/statm", "r");
+  if (!f) {
+    return 0;
+  }
+  unsigned long total = 0;
+  unsigned long resident = 0;
+  int n = std::fscanf(f, "%lu %lu", &total, &resident);
+  std::fclose(f);
+  if (n != 2) {
+    return 0;
+  }
+  return resident * sysconf(_SC_PAGESIZE);
+#else
+  return 0;
+#endif
+}
+
+} // namespace mlx::core
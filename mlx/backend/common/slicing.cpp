@@ -1,5 +1,7 @@
 // Copyright © 2024 Apple Inc.
 
+#include <algorithm>
+
 #include "mlx/backend/common/utils.h"
 
 namespace mlx::core {
@@ -65,4 +67,42 @@ void slice(
   shared_buffer_slice(in, inp_strides, data_offset, data_size, out);
 }
 
+bool concatenate_as_view(
+    const std::vector<array>& inputs,
+    array& out,
+    int axis) {
+  // The concatenation has to be a linear byte-wise concatenation for the
+  // output to be expressible as a single view.
+  for (int i = 0; i < axis; ++i) {
+    if (out.shape(i) != 1) {
+      return false;
+    }
+  }
+  auto& first = inputs[0];
+  if (first.size() == 0) {
+    return false;
+  }
+  auto buf = first.buffer().ptr();
+  const char* expected = first.data<char>();
+  for (auto& in : inputs) {
+    if (in.size() == 0 || !in.flags().row_contiguous ||
+        in.buffer().ptr() != buf || in.data<char>() != expected) {
+      return false;
+    }
+    expected += in.size() * in.itemsize();
+  }
+
+  Strides strides(out.ndim(), 1);
+  for (int i = out.ndim() - 2; i >= 0; --i) {
+    strides[i] = strides[i + 1] * out.shape(i + 1);
+  }
+  auto flags = first.flags();
+  flags.contiguous = true;
+  flags.row_contiguous = true;
+  auto max_dim = std::max_element(out.shape().begin(), out.shape().end());
+  flags.col_contiguous = out.size() <= 1 || out.size() == *max_dim;
+  out.copy_shared_buffer(first, strides, flags, out.size());
+  return true;
+}
+
 } // namespace mlx::core
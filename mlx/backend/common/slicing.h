@@ -17,4 +17,12 @@ void slice(
     const Shape& start_indices,
     const Shape& strides);
 
+// Alias the concatenation output to its inputs when they are already laid
+// out back to back in a single buffer (e.g. views produced by split). Returns
+// false when a copy is required.
+bool concatenate_as_view(
+    const std::vector<array>& inputs,
+    array& out,
+    int axis);
+
 } // namespace mlx::core
@@ -0,0 +1,124 @@
+// Copyright © 2025 Apple Inc.
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace mlx::core {
+
+/**
+ * A set of small per-thread buffer pools fronting a shared BufferCache.
+ *
+ * Each scheduler stream runs on its own thread, so a thread local pool is
+ * effectively a per-stream pool. Buffers freed on a thread are kept in that
+ * thread's pool, up to a byte budget, and satisfy same-size allocations from
+ * the same thread without touching the allocator's global lock. Each pool
+ * has its own mutex which is uncontended in steady state; other threads only
+ * take it when the pools are drained, e.g. under memory pressure or from
+ * clear_cache().
+ *
+ * Only one pool set per buffer type may exist in a process since the thread
+ * local slot is keyed on the template parameter.
+ */
+template <typename T>
+class StreamPoolSet {
+ public:
+  StreamPoolSet(size_t max_pool_bytes, std::function<size_t(T*)> get_size)
+      : max_pool_bytes_(max_pool_bytes), get_size_(std::move(get_size)) {}
+
+  StreamPoolSet(const StreamPoolSet&) = delete;
+  StreamPoolSet& operator=(const StreamPoolSet&) = delete;
+
+  /** Pop a buffer of exactly `size` bytes from the calling thread's pool. */
+  T* try_reuse(size_t size) {
+    auto& pool = local();
+    std::lock_guard lock(pool.mutex);
+    for (auto& [bucket_size, bufs] : pool.buckets) {
+      if (bucket_size == size && !bufs.empty()) {
+        T* buf = bufs.back();
+        bufs.pop_back();
+        pool.bytes -= size;
+        total_bytes_.fetch_sub(size, std::memory_order_relaxed);
+        return buf;
+      }
+    }
+    return nullptr;
+  }
+
+  /**
+   * Keep a freed buffer in the calling thread's pool. Returns false without
+   * taking ownership when the pool is at its byte budget.
+   */
+  bool try_recycle(T* buf) {
+    size_t size = get_size_(buf);
+    auto& pool = local();
+    std::lock_guard lock(pool.mutex);
+    if (pool.bytes + size > max_pool_bytes_) {
+      return false;
+    }
+    auto it = pool.buckets.begin();
+    for (; it != pool.buckets.end() && it->first != size; ++it) {
+    }
+    if (it == pool.buckets.end()) {
+      it = pool.buckets.emplace(it, size, std::vector<T*>{});
+    }
+    it->second.push_back(buf);
+    pool.bytes += size;
+    total_bytes_.fetch_add(size, std::memory_order_relaxed);
+    return true;
+  }
+
+  /** Move the contents of every pool into `out`. */
+  void drain(std::vector<T*>& out) {
+    std::lock_guard registry_lock(registry_mutex_);
+    for (auto& pool : pools_) {
+      std::lock_guard lock(pool->mutex);
+      for (auto& [bucket_size, bufs] : pool->buckets) {
+        out.insert(out.end(), bufs.begin(), bufs.end());
+      }
+      pool->buckets.clear();
+      total_bytes_.fetch_sub(pool->bytes, std::memory_order_relaxed);
+      pool->bytes = 0;
+    }
+  }
+
+  /** The number of bytes currently held across all pools. */
+  size_t pool_size() const {
+    return total_bytes_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct Pool {
+    std::mutex mutex;
+    // One bucket per distinct (rounded) buffer size, LIFO within a bucket so
+    // reuse favors cache-warm buffers.
+    std::vector<std::pair<size_t, std::vector<T*>>> buckets;
+    size_t bytes{0};
+  };
+
+  Pool& local() {
+    // Pools are owned by the registry and persist after their thread exits;
+    // any buffers they still hold are reclaimed by the next drain().
+    thread_local Pool* pool = [this]() {
+      auto owned = std::make_unique<Pool>();
+      auto* raw = owned.get();
+      std::lock_guard lock(registry_mutex_);
+      pools_.push_back(std::move(owned));
+      return raw;
+    }();
+    return *pool;
+  }
+
+  const size_t max_pool_bytes_;
+  std::function<size_t(T*)> get_size_;
+
+  std::mutex registry_mutex_;
+  std::vector<std::unique_ptr<Pool>> pools_;
+  std::atomic<size_t> total_bytes_{0};
+};
+
+} // namespace mlx::core
@@ -22,29 +22,34 @@ std::tuple<Shape, std::vector<Strides>> collapse_contiguous_dims(
     const std::vector<Strides>& strides,
     int64_t size_cap) {
   // Make a vector that has axes separated with -1. Collapse all axes between
-  // -1.
+  // -1. Size-one axes carry no information and their strides can be
+  // arbitrary, so they are skipped rather than allowed to break a group.
   Shape to_collapse;
   if (shape.size() > 0) {
-    if (shape[0] != 1) {
-      to_collapse.push_back(0);
-    }
-    size_t size = shape[0];
-    for (int i = 1; i < shape.size(); i++) {
-      bool contiguous = true;
-      size *= shape[i];
-      for (const auto& st : strides) {
-        if (st[i] * shape[i] != st[i - 1] || size > size_cap) {
-          contiguous = false;
-          size = shape[i];
-          break;
+    int last = -1;
+    size_t size = 1;
+    for (int i = 0; i < shape.size(); i++) {
+      if (shape[i] == 1) {
+        continue;
+      }
+      bool contiguous = last >= 0;
+      if (contiguous) {
+        size *= shape[i];
+        for (const auto& st : strides) {
+          if (st[i] * shape[i] != st[last] || size > size_cap) {
+            contiguous = false;
+            break;
+          }
         }
       }
       if (!contiguous) {
-        to_collapse.push_back(-1);
-      }
-      if (shape[i] != 1) {
-        to_collapse.push_back(i);
+        size = shape[i];
+        if (last >= 0) {
+          to_collapse.push_back(-1);
+        }
       }
+      to_collapse.push_back(i);
+      last = i;
     }
     to_collapse.push_back(-1);
   }
@@ -88,12 +93,13 @@ std::pair<Shape, Strides> collapse_contiguous_dims(
   Strides collapsed_strides;
 
   if (shape.size() > 0) {
-    collapsed_shape.push_back(shape[0]);
-    collapsed_strides.push_back(strides[0]);
-    for (int i = 1; i < shape.size(); i++) {
+    // Size-one axes are skipped so their (arbitrary) strides cannot break
+    // a group
+    for (int i = 0; i < shape.size(); i++) {
       if (shape[i] == 1) {
         continue;
       } else if (
+          collapsed_shape.empty() ||
           strides[i] * shape[i] != collapsed_strides.back() ||
           collapsed_shape.back() * static_cast<int64_t>(shape[i]) > size_cap) {
         collapsed_shape.push_back(shape[i]);
@@ -103,6 +109,10 @@ std::pair<Shape, Strides> collapse_contiguous_dims(
         collapsed_strides.back() = strides[i];
       }
     }
+    if (collapsed_shape.empty()) {
+      collapsed_shape.push_back(1);
+      collapsed_strides.push_back(0);
+    }
   }
 
   return std::make_pair(collapsed_shape, collapsed_strides);
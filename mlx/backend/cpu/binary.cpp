@@ -1,5 +1,6 @@
 // Copyright © 2023 Apple Inc.
 
+#include <array>
 #include <cassert>
 #include <cmath>
 #include <sstream>
@@ -16,8 +17,107 @@ namespace mlx::core {
 
 namespace {
 
+// Kernels are resolved once at graph build: each dispatcher indexes a
+// constexpr table by Dtype::Val and captures the function pointer, so the
+// scheduled task makes a single indirect call instead of switching on
+// dtype per dispatch. Unsupported dtypes hold a null entry and error out
+// before anything is scheduled.
+using BinaryKernel =
+    void (*)(const array&, const array&, array&, BinaryOpType);
+
+template <typename T, typename U, typename Op>
+void binary_kernel(
+    const array& a,
+    const array& b,
+    array& out,
+    BinaryOpType bopt) {
+  binary_op<T, U, Op>(a, b, out, bopt);
+}
+
 template <typename Op>
-void binary(const array& a, const array& b, array& out, Op op, Stream stream) {
+inline constexpr std::array<BinaryKernel, 14> binary_all_kernels = {
+    &binary_kernel<bool, bool, Op>,
+    &binary_kernel<uint8_t, uint8_t, Op>,
+    &binary_kernel<uint16_t, uint16_t, Op>,
+    &binary_kernel<uint32_t, uint32_t, Op>,
+    &binary_kernel<uint64_t, uint64_t, Op>,
+    &binary_kernel<int8_t, int8_t, Op>,
+    &binary_kernel<int16_t, int16_t, Op>,
+    &binary_kernel<int32_t, int32_t, Op>,
+    &binary_kernel<int64_t, int64_t, Op>,
+    &binary_kernel<float16_t, float16_t, Op>,
+    &binary_kernel<float, float, Op>,
+    &binary_kernel<double, double, Op>,
+    &binary_kernel<bfloat16_t, bfloat16_t, Op>,
+    &binary_kernel<complex64_t, complex64_t, Op>,
+};
+
+template <typename Op>
+inline constexpr std::array<BinaryKernel, 14> comparison_kernels = {
+    &binary_kernel<bool, bool, Op>,
+    &binary_kernel<uint8_t, bool, Op>,
+    &binary_kernel<uint16_t, bool, Op>,
+    &binary_kernel<uint32_t, bool, Op>,
+    &binary_kernel<uint64_t, bool, Op>,
+    &binary_kernel<int8_t, bool, Op>,
+    &binary_kernel<int16_t, bool, Op>,
+    &binary_kernel<int32_t, bool, Op>,
+    &binary_kernel<int64_t, bool, Op>,
+    &binary_kernel<float16_t, bool, Op>,
+    &binary_kernel<float, bool, Op>,
+    &binary_kernel<double, bool, Op>,
+    &binary_kernel<bfloat16_t, bool, Op>,
+    &binary_kernel<complex64_t, bool, Op>,
+};
+
+template <typename Op>
+inline constexpr std::array<BinaryKernel, 14> binary_float_kernels = {
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    &binary_kernel<float16_t, float16_t, Op>,
+    &binary_kernel<float, float, Op>,
+    &binary_kernel<double, double, Op>,
+    &binary_kernel<bfloat16_t, bfloat16_t, Op>,
+    &binary_kernel<complex64_t, complex64_t, Op>,
+};
+
+template <typename Op>
+inline constexpr std::array<BinaryKernel, 14> binary_int_kernels = {
+    &binary_kernel<bool, bool, Op>,
+    &binary_kernel<uint8_t, uint8_t, Op>,
+    &binary_kernel<uint16_t, uint16_t, Op>,
+    &binary_kernel<uint32_t, uint32_t, Op>,
+    &binary_kernel<uint64_t, uint64_t, Op>,
+    &binary_kernel<int8_t, int8_t, Op>,
+    &binary_kernel<int16_t, int16_t, Op>,
+    &binary_kernel<int32_t, int32_t, Op>,
+    &binary_kernel<int64_t, int64_t, Op>,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+};
+
+void dispatch_binary(
+    const array& a,
+    const array& b,
+    array& out,
+    BinaryKernel kernel,
+    const char* tag,
+    Stream stream) {
+  if (kernel == nullptr) {
+    std::ostringstream err;
+    err << "[" << tag << "] Does not support " << out.dtype();
+    throw std::runtime_error(err.str());
+  }
   auto bopt = get_binary_op_type(a, b);
   set_binary_op_output_data(a, b, out, bopt);
 
@@ -28,52 +128,19 @@ void binary(const array& a, const array& b, array& out, Op op, Stream stream) {
   encoder.dispatch([a = array::unsafe_weak_copy(a),
                     b = array::unsafe_weak_copy(b),
                     out = array::unsafe_weak_copy(out),
-                    bopt]() mutable {
-    switch (out.dtype()) {
-      case bool_:
-        binary_op<bool, Op>(a, b, out, bopt);
-        break;
-      case uint8:
-        binary_op<uint8_t, Op>(a, b, out, bopt);
-        break;
-      case uint16:
-        binary_op<uint16_t, Op>(a, b, out, bopt);
-        break;
-      case uint32:
-        binary_op<uint32_t, Op>(a, b, out, bopt);
-        break;
-      case uint64:
-        binary_op<uint64_t, Op>(a, b, out, bopt);
-        break;
-      case int8:
-        binary_op<int8_t, Op>(a, b, out, bopt);
-        break;
-      case int16:
-        binary_op<int16_t, Op>(a, b, out, bopt);
-        break;
-      case int32:
-        binary_op<int32_t, Op>(a, b, out, bopt);
-        break;
-      case int64:
-        binary_op<int64_t, Op>(a, b, out, bopt);
-        break;
-      case float16:
-        binary_op<float16_t, Op>(a, b, out, bopt);
-        break;
-      case float32:
-        binary_op<float, Op>(a, b, out, bopt);
-        break;
-      case float64:
-        binary_op<double, Op>(a, b, out, bopt);
-        break;
-      case bfloat16:
-        binary_op<bfloat16_t, Op>(a, b, out, bopt);
-        break;
-      case complex64:
-        binary_op<complex64_t, Op>(a, b, out, bopt);
-        break;
-    }
-  });
+                    bopt,
+                    kernel]() mutable { kernel(a, b, out, bopt); });
+}
+
+template <typename Op>
+void binary(const array& a, const array& b, array& out, Op op, Stream stream) {
+  dispatch_binary(
+      a,
+      b,
+      out,
+      binary_all_kernels<Op>[static_cast<int>(out.dtype().val())],
+      "binary",
+      stream);
 }
 
 template <typename Op>
@@ -83,62 +150,13 @@ void comparison_op(
     array& out,
     Op op,
     Stream stream) {
-  auto bopt = get_binary_op_type(a, b);
-  set_binary_op_output_data(a, b, out, bopt);
-
-  auto& encoder = cpu::get_command_encoder(stream);
-  encoder.set_input_array(a);
-  encoder.set_input_array(b);
-  encoder.set_output_array(out);
-  encoder.dispatch([a = array::unsafe_weak_copy(a),
-                    b = array::unsafe_weak_copy(b),
-                    out = array::unsafe_weak_copy(out),
-                    bopt]() mutable {
-    switch (a.dtype()) {
-      case bool_:
-        binary_op<bool, bool, Op>(a, b, out, bopt);
-        break;
-      case uint8:
-        binary_op<uint8_t, bool, Op>(a, b, out, bopt);
-        break;
-      case uint16:
-        binary_op<uint16_t, bool, Op>(a, b, out, bopt);
-        break;
-      case uint32:
-        binary_op<uint32_t, bool, Op>(a, b, out, bopt);
-        break;
-      case uint64:
-        binary_op<uint64_t, bool, Op>(a, b, out, bopt);
-        break;
-      case int8:
-        binary_op<int8_t, bool, Op>(a, b, out, bopt);
-        break;
-      case int16:
-        binary_op<int16_t, bool, Op>(a, b, out, bopt);
-        break;
-      case int32:
-        binary_op<int32_t, bool, Op>(a, b, out, bopt);
-        break;
-      case int64:
-        binary_op<int64_t, bool, Op>(a, b, out, bopt);
-        break;
-      case float16:
-        binary_op<float16_t, bool, Op>(a, b, out, bopt);
-        break;
-      case float32:
-        binary_op<float, bool, Op>(a, b, out, bopt);
-        break;
-      case float64:
-        binary_op<double, bool, Op>(a, b, out, bopt);
-        break;
-      case bfloat16:
-        binary_op<bfloat16_t, bool, Op>(a, b, out, bopt);
-        break;
-      case complex64:
-        binary_op<complex64_t, bool, Op>(a, b, out, bopt);
-        break;
-    }
-  });
+  dispatch_binary(
+      a,
+      b,
+      out,
+      comparison_kernels<Op>[static_cast<int>(a.dtype().val())],
+      "comparison",
+      stream);
 }
 
 template <typename Op>
@@ -148,38 +166,13 @@ void binary_float(
     array& out,
     Op op,
     Stream stream) {
-  auto bopt = get_binary_op_type(a, b);
-  set_binary_op_output_data(a, b, out, bopt);
-
-  auto& encoder = cpu::get_command_encoder(stream);
-  encoder.set_input_array(a);
-  encoder.set_input_array(b);
-  encoder.set_output_array(out);
-  encoder.dispatch([a = array::unsafe_weak_copy(a),
-                    b = array::unsafe_weak_copy(b),
-                    out = array::unsafe_weak_copy(out),
-                    bopt]() mutable {
-    switch (out.dtype()) {
-      case float16:
-        binary_op<float16_t, Op>(a, b, out, bopt);
-        break;
-      case float32:
-        binary_op<float, Op>(a, b, out, bopt);
-        break;
-      case float64:
-        binary_op<double, Op>(a, b, out, bopt);
-        break;
-      case bfloat16:
-        binary_op<bfloat16_t, Op>(a, b, out, bopt);
-        break;
-      case complex64:
-        binary_op<complex64_t, Op>(a, b, out, bopt);
-        break;
-      default:
-        throw std::runtime_error(
-            "[binary_float] Only supports floating point types.");
-    }
-  });
+  dispatch_binary(
+      a,
+      b,
+      out,
+      binary_float_kernels<Op>[static_cast<int>(out.dtype().val())],
+      "binary_float",
+      stream);
 }
 
 template <typename Op>
@@ -189,49 +182,13 @@ void binary_int(
     array& out,
     Op op,
     Stream stream) {
-  auto bopt = get_binary_op_type(a, b);
-  set_binary_op_output_data(a, b, out, bopt);
-
-  auto& encoder = cpu::get_command_encoder(stream);
-  encoder.set_input_array(a);
-  encoder.set_input_array(b);
-  encoder.set_output_array(out);
-  encoder.dispatch([a = array::unsafe_weak_copy(a),
-                    b = array::unsafe_weak_copy(b),
-                    out = array::unsafe_weak_copy(out),
-                    bopt]() mutable {
-    switch (out.dtype()) {
-      case bool_:
-        binary_op<bool, Op>(a, b, out, bopt);
-      case uint8:
-        binary_op<uint8_t, Op>(a, b, out, bopt);
-        break;
-      case uint16:
-        binary_op<uint16_t, Op>(a, b, out, bopt);
-        break;
-      case uint32:
-        binary_op<uint32_t, Op>(a, b, out, bopt);
-        break;
-      case uint64:
-        binary_op<uint64_t, Op>(a, b, out, bopt);
-        break;
-      case int8:
-        binary_op<int8_t, Op>(a, b, out, bopt);
-        break;
-      case int16:
-        binary_op<int16_t, Op>(a, b, out, bopt);
-        break;
-      case int32:
-        binary_op<int32_t, Op>(a, b, out, bopt);
-        break;
-      case int64:
-        binary_op<int64_t, Op>(a, b, out, bopt);
-        break;
-      default:
-        throw std::runtime_error("[binary_int] Type not supported");
-        break;
-    }
-  });
+  dispatch_binary(
+      a,
+      b,
+      out,
+      binary_int_kernels<Op>[static_cast<int>(out.dtype().val())],
+      "binary_int",
+      stream);
 }
 
 } // namespace
@@ -276,6 +233,7 @@ void DivMod::eval_cpu(
     switch (out_a.dtype()) {
       case bool_:
         binary_op<bool>(a, b, out_a, out_b, integral_op, bopt);
+        break;
       case uint8:
         binary_op<uint8_t>(a, b, out_a, out_b, integral_op, bopt);
         break;
@@ -95,4 +95,18 @@ struct Select {
   }
 };
 
+struct MaskedAdd {
+  template <typename T>
+  T operator()(bool condition, T x, T y) {
+    return condition ? T(x + y) : T(0);
+  }
+};
+
+struct MaskedMultiply {
+  template <typename T>
+  T operator()(bool condition, T x, T y) {
+    return condition ? T(x * y) : T(0);
+  }
+};
+
 } // namespace mlx::core::detail
@@ -4,11 +4,56 @@
 #include "mlx/backend/cpu/copy.h"
 #include "mlx/backend/cpu/encoder.h"
 #include "mlx/backend/cpu/lapack.h"
+#include "mlx/backend/cpu/parallel.h"
+#include "mlx/backend/cpu/simd/simd.h"
 #include "mlx/linalg.h"
 #include "mlx/primitives.h"
 
 namespace mlx::core {
 
+namespace {
+
+// Matrices up to this order are factorized with the simd kernel below
+// instead of paying the LAPACK call overhead per matrix
+constexpr int cholesky_lapack_threshold = 64;
+
+template <typename T>
+T simd_dot(const T* x, const T* y, int n) {
+  constexpr int S = simd::max_size<T>;
+  simd::Simd<T, S> acc(0);
+  int i = 0;
+  for (; i + S <= n; i += S) {
+    acc = acc + simd::load<T, S>(x + i) * simd::load<T, S>(y + i);
+  }
+  T out = simd::sum(acc);
+  for (; i < n; ++i) {
+    out += x[i] * y[i];
+  }
+  return out;
+}
+
+// Unblocked Cholesky of a single small row-major matrix, in place. The
+// columns of the lower factor are built left to right with the dot products
+// over the finished part of each row vectorized. A matrix that is not
+// positive definite produces NaNs from the square root of a negative
+// diagonal (LAPACK instead stops at the failing minor; neither result is
+// meaningful).
+template <typename T>
+void simd_cholesky(T* a, int N) {
+  for (int j = 0; j < N; j++) {
+    T* row_j = a + j * N;
+    T diag = std::sqrt(row_j[j] - simd_dot(row_j, row_j, j));
+    row_j[j] = diag;
+    T inv = T(1) / diag;
+    for (int i = j + 1; i < N; i++) {
+      T* row_i = a + i * N;
+      row_i[j] = (row_i[j] - simd_dot(row_i, row_j, j)) * inv;
+    }
+  }
+}
+
+} // namespace
+
 template <typename T>
 void cholesky_impl(const array& a, array& factor, bool upper, Stream stream) {
   // Lapack uses the column-major convention. We take advantage of the fact that
@@ -31,40 +76,60 @@ void cholesky_impl(const array& a, array& factor, bool upper, Stream stream) {
   encoder.dispatch([matrix = factor.data<T>(),
                     upper,
                     N = a.shape(-1),
-                    size = a.size()]() mutable {
-    char uplo = (upper) ? 'L' : 'U';
+                    size = a.size()]() {
     size_t num_matrices = size / (N * N);
-    for (int i = 0; i < num_matrices; i++) {
-      // Compute Cholesky factorization.
-      int info;
-      potrf<T>(
-          /* uplo = */ &uplo,
-          /* n = */ &N,
-          /* a = */ matrix,
-          /* lda = */ &N,
-          /* info = */ &info);
+    // The matrices are independent, so farm chunks of the batch out to the
+    // worker pool
+    parallel_for(num_matrices, [&](size_t start, size_t end) {
+      char uplo = (upper) ? 'L' : 'U';
+      int n = N;
+      for (size_t m = start; m < end; m++) {
+        T* mat = matrix + m * static_cast<size_t>(N) * N;
+        if (N <= cholesky_lapack_threshold) {
+          // The input is symmetric, so the lower factor can be computed
+          // from the rows either way and transposed when the upper one was
+          // asked for
+          simd_cholesky(mat, N);
+          if (upper) {
+            for (int r = 0; r < N; r++) {
+              for (int c = r + 1; c < N; c++) {
+                mat[r * N + c] = mat[c * N + r];
+              }
+            }
+          }
+        } else {
+          // Compute Cholesky factorization.
+          int info;
+          potrf<T>(
+              /* uplo = */ &uplo,
+              /* n = */ &n,
+              /* a = */ mat,
+              /* lda = */ &n,
+              /* info = */ &info);
 
-      // TODO: We do nothing when the matrix is not positive semi-definite
-      // because throwing an error would result in a crash. If we figure out how
-      // to catch errors from the implementation we should throw.
-      if (info < 0) {
-        std::stringstream msg;
-        msg << "[Cholesky::eval_cpu] Cholesky decomposition failed with error code "
-            << info;
-        throw std::runtime_error(msg.str());
-      }
+          // TODO: We do nothing when the matrix is not positive
+          // semi-definite because throwing an error would result in a crash.
+          // If we figure out how to catch errors from the implementation we
+          // should throw.
+          if (info < 0) {
+            std::stringstream msg;
+            msg << "[Cholesky::eval_cpu] Cholesky decomposition failed with error code "
+                << info;
+            throw std::runtime_error(msg.str());
+          }
+        }
 
-      // Zero out the upper/lower triangle while advancing the pointer to the
-      // next matrix at the same time.
-      for (int row = 0; row < N; row++) {
-        if (upper) {
-          std::fill(matrix, matrix + row, 0);
-        } else {
-          std::fill(matrix + row + 1, matrix + N, 0);
+        // Zero out the upper/lower triangle
+        T* row = mat;
+        for (int r = 0; r < N; r++, row += N) {
+          if (upper) {
+            std::fill(row, row + r, 0);
+          } else {
+            std::fill(row + r + 1, row + N, 0);
+          }
         }
-        matrix += N;
       }
-    }
+    });
   });
 }
 
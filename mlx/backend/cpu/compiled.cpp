@@ -6,6 +6,12 @@
 #include <list>
 #include <mutex>
 #include <shared_mutex>
+#ifdef _MSC_VER
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
 
 #include <fmt/format.h>
 
@@ -46,6 +52,25 @@ static CompilerCache& cache() {
   return cache_;
 };
 
+// Get the cache directory for storing compiled shared libraries. Kernels
+// compiled by one process are dlopen'd by every subsequent one.
+static const std::filesystem::path& cpu_cache_dir() {
+  static std::filesystem::path cache = []() -> std::filesystem::path {
+    std::filesystem::path cache;
+    if (auto c = std::getenv("MLX_CPU_CACHE_DIR"); c) {
+      cache = c;
+    } else {
+      cache =
+          std::filesystem::temp_directory_path() / "mlx" / version() / "cpu";
+    }
+    if (!std::filesystem::exists(cache)) {
+      std::filesystem::create_directories(cache);
+    }
+    return cache;
+  }();
+  return cache;
+}
+
 // GPU compile is always available if the GPU is available and since we are in
 // this file CPU compile is also available.
 namespace detail {
@@ -77,29 +102,27 @@ void* compile(
 
   // Deal with long kernel names. Maximum length for filename on macOS is 255
   // characters, and on Windows the maximum length for whole path is 260. Clip
-  // file name with a little extra room and append a 16 character hash.
+  // file name with enough room for the 16 character source hash appended
+  // below plus the lib prefix and extensions.
 #ifdef _WIN32
-  constexpr int max_file_name_length = 140;
+  constexpr int max_file_name_length = 120;
 #else
-  constexpr int max_file_name_length = 245;
+  constexpr int max_file_name_length = 224;
 #endif
   if (kernel_name.size() > max_file_name_length) {
-    std::ostringstream file_name;
-    file_name
-        << std::string_view(kernel_name).substr(0, max_file_name_length - 16);
-    auto file_id =
-        std::hash<std::string>{}(kernel_name.substr(max_file_name_length - 16));
-    file_name << "_" << std::hex << std::setw(16) << file_id << std::dec;
-    kernel_file_name = file_name.str();
+    kernel_file_name = kernel_name.substr(0, max_file_name_length);
   } else {
     kernel_file_name = kernel_name;
   }
 
-  auto output_dir =
-      std::filesystem::temp_directory_path() / "mlx" / version() / "cpu";
-  if (!std::filesystem::exists(output_dir)) {
-    std::filesystem::create_directories(output_dir);
-  }
+  // Key the shared library by the hash of the source so a kernel compiled
+  // by an earlier process is picked up from disk, and a codegen change
+  // misses rather than reusing a stale library with the same name.
+  auto file_id = std::hash<std::string>{}(source_code);
+  kernel_file_name =
+      fmt::format("{0}_{1:016x}", kernel_file_name, size_t(file_id));
+
+  auto output_dir = cpu_cache_dir();
 
   std::string shared_lib_name = "lib" + kernel_file_name + ".so";
   auto shared_lib_path = (output_dir / shared_lib_name).string();
@@ -118,15 +141,29 @@ void* compile(
     source_file << source_code;
     source_file.close();
 
+    // Compile to a private name and move the result into place so another
+    // process racing on the same kernel never loads a partly written
+    // library. Renames within a directory are atomic.
+    std::string build_lib_name = fmt::format(
+        "{0}.{1}.tmp", shared_lib_name, getpid());
     try {
       JitCompiler::exec(JitCompiler::build_command(
-          output_dir, source_file_name, shared_lib_name));
+          output_dir, source_file_name, build_lib_name));
     } catch (const std::exception& error) {
       throw std::runtime_error(fmt::format(
           "[Compile::eval_cpu] Failed to compile function {0}: {1}",
           kernel_name,
           error.what()));
     }
+    std::error_code rename_error;
+    std::filesystem::rename(
+        output_dir / build_lib_name, shared_lib_path, rename_error);
+    if (rename_error && !std::filesystem::exists(shared_lib_path)) {
+      throw std::runtime_error(fmt::format(
+          "[Compile::eval_cpu] Failed to write compiled function {0}: {1}",
+          kernel_name,
+          rename_error.message()));
+    }
   }
 
   // load library
@@ -6,6 +6,8 @@
 #include "mlx/backend/cpu/copy.h"
 #include "mlx/backend/cpu/encoder.h"
 #include "mlx/backend/cpu/lapack.h"
+#include "mlx/backend/cpu/parallel.h"
+#include "mlx/backend/cpu/simd/simd.h"
 #include "mlx/primitives.h"
 #include "mlx/utils.h"
 
@@ -1293,6 +1295,278 @@ void explicit_gemm_conv_ND_cpu(
 // Conv routing
 ///////////////////////////////////////////////////////////////////////////////
 
+///////////////////////////////////////////////////////////////////////////////
+// Specialized 2D kernels
+///////////////////////////////////////////////////////////////////////////////
+
+// Depthwise 2D convolution (one filter per channel). With NHWC inputs every
+// tap is contiguous over channels, so the inner loop is a width-S fma with
+// the weights packed to the same layout.
+void depthwise_conv_2D_cpu(
+    const array& in,
+    const array& wt,
+    array out,
+    const std::vector<int>& padding_lo,
+    const std::vector<int>& wt_strides,
+    const std::vector<int>& wt_dilation,
+    bool flip,
+    Stream stream) {
+  auto& encoder = cpu::get_command_encoder(stream);
+  encoder.set_input_array(in);
+  encoder.set_input_array(wt);
+  encoder.set_output_array(out);
+
+  encoder.dispatch([in_ptr = in.data<float>(),
+                    wt_ptr = wt.data<float>(),
+                    out_ptr = out.data<float>(),
+                    N = in.shape(0),
+                    iH = in.shape(1),
+                    iW = in.shape(2),
+                    C = in.shape(3),
+                    oH = out.shape(1),
+                    oW = out.shape(2),
+                    wH = wt.shape(1),
+                    wW = wt.shape(2),
+                    padding_lo,
+                    wt_strides,
+                    wt_dilation,
+                    flip]() {
+    // Pack the (C, wH, wW, 1) weights as (wH, wW, C) so each tap is
+    // contiguous over channels, folding in the flip
+    std::vector<float> pwt(wH * wW * C);
+    for (int c = 0; c < C; ++c) {
+      for (int wh = 0; wh < wH; ++wh) {
+        for (int ww = 0; ww < wW; ++ww) {
+          int wh_s = flip ? wH - 1 - wh : wh;
+          int ww_s = flip ? wW - 1 - ww : ww;
+          pwt[(wh * wW + ww) * C + c] = wt_ptr[(c * wH + wh_s) * wW + ww_s];
+        }
+      }
+    }
+
+    constexpr int S = simd::max_size<float>;
+    parallel_for(size_t(N) * oH, [&](size_t start, size_t end) {
+      for (size_t r = start; r < end; ++r) {
+        int n = r / oH;
+        int oh = r % oH;
+        const float* in_n = in_ptr + size_t(n) * iH * iW * C;
+        float* out_r = out_ptr + (size_t(n) * oH + oh) * oW * C;
+        int ih_base = oh * wt_strides[0] - padding_lo[0];
+        for (int ow = 0; ow < oW; ++ow, out_r += C) {
+          int iw_base = ow * wt_strides[1] - padding_lo[1];
+          int c = 0;
+          for (; c + S <= C; c += S) {
+            simd::Simd<float, S> acc = 0.f;
+            for (int wh = 0; wh < wH; ++wh) {
+              int ih = ih_base + wh * wt_dilation[0];
+              if (ih < 0 || ih >= iH) {
+                continue;
+              }
+              for (int ww = 0; ww < wW; ++ww) {
+                int iw = iw_base + ww * wt_dilation[1];
+                if (iw < 0 || iw >= iW) {
+                  continue;
+                }
+                acc = simd::fma(
+                    simd::load<float, S>(
+                        in_n + (size_t(ih) * iW + iw) * C + c),
+                    simd::load<float, S>(pwt.data() + (wh * wW + ww) * C + c),
+                    acc);
+              }
+            }
+            simd::store(out_r + c, acc);
+          }
+          for (; c < C; ++c) {
+            float acc = 0.f;
+            for (int wh = 0; wh < wH; ++wh) {
+              int ih = ih_base + wh * wt_dilation[0];
+              if (ih < 0 || ih >= iH) {
+                continue;
+              }
+              for (int ww = 0; ww < wW; ++ww) {
+                int iw = iw_base + ww * wt_dilation[1];
+                if (iw < 0 || iw >= iW) {
+                  continue;
+                }
+                acc = std::fma(
+                    in_n[(size_t(ih) * iW + iw) * C + c],
+                    pwt[(wh * wW + ww) * C + c],
+                    acc);
+              }
+            }
+            out_r[c] = acc;
+          }
+        }
+      }
+    });
+  });
+}
+
+// Winograd F(2x2, 3x3) for stride-1 3x3 convolutions: each 4x4 input tile
+// produces a 2x2 output tile with 16 multiplies per (c, o) pair instead of
+// 36. The transformed weights U are laid out (tap, c, o) so the per-tile
+// core is a width-S fma over output channels; partial edge tiles gather
+// zeros and store only the valid outputs.
+void winograd_conv_2D_cpu(
+    const array& in,
+    const array& wt,
+    array out,
+    const std::vector<int>& padding_lo,
+    bool flip,
+    Stream stream) {
+  auto& encoder = cpu::get_command_encoder(stream);
+  encoder.set_input_array(in);
+  encoder.set_input_array(wt);
+  encoder.set_output_array(out);
+
+  encoder.dispatch([in_ptr = in.data<float>(),
+                    wt_ptr = wt.data<float>(),
+                    out_ptr = out.data<float>(),
+                    N = in.shape(0),
+                    iH = in.shape(1),
+                    iW = in.shape(2),
+                    C = in.shape(3),
+                    oH = out.shape(1),
+                    oW = out.shape(2),
+                    O = wt.shape(0),
+                    padding_lo,
+                    flip]() {
+    // Transform the weights once: U[tap][c][o] = (G g G^T)[tap]
+    std::vector<float> U(size_t(16) * C * O);
+    for (int o = 0; o < O; ++o) {
+      for (int c = 0; c < C; ++c) {
+        float g[3][3];
+        for (int i = 0; i < 3; ++i) {
+          for (int j = 0; j < 3; ++j) {
+            int i_s = flip ? 2 - i : i;
+            int j_s = flip ? 2 - j : j;
+            g[i][j] = wt_ptr[((o * 3 + i_s) * 3 + j_s) * C + c];
+          }
+        }
+        float t[4][3];
+        for (int j = 0; j < 3; ++j) {
+          t[0][j] = g[0][j];
+          t[1][j] = 0.5f * (g[0][j] + g[1][j] + g[2][j]);
+          t[2][j] = 0.5f * (g[0][j] - g[1][j] + g[2][j]);
+          t[3][j] = g[2][j];
+        }
+        for (int i = 0; i < 4; ++i) {
+          float u0 = t[i][0];
+          float u1 = 0.5f * (t[i][0] + t[i][1] + t[i][2]);
+          float u2 = 0.5f * (t[i][0] - t[i][1] + t[i][2]);
+          float u3 = t[i][2];
+          U[((i * 4 + 0) * C + c) * O + o] = u0;
+          U[((i * 4 + 1) * C + c) * O + o] = u1;
+          U[((i * 4 + 2) * C + c) * O + o] = u2;
+          U[((i * 4 + 3) * C + c) * O + o] = u3;
+        }
+      }
+    }
+
+    constexpr int S = simd::max_size<float>;
+    int tH = (oH + 1) / 2;
+    int tW = (oW + 1) / 2;
+    parallel_for(size_t(N) * tH, [&](size_t start, size_t end) {
+      std::vector<float> V(16 * C);
+      std::vector<float> M(16 * O);
+      for (size_t r = start; r < end; ++r) {
+        int n = r / tH;
+        int th = r % tH;
+        const float* in_n = in_ptr + size_t(n) * iH * iW * C;
+        for (int tw = 0; tw < tW; ++tw) {
+          // Input transform: V = B^T d B per channel, gathering zeros for
+          // out-of-range (padding) pixels
+          int ih0 = 2 * th - padding_lo[0];
+          int iw0 = 2 * tw - padding_lo[1];
+          for (int c = 0; c < C; ++c) {
+            float d[4][4];
+            for (int i = 0; i < 4; ++i) {
+              int ih = ih0 + i;
+              for (int j = 0; j < 4; ++j) {
+                int iw = iw0 + j;
+                d[i][j] = (ih >= 0 && ih < iH && iw >= 0 && iw < iW)
+                    ? in_n[(size_t(ih) * iW + iw) * C + c]
+                    : 0.f;
+              }
+            }
+            float y[4][4];
+            for (int j = 0; j < 4; ++j) {
+              y[0][j] = d[0][j] - d[2][j];
+              y[1][j] = d[1][j] + d[2][j];
+              y[2][j] = d[2][j] - d[1][j];
+              y[3][j] = d[1][j] - d[3][j];
+            }
+            for (int i = 0; i < 4; ++i) {
+              V[(i * 4 + 0) * C + c] = y[i][0] - y[i][2];
+              V[(i * 4 + 1) * C + c] = y[i][1] + y[i][2];
+              V[(i * 4 + 2) * C + c] = y[i][2] - y[i][1];
+              V[(i * 4 + 3) * C + c] = y[i][1] - y[i][3];
+            }
+          }
+
+          // Elementwise core: M[k][o] = sum_c V[k][c] * U[k][c][o]
+          std::fill(M.begin(), M.end(), 0.f);
+          for (int k = 0; k < 16; ++k) {
+            float* Mk = M.data() + k * O;
+            const float* Uk = U.data() + size_t(k) * C * O;
+            for (int c = 0; c < C; ++c) {
+              simd::Simd<float, S> v = V[k * C + c];
+              const float* Ukc = Uk + size_t(c) * O;
+              int o = 0;
+              for (; o + S <= O; o += S) {
+                simd::store(
+                    Mk + o,
+                    simd::fma(
+                        v,
+                        simd::load<float, S>(Ukc + o),
+                        simd::load<float, S>(Mk + o)));
+              }
+              for (; o < O; ++o) {
+                Mk[o] = std::fma(V[k * C + c], Ukc[o], Mk[o]);
+              }
+            }
+          }
+
+          // Output transform: 2x2 tile = A^T M A per output channel
+          for (int o = 0; o < O; ++o) {
+            float m[4][4];
+            for (int i = 0; i < 4; ++i) {
+              for (int j = 0; j < 4; ++j) {
+                m[i][j] = M[(i * 4 + j) * O + o];
+              }
+            }
+            float t0[4];
+            float t1[4];
+            for (int j = 0; j < 4; ++j) {
+              t0[j] = m[0][j] + m[1][j] + m[2][j];
+              t1[j] = m[1][j] - m[2][j] - m[3][j];
+            }
+            float y00 = t0[0] + t0[1] + t0[2];
+            float y01 = t0[1] - t0[2] - t0[3];
+            float y10 = t1[0] + t1[1] + t1[2];
+            float y11 = t1[1] - t1[2] - t1[3];
+
+            int h0 = 2 * th;
+            int w0 = 2 * tw;
+            float* out_t = out_ptr +
+                ((size_t(n) * oH + h0) * oW + w0) * O + o;
+            out_t[0] = y00;
+            if (w0 + 1 < oW) {
+              out_t[O] = y01;
+            }
+            if (h0 + 1 < oH) {
+              out_t[size_t(oW) * O] = y10;
+              if (w0 + 1 < oW) {
+                out_t[size_t(oW) * O + O] = y11;
+              }
+            }
+          }
+        }
+      }
+    });
+  });
+}
+
 void conv_1D_cpu(
     const array& in,
     const array& wt,
@@ -1347,6 +1621,19 @@ void conv_2D_cpu(
     bool flip,
     Stream stream) {
   const int groups = in.shape().back() / wt.shape().back();
+  bool fast_eligible = in.dtype() == float32 && wt.dtype() == float32 &&
+      out.dtype() == float32 && in.flags().row_contiguous &&
+      wt.flags().row_contiguous && in_dilation[0] == 1 && in_dilation[1] == 1;
+  if (fast_eligible && groups == in.shape(3) && groups > 1 &&
+      wt.shape(0) == groups) {
+    return depthwise_conv_2D_cpu(
+        in, wt, out, padding_lo, wt_strides, wt_dilation, flip, stream);
+  }
+  if (fast_eligible && groups == 1 && wt.shape(1) == 3 && wt.shape(2) == 3 &&
+      wt_strides[0] == 1 && wt_strides[1] == 1 && wt_dilation[0] == 1 &&
+      wt_dilation[1] == 1) {
+    return winograd_conv_2D_cpu(in, wt, out, padding_lo, flip, stream);
+  }
   if (wt_dilation[0] == 1 && wt_dilation[1] == 1 && in_dilation[0] == 1 &&
       in_dilation[1] == 1 && groups == 1) {
     return explicit_gemm_conv_ND_cpu(
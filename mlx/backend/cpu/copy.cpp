@@ -53,6 +53,65 @@ inline void copy_dims(
   }
 }
 
+// Cache-blocked kernel for transposed copies: destination rows are
+// contiguous and the source is walked down contiguous columns, so the
+// element at (r, c) is src[r + c * src_col_stride]. Tiles keep both sides
+// cache resident and the row stores go through the simd layer when no
+// conversion is needed.
+template <typename SrcT, typename DstT>
+void copy_transpose(
+    const SrcT* src,
+    DstT* dst,
+    int rows,
+    int cols,
+    int64_t src_col_stride,
+    int64_t dst_row_stride) {
+  constexpr int tile = 16;
+  SrcT buf[tile * tile];
+  for (int r0 = 0; r0 < rows; r0 += tile) {
+    int rt = std::min(tile, rows - r0);
+    for (int c0 = 0; c0 < cols; c0 += tile) {
+      int ct = std::min(tile, cols - c0);
+      // Gather the tile with contiguous column reads
+      for (int c = 0; c < ct; ++c) {
+        const SrcT* col = src + (c0 + c) * src_col_stride + r0;
+        for (int r = 0; r < rt; ++r) {
+          buf[r * tile + c] = col[r];
+        }
+      }
+      // Write contiguous rows
+      for (int r = 0; r < rt; ++r) {
+        DstT* out = dst + (r0 + r) * dst_row_stride + c0;
+        if constexpr (std::is_same_v<SrcT, DstT>) {
+          constexpr int S = simd::max_size<SrcT>;
+          int c = 0;
+          if (ct == tile) {
+            for (; c + S <= tile; c += S) {
+              simd::store(out + c, simd::load<SrcT, S>(buf + r * tile + c));
+            }
+          }
+          for (; c < ct; ++c) {
+            out[c] = buf[r * tile + c];
+          }
+        } else {
+          for (int c = 0; c < ct; ++c) {
+            out[c] = static_cast<DstT>(buf[r * tile + c]);
+          }
+        }
+      }
+    }
+  }
+}
+
+// True when the innermost two collapsed dims form a transpose: contiguous
+// destination rows fed from contiguous source columns
+inline bool is_transpose_2d(
+    const std::vector<Strides>& strides,
+    int ndim) {
+  return strides[0][ndim - 2] == 1 && strides[0][ndim - 1] != 1 &&
+      strides[1][ndim - 1] == 1;
+}
+
 template <typename SrcT, typename DstT>
 void copy_general_general(
     const array& src,
@@ -92,8 +151,18 @@ void copy_general_general(
       copy_dims<SrcT, DstT, 1>(
           src_ptr, dst_ptr, shape, strides[0], strides[1], 0);
     } else if (ndim == 2) {
-      copy_dims<SrcT, DstT, 2>(
-          src_ptr, dst_ptr, shape, strides[0], strides[1], 0);
+      if (is_transpose_2d(strides, ndim)) {
+        copy_transpose<SrcT, DstT>(
+            src_ptr,
+            dst_ptr,
+            shape[0],
+            shape[1],
+            strides[0][1],
+            strides[1][0]);
+      } else {
+        copy_dims<SrcT, DstT, 2>(
+            src_ptr, dst_ptr, shape, strides[0], strides[1], 0);
+      }
     } else if (ndim == 3) {
       copy_dims<SrcT, DstT, 3>(
           src_ptr, dst_ptr, shape, strides[0], strides[1], 0);
@@ -111,14 +180,27 @@ void copy_general_general(
   ContiguousIterator out(shape, strides[1], ndim - 3);
   auto stride = std::accumulate(
       shape.end() - 3, shape.end(), 1, std::multiplies<int64_t>());
+  bool transpose_2d = is_transpose_2d(strides, ndim);
   for (int64_t elem = 0; elem < size; elem += stride) {
-    copy_dims<SrcT, DstT, 3>(
-        src_ptr + in.loc,
-        dst_ptr + out.loc,
-        shape,
-        strides[0],
-        strides[1],
-        ndim - 3);
+    if (transpose_2d) {
+      for (int n = 0; n < shape[ndim - 3]; ++n) {
+        copy_transpose<SrcT, DstT>(
+            src_ptr + in.loc + n * strides[0][ndim - 3],
+            dst_ptr + out.loc + n * strides[1][ndim - 3],
+            shape[ndim - 2],
+            shape[ndim - 1],
+            strides[0][ndim - 1],
+            strides[1][ndim - 2]);
+      }
+    } else {
+      copy_dims<SrcT, DstT, 3>(
+          src_ptr + in.loc,
+          dst_ptr + out.loc,
+          shape,
+          strides[0],
+          strides[1],
+          ndim - 3);
+    }
     in.step();
     out.step();
   }
@@ -0,0 +1,168 @@
+// Copyright © 2025 Apple Inc.
+
+#include <cassert>
+#include <cmath>
+
+#include "mlx/backend/cpu/copy.h"
+#include "mlx/backend/cpu/encoder.h"
+#include "mlx/backend/cpu/simd/simd.h"
+#include "mlx/fast_primitives.h"
+#include "mlx/types/limits.h"
+
+namespace mlx::core {
+
+namespace {
+
+using namespace mlx::core::simd;
+
+template <typename T, typename AccT, typename IdxT>
+void cross_entropy(
+    const array& logits,
+    const array& targets,
+    array& out,
+    Stream stream) {
+  auto& encoder = cpu::get_command_encoder(stream);
+  encoder.set_input_array(logits);
+  encoder.set_input_array(targets);
+  encoder.set_output_array(out);
+
+  const T* in_ptr = logits.data<T>();
+  const IdxT* tgt_ptr = targets.data<IdxT>();
+  T* out_ptr = out.data<T>();
+
+  int M = logits.shape().back();
+  int L = logits.data_size() / M;
+
+  encoder.dispatch([in_ptr, tgt_ptr, out_ptr, M, L]() mutable {
+    constexpr int N = std::min(max_size<AccT>, max_size<T>);
+    const AccT neg_inf = -numeric_limits<AccT>::infinity();
+
+    for (int i = 0; i < L; i++, in_ptr += M, tgt_ptr++, out_ptr++) {
+      // One sweep over the logits: keep a running maximum and a sum of
+      // exponentials which is rescaled whenever the maximum grows, then
+      // the loss is log(sum) + max - logits[target]
+      const T* current_in_ptr = in_ptr;
+      Simd<AccT, N> vmaximum(neg_inf);
+      Simd<AccT, N> vnormalizer(0.0);
+      size_t s = M;
+      while (s >= N) {
+        Simd<AccT, N> vals = load<T, N>(current_in_ptr);
+        auto vmaximum_new = maximum(vals, vmaximum);
+        // Lanes which have seen only -inf have nothing to rescale and
+        // exponentiating (-inf) - (-inf) would poison them with NaNs
+        vnormalizer = select(
+            vmaximum_new == Simd<AccT, N>(neg_inf),
+            Simd<AccT, N>(0.0),
+            vnormalizer * exp(vmaximum - vmaximum_new) +
+                exp(vals - vmaximum_new));
+        vmaximum = vmaximum_new;
+        current_in_ptr += N;
+        s -= N;
+      }
+
+      AccT maximum = max(vmaximum);
+      AccT normalizer = 0;
+      if (maximum != neg_inf) {
+        normalizer =
+            sum(vnormalizer * exp(vmaximum - Simd<AccT, N>(maximum)));
+      }
+      while (s-- > 0) {
+        AccT val = static_cast<AccT>(*current_in_ptr++);
+        if (val > maximum) {
+          normalizer = normalizer * std::exp(maximum - val) + 1;
+          maximum = val;
+        } else if (maximum != neg_inf) {
+          normalizer += std::exp(val - maximum);
+        }
+      }
+
+      AccT lse =
+          std::isinf(maximum) ? maximum : std::log(normalizer) + maximum;
+      *out_ptr = static_cast<T>(lse - static_cast<AccT>(in_ptr[*tgt_ptr]));
+    }
+  });
+}
+
+template <typename IdxT>
+void cross_entropy_dispatch(
+    const array& logits,
+    const array& targets,
+    array& out,
+    Stream stream) {
+  switch (logits.dtype()) {
+    case float32:
+      cross_entropy<float, float, IdxT>(logits, targets, out, stream);
+      break;
+    case float16:
+      cross_entropy<float16_t, float, IdxT>(logits, targets, out, stream);
+      break;
+    case bfloat16:
+      cross_entropy<bfloat16_t, float, IdxT>(logits, targets, out, stream);
+      break;
+    case float64:
+      cross_entropy<double, double, IdxT>(logits, targets, out, stream);
+      break;
+    default:
+      throw std::runtime_error(
+          "[cross_entropy] only supports floating point logits");
+      break;
+  }
+}
+
+} // namespace
+
+void fast::CrossEntropy::eval_cpu(
+    const std::vector<array>& inputs,
+    std::vector<array>& outputs) {
+  assert(inputs.size() == 2);
+
+  auto s = stream();
+  auto& encoder = cpu::get_command_encoder(s);
+  auto ensure_row_contiguous = [&s, &encoder](const array& x) {
+    if (x.flags().row_contiguous) {
+      return x;
+    } else {
+      array x_copy = contiguous_copy_cpu(x, s);
+      encoder.add_temporary(x_copy);
+      return x_copy;
+    }
+  };
+
+  auto logits = ensure_row_contiguous(inputs[0]);
+  auto targets = ensure_row_contiguous(inputs[1]);
+  auto& out = outputs[0];
+  out.set_data(allocator::malloc(out.nbytes()));
+
+  switch (targets.dtype()) {
+    case uint8:
+      cross_entropy_dispatch<uint8_t>(logits, targets, out, s);
+      break;
+    case uint16:
+      cross_entropy_dispatch<uint16_t>(logits, targets, out, s);
+      break;
+    case uint32:
+      cross_entropy_dispatch<uint32_t>(logits, targets, out, s);
+      break;
+    case uint64:
+      cross_entropy_dispatch<uint64_t>(logits, targets, out, s);
+      break;
+    case int8:
+      cross_entropy_dispatch<int8_t>(logits, targets, out, s);
+      break;
+    case int16:
+      cross_entropy_dispatch<int16_t>(logits, targets, out, s);
+      break;
+    case int32:
+      cross_entropy_dispatch<int32_t>(logits, targets, out, s);
+      break;
+    case int64:
+      cross_entropy_dispatch<int64_t>(logits, targets, out, s);
+      break;
+    default:
+      throw std::runtime_error(
+          "[cross_entropy] targets must be integer class indices");
+      break;
+  }
+}
+
+} // namespace mlx::core
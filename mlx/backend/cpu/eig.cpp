@@ -5,6 +5,7 @@
 #include "mlx/backend/cpu/copy.h"
 #include "mlx/backend/cpu/encoder.h"
 #include "mlx/backend/cpu/lapack.h"
+#include "mlx/backend/cpu/parallel.h"
 #include "mlx/linalg.h"
 #include "mlx/primitives.h"
 
@@ -65,59 +66,66 @@ void eig_impl(
       lwork = static_cast<int>(work);
     }
 
-    auto eig_tmp_data = array::Data{allocator::malloc(sizeof(T) * N * 2)};
-    auto vec_tmp_data =
-        array::Data{allocator::malloc(vec_ptr ? sizeof(T) * N * N * 2 : 0)};
-    auto eig_tmp = static_cast<T*>(eig_tmp_data.buffer.raw_ptr());
-    auto vec_tmp = static_cast<T*>(vec_tmp_data.buffer.raw_ptr());
-    auto work_buf = array::Data{allocator::malloc(sizeof(T) * lwork)};
-    for (size_t i = 0; i < size / (N * N); ++i) {
-      geev<T>(
-          &jobl,
-          &jobr,
-          &N,
-          a_ptr,
-          &N,
-          eig_tmp,
-          eig_tmp + N,
-          vec_tmp,
-          &n_vecs_l,
-          nullptr,
-          &n_vecs_r,
-          static_cast<T*>(work_buf.buffer.raw_ptr()),
-          &lwork,
-          &info);
-      for (int i = 0; i < N; ++i) {
-        eig_ptr[i] = {eig_tmp[i], eig_tmp[N + i]};
-      }
-      if (vec_ptr) {
+    size_t num_matrices = size / (N * N);
+    // The matrices are independent, so chunks of the batch run on the
+    // worker pool, each with its own scratch space.
+    parallel_for(num_matrices, [&](size_t start, size_t end) {
+      auto eig_tmp_data = array::Data{allocator::malloc(sizeof(T) * N * 2)};
+      auto vec_tmp_data =
+          array::Data{allocator::malloc(vec_ptr ? sizeof(T) * N * N * 2 : 0)};
+      auto eig_tmp = static_cast<T*>(eig_tmp_data.buffer.raw_ptr());
+      auto vec_tmp = static_cast<T*>(vec_tmp_data.buffer.raw_ptr());
+      auto work_buf = array::Data{allocator::malloc(sizeof(T) * lwork)};
+      for (size_t m = start; m < end; ++m) {
+        auto a_m = a_ptr + m * N * N;
+        auto eig_m = eig_ptr + m * N;
+        auto vec_m = vec_ptr ? vec_ptr + m * N * N : nullptr;
+        int n = N;
+        int info;
+        geev<T>(
+            &jobl,
+            &jobr,
+            &n,
+            a_m,
+            &n,
+            eig_tmp,
+            eig_tmp + N,
+            vec_tmp,
+            &n_vecs_l,
+            nullptr,
+            &n_vecs_r,
+            static_cast<T*>(work_buf.buffer.raw_ptr()),
+            &lwork,
+            &info);
         for (int i = 0; i < N; ++i) {
-          if (eig_ptr[i].imag() != 0) {
-            // This vector and the next are a pair
-            for (int j = 0; j < N; ++j) {
-              vec_ptr[i * N + j] = {
-                  vec_tmp[i * N + j], -vec_tmp[(i + 1) * N + j]};
-              vec_ptr[(i + 1) * N + j] = {
-                  vec_tmp[i * N + j], vec_tmp[(i + 1) * N + j]};
-            }
-            i += 1;
-          } else {
-            for (int j = 0; j < N; ++j) {
-              vec_ptr[i * N + j] = {vec_tmp[i * N + j], 0};
+          eig_m[i] = {eig_tmp[i], eig_tmp[N + i]};
+        }
+        if (vec_m) {
+          for (int i = 0; i < N; ++i) {
+            if (eig_m[i].imag() != 0) {
+              // This vector and the next are a pair
+              for (int j = 0; j < N; ++j) {
+                vec_m[i * N + j] = {
+                    vec_tmp[i * N + j], -vec_tmp[(i + 1) * N + j]};
+                vec_m[(i + 1) * N + j] = {
+                    vec_tmp[i * N + j], vec_tmp[(i + 1) * N + j]};
+              }
+              i += 1;
+            } else {
+              for (int j = 0; j < N; ++j) {
+                vec_m[i * N + j] = {vec_tmp[i * N + j], 0};
+              }
             }
           }
         }
-        vec_ptr += N * N;
-      }
-      a_ptr += N * N;
-      eig_ptr += N;
-      if (info != 0) {
-        std::stringstream msg;
-        msg << "[Eig::eval_cpu] Eigenvalue decomposition failed with error code "
-            << info;
-        throw std::runtime_error(msg.str());
+        if (info != 0) {
+          std::stringstream msg;
+          msg << "[Eig::eval_cpu] Eigenvalue decomposition failed with error code "
+              << info;
+          throw std::runtime_error(msg.str());
+        }
       }
-    }
+    });
   });
   encoder.add_temporary(a);
 }
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <unordered_map>
+#include <unordered_set>
 
 #include "mlx/array.h"
 #include "mlx/scheduler.h"
@@ -40,14 +41,47 @@ struct CommandEncoder {
     return temporaries_;
   }
 
+  // Release the buffers once every already scheduled task which uses them
+  // is done. The frees are batched on the stream thread and dropped at
+  // the next task boundary instead of rendezvousing with the allocator
+  // once per op.
+  void retire(
+      std::unordered_set<std::shared_ptr<array::Data>> buffers,
+      std::vector<array> temps) {
+    dispatch([retired = retired_,
+              buffers = std::move(buffers),
+              temps = std::move(temps)]() {
+      retired->reserve(retired->size() + buffers.size() + temps.size());
+      for (auto& b : buffers) {
+        retired->push_back(b);
+      }
+      for (auto& t : temps) {
+        retired->push_back(t.data_shared_ptr());
+      }
+    });
+  }
+
+  // Drop the current retired batch without waiting for the next task
+  // boundary. Called at fence crossings (the end of an eval) so an idle
+  // stream does not pin the last batch; in particular the buffers the
+  // synchronizer retires would otherwise stay alive and block donation
+  // of eval outputs fed into the next graph.
+  void flush_retired() {
+    dispatch([retired = retired_]() { retired->clear(); });
+  }
+
   template <class F, class... Args>
   void dispatch(F&& f, Args&&... args) {
     num_ops_ = (num_ops_ + 1) % DISPATCHES_PER_TASK;
     auto task = std::bind(std::forward<F>(f), std::forward<Args>(args)...);
     if (num_ops_ == 0) {
       scheduler::notify_new_task(stream_);
-      auto task_wrap = [s = stream_, task = std::move(task)]() mutable {
+      auto task_wrap = [s = stream_,
+                        retired = retired_,
+                        task = std::move(task)]() mutable {
         task();
+        // Drop everything retired since the previous boundary in one batch
+        retired->clear();
         scheduler::notify_task_completion(s);
       };
       scheduler::enqueue(stream_, std::move(task_wrap));
@@ -59,6 +93,10 @@ struct CommandEncoder {
  private:
   Stream stream_;
   std::vector<array> temporaries_;
+  // Buffers waiting to be freed, appended and cleared only from tasks on
+  // the stream thread (see retire)
+  std::shared_ptr<std::vector<std::shared_ptr<array::Data>>> retired_{
+      std::make_shared<std::vector<std::shared_ptr<array::Data>>>()};
   int num_ops_{0};
 };
 
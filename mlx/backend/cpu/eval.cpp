@@ -33,8 +33,7 @@ void eval(array& arr) {
     buffers.erase(it);
   }
   auto& encoder = cpu::get_command_encoder(s);
-  encoder.dispatch([buffers = std::move(buffers),
-                    temps = std::move(encoder.temporaries())]() {});
+  encoder.retire(std::move(buffers), std::move(encoder.temporaries()));
 }
 
 } // namespace mlx::core::cpu
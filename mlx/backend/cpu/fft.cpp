@@ -5,10 +5,40 @@
 #include "mlx/3rdparty/pocketfft.h"
 #include "mlx/allocator.h"
 #include "mlx/backend/cpu/encoder.h"
+#include "mlx/backend/cpu/parallel.h"
 #include "mlx/primitives.h"
 
 namespace mlx::core {
 
+namespace {
+
+// Transform batches below this many total elements stay single threaded;
+// the fork/join cost swamps the transforms themselves
+constexpr size_t multithreaded_fft_min_size = 1 << 17;
+
+// How many threads to hand pocketfft. It distributes the independent
+// transforms of a batch over its internal pool and vectorizes across
+// them where the layout allows, so batches of small transforms scale
+// with cores instead of running through one row at a time.
+size_t fft_thread_count(
+    const std::vector<size_t>& shape,
+    const std::vector<size_t>& axes) {
+  size_t total = 1;
+  for (auto s : shape) {
+    total *= s;
+  }
+  size_t transform_size = 1;
+  for (auto ax : axes) {
+    transform_size *= shape[ax];
+  }
+  if (total < multithreaded_fft_min_size || total == transform_size) {
+    return 1;
+  }
+  return cpu_pool_num_threads();
+}
+
+} // namespace
+
 void FFT::eval_cpu(const std::vector<array>& inputs, array& out) {
   auto& in = inputs[0];
   std::vector<std::ptrdiff_t> strides_in(
@@ -40,6 +70,8 @@ void FFT::eval_cpu(const std::vector<array>& inputs, array& out) {
     scale /= nelem;
   }
 
+  auto nthreads = fft_thread_count(shape, axes_);
+
   auto& encoder = cpu::get_command_encoder(stream());
   encoder.set_input_array(in);
   encoder.set_output_array(out);
@@ -56,7 +88,8 @@ void FFT::eval_cpu(const std::vector<array>& inputs, array& out) {
                       inverse = inverse_,
                       in_ptr,
                       out_ptr,
-                      scale]() {
+                      scale,
+                      nthreads]() {
       pocketfft::c2c(
           shape,
           strides_in,
@@ -65,7 +98,8 @@ void FFT::eval_cpu(const std::vector<array>& inputs, array& out) {
           !inverse,
           in_ptr,
           out_ptr,
-          scale);
+          scale,
+          nthreads);
     });
   } else if (in.dtype() == float32 && out.dtype() == complex64) {
     auto in_ptr = in.data<float>();
@@ -78,7 +112,8 @@ void FFT::eval_cpu(const std::vector<array>& inputs, array& out) {
                       inverse = inverse_,
                       in_ptr,
                       out_ptr,
-                      scale]() {
+                      scale,
+                      nthreads]() {
       pocketfft::r2c(
           shape,
           strides_in,
@@ -87,7 +122,8 @@ void FFT::eval_cpu(const std::vector<array>& inputs, array& out) {
           !inverse,
           in_ptr,
           out_ptr,
-          scale);
+          scale,
+          nthreads);
     });
   } else if (in.dtype() == complex64 && out.dtype() == float32) {
     auto in_ptr =
@@ -100,7 +136,8 @@ void FFT::eval_cpu(const std::vector<array>& inputs, array& out) {
                       inverse = inverse_,
                       in_ptr,
                       out_ptr,
-                      scale]() {
+                      scale,
+                      nthreads]() {
       pocketfft::c2r(
           shape,
           strides_in,
@@ -109,7 +146,8 @@ void FFT::eval_cpu(const std::vector<array>& inputs, array& out) {
           !inverse,
           in_ptr,
           out_ptr,
-          scale);
+          scale,
+          nthreads);
     });
   } else {
     throw std::runtime_error(
@@ -1,40 +1,121 @@
 // Copyright © 2025 Apple Inc.
 #pragma once
 
+#include "mlx/backend/cpu/parallel.h"
 #include "mlx/backend/cpu/simd/simd.h"
+#include "mlx/utils.h"
+
+#ifdef MLX_GEMM_RUNTIME_DISPATCH
+#include "mlx/backend/cpu/gemms/simd_gemm_dispatch.h"
+#endif
 
 namespace mlx::core {
 
+#include "mlx/backend/cpu/gemms/simd_gemm_kernel.h"
+
 inline int ceildiv(int a, int b) {
   return (a + b - 1) / b;
 }
 
-template <int block_size, typename T, typename AccT>
-void load_block(
-    const T* in,
-    AccT* out,
+// Threads used for a single gemm; defaults to the shared CPU pool size
+// (MLX_CPU_GEMM_THREADS overrides)
+inline int gemm_num_threads() {
+  static int num_threads = std::max(
+      env::get_var("MLX_CPU_GEMM_THREADS", cpu_pool_num_threads()), 1);
+  return num_threads;
+}
+
+// Fan tile_fn(t_begin, t_end) out over contiguous chunks of the flattened
+// (M, N) output tile grid. Tiles write disjoint regions of the output, so
+// the chunks need no synchronization beyond joining the futures.
+template <typename F>
+void simd_gemm_dispatch_tiles(int M, int N, int K, F tile_fn) {
+  // Stay single threaded below ~4 MFLOPs where the enqueue overhead and
+  // cold per-thread tile buffers cost more than they save
+  constexpr size_t min_parallel_flops = 1ULL << 21;
+
+  int total_tiles =
+      ceildiv(M, gemm_block_size) * ceildiv(N, gemm_block_size);
+  int threads = std::min(gemm_num_threads(), total_tiles);
+  if (size_t(M) * N * K < min_parallel_flops) {
+    threads = 1;
+  }
+  if (threads <= 1) {
+    tile_fn(0, total_tiles);
+    return;
+  }
+
+  auto& pool = cpu_thread_pool();
+  std::vector<std::future<void>> futures;
+  futures.reserve(threads);
+  int chunk = ceildiv(total_tiles, threads);
+  for (int t = 0; t < total_tiles; t += chunk) {
+    futures.push_back(pool.enqueue(
+        [tile_fn, t, t_end = std::min(t + chunk, total_tiles)]() {
+          tile_fn(t, t_end);
+        }));
+  }
+  for (auto& f : futures) {
+    f.wait();
+  }
+}
+
+#ifdef MLX_GEMM_RUNTIME_DISPATCH
+
+// Run a gemm through the per-ISA kernel chosen at startup. The variants
+// work on float panels, so the input is converted up front (which also
+// stops the tile kernel re-converting each panel element per tile) and the
+// result is converted back after the tiles are joined.
+template <typename T>
+void simd_gemm_dispatched(
+    const T* a,
+    const T* b,
+    T* c,
+    bool a_trans,
+    bool b_trans,
     int M,
     int N,
-    int i,
-    int j,
-    bool transpose) {
-  if (transpose) {
-    for (int ii = 0; ii < block_size && i * block_size + ii < M; ++ii) {
-      for (int jj = 0; jj < block_size && j * block_size + jj < N; ++jj) {
-        out[jj * block_size + ii] =
-            in[(i * block_size + ii) * N + j * block_size + jj];
-      }
+    int K,
+    float alpha,
+    float beta) {
+  auto kernel = select_gemm_kernel();
+  std::vector<float> af(size_t(M) * K);
+  std::vector<float> bf(size_t(K) * N);
+  std::vector<float> cf(size_t(M) * N);
+  for (size_t i = 0; i < af.size(); ++i) {
+    af[i] = static_cast<float>(a[i]);
+  }
+  for (size_t i = 0; i < bf.size(); ++i) {
+    bf[i] = static_cast<float>(b[i]);
+  }
+  simd_gemm_dispatch_tiles(M, N, K, [&](int t_begin, int t_end) {
+    kernel(
+        af.data(),
+        bf.data(),
+        cf.data(),
+        a_trans,
+        b_trans,
+        M,
+        N,
+        K,
+        alpha,
+        0.0f,
+        t_begin,
+        t_end);
+  });
+  if (beta != 0) {
+    for (size_t i = 0; i < cf.size(); ++i) {
+      c[i] = static_cast<T>(cf[i] + beta * static_cast<float>(c[i]));
     }
   } else {
-    for (int ii = 0; ii < block_size && i * block_size + ii < M; ++ii) {
-      for (int jj = 0; jj < block_size && j * block_size + jj < N; ++jj) {
-        out[ii * block_size + jj] =
-            in[(i * block_size + ii) * N + j * block_size + jj];
-      }
+    for (size_t i = 0; i < cf.size(); ++i) {
+      c[i] = static_cast<T>(cf[i]);
     }
   }
 }
 
+#endif // MLX_GEMM_RUNTIME_DISPATCH
+
 template <typename T, typename AccT>
 void simd_gemm(
     const T* a,
@@ -47,93 +128,42 @@ void simd_gemm(
     int K,
     float alpha,
     float beta) {
-  constexpr int block_size = 16;
-  constexpr int simd_size = simd::max_size<AccT>;
-  static_assert(
-      (block_size % simd_size) == 0,
-      "Block size must be divisible by SIMD size");
-
-  int last_k_block_size = K - block_size * (K / block_size);
-  int last_k_simd_block = (last_k_block_size / simd_size) * simd_size;
-  for (int i = 0; i < ceildiv(M, block_size); i++) {
-    for (int j = 0; j < ceildiv(N, block_size); j++) {
-      AccT c_block[block_size * block_size] = {0.0};
-      AccT a_block[block_size * block_size];
-      AccT b_block[block_size * block_size];
-
-      int k = 0;
-      for (; k < K / block_size; k++) {
-        // Load a and b blocks
-        if (a_trans) {
-          load_block<block_size>(a, a_block, K, M, k, i, true);
-        } else {
-          load_block<block_size>(a, a_block, M, K, i, k, false);
-        }
-        if (b_trans) {
-          load_block<block_size>(b, b_block, N, K, j, k, false);
-        } else {
-          load_block<block_size>(b, b_block, K, N, k, j, true);
-        }
-
-        // Multiply and accumulate
-        for (int ii = 0; ii < block_size && i * block_size + ii < M; ++ii) {
-          for (int jj = 0; jj < block_size && j * block_size + jj < N; ++jj) {
-            for (int kk = 0; kk < block_size; kk += simd_size) {
-              auto av =
-                  simd::load<AccT, simd_size>(a_block + ii * block_size + kk);
-              auto bv =
-                  simd::load<AccT, simd_size>(b_block + jj * block_size + kk);
-              c_block[ii * block_size + jj] += simd::sum(av * bv);
-            }
-          }
-        }
-      }
-      if (last_k_block_size) {
-        // Load a and b blocks
-        if (a_trans) {
-          load_block<block_size>(a, a_block, K, M, k, i, true);
-        } else {
-          load_block<block_size>(a, a_block, M, K, i, k, false);
-        }
-        if (b_trans) {
-          load_block<block_size>(b, b_block, N, K, j, k, false);
-        } else {
-          load_block<block_size>(b, b_block, K, N, k, j, true);
-        }
-
-        // Multiply and accumulate
-        for (int ii = 0; ii < block_size && i * block_size + ii < M; ++ii) {
-          for (int jj = 0; jj < block_size && j * block_size + jj < N; ++jj) {
-            int kk = 0;
-            for (; kk < last_k_simd_block; kk += simd_size) {
-              auto av =
-                  simd::load<AccT, simd_size>(a_block + ii * block_size + kk);
-              auto bv =
-                  simd::load<AccT, simd_size>(b_block + jj * block_size + kk);
-              c_block[ii * block_size + jj] += simd::sum(av * bv);
-            }
-            for (; kk < last_k_block_size; ++kk) {
-              c_block[ii * block_size + jj] +=
-                  a_block[ii * block_size + kk] * b_block[jj * block_size + kk];
-            }
-          }
-        }
-      }
-
-      // Store
-      for (int ii = 0; ii < block_size && i * block_size + ii < M; ++ii) {
-        for (int jj = 0; jj < block_size && j * block_size + jj < N; ++jj) {
-          auto c_idx = (i * block_size + ii) * N + j * block_size + jj;
-          if (beta != 0) {
-            c[c_idx] = static_cast<T>(
-                alpha * c_block[ii * block_size + jj] + beta * c[c_idx]);
-          } else {
-            c[c_idx] = static_cast<T>(alpha * c_block[ii * block_size + jj]);
-          }
-        }
-      }
+#ifdef MLX_GEMM_BF16_DISPATCH
+  // On machines with native bf16 dot products keep the panels in bf16 and
+  // let the hardware widen inside the instruction
+  if constexpr (std::is_same_v<T, bfloat16_t>) {
+    if (auto kernel = select_gemm_bf16_kernel()) {
+      simd_gemm_dispatch_tiles(M, N, K, [=](int t_begin, int t_end) {
+        kernel(
+            reinterpret_cast<const uint16_t*>(a),
+            reinterpret_cast<const uint16_t*>(b),
+            reinterpret_cast<uint16_t*>(c),
+            a_trans,
+            b_trans,
+            M,
+            N,
+            K,
+            alpha,
+            beta,
+            t_begin,
+            t_end);
+      });
+      return;
     }
   }
+#endif
+#ifdef MLX_GEMM_RUNTIME_DISPATCH
+  // Half precision gemms accumulate in float; route them to the kernel
+  // compiled for this machine's vector width
+  if constexpr (!std::is_same_v<T, float> && std::is_same_v<AccT, float>) {
+    simd_gemm_dispatched<T>(a, b, c, a_trans, b_trans, M, N, K, alpha, beta);
+    return;
+  }
+#endif
+  simd_gemm_dispatch_tiles(M, N, K, [=](int t_begin, int t_end) {
+    simd_gemm_tile_range<T, AccT>(
+        a, b, c, a_trans, b_trans, M, N, K, alpha, beta, t_begin, t_end);
+  });
 }
 
 } // namespace mlx::core
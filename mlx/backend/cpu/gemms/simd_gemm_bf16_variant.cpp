@@ -0,0 +1,142 @@
+// Copyright © 2025 Apple Inc.
+
+// Native bf16 block gemm built around VDPBF16PS, compiled with
+// -mavx512bf16 and picked at startup through select_gemm_bf16_kernel; see
+// the gemms section of the cpu CMakeLists. Unlike the float variants the
+// panels stay in bf16 all the way into the dot product: each instruction
+// consumes 32 bf16 inputs and accumulates 16 fp32 lanes, so the kernel
+// moves half the panel bytes and retires twice the multiplies per
+// instruction compared to upconverting lane-by-lane.
+//
+// The kernel works on raw uint16_t bf16 bits so it shares no
+// half-conversion symbols with the baseline-compiled objects.
+
+#include <immintrin.h>
+#include <stdint.h>
+#include <algorithm>
+#include <cstring>
+
+#include "mlx/backend/cpu/gemms/simd_gemm_dispatch.h"
+
+namespace mlx::core::gemm_avx512bf16 {
+
+namespace {
+
+constexpr int block_size = 16;
+
+// Bounds-guarded block copy matching load_block in simd_gemm_kernel.h;
+// callers zero the destination first so short blocks stay zero padded
+// (bf16 zero bits multiply to zero, which also covers the K tail).
+void load_block(
+    const uint16_t* in,
+    uint16_t* out,
+    int M,
+    int N,
+    int i,
+    int j,
+    bool transpose) {
+  if (transpose) {
+    for (int ii = 0; ii < block_size && i * block_size + ii < M; ++ii) {
+      for (int jj = 0; jj < block_size && j * block_size + jj < N; ++jj) {
+        out[jj * block_size + ii] =
+            in[(i * block_size + ii) * N + j * block_size + jj];
+      }
+    }
+  } else {
+    for (int ii = 0; ii < block_size && i * block_size + ii < M; ++ii) {
+      for (int jj = 0; jj < block_size && j * block_size + jj < N; ++jj) {
+        out[ii * block_size + jj] =
+            in[(i * block_size + ii) * N + j * block_size + jj];
+      }
+    }
+  }
+}
+
+} // namespace
+
+void gemm_bf16_tiles(
+    const uint16_t* a,
+    const uint16_t* b,
+    uint16_t* c,
+    bool a_trans,
+    bool b_trans,
+    int M,
+    int N,
+    int K,
+    float alpha,
+    float beta,
+    int t_begin,
+    int t_end) {
+  int n_tiles = (N + block_size - 1) / block_size;
+  int k_blocks = (K + block_size - 1) / block_size;
+
+  for (int t = t_begin; t < t_end; ++t) {
+    int i = t / n_tiles;
+    int j = t % n_tiles;
+
+    // a_block rows follow m, b_block rows follow k; both padded with zeros
+    alignas(64) uint16_t a_block[block_size * block_size];
+    alignas(64) uint16_t b_block[block_size * block_size];
+
+    // One fp32 accumulator of 16 output columns per row of the tile
+    __m512 acc[block_size];
+    for (int ii = 0; ii < block_size; ++ii) {
+      acc[ii] = _mm512_setzero_ps();
+    }
+
+    for (int k = 0; k < k_blocks; ++k) {
+      std::memset(a_block, 0, sizeof(a_block));
+      std::memset(b_block, 0, sizeof(b_block));
+      if (a_trans) {
+        load_block(a, a_block, K, M, k, i, true);
+      } else {
+        load_block(a, a_block, M, K, i, k, false);
+      }
+      if (b_trans) {
+        load_block(b, b_block, N, K, j, k, true);
+      } else {
+        load_block(b, b_block, K, N, k, j, false);
+      }
+
+      for (int kk = 0; kk < block_size; kk += 2) {
+        // Interleave rows kk and kk + 1 of b so lane jj holds the bf16
+        // pair (b[kk][jj], b[kk + 1][jj]) that VDPBF16PS reduces
+        auto r0 = _mm256_load_si256(
+            reinterpret_cast<const __m256i*>(b_block + kk * block_size));
+        auto r1 = _mm256_load_si256(
+            reinterpret_cast<const __m256i*>(b_block + (kk + 1) * block_size));
+        auto b_pairs = _mm512_or_si512(
+            _mm512_cvtepu16_epi32(r0),
+            _mm512_slli_epi32(_mm512_cvtepu16_epi32(r1), 16));
+
+        for (int ii = 0; ii < block_size; ++ii) {
+          uint32_t a_pair;
+          std::memcpy(&a_pair, a_block + ii * block_size + kk, sizeof(a_pair));
+          acc[ii] = _mm512_dpbf16_ps(
+              acc[ii],
+              (__m512bh)_mm512_set1_epi32(a_pair),
+              (__m512bh)b_pairs);
+        }
+      }
+    }
+
+    // Store, rounding back to bf16
+    int m0 = i * block_size;
+    int n0 = j * block_size;
+    int n_valid = std::min(block_size, N - n0);
+    __mmask16 n_mask = static_cast<__mmask16>((1u << n_valid) - 1);
+    for (int ii = 0; ii < block_size && m0 + ii < M; ++ii) {
+      uint16_t* c_row = c + size_t(m0 + ii) * N + n0;
+      auto r = _mm512_mul_ps(acc[ii], _mm512_set1_ps(alpha));
+      if (beta != 0) {
+        auto c_old = _mm256_maskz_loadu_epi16(n_mask, c_row);
+        auto c_oldf = _mm512_castsi512_ps(
+            _mm512_slli_epi32(_mm512_cvtepu16_epi32(c_old), 16));
+        r = _mm512_fmadd_ps(_mm512_set1_ps(beta), c_oldf, r);
+      }
+      _mm256_mask_storeu_epi16(c_row, n_mask, (__m256i)_mm512_cvtneps_pbh(r));
+    }
+  }
+}
+
+} // namespace mlx::core::gemm_avx512bf16
@@ -0,0 +1,143 @@
+// Copyright © 2025 Apple Inc.
+#pragma once
+
+// Runtime selection between the per-ISA gemm kernels built from
+// simd_gemm_variant.cpp (see the gemms section of the cpu CMakeLists). The
+// variants operate on float panels so they share no inline half-precision
+// conversion symbols with the rest of the library; converting to and from
+// float happens once in the (baseline compiled) callers.
+
+namespace mlx::core {
+
+// A contiguous range of output tiles: (a, b, c, a_trans, b_trans, M, N, K,
+// alpha, beta, t_begin, t_end); see simd_gemm_tile_range
+using gemm_tile_fn = void (*)(
+    const float*,
+    const float*,
+    float*,
+    bool,
+    bool,
+    int,
+    int,
+    int,
+    float,
+    float,
+    int,
+    int);
+
+namespace gemm_base {
+void gemm_tiles(
+    const float* a,
+    const float* b,
+    float* c,
+    bool a_trans,
+    bool b_trans,
+    int M,
+    int N,
+    int K,
+    float alpha,
+    float beta,
+    int t_begin,
+    int t_end);
+} // namespace gemm_base
+
+namespace gemm_avx2 {
+void gemm_tiles(
+    const float* a,
+    const float* b,
+    float* c,
+    bool a_trans,
+    bool b_trans,
+    int M,
+    int N,
+    int K,
+    float alpha,
+    float beta,
+    int t_begin,
+    int t_end);
+} // namespace gemm_avx2
+
+namespace gemm_avx512 {
+void gemm_tiles(
+    const float* a,
+    const float* b,
+    float* c,
+    bool a_trans,
+    bool b_trans,
+    int M,
+    int N,
+    int K,
+    float alpha,
+    float beta,
+    int t_begin,
+    int t_end);
+} // namespace gemm_avx512
+
+#ifdef MLX_GEMM_BF16_DISPATCH
+
+// Same tile-range contract as gemm_tile_fn but consuming raw bf16 bits and
+// accumulating with the native bf16 dot-product instructions; see
+// simd_gemm_bf16_variant.cpp
+using gemm_bf16_tile_fn = void (*)(
+    const uint16_t*,
+    const uint16_t*,
+    uint16_t*,
+    bool,
+    bool,
+    int,
+    int,
+    int,
+    float,
+    float,
+    int,
+    int);
+
+namespace gemm_avx512bf16 {
+void gemm_bf16_tiles(
+    const uint16_t* a,
+    const uint16_t* b,
+    uint16_t* c,
+    bool a_trans,
+    bool b_trans,
+    int M,
+    int N,
+    int K,
+    float alpha,
+    float beta,
+    int t_begin,
+    int t_end);
+} // namespace gemm_avx512bf16
+
+// Null when this machine has no native bf16 dot product; callers then take
+// the float-panel route through select_gemm_kernel
+inline gemm_bf16_tile_fn select_gemm_bf16_kernel() {
+  static gemm_bf16_tile_fn kernel = []() -> gemm_bf16_tile_fn {
+    if (__builtin_cpu_supports("avx512bf16") &&
+        __builtin_cpu_supports("avx512bw") &&
+        __builtin_cpu_supports("avx512vl")) {
+      return gemm_avx512bf16::gemm_bf16_tiles;
+    }
+    return nullptr;
+  }();
+  return kernel;
+}
+
+#endif // MLX_GEMM_BF16_DISPATCH
+
+inline gemm_tile_fn select_gemm_kernel() {
+  static gemm_tile_fn kernel = []() {
+    if (__builtin_cpu_supports("avx512f") &&
+        __builtin_cpu_supports("avx512bw") &&
+        __builtin_cpu_supports("avx512dq") &&
+        __builtin_cpu_supports("avx512vl")) {
+      return gemm_avx512::gemm_tiles;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+      return gemm_avx2::gemm_tiles;
+    }
+    return gemm_base::gemm_tiles;
+  }();
+  return kernel;
+}
+
+} // namespace mlx::core
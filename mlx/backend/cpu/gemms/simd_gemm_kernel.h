@@ -0,0 +1,149 @@
+// Copyright © 2025 Apple Inc.
+#pragma once
+
+// The block gemm kernel, separated from the thread-pool driver in
+// simd_gemm.h so it can be compiled once per instruction set. This header
+// deliberately has no includes: it references only the simd layer and must
+// be included after the simd headers, either at mlx::core scope (see
+// simd_gemm.h) or inside a per-ISA namespace (see simd_gemm_variant.cpp) so
+// that every instantiation is a distinct symbol and objects built with
+// different vector widths cannot be merged by the linker.
+
+constexpr int gemm_block_size = 16;
+
+inline constexpr int gemm_ceildiv(int a, int b) {
+  return (a + b - 1) / b;
+}
+
+template <int block_size, typename T, typename AccT>
+void load_block(
+    const T* in,
+    AccT* out,
+    int M,
+    int N,
+    int i,
+    int j,
+    bool transpose) {
+  if (transpose) {
+    for (int ii = 0; ii < block_size && i * block_size + ii < M; ++ii) {
+      for (int jj = 0; jj < block_size && j * block_size + jj < N; ++jj) {
+        out[jj * block_size + ii] =
+            in[(i * block_size + ii) * N + j * block_size + jj];
+      }
+    }
+  } else {
+    for (int ii = 0; ii < block_size && i * block_size + ii < M; ++ii) {
+      for (int jj = 0; jj < block_size && j * block_size + jj < N; ++jj) {
+        out[ii * block_size + jj] =
+            in[(i * block_size + ii) * N + j * block_size + jj];
+      }
+    }
+  }
+}
+
+// Compute a contiguous range [t_begin, t_end) of output tiles, flattened
+// row-major over the (M / block_size, N / block_size) tile grid so that a
+// range reuses the same rows of A across adjacent tiles.
+template <typename T, typename AccT>
+void simd_gemm_tile_range(
+    const T* a,
+    const T* b,
+    T* c,
+    bool a_trans,
+    bool b_trans,
+    int M,
+    int N,
+    int K,
+    float alpha,
+    float beta,
+    int t_begin,
+    int t_end) {
+  constexpr int block_size = gemm_block_size;
+  constexpr int simd_size = simd::max_size<AccT>;
+  static_assert(
+      (block_size % simd_size) == 0,
+      "Block size must be divisible by SIMD size");
+
+  int last_k_block_size = K - block_size * (K / block_size);
+  int last_k_simd_block = (last_k_block_size / simd_size) * simd_size;
+  int n_tiles = gemm_ceildiv(N, block_size);
+  for (int t = t_begin; t < t_end; ++t) {
+    int i = t / n_tiles;
+    int j = t % n_tiles;
+    AccT c_block[block_size * block_size] = {0.0};
+    AccT a_block[block_size * block_size];
+    AccT b_block[block_size * block_size];
+
+    int k = 0;
+    for (; k < K / block_size; k++) {
+      // Load a and b blocks
+      if (a_trans) {
+        load_block<block_size>(a, a_block, K, M, k, i, true);
+      } else {
+        load_block<block_size>(a, a_block, M, K, i, k, false);
+      }
+      if (b_trans) {
+        load_block<block_size>(b, b_block, N, K, j, k, false);
+      } else {
+        load_block<block_size>(b, b_block, K, N, k, j, true);
+      }
+
+      // Multiply and accumulate
+      for (int ii = 0; ii < block_size && i * block_size + ii < M; ++ii) {
+        for (int jj = 0; jj < block_size && j * block_size + jj < N; ++jj) {
+          for (int kk = 0; kk < block_size; kk += simd_size) {
+            auto av =
+                simd::load<AccT, simd_size>(a_block + ii * block_size + kk);
+            auto bv =
+                simd::load<AccT, simd_size>(b_block + jj * block_size + kk);
+            c_block[ii * block_size + jj] += simd::sum(av * bv);
+          }
+        }
+      }
+    }
+    if (last_k_block_size) {
+      // Load a and b blocks
+      if (a_trans) {
+        load_block<block_size>(a, a_block, K, M, k, i, true);
+      } else {
+        load_block<block_size>(a, a_block, M, K, i, k, false);
+      }
+      if (b_trans) {
+        load_block<block_size>(b, b_block, N, K, j, k, false);
+      } else {
+        load_block<block_size>(b, b_block, K, N, k, j, true);
+      }
+
+      // Multiply and accumulate
+      for (int ii = 0; ii < block_size && i * block_size + ii < M; ++ii) {
+        for (int jj = 0; jj < block_size && j * block_size + jj < N; ++jj) {
+          int kk = 0;
+          for (; kk < last_k_simd_block; kk += simd_size) {
+            auto av =
+                simd::load<AccT, simd_size>(a_block + ii * block_size + kk);
+            auto bv =
+                simd::load<AccT, simd_size>(b_block + jj * block_size + kk);
+            c_block[ii * block_size + jj] += simd::sum(av * bv);
+          }
+          for (; kk < last_k_block_size; ++kk) {
+            c_block[ii * block_size + jj] +=
+                a_block[ii * block_size + kk] * b_block[jj * block_size + kk];
+          }
+        }
+      }
+    }
+
+    // Store
+    for (int ii = 0; ii < block_size && i * block_size + ii < M; ++ii) {
+      for (int jj = 0; jj < block_size && j * block_size + jj < N; ++jj) {
+        auto c_idx = (i * block_size + ii) * N + j * block_size + jj;
+        if (beta != 0) {
+          c[c_idx] = static_cast<T>(
+              alpha * c_block[ii * block_size + jj] + beta * c[c_idx]);
+        } else {
+          c[c_idx] = static_cast<T>(alpha * c_block[ii * block_size + jj]);
+        }
+      }
+    }
+  }
+}
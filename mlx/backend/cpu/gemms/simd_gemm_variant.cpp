@@ -0,0 +1,57 @@
+// Copyright © 2025 Apple Inc.
+
+// Compiled once per instruction set level with MLX_GEMM_VARIANT set to the
+// namespace for that level (gemm_base, gemm_avx2, gemm_avx512) and the
+// matching -m flags; see the gemms section of the cpu CMakeLists. The simd
+// headers and the kernel are included *inside* the variant namespace so all
+// of their instantiations are distinct symbols per object file — otherwise
+// the linker would keep a single (arbitrary) copy of each weak template
+// symbol across the differently vectorized objects.
+//
+// The standard headers the simd layer needs are pulled in ahead of the
+// namespace so their include guards keep them at global scope.
+
+#include <stdint.h>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstring>
+#include <functional>
+
+#include "mlx/backend/cpu/gemms/simd_gemm_dispatch.h"
+
+#ifndef MLX_GEMM_VARIANT
+#define MLX_GEMM_VARIANT gemm_base
+#endif
+
+namespace mlx::core::MLX_GEMM_VARIANT {
+
+#include "mlx/backend/cpu/simd/base_simd.h"
+#if defined(__AVX2__)
+#include "mlx/backend/cpu/simd/avx_simd.h"
+#endif
+
+// The simd headers land in a nested namespace here; give the kernel the
+// name it expects
+namespace simd = mlx::core::simd;
+
+#include "mlx/backend/cpu/gemms/simd_gemm_kernel.h"
+
+void gemm_tiles(
+    const float* a,
+    const float* b,
+    float* c,
+    bool a_trans,
+    bool b_trans,
+    int M,
+    int N,
+    int K,
+    float alpha,
+    float beta,
+    int t_begin,
+    int t_end) {
+  simd_gemm_tile_range<float, float>(
+      a, b, c, a_trans, b_trans, M, N, K, alpha, beta, t_begin, t_end);
+}
+
+} // namespace mlx::core::MLX_GEMM_VARIANT
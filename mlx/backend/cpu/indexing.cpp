@@ -2,6 +2,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <mutex>
 
 #include "mlx/allocator.h"
 #include "mlx/primitives.h"
@@ -9,9 +10,14 @@
 #include "mlx/backend/common/utils.h"
 #include "mlx/backend/cpu/copy.h"
 #include "mlx/backend/cpu/encoder.h"
+#include "mlx/backend/cpu/parallel.h"
 
 namespace mlx::core {
 
+// Gathers under this many bytes stay on the calling thread; above it the
+// index space is split over the worker pool
+constexpr size_t min_parallel_gather_bytes = 1 << 20;
+
 template <typename IdxT>
 inline size_t offset_neg_idx(IdxT idx, size_t size) {
   return (idx < 0) ? idx + size : idx;
@@ -106,40 +112,61 @@ void gather(
     slice_size *= s;
   }
   size_t ind_size = slice_size == 0 ? 0 : out.size() / slice_size;
+  if (ind_size == 0) {
+    // Nothing to gather; seeking iterators over an empty index shape
+    // would divide by a zero extent
+    return;
+  }
   const T* src_ptr = src.data<T>();
   T* dst_ptr = out.data<T>();
 
-  std::vector<ContiguousIterator> its(inds.begin(), inds.end());
-  ContiguousIterator src_it;
-  if (!can_copy && src.ndim() > 0) {
-    src_it = ContiguousIterator(slice_sizes, src.strides(), src.ndim());
-  }
-
-  size_t out_idx = 0;
-  for (int idx = 0; idx < ind_size; idx++) {
-    size_t src_idx = 0;
-    for (int ii = 0; ii < inds.size(); ++ii) {
-      auto ax = axes[ii];
-      auto idx_loc = its[ii].loc;
-      its[ii].step();
-      auto idx_val =
-          offset_neg_idx(inds[ii].data<IdxT>()[idx_loc], src.shape(ax));
-      src_idx += (idx_val * src.strides()[ax]);
+  auto gather_slices = [&](size_t start, size_t end) {
+    std::vector<ContiguousIterator> its(inds.begin(), inds.end());
+    for (auto& it : its) {
+      it.seek(start);
+    }
+    ContiguousIterator src_it;
+    if (!can_copy && src.ndim() > 0) {
+      src_it = ContiguousIterator(slice_sizes, src.strides(), src.ndim());
     }
 
-    if (slice_size == 1) {
-      dst_ptr[out_idx++] = src_ptr[src_idx];
-    } else if (can_copy) {
-      std::copy(
-          src_ptr + src_idx, src_ptr + src_idx + slice_size, dst_ptr + out_idx);
-      out_idx += slice_size;
-    } else {
-      for (int jj = 0; jj < slice_size; jj++) {
-        dst_ptr[out_idx++] = src_ptr[src_idx + src_it.loc];
-        src_it.step();
+    size_t out_idx = start * slice_size;
+    for (size_t idx = start; idx < end; idx++) {
+      size_t src_idx = 0;
+      for (int ii = 0; ii < inds.size(); ++ii) {
+        auto ax = axes[ii];
+        auto idx_loc = its[ii].loc;
+        its[ii].step();
+        auto idx_val =
+            offset_neg_idx(inds[ii].data<IdxT>()[idx_loc], src.shape(ax));
+        src_idx += (idx_val * src.strides()[ax]);
+      }
+
+      if (slice_size == 1) {
+        dst_ptr[out_idx++] = src_ptr[src_idx];
+      } else if (can_copy) {
+        std::copy(
+            src_ptr + src_idx,
+            src_ptr + src_idx + slice_size,
+            dst_ptr + out_idx);
+        out_idx += slice_size;
+      } else {
+        for (int jj = 0; jj < slice_size; jj++) {
+          dst_ptr[out_idx++] = src_ptr[src_idx + src_it.loc];
+          src_it.step();
+        }
+        src_it.reset();
       }
-      src_it.reset();
     }
+  };
+
+  // Each index produces an independent slice of the output, so the gather
+  // is bandwidth bound and chunks of the index space can run on the worker
+  // pool once there is enough to copy
+  if (ind_size * slice_size * sizeof(T) < min_parallel_gather_bytes) {
+    gather_slices(0, ind_size);
+  } else {
+    parallel_for(ind_size, gather_slices);
   }
 }
 
@@ -258,11 +285,6 @@ void gather_axis(
     array& out,
     const int axis) {
   auto shape = remove_index(ind.shape(), axis);
-  ContiguousIterator ind_it(
-      shape, remove_index(ind.strides(), axis), src.ndim() - 1);
-  ContiguousIterator src_it(
-      shape, remove_index(src.strides(), axis), src.ndim() - 1);
-
   auto ind_ptr = ind.data<IdxT>();
   auto src_ptr = src.data<T>();
   auto dst_ptr = out.data<T>();
@@ -282,18 +304,39 @@ void gather_axis(
   }
 
   size_t stride_pre = size_post * ind_ax_size;
-  for (size_t i = 0; i < size_pre; i++) {
-    for (size_t k = 0; k < size_post; k++) {
+  auto gather_rows = [&](size_t start, size_t end) {
+    ContiguousIterator ind_it(
+        shape, remove_index(ind.strides(), axis), src.ndim() - 1);
+    ContiguousIterator src_it(
+        shape, remove_index(src.strides(), axis), src.ndim() - 1);
+    ind_it.seek(start);
+    src_it.seek(start);
+    for (size_t n = start; n < end; ++n) {
+      size_t i = n / size_post;
+      size_t k = n % size_post;
+      auto dst = dst_ptr + i * stride_pre + k;
       for (int j = 0; j < ind_ax_size; ++j) {
         auto ind_val = offset_neg_idx(
             ind_ptr[ind_it.loc + j * ind_ax_stride], src_ax_size);
-        dst_ptr[k + j * dst_ax_stride] =
-            src_ptr[src_it.loc + ind_val * src_ax_stride];
+        dst[j * dst_ax_stride] = src_ptr[src_it.loc + ind_val * src_ax_stride];
       }
       ind_it.step();
       src_it.step();
     }
-    dst_ptr += stride_pre;
+  };
+
+  if (out.size() == 0) {
+    // Nothing to gather; seeking iterators over an empty shape would
+    // divide by a zero extent
+    return;
+  }
+
+  // The (pre, post) positions write disjoint parts of the output, so
+  // chunks of that grid can run on the worker pool
+  if (ind.size() * sizeof(T) < min_parallel_gather_bytes) {
+    gather_rows(0, size_pre * size_post);
+  } else {
+    parallel_for(size_pre * size_post, gather_rows);
   }
 }
 
@@ -514,9 +557,17 @@ void Scatter::eval_cpu(const std::vector<array>& inputs, array& out) {
   auto& src = inputs[0];
   auto& updates = inputs.back();
 
-  // Copy src into out (copy allocates memory for out)
-  auto ctype =
-      src.flags().row_contiguous ? CopyType::Vector : CopyType::General;
+  // Copy src into out (copy allocates memory for out). The vector copy
+  // donates the src buffer when the runtime owns it uniquely, so the
+  // scatter then accumulates in place without copying the destination.
+  CopyType ctype;
+  if (src.data_size() == 1) {
+    ctype = CopyType::Scalar;
+  } else if (src.flags().row_contiguous) {
+    ctype = CopyType::Vector;
+  } else {
+    ctype = CopyType::General;
+  }
   copy_cpu(src, out, ctype, stream());
 
   auto& encoder = cpu::get_command_encoder(stream());
@@ -683,9 +734,17 @@ void ScatterAxis::eval_cpu(const std::vector<array>& inputs, array& out) {
   auto& idx = inputs[1];
   auto& updates = inputs[2];
 
-  // Copy src into out (copy allocates memory for out)
-  auto ctype =
-      src.flags().row_contiguous ? CopyType::Vector : CopyType::General;
+  // Copy src into out (copy allocates memory for out). The vector copy
+  // donates the src buffer when the runtime owns it uniquely, so the
+  // scatter then accumulates in place without copying the destination.
+  CopyType ctype;
+  if (src.data_size() == 1) {
+    ctype = CopyType::Scalar;
+  } else if (src.flags().row_contiguous) {
+    ctype = CopyType::Vector;
+  } else {
+    ctype = CopyType::General;
+  }
   copy_cpu(src, out, ctype, stream());
 
   auto& encoder = cpu::get_command_encoder(stream());
@@ -747,4 +806,106 @@ void ScatterAxis::eval_cpu(const std::vector<array>& inputs, array& out) {
   });
 }
 
+template <typename T>
+void bincount(const array& in, array& out, int nbins) {
+  auto counts = out.data<uint32_t>();
+  std::fill(counts, counts + out.size(), 0);
+
+  size_t n = in.shape().back();
+  size_t n_rows = in.size() / n;
+
+  auto count_row = [nbins](const T* row, size_t n, uint32_t* row_counts) {
+    for (size_t j = 0; j < n; ++j) {
+      auto v = static_cast<int64_t>(row[j]);
+      if (v >= 0 && v < nbins) {
+        row_counts[v]++;
+      }
+    }
+  };
+
+  if (in.flags().row_contiguous) {
+    const T* src = in.data<T>();
+    if (n_rows > 1) {
+      // Each thread owns a contiguous block of rows so the histograms do
+      // not contend
+      parallel_for(n_rows, [&](size_t start, size_t end) {
+        for (size_t r = start; r < end; ++r) {
+          count_row(src + r * n, n, counts + r * nbins);
+        }
+      });
+    } else {
+      // A single long row: each thread counts its chunk into a private
+      // histogram, merged under a lock. Heavily repeated values (e.g.
+      // Zipf-distributed tokens) hit thread-local cache lines instead of
+      // serializing on shared bins.
+      std::mutex mtx;
+      parallel_for(n, [&](size_t start, size_t end) {
+        std::vector<uint32_t> local(nbins, 0);
+        count_row(src + start, end - start, local.data());
+        std::lock_guard<std::mutex> lock(mtx);
+        for (int i = 0; i < nbins; ++i) {
+          counts[i] += local[i];
+        }
+      });
+    }
+  } else {
+    ContiguousIterator it(in);
+    const T* src = in.data<T>();
+    for (size_t r = 0; r < n_rows; ++r) {
+      auto row_counts = counts + r * nbins;
+      for (size_t j = 0; j < n; ++j) {
+        auto v = static_cast<int64_t>(src[it.loc]);
+        it.step();
+        if (v >= 0 && v < nbins) {
+          row_counts[v]++;
+        }
+      }
+    }
+  }
+}
+
+void Bincount::eval_cpu(const std::vector<array>& inputs, array& out) {
+  assert(inputs.size() == 1);
+  auto& in = inputs[0];
+
+  out.set_data(allocator::malloc(out.nbytes()));
+
+  auto& encoder = cpu::get_command_encoder(stream());
+  encoder.set_input_array(in);
+  encoder.set_output_array(out);
+  encoder.dispatch([in = array::unsafe_weak_copy(in),
+                    out = array::unsafe_weak_copy(out),
+                    nbins = nbins_]() mutable {
+    switch (in.dtype()) {
+      case uint8:
+        bincount<uint8_t>(in, out, nbins);
+        break;
+      case uint16:
+        bincount<uint16_t>(in, out, nbins);
+        break;
+      case uint32:
+        bincount<uint32_t>(in, out, nbins);
+        break;
+      case uint64:
+        bincount<uint64_t>(in, out, nbins);
+        break;
+      case int8:
+        bincount<int8_t>(in, out, nbins);
+        break;
+      case int16:
+        bincount<int16_t>(in, out, nbins);
+        break;
+      case int32:
+        bincount<int32_t>(in, out, nbins);
+        break;
+      case int64:
+        bincount<int64_t>(in, out, nbins);
+        break;
+      default:
+        throw std::runtime_error(
+            "[Bincount::eval_cpu] Cannot count non-integer arrays.");
+    }
+  });
+}
+
 } // namespace mlx::core
@@ -0,0 +1,161 @@
+// Copyright © 2025 Apple Inc.
+
+#include <cassert>
+
+#include "mlx/backend/cpu/copy.h"
+#include "mlx/backend/cpu/encoder.h"
+#include "mlx/fast_primitives.h"
+
+namespace mlx::core {
+
+namespace {
+
+template <typename T, typename O, typename IdxT>
+void input_embedding(
+    const array& weights,
+    const array& indices,
+    const array& positions,
+    array& out,
+    Stream stream) {
+  auto& encoder = cpu::get_command_encoder(stream);
+  encoder.set_input_array(weights);
+  encoder.set_input_array(indices);
+  encoder.set_input_array(positions);
+  encoder.set_output_array(out);
+
+  const T* w_ptr = weights.data<T>();
+  const IdxT* idx_ptr = indices.data<IdxT>();
+  const T* pos_ptr = positions.data<T>();
+  O* out_ptr = out.data<O>();
+
+  int D = weights.shape(1);
+  size_t N = indices.size();
+
+  encoder.dispatch([w_ptr, idx_ptr, pos_ptr, out_ptr, D, N]() {
+    for (size_t t = 0; t < N; ++t) {
+      const T* row = w_ptr + static_cast<size_t>(idx_ptr[t]) * D;
+      const T* pos = pos_ptr + t * D;
+      O* o = out_ptr + t * D;
+      for (int d = 0; d < D; ++d) {
+        o[d] = static_cast<O>(
+            static_cast<float>(row[d]) + static_cast<float>(pos[d]));
+      }
+    }
+  });
+}
+
+template <typename T, typename O>
+void input_embedding_index_dispatch(
+    const array& weights,
+    const array& indices,
+    const array& positions,
+    array& out,
+    Stream stream) {
+  switch (indices.dtype()) {
+    case int8:
+      input_embedding<T, O, int8_t>(weights, indices, positions, out, stream);
+      break;
+    case int16:
+      input_embedding<T, O, int16_t>(weights, indices, positions, out, stream);
+      break;
+    case int32:
+      input_embedding<T, O, int32_t>(weights, indices, positions, out, stream);
+      break;
+    case int64:
+      input_embedding<T, O, int64_t>(weights, indices, positions, out, stream);
+      break;
+    case uint8:
+      input_embedding<T, O, uint8_t>(weights, indices, positions, out, stream);
+      break;
+    case uint16:
+      input_embedding<T, O, uint16_t>(
+          weights, indices, positions, out, stream);
+      break;
+    case uint32:
+      input_embedding<T, O, uint32_t>(
+          weights, indices, positions, out, stream);
+      break;
+    case uint64:
+      input_embedding<T, O, uint64_t>(
+          weights, indices, positions, out, stream);
+      break;
+    default:
+      throw std::runtime_error(
+          "[input_embedding] indices must be of integer type");
+      break;
+  }
+}
+
+template <typename T>
+void input_embedding_out_dispatch(
+    const array& weights,
+    const array& indices,
+    const array& positions,
+    array& out,
+    Stream stream) {
+  switch (out.dtype()) {
+    case float32:
+      input_embedding_index_dispatch<T, float>(
+          weights, indices, positions, out, stream);
+      break;
+    case float16:
+      input_embedding_index_dispatch<T, float16_t>(
+          weights, indices, positions, out, stream);
+      break;
+    case bfloat16:
+      input_embedding_index_dispatch<T, bfloat16_t>(
+          weights, indices, positions, out, stream);
+      break;
+    default:
+      throw std::runtime_error(
+          "[input_embedding] only supports float32, float16 and bfloat16");
+      break;
+  }
+}
+
+} // namespace
+
+void fast::InputEmbedding::eval_cpu(
+    const std::vector<array>& inputs,
+    std::vector<array>& outputs) {
+  assert(inputs.size() == 3);
+
+  auto s = stream();
+  auto& encoder = cpu::get_command_encoder(s);
+  auto ensure_row_contiguous = [&s, &encoder](const array& x) {
+    if (x.flags().row_contiguous) {
+      return x;
+    } else {
+      array x_copy = contiguous_copy_cpu(x, s);
+      encoder.add_temporary(x_copy);
+      return x_copy;
+    }
+  };
+
+  auto weights = ensure_row_contiguous(inputs[0]);
+  auto indices = ensure_row_contiguous(inputs[1]);
+  auto positions = ensure_row_contiguous(inputs[2]);
+  auto& out = outputs[0];
+  out.set_data(allocator::malloc(out.nbytes()));
+
+  switch (weights.dtype()) {
+    case float32:
+      input_embedding_out_dispatch<float>(
+          weights, indices, positions, out, s);
+      break;
+    case float16:
+      input_embedding_out_dispatch<float16_t>(
+          weights, indices, positions, out, s);
+      break;
+    case bfloat16:
+      input_embedding_out_dispatch<bfloat16_t>(
+          weights, indices, positions, out, s);
+      break;
+    default:
+      throw std::runtime_error(
+          "[input_embedding] only supports float32, float16 and bfloat16");
+      break;
+  }
+}
+
+} // namespace mlx::core
@@ -0,0 +1,167 @@
+// Copyright © 2025 Apple Inc.
+
+#include <cassert>
+#include <cmath>
+
+#include "mlx/backend/cpu/copy.h"
+#include "mlx/backend/cpu/encoder.h"
+#include "mlx/backend/cpu/simd/simd.h"
+#include "mlx/fast_primitives.h"
+#include "mlx/types/limits.h"
+
+namespace mlx::core {
+
+namespace {
+
+using namespace mlx::core::simd;
+
+template <typename T, typename AccT, typename IdxT>
+void linear_cross_entropy(
+    const array& x,
+    const array& w,
+    const array& targets,
+    array& out,
+    Stream stream) {
+  auto& encoder = cpu::get_command_encoder(stream);
+  encoder.set_input_array(x);
+  encoder.set_input_array(w);
+  encoder.set_input_array(targets);
+  encoder.set_output_array(out);
+
+  const T* x_ptr = x.data<T>();
+  const T* w_ptr = w.data<T>();
+  const IdxT* tgt_ptr = targets.data<IdxT>();
+  T* out_ptr = out.data<T>();
+
+  int V = w.shape(0);
+  int D = w.shape(1);
+  int L = out.size();
+
+  encoder.dispatch([x_ptr, w_ptr, tgt_ptr, out_ptr, V, D, L]() mutable {
+    constexpr int N = std::min(max_size<AccT>, max_size<T>);
+    const AccT neg_inf = -numeric_limits<AccT>::infinity();
+
+    for (int i = 0; i < L; i++, x_ptr += D, tgt_ptr++, out_ptr++) {
+      // Stream the vocabulary: each projection row produces one logit
+      // which feeds a running maximum and a sum of exponentials rescaled
+      // whenever the maximum grows, so the logits are never stored
+      AccT maximum = neg_inf;
+      AccT normalizer = 0;
+      AccT target_logit = 0;
+      auto tgt = static_cast<int64_t>(*tgt_ptr);
+      const T* w_row = w_ptr;
+      for (int v = 0; v < V; v++, w_row += D) {
+        Simd<AccT, N> vacc(0.0);
+        int d = 0;
+        for (; d + N <= D; d += N) {
+          Simd<AccT, N> xv = load<T, N>(x_ptr + d);
+          Simd<AccT, N> wv = load<T, N>(w_row + d);
+          vacc = vacc + xv * wv;
+        }
+        AccT z = sum(vacc);
+        for (; d < D; d++) {
+          z += static_cast<AccT>(x_ptr[d]) * static_cast<AccT>(w_row[d]);
+        }
+        if (v == tgt) {
+          target_logit = z;
+        }
+        if (z > maximum) {
+          normalizer = normalizer * std::exp(maximum - z) + 1;
+          maximum = z;
+        } else if (maximum != neg_inf) {
+          normalizer += std::exp(z - maximum);
+        }
+      }
+      AccT lse =
+          std::isinf(maximum) ? maximum : std::log(normalizer) + maximum;
+      *out_ptr = static_cast<T>(lse - target_logit);
+    }
+  });
+}
+
+template <typename IdxT>
+void linear_cross_entropy_dispatch(
+    const array& x,
+    const array& w,
+    const array& targets,
+    array& out,
+    Stream stream) {
+  switch (x.dtype()) {
+    case float32:
+      linear_cross_entropy<float, float, IdxT>(x, w, targets, out, stream);
+      break;
+    case float16:
+      linear_cross_entropy<float16_t, float, IdxT>(x, w, targets, out, stream);
+      break;
+    case bfloat16:
+      linear_cross_entropy<bfloat16_t, float, IdxT>(
+          x, w, targets, out, stream);
+      break;
+    case float64:
+      linear_cross_entropy<double, double, IdxT>(x, w, targets, out, stream);
+      break;
+    default:
+      throw std::runtime_error(
+          "[linear_cross_entropy] only supports floating point inputs");
+      break;
+  }
+}
+
+} // namespace
+
+void fast::LinearCrossEntropy::eval_cpu(
+    const std::vector<array>& inputs,
+    std::vector<array>& outputs) {
+  assert(inputs.size() == 3);
+
+  auto s = stream();
+  auto& encoder = cpu::get_command_encoder(s);
+  auto ensure_row_contiguous = [&s, &encoder](const array& x) {
+    if (x.flags().row_contiguous) {
+      return x;
+    } else {
+      array x_copy = contiguous_copy_cpu(x, s);
+      encoder.add_temporary(x_copy);
+      return x_copy;
+    }
+  };
+
+  auto x = ensure_row_contiguous(inputs[0]);
+  auto w = ensure_row_contiguous(inputs[1]);
+  auto targets = ensure_row_contiguous(inputs[2]);
+  auto& out = outputs[0];
+  out.set_data(allocator::malloc(out.nbytes()));
+
+  switch (targets.dtype()) {
+    case uint8:
+      linear_cross_entropy_dispatch<uint8_t>(x, w, targets, out, s);
+      break;
+    case uint16:
+      linear_cross_entropy_dispatch<uint16_t>(x, w, targets, out, s);
+      break;
+    case uint32:
+      linear_cross_entropy_dispatch<uint32_t>(x, w, targets, out, s);
+      break;
+    case uint64:
+      linear_cross_entropy_dispatch<uint64_t>(x, w, targets, out, s);
+      break;
+    case int8:
+      linear_cross_entropy_dispatch<int8_t>(x, w, targets, out, s);
+      break;
+    case int16:
+      linear_cross_entropy_dispatch<int16_t>(x, w, targets, out, s);
+      break;
+    case int32:
+      linear_cross_entropy_dispatch<int32_t>(x, w, targets, out, s);
+      break;
+    case int64:
+      linear_cross_entropy_dispatch<int64_t>(x, w, targets, out, s);
+      break;
+    default:
+      throw std::runtime_error(
+          "[linear_cross_entropy] targets must be integer class indices");
+      break;
+  }
+}
+
+} // namespace mlx::core
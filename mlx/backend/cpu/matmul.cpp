@@ -26,6 +26,31 @@ void matmul_dispatch(
   T* out_ptr = out.data<T>();
   size_t ldc = out.shape(-1);
   size_t batch_size = a.size() / (a.shape(-2) * a.shape(-1));
+  auto a_shape = a.shape();
+  auto a_strides = a.strides();
+  auto b_shape = b.shape();
+  auto b_strides = b.strides();
+
+  // Collapse the batch into M when a is densely batched and b is shared
+  // across the batch (stride-0 broadcast) so the whole product runs as a
+  // single GEMM instead of batch_size small ones. This mirrors the fold
+  // the GPU paths do and covers e.g. a shared projection applied to a
+  // large batch.
+  if (batch_size > 1 && !a_transposed && a.flags().row_contiguous) {
+    bool b_shared = true;
+    for (int i = 0; i + 2 < b.ndim(); ++i) {
+      b_shared &= (b_strides[i] == 0 || b_shape[i] == 1);
+    }
+    if (b_shared) {
+      auto K = a_shape.back();
+      a_shape = {static_cast<ShapeElem>(batch_size * a.shape(-2)), K};
+      a_strides = {K, 1};
+      b_shape = {b.shape(-2), b.shape(-1)};
+      b_strides = {b.strides()[b.ndim() - 2], b.strides()[b.ndim() - 1]};
+      batch_size = 1;
+    }
+  }
+
   auto& encoder = cpu::get_command_encoder(stream);
   encoder.set_input_array(a);
   encoder.set_input_array(b);
@@ -41,10 +66,10 @@ void matmul_dispatch(
                     alpha,
                     beta,
                     batch_size,
-                    a_shape = a.shape(),
-                    a_strides = a.strides(),
-                    b_shape = b.shape(),
-                    b_strides = b.strides()]() {
+                    a_shape = std::move(a_shape),
+                    a_strides = std::move(a_strides),
+                    b_shape = std::move(b_shape),
+                    b_strides = std::move(b_strides)]() {
     matmul<T>(
         a_ptr,
         b_ptr,
@@ -0,0 +1,75 @@
+// Copyright © 2025 Apple Inc.
+#pragma once
+
+#include <thread>
+
+#include "mlx/backend/common/numa.h"
+#include "mlx/threadpool.h"
+#include "mlx/utils.h"
+
+namespace mlx::core {
+
+// Threads shared by CPU kernels that fan independent work out of the stream
+// thread (MLX_CPU_THREADS overrides). When the pool is confined to a NUMA
+// node the default is one worker per CPU of that node rather than of the
+// whole machine.
+inline int cpu_pool_num_threads() {
+  static int num_threads = std::max(
+      env::get_var(
+          "MLX_CPU_THREADS",
+          thread_affinity_cpus().empty()
+              ? std::thread::hardware_concurrency()
+              : thread_affinity_cpus().size()),
+      1);
+  return num_threads;
+}
+
+// A dedicated pool rather than the scheduler's stream threads, so kernels
+// already running on a stream thread can block on the futures without
+// deadlocking
+inline ThreadPool& cpu_thread_pool() {
+  static ThreadPool pool{
+      static_cast<size_t>(cpu_pool_num_threads()), thread_affinity_cpus()};
+  return pool;
+}
+
+// Run f(begin, end) over contiguous chunks of [0, n) across the pool and
+// block until every chunk is done. Chunks hold at least `grain` items so
+// cheap work is not scattered one item per thread; the whole range runs on
+// the calling thread when it fits in a single chunk. Exceptions from the
+// chunks are rethrown here.
+template <typename F>
+void parallel_for(size_t n, size_t grain, F f) {
+  if (n == 0) {
+    return;
+  }
+  grain = std::max<size_t>(grain, 1);
+  size_t threads =
+      std::min<size_t>(cpu_pool_num_threads(), (n + grain - 1) / grain);
+  size_t chunk = std::max(grain, (n + threads - 1) / threads);
+  if (chunk >= n) {
+    f(size_t(0), n);
+    return;
+  }
+
+  auto& pool = cpu_thread_pool();
+  std::vector<std::future<void>> futures;
+  futures.reserve((n + chunk - 1) / chunk);
+  for (size_t s = 0; s < n; s += chunk) {
+    futures.push_back(pool.enqueue(
+        [&f, s, e = std::min(s + chunk, n)]() { f(s, e); }));
+  }
+  for (auto& fut : futures) {
+    fut.wait();
+  }
+  for (auto& fut : futures) {
+    fut.get();
+  }
+}
+
+template <typename F>
+void parallel_for(size_t n, F f) {
+  parallel_for(n, 1, std::move(f));
+}
+
+} // namespace mlx::core
@@ -179,6 +179,9 @@ void AsType::eval_cpu(const std::vector<array>& inputs, array& out) {
 }
 
 void Concatenate::eval_cpu(const std::vector<array>& inputs, array& out) {
+  if (concatenate_as_view(inputs, out, axis_)) {
+    return;
+  }
   std::vector<int> sizes;
   sizes.push_back(0);
   for (auto& p : inputs) {
@@ -303,6 +306,22 @@ void RandomBits::eval_cpu(const std::vector<array>& inputs, array& out) {
       auto key = std::make_pair(kptr[k1_elem], kptr[k2_elem]);
 
       std::pair<uintptr_t, uintptr_t> count{0, half_size + !even};
+      constexpr int S = simd::max_size<uint32_t>;
+      if constexpr (S > 1) {
+        uint32_t counts[S];
+        for (; count.first + S < half_size; count.first += S, count.second += S) {
+          for (int j = 0; j < S; ++j) {
+            counts[j] = count.first + j;
+          }
+          auto c0 = simd::load<uint32_t, S>(counts);
+          auto c1 = c0 +
+              simd::Simd<uint32_t, S>(
+                        static_cast<uint32_t>(count.second - count.first));
+          auto rb = random::threefry2x32_hash<S>(key, c0, c1);
+          simd::store(ptr + count.first, rb.first);
+          simd::store(ptr + count.second, rb.second);
+        }
+      }
       for (; count.first + 1 < half_size; count.first++, count.second++) {
         std::tie(ptr[count.first], ptr[count.second]) =
             random::threefry2x32_hash(key, count);
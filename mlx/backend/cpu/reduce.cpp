@@ -6,6 +6,7 @@
 
 #include "mlx/backend/common/reduce.h"
 #include "mlx/backend/cpu/encoder.h"
+#include "mlx/backend/cpu/parallel.h"
 #include "mlx/backend/cpu/simd/simd.h"
 #include "mlx/primitives.h"
 
@@ -68,6 +69,7 @@ const complex64_t Limits<complex64_t>::max =
 const complex64_t Limits<complex64_t>::min =
     -std::numeric_limits<float>::infinity();
 
+// Reduce `size` rows of `stride` columns into the accumulator row.
 template <typename T, typename U, typename Op>
 void strided_reduce(
     const T* x,
@@ -76,6 +78,38 @@ void strided_reduce(
     size_t stride,
     Op op) {
   constexpr int N = std::min(simd::max_size<T>, simd::max_size<U>);
+
+  // Once the accumulator row spills out of the cache, re-reading and
+  // re-writing it for every input row dominates the reduction. Sweep the
+  // columns in blocks of rows instead, carrying each column vector in a
+  // register across the block, so every accumulator element moves once per
+  // block while the rows are still streamed in order.
+  constexpr int row_block = 32;
+  if (stride * sizeof(U) > (1 << 17)) {
+    for (int i = 0; i < size; i += row_block) {
+      int rows = std::min(row_block, size - i);
+      const T* xb = x + static_cast<size_t>(i) * stride;
+      size_t c = 0;
+      for (; c + N <= stride; c += N) {
+        auto acc = simd::load<U, N>(accumulator + c);
+        const T* p = xb + c;
+        for (int r = 0; r < rows; r++, p += stride) {
+          acc = op(acc, simd::Simd<U, N>(simd::load<T, N>(p)));
+        }
+        simd::store<U, N>(accumulator + c, acc);
+      }
+      for (; c < stride; c++) {
+        U acc = accumulator[c];
+        const T* p = xb + c;
+        for (int r = 0; r < rows; r++, p += stride) {
+          acc = op(acc, *p);
+        }
+        accumulator[c] = acc;
+      }
+    }
+    return;
+  }
+
   for (int i = 0; i < size; i++) {
     U* moving_accumulator = accumulator;
     auto s = stride;
@@ -152,11 +186,18 @@ void reduction_op(
   }
 
   if (plan.type == ContiguousReduce && plan.shape.size() == 1) {
-    int reduction_size = plan.shape[0];
-    for (int i = 0; i < out.size(); i++, out_ptr++, in_ptr += reduction_size) {
-      *out_ptr = init;
-      contiguous_reduce(in_ptr, out_ptr, reduction_size, Op{}, init);
-    }
+    size_t reduction_size = plan.shape[0];
+    // Each output reduces its own contiguous row; size the grain so every
+    // task reads at least ~16k elements of input
+    size_t grain = std::max<size_t>(1, (1 << 14) / reduction_size);
+    parallel_for(out.size(), grain, [&](size_t start, size_t end) {
+      auto o = out_ptr + start;
+      auto in = in_ptr + start * reduction_size;
+      for (size_t i = start; i < end; i++, o++, in += reduction_size) {
+        *o = init;
+        contiguous_reduce(in, o, reduction_size, Op{}, init);
+      }
+    });
     return;
   }
 
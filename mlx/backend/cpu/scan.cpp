@@ -6,6 +6,7 @@
 #include "mlx/backend/cpu/binary_ops.h"
 #include "mlx/backend/cpu/copy.h"
 #include "mlx/backend/cpu/encoder.h"
+#include "mlx/backend/cpu/parallel.h"
 #include "mlx/backend/cpu/simd/simd.h"
 #include "mlx/primitives.h"
 
@@ -78,6 +79,94 @@ void contiguous_scan(
   }
 };
 
+// Scans below this many elements stay serial; the fork/join overhead
+// only pays for itself on long axes
+constexpr int parallel_scan_min_size = 1 << 20;
+
+// Three-phase parallel scan of a single long contiguous axis: every
+// chunk reduces to a partial, the partials are scanned serially to get
+// each chunk's carry-in, and the chunks then scan independently from
+// their carries. Chunk partials fold in element order, so only the
+// combination across chunk boundaries is reassociated.
+template <typename T, typename U, typename Op, typename CombineOp>
+void parallel_contiguous_scan(
+    const T* input,
+    U* output,
+    int stride,
+    bool reverse,
+    bool inclusive,
+    const Op& op,
+    const CombineOp& combine,
+    U init) {
+  int n_chunks = std::min<int>(
+      cpu_pool_num_threads(), (stride + parallel_scan_min_size - 1) / parallel_scan_min_size);
+  int chunk = (stride + n_chunks - 1) / n_chunks;
+
+  // Phase 1: reduce each chunk to its partial
+  std::vector<U> partials(n_chunks);
+  parallel_for(n_chunks, [&](size_t start, size_t end) {
+    for (size_t c = start; c < end; ++c) {
+      int lo = c * chunk;
+      int hi = std::min(lo + chunk, stride);
+      U acc = init;
+      if (!reverse) {
+        for (int i = lo; i < hi; ++i) {
+          acc = op(acc, input[i]);
+        }
+      } else {
+        for (int i = hi - 1; i >= lo; --i) {
+          acc = op(acc, input[i]);
+        }
+      }
+      partials[c] = acc;
+    }
+  });
+
+  // Phase 2: scan the partials for each chunk's carry-in
+  std::vector<U> carries(n_chunks);
+  if (!reverse) {
+    carries[0] = init;
+    for (int c = 1; c < n_chunks; ++c) {
+      carries[c] = combine(carries[c - 1], partials[c - 1]);
+    }
+  } else {
+    carries[n_chunks - 1] = init;
+    for (int c = n_chunks - 2; c >= 0; --c) {
+      carries[c] = combine(carries[c + 1], partials[c + 1]);
+    }
+  }
+
+  // Phase 3: scan each chunk from its carry
+  parallel_for(n_chunks, [&](size_t start, size_t end) {
+    for (size_t c = start; c < end; ++c) {
+      int lo = c * chunk;
+      int hi = std::min(lo + chunk, stride);
+      U acc = carries[c];
+      if (!reverse) {
+        for (int i = lo; i < hi; ++i) {
+          if (inclusive) {
+            acc = op(acc, input[i]);
+            output[i] = acc;
+          } else {
+            output[i] = acc;
+            acc = op(acc, input[i]);
+          }
+        }
+      } else {
+        for (int i = hi - 1; i >= lo; --i) {
+          if (inclusive) {
+            acc = op(acc, input[i]);
+            output[i] = acc;
+          } else {
+            output[i] = acc;
+            acc = op(acc, input[i]);
+          }
+        }
+      }
+    }
+  });
+}
+
 template <typename T, typename U, typename Op>
 void strided_scan(
     const T* input,
@@ -153,7 +242,7 @@ void strided_scan(
   }
 };
 
-template <typename T, typename U, typename Op>
+template <typename T, typename U, typename Op, typename CombineOp>
 void scan_op(
     const array& in,
     array& out,
@@ -161,18 +250,50 @@ void scan_op(
     bool reverse,
     bool inclusive,
     const Op& op,
+    const CombineOp& combine,
     U init) {
   if (in.flags().row_contiguous) {
     if (in.strides()[axis] == 1) {
-      contiguous_scan(
-          in.data<T>(),
-          out.data<U>(),
-          in.size() / in.shape(axis),
-          in.shape(axis),
-          reverse,
-          inclusive,
-          op,
-          init);
+      int count = in.size() / in.shape(axis);
+      int stride = in.shape(axis);
+      if (count == 1 && stride >= parallel_scan_min_size) {
+        parallel_contiguous_scan(
+            in.data<T>(),
+            out.data<U>(),
+            stride,
+            reverse,
+            inclusive,
+            op,
+            combine,
+            init);
+      } else if (
+          count > 1 && static_cast<size_t>(count) * stride >=
+              static_cast<size_t>(parallel_scan_min_size)) {
+        // Rows are independent; spread them over the pool
+        auto in_ptr = in.data<T>();
+        auto out_ptr = out.data<U>();
+        parallel_for(count, [&](size_t start, size_t end) {
+          contiguous_scan(
+              in_ptr + start * stride,
+              out_ptr + start * stride,
+              end - start,
+              stride,
+              reverse,
+              inclusive,
+              op,
+              init);
+        });
+      } else {
+        contiguous_scan(
+            in.data<T>(),
+            out.data<U>(),
+            count,
+            stride,
+            reverse,
+            inclusive,
+            op,
+            init);
+      }
     } else {
       strided_scan(
           in.data<T>(),
@@ -201,40 +322,45 @@ void scan_dispatch(
   switch (rtype) {
     case Scan::Sum: {
       auto op = [](U y, T x) { return y + x; };
+      auto combine = [](U a, U b) { return a + b; };
       auto init = static_cast<U>(0);
-      scan_op<T, U>(in, out, axis, reverse, inclusive, op, init);
+      scan_op<T, U>(in, out, axis, reverse, inclusive, op, combine, init);
       break;
     }
     case Scan::Prod: {
       auto op = [](U y, T x) { return y * x; };
+      auto combine = [](U a, U b) { return a * b; };
       auto init = static_cast<U>(1);
-      scan_op<T, U>(in, out, axis, reverse, inclusive, op, init);
+      scan_op<T, U>(in, out, axis, reverse, inclusive, op, combine, init);
       break;
     }
     case Scan::Min: {
       auto op = [](U y, T x) { return x < y ? x : y; };
+      auto combine = [](U a, U b) { return b < a ? b : a; };
       auto init = (issubdtype(in.dtype(), floating))
           ? static_cast<U>(std::numeric_limits<float>::infinity())
           : std::numeric_limits<U>::max();
-      scan_op<T, U>(in, out, axis, reverse, inclusive, op, init);
+      scan_op<T, U>(in, out, axis, reverse, inclusive, op, combine, init);
       break;
     }
     case Scan::Max: {
       auto op = [](U y, T x) { return x < y ? y : x; };
+      auto combine = [](U a, U b) { return a < b ? b : a; };
       auto init = (issubdtype(in.dtype(), floating))
           ? static_cast<U>(-std::numeric_limits<float>::infinity())
           : std::numeric_limits<U>::min();
-      scan_op<T, U>(in, out, axis, reverse, inclusive, op, init);
+      scan_op<T, U>(in, out, axis, reverse, inclusive, op, combine, init);
       break;
     }
     case Scan::LogAddExp: {
       auto op = [](U a, T b) {
         return detail::LogAddExp{}(a, static_cast<U>(b));
       };
+      auto combine = [](U a, U b) { return detail::LogAddExp{}(a, b); };
       auto init = (issubdtype(in.dtype(), floating))
           ? static_cast<U>(-std::numeric_limits<float>::infinity())
           : std::numeric_limits<U>::min();
-      scan_op<T, U>(in, out, axis, reverse, inclusive, op, init);
+      scan_op<T, U>(in, out, axis, reverse, inclusive, op, combine, init);
       break;
     }
   }
@@ -92,4 +92,20 @@ void Select::eval_cpu(const std::vector<array>& inputs, array& out) {
   select_op(condition, a, b, out, detail::Select(), stream());
 }
 
+void MaskedAdd::eval_cpu(const std::vector<array>& inputs, array& out) {
+  assert(inputs.size() == 3);
+  const auto& condition = inputs[0];
+  const auto& a = inputs[1];
+  const auto& b = inputs[2];
+  select_op(condition, a, b, out, detail::MaskedAdd(), stream());
+}
+
+void MaskedMultiply::eval_cpu(const std::vector<array>& inputs, array& out) {
+  assert(inputs.size() == 3);
+  const auto& condition = inputs[0];
+  const auto& a = inputs[1];
+  const auto& b = inputs[2];
+  select_op(condition, a, b, out, detail::MaskedMultiply(), stream());
+}
+
 } // namespace mlx::core
@@ -0,0 +1,405 @@
+#pragma once
+
+#include <stdint.h>
+#include <cmath>
+#include <cstring>
+
+#include "mlx/backend/cpu/simd/base_simd.h"
+
+// Vector types for x86 built on the GCC/Clang vector extensions. The
+// element-wise operators lower to AVX-512 (or AVX2) without spelling out
+// intrinsics, which keeps this file generic over the element type like the
+// accelerate backend.
+
+namespace mlx::core::simd {
+
+// Bytes per vector register
+#ifdef __AVX512F__
+constexpr int simd_byte_width = 64;
+#else
+constexpr int simd_byte_width = 32;
+#endif
+
+// This indirection is needed to remap types that the vector extensions
+// cannot handle
+template <typename T, int N>
+struct ScalarT {
+  using v = T;
+};
+template <int N>
+struct ScalarT<bool, N> {
+  using v = char;
+};
+
+template <int S>
+struct SignedIntT;
+template <>
+struct SignedIntT<1> {
+  using v = int8_t;
+};
+template <>
+struct SignedIntT<2> {
+  using v = int16_t;
+};
+template <>
+struct SignedIntT<4> {
+  using v = int32_t;
+};
+template <>
+struct SignedIntT<8> {
+  using v = int64_t;
+};
+
+template <typename T, int N>
+struct Simd {
+  static constexpr int size = N;
+  using scalar_t = typename ScalarT<T, N>::v;
+  // Keep scalar alignment so loads from arbitrarily offset buffers are safe
+  typedef scalar_t vec_t __attribute__((
+      vector_size(N * sizeof(scalar_t)),
+      aligned(alignof(scalar_t))));
+  // Signed integer vector with the same lane width, used as a blend mask
+  typedef typename SignedIntT<sizeof(scalar_t)>::v mask_t __attribute__((
+      vector_size(N * sizeof(scalar_t)),
+      aligned(alignof(scalar_t))));
+
+  Simd() {}
+
+  Simd(vec_t v) : value(v) {}
+
+  template <typename U>
+  Simd(Simd<U, N> other)
+      : value(__builtin_convertvector(other.value, vec_t)) {}
+
+  template <typename U>
+  Simd(U v) : value(vec_t{} + static_cast<scalar_t>(v)) {}
+
+  Simd(Simd<T, N / 2> x, Simd<T, N / 2> y) {
+    std::memcpy(&value, &x.value, sizeof(x.value));
+    std::memcpy(
+        reinterpret_cast<char*>(&value) + sizeof(x.value),
+        &y.value,
+        sizeof(y.value));
+  }
+
+  T operator[](int idx) const {
+    return reinterpret_cast<const T*>(&value)[idx];
+  }
+
+  T& operator[](int idx) {
+    return reinterpret_cast<T*>(&value)[idx];
+  }
+
+  vec_t value;
+};
+
+template <>
+inline constexpr int max_size<int8_t> = simd_byte_width;
+template <>
+inline constexpr int max_size<int16_t> = simd_byte_width / 2;
+template <>
+inline constexpr int max_size<int> = simd_byte_width / 4;
+template <>
+inline constexpr int max_size<int64_t> = simd_byte_width / 8;
+template <>
+inline constexpr int max_size<uint8_t> = simd_byte_width;
+template <>
+inline constexpr int max_size<uint16_t> = simd_byte_width / 2;
+template <>
+inline constexpr int max_size<uint32_t> = simd_byte_width / 4;
+template <>
+inline constexpr int max_size<uint64_t> = simd_byte_width / 8;
+template <>
+inline constexpr int max_size<float> = simd_byte_width / 4;
+template <>
+inline constexpr int max_size<double> = simd_byte_width / 8;
+
+// The transcendentals fall back to per-lane libm calls; the hot ones (exp,
+// erf, sin, cos, ...) are built from the vector ops in math.h instead.
+#define SIMD_SCALAR_UNARY(name, op) \
+  template <typename T, int N>      \
+  Simd<T, N> name(Simd<T, N> v) {   \
+    Simd<T, N> r;                   \
+    for (int i = 0; i < N; ++i) {   \
+      r.value[i] = op(v.value[i]);  \
+    }                               \
+    return r;                       \
+  }
+
+SIMD_SCALAR_UNARY(acos, std::acos)
+SIMD_SCALAR_UNARY(acosh, std::acosh)
+SIMD_SCALAR_UNARY(asin, std::asin)
+SIMD_SCALAR_UNARY(asinh, std::asinh)
+SIMD_SCALAR_UNARY(atan, std::atan)
+SIMD_SCALAR_UNARY(atanh, std::atanh)
+SIMD_SCALAR_UNARY(ceil, std::ceil)
+SIMD_SCALAR_UNARY(cosh, std::cosh)
+SIMD_SCALAR_UNARY(expm1, std::expm1)
+SIMD_SCALAR_UNARY(floor, std::floor)
+SIMD_SCALAR_UNARY(log, std::log)
+SIMD_SCALAR_UNARY(log2, std::log2)
+SIMD_SCALAR_UNARY(log10, std::log10)
+SIMD_SCALAR_UNARY(log1p, std::log1p)
+SIMD_SCALAR_UNARY(rint, std::rint)
+SIMD_SCALAR_UNARY(sinh, std::sinh)
+SIMD_SCALAR_UNARY(sqrt, std::sqrt)
+SIMD_SCALAR_UNARY(tan, std::tan)
+SIMD_SCALAR_UNARY(tanh, std::tanh)
+
+template <typename T, int N>
+Simd<T, N> operator-(Simd<T, N> v) {
+  return Simd<T, N>(-v.value);
+}
+
+template <typename T, int N>
+Simd<T, N> operator~(Simd<T, N> v) {
+  return Simd<T, N>(~v.value);
+}
+
+template <typename T, int N>
+Simd<T, N> abs(Simd<T, N> v) {
+  if constexpr (std::is_unsigned_v<T>) {
+    return v;
+  } else {
+    return Simd<T, N>(v.value < 0 ? -v.value : v.value);
+  }
+}
+
+template <typename T, int N>
+Simd<bool, N> isnan(Simd<T, N> v) {
+  return Simd<bool, N>(__builtin_convertvector(
+      v.value != v.value, typename Simd<bool, N>::vec_t));
+}
+
+template <typename T, int N>
+Simd<bool, N> operator!(Simd<T, N> v) {
+  return Simd<bool, N>(
+      __builtin_convertvector(v.value == 0, typename Simd<bool, N>::vec_t));
+}
+
+#define SIMD_DEFAULT_BINARY(OP)                                       \
+  template <typename T, typename U, int N>                            \
+  Simd<T, N> operator OP(Simd<T, N> x, U y) {                         \
+    return Simd<T, N>(                                                \
+        x.value OP static_cast<typename Simd<T, N>::scalar_t>(y));    \
+  }                                                                   \
+  template <typename T1, typename T2, int N>                          \
+  Simd<T2, N> operator OP(T1 x, Simd<T2, N> y) {                      \
+    return Simd<T2, N>(                                               \
+        static_cast<typename Simd<T2, N>::scalar_t>(x) OP y.value);   \
+  }                                                                   \
+  template <typename T1, typename T2, int N>                          \
+  Simd<T1, N> operator OP(Simd<T1, N> x, Simd<T2, N> y) {             \
+    return Simd<T1, N>(x.value OP Simd<T1, N>(y).value);              \
+  }
+
+SIMD_DEFAULT_BINARY(+)
+SIMD_DEFAULT_BINARY(-)
+SIMD_DEFAULT_BINARY(/)
+SIMD_DEFAULT_BINARY(*)
+SIMD_DEFAULT_BINARY(<<)
+SIMD_DEFAULT_BINARY(>>)
+SIMD_DEFAULT_BINARY(|)
+SIMD_DEFAULT_BINARY(^)
+SIMD_DEFAULT_BINARY(&)
+
+// The vector extensions have no logical operators; these are only used with
+// boolean-valued lanes where the bitwise forms are equivalent
+#define SIMD_DEFAULT_LOGICAL(OP, BITOP)                                     \
+  template <typename T, typename U, int N>                                  \
+  Simd<bool, N> operator OP(Simd<T, N> x, U y) {                            \
+    return Simd<bool, N>(__builtin_convertvector(                           \
+        (x.value != 0)                                                      \
+            BITOP(Simd<T, N>(y).value != 0),                                \
+        typename Simd<bool, N>::vec_t));                                    \
+  }                                                                         \
+  template <typename T1, typename T2, int N>                                \
+  Simd<bool, N> operator OP(T1 x, Simd<T2, N> y) {                          \
+    return Simd<bool, N>(__builtin_convertvector(                           \
+        (Simd<T2, N>(x).value != 0) BITOP(y.value != 0),                    \
+        typename Simd<bool, N>::vec_t));                                    \
+  }                                                                         \
+  template <typename T1, typename T2, int N>                                \
+  Simd<bool, N> operator OP(Simd<T1, N> x, Simd<T2, N> y) {                 \
+    return Simd<bool, N>(__builtin_convertvector(                           \
+        (x.value != 0) BITOP(Simd<T1, N>(y).value != 0),                    \
+        typename Simd<bool, N>::vec_t));                                    \
+  }
+
+SIMD_DEFAULT_LOGICAL(&&, &)
+SIMD_DEFAULT_LOGICAL(||, |)
+
+#define SIMD_DEFAULT_COMPARISONS(OP)                                     \
+  template <int N, typename T, typename U>                               \
+  Simd<bool, N> operator OP(Simd<T, N> a, U b) {                         \
+    return Simd<bool, N>(__builtin_convertvector(                        \
+        a.value OP static_cast<typename Simd<T, N>::scalar_t>(b),        \
+        typename Simd<bool, N>::vec_t));                                 \
+  }                                                                      \
+  template <int N, typename T, typename U>                               \
+  Simd<bool, N> operator OP(T a, Simd<U, N> b) {                         \
+    return Simd<bool, N>(__builtin_convertvector(                        \
+        static_cast<typename Simd<U, N>::scalar_t>(a) OP b.value,        \
+        typename Simd<bool, N>::vec_t));                                 \
+  }                                                                      \
+  template <int N, typename T1, typename T2>                             \
+  Simd<bool, N> operator OP(Simd<T1, N> a, Simd<T2, N> b) {              \
+    return Simd<bool, N>(__builtin_convertvector(                        \
+        a.value OP Simd<T1, N>(b).value,                                 \
+        typename Simd<bool, N>::vec_t));                                 \
+  }
+
+SIMD_DEFAULT_COMPARISONS(>)
+SIMD_DEFAULT_COMPARISONS(<)
+SIMD_DEFAULT_COMPARISONS(>=)
+SIMD_DEFAULT_COMPARISONS(<=)
+SIMD_DEFAULT_COMPARISONS(==)
+SIMD_DEFAULT_COMPARISONS(!=)
+
+template <typename MaskT, typename T1, typename T2, int N>
+Simd<T1, N> select(Simd<MaskT, N> mask, Simd<T1, N> x, Simd<T2, N> y) {
+  static_assert(std::is_same_v<MaskT, bool>);
+  // Widen the mask to the lane width so the vector conditional applies
+  auto m = __builtin_convertvector(
+      mask.value != 0, typename Simd<T1, N>::mask_t);
+  return Simd<T1, N>(m ? x.value : Simd<T1, N>(y).value);
+}
+
+template <typename T, int N>
+Simd<T, N> atan2(Simd<T, N> a, Simd<T, N> b) {
+  Simd<T, N> r;
+  for (int i = 0; i < N; ++i) {
+    r.value[i] = std::atan2(a.value[i], b.value[i]);
+  }
+  return r;
+}
+
+template <typename T, int N>
+Simd<T, N> maximum(Simd<T, N> a, Simd<T, N> b) {
+  Simd<T, N> r(a.value > b.value ? a.value : b.value);
+  if constexpr (!std::is_integral_v<T>) {
+    r = select(isnan(a), a, r);
+  }
+  return r;
+}
+
+template <typename T, int N>
+Simd<T, N> minimum(Simd<T, N> a, Simd<T, N> b) {
+  Simd<T, N> r(a.value < b.value ? a.value : b.value);
+  if constexpr (!std::is_integral_v<T>) {
+    r = select(isnan(a), a, r);
+  }
+  return r;
+}
+
+template <typename T, int N>
+Simd<T, N> remainder(Simd<T, N> a, Simd<T, N> b) {
+  Simd<T, N> r;
+  if constexpr (!std::is_integral_v<T>) {
+    for (int i = 0; i < N; ++i) {
+      r.value[i] = std::remainder(a.value[i], b.value[i]);
+    }
+  } else {
+    r = a - b * (a / b);
+  }
+  if constexpr (std::is_signed_v<T>) {
+    auto mask = (r != 0) && ((r < 0) != (b < 0));
+    r = select(mask, r + b, r);
+  }
+  return r;
+}
+
+template <typename T, int N>
+Simd<T, N> pow(Simd<T, N> base, Simd<T, N> exp) {
+  if constexpr (!std::is_integral_v<T>) {
+    Simd<T, N> r;
+    for (int i = 0; i < N; ++i) {
+      r.value[i] = std::pow(base.value[i], exp.value[i]);
+    }
+    return r;
+  } else {
+    Simd<T, N> res = 1;
+    // Raising an integer to a negative power is undefined
+    if (any(exp < 0)) {
+      return 0;
+    }
+    while (any(exp > 0)) {
+      res = select((exp & 1) != 0, res * base, res);
+      base = select(exp > 0, base * base, base);
+      exp = exp >> 1;
+    }
+    return res;
+  }
+}
+
+template <typename T, int N>
+Simd<T, N> recip(Simd<T, N> v) {
+  return Simd<T, N>(static_cast<typename Simd<T, N>::scalar_t>(1) / v.value);
+}
+
+template <typename T, int N>
+Simd<T, N> rsqrt(Simd<T, N> v) {
+  return recip(sqrt(v));
+}
+
+template <typename T, int N>
+Simd<T, N> clamp(Simd<T, N> v, Simd<T, N> min, Simd<T, N> max) {
+  return minimum(maximum(v, min), max);
+}
+
+template <typename T, typename U, int N>
+Simd<T, N> fma(Simd<T, N> x, Simd<T, N> y, U z) {
+  return Simd<T, N>(x.value * y.value + Simd<T, N>(z).value);
+}
+
+// Reductions are pairwise over the vector halves down to the scalar case
+
+template <typename T, int N>
+bool all(Simd<T, N> x) {
+  auto ptr = (T*)&x;
+  auto lhs = load<T, N / 2>(ptr);
+  auto rhs = load<T, N / 2>(ptr + N / 2);
+  return all(lhs) && all(rhs);
+}
+
+template <typename T, int N>
+bool any(Simd<T, N> x) {
+  auto ptr = (T*)&x;
+  auto lhs = load<T, N / 2>(ptr);
+  auto rhs = load<T, N / 2>(ptr + N / 2);
+  return any(lhs) || any(rhs);
+}
+
+template <typename T, int N>
+T sum(Simd<T, N> x) {
+  auto ptr = (T*)&x;
+  auto lhs = load<T, N / 2>(ptr);
+  auto rhs = load<T, N / 2>(ptr + N / 2);
+  return sum(lhs + rhs);
+}
+
+template <typename T, int N>
+T max(Simd<T, N> x) {
+  auto ptr = (T*)&x;
+  auto lhs = load<T, N / 2>(ptr);
+  auto rhs = load<T, N / 2>(ptr + N / 2);
+  return max(maximum(lhs, rhs));
+}
+
+template <typename T, int N>
+T min(Simd<T, N> x) {
+  auto ptr = (T*)&x;
+  auto lhs = load<T, N / 2>(ptr);
+  auto rhs = load<T, N / 2>(ptr + N / 2);
+  return min(minimum(lhs, rhs));
+}
+
+template <typename T, int N>
+T prod(Simd<T, N> x) {
+  auto ptr = (T*)&x;
+  auto lhs = load<T, N / 2>(ptr);
+  auto rhs = load<T, N / 2>(ptr + N / 2);
+  return prod(lhs * rhs);
+}
+
+} // namespace mlx::core::simd
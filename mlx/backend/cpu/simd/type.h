@@ -4,4 +4,6 @@
 
 #ifdef MLX_USE_ACCELERATE
 #include "mlx/backend/cpu/simd/accelerate_simd.h"
+#elif defined(__AVX2__)
+#include "mlx/backend/cpu/simd/avx_simd.h"
 #endif
@@ -3,11 +3,13 @@
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstring>
 #include <numeric>
 
 #include "mlx/backend/common/utils.h"
 #include "mlx/backend/cpu/copy.h"
 #include "mlx/backend/cpu/encoder.h"
+#include "mlx/backend/cpu/parallel.h"
 #include "mlx/dtype_utils.h"
 #include "mlx/primitives.h"
 
@@ -104,6 +106,110 @@ struct StridedIterator {
   T* ptr_;
 };
 
+// Order-preserving maps between fixed-width values and unsigned keys, so
+// an LSD pass over the key bytes sorts the values. Only specialized for
+// dtypes where the map is a bijection on the bit pattern.
+template <typename T, typename Enable = void>
+struct RadixTraits : std::false_type {};
+
+template <typename T>
+struct RadixTraits<
+    T,
+    std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>>
+    : std::true_type {
+  using KeyT = std::make_unsigned_t<T>;
+  static constexpr KeyT sign = std::is_signed_v<T>
+      ? KeyT(1) << (8 * sizeof(T) - 1)
+      : KeyT(0);
+  static KeyT to_key(T v) {
+    return static_cast<KeyT>(v) ^ sign;
+  }
+  static T from_key(KeyT k) {
+    return static_cast<T>(k ^ sign);
+  }
+};
+
+template <typename T, typename UInt>
+struct FloatRadixTraits : std::true_type {
+  using KeyT = UInt;
+  static constexpr KeyT sign = KeyT(1) << (8 * sizeof(T) - 1);
+  static KeyT to_key(T v) {
+    KeyT u;
+    std::memcpy(&u, &v, sizeof(T));
+    return (u & sign) ? ~u : (u | sign);
+  }
+  static T from_key(KeyT k) {
+    KeyT u = (k & sign) ? (k ^ sign) : ~k;
+    T v;
+    std::memcpy(&v, &u, sizeof(T));
+    return v;
+  }
+};
+
+template <>
+struct RadixTraits<float> : FloatRadixTraits<float, uint32_t> {};
+template <>
+struct RadixTraits<double> : FloatRadixTraits<double, uint64_t> {};
+
+// Rows below this size stay on the comparison sort; per-row histograms
+// don't pay for themselves on short rows
+constexpr int radix_sort_min_size = 256;
+
+// LSD radix sort over contiguous rows, parallelized over the row batch.
+// Each row is mapped to unsigned keys, sorted one byte per pass with a
+// histogram computed in a single read, and mapped back in place. Passes
+// whose byte is constant across the row are skipped.
+template <typename T>
+void radix_sort(T* ptr, size_t n_rows, int axis_size) {
+  using Traits = RadixTraits<T>;
+  using KeyT = typename Traits::KeyT;
+  constexpr int n_passes = sizeof(KeyT);
+
+  parallel_for(n_rows, [&](size_t start, size_t end) {
+    std::vector<KeyT> keys(axis_size);
+    std::vector<KeyT> scratch(axis_size);
+    for (size_t r = start; r < end; ++r) {
+      T* row = ptr + r * axis_size;
+      for (int i = 0; i < axis_size; ++i) {
+        keys[i] = Traits::to_key(row[i]);
+      }
+
+      // Histogram every pass's byte in one read of the row
+      size_t hist[n_passes][256] = {};
+      for (int i = 0; i < axis_size; ++i) {
+        for (int p = 0; p < n_passes; ++p) {
+          hist[p][(keys[i] >> (8 * p)) & 0xFF]++;
+        }
+      }
+
+      KeyT* src = keys.data();
+      KeyT* dst = scratch.data();
+      for (int p = 0; p < n_passes; ++p) {
+        // The byte is constant across the row; nothing to move. The
+        // histogram stays valid across passes since they only permute.
+        if (hist[p][(src[0] >> (8 * p)) & 0xFF] ==
+            static_cast<size_t>(axis_size)) {
+          continue;
+        }
+        size_t offsets[256];
+        size_t total = 0;
+        for (int b = 0; b < 256; ++b) {
+          offsets[b] = total;
+          total += hist[p][b];
+        }
+        for (int i = 0; i < axis_size; ++i) {
+          dst[offsets[(src[i] >> (8 * p)) & 0xFF]++] = src[i];
+        }
+        std::swap(src, dst);
+      }
+
+      for (int i = 0; i < axis_size; ++i) {
+        row[i] = Traits::from_key(src[i]);
+      }
+    }
+  });
+}
+
 template <typename T>
 void sort(array& out, int axis) {
   // Get axis, shape and stride info
@@ -111,6 +217,14 @@ void sort(array& out, int axis) {
   size_t in_size = out.size();
   size_t n_rows = in_size / out.shape(axis);
 
+  if constexpr (RadixTraits<T>::value) {
+    if (out.flags().row_contiguous && axis == out.ndim() - 1 &&
+        out.shape(axis) >= radix_sort_min_size) {
+      radix_sort(out.data<T>(), n_rows, out.shape(axis));
+      return;
+    }
+  }
+
   auto remaining_shape = out.shape();
   remaining_shape.erase(remaining_shape.begin() + axis);
 
@@ -0,0 +1,136 @@
+// Copyright © 2025 Apple Inc.
+
+#include <cassert>
+
+#include "mlx/allocator.h"
+#include "mlx/backend/cpu/copy.h"
+#include "mlx/backend/cpu/encoder.h"
+#include "mlx/backend/cpu/simd/simd.h"
+#include "mlx/primitives.h"
+
+namespace mlx::core {
+
+namespace {
+
+using namespace mlx::core::simd;
+
+template <typename T, typename AccT>
+void sparse_matmul(
+    const int32_t* indptr,
+    const int32_t* indices,
+    const T* data,
+    const T* b,
+    T* out,
+    int M,
+    int N) {
+  constexpr int S = std::min(max_size<AccT>, max_size<T>);
+  // Accumulate each output row in a dense register-width strided buffer:
+  // every nonzero of the row scales one row of b and adds it on, so the
+  // work is proportional to the stored entries rather than the dense
+  // shape.
+  std::vector<AccT> acc(N);
+  for (int i = 0; i < M; ++i) {
+    std::fill(acc.begin(), acc.end(), AccT(0));
+    for (int32_t j = indptr[i]; j < indptr[i + 1]; ++j) {
+      auto v = static_cast<AccT>(data[j]);
+      auto vv = Simd<AccT, S>(v);
+      const T* b_row = b + static_cast<int64_t>(indices[j]) * N;
+      int n = 0;
+      for (; n + S <= N; n += S) {
+        auto vacc = load<AccT, S>(acc.data() + n);
+        Simd<AccT, S> vb = load<T, S>(b_row + n);
+        store(acc.data() + n, vacc + vv * vb);
+      }
+      for (; n < N; ++n) {
+        acc[n] += v * static_cast<AccT>(b_row[n]);
+      }
+    }
+    T* out_row = out + static_cast<int64_t>(i) * N;
+    for (int n = 0; n < N; ++n) {
+      out_row[n] = static_cast<T>(acc[n]);
+    }
+  }
+}
+
+} // namespace
+
+void SparseMatmul::eval_cpu(const std::vector<array>& inputs, array& out) {
+  assert(inputs.size() == 4);
+  out.set_data(allocator::malloc(out.nbytes()));
+
+  auto& s = stream();
+  auto& encoder = cpu::get_command_encoder(s);
+  auto ensure_row_contiguous = [&s, &encoder](const array& x) {
+    if (x.flags().row_contiguous) {
+      return x;
+    }
+    auto xc = contiguous_copy_cpu(x, s);
+    encoder.add_temporary(xc);
+    return xc;
+  };
+
+  auto indptr = ensure_row_contiguous(inputs[0]);
+  auto indices = ensure_row_contiguous(inputs[1]);
+  auto data = ensure_row_contiguous(inputs[2]);
+  auto b = ensure_row_contiguous(inputs[3]);
+
+  encoder.set_input_array(indptr);
+  encoder.set_input_array(indices);
+  encoder.set_input_array(data);
+  encoder.set_input_array(b);
+  encoder.set_output_array(out);
+
+  int M = out.shape(0);
+  int N = out.shape(1);
+  encoder.dispatch([indptr_ptr = indptr.data<int32_t>(),
+                    indices_ptr = indices.data<int32_t>(),
+                    data_ptr = data.data<void>(),
+                    b_ptr = b.data<void>(),
+                    out_ptr = out.data<void>(),
+                    dtype = out.dtype(),
+                    M,
+                    N]() {
+    switch (dtype) {
+      case float32:
+        return sparse_matmul<float, float>(
+            indptr_ptr,
+            indices_ptr,
+            static_cast<const float*>(data_ptr),
+            static_cast<const float*>(b_ptr),
+            static_cast<float*>(out_ptr),
+            M,
+            N);
+      case float64:
+        return sparse_matmul<double, double>(
+            indptr_ptr,
+            indices_ptr,
+            static_cast<const double*>(data_ptr),
+            static_cast<const double*>(b_ptr),
+            static_cast<double*>(out_ptr),
+            M,
+            N);
+      case float16:
+        return sparse_matmul<float16_t, float>(
+            indptr_ptr,
+            indices_ptr,
+            static_cast<const float16_t*>(data_ptr),
+            static_cast<const float16_t*>(b_ptr),
+            static_cast<float16_t*>(out_ptr),
+            M,
+            N);
+      case bfloat16:
+        return sparse_matmul<bfloat16_t, float>(
+            indptr_ptr,
+            indices_ptr,
+            static_cast<const bfloat16_t*>(data_ptr),
+            static_cast<const bfloat16_t*>(b_ptr),
+            static_cast<bfloat16_t*>(out_ptr),
+            M,
+            N);
+      default:
+        throw std::runtime_error("[SparseMatmul] Unsupported type.");
+    }
+  });
+}
+
+} // namespace mlx::core
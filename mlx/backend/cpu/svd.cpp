@@ -4,6 +4,7 @@
 #include "mlx/backend/cpu/copy.h"
 #include "mlx/backend/cpu/encoder.h"
 #include "mlx/backend/cpu/lapack.h"
+#include "mlx/backend/cpu/parallel.h"
 #include "mlx/primitives.h"
 
 namespace mlx::core {
@@ -120,35 +121,40 @@ void svd_impl(
     }
 
     const int lwork = workspace_dimension;
-    auto scratch = array::Data{allocator::malloc(sizeof(T) * lwork)};
-
-    // Loop over matrices.
-    for (int i = 0; i < num_matrices; i++) {
-      gesdd<T>(
-          /* jobz = */ jobz,
-          // M and N are swapped since lapack expects column-major.
-          /* m = */ &N,
-          /* n = */ &M,
-          /* a = */ in_ptr + M * N * i,
-          /* lda = */ &lda,
-          /* s = */ s_ptr + K * i,
-          // According to the identity above, lapack will write Vᵀᵀ as U.
-          /* u = */ vt_ptr ? vt_ptr + N * N * i : nullptr,
-          /* ldu = */ &ldu,
-          // According to the identity above, lapack will write Uᵀ as Vᵀ.
-          /* vt = */ u_ptr ? u_ptr + M * M * i : nullptr,
-          /* ldvt = */ &ldvt,
-          /* work = */ static_cast<T*>(scratch.buffer.raw_ptr()),
-          /* lwork = */ &lwork,
-          /* iwork = */ static_cast<int*>(iwork.buffer.raw_ptr()),
-          /* info = */ &info);
-
-      if (info != 0) {
-        std::stringstream ss;
-        ss << "svd_impl: sgesvdx_ failed with code " << info;
-        throw std::runtime_error(ss.str());
+
+    // The matrices are independent, so chunks of the batch run on the
+    // worker pool, each with its own scratch space.
+    parallel_for(num_matrices, [&](size_t start, size_t end) {
+      auto scratch = array::Data{allocator::malloc(sizeof(T) * lwork)};
+      auto iwork_chunk = array::Data{allocator::malloc(sizeof(int) * 8 * K)};
+      for (size_t i = start; i < end; i++) {
+        int info;
+        gesdd<T>(
+            /* jobz = */ jobz,
+            // M and N are swapped since lapack expects column-major.
+            /* m = */ &N,
+            /* n = */ &M,
+            /* a = */ in_ptr + M * N * i,
+            /* lda = */ &lda,
+            /* s = */ s_ptr + K * i,
+            // According to the identity above, lapack will write Vᵀᵀ as U.
+            /* u = */ vt_ptr ? vt_ptr + N * N * i : nullptr,
+            /* ldu = */ &ldu,
+            // According to the identity above, lapack will write Uᵀ as Vᵀ.
+            /* vt = */ u_ptr ? u_ptr + M * M * i : nullptr,
+            /* ldvt = */ &ldvt,
+            /* work = */ static_cast<T*>(scratch.buffer.raw_ptr()),
+            /* lwork = */ &lwork,
+            /* iwork = */ static_cast<int*>(iwork_chunk.buffer.raw_ptr()),
+            /* info = */ &info);
+
+        if (info != 0) {
+          std::stringstream ss;
+          ss << "svd_impl: sgesvdx_ failed with code " << info;
+          throw std::runtime_error(ss.str());
+        }
       }
-    }
+    });
   });
   encoder.add_temporary(in);
 }
@@ -5,6 +5,8 @@
 #include <cstdint>
 #include <utility>
 
+#include "mlx/backend/cpu/simd/simd.h"
+
 namespace mlx::core::random {
 
 /** Applies the Threefry 2x32 hash function.
@@ -18,4 +20,33 @@ std::pair<uint32_t, uint32_t> threefry2x32_hash(
     const std::pair<uint32_t, uint32_t>& key,
     std::pair<uint32_t, uint32_t> count);
 
+/** Hash N counters with the same key in one pass. The math is identical to
+ * the scalar version so both produce the same bit stream. */
+template <int N>
+std::pair<simd::Simd<uint32_t, N>, simd::Simd<uint32_t, N>> threefry2x32_hash(
+    const std::pair<uint32_t, uint32_t>& key,
+    simd::Simd<uint32_t, N> c0,
+    simd::Simd<uint32_t, N> c1) {
+  constexpr static uint32_t rotations[2][4] = {
+      {13, 15, 26, 6}, {17, 29, 16, 24}};
+
+  uint32_t ks[3] = {key.first, key.second, key.first ^ key.second ^ 0x1BD11BDA};
+
+  c0 = c0 + simd::Simd<uint32_t, N>(ks[0]);
+  c1 = c1 + simd::Simd<uint32_t, N>(ks[1]);
+
+  for (int i = 0; i < 5; ++i) {
+    for (auto r : rotations[i % 2]) {
+      c0 = c0 + c1;
+      c1 = (c1 << simd::Simd<uint32_t, N>(r)) |
+          (c1 >> simd::Simd<uint32_t, N>(32 - r));
+      c1 = c1 ^ c0;
+    }
+    c0 = c0 + simd::Simd<uint32_t, N>(ks[(i + 1) % 3]);
+    c1 = c1 + simd::Simd<uint32_t, N>(ks[(i + 2) % 3] + i + 1);
+  }
+
+  return {c0, c1};
+}
+
 } // namespace mlx::core::random
@@ -2,6 +2,9 @@
 
 #pragma once
 
+#include <array>
+#include <sstream>
+
 #include "mlx/backend/common/unary.h"
 #include "mlx/backend/cpu/encoder.h"
 #include "mlx/backend/cpu/simd/simd.h"
@@ -52,230 +55,188 @@ void unary_op(const array& a, array& out, Op) {
   }
 }
 
+// Kernels are resolved once at graph build: each dispatcher indexes a
+// constexpr table by Dtype::Val and captures the function pointer, so the
+// scheduled task makes a single indirect call instead of switching on
+// dtype per dispatch. Unsupported dtypes hold a null entry and error out
+// before anything is scheduled.
+using UnaryKernel = void (*)(const array&, array&);
+
+template <typename T, typename U, typename Op>
+void unary_kernel(const array& a, array& out) {
+  unary_op<T, U, Op>(a, out, Op{});
+}
+
 template <typename Op>
-void unary(const array& a, array& out, Op op, Stream stream) {
+inline constexpr std::array<UnaryKernel, 14> unary_all_kernels = {
+    &unary_kernel<bool, bool, Op>,
+    &unary_kernel<uint8_t, uint8_t, Op>,
+    &unary_kernel<uint16_t, uint16_t, Op>,
+    &unary_kernel<uint32_t, uint32_t, Op>,
+    &unary_kernel<uint64_t, uint64_t, Op>,
+    &unary_kernel<int8_t, int8_t, Op>,
+    &unary_kernel<int16_t, int16_t, Op>,
+    &unary_kernel<int32_t, int32_t, Op>,
+    &unary_kernel<int64_t, int64_t, Op>,
+    &unary_kernel<float16_t, float16_t, Op>,
+    &unary_kernel<float, float, Op>,
+    &unary_kernel<double, double, Op>,
+    &unary_kernel<bfloat16_t, bfloat16_t, Op>,
+    &unary_kernel<complex64_t, complex64_t, Op>,
+};
+
+template <typename Op>
+inline constexpr std::array<UnaryKernel, 14> unary_real_fp_kernels = {
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    &unary_kernel<float16_t, float16_t, Op>,
+    &unary_kernel<float, float, Op>,
+    &unary_kernel<double, double, Op>,
+    &unary_kernel<bfloat16_t, bfloat16_t, Op>,
+    nullptr,
+};
+
+template <typename Op>
+inline constexpr std::array<UnaryKernel, 14> unary_fp_kernels = {
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    &unary_kernel<float16_t, float16_t, Op>,
+    &unary_kernel<float, float, Op>,
+    &unary_kernel<double, double, Op>,
+    &unary_kernel<bfloat16_t, bfloat16_t, Op>,
+    &unary_kernel<complex64_t, complex64_t, Op>,
+};
+
+template <typename Op>
+inline constexpr std::array<UnaryKernel, 14> unary_signed_kernels = {
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    &unary_kernel<int8_t, int8_t, Op>,
+    &unary_kernel<int16_t, int16_t, Op>,
+    &unary_kernel<int32_t, int32_t, Op>,
+    &unary_kernel<int64_t, int64_t, Op>,
+    &unary_kernel<float16_t, float16_t, Op>,
+    &unary_kernel<float, float, Op>,
+    &unary_kernel<double, double, Op>,
+    &unary_kernel<bfloat16_t, bfloat16_t, Op>,
+    &unary_kernel<complex64_t, complex64_t, Op>,
+};
+
+template <typename Op>
+inline constexpr std::array<UnaryKernel, 14> unary_int_kernels = {
+    nullptr,
+    &unary_kernel<uint8_t, uint8_t, Op>,
+    &unary_kernel<uint16_t, uint16_t, Op>,
+    &unary_kernel<uint32_t, uint32_t, Op>,
+    &unary_kernel<uint64_t, uint64_t, Op>,
+    &unary_kernel<int8_t, int8_t, Op>,
+    &unary_kernel<int16_t, int16_t, Op>,
+    &unary_kernel<int32_t, int32_t, Op>,
+    &unary_kernel<int64_t, int64_t, Op>,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+};
+
+inline void dispatch_unary(
+    const array& a,
+    array& out,
+    UnaryKernel kernel,
+    const char* tag,
+    Stream stream) {
+  if (kernel == nullptr) {
+    std::ostringstream err;
+    err << "[" << tag << "] Does not support " << out.dtype();
+    throw std::runtime_error(err.str());
+  }
   set_unary_output_data(a, out);
   auto& encoder = cpu::get_command_encoder(stream);
   encoder.set_input_array(a);
   encoder.set_output_array(out);
   encoder.dispatch([a = array::unsafe_weak_copy(a),
                     out = array::unsafe_weak_copy(out),
-                    op = op]() mutable {
-    switch (out.dtype()) {
-      case bool_:
-        unary_op<bool>(a, out, op);
-        break;
-      case uint8:
-        unary_op<uint8_t>(a, out, op);
-        break;
-      case uint16:
-        unary_op<uint16_t>(a, out, op);
-        break;
-      case uint32:
-        unary_op<uint32_t>(a, out, op);
-        break;
-      case uint64:
-        unary_op<uint64_t>(a, out, op);
-        break;
-      case int8:
-        unary_op<int8_t>(a, out, op);
-        break;
-      case int16:
-        unary_op<int16_t>(a, out, op);
-        break;
-      case int32:
-        unary_op<int32_t>(a, out, op);
-        break;
-      case int64:
-        unary_op<int64_t>(a, out, op);
-        break;
-      case float16:
-        unary_op<float16_t>(a, out, op);
-        break;
-      case float32:
-        unary_op<float>(a, out, op);
-        break;
-      case float64:
-        unary_op<double>(a, out, op);
-        break;
-      case bfloat16:
-        unary_op<bfloat16_t>(a, out, op);
-        break;
-      case complex64:
-        unary_op<complex64_t>(a, out, op);
-        break;
-    }
-  });
+                    kernel]() mutable { kernel(a, out); });
+}
+
+template <typename Op>
+void unary(const array& a, array& out, Op op, Stream stream) {
+  dispatch_unary(
+      a,
+      out,
+      unary_all_kernels<Op>[static_cast<int>(out.dtype().val())],
+      "unary",
+      stream);
 }
 
 template <typename Op>
 void unary_real_fp(const array& a, array& out, Op op, Stream stream) {
-  set_unary_output_data(a, out);
-  auto& encoder = cpu::get_command_encoder(stream);
-  encoder.set_input_array(a);
-  encoder.set_output_array(out);
-  encoder.dispatch([a = array::unsafe_weak_copy(a),
-                    out = array::unsafe_weak_copy(out),
-                    op = op]() mutable {
-    switch (out.dtype()) {
-      case bfloat16:
-        unary_op<bfloat16_t>(a, out, op);
-        break;
-      case float16:
-        unary_op<float16_t>(a, out, op);
-        break;
-      case float32:
-        unary_op<float>(a, out, op);
-        break;
-      case float64:
-        unary_op<double>(a, out, op);
-        break;
-      default:
-        std::ostringstream err;
-        err << "[unary_real] Does not support " << out.dtype();
-        throw std::runtime_error(err.str());
-    }
-  });
+  dispatch_unary(
+      a,
+      out,
+      unary_real_fp_kernels<Op>[static_cast<int>(out.dtype().val())],
+      "unary_real",
+      stream);
 }
+
 template <typename Op>
 void unary_fp(const array& a, array& out, Op op, Stream stream) {
-  set_unary_output_data(a, out);
-  auto& encoder = cpu::get_command_encoder(stream);
-  encoder.set_input_array(a);
-  encoder.set_output_array(out);
-  encoder.dispatch([a = array::unsafe_weak_copy(a),
-                    out = array::unsafe_weak_copy(out),
-                    op = op]() mutable {
-    switch (out.dtype()) {
-      case bfloat16:
-        unary_op<bfloat16_t>(a, out, op);
-        break;
-      case float16:
-        unary_op<float16_t>(a, out, op);
-        break;
-      case float32:
-        unary_op<float>(a, out, op);
-        break;
-      case float64:
-        unary_op<double>(a, out, op);
-        break;
-      case complex64:
-        unary_op<complex64_t>(a, out, op);
-        break;
-      default:
-        std::ostringstream err;
-        err << "[unary_fp] Does not support " << out.dtype();
-        throw std::runtime_error(err.str());
-    }
-  });
+  dispatch_unary(
+      a,
+      out,
+      unary_fp_kernels<Op>[static_cast<int>(out.dtype().val())],
+      "unary_fp",
+      stream);
 }
 
 template <typename Op>
 void unary_signed(const array& a, array& out, Op op, Stream stream) {
-  set_unary_output_data(a, out);
-  auto& encoder = cpu::get_command_encoder(stream);
-  encoder.set_input_array(a);
-  encoder.set_output_array(out);
-  encoder.dispatch([a = array::unsafe_weak_copy(a),
-                    out = array::unsafe_weak_copy(out),
-                    op = op]() mutable {
-    switch (out.dtype()) {
-      case int8:
-        unary_op<int8_t>(a, out, op);
-        break;
-      case int16:
-        unary_op<int16_t>(a, out, op);
-        break;
-      case int32:
-        unary_op<int32_t>(a, out, op);
-        break;
-      case int64:
-        unary_op<int64_t>(a, out, op);
-        break;
-      case float16:
-        unary_op<float16_t>(a, out, op);
-        break;
-      case float32:
-        unary_op<float>(a, out, op);
-        break;
-      case float64:
-        unary_op<double>(a, out, op);
-        break;
-      case bfloat16:
-        unary_op<bfloat16_t>(a, out, op);
-        break;
-      case complex64:
-        unary_op<complex64_t>(a, out, op);
-        break;
-      default:
-        throw std::runtime_error("[Abs] Called on unsigned type");
-    }
-  });
+  dispatch_unary(
+      a,
+      out,
+      unary_signed_kernels<Op>[static_cast<int>(out.dtype().val())],
+      "unary_signed",
+      stream);
 }
 
 template <typename Op>
 void unary_complex(const array& a, array& out, Op op, Stream stream) {
-  set_unary_output_data(a, out);
-  auto& encoder = cpu::get_command_encoder(stream);
-  encoder.set_input_array(a);
-  encoder.set_output_array(out);
-  encoder.dispatch([a = array::unsafe_weak_copy(a),
-                    out = array::unsafe_weak_copy(out),
-                    op = op]() mutable { unary_op<complex64_t>(a, out, op); });
+  dispatch_unary(
+      a, out, &unary_kernel<complex64_t, complex64_t, Op>, "unary", stream);
 }
 
 template <typename Op>
 void unary_complex_to_float(const array& a, array& out, Op op, Stream stream) {
-  set_unary_output_data(a, out);
-  auto& encoder = cpu::get_command_encoder(stream);
-  encoder.set_input_array(a);
-  encoder.set_output_array(out);
-  encoder.dispatch(
-      [a = array::unsafe_weak_copy(a),
-       out = array::unsafe_weak_copy(out),
-       op = op]() mutable { unary_op<complex64_t, float>(a, out, op); });
+  dispatch_unary(
+      a, out, &unary_kernel<complex64_t, float, Op>, "unary", stream);
 }
 
 template <typename Op>
 void unary_int(const array& a, array& out, Op op, Stream stream) {
-  set_unary_output_data(a, out);
-  auto& encoder = cpu::get_command_encoder(stream);
-  encoder.set_input_array(a);
-  encoder.set_output_array(out);
-  encoder.dispatch([a = array::unsafe_weak_copy(a),
-                    out = array::unsafe_weak_copy(out),
-                    op = op]() mutable {
-    switch (out.dtype()) {
-      case uint8:
-        unary_op<uint8_t>(a, out, op);
-        break;
-      case uint16:
-        unary_op<uint16_t>(a, out, op);
-        break;
-      case uint32:
-        unary_op<uint32_t>(a, out, op);
-        break;
-      case uint64:
-        unary_op<uint64_t>(a, out, op);
-        break;
-      case int8:
-        unary_op<int8_t>(a, out, op);
-        break;
-      case int16:
-        unary_op<int16_t>(a, out, op);
-        break;
-      case int32:
-        unary_op<int32_t>(a, out, op);
-        break;
-      case int64:
-        unary_op<int64_t>(a, out, op);
-        break;
-      default:
-        std::ostringstream err;
-        err << "[unary_int] Does not support " << out.dtype();
-        throw std::runtime_error(err.str());
-    }
-  });
+  dispatch_unary(
+      a,
+      out,
+      unary_int_kernels<Op>[static_cast<int>(out.dtype().val())],
+      "unary_int",
+      stream);
 }
 
 } // namespace mlx::core
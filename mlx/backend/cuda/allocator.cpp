@@ -1,7 +1,10 @@
 // Copyright © 2025 Apple Inc.
 
 #include "mlx/backend/cuda/allocator.h"
+#include "mlx/array.h"
+#include "mlx/backend/common/resident_memory.h"
 #include "mlx/backend/cuda/utils.h"
+#include "mlx/memory.h"
 #include "mlx/utils.h"
 
 #include <cuda_runtime.h>
@@ -23,6 +26,14 @@ constexpr int small_block_size = 8;
 // size and small_block_size.
 constexpr int small_pool_size = 4 * page_size;
 
+// The byte budget of each per-stream buffer pool when
+// MLX_STREAM_BUFFER_POOLS is enabled.
+constexpr size_t stream_pool_size = 1 << 24;
+
+// How many allocations go by between samples of the process resident set
+// size when an rss watermark is set.
+constexpr size_t rss_check_interval = 256;
+
 SmallSizePool::SmallSizePool() {
   auto num_blocks = small_pool_size / small_block_size;
   buffer_ = new Block[num_blocks];
@@ -82,7 +93,10 @@ CudaAllocator::CudaAllocator()
     : buffer_cache_(
           page_size,
           [](CudaBuffer* buf) { return buf->size; },
-          [this](CudaBuffer* buf) { cuda_free(buf); }) {
+          [this](CudaBuffer* buf) { cuda_free(buf); }),
+      stream_pools_(
+          stream_pool_size,
+          [](CudaBuffer* buf) { return buf->size; }) {
   // TODO: Set memory limit for multi-device.
   size_t free, total;
   CHECK_CUDA_ERROR(cudaMemGetInfo(&free, &total));
@@ -91,9 +105,6 @@ CudaAllocator::CudaAllocator()
 }
 
 Buffer CudaAllocator::malloc(size_t size) {
-  // Find available buffer from cache.
-  auto orig_size = size;
-  std::unique_lock lock(mutex_);
   if (size <= small_block_size) {
     size = 8;
   } else if (size < page_size) {
@@ -102,12 +113,30 @@ Buffer CudaAllocator::malloc(size_t size) {
     size = page_size * ((size + page_size - 1) / page_size);
   }
 
+  // Try the calling stream's local pool without taking the global lock.
+  if (env::stream_buffer_pools()) {
+    if (CudaBuffer* buf = stream_pools_.try_reuse(size)) {
+      buf->resident_device = -1;
+      update_peak_memory(active_memory_.fetch_add(size) + size);
+      check_rss_watermark();
+      return Buffer{buf};
+    }
+  }
+
+  // Find available buffer from cache.
+  std::unique_lock lock(mutex_);
   CudaBuffer* buf = buffer_cache_.reuse_from_cache(size);
   if (!buf) {
-    // If we have a lot of memory pressure try to reclaim memory from the cache.
+    // If we have a lot of memory pressure try to reclaim memory from the
+    // stream pools and the cache.
     int64_t mem_to_free =
         get_active_memory() + get_cache_memory() + size - memory_limit_;
     if (mem_to_free > 0) {
+      std::vector<CudaBuffer*> drained;
+      stream_pools_.drain(drained);
+      for (auto* b : drained) {
+        buffer_cache_.recycle_to_cache(b);
+      }
       buffer_cache_.release_cached_buffers(mem_to_free);
     }
 
@@ -126,22 +155,95 @@ Buffer CudaAllocator::malloc(size_t size) {
     }
     lock.lock();
   }
-  active_memory_ += size;
-  peak_memory_ = std::max(active_memory_, peak_memory_);
+  buf->resident_device = -1;
+  update_peak_memory(active_memory_.fetch_add(size) + size);
 
   // Maintain the cache below the requested limit.
   if (get_cache_memory() > max_pool_size_) {
     buffer_cache_.release_cached_buffers(get_cache_memory() - max_pool_size_);
   }
+  lock.unlock();
+  check_rss_watermark();
+  return Buffer{buf};
+}
+
+Buffer CudaAllocator::malloc_wired(size_t size) {
+  if (size == 0) {
+    return Buffer{nullptr};
+  }
+  auto* buf = new CudaBuffer{nullptr, size, false, false, true};
+  cudaError_t err = cudaMallocManaged(&buf->data, size);
+  if (err != cudaSuccess) {
+    delete buf;
+    if (err != cudaErrorMemoryAllocation) {
+      throw std::runtime_error(fmt::format(
+          "cudaMallocManaged failed: {}.", cudaGetErrorString(err)));
+    }
+    return Buffer{nullptr};
+  }
+  // Keep the data device resident so it is not evicted under pressure
+#if CUDART_VERSION >= 13000
+  cudaMemLocation loc;
+  loc.type = cudaMemLocationTypeDevice;
+  loc.id = 0;
+#else
+  int loc = 0;
+#endif // CUDART_VERSION >= 13000
+  cudaMemAdvise(buf->data, size, cudaMemAdviseSetPreferredLocation, loc);
+  update_peak_memory(active_memory_.fetch_add(size) + size);
   return Buffer{buf};
 }
 
+Buffer CudaAllocator::wrap_external(void* ptr, size_t size) {
+  if (ptr == nullptr || size == 0) {
+    return Buffer{nullptr};
+  }
+  // Page-lock the memory so the GPU can access it; regions the caller
+  // already registered are left alone.
+  bool registered = false;
+  cudaError_t err = cudaHostRegister(ptr, size, cudaHostRegisterDefault);
+  if (err == cudaSuccess) {
+    registered = true;
+  } else if (err == cudaErrorHostMemoryAlreadyRegistered) {
+    cudaGetLastError();
+  } else {
+    throw std::runtime_error(fmt::format(
+        "[wrap_external] cudaHostRegister failed: {}.",
+        cudaGetErrorString(err)));
+  }
+  return Buffer{new CudaBuffer{ptr, size, true, registered}};
+}
+
 void CudaAllocator::free(Buffer buffer) {
   auto* buf = static_cast<CudaBuffer*>(buffer.ptr());
   if (!buf) {
     return;
   }
 
+  // Wired buffers are released outright, never cached.
+  if (buf->wired) {
+    active_memory_ -= buf->size;
+    cudaFree(buf->data);
+    delete buf;
+    return;
+  }
+
+  // Externally owned memory only releases the wrapper's bookkeeping.
+  if (buf->external) {
+    if (buf->registered) {
+      cudaHostUnregister(buf->data);
+    }
+    delete buf;
+    return;
+  }
+
+  // Keep the buffer in the calling stream's local pool when there is room.
+  if (env::stream_buffer_pools() && get_cache_memory() < max_pool_size_ &&
+      stream_pools_.try_recycle(buf)) {
+    active_memory_ -= buf->size;
+    return;
+  }
+
   std::unique_lock lock(mutex_);
   active_memory_ -= buf->size;
   if (get_cache_memory() < max_pool_size_) {
@@ -159,6 +261,34 @@ size_t CudaAllocator::size(Buffer buffer) const {
   return buf->size;
 }
 
+void CudaAllocator::update_peak_memory(size_t active) {
+  size_t peak = peak_memory_.load(std::memory_order_relaxed);
+  while (peak < active && !peak_memory_.compare_exchange_weak(peak, active)) {
+  }
+}
+
+void CudaAllocator::check_rss_watermark() {
+  size_t watermark = rss_watermark_.load(std::memory_order_relaxed);
+  if (watermark == 0 ||
+      (malloc_count_.fetch_add(1, std::memory_order_relaxed) %
+       rss_check_interval) != 0) {
+    return;
+  }
+  size_t rss = get_resident_memory();
+  if (rss <= watermark) {
+    return;
+  }
+
+  // Trim toward the low watermark.
+  std::lock_guard lock(mutex_);
+  std::vector<CudaBuffer*> drained;
+  stream_pools_.drain(drained);
+  for (auto* b : drained) {
+    buffer_cache_.recycle_to_cache(b);
+  }
+  buffer_cache_.release_cached_buffers(rss - 0.9 * watermark);
+}
+
 // This must be called with mutex_ aquired
 void CudaAllocator::cuda_free(CudaBuffer* buf) {
   if (scalar_pool_.in_pool(buf)) {
@@ -193,7 +323,16 @@ size_t CudaAllocator::set_memory_limit(size_t limit) {
 }
 
 size_t CudaAllocator::get_cache_memory() const {
-  return buffer_cache_.cache_size();
+  return buffer_cache_.cache_size() + stream_pools_.pool_size();
+}
+
+CacheStats CudaAllocator::get_cache_stats() const {
+  return buffer_cache_.stats();
+}
+
+void CudaAllocator::reset_cache_stats() {
+  std::lock_guard lk(mutex_);
+  buffer_cache_.reset_stats();
 }
 
 size_t CudaAllocator::set_cache_limit(size_t limit) {
@@ -202,8 +341,17 @@ size_t CudaAllocator::set_cache_limit(size_t limit) {
   return limit;
 }
 
+size_t CudaAllocator::set_rss_watermark(size_t limit) {
+  return rss_watermark_.exchange(limit);
+}
+
 void CudaAllocator::clear_cache() {
   std::lock_guard lk(mutex_);
+  std::vector<CudaBuffer*> drained;
+  stream_pools_.drain(drained);
+  for (auto* buf : drained) {
+    cuda_free(buf);
+  }
   buffer_cache_.clear();
 }
 
@@ -215,6 +363,48 @@ CudaAllocator& allocator() {
   return *allocator_;
 }
 
+// Migrations run on a dedicated non-blocking stream so they overlap with
+// compute on the per-device streams
+static cudaStream_t transfer_stream() {
+  static cudaStream_t stream = []() {
+    cudaStream_t s;
+    CHECK_CUDA_ERROR(cudaStreamCreateWithFlags(&s, cudaStreamNonBlocking));
+    return s;
+  }();
+  return stream;
+}
+
+void prefetch_to_device(CudaBuffer* buf, int device /* = 0 */) {
+  if (buf == nullptr || buf->data == nullptr || buf->external) {
+    // Externally owned memory is page-locked host memory, not managed
+    return;
+  }
+  // Buffers below a page migrate faster than the hint costs
+  if (buf->size < page_size) {
+    return;
+  }
+  // Without concurrent managed access a prefetch can force the device to
+  // synchronize, which would defeat the point of the hint
+  static bool supported = []() {
+    int attr = 0;
+    cudaDeviceGetAttribute(&attr, cudaDevAttrConcurrentManagedAccess, 0);
+    return attr != 0;
+  }();
+  if (!supported) {
+    return;
+  }
+#if CUDART_VERSION >= 13000
+  cudaMemLocation loc;
+  loc.type = cudaMemLocationTypeDevice;
+  loc.id = device;
+  cudaMemPrefetchAsync(buf->data, buf->size, loc, 0, transfer_stream());
+#else
+  cudaMemPrefetchAsync(buf->data, buf->size, device, transfer_stream());
+#endif // CUDART_VERSION >= 13000
+  // Best effort; a failed hint leaves demand paging to do the job
+  cudaGetLastError();
+}
+
 } // namespace cu
 
 namespace allocator {
@@ -250,9 +440,18 @@ size_t get_memory_limit() {
 size_t get_cache_memory() {
   return cu::allocator().get_cache_memory();
 }
+CacheStats get_cache_stats() {
+  return cu::allocator().get_cache_stats();
+}
+void reset_cache_stats() {
+  cu::allocator().reset_cache_stats();
+}
 size_t set_cache_limit(size_t limit) {
   return cu::allocator().set_cache_limit(limit);
 }
+size_t set_rss_watermark(size_t limit) {
+  return cu::allocator().set_rss_watermark(limit);
+}
 void clear_cache() {
   cu::allocator().clear_cache();
 }
@@ -262,4 +461,34 @@ size_t set_wired_limit(size_t) {
   return 0;
 }
 
+void prefetch(const array& a, Device device) {
+  if (a.status() == array::Status::unscheduled || a.nbytes() == 0) {
+    return;
+  }
+  auto buffer = a.buffer();
+  auto* buf = static_cast<cu::CudaBuffer*>(buffer.ptr());
+  if (buf == nullptr || buf->data == nullptr || buf->external) {
+    // Externally owned memory is page-locked host memory, not managed
+    return;
+  }
+
+#if CUDART_VERSION >= 13000
+  cudaMemLocation loc;
+  if (device.type == Device::gpu) {
+    loc.type = cudaMemLocationTypeDevice;
+    loc.id = device.index;
+  } else {
+    loc.type = cudaMemLocationTypeHost;
+    loc.id = 0;
+  }
+  CHECK_CUDA_ERROR(cudaMemPrefetchAsync(
+      buf->data, buf->size, loc, 0, cu::transfer_stream()));
+#else
+  int dst = device.type == Device::gpu ? device.index : cudaCpuDeviceId;
+  CHECK_CUDA_ERROR(
+      cudaMemPrefetchAsync(buf->data, buf->size, dst, cu::transfer_stream()));
+#endif // CUDART_VERSION >= 13000
+  buf->resident_device = device.type == Device::gpu ? device.index : -1;
+}
+
 } // namespace mlx::core
@@ -4,7 +4,9 @@
 
 #include "mlx/allocator.h"
 #include "mlx/backend/common/buffer_cache.h"
+#include "mlx/backend/common/stream_buffer_pool.h"
 
+#include <atomic>
 #include <mutex>
 #include <set>
 #include <utility>
@@ -17,6 +19,16 @@ using allocator::Buffer;
 struct CudaBuffer {
   void* data;
   size_t size;
+  // True when the memory is externally owned (see wrap_external)
+  bool external{false};
+  // True when wrap_external page-locked the memory itself
+  bool registered{false};
+  // True for wired allocations (see malloc_wired); never cached
+  bool wired{false};
+  // Device the data is believed resident on: set when a kernel produces
+  // the buffer or after an upload prefetch, reset when the allocator hands
+  // the buffer out again (-1 means not resident anywhere)
+  int resident_device{-1};
 };
 
 class SmallSizePool {
@@ -47,6 +59,8 @@ class CudaAllocator : public allocator::Allocator {
   Buffer malloc(size_t size) override;
   void free(Buffer buffer) override;
   size_t size(Buffer buffer) const override;
+  Buffer wrap_external(void* ptr, size_t size) override;
+  Buffer malloc_wired(size_t size) override;
 
   size_t get_active_memory() const;
   size_t get_peak_memory() const;
@@ -54,11 +68,16 @@ class CudaAllocator : public allocator::Allocator {
   size_t get_memory_limit();
   size_t set_memory_limit(size_t limit);
   size_t get_cache_memory() const;
+  CacheStats get_cache_stats() const;
+  void reset_cache_stats();
   size_t set_cache_limit(size_t limit);
+  size_t set_rss_watermark(size_t limit);
   void clear_cache();
 
  private:
   void cuda_free(CudaBuffer* buf);
+  void update_peak_memory(size_t active);
+  void check_rss_watermark();
 
   CudaAllocator();
   friend CudaAllocator& allocator();
@@ -67,11 +86,22 @@ class CudaAllocator : public allocator::Allocator {
   size_t memory_limit_;
   size_t max_pool_size_;
   BufferCache<CudaBuffer> buffer_cache_;
-  size_t active_memory_{0};
-  size_t peak_memory_{0};
+  // Optional per-stream pools in front of the cache (MLX_STREAM_BUFFER_POOLS)
+  StreamPoolSet<CudaBuffer> stream_pools_;
+  std::atomic<size_t> active_memory_{0};
+  std::atomic<size_t> peak_memory_{0};
+  // Resident memory watermark (0 disables the check)
+  std::atomic<size_t> rss_watermark_{0};
+  std::atomic<size_t> malloc_count_{0};
   SmallSizePool scalar_pool_;
 };
 
 CudaAllocator& allocator();
 
+// Hint the driver to start migrating |buf|'s pages to |device| on the
+// dedicated transfer stream so the upload overlaps in-flight compute.
+// Purely a hint: kernels touching the pages before the migration lands
+// still fault them in correctly.
+void prefetch_to_device(CudaBuffer* buf, int device = 0);
+
 } // namespace mlx::core::cu
@@ -7,6 +7,7 @@
 #include "mlx/backend/gpu/copy.h"
 #include "mlx/primitives.h"
 
+#include <fmt/ranges.h>
 #include <nvtx3/nvtx3.hpp>
 
 #include <cassert>
@@ -386,12 +387,44 @@ void Convolution::eval_gpu(const std::vector<array>& inputs, array& out_) {
     register_args(encoder, backend_type, in, wt, out, out_);
 
     // Find a plan for the graph and execute it.
-    auto plan = find_cudnn_plan_from_op_graph(
-        encoder.device().cudnn_handle(), backend_type, dtype, *op_graph);
+    auto [x, w, y] = dispatch_args(backend_type, in, wt, out);
+    std::optional<cudnn_frontend::ExecutionPlan> plan;
+    if (env::cudnn_autotune()) {
+      // Heuristics often mispredict for unusual shape mixes; measure the
+      // candidate plans instead and remember the winner across processes.
+      auto autotune_key = fmt::format(
+          "conv_{}_x{}_w{}_s{}_pl{}_ph{}_d{}_g{}_f{}",
+          static_cast<int>(backend_type),
+          fmt::join(x.shape(), ","),
+          fmt::join(w.shape(), ","),
+          fmt::join(kernel_strides_, ","),
+          fmt::join(padding_lo_, ","),
+          fmt::join(padding_hi_, ","),
+          fmt::join(kernel_dilation_, ","),
+          groups_,
+          flip_);
+      int64_t uids[] = {'x', 'w', 'y'};
+      size_t arg_sizes[] = {
+          x.data_size() * x.itemsize(),
+          w.data_size() * w.itemsize(),
+          y.data_size() * y.itemsize()};
+      plan = find_cudnn_plan_autotuned(
+          encoder.device(),
+          backend_type,
+          dtype,
+          *op_graph,
+          autotune_key,
+          /* num_args = */ 3,
+          uids,
+          arg_sizes);
+    }
+    if (!plan) {
+      plan = find_cudnn_plan_from_op_graph(
+          encoder.device().cudnn_handle(), backend_type, dtype, *op_graph);
+    }
     if (!plan) {
       throw std::runtime_error("[conv] Unable to find an execution plan.");
     }
-    auto [x, w, y] = dispatch_args(backend_type, in, wt, out);
     if (encode_cudnn_plan(encoder, *plan, {'x', 'w', 'y'}, x, w, y)) {
       conv_cache().emplace(
           cache_key, std::make_pair(backend_type, std::move(*plan)));
@@ -2,6 +2,13 @@
 
 #include "mlx/backend/cuda/cudnn_utils.h"
 #include "mlx/backend/cuda/device.h"
+#include "mlx/version.h"
+
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <mutex>
 
 namespace mlx::core {
 
@@ -155,6 +162,115 @@ bool prepare_cudnn_plan(
   return true;
 }
 
+
+// Persisted per-(graph, arch) winners of the measured plan search
+// (MLX_CUDNN_AUTOTUNE). The file holds one "key\twinner tag" line per entry;
+// appends of a single line are atomic enough for concurrent processes, and a
+// duplicated key just resolves to the same measurement.
+class AutotuneWinners {
+ public:
+  AutotuneWinners() {
+    path_ = []() -> std::filesystem::path {
+      std::filesystem::path cache;
+      if (auto c = std::getenv("MLX_CUDNN_AUTOTUNE_CACHE_DIR"); c) {
+        cache = c;
+      } else {
+        cache = std::filesystem::temp_directory_path() / "mlx" / version();
+      }
+      if (!std::filesystem::exists(cache)) {
+        std::error_code error;
+        if (!std::filesystem::create_directories(cache, error)) {
+          return std::filesystem::path();
+        }
+      }
+      return cache / "cudnn_autotune.txt";
+    }();
+    if (path_.empty()) {
+      return;
+    }
+    std::ifstream file(path_);
+    std::string line;
+    while (std::getline(file, line)) {
+      auto tab = line.find('\t');
+      if (tab != std::string::npos) {
+        winners_.emplace(line.substr(0, tab), line.substr(tab + 1));
+      }
+    }
+  }
+
+  std::optional<std::string> lookup(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (auto it = winners_.find(key); it != winners_.end()) {
+      return it->second;
+    }
+    return std::nullopt;
+  }
+
+  void store(const std::string& key, const std::string& tag) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!winners_.emplace(key, tag).second) {
+      return;
+    }
+    if (!path_.empty()) {
+      std::ofstream file(path_, std::ios::app);
+      file << key << '\t' << tag << '\n';
+    }
+  }
+
+ private:
+  std::mutex mutex_;
+  std::map<std::string, std::string> winners_;
+  std::filesystem::path path_;
+};
+
+AutotuneWinners& autotune_winners() {
+  static AutotuneWinners winners;
+  return winners;
+}
+
+// Execute |plan| a few times on |stream| and return the best time in
+// milliseconds, or nullopt when the plan fails to run.
+std::optional<float> time_cudnn_plan(
+    cudnnHandle_t handle,
+    cudnn_frontend::ExecutionPlan& plan,
+    int num_args,
+    const int64_t* uids,
+    void** data_ptrs,
+    void* workspace,
+    cudaStream_t stream) {
+  auto args = cudnn_frontend::VariantPackBuilder()
+                  .setWorkspacePointer(workspace)
+                  .setDataPointers(num_args, data_ptrs)
+                  .setUids(num_args, uids)
+                  .build();
+  // Warm up once to exclude one-time setup costs from the measurement.
+  if (cudnnBackendExecute(handle, plan.get_raw_desc(), args.get_raw_desc()) !=
+      CUDNN_STATUS_SUCCESS) {
+    return std::nullopt;
+  }
+
+  cudaEvent_t start_raw, stop_raw;
+  CHECK_CUDA_ERROR(cudaEventCreate(&start_raw));
+  CudaHandle<cudaEvent_t, cudaEventDestroy> start(start_raw);
+  CHECK_CUDA_ERROR(cudaEventCreate(&stop_raw));
+  CudaHandle<cudaEvent_t, cudaEventDestroy> stop(stop_raw);
+
+  float best = std::numeric_limits<float>::max();
+  for (int i = 0; i < 3; ++i) {
+    CHECK_CUDA_ERROR(cudaEventRecord(start, stream));
+    if (cudnnBackendExecute(handle, plan.get_raw_desc(), args.get_raw_desc()) !=
+        CUDNN_STATUS_SUCCESS) {
+      return std::nullopt;
+    }
+    CHECK_CUDA_ERROR(cudaEventRecord(stop, stream));
+    CHECK_CUDA_ERROR(cudaEventSynchronize(stop));
+    float ms = 0;
+    CHECK_CUDA_ERROR(cudaEventElapsedTime(&ms, start, stop));
+    best = std::min(best, ms);
+  }
+  return best;
+}
+
 } // namespace
 
 cudnn_frontend::Tensor build_cudnn_tensor(int64_t id, const array& x) {
@@ -213,6 +329,100 @@ std::optional<cudnn_frontend::ExecutionPlan> find_cudnn_plan_from_op_graph(
   return find_cudnn_plan_from_engine_configs(handle, engine_configs, op_graph);
 }
 
+std::optional<cudnn_frontend::ExecutionPlan> find_cudnn_plan_autotuned(
+    cu::Device& device,
+    cudnnBackendDescriptorType_t backend_type,
+    Dtype dtype,
+    cudnn_frontend::OperationGraph& op_graph,
+    const std::string& cache_key,
+    int num_args,
+    const int64_t* uids,
+    const size_t* arg_sizes) {
+  auto handle = device.cudnn_handle();
+  auto engine_configs = get_cudnn_engine_configs(backend_type, dtype, op_graph);
+
+  // Build every config that works instead of stopping at the first one.
+  auto op_graph_tag = op_graph.getTag();
+  std::vector<cudnn_frontend::ExecutionPlan> plans;
+  for (const auto& config : engine_configs) {
+    try {
+      plans.push_back(cudnn_frontend::ExecutionPlanBuilder()
+                          .setHandle(handle)
+                          .setEngineConfig(config, op_graph_tag)
+                          .build());
+    } catch (cudnn_frontend::cudnnException& error) {
+      if (error.getCudnnStatus() != CUDNN_STATUS_NOT_SUPPORTED) {
+        throw;
+      }
+    }
+  }
+  if (plans.empty()) {
+    return std::nullopt;
+  }
+
+  auto key = fmt::format(
+      "{}_sm{}{}",
+      cache_key,
+      device.compute_capability_major(),
+      device.compute_capability_minor());
+  if (auto winner = autotune_winners().lookup(key)) {
+    for (auto& plan : plans) {
+      if (plan.getTag() == *winner) {
+        return std::move(plan);
+      }
+    }
+    // The winner no longer builds (e.g. cuDNN upgrade); fall through and
+    // measure again.
+  }
+
+  // Run the candidates on zero-filled scratch buffers so the measurement
+  // neither touches in-flight data nor depends on it being computed yet.
+  CudaStream stream(device);
+  int64_t workspace_size = 0;
+  for (auto& plan : plans) {
+    workspace_size = std::max<int64_t>(workspace_size, plan.getWorkspaceSize());
+  }
+  array workspace(
+      workspace_size > 0 ? allocator::malloc(workspace_size)
+                         : allocator::Buffer(nullptr),
+      {static_cast<int>(workspace_size)},
+      uint8);
+  std::vector<array> scratch;
+  std::vector<void*> data_ptrs;
+  for (int i = 0; i < num_args; ++i) {
+    scratch.emplace_back(
+        allocator::malloc(arg_sizes[i]),
+        Shape{static_cast<int>(arg_sizes[i])},
+        uint8);
+    data_ptrs.push_back(scratch.back().data<void>());
+    CHECK_CUDA_ERROR(cudaMemsetAsync(data_ptrs[i], 0, arg_sizes[i], stream));
+  }
+
+  cudnnSetStream(handle, stream);
+  int best = -1;
+  float best_time = std::numeric_limits<float>::max();
+  for (int i = 0; i < plans.size(); ++i) {
+    auto time = time_cudnn_plan(
+        handle,
+        plans[i],
+        num_args,
+        uids,
+        data_ptrs.data(),
+        workspace.data<void>(),
+        stream);
+    if (time && *time < best_time) {
+      best = i;
+      best_time = *time;
+    }
+  }
+  if (best < 0) {
+    return std::nullopt;
+  }
+
+  autotune_winners().store(key, plans[best].getTag());
+  return std::move(plans[best]);
+}
+
 bool encode_cudnn_plan_with_capturing(
     cu::CommandEncoder& encoder,
     cudnn_frontend::ExecutionPlan& plan,
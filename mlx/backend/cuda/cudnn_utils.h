@@ -113,6 +113,20 @@ std::optional<cudnn_frontend::ExecutionPlan> find_cudnn_plan_from_op_graph(
     Dtype dtype,
     cudnn_frontend::OperationGraph& op_graph);
 
+// Build every working plan for |op_graph|, time them on zero-filled scratch
+// buffers of |arg_sizes| bytes on a private stream, and return the fastest
+// (MLX_CUDNN_AUTOTUNE). Winners are persisted on disk per (|cache_key|,
+// compute arch) so later processes skip the measurement.
+std::optional<cudnn_frontend::ExecutionPlan> find_cudnn_plan_autotuned(
+    cu::Device& device,
+    cudnnBackendDescriptorType_t backend_type,
+    Dtype dtype,
+    cudnn_frontend::OperationGraph& op_graph,
+    const std::string& cache_key,
+    int num_args,
+    const int64_t* uids,
+    const size_t* arg_sizes);
+
 // Encode the plan to command buffer by capturing.
 bool encode_cudnn_plan_with_capturing(
     cu::CommandEncoder& encoder,
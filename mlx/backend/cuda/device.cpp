@@ -1,6 +1,7 @@
 // Copyright © 2025 Apple Inc.
 
 #include "mlx/backend/cuda/device.h"
+#include "mlx/backend/cuda/allocator.h"
 #include "mlx/backend/cuda/jit_module.h"
 #include "mlx/backend/cuda/worker.h"
 #include "mlx/utils.h"
@@ -86,7 +87,7 @@ void Device::make_current() {
 CommandEncoder& Device::get_command_encoder(Stream s) {
   auto it = encoders_.find(s.index);
   if (it == encoders_.end()) {
-    it = encoders_.try_emplace(s.index, *this).first;
+    it = encoders_.try_emplace(s.index, *this, s).first;
   }
   return it->second;
 }
@@ -199,9 +200,9 @@ void CommandEncoder::insert_graph_dependencies(std::vector<GraphNode> nodes) {
   }
 }
 
-CommandEncoder::CommandEncoder(Device& d)
+CommandEncoder::CommandEncoder(Device& d, Stream s)
     : device_(d),
-      stream_(d),
+      stream_(d, get_stream_priority(s.index)),
       graph_(d),
       graph_cache_(cuda_graph_cache_size()) {}
 
@@ -210,6 +211,14 @@ void CommandEncoder::add_completed_handler(std::function<void()> task) {
 }
 
 void CommandEncoder::set_input_array(const array& arr) {
+  // Inputs no kernel has produced (e.g. host-filled dataloader arrays)
+  // start migrating on the transfer stream now, so the upload overlaps
+  // in-flight compute instead of faulting in page by page at first touch
+  if (auto* buf = static_cast<CudaBuffer*>(arr.buffer().ptr());
+      buf && buf->resident_device != device_.cuda_device()) {
+    prefetch_to_device(buf, device_.cuda_device());
+    buf->resident_device = device_.cuda_device();
+  }
   if (!use_cuda_graphs()) {
     return;
   }
@@ -218,6 +227,10 @@ void CommandEncoder::set_input_array(const array& arr) {
 }
 
 void CommandEncoder::set_output_array(const array& arr) {
+  // Kernels produce their outputs resident on the encoder's device
+  if (auto* buf = static_cast<CudaBuffer*>(arr.buffer().ptr())) {
+    buf->resident_device = device_.cuda_device();
+  }
   if (!use_cuda_graphs()) {
     return;
   }
@@ -291,12 +304,17 @@ void CommandEncoder::add_kernel_node(
 void CommandEncoder::add_kernel_node(const cudaKernelNodeParams& params) {
   cudaGraphNode_t node;
   CHECK_CUDA_ERROR(cudaGraphAddKernelNode(&node, graph_, NULL, 0, &params));
+  // cudaGraphExecUpdate cannot change a node's function, so the kernel
+  // identity is part of the cache key; otherwise topologically identical
+  // graphs with different kernels collide and reinstantiate every commit.
+  graph_key_ += std::to_string(reinterpret_cast<std::uintptr_t>(params.func));
   insert_graph_dependencies(GraphNode{node, 'K'});
 }
 
 void CommandEncoder::add_kernel_node(const CUDA_KERNEL_NODE_PARAMS& params) {
   CUgraphNode node;
   CHECK_CUDA_ERROR(cuGraphAddKernelNode(&node, graph_, NULL, 0, &params));
+  graph_key_ += std::to_string(reinterpret_cast<std::uintptr_t>(params.func));
   insert_graph_dependencies(GraphNode{node, 'K'});
 }
 
@@ -309,6 +327,11 @@ void CommandEncoder::add_graph_node(cudaGraph_t child) {
   }
   cudaGraphNode_t node;
   CHECK_CUDA_ERROR(cudaGraphAddChildGraphNode(&node, graph_, NULL, 0, child));
+  // Child graphs have no stable identity; discriminate on their size so
+  // captured subgraphs of different programs rarely share an exec entry
+  size_t num_child_nodes = 0;
+  CHECK_CUDA_ERROR(cudaGraphGetNodes(child, nullptr, &num_child_nodes));
+  graph_key_ += std::to_string(num_child_nodes);
   insert_graph_dependencies(GraphNode{node, 'G'});
 }
 
@@ -383,11 +406,42 @@ void CommandEncoder::synchronize() {
   f.wait();
 }
 
+// Enable peer access between |a| and |b| when the hardware supports it, so
+// transfers between the two devices go over NVLink/PCIe peer mappings
+// instead of bouncing through host memory. Failures are not fatal; managed
+// memory still migrates through the host without it.
+void enable_peer_access(int a, int b) {
+  auto enable = [](int from, int to) {
+    int can = 0;
+    CHECK_CUDA_ERROR(cudaDeviceCanAccessPeer(&can, from, to));
+    if (can == 0) {
+      return;
+    }
+    CHECK_CUDA_ERROR(cudaSetDevice(from));
+    auto err = cudaDeviceEnablePeerAccess(to, 0);
+    if (err != cudaSuccess && err != cudaErrorPeerAccessAlreadyEnabled) {
+      CHECK_CUDA_ERROR(err);
+    }
+    cudaGetLastError();
+  };
+  enable(a, b);
+  enable(b, a);
+}
+
 Device& device(mlx::core::Device device) {
   static std::unordered_map<int, Device> devices;
   auto it = devices.find(device.index);
   if (it == devices.end()) {
     it = devices.try_emplace(device.index, device.index).first;
+    // Peer access is enabled lazily, the first time a second device is used
+    // in the process
+    for (auto& [index, d] : devices) {
+      if (index != device.index) {
+        enable_peer_access(index, device.index);
+      }
+    }
+    // Enabling peer access changes the current device; restore it
+    it->second.make_current();
   }
   return it->second;
 }
@@ -31,7 +31,7 @@ class CommandEncoder {
     CommandEncoder& enc;
   };
 
-  explicit CommandEncoder(Device& d);
+  CommandEncoder(Device& d, Stream s);
 
   CommandEncoder(const CommandEncoder&) = delete;
   CommandEncoder& operator=(const CommandEncoder&) = delete;
@@ -10,4 +10,18 @@ struct Select {
   }
 };
 
+struct MaskedAdd {
+  template <typename T>
+  __device__ T operator()(bool condition, T x, T y) {
+    return condition ? static_cast<T>(x + y) : T(0);
+  }
+};
+
+struct MaskedMultiply {
+  template <typename T>
+  __device__ T operator()(bool condition, T x, T y) {
+    return condition ? static_cast<T>(x * y) : T(0);
+  }
+};
+
 } // namespace mlx::core::cu
@@ -53,4 +53,54 @@ void AllReduce::eval_gpu(
           "Only all reduce sum, max, and min are supported.");
   }
 }
+
+void ReduceScatter::eval_gpu(
+    const std::vector<array>& inputs,
+    std::vector<array>& outputs) {
+  assert(inputs.size() == 1);
+  assert(outputs.size() == 1);
+
+  auto input = inputs[0];
+  if (!input.flags().row_contiguous) {
+    array copy(input.shape(), input.dtype(), nullptr, {});
+    copy_gpu(input, copy, CopyType::General, stream());
+    input = copy;
+  }
+  outputs[0].set_data(allocator::malloc(outputs[0].nbytes()));
+
+  auto& encoder = cu::get_command_encoder(stream());
+  encoder.set_input_array(input);
+  encoder.set_output_array(outputs[0]);
+  if (!inputs[0].flags().row_contiguous) {
+    encoder.add_temporary(input);
+  }
+
+  auto capture = encoder.capture_context();
+  distributed::detail::reduce_scatter(group(), input, outputs[0], stream());
+}
+
+void Broadcast::eval_gpu(
+    const std::vector<array>& inputs,
+    std::vector<array>& outputs) {
+  assert(inputs.size() == 1);
+  assert(outputs.size() == 1);
+
+  auto input = inputs[0];
+  if (!input.flags().row_contiguous) {
+    array copy(input.shape(), input.dtype(), nullptr, {});
+    copy_gpu(input, copy, CopyType::General, stream());
+    input = copy;
+  }
+  outputs[0].set_data(allocator::malloc(outputs[0].nbytes()));
+
+  auto& encoder = cu::get_command_encoder(stream());
+  encoder.set_input_array(input);
+  encoder.set_output_array(outputs[0]);
+  if (!inputs[0].flags().row_contiguous) {
+    encoder.add_temporary(input);
+  }
+
+  auto capture = encoder.capture_context();
+  distributed::detail::broadcast(group(), input, outputs[0], root_, stream());
+}
 } // namespace mlx::core::distributed
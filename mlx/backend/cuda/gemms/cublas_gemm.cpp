@@ -5,6 +5,7 @@
 #include "mlx/dtype_utils.h"
 #include "mlx/utils.h"
 
+#include <cuda_fp16.h>
 #include <fmt/format.h>
 
 namespace mlx::core {
@@ -119,19 +120,28 @@ CublasGemm::CublasGemm(
     int64_t ldb,
     int32_t batch_count,
     int64_t a_batch_stride,
-    int64_t b_batch_stride)
+    int64_t b_batch_stride,
+    std::optional<Dtype> accum_dtype /* = std::nullopt */)
     : handle_(device.lt_handle()),
       pref_(cublas_preference(device)),
       M_(a_rows),
       N_(b_cols) {
   heuristic_.state = CUBLAS_STATUS_NOT_INITIALIZED;
 
+  auto compute_type = dtype_to_compute_type(dtype);
   auto scale_type = dtype_to_cublas_type(dtype);
   if (dtype == bfloat16 || dtype == float16) {
     scale_type = CUDA_R_32F;
   }
-  CHECK_CUBLAS_ERROR(cublasLtMatmulDescCreate(
-      &matmul_desc_, dtype_to_compute_type(dtype), scale_type));
+  // fp16 accumulation is only available for fp16 operands; any other
+  // request keeps the (at least fp32) default above
+  if (accum_dtype == float16 && dtype == float16) {
+    compute_type = CUBLAS_COMPUTE_16F;
+    scale_type = CUDA_R_16F;
+    half_scale_ = true;
+  }
+  CHECK_CUBLAS_ERROR(
+      cublasLtMatmulDescCreate(&matmul_desc_, compute_type, scale_type));
   int32_t pointer_mode = CUBLASLT_POINTER_MODE_HOST;
   CHECK_CUBLAS_ERROR(cublasLtMatmulDescSetAttribute(
       matmul_desc_,
@@ -183,7 +193,8 @@ CublasGemm::CublasGemm(
     int32_t batch_count,
     int64_t a_batch_stride,
     int64_t b_batch_stride,
-    int64_t c_batch_stride)
+    int64_t c_batch_stride,
+    std::optional<Dtype> accum_dtype /* = std::nullopt */)
     : CublasGemm(
           device,
           dtype,
@@ -197,12 +208,59 @@ CublasGemm::CublasGemm(
           ldb,
           batch_count,
           a_batch_stride,
-          b_batch_stride) {
+          b_batch_stride,
+          accum_dtype) {
   auto type = dtype_to_cublas_type(dtype);
   c_desc_ = create_matrix_layout(
       type, b_cols, a_rows, false, ldc, batch_count, c_batch_stride);
 }
 
+CublasGemm::CublasGemm(
+    cu::Device& device,
+    Dtype out_dtype,
+    uint64_t M,
+    uint64_t N,
+    uint64_t K)
+    : handle_(device.lt_handle()),
+      pref_(cublas_preference(device)),
+      M_(M),
+      N_(N) {
+  heuristic_.state = CUBLAS_STATUS_NOT_INITIALIZED;
+
+  CHECK_CUBLAS_ERROR(
+      cublasLtMatmulDescCreate(&matmul_desc_, CUBLAS_COMPUTE_32F, CUDA_R_32F));
+  int32_t pointer_mode = CUBLASLT_POINTER_MODE_HOST;
+  CHECK_CUBLAS_ERROR(cublasLtMatmulDescSetAttribute(
+      matmul_desc_,
+      CUBLASLT_MATMUL_DESC_POINTER_MODE,
+      &pointer_mode,
+      sizeof(int32_t)));
+
+  // The same A/B swap as above so the row-major result comes out directly,
+  // with the extra constraint that the fp8 tensor cores only support the TN
+  // format: cublas A (mlx's b) transposed, cublas B (mlx's a) not. Both
+  // operands are K-major since b arrives pre-transposed as (N, K).
+  cublasOperation_t a_op = CUBLAS_OP_T;
+  CHECK_CUBLAS_ERROR(cublasLtMatmulDescSetAttribute(
+      matmul_desc_,
+      CUBLASLT_MATMUL_DESC_TRANSA,
+      &a_op,
+      sizeof(cublasOperation_t)));
+  cublasOperation_t b_op = CUBLAS_OP_N;
+  CHECK_CUBLAS_ERROR(cublasLtMatmulDescSetAttribute(
+      matmul_desc_,
+      CUBLASLT_MATMUL_DESC_TRANSB,
+      &b_op,
+      sizeof(cublasOperation_t)));
+
+  a_desc_ = create_matrix_layout(
+      CUDA_R_8F_E4M3, K, N, false, K, /* batch_count = */ 1, 0);
+  b_desc_ = create_matrix_layout(
+      CUDA_R_8F_E4M3, K, M, false, K, /* batch_count = */ 1, 0);
+  out_desc_ = create_matrix_layout(
+      dtype_to_cublas_type(out_dtype), N, M, false, N, /* batch_count = */ 1, 0);
+}
+
 CublasGemm::~CublasGemm() {
   CHECK_CUBLAS_ERROR(cublasLtMatrixLayoutDestroy(a_desc_));
   CHECK_CUBLAS_ERROR(cublasLtMatrixLayoutDestroy(b_desc_));
@@ -231,19 +289,60 @@ void CublasGemm::set_out(
 }
 
 void CublasGemm::set_bias(cu::CommandEncoder& encoder, const array& bias) {
-  encoder.set_input_array(bias);
-  cublasLtEpilogue_t epilogue = CUBLASLT_EPILOGUE_BIAS;
+  set_epilogue(encoder, GemmActivation::None, bias);
+}
+
+void CublasGemm::set_epilogue(
+    cu::CommandEncoder& encoder,
+    GemmActivation activation,
+    const std::optional<array>& bias) {
+  cublasLtEpilogue_t epilogue;
+  switch (activation) {
+    case GemmActivation::Relu:
+      epilogue = bias ? CUBLASLT_EPILOGUE_RELU_BIAS : CUBLASLT_EPILOGUE_RELU;
+      break;
+    case GemmActivation::Gelu:
+      epilogue = bias ? CUBLASLT_EPILOGUE_GELU_BIAS : CUBLASLT_EPILOGUE_GELU;
+      break;
+    default:
+      epilogue = CUBLASLT_EPILOGUE_BIAS;
+      break;
+  }
   CHECK_CUBLAS_ERROR(cublasLtMatmulDescSetAttribute(
       matmul_desc_,
       CUBLASLT_MATMUL_DESC_EPILOGUE,
       &epilogue,
       sizeof(epilogue)));
-  auto* bias_ptr = bias.data<void>();
+  if (bias) {
+    encoder.set_input_array(*bias);
+    auto* bias_ptr = bias->data<void>();
+    CHECK_CUBLAS_ERROR(cublasLtMatmulDescSetAttribute(
+        matmul_desc_,
+        CUBLASLT_MATMUL_DESC_BIAS_POINTER,
+        &bias_ptr,
+        sizeof(bias_ptr)));
+  }
+}
+
+void CublasGemm::set_scales(
+    cu::CommandEncoder& encoder,
+    const array& a_scale,
+    const array& b_scale) {
+  // A and B are swapped (see the fp8 constructor) so the scales swap too
+  encoder.set_input_array(a_scale);
+  encoder.set_input_array(b_scale);
+  auto* b_scale_ptr = b_scale.data<void>();
+  CHECK_CUBLAS_ERROR(cublasLtMatmulDescSetAttribute(
+      matmul_desc_,
+      CUBLASLT_MATMUL_DESC_A_SCALE_POINTER,
+      &b_scale_ptr,
+      sizeof(b_scale_ptr)));
+  auto* a_scale_ptr = a_scale.data<void>();
   CHECK_CUBLAS_ERROR(cublasLtMatmulDescSetAttribute(
       matmul_desc_,
-      CUBLASLT_MATMUL_DESC_BIAS_POINTER,
-      &bias_ptr,
-      sizeof(bias_ptr)));
+      CUBLASLT_MATMUL_DESC_B_SCALE_POINTER,
+      &a_scale_ptr,
+      sizeof(a_scale_ptr)));
 }
 
 void CublasGemm::run(
@@ -364,16 +463,27 @@ void CublasGemm::execute(
     workspace_ptr = workspace.data<void>();
   }
 
+  // With an fp16 compute type the scalars are halves rather than floats
+  __half alpha_h, beta_h;
+  const void* alpha_ptr = &alpha;
+  const void* beta_ptr = &beta;
+  if (half_scale_) {
+    alpha_h = __float2half(alpha);
+    beta_h = __float2half(beta);
+    alpha_ptr = &alpha_h;
+    beta_ptr = &beta_h;
+  }
+
   auto capture = encoder.capture_context();
   CHECK_CUBLAS_ERROR(cublasLtMatmul(
       handle_,
       matmul_desc_,
-      &alpha,
+      alpha_ptr,
       b, // a and b are swapped
       a_desc_,
       a,
       b_desc_,
-      &beta,
+      beta_ptr,
       c ? c : out,
       c ? c_desc_ : out_desc_,
       out,
@@ -4,10 +4,15 @@
 #include "mlx/array.h"
 #include "mlx/backend/cuda/device.h"
 
+#include <optional>
+
 #include <cublasLt.h>
 
 namespace mlx::core {
 
+// Activations cublasLt can apply in the matmul epilogue.
+enum class GemmActivation { None, Relu, Gelu };
+
 class CublasGemm {
  public:
   CublasGemm(
@@ -23,7 +28,8 @@ class CublasGemm {
       int64_t ldb,
       int32_t batch_count,
       int64_t a_batch_stride,
-      int64_t b_batch_stride);
+      int64_t b_batch_stride,
+      std::optional<Dtype> accum_dtype = std::nullopt);
 
   CublasGemm(
       cu::Device& device,
@@ -40,7 +46,18 @@ class CublasGemm {
       int32_t batch_count,
       int64_t a_batch_stride,
       int64_t b_batch_stride,
-      int64_t c_batch_stride);
+      int64_t c_batch_stride,
+      std::optional<Dtype> accum_dtype = std::nullopt);
+
+  // Gemm over fp8 (e4m3) operands with float32 accumulation. `a` is
+  // row-major (M, K) and `b` is pre-transposed row-major (N, K); both
+  // must be K-major as the fp8 tensor cores require.
+  CublasGemm(
+      cu::Device& device,
+      Dtype out_dtype,
+      uint64_t M,
+      uint64_t N,
+      uint64_t K);
 
   ~CublasGemm();
 
@@ -57,6 +74,19 @@ class CublasGemm {
 
   void set_bias(cu::CommandEncoder& encoder, const array& bias);
 
+  // Attach per-tensor dequantization scales for the fp8 gemm.
+  void set_scales(
+      cu::CommandEncoder& encoder,
+      const array& a_scale,
+      const array& b_scale);
+
+  // Fuse a bias add and/or an activation into the matmul's epilogue. At
+  // least one of |activation| and |bias| must be set.
+  void set_epilogue(
+      cu::CommandEncoder& encoder,
+      GemmActivation activation,
+      const std::optional<array>& bias);
+
   void run(
       cu::CommandEncoder& encoder,
       array& out,
@@ -123,6 +153,9 @@ class CublasGemm {
   cublasLtMatrixLayout_t c_desc_{nullptr};
   cublasLtMatrixLayout_t out_desc_{nullptr};
   cublasLtMatmulHeuristicResult_t heuristic_;
+  // True when the compute and scale types are fp16; alpha and beta are
+  // then passed as halves (see execute)
+  bool half_scale_{false};
 };
 
 } // namespace mlx::core
@@ -144,17 +144,36 @@ void write_cached_ptx(
     return;
   }
 
-  std::ofstream ptx_file(cache_dir / (module_name + ".ptx"), std::ios::binary);
-  if (!ptx.empty()) {
-    ptx_file.write(&ptx.front(), ptx.size());
-  }
-  std::ofstream txt_file(cache_dir / (module_name + ".txt"), std::ios::binary);
-  for (const auto& [name, mangled] : ptx_kernels) {
-    txt_file << name << "\t" << mangled << std::endl;
-  }
+  // Stage each file under a process-unique name and atomically rename it
+  // into place so that concurrent processes populating the same entry never
+  // expose partially written files to readers.
+  auto commit_file = [&](const std::string& ext, auto&& fill) {
+    auto tmp_path =
+        cache_dir / fmt::format("{}.{}.{}", module_name, getpid(), ext);
+    {
+      std::ofstream file(tmp_path, std::ios::binary);
+      fill(file);
+    }
+    std::error_code error;
+    std::filesystem::rename(tmp_path, cache_dir / (module_name + "." + ext), error);
+    if (error) {
+      std::filesystem::remove(tmp_path, error);
+    }
+  };
 
-  std::ofstream source_file(cache_dir / (module_name + ".cu"));
-  source_file << source_code;
+  // Commit the ptx last: readers check for it first, so once it is visible
+  // the kernel name table is guaranteed to be in place.
+  commit_file("txt", [&](std::ofstream& file) {
+    for (const auto& [name, mangled] : ptx_kernels) {
+      file << name << "\t" << mangled << std::endl;
+    }
+  });
+  commit_file("cu", [&](std::ofstream& file) { file << source_code; });
+  commit_file("ptx", [&](std::ofstream& file) {
+    if (!ptx.empty()) {
+      file.write(&ptx.front(), ptx.size());
+    }
+  });
 }
 
 // Return if |device|'s version is not newer than |major|.|minor| version.
@@ -329,10 +348,20 @@ JitModule::JitModule(
   std::string ptx;
   std::vector<std::pair<std::string, std::string>> ptx_kernels;
 
-  // Try to load them from the file cache
-  if (!read_cached_ptx(ptx_cache_dir(), module_name, ptx, ptx_kernels)) {
-    auto [precompiled, source_code, kernel_names] = builder();
+  auto [precompiled, source_code, kernel_names] = builder();
 
+  // Cache entries are keyed by the source and the target architecture as
+  // well as the name, so that processes running different builds or driving
+  // different GPUs can safely share one cache directory.
+  std::string module_key = fmt::format(
+      "{}_sm{}{}_{:016x}",
+      module_name,
+      device.compute_capability_major(),
+      device.compute_capability_minor(),
+      std::hash<std::string>{}(source_code));
+
+  // Try to load them from the file cache
+  if (!read_cached_ptx(ptx_cache_dir(), module_key, ptx, ptx_kernels)) {
     // Get the PTX or cubin
     if (precompiled) {
       ptx = std::move(source_code);
@@ -346,7 +375,7 @@ JitModule::JitModule(
     // If requested save them in the file cache for the next launch
     if (use_disk_cache) {
       write_cached_ptx(
-          ptx_cache_dir(), module_name, ptx, ptx_kernels, source_code);
+          ptx_cache_dir(), module_key, ptx, ptx_kernels, source_code);
     }
   }
 
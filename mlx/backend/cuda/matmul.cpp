@@ -5,7 +5,9 @@
 #include "mlx/backend/cuda/gemms/cublas_gemm.h"
 #include "mlx/backend/cuda/gemms/gemv.h"
 #include "mlx/backend/gpu/copy.h"
+#include "mlx/fast_primitives.h"
 #include "mlx/primitives.h"
+#include "mlx/transforms_impl.h"
 
 #include <nvtx3/nvtx3.hpp>
 #include <numeric>
@@ -42,7 +44,9 @@ void gemm_and_bias(
     const array& a,
     const array& b,
     const std::optional<array>& bias = std::nullopt,
-    float alpha = 1.0f) {
+    float alpha = 1.0f,
+    GemmActivation activation = GemmActivation::None,
+    std::optional<Dtype> accum_dtype = std::nullopt) {
   // Check and collapse batch dimensions
   auto [batch_shape, a_batch_strides, b_batch_strides] = collapse_batches(a, b);
 
@@ -61,7 +65,8 @@ void gemm_and_bias(
   }
 
   // Use gemmv when possible
-  if (!bias && cu::can_use_gemv(M, N, K, a_transposed, b_transposed)) {
+  if (!bias && activation == GemmActivation::None &&
+      cu::can_use_gemv(M, N, K, a_transposed, b_transposed)) {
     cu::gemv(
         a,
         b,
@@ -91,9 +96,10 @@ void gemm_and_bias(
       ldb,
       batch_shape.back(),
       a_batch_strides.back(),
-      b_batch_strides.back());
-  if (bias) {
-    gemm.set_bias(encoder, *bias);
+      b_batch_strides.back(),
+      accum_dtype);
+  if (bias || activation != GemmActivation::None) {
+    gemm.set_epilogue(encoder, activation, bias);
   }
   gemm.run(
       encoder, out, a, b, batch_shape, a_batch_strides, b_batch_strides, alpha);
@@ -129,7 +135,21 @@ void Matmul::eval_gpu(const std::vector<array>& inputs, array& out) {
   auto [b_transposed, ldb, b] = check_transpose(encoder, s, b_pre);
 
   gemm_and_bias(
-      encoder, M, N, K, a_transposed, lda, b_transposed, ldb, out, a, b);
+      encoder,
+      M,
+      N,
+      K,
+      a_transposed,
+      lda,
+      b_transposed,
+      ldb,
+      out,
+      a,
+      b,
+      /* bias = */ std::nullopt,
+      /* alpha = */ 1.0f,
+      GemmActivation::None,
+      accum_dtype());
 }
 
 void AddMM::eval_gpu(const std::vector<array>& inputs, array& out) {
@@ -154,6 +174,11 @@ void AddMM::eval_gpu(const std::vector<array>& inputs, array& out) {
   auto [a_transposed, lda, a] = check_transpose(encoder, s, a_pre);
   auto [b_transposed, ldb, b] = check_transpose(encoder, s, b_pre);
 
+  // Map the primitive's fused activation (if any) to a cublasLt epilogue
+  GemmActivation activation = activation_ == Activation::Relu
+      ? GemmActivation::Relu
+      : GemmActivation::None;
+
   /////////////////////////////////////////////////////////////////////////////
   // Dispatch to GEMM with epilogue or AddMM
 
@@ -172,7 +197,8 @@ void AddMM::eval_gpu(const std::vector<array>& inputs, array& out) {
         a,
         b,
         c,
-        alpha_);
+        alpha_,
+        activation);
     return;
   }
 
@@ -235,6 +261,9 @@ void AddMM::eval_gpu(const std::vector<array>& inputs, array& out) {
       a_batch_strides.back(),
       b_batch_strides.back(),
       c_batch_strides.back());
+  if (activation != GemmActivation::None) {
+    gemm.set_epilogue(encoder, activation, std::nullopt);
+  }
   gemm.run(
       encoder,
       out,
@@ -249,4 +278,49 @@ void AddMM::eval_gpu(const std::vector<array>& inputs, array& out) {
       beta_);
 }
 
+namespace fast {
+
+bool ScaledMatmul::use_fallback(Stream s) {
+  return detail::in_grad_tracing() || s.device == Device::cpu;
+}
+
+void ScaledMatmul::eval_gpu(const std::vector<array>& inputs, array& out) {
+  nvtx3::scoped_range r("ScaledMatmul::eval_gpu");
+  auto& s = stream();
+  auto& encoder = cu::get_command_encoder(s);
+
+  auto ensure_row_contiguous = [&s, &encoder](const array& x) {
+    if (x.flags().row_contiguous) {
+      return x;
+    }
+    array x_copy = contiguous_copy_gpu(x, s);
+    encoder.add_temporary(x_copy);
+    return x_copy;
+  };
+
+  // Both operands are K-major by construction (b is pre-transposed)
+  array a = ensure_row_contiguous(inputs[0]);
+  array b = ensure_row_contiguous(inputs[1]);
+
+  out.set_data(allocator::malloc(out.nbytes()));
+
+  CublasGemm gemm(
+      cu::device(s.device),
+      out.dtype(),
+      /* M = */ a.shape(0),
+      /* N = */ b.shape(0),
+      /* K = */ a.shape(1));
+  gemm.set_scales(encoder, inputs[2], inputs[3]);
+  gemm.run(
+      encoder,
+      out,
+      a,
+      b,
+      /* batch_shape = */ {1},
+      /* a_batch_strides = */ {0},
+      /* b_batch_strides = */ {0});
+}
+
+} // namespace fast
+
 } // namespace mlx::core
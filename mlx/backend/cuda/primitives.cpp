@@ -23,22 +23,33 @@ namespace mlx::core {
     throw std::runtime_error(#func " has no CUDA implementation.");   \
   }
 
+NO_GPU(Bincount)
 NO_GPU(BlockMaskedMM)
 NO_GPU(FFT)
 NO_GPU(GatherMM)
-NO_GPU(GatherQMM)
 NO_GPU(Hadamard)
 NO_GPU(Load)
 NO_GPU_MULTI(LUF)
 NO_GPU_MULTI(QRF)
-NO_GPU(QuantizedMatmul)
 NO_GPU(SegmentedMM)
+NO_GPU(SparseMatmul)
 NO_GPU_MULTI(SVD)
 NO_GPU(Inverse)
 NO_GPU(Cholesky)
 NO_GPU_MULTI(Eig)
 NO_GPU_MULTI(Eigh)
 
+namespace fast {
+bool PagedAttention::use_fallback(Stream s) {
+  return true;
+}
+NO_GPU(PagedAttention)
+bool RoPEAttention::use_fallback(Stream s) {
+  return true;
+}
+NO_GPU(RoPEAttention)
+} // namespace fast
+
 namespace distributed {
 NO_GPU_MULTI(AllGather)
 NO_GPU_MULTI(Send)
@@ -0,0 +1,244 @@
+// Copyright © 2025 Apple Inc.
+
+#include "mlx/backend/cuda/device.h"
+#include "mlx/backend/cuda/kernel_utils.cuh"
+#include "mlx/backend/cuda/quantized/quantized.h"
+#include "mlx/backend/cuda/quantized/quantized_utils.cuh"
+#include "mlx/dtype_utils.h"
+
+#include <cooperative_groups.h>
+#include <cooperative_groups/reduce.h>
+
+namespace mlx::core {
+
+namespace cu {
+
+namespace cg = cooperative_groups;
+
+// Matrix-vector product with the quantized matrix kept packed: one warp per
+// output element strides over the packed words of its row, so the weights are
+// read at their quantized width instead of being dequantized to a temporary.
+// Decode-style batches of a few rows are handled by the y dim of the grid.
+template <typename T, int group_size, int bits>
+__global__ void qmv(
+    const uint32_t* w,
+    const T* scales,
+    const T* biases,
+    const T* x,
+    T* out,
+    int K,
+    int N) {
+  static_assert(bits == 4 || bits == 8, "qmv packs values in whole words");
+  constexpr int pack_factor = 32 / bits;
+
+  auto block = cg::this_thread_block();
+  auto warp = cg::tiled_partition<WARP_SIZE>(block);
+
+  int n = block.group_index().x * block.dim_threads().y +
+      block.thread_index().y;
+  if (n >= N) {
+    return;
+  }
+  int b = block.group_index().y;
+
+  const uint32_t* w_row = w + size_t(n) * (K / pack_factor);
+  const T* s_row = scales + size_t(n) * (K / group_size);
+  const T* b_row = biases + size_t(n) * (K / group_size);
+  const T* x_row = x + size_t(b) * K;
+
+  float acc = 0;
+  for (int i = warp.thread_rank(); i < K / pack_factor; i += WARP_SIZE) {
+    uint32_t word = w_row[i];
+    int g = (i * pack_factor) / group_size;
+    float scale = static_cast<float>(s_row[g]);
+    float bias = static_cast<float>(b_row[g]);
+    const T* xv = x_row + i * pack_factor;
+
+    // Accumulate the quantized dot product and the sum of the activations
+    // separately so the affine transform is applied once per word
+    float dot = 0;
+    float x_sum = 0;
+#pragma unroll
+    for (int j = 0; j < pack_factor; j++) {
+      float q = (word >> (bits * j)) & ((1 << bits) - 1);
+      float xj = static_cast<float>(xv[j]);
+      dot += q * xj;
+      x_sum += xj;
+    }
+    acc += scale * dot + bias * x_sum;
+  }
+
+  acc = cg::reduce(warp, acc, cg::plus<float>{});
+  if (warp.thread_rank() == 0) {
+    out[size_t(b) * N + n] = static_cast<T>(acc);
+  }
+}
+
+// Gathered variant for MoE dispatch: one launch covers every
+// (token, expert) pair instead of a kernel per expert at tiny M. Batch
+// item b reads its activation rows through lhs_indices[b] and its
+// expert's packed weights through rhs_indices[b], keeping the weights at
+// their quantized width exactly like qmv.
+template <typename T, int group_size, int bits>
+__global__ void gather_qmv(
+    const uint32_t* w,
+    const T* scales,
+    const T* biases,
+    const T* x,
+    const uint32_t* lhs_indices,
+    const uint32_t* rhs_indices,
+    T* out,
+    int M,
+    int K,
+    int N) {
+  static_assert(bits == 4 || bits == 8, "qmv packs values in whole words");
+  constexpr int pack_factor = 32 / bits;
+
+  auto block = cg::this_thread_block();
+  auto warp = cg::tiled_partition<WARP_SIZE>(block);
+
+  int n = block.group_index().x * block.dim_threads().y +
+      block.thread_index().y;
+  if (n >= N) {
+    return;
+  }
+  int b = block.group_index().y;
+  int m = block.group_index().z;
+
+  size_t expert = rhs_indices[b];
+  const uint32_t* w_row =
+      w + (expert * N + n) * size_t(K / pack_factor);
+  const T* s_row = scales + (expert * N + n) * size_t(K / group_size);
+  const T* b_row = biases + (expert * N + n) * size_t(K / group_size);
+  const T* x_row = x + (size_t(lhs_indices[b]) * M + m) * K;
+
+  float acc = 0;
+  for (int i = warp.thread_rank(); i < K / pack_factor; i += WARP_SIZE) {
+    uint32_t word = w_row[i];
+    int g = (i * pack_factor) / group_size;
+    float scale = static_cast<float>(s_row[g]);
+    float bias = static_cast<float>(b_row[g]);
+    const T* xv = x_row + i * pack_factor;
+
+    float dot = 0;
+    float x_sum = 0;
+#pragma unroll
+    for (int j = 0; j < pack_factor; j++) {
+      float q = (word >> (bits * j)) & ((1 << bits) - 1);
+      float xj = static_cast<float>(xv[j]);
+      dot += q * xj;
+      x_sum += xj;
+    }
+    acc += scale * dot + bias * x_sum;
+  }
+
+  acc = cg::reduce(warp, acc, cg::plus<float>{});
+  if (warp.thread_rank() == 0) {
+    out[(size_t(b) * M + m) * N + n] = static_cast<T>(acc);
+  }
+}
+
+} // namespace cu
+
+void qmv(
+    const array& x,
+    const array& wq,
+    const array& scales,
+    const array& biases,
+    array& out,
+    int group_size_,
+    int bits_,
+    int M,
+    int K,
+    int N,
+    cu::CommandEncoder& enc) {
+  enc.set_input_array(x);
+  enc.set_input_array(wq);
+  enc.set_input_array(scales);
+  enc.set_input_array(biases);
+  enc.set_output_array(out);
+  dispatch_float_types(x.dtype(), "qmv", [&](auto type_tag) {
+    dispatch_groups(group_size_, [&](auto group_size) {
+      dispatch_bits(bits_, [&](auto bits) {
+        if constexpr (bits.value == 4 || bits.value == 8) {
+          using T = cuda_type_t<MLX_GET_TYPE(type_tag)>;
+          constexpr int rows_per_block = 8;
+          dim3 block_dims{WARP_SIZE, rows_per_block, 1};
+          dim3 num_blocks{
+              static_cast<unsigned>((N + rows_per_block - 1) / rows_per_block),
+              static_cast<unsigned>(M),
+              1};
+          auto kernel = cu::qmv<T, group_size.value, bits.value>;
+          enc.add_kernel_node(
+              kernel,
+              num_blocks,
+              block_dims,
+              0,
+              wq.data<uint32_t>(),
+              scales.data<T>(),
+              biases.data<T>(),
+              x.data<T>(),
+              out.data<T>(),
+              K,
+              N);
+        }
+      });
+    });
+  });
+}
+
+void gather_qmv(
+    const array& x,
+    const array& wq,
+    const array& scales,
+    const array& biases,
+    const array& lhs_indices,
+    const array& rhs_indices,
+    array& out,
+    int group_size_,
+    int bits_,
+    int M,
+    int K,
+    int N,
+    cu::CommandEncoder& enc) {
+  enc.set_input_array(x);
+  enc.set_input_array(wq);
+  enc.set_input_array(scales);
+  enc.set_input_array(biases);
+  enc.set_input_array(lhs_indices);
+  enc.set_input_array(rhs_indices);
+  enc.set_output_array(out);
+  dispatch_float_types(x.dtype(), "gather_qmv", [&](auto type_tag) {
+    dispatch_groups(group_size_, [&](auto group_size) {
+      dispatch_bits(bits_, [&](auto bits) {
+        if constexpr (bits.value == 4 || bits.value == 8) {
+          using T = cuda_type_t<MLX_GET_TYPE(type_tag)>;
+          constexpr int rows_per_block = 8;
+          dim3 block_dims{WARP_SIZE, rows_per_block, 1};
+          dim3 num_blocks{
+              static_cast<unsigned>((N + rows_per_block - 1) / rows_per_block),
+              static_cast<unsigned>(lhs_indices.size()),
+              static_cast<unsigned>(M)};
+          auto kernel = cu::gather_qmv<T, group_size.value, bits.value>;
+          enc.add_kernel_node(
+              kernel,
+              num_blocks,
+              block_dims,
+              0,
+              wq.data<uint32_t>(),
+              scales.data<T>(),
+              biases.data<T>(),
+              x.data<T>(),
+              lhs_indices.data<uint32_t>(),
+              rhs_indices.data<uint32_t>(),
+              out.data<T>(),
+              M,
+              K,
+              N);
+        }
+      });
+    });
+  });
+}
+
+} // namespace mlx::core
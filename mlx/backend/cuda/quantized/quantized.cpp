@@ -2,8 +2,10 @@
 
 #include "mlx/backend/cuda/quantized/quantized.h"
 #include "mlx/backend/cuda/device.h"
+#include "mlx/backend/cuda/gemms/cublas_gemm.h"
 #include "mlx/backend/gpu/copy.h"
 #include "mlx/fast_primitives.h"
+#include "mlx/primitives.h"
 
 #include <nvtx3/nvtx3.hpp>
 
@@ -46,6 +48,127 @@ inline array ensure_row_contiguous_matrix(
 
 } // namespace
 
+void QuantizedMatmul::eval_gpu(
+    const std::vector<array>& inputs,
+    array& out) {
+  nvtx3::scoped_range r("QuantizedMatmul::eval_gpu");
+  auto& s = stream();
+  auto& d = cu::device(s.device);
+  auto& enc = d.get_command_encoder(s);
+
+  if (mode_ != QuantizationMode::Affine) {
+    throw std::runtime_error(
+        "[QuantizedMatmul::eval_gpu] Only affine quantization is supported "
+        "on CUDA.");
+  }
+  if (inputs[1].ndim() != 2) {
+    throw std::runtime_error(
+        "[QuantizedMatmul::eval_gpu] Batched quantized weights NYI on CUDA.");
+  }
+
+  auto x = ensure_row_contiguous(inputs[0], enc, s);
+  auto wq = ensure_row_contiguous(inputs[1], enc, s);
+  auto scales = ensure_row_contiguous(inputs[2], enc, s);
+  auto biases = ensure_row_contiguous(inputs[3], enc, s);
+
+  out.set_data(allocator::malloc(out.nbytes()));
+  if (out.size() == 0) {
+    return;
+  }
+
+  int K = x.shape(-1);
+  int M = x.size() / K;
+  int N = out.shape(-1);
+
+  // Decode-style shapes are memory bound on the weights, so read them packed
+  if (transpose_ && M <= 4 && (bits_ == 4 || bits_ == 8)) {
+    qmv(x, wq, scales, biases, out, group_size_, bits_, M, K, N, enc);
+    return;
+  }
+
+  // Otherwise dequantize the weights and run a regular gemm
+  Shape w_shape = transpose_ ? Shape{N, K} : Shape{K, N};
+  array w_full(std::move(w_shape), x.dtype(), nullptr, {});
+  w_full.set_data(allocator::malloc(w_full.nbytes()));
+  enc.add_temporary(w_full);
+  affine_dequantize(wq, scales, biases, w_full, group_size_, bits_, enc, s);
+
+  CublasGemm gemm(
+      d,
+      x.dtype(),
+      /* a_transposed = */ false,
+      /* a_rows = */ M,
+      /* a_cols = */ K,
+      /* lda = */ K,
+      /* b_transposed = */ transpose_,
+      /* b_rows = */ K,
+      /* b_cols = */ N,
+      /* ldb = */ transpose_ ? K : N,
+      /* batch_count = */ 1,
+      /* a_batch_stride = */ 0,
+      /* b_batch_stride = */ 0);
+  gemm.run(
+      enc,
+      out,
+      x,
+      w_full,
+      /* batch_shape = */ {1},
+      /* a_batch_strides = */ {0},
+      /* b_batch_strides = */ {0});
+}
+
+void GatherQMM::eval_gpu(const std::vector<array>& inputs, array& out) {
+  nvtx3::scoped_range r("GatherQMM::eval_gpu");
+  auto& s = stream();
+  auto& d = cu::device(s.device);
+  auto& enc = d.get_command_encoder(s);
+
+  if (mode_ != QuantizationMode::Affine) {
+    throw std::runtime_error(
+        "[GatherQMM::eval_gpu] Only affine quantization is supported "
+        "on CUDA.");
+  }
+  if (!transpose_ || (bits_ != 4 && bits_ != 8)) {
+    throw std::runtime_error(
+        "[GatherQMM::eval_gpu] Only transposed 4-bit or 8-bit weights are "
+        "supported on CUDA.");
+  }
+
+  auto x = ensure_row_contiguous(inputs[0], enc, s);
+  auto wq = ensure_row_contiguous(inputs[1], enc, s);
+  auto scales = ensure_row_contiguous(inputs[2], enc, s);
+  auto biases = ensure_row_contiguous(inputs[3], enc, s);
+  auto lhs_indices = ensure_row_contiguous(inputs[4], enc, s);
+  auto rhs_indices = ensure_row_contiguous(inputs[5], enc, s);
+
+  out.set_data(allocator::malloc(out.nbytes()));
+  if (out.size() == 0) {
+    return;
+  }
+
+  int K = x.shape(-1);
+  int M = x.shape(-2);
+  int N = out.shape(-1);
+
+  // Every (index, row) pair is a block row of the same launch, so MoE
+  // dispatch with a handful of tokens per expert costs one kernel instead
+  // of one per expert.
+  gather_qmv(
+      x,
+      wq,
+      scales,
+      biases,
+      lhs_indices,
+      rhs_indices,
+      out,
+      group_size_,
+      bits_,
+      M,
+      K,
+      N,
+      enc);
+}
+
 void fast::Quantize::eval_gpu(
     const std::vector<array>& inputs,
     std::vector<array>& outputs) {
@@ -14,6 +14,39 @@ void affine_quantize(
     cu::CommandEncoder& enc,
     const Stream& s);
 
+// Matrix-vector product over packed affine-quantized weights (4 or 8 bits,
+// transposed layout). |x| is (M, K) with M a few rows, |out| is (M, N).
+void qmv(
+    const array& x,
+    const array& wq,
+    const array& scales,
+    const array& biases,
+    array& out,
+    int group_size_,
+    int bits_,
+    int M,
+    int K,
+    int N,
+    cu::CommandEncoder& enc);
+
+// Gathered qmv for MoE dispatch: batch item b multiplies the x rows
+// selected by |lhs_indices[b]| with the packed weight matrix selected by
+// |rhs_indices[b]|, all in a single launch.
+void gather_qmv(
+    const array& x,
+    const array& wq,
+    const array& scales,
+    const array& biases,
+    const array& lhs_indices,
+    const array& rhs_indices,
+    array& out,
+    int group_size_,
+    int bits_,
+    int M,
+    int K,
+    int N,
+    cu::CommandEncoder& enc);
+
 void affine_dequantize(
     const array& wq,
     const array& scales,
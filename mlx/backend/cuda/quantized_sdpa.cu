@@ -0,0 +1,358 @@
+// Copyright © 2025 Apple Inc.
+
+#include "mlx/backend/cuda/device.h"
+#include "mlx/backend/cuda/kernel_utils.cuh"
+#include "mlx/backend/gpu/copy.h"
+#include "mlx/dtype_utils.h"
+#include "mlx/fast_primitives.h"
+#include "mlx/transforms_impl.h"
+
+#include <nvtx3/nvtx3.hpp>
+
+#include <cooperative_groups.h>
+#include <cooperative_groups/reduce.h>
+
+namespace mlx::core {
+
+namespace cu {
+
+namespace cg = cooperative_groups;
+
+struct QuantAttnParams {
+  int B;
+  int H;
+  int H_kv;
+  int D;
+
+  int qL;
+  int kL;
+
+  int gqa_factor;
+  float scale;
+
+  // log2 of the quantization group size and the number of groups per
+  // key/value row.
+  int group_shift;
+  int groups;
+};
+
+// Vector (decode) attention over an affine-quantized KV cache. The layout
+// matches kernel_sdpav_1pass but the keys and values arrive as packed
+// 4/8-bit words with per-group scales and biases, and every row is
+// dequantized in registers as it is loaded. All of Q, K, V, the scales,
+// the biases and O are row contiguous; the host makes copies when needed.
+template <typename T, bool do_causal, int D, int bits>
+__global__ void kernel_quant_sdpav_1pass(
+    const T* Q,
+    const uint8_t* K,
+    const T* K_scales,
+    const T* K_biases,
+    const uint8_t* V,
+    const T* V_scales,
+    const T* V_biases,
+    T* O,
+    __grid_constant__ const QuantAttnParams params) {
+  constexpr int BN = 32;
+  constexpr int BD = 32;
+
+  constexpr int v_per_thread = D / BD;
+  constexpr int row_bytes = D * bits / 8;
+
+  const int inner_kv_stride = BN * row_bytes;
+  const int inner_sb_stride = BN * params.groups;
+
+  typedef float U;
+
+  U q[v_per_thread];
+  U o[v_per_thread];
+
+  __shared__ U outputs[BN][BD + 1];
+  __shared__ U max_scores[BN];
+  __shared__ U sum_exp_scores[BN];
+
+  const U scale_log2 = params.scale * M_LOG2E;
+
+  auto block = cg::this_thread_block();
+  auto warp = cg::tiled_partition<32>(block);
+
+  const int lane_idx = warp.thread_rank();
+  const int warp_idx = warp.meta_group_rank();
+
+  // Adjust to thread block and thread
+  const int batch_idx = blockIdx.z;
+  const int head_idx = blockIdx.x;
+  const int kv_head_idx = head_idx / params.gqa_factor;
+
+  const int q_seq_idx = blockIdx.y;
+  const int kv_seq_idx = warp_idx;
+
+  Q += ((size_t(batch_idx) * params.H + head_idx) * params.qL + q_seq_idx) * D;
+  O += ((size_t(batch_idx) * params.H + head_idx) * params.qL + q_seq_idx) * D;
+
+  const size_t kv_row =
+      (size_t(batch_idx) * params.H_kv + kv_head_idx) * params.kL + kv_seq_idx;
+  K += kv_row * row_bytes;
+  V += kv_row * row_bytes;
+  K_scales += kv_row * params.groups;
+  K_biases += kv_row * params.groups;
+  V_scales += kv_row * params.groups;
+  V_biases += kv_row * params.groups;
+
+  // Unpack the e-th element of a packed row.
+  auto load_quant = [](const uint8_t* row, int e) -> int {
+    if constexpr (bits == 4) {
+      uint8_t byte = row[e >> 1];
+      return (e & 1) ? (byte >> 4) : (byte & 0x0F);
+    } else {
+      return row[e];
+    }
+  };
+
+  // Read the query and 0 the output accumulator
+#pragma unroll
+  for (int i = 0; i < v_per_thread; i++) {
+    q[i] = scale_log2 * static_cast<U>(Q[v_per_thread * lane_idx + i]);
+  }
+
+#pragma unroll
+  for (int i = 0; i < v_per_thread; i++) {
+    o[i] = 0.f;
+  }
+
+  U max_score = -INFINITY;
+  U sum_exp_score = 0.f;
+
+  // For each key
+  for (int i = kv_seq_idx; i < params.kL; i += BN) {
+    bool use_key = true;
+    if constexpr (do_causal) {
+      use_key = i <= (params.kL - params.qL + q_seq_idx);
+    }
+
+    if (use_key) {
+      // Read and dequantize the key, computing the i-th score
+      U score = 0.f;
+#pragma unroll
+      for (int j = 0; j < v_per_thread; j++) {
+        int e = v_per_thread * lane_idx + j;
+        int g = e >> params.group_shift;
+        U kv = static_cast<U>(K_scales[g]) * load_quant(K, e) +
+            static_cast<U>(K_biases[g]);
+        score += q[j] * kv;
+      }
+
+      // Warp sum
+      score = cg::reduce(warp, score, cg::plus<U>());
+
+      // Update the accumulators
+      U new_max = max(max_score, score);
+      bool is_neg_inf = new_max == -INFINITY;
+      U factor = is_neg_inf ? 1 : exp2f(max_score - new_max);
+      U exp_score = is_neg_inf ? 0 : exp2f(score - new_max);
+
+      max_score = new_max;
+      sum_exp_score = sum_exp_score * factor + exp_score;
+
+      // Update the output accumulator with the dequantized value
+#pragma unroll
+      for (int j = 0; j < v_per_thread; j++) {
+        int e = v_per_thread * lane_idx + j;
+        int g = e >> params.group_shift;
+        U vv = static_cast<U>(V_scales[g]) * load_quant(V, e) +
+            static_cast<U>(V_biases[g]);
+        o[j] = o[j] * factor + exp_score * vv;
+      }
+    }
+
+    // Move the pointers to the next kv
+    K += inner_kv_stride;
+    V += inner_kv_stride;
+    K_scales += inner_sb_stride;
+    K_biases += inner_sb_stride;
+    V_scales += inner_sb_stride;
+    V_biases += inner_sb_stride;
+  }
+
+  if (lane_idx == 0) {
+    max_scores[warp_idx] = max_score;
+    sum_exp_scores[warp_idx] = sum_exp_score;
+  }
+  block.sync();
+
+  max_score = max_scores[lane_idx];
+  U new_max = cg::reduce(warp, max_score, cg::greater<U>());
+  U factor = exp2f(max_score - new_max);
+  sum_exp_score =
+      cg::reduce(warp, sum_exp_scores[lane_idx] * factor, cg::plus<U>());
+  sum_exp_score = __frcp_rn(sum_exp_score);
+
+  // Now we need to aggregate all the outputs
+#pragma unroll
+  for (int i = 0; i < v_per_thread; i++) {
+    outputs[lane_idx][warp_idx] = o[i];
+    block.sync();
+    U ot = outputs[warp_idx][lane_idx] * factor;
+    o[i] = cg::reduce(warp, ot, cg::plus<U>()) * sum_exp_score;
+    block.sync();
+  }
+
+  // And write the output
+  if (lane_idx == 0) {
+#pragma unroll
+    for (int i = 0; i < v_per_thread; i++) {
+      O[v_per_thread * warp_idx + i] = static_cast<T>(o[i]);
+    }
+  }
+}
+
+} // namespace cu
+
+namespace {
+
+template <typename F>
+void dispatch_quant_headdim(int n, F&& f) {
+  switch (n) {
+    case 64:
+      f(std::integral_constant<int, 64>{});
+      break;
+    case 96:
+      f(std::integral_constant<int, 96>{});
+      break;
+    case 128:
+      f(std::integral_constant<int, 128>{});
+      break;
+  }
+}
+
+template <typename F>
+void dispatch_quant_bits(int bits, F&& f) {
+  if (bits == 4) {
+    f(std::integral_constant<int, 4>{});
+  } else {
+    f(std::integral_constant<int, 8>{});
+  }
+}
+
+} // namespace
+
+namespace fast {
+
+bool QuantizedSDPA::use_fallback(
+    const array& q,
+    const array& k,
+    int group_size,
+    int bits,
+    Stream s) {
+  if (detail::in_grad_tracing()) {
+    return true;
+  }
+  if (s.device == Device::cpu) {
+    return true;
+  }
+
+  const int query_head_dim = q.shape(-1);
+  const bool supported_head_dim = query_head_dim == 64 ||
+      query_head_dim == 96 || query_head_dim == 128;
+
+  // Only the vector (decode) path has a fused dequantizing kernel.
+  return !supported_head_dim || q.shape(2) >= 4;
+}
+
+void QuantizedSDPA::eval_gpu(const std::vector<array>& inputs, array& out) {
+  nvtx3::scoped_range r("QuantizedSDPA::eval_gpu");
+
+  auto& s = stream();
+  auto& encoder = cu::get_command_encoder(s);
+
+  // The kernel indexes every input by shape, so make row contiguous copies
+  // where needed.
+  std::vector<array> copies;
+  auto ensure_row_contiguous = [&copies, &s](const array& arr) -> const array& {
+    if (arr.flags().row_contiguous) {
+      return arr;
+    }
+    array arr_copy = contiguous_copy_gpu(arr, s);
+    copies.push_back(std::move(arr_copy));
+    return copies.back();
+  };
+
+  const auto& q = ensure_row_contiguous(inputs[0]);
+  const auto& k = ensure_row_contiguous(inputs[1]);
+  const auto& k_scales = ensure_row_contiguous(inputs[2]);
+  const auto& k_biases = ensure_row_contiguous(inputs[3]);
+  const auto& v = ensure_row_contiguous(inputs[4]);
+  const auto& v_scales = ensure_row_contiguous(inputs[5]);
+  const auto& v_biases = ensure_row_contiguous(inputs[6]);
+
+  out.set_data(allocator::malloc(out.nbytes()));
+
+  for (const auto& cp : copies) {
+    encoder.add_temporary(cp);
+  }
+
+  encoder.set_input_array(q);
+  encoder.set_input_array(k);
+  encoder.set_input_array(k_scales);
+  encoder.set_input_array(k_biases);
+  encoder.set_input_array(v);
+  encoder.set_input_array(v_scales);
+  encoder.set_input_array(v_biases);
+  encoder.set_output_array(out);
+
+  int group_shift = 0;
+  while ((1 << group_shift) < group_size_) {
+    group_shift++;
+  }
+
+  cu::QuantAttnParams params{
+      /* int B = */ q.shape(0),
+      /* int H = */ q.shape(1),
+      /* int H_kv = */ k.shape(1),
+      /* int D = */ q.shape(3),
+
+      /* int qL = */ q.shape(2),
+      /* int kL = */ k.shape(2),
+
+      /* int gqa_factor = */ q.shape(1) / k.shape(1),
+      /* float scale = */ scale_,
+
+      /* int group_shift = */ group_shift,
+      /* int groups = */ q.shape(3) / group_size_};
+
+  dim3 grid_dim(params.H, params.qL, params.B);
+  dim3 block_dim(1024, 1, 1);
+
+  dispatch_float_types(out.dtype(), "kernel_quant_sdpav", [&](auto type_tag) {
+    dispatch_bool(do_causal_, [&](auto do_causal) {
+      dispatch_quant_headdim(params.D, [&](auto headdim) {
+        dispatch_quant_bits(bits_, [&](auto bits) {
+          using DataType = cuda_type_t<MLX_GET_TYPE(type_tag)>;
+
+          auto kernel = cu::kernel_quant_sdpav_1pass<
+              DataType,
+              do_causal.value,
+              headdim.value,
+              bits.value>;
+          encoder.add_kernel_node(
+              kernel,
+              grid_dim,
+              block_dim,
+              0,
+              q.data<DataType>(),
+              reinterpret_cast<const uint8_t*>(k.data<uint32_t>()),
+              k_scales.data<DataType>(),
+              k_biases.data<DataType>(),
+              reinterpret_cast<const uint8_t*>(v.data<uint32_t>()),
+              v_scales.data<DataType>(),
+              v_biases.data<DataType>(),
+              out.data<DataType>(),
+              params);
+        });
+      });
+    });
+  });
+}
+
+} // namespace fast
+
+} // namespace mlx::core
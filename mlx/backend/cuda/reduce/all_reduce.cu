@@ -57,8 +57,116 @@ __global__ void all_reduce(T* in, U* out, size_t block_step, size_t size) {
   }
 }
 
+
+// Single kernel variant of the two-pass reduce for medium sizes: every block
+// writes its partial, and the last block to finish folds the partials into
+// the final value on device, saving the second launch.
+template <typename T, typename U, typename ReduceOp, int N = 4>
+__global__ void all_reduce_single_pass(
+    T* in,
+    U* out,
+    size_t block_step,
+    size_t size,
+    U* partials,
+    int* counter) {
+  auto grid = cg::this_grid();
+  auto block = cg::this_thread_block();
+  auto warp = cg::tiled_partition<WARP_SIZE>(block);
+
+  const U init = cu::ReduceInit<ReduceOp, T>::value();
+  ReduceOp op;
+
+  T vals[N];
+  U accs[1];
+  accs[0] = init;
+
+  size_t start = grid.block_rank() * block_step;
+  size_t end = start + block_step;
+  size_t check = min(end, size);
+
+  size_t i = start;
+  for (; i + block.size() * N <= check; i += block.size() * N) {
+    cub::LoadDirectBlockedVectorized<T, N>(block.thread_rank(), in + i, vals);
+    for (int j = 0; j < N; j++) {
+      accs[0] = op(accs[0], cast_to<U>(vals[j]));
+    }
+  }
+
+  if (i < check) {
+    cub::LoadDirectBlocked(
+        block.thread_rank(), in + i, vals, check - i, cast_to<T>(init));
+    for (int j = 0; j < N; j++) {
+      accs[0] = op(accs[0], cast_to<U>(vals[j]));
+    }
+  }
+
+  __shared__ U shared_accumulators[32];
+  block_reduce(block, warp, accs, shared_accumulators, op, init);
+
+  __shared__ bool is_last;
+  if (block.thread_rank() == 0) {
+    partials[grid.block_rank()] = accs[0];
+    __threadfence();
+    is_last = atomicAdd(counter, 1) + 1 == grid.num_blocks();
+  }
+  block.sync();
+  if (!is_last) {
+    return;
+  }
+
+  accs[0] = init;
+  for (size_t j = block.thread_rank(); j < grid.num_blocks();
+       j += block.size()) {
+    accs[0] = op(accs[0], partials[j]);
+  }
+  block_reduce(block, warp, accs, shared_accumulators, op, init);
+
+  if (block.thread_rank() == 0) {
+    out[0] = accs[0];
+  }
+}
+
 } // namespace cu
 
+namespace {
+
+// Start migrating a small result back to the host behind the reduce so that
+// a host read after the completion event signals (e.g. item() on a loss)
+// does not begin with a page fault.
+void prefetch_result_to_host(cu::CommandEncoder& encoder, const array& out) {
+  if (out.size() != 1) {
+    return;
+  }
+  // Without concurrent managed access a prefetch can force the device to
+  // synchronize, which would defeat the point of the hint
+  static bool supported = []() {
+    int attr = 0;
+    cudaDeviceGetAttribute(&attr, cudaDevAttrConcurrentManagedAccess, 0);
+    return attr != 0;
+  }();
+  if (!supported) {
+    return;
+  }
+  auto capture = encoder.capture_context();
+#if CUDART_VERSION >= 13000
+  cudaMemLocation loc;
+  loc.type = cudaMemLocationTypeHost;
+  loc.id = 0;
+  auto err = cudaMemPrefetchAsync(
+      out.data<void>(), out.nbytes(), loc, 0, encoder.stream());
+#else
+  auto err = cudaMemPrefetchAsync(
+      out.data<void>(), out.nbytes(), cudaCpuDeviceId, encoder.stream());
+#endif // CUDART_VERSION >= 13000
+  if (err != cudaSuccess) {
+    // Best effort; a failed hint leaves demand paging to do the job
+    capture.discard = true;
+    cudaGetLastError();
+  }
+}
+
+} // namespace
+
 void all_reduce(
     cu::CommandEncoder& encoder,
     const array& in,
@@ -102,9 +210,52 @@ void all_reduce(
   // Cub doesn't like const pointers for load (sigh).
   void* indata = const_cast<void*>(in.data<void>());
 
-  // Large array so allocate an intermediate and accumulate there
   std::tie(blocks, threads, block_step) = get_args(insize, N_READS);
   encoder.set_input_array(in);
+
+  // Medium array so fuse the two passes into one kernel with a device-side
+  // finalization
+  constexpr int max_single_pass_blocks = 128;
+  if (blocks > 1 && blocks <= max_single_pass_blocks) {
+    array partials({blocks}, out.dtype(), nullptr, {});
+    partials.set_data(allocator::malloc(partials.nbytes()));
+    encoder.add_temporary(partials);
+    array counter({1}, int32, nullptr, {});
+    counter.set_data(allocator::malloc(counter.nbytes()));
+    encoder.add_temporary(counter);
+    encoder.set_output_array(counter);
+    {
+      auto capture = encoder.capture_context();
+      CHECK_CUDA_ERROR(cudaMemsetAsync(
+          counter.data<void>(), 0, counter.nbytes(), encoder.stream()));
+    }
+
+    encoder.set_input_array(counter);
+    encoder.set_output_array(out);
+    dispatch_all_types(dt, [&](auto type_tag) {
+      dispatch_reduce_ops(reduce_type, [&](auto reduce_type_tag) {
+        using OP = MLX_GET_TYPE(reduce_type_tag);
+        using T = cuda_type_t<MLX_GET_TYPE(type_tag)>;
+        using U = typename cu::ReduceResult<OP, T>::type;
+        auto kernel = cu::all_reduce_single_pass<T, U, OP, N_READS>;
+        encoder.add_kernel_node(
+            kernel,
+            blocks,
+            threads,
+            0,
+            static_cast<T*>(indata),
+            out.data<U>(),
+            block_step,
+            insize,
+            partials.data<U>(),
+            counter.data<int32_t>());
+      });
+    });
+    prefetch_result_to_host(encoder, out);
+    return;
+  }
+
+  // Large array so allocate an intermediate and accumulate there
   if (blocks > 1) {
     array intermediate({blocks}, out.dtype(), nullptr, {});
     intermediate.set_data(allocator::malloc(intermediate.nbytes()));
@@ -154,6 +305,7 @@ void all_reduce(
           insize);
     });
   });
+  prefetch_result_to_host(encoder, out);
 }
 
 } // namespace mlx::core
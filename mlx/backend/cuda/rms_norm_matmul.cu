@@ -0,0 +1,155 @@
+// Copyright © 2025 Apple Inc.
+
+#include "mlx/backend/cuda/device.h"
+#include "mlx/backend/cuda/kernel_utils.cuh"
+#include "mlx/backend/cuda/steel/gemm.cuh"
+#include "mlx/backend/gpu/copy.h"
+#include "mlx/dtype_utils.h"
+#include "mlx/fast_primitives.h"
+#include "mlx/transforms_impl.h"
+
+#include <nvtx3/nvtx3.hpp>
+
+#include <cooperative_groups.h>
+#include <cooperative_groups/reduce.h>
+
+namespace mlx::core {
+
+namespace cu {
+
+namespace cg = cooperative_groups;
+
+// One warp per row: compute 1 / sqrt(mean(x^2) + eps) for every row of x.
+// The statistics are tiny (one float per row) so this pass is essentially
+// free next to the GEMM that consumes them.
+template <typename T>
+__global__ void rms_row_stats(const T* x, float* inv_rms, int K, float eps) {
+  auto block = cg::this_thread_block();
+  auto warp = cg::tiled_partition<WARP_SIZE>(block);
+
+  const int row =
+      block.group_index().x * warp.meta_group_size() + warp.meta_group_rank();
+  x += size_t(row) * K;
+
+  float acc = 0.f;
+  for (int k = warp.thread_rank(); k < K; k += WARP_SIZE) {
+    float v = static_cast<float>(x[k]);
+    acc += v * v;
+  }
+  acc = cg::reduce(warp, acc, cg::plus<float>());
+
+  if (warp.thread_rank() == 0) {
+    inv_rms[row] = rsqrtf(acc / K + eps);
+  }
+}
+
+} // namespace cu
+
+namespace fast {
+
+bool RMSNormMatmul::use_fallback(const array& x, const array& w, Stream s) {
+  if (detail::in_grad_tracing()) {
+    return true;
+  }
+  if (s.device == Device::cpu) {
+    return true;
+  }
+
+  // The steel kernel does bf16 mmas over block-aligned tiles.
+  constexpr int BM = 64;
+  constexpr int BN = 64;
+  constexpr int BK = 32;
+  int64_t K = x.shape(-1);
+  int64_t M = x.size() / K;
+  int64_t N = w.shape(0);
+  return x.dtype() != bfloat16 || (M % BM) != 0 || (N % BN) != 0 ||
+      (K % BK) != 0;
+}
+
+void RMSNormMatmul::eval_gpu(const std::vector<array>& inputs, array& out) {
+  nvtx3::scoped_range r("RMSNormMatmul::eval_gpu");
+
+  auto& s = stream();
+  auto& encoder = cu::get_command_encoder(s);
+
+  std::vector<array> copies;
+  auto ensure_row_contiguous = [&copies, &s](const array& arr) -> const array& {
+    if (arr.flags().row_contiguous) {
+      return arr;
+    }
+    array arr_copy = contiguous_copy_gpu(arr, s);
+    copies.push_back(std::move(arr_copy));
+    return copies.back();
+  };
+
+  const auto& x = ensure_row_contiguous(inputs[0]);
+  const auto& gamma = ensure_row_contiguous(inputs[1]);
+  const auto& w = ensure_row_contiguous(inputs[2]);
+
+  int K = x.shape(-1);
+  int M = x.size() / K;
+  int N = w.shape(0);
+
+  out.set_data(allocator::malloc(out.nbytes()));
+
+  // Row statistics
+  array inv_rms({M}, float32, nullptr, {});
+  inv_rms.set_data(allocator::malloc(inv_rms.nbytes()));
+  encoder.add_temporary(inv_rms);
+  for (const auto& cp : copies) {
+    encoder.add_temporary(cp);
+  }
+
+  using DataType = cuda_type_t<bfloat16_t>;
+
+  {
+    constexpr int warps_per_block = 4;
+    encoder.set_input_array(x);
+    encoder.set_output_array(inv_rms);
+    dim3 grid_dim(cuda::ceil_div(M, warps_per_block));
+    dim3 block_dim(warps_per_block * WARP_SIZE);
+    encoder.add_kernel_node(
+        cu::rms_row_stats<DataType>,
+        grid_dim,
+        block_dim,
+        0,
+        x.data<DataType>(),
+        inv_rms.data<float>(),
+        K,
+        eps_);
+  }
+
+  {
+    constexpr int BM = 64;
+    constexpr int BN = 64;
+    constexpr int BK = 32;
+
+    encoder.set_input_array(x);
+    encoder.set_input_array(gamma);
+    encoder.set_input_array(w);
+    encoder.set_input_array(inv_rms);
+    encoder.set_output_array(out);
+
+    auto kernel = cu::rms_norm_ab_t_aligned<DataType, BM, BN, BK>;
+    dim3 grid_dim(N / BN, M / BM);
+    dim3 block_dim(4 * WARP_SIZE);
+    uint32_t smem = 2 * (BM * BK + BN * BK) * sizeof(DataType);
+    encoder.add_kernel_node(
+        kernel,
+        grid_dim,
+        block_dim,
+        smem,
+        x.data<DataType>(),
+        w.data<DataType>(),
+        // A scalar weight means rms_norm without gamma
+        gamma.ndim() == 1 ? gamma.data<DataType>() : nullptr,
+        inv_rms.data<float>(),
+        out.data<DataType>(),
+        N,
+        K);
+  }
+}
+
+} // namespace fast
+
+} // namespace mlx::core
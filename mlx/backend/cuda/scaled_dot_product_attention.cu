@@ -674,6 +674,7 @@ bool ScaledDotProductAttention::use_fallback(
     bool has_mask,
     bool has_arr_mask,
     bool do_causal,
+    bool do_block_sparse,
     Stream s) {
   if (detail::in_grad_tracing()) {
     return true;
@@ -98,4 +98,158 @@ __global__ void ab_t_aligned(const T* a, const T* b, T* y, int N, int K) {
   C.store_global(y, N, offset_m, offset_n);
 }
 
+/**
+ * Computes rms_norm(A, gamma) @ B.T without materializing the normalized
+ * activations.
+ *
+ * The row statistics come precomputed in `inv_rms`; since they are constant
+ * along the reduction they are applied to the accumulators in the epilogue,
+ * while `gamma` (which indexes the reduction dimension) is folded into the
+ * A-operand register loads. A and B must be aligned with the block sizes
+ * like in ab_t_aligned.
+ */
+template <typename T, int BM, int BN, int BK>
+__global__ void rms_norm_ab_t_aligned(
+    const T* a,
+    const T* b,
+    const T* gamma,
+    const float* inv_rms,
+    T* y,
+    int N,
+    int K) {
+  constexpr int WARPS_M = 2;
+  constexpr int WARPS_N = 2;
+  constexpr int NUM_WARPS = WARPS_M * WARPS_N;
+  constexpr int WARP_STEP_M = BM / WARPS_M;
+  constexpr int WARP_STEP_N = BN / WARPS_N;
+
+  using T2 = Vector2_t<T>;
+
+  // Precompute some offsets for each thread
+  const int warpid = threadIdx.x / 32;
+  const int laneid = threadIdx.x % 32;
+  const int wm = warpid / WARPS_N;
+  const int wn = warpid % WARPS_N;
+  const int offset_m = wm * WARP_STEP_M;
+  const int offset_n = wn * WARP_STEP_N;
+
+  // Allocate shared memory
+  extern __shared__ char shmem[];
+  SharedTile<T, BM, BK>(&as)[2] = *(SharedTile<T, BM, BK>(*)[2])(&shmem[0]);
+  SharedTile<T, BN, BK>(&bs)[2] =
+      *(SharedTile<T, BN, BK>(*)[2])(&shmem[sizeof(T) * 2 * BM * BK]);
+
+  // Allocate registers for the MMA
+  RegisterTile<float, BM / WARPS_M, BN / WARPS_N> C;
+  RegisterTile<T, BM / WARPS_M, 16> A;
+  RegisterTile<T, BN / WARPS_N, 16> B;
+
+  // Move the global pointers to the tile
+  a += blockIdx.y * BM * K;
+  b += blockIdx.x * BN * K;
+  y += blockIdx.y * BM * N + blockIdx.x * BN;
+
+  // Loads an A fragment from shared memory and multiplies it by gamma. The
+  // fragment columns held by this thread start at 2 * (laneid % 4) and
+  // 2 * (laneid % 4) + 8 of the 16 wide tile whose first column is at
+  // `kbase` of the reduction dimension.
+  int kbase = 0;
+  auto gamma_load = [&](Tile16x16<T>& frag,
+                        SharedTile<T, BM, BK>& tile,
+                        uint32_t base_address,
+                        int row,
+                        int col) {
+    frag.load(tile.loc(base_address, row, col));
+    if (gamma != nullptr) {
+      int kc = kbase + (col - (laneid / 16) * 8) + 2 * (laneid % 4);
+      T2 g0 = *reinterpret_cast<const T2*>(gamma + kc);
+      T2 g1 = *reinterpret_cast<const T2*>(gamma + kc + 8);
+      frag.values[0] = __hmul2(frag.values[0], g0);
+      frag.values[1] = __hmul2(frag.values[1], g0);
+      frag.values[2] = __hmul2(frag.values[2], g1);
+      frag.values[3] = __hmul2(frag.values[3], g1);
+    }
+  };
+
+  // Zero the accumulators
+  C.fill(0);
+
+  // Start the SM pipeline
+  load_async<NUM_WARPS>(as[0], as[0].base_addr(), a, K);
+  load_async<NUM_WARPS>(bs[0], bs[0].base_addr(), b, K);
+  cp_async_commit();
+
+  int tic = 0;
+  for (int k_block = BK; k_block < K; k_block += BK) {
+    load_async<NUM_WARPS>(as[tic ^ 1], as[tic ^ 1].base_addr(), a + k_block, K);
+    load_async<NUM_WARPS>(bs[tic ^ 1], bs[tic ^ 1].base_addr(), b + k_block, K);
+    cp_async_commit();
+    cp_async_wait<1>();
+    __syncthreads();
+
+    kbase = k_block - BK;
+    MLX_UNROLL
+    for (int k = 0; k < BK / 16; k++) {
+      A.load(
+          as[tic],
+          gamma_load,
+          as[tic].base_addr(),
+          offset_m + laneid % 16,
+          k * 16 + laneid / 16 * 8);
+      B.load(
+          bs[tic],
+          bs[tic].base_addr(),
+          offset_n + laneid % 16,
+          k * 16 + laneid / 16 * 8);
+
+      mma_t(C, A, B);
+    }
+
+    tic ^= 1;
+  }
+
+  // Empty the pipeline
+  cp_async_wait_all();
+  __syncthreads();
+  kbase = K - BK;
+  MLX_UNROLL
+  for (int k = 0; k < BK / 16; k++) {
+    A.load(
+        as[tic],
+        gamma_load,
+        as[tic].base_addr(),
+        offset_m + laneid % 16,
+        k * 16 + laneid / 16 * 8);
+    B.load(
+        bs[tic],
+        bs[tic].base_addr(),
+        offset_n + laneid % 16,
+        k * 16 + laneid / 16 * 8);
+
+    mma_t(C, A, B);
+  }
+
+  // Scale the accumulators by the row statistics before writing out
+  const int base_m = blockIdx.y * BM + offset_m + laneid / 4;
+  MLX_UNROLL
+  for (int i = 0; i < decltype(C)::TILES_Y; i++) {
+    float r0 = inv_rms[base_m + i * 16];
+    float r8 = inv_rms[base_m + i * 16 + 8];
+    MLX_UNROLL
+    for (int j = 0; j < decltype(C)::TILES_X; j++) {
+      auto& frag = C.data[i * decltype(C)::TILES_X + j];
+      frag.values[0].x *= r0;
+      frag.values[0].y *= r0;
+      frag.values[2].x *= r0;
+      frag.values[2].y *= r0;
+      frag.values[1].x *= r8;
+      frag.values[1].y *= r8;
+      frag.values[3].x *= r8;
+      frag.values[3].y *= r8;
+    }
+  }
+
+  C.store_global(y, N, offset_m, offset_n);
+}
+
 } // namespace mlx::core::cu
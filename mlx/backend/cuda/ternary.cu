@@ -265,4 +265,16 @@ void Select::eval_gpu(const std::vector<array>& inputs, array& out) {
   ternary_op_gpu<cu::Select>(inputs, out, s);
 }
 
+void MaskedAdd::eval_gpu(const std::vector<array>& inputs, array& out) {
+  nvtx3::scoped_range r("MaskedAdd::eval_gpu");
+  auto& s = out.primitive().stream();
+  ternary_op_gpu<cu::MaskedAdd>(inputs, out, s);
+}
+
+void MaskedMultiply::eval_gpu(const std::vector<array>& inputs, array& out) {
+  nvtx3::scoped_range r("MaskedMultiply::eval_gpu");
+  auto& s = out.primitive().stream();
+  ternary_op_gpu<cu::MaskedMultiply>(inputs, out, s);
+}
+
 } // namespace mlx::core
@@ -81,9 +81,20 @@ void CudaGraphExec::instantiate(cudaGraph_t graph) {
   CHECK_CUDA_ERROR(cudaGraphInstantiate(&handle_, graph, nullptr, nullptr, 0));
 }
 
-CudaStream::CudaStream(cu::Device& device) {
+CudaStream::CudaStream(cu::Device& device, StreamPriority priority) {
   device.make_current();
-  CHECK_CUDA_ERROR(cudaStreamCreateWithFlags(&handle_, cudaStreamNonBlocking));
+  if (priority == StreamPriority::normal) {
+    CHECK_CUDA_ERROR(
+        cudaStreamCreateWithFlags(&handle_, cudaStreamNonBlocking));
+  } else {
+    // Lower numbers mean higher priority in CUDA
+    int least, greatest;
+    CHECK_CUDA_ERROR(cudaDeviceGetStreamPriorityRange(&least, &greatest));
+    CHECK_CUDA_ERROR(cudaStreamCreateWithPriority(
+        &handle_,
+        cudaStreamNonBlocking,
+        priority == StreamPriority::high ? greatest : least));
+  }
 }
 
 } // namespace mlx::core
@@ -8,6 +8,8 @@
 #include <cuda.h>
 #include <cuda_runtime.h>
 
+#include "mlx/stream.h"
+
 namespace mlx::core {
 
 namespace cu {
@@ -83,7 +85,9 @@ class CudaGraphExec : public CudaHandle<cudaGraphExec_t, cudaGraphExecDestroy> {
 
 class CudaStream : public CudaHandle<cudaStream_t, cudaStreamDestroy> {
  public:
-  explicit CudaStream(cu::Device& device);
+  explicit CudaStream(
+      cu::Device& device,
+      StreamPriority priority = StreamPriority::normal);
 };
 
 } // namespace mlx::core
@@ -1,8 +1,11 @@
 // Copyright © 2023-2024 Apple Inc.
 #include "mlx/backend/metal/allocator.h"
+#include "mlx/backend/common/resident_memory.h"
 #include "mlx/backend/metal/metal.h"
 #include "mlx/backend/metal/resident.h"
+#include "mlx/device.h"
 #include "mlx/memory.h"
+#include "mlx/utils.h"
 
 #include <mach/vm_page_size.h>
 #include <unistd.h>
@@ -13,6 +16,14 @@ namespace mlx::core {
 constexpr size_t resource_options =
     MTL::ResourceStorageModeShared | MTL::ResourceHazardTrackingModeUntracked;
 
+// The byte budget of each per-stream buffer pool when
+// MLX_STREAM_BUFFER_POOLS is enabled.
+constexpr size_t stream_pool_size = 1 << 24;
+
+// How many allocations go by between samples of the process resident set
+// size when an rss watermark is set.
+constexpr size_t rss_check_interval = 256;
+
 namespace allocator {
 
 Allocator& allocator() {
@@ -41,7 +52,10 @@ MetalAllocator::MetalAllocator()
               residency_set_.erase(buf);
             }
             buf->release();
-          }) {
+          }),
+      stream_pools_(
+          stream_pool_size,
+          [](MTL::Buffer* buf) { return buf->length(); }) {
   auto pool = metal::new_scoped_memory_pool();
   auto memsize = std::get<size_t>(device_info().at("memory_size"));
   auto max_rec_size =
@@ -54,25 +68,49 @@ MetalAllocator::MetalAllocator()
       .set_residency_set(residency_set_.mtl_residency_set());
   bool is_vm = std::get<std::string>(device_info().at("device_name")) ==
       "Apple Paravirtual device";
-  if (is_vm) {
-    return;
+  if (!is_vm) {
+    // Anything below a page wastes most of a standalone buffer's backing,
+    // so sub-page allocations suballocate from shared heaps instead
+    small_buffer_size_ = vm_page_size;
   }
-  auto heap_desc = MTL::HeapDescriptor::alloc()->init();
-  heap_desc->setResourceOptions(resource_options);
-  heap_desc->setSize(heap_size_);
-  heap_ = device_->newHeap(heap_desc);
-  heap_desc->release();
-  residency_set_.insert(heap_);
 }
 
 MetalAllocator::~MetalAllocator() {
   auto pool = metal::new_scoped_memory_pool();
-  if (heap_) {
-    heap_->release();
+  for (auto* heap : heaps_) {
+    heap->release();
   }
   buffer_cache_.clear();
 }
 
+MTL::Buffer* MetalAllocator::heap_alloc(size_t size) {
+  std::unique_lock lk(mutex_);
+  // Newest heaps have the most free space, so walk them in reverse to
+  // avoid probing full heaps on every small allocation
+  for (auto it = heaps_.rbegin(); it != heaps_.rend(); ++it) {
+    if (auto* buf = (*it)->newBuffer(size, resource_options); buf) {
+      return buf;
+    }
+  }
+  if (heaps_.size() >= max_heaps_) {
+    return nullptr;
+  }
+  auto heap_desc = MTL::HeapDescriptor::alloc()->init();
+  heap_desc->setResourceOptions(resource_options);
+  heap_desc->setSize(heap_size_);
+  auto* heap = device_->newHeap(heap_desc);
+  heap_desc->release();
+  if (!heap) {
+    // The device refused a heap; stop trying for this process
+    small_buffer_size_ = 0;
+    return nullptr;
+  }
+  num_resources_++;
+  residency_set_.insert(heap);
+  heaps_.push_back(heap);
+  return heap->newBuffer(size, resource_options);
+}
+
 size_t MetalAllocator::set_cache_limit(size_t limit) {
   std::unique_lock lk(mutex_);
   std::swap(limit, max_pool_size_);
@@ -120,6 +158,15 @@ Buffer MetalAllocator::malloc(size_t size) {
     size = vm_page_size * ((size + vm_page_size - 1) / vm_page_size);
   }
 
+  // Try the calling stream's local pool without taking the global lock
+  if (env::stream_buffer_pools()) {
+    if (MTL::Buffer* buf = stream_pools_.try_reuse(size)) {
+      update_peak_memory(active_memory_.fetch_add(size) + size);
+      check_rss_watermark();
+      return Buffer{static_cast<void*>(buf)};
+    }
+  }
+
   // Try the cache
   std::unique_lock lk(mutex_);
   MTL::Buffer* buf = buffer_cache_.reuse_from_cache(size);
@@ -128,8 +175,14 @@ Buffer MetalAllocator::malloc(size_t size) {
 
     auto pool = metal::new_scoped_memory_pool();
 
-    // If we have a lot of memory pressure try to reclaim memory from the cache
+    // If we have a lot of memory pressure try to reclaim memory from the
+    // stream pools and the cache
     if (mem_required >= gc_limit_ || num_resources_ >= resource_limit_) {
+      std::vector<MTL::Buffer*> drained;
+      stream_pools_.drain(drained);
+      for (auto* b : drained) {
+        buffer_cache_.recycle_to_cache(b);
+      }
       num_resources_ -=
           buffer_cache_.release_cached_buffers(mem_required - gc_limit_);
     }
@@ -142,8 +195,8 @@ Buffer MetalAllocator::malloc(size_t size) {
       throw std::runtime_error(msg.str());
     }
     lk.unlock();
-    if (size < small_size_ && heap_) {
-      buf = heap_->newBuffer(size, resource_options);
+    if (size <= small_buffer_size_) {
+      buf = heap_alloc(size);
     }
     if (!buf) {
       buf = device_->newBuffer(size, resource_options);
@@ -158,8 +211,7 @@ Buffer MetalAllocator::malloc(size_t size) {
     }
   }
 
-  active_memory_ += buf->length();
-  peak_memory_ = std::max(peak_memory_, active_memory_);
+  update_peak_memory(active_memory_.fetch_add(buf->length()) + buf->length());
 
   // Maintain the cache below the requested limit
   if (get_cache_memory() > max_pool_size_) {
@@ -168,20 +220,157 @@ Buffer MetalAllocator::malloc(size_t size) {
         get_cache_memory() - max_pool_size_);
   }
 
+  lk.unlock();
+  check_rss_watermark();
   return Buffer{static_cast<void*>(buf)};
 }
 
 void MetalAllocator::clear_cache() {
   std::unique_lock lk(mutex_);
   auto pool = metal::new_scoped_memory_pool();
+  std::vector<MTL::Buffer*> drained;
+  stream_pools_.drain(drained);
+  for (auto* buf : drained) {
+    num_resources_--;
+    if (!buf->heap()) {
+      residency_set_.erase(buf);
+    }
+    buf->release();
+  }
   num_resources_ -= buffer_cache_.clear();
 }
 
+void MetalAllocator::update_peak_memory(size_t active) {
+  size_t peak = peak_memory_.load(std::memory_order_relaxed);
+  while (peak < active && !peak_memory_.compare_exchange_weak(peak, active)) {
+  }
+}
+
+size_t MetalAllocator::set_rss_watermark(size_t limit) {
+  return rss_watermark_.exchange(limit);
+}
+
+void MetalAllocator::check_rss_watermark() {
+  size_t watermark = rss_watermark_.load(std::memory_order_relaxed);
+  if (watermark == 0 ||
+      (malloc_count_.fetch_add(1, std::memory_order_relaxed) %
+       rss_check_interval) != 0) {
+    return;
+  }
+  size_t rss = get_resident_memory();
+  if (rss <= watermark) {
+    return;
+  }
+
+  // Trim toward the low watermark
+  std::unique_lock lk(mutex_);
+  auto pool = metal::new_scoped_memory_pool();
+  std::vector<MTL::Buffer*> drained;
+  stream_pools_.drain(drained);
+  for (auto* b : drained) {
+    buffer_cache_.recycle_to_cache(b);
+  }
+  num_resources_ -= buffer_cache_.release_cached_buffers(rss - 0.9 * watermark);
+}
+
+Buffer MetalAllocator::malloc_wired(size_t size) {
+  if (size == 0) {
+    return Buffer{nullptr};
+  }
+  if (size > device_->maxBufferLength()) {
+    std::ostringstream msg;
+    msg << "[metal::malloc_wired] Attempting to allocate " << size
+        << " bytes which is greater than"
+        << " the maximum allowed buffer size of " << device_->maxBufferLength()
+        << " bytes.";
+    throw std::runtime_error(msg.str());
+  }
+  auto pool = metal::new_scoped_memory_pool();
+  MTL::Buffer* buf = device_->newBuffer(size, resource_options);
+  if (!buf) {
+    return Buffer{nullptr};
+  }
+  std::unique_lock lk(mutex_);
+  num_resources_++;
+  residency_set_.insert(buf);
+  wired_buffers_.insert(buf);
+  wired_buffer_count_.fetch_add(1, std::memory_order_release);
+  lk.unlock();
+  update_peak_memory(active_memory_.fetch_add(buf->length()) + buf->length());
+  return Buffer{static_cast<void*>(buf)};
+}
+
+Buffer MetalAllocator::wrap_external(void* ptr, size_t size) {
+  if (ptr == nullptr || size == 0) {
+    return Buffer{nullptr};
+  }
+  if (reinterpret_cast<uintptr_t>(ptr) % vm_page_size != 0) {
+    throw std::invalid_argument(
+        "[metal::wrap_external] External memory must be page aligned "
+        "(e.g. an mmap'd region) to be wrapped without a copy.");
+  }
+  auto pool = metal::new_scoped_memory_pool();
+  // No-copy buffers cover whole pages; the rounded length stays within the
+  // caller's mapping since mappings are page granular
+  size_t length = vm_page_size * ((size + vm_page_size - 1) / vm_page_size);
+  MTL::Buffer* buf = device_->newBuffer(
+      ptr, length, resource_options, [](void*, NS::UInteger) {});
+  if (!buf) {
+    return Buffer{nullptr};
+  }
+  std::unique_lock lk(mutex_);
+  num_resources_++;
+  residency_set_.insert(buf);
+  wrapped_.insert(buf);
+  wrapped_count_.fetch_add(1, std::memory_order_release);
+  return Buffer{static_cast<void*>(buf)};
+}
+
 void MetalAllocator::free(Buffer buffer) {
   auto buf = static_cast<MTL::Buffer*>(buffer.ptr());
   if (buf == nullptr) {
     return;
   }
+
+  // Externally owned memory only releases the wrapper's bookkeeping; it
+  // must never reach the pools or the cache
+  if (wrapped_count_.load(std::memory_order_acquire) > 0) {
+    std::unique_lock lk(mutex_);
+    if (auto it = wrapped_.find(buf); it != wrapped_.end()) {
+      wrapped_.erase(it);
+      wrapped_count_.fetch_sub(1, std::memory_order_release);
+      num_resources_--;
+      residency_set_.erase(buf);
+      lk.unlock();
+      auto pool = metal::new_scoped_memory_pool();
+      buf->release();
+      return;
+    }
+  }
+
+  // Wired buffers are released outright, never cached
+  if (wired_buffer_count_.load(std::memory_order_acquire) > 0) {
+    std::unique_lock lk(mutex_);
+    if (auto it = wired_buffers_.find(buf); it != wired_buffers_.end()) {
+      wired_buffers_.erase(it);
+      wired_buffer_count_.fetch_sub(1, std::memory_order_release);
+      num_resources_--;
+      residency_set_.erase(buf);
+      active_memory_ -= buf->length();
+      lk.unlock();
+      auto pool = metal::new_scoped_memory_pool();
+      buf->release();
+      return;
+    }
+  }
+
+  // Keep the buffer in the calling stream's local pool when there is room
+  if (env::stream_buffer_pools() && get_cache_memory() < max_pool_size_ &&
+      stream_pools_.try_recycle(buf)) {
+    active_memory_ -= buf->length();
+    return;
+  }
+
   std::unique_lock lk(mutex_);
   active_memory_ -= buf->length();
   if (get_cache_memory() < max_pool_size_) {
@@ -220,6 +409,9 @@ size_t set_memory_limit(size_t limit) {
 size_t get_memory_limit() {
   return metal::allocator().get_memory_limit();
 }
+size_t set_rss_watermark(size_t limit) {
+  return metal::allocator().set_rss_watermark(limit);
+}
 size_t set_wired_limit(size_t limit) {
   if (limit > std::get<size_t>(metal::device_info().at(
                   "max_recommended_working_set_size"))) {
@@ -241,8 +433,17 @@ void reset_peak_memory() {
 size_t get_cache_memory() {
   return metal::allocator().get_cache_memory();
 }
+CacheStats get_cache_stats() {
+  return metal::allocator().get_cache_stats();
+}
+void reset_cache_stats() {
+  metal::allocator().reset_cache_stats();
+}
 void clear_cache() {
   return metal::allocator().clear_cache();
 }
 
+// Metal has a single physical memory; there is nothing to migrate.
+void prefetch(const array&, Device) {}
+
 } // namespace mlx::core
@@ -2,12 +2,15 @@
 
 #pragma once
 
+#include <atomic>
 #include <map>
 #include <mutex>
+#include <unordered_set>
 #include <vector>
 
 #include "mlx/allocator.h"
 #include "mlx/backend/common/buffer_cache.h"
+#include "mlx/backend/common/stream_buffer_pool.h"
 #include "mlx/backend/metal/device.h"
 #include "mlx/backend/metal/resident.h"
 
@@ -21,6 +24,8 @@ class MetalAllocator : public allocator::Allocator {
   virtual Buffer malloc(size_t size) override;
   virtual void free(Buffer buffer) override;
   virtual size_t size(Buffer buffer) const override;
+  virtual Buffer wrap_external(void* ptr, size_t size) override;
+  virtual Buffer malloc_wired(size_t size) override;
   size_t get_active_memory() {
     return active_memory_;
   };
@@ -32,23 +37,37 @@ class MetalAllocator : public allocator::Allocator {
     peak_memory_ = 0;
   };
   size_t get_cache_memory() {
-    return buffer_cache_.cache_size();
+    return buffer_cache_.cache_size() + stream_pools_.pool_size();
+  };
+  CacheStats get_cache_stats() {
+    return buffer_cache_.stats();
+  };
+  void reset_cache_stats() {
+    std::unique_lock lk(mutex_);
+    buffer_cache_.reset_stats();
   };
   size_t set_cache_limit(size_t limit);
   size_t set_memory_limit(size_t limit);
   size_t get_memory_limit();
   size_t set_wired_limit(size_t limit);
+  size_t set_rss_watermark(size_t limit);
   void clear_cache();
 
  private:
   MTL::Device* device_;
 
-  // The size of allocations which go on the heap until it is full. This size
-  // is chosen because it is the actual minimum size of a buffer allocated from
-  // the heap, a heap can have at most heap.size() / 256 buffers.
-  static constexpr int small_size_ = 256;
+  // Small allocations are suballocated from shared heaps instead of each
+  // taking a page-granular device buffer and a residency set entry. Heaps
+  // are added as they fill, up to max_heaps_; past that (or when the
+  // device does not support heaps) small allocations fall back to
+  // standalone buffers. A heap sub-allocates at 256 byte granularity, so
+  // a heap can have at most heap_size_ / 256 buffers.
   static constexpr int heap_size_ = 1 << 20;
-  MTL::Heap* heap_;
+  static constexpr int max_heaps_ = 64;
+  std::vector<MTL::Heap*> heaps_;
+  // Allocations up to this size go on the heaps; 0 disables them
+  size_t small_buffer_size_{0};
+  MTL::Buffer* heap_alloc(size_t size);
   MetalAllocator();
   ~MetalAllocator();
   friend MetalAllocator& allocator();
@@ -56,13 +75,32 @@ class MetalAllocator : public allocator::Allocator {
   // Caching allocator
   BufferCache<MTL::Buffer> buffer_cache_;
 
+  // Optional per-stream pools in front of the cache (MLX_STREAM_BUFFER_POOLS)
+  StreamPoolSet<MTL::Buffer> stream_pools_;
+
   ResidencySet residency_set_;
 
+  void update_peak_memory(size_t active);
+  void check_rss_watermark();
+
   // Allocation stats
   size_t block_limit_;
   size_t gc_limit_;
-  size_t active_memory_{0};
-  size_t peak_memory_{0};
+  std::atomic<size_t> active_memory_{0};
+  std::atomic<size_t> peak_memory_{0};
+  // Resident memory watermark (0 disables the check)
+  std::atomic<size_t> rss_watermark_{0};
+  std::atomic<size_t> malloc_count_{0};
+
+  // Buffers wrapping externally owned memory (see wrap_external). The
+  // count lets free skip the set lookup when no wrapped buffers exist.
+  std::unordered_set<MTL::Buffer*> wrapped_;
+  std::atomic<size_t> wrapped_count_{0};
+
+  // Wired buffers (see malloc_wired); released outright on free instead of
+  // recycling through the cache
+  std::unordered_set<MTL::Buffer*> wired_buffers_;
+  std::atomic<size_t> wired_buffer_count_{0};
   size_t max_pool_size_;
   size_t wired_limit_{0};
   bool relaxed_{true};
@@ -1,6 +1,7 @@
 // Copyright © 2024 Apple Inc.
 #include "mlx/backend/common/binary.h"
 #include "mlx/backend/metal/device.h"
+#include "mlx/backend/metal/elementwise_tuner.h"
 #include "mlx/backend/metal/kernels.h"
 #include "mlx/backend/metal/utils.h"
 #include "mlx/primitives.h"
@@ -62,6 +63,56 @@ std::string get_kernel_name(
   return kname;
 }
 
+namespace {
+
+// Pick between the scalar and vectorized contiguous kernels by timing
+// both on this device. As in the unary case the key leaves the op out;
+// the contiguous binary kernels are bandwidth bound.
+int tuned_binary_work_per_thread(
+    metal::Device& d,
+    const Stream& s,
+    const array& a,
+    const array& b,
+    const array& out,
+    BinaryOpType bopt,
+    const char* op,
+    int work_per_thread) {
+  std::string key;
+  concatenate(
+      key,
+      "binary_",
+      type_to_name(a),
+      type_to_name(out),
+      "_n",
+      work_size_bucket(out.data_size()));
+  auto encode_one = [&](int wpt, MTL::ComputeCommandEncoder* enc) {
+    auto kernel_name =
+        get_kernel_name(bopt, op, a, /* large = */ false, 0, wpt);
+    auto kernel = get_binary_kernel(d, kernel_name, a.dtype(), out.dtype(), op);
+    enc->setComputePipelineState(kernel);
+    auto buf = [](const array& x) {
+      return static_cast<const MTL::Buffer*>(x.buffer().ptr());
+    };
+    auto buf_offset = [&](const array& x) {
+      return x.data<char>() -
+          static_cast<char*>(const_cast<MTL::Buffer*>(buf(x))->contents());
+    };
+    enc->setBuffer(buf(a), buf_offset(a), 0);
+    enc->setBuffer(buf(b), buf_offset(b), 1);
+    enc->setBuffer(buf(out), buf_offset(out), 2);
+    int size = out.data_size();
+    enc->setBytes(&size, sizeof(int), 3);
+    size_t nthreads = ceildiv(out.data_size(), wpt);
+    auto tg = std::min(
+        kernel->maxTotalThreadsPerThreadgroup(), NS::UInteger(nthreads));
+    enc->dispatchThreads(MTL::Size(nthreads, 1, 1), MTL::Size(tg, 1, 1));
+  };
+  return tuned_work_per_thread(
+      d, s, key, {1, work_per_thread}, encode_one, work_per_thread);
+}
+
+} // namespace
+
 void binary_op_gpu_inplace(
     const std::vector<array>& inputs,
     std::vector<array>& outputs,
@@ -99,9 +150,15 @@ void binary_op_gpu_inplace(
     large = out.data_size() > UINT32_MAX;
     work_per_thread = get_work_per_thread(a.dtype(), out.data_size());
   }
+  auto& d = metal::device(s.device);
+  if (bopt != BinaryOpType::General && bopt != BinaryOpType::ScalarScalar &&
+      !large && work_per_thread > 1 && outputs.size() == 1 &&
+      elementwise_tuning_enabled()) {
+    work_per_thread = tuned_binary_work_per_thread(
+        d, s, a, b, out, bopt, op, work_per_thread);
+  }
   std::string kernel_name =
       get_kernel_name(bopt, op, a, large, shape.size(), work_per_thread);
-  auto& d = metal::device(s.device);
 
   auto kernel = outputs.size() == 2
       ? get_binary_two_kernel(d, kernel_name, a.dtype(), out.dtype(), op)
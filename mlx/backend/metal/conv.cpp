@@ -791,9 +791,13 @@ void dispatch_conv_2D_gpu(
     return winograd_conv_2D_gpu(s, d, in, wt, out, conv_params, copies);
   }
 
-  // Direct to implicit gemm conv
-  if (is_idil_one && (conv_params.C <= 4 || conv_params.C % 16 == 0) &&
-      (conv_params.O <= 16 || conv_params.O % 16 == 0)) {
+  // Direct to implicit gemm conv. Small input channel counts always take
+  // the channel specialized implicit gemm since the explicit gemm
+  // fallback pays for an im2col copy first.
+  if (is_idil_one &&
+      (conv_params.C <= 4 ||
+       (conv_params.C % 16 == 0 &&
+        (conv_params.O <= 16 || conv_params.O % 16 == 0)))) {
     return implicit_gemm_conv_2D_gpu(s, d, in, wt, out, conv_params);
   }
 
@@ -6,6 +6,7 @@
 #include "mlx/backend/common/compiled.h"
 #include "mlx/backend/gpu/copy.h"
 #include "mlx/backend/metal/jit/includes.h"
+#include "mlx/backend/metal/metal.h"
 #include "mlx/backend/metal/utils.h"
 #include "mlx/fast.h"
 #include "mlx/fast_primitives.h"
@@ -22,6 +23,20 @@ static CustomKernelCache& cache() {
   return cache_;
 };
 
+// Build the library preamble for a custom kernel. Kernels that refer to the
+// steel namespace additionally get the steel gemm building blocks
+// (BlockLoader, BlockMMA, and friends) so fused kernels can use the
+// library's gemm tiles instead of hand rolling tile loads. Detected from
+// the assembled source the same way the shape/strides/ndim bindings and
+// attributes are.
+static std::string preamble_for(const std::string& kernel_source) {
+  std::string preamble = metal::utils();
+  if (kernel_source.find("steel::") != std::string::npos) {
+    preamble += metal::gemm();
+  }
+  return preamble;
+}
+
 std::string write_signature(
     std::string func_name,
     const std::string& header,
@@ -324,6 +339,194 @@ CustomKernelFunction metal_kernel(
   };
 }
 
+PrecompiledCustomKernelFunction precompile_metal_kernel(
+    const std::string& name,
+    const std::vector<std::string>& input_names,
+    const std::vector<Dtype>& input_dtypes,
+    const std::vector<int>& input_ndims,
+    const std::vector<std::string>& output_names,
+    const std::vector<Dtype>& output_dtypes,
+    const std::string& source,
+    const std::string& header /* = "" */,
+    const std::vector<std::pair<std::string, TemplateArg>>&
+        template_args /* = {} */,
+    bool ensure_row_contiguous /* = true */,
+    bool atomic_outputs /* = false */) {
+  if (output_names.empty()) {
+    throw std::invalid_argument(
+        "[precompile_metal_kernel] Must specify at least one output.");
+  }
+  if (input_dtypes.size() != input_names.size() ||
+      input_ndims.size() != input_names.size()) {
+    throw std::invalid_argument(
+        "[precompile_metal_kernel] `input_dtypes` and `input_ndims` must "
+        "match `input_names` in size.");
+  }
+  if (output_dtypes.size() != output_names.size()) {
+    throw std::invalid_argument(
+        "[precompile_metal_kernel] `output_dtypes` must match `output_names` "
+        "in size.");
+  }
+
+  std::vector<CustomKernelShapeInfo> shape_infos;
+  for (auto& n : input_names) {
+    CustomKernelShapeInfo shape_info;
+    shape_info.shape = source.find(n + "_shape") != std::string::npos;
+    shape_info.strides = source.find(n + "_strides") != std::string::npos;
+    shape_info.ndim = source.find(n + "_ndim") != std::string::npos;
+    shape_infos.push_back(shape_info);
+  }
+  const std::vector<std::pair<std::string, std::string>> metal_attributes = {
+      {"dispatch_quadgroups_per_threadgroup", "uint"},
+      {"dispatch_simdgroups_per_threadgroup", "uint"},
+      {"dispatch_threads_per_threadgroup", "uint3"},
+      {"grid_origin", "uint3"},
+      {"grid_size", "uint3"},
+      {"quadgroup_index_in_threadgroup", "uint"},
+      {"quadgroups_per_threadgroup", "uint"},
+      {"simdgroup_index_in_threadgroup", "uint"},
+      {"simdgroups_per_threadgroup", "uint"},
+      {"thread_execution_width", "uint"},
+      {"thread_index_in_quadgroup", "uint"},
+      {"thread_index_in_simdgroup", "uint"},
+      {"thread_index_in_threadgroup", "uint"},
+      {"thread_position_in_grid", "uint3"},
+      {"thread_position_in_threadgroup", "uint3"},
+      {"threadgroup_position_in_grid", "uint3"},
+      {"threadgroups_per_grid", "uint3"},
+      {"threads_per_grid", "uint3"},
+      {"threads_per_simdgroup", "uint"},
+      {"threads_per_threadgroup", "uint3"},
+  };
+
+  std::vector<std::string> attributes;
+  for (const auto& [attr, dtype] : metal_attributes) {
+    if (source.find(attr) != std::string::npos) {
+      attributes.push_back("  " + dtype + " " + attr + " [[" + attr + "]]");
+    }
+  }
+
+  // Bind the template arguments into the kernel name once.
+  std::string kernel_name = "custom_kernel_" + name;
+  std::string template_def = "";
+  if (!template_args.empty()) {
+    std::regex disallowed_chars("\\<|\\>|(, )");
+    template_def = write_template(template_args);
+    auto template_hash = std::regex_replace(template_def, disallowed_chars, "_");
+    template_hash.pop_back();
+    kernel_name += "_";
+    kernel_name += template_hash;
+  }
+
+  // Placeholder inputs carrying just the dtype and rank drive the signature
+  // generation. Sized past the constant-address-space cutoff so non-scalar
+  // inputs always bind as device pointers.
+  constexpr int max_constant_array_size = 8;
+  std::vector<array> sig_inputs;
+  for (int i = 0; i < input_names.size(); ++i) {
+    sig_inputs.push_back(array(
+        Shape(input_ndims[i], max_constant_array_size),
+        input_dtypes[i],
+        nullptr,
+        {}));
+  }
+
+  std::string kernel_source = write_signature(
+      kernel_name,
+      header,
+      source,
+      input_names,
+      sig_inputs,
+      output_names,
+      output_dtypes,
+      template_args,
+      attributes,
+      shape_infos,
+      atomic_outputs);
+
+  if (!template_args.empty()) {
+    template_def = kernel_name + template_def;
+    kernel_source += "\ntemplate [[host_name(\"";
+    kernel_source += kernel_name;
+    kernel_source += "\")]] [[kernel]] decltype(";
+    kernel_source += template_def;
+    kernel_source += ") ";
+    kernel_source += template_def;
+    kernel_source += ";\n";
+  }
+
+  // Register the source and build the pipeline eagerly so the first eval
+  // hits a warm cache.
+  cache().libraries[kernel_name] = kernel_source;
+  if (metal::is_available()) {
+    auto& d = metal::device(Device(Device::gpu));
+    auto lib = d.get_library(kernel_name, [&] {
+      return preamble_for(kernel_source) + kernel_source;
+    });
+    d.get_kernel(kernel_name, lib);
+  }
+
+  return [=,
+          shape_infos = std::move(shape_infos),
+          kernel_name = std::move(kernel_name),
+          kernel_source = std::move(kernel_source)](
+             const std::vector<array>& inputs,
+             const std::vector<Shape>& output_shapes,
+             std::tuple<int, int, int> grid,
+             std::tuple<int, int, int> threadgroup,
+             std::optional<float> init_value = std::nullopt,
+             StreamOrDevice s_ = {}) {
+    if (inputs.size() != input_names.size()) {
+      std::ostringstream msg;
+      msg << "[precompile_metal_kernel] Expected `inputs` to have size "
+          << input_names.size() << " but got size " << inputs.size() << ".";
+      throw std::invalid_argument(msg.str());
+    }
+    for (int i = 0; i < inputs.size(); ++i) {
+      if (inputs[i].dtype() != input_dtypes[i] ||
+          inputs[i].ndim() != input_ndims[i]) {
+        std::ostringstream msg;
+        msg << "[precompile_metal_kernel] Input " << i
+            << " was bound with dtype " << input_dtypes[i] << " and "
+            << input_ndims[i] << " dimensions but got dtype "
+            << inputs[i].dtype() << " with " << inputs[i].ndim()
+            << " dimensions.";
+        throw std::invalid_argument(msg.str());
+      }
+    }
+    if (output_shapes.size() != output_names.size()) {
+      std::ostringstream msg;
+      msg << "[precompile_metal_kernel] Expected `output_shapes` to have size "
+          << output_names.size() << " but got size " << output_shapes.size()
+          << ".";
+      throw std::invalid_argument(msg.str());
+    }
+
+    auto s = to_stream(s_);
+    if (s.device != Device::gpu) {
+      throw std::invalid_argument(
+          "[precompile_metal_kernel] Only supports the GPU.");
+    }
+
+    return array::make_arrays(
+        std::vector<Shape>(output_shapes),
+        std::vector<Dtype>(output_dtypes),
+        std::make_shared<CustomKernel>(
+            s,
+            kernel_name,
+            kernel_source,
+            grid,
+            threadgroup,
+            shape_infos,
+            ensure_row_contiguous,
+            init_value,
+            std::vector<ScalarArg>{},
+            false,
+            0),
+        inputs);
+  };
+}
+
 void CustomKernel::eval_gpu(
     const std::vector<array>& inputs,
     std::vector<array>& outputs) {
@@ -372,7 +575,8 @@ void CustomKernel::eval_gpu(
     }
   }
 
-  auto lib = d.get_library(name_, [this] { return metal::utils() + source_; });
+  auto lib =
+      d.get_library(name_, [this] { return preamble_for(source_) + source_; });
   auto kernel = d.get_kernel(name_, lib);
   auto& compute_encoder = d.get_command_encoder(s.index);
   compute_encoder.set_compute_pipeline_state(kernel);
@@ -1,5 +1,6 @@
 // Copyright © 2023-2024 Apple Inc.
 
+#include <algorithm>
 #include <cstdlib>
 #include <sstream>
 
@@ -11,6 +12,7 @@
 #include "mlx/backend/metal/device.h"
 #include "mlx/backend/metal/metal.h"
 #include "mlx/backend/metal/utils.h"
+#include "mlx/profiler.h"
 #include "mlx/utils.h"
 
 namespace mlx::core::metal {
@@ -287,8 +289,14 @@ void CommandEncoder::barrier() {
 
 Device::Device() {
   auto pool = new_scoped_memory_pool();
-  device_ = load_device();
-  default_library_ = load_default_library(device_);
+  {
+    detail::ScopedInitStage stage("metal_device");
+    device_ = load_device();
+  }
+  {
+    detail::ScopedInitStage stage("metal_default_library");
+    default_library_ = load_default_library(device_);
+  }
   arch_ = std::string(device_->architecture()->name()->utf8String());
   int ag_tens = arch_[arch_.size() - 3] - '0';
   int ag_ones = arch_[arch_.size() - 2] - '0';
@@ -318,6 +326,17 @@ Device::Device() {
   }
   max_ops_per_buffer_ = env::max_ops_per_buffer(max_ops_per_buffer_);
   max_mb_per_buffer_ = env::max_mb_per_buffer(max_mb_per_buffer_);
+
+  // Map a pre-warmed pipeline archive if one is provided. Failing to load
+  // it only costs the cold-start time it would have saved, so don't throw
+  // during device construction.
+  if (const char* archive = std::getenv("MLX_BINARY_ARCHIVE"); archive) {
+    detail::ScopedInitStage stage("metal_binary_archive");
+    try {
+      load_binary_archive(archive);
+    } catch (const std::runtime_error&) {
+    }
+  }
 }
 
 Device::~Device() {
@@ -329,6 +348,9 @@ Device::~Device() {
     }
   }
   stream_map_.clear();
+  if (binary_archive_) {
+    binary_archive_->release();
+  }
   device_->release();
 }
 
@@ -352,13 +374,33 @@ MTL::CommandQueue* Device::get_queue(Stream stream) {
 
 bool Device::command_buffer_needs_commit(int index) {
   auto& stream = get_stream_(index);
-  if (stream.buffer_ops > max_ops_per_buffer_ ||
-      (stream.buffer_sizes >> 20) > max_mb_per_buffer_) {
+  int max_ops = stream.max_ops >= 0 ? stream.max_ops : max_ops_per_buffer_;
+  int max_mb = stream.max_mb >= 0 ? stream.max_mb : max_mb_per_buffer_;
+  if (stream.latency_target_ms > 0) {
+    if (int budget = stream.auto_state->ops_budget.load(); budget > 0) {
+      max_ops = budget;
+    }
+  }
+  if (stream.buffer_ops > max_ops ||
+      (stream.buffer_sizes >> 20) > max_mb) {
     return true;
   }
   return false;
 }
 
+void Device::set_commit_policy(
+    int index,
+    int max_ops,
+    int max_mb,
+    float latency_target_ms) {
+  auto& stream = get_stream_(index);
+  stream.max_ops = max_ops;
+  stream.max_mb = max_mb;
+  stream.latency_target_ms = latency_target_ms;
+  stream.auto_state->ops_budget = 0;
+  stream.auto_state->avg_latency_ms = 0;
+}
+
 MTL::CommandBuffer* Device::get_command_buffer(int index) {
   auto& stream = get_stream_(index);
   if (stream.buffer == nullptr) {
@@ -375,6 +417,57 @@ MTL::CommandBuffer* Device::get_command_buffer(int index) {
 
 void Device::commit_command_buffer(int index) {
   auto& stream = get_stream_(index);
+  if (!stream.retained_buffers.empty()) {
+    stream.buffer->addCompletedHandler(
+        [buffers = std::move(stream.retained_buffers)](MTL::CommandBuffer*) {});
+    stream.retained_buffers.clear();
+  }
+  if (stream.latency_target_ms > 0 && stream.buffer_ops > 0) {
+    // Steer the ops budget toward the latency target: halve it when
+    // measured GPU time overshoots, double it when there is ample
+    // headroom. Multiplicative steps converge in a few buffers and stay
+    // stable across workload shifts (long training graphs grow the
+    // budget, interactive decode shrinks it).
+    stream.buffer->addCompletedHandler(
+        [state = stream.auto_state,
+         ops = stream.buffer_ops,
+         target = stream.latency_target_ms](MTL::CommandBuffer* cbuf) {
+          auto ms = static_cast<float>(
+              (cbuf->GPUEndTime() - cbuf->GPUStartTime()) * 1e3);
+          float avg = state->avg_latency_ms.load();
+          avg = avg > 0 ? 0.75f * avg + 0.25f * ms : ms;
+          state->avg_latency_ms.store(avg);
+          int budget = state->ops_budget.load();
+          if (budget <= 0) {
+            budget = ops;
+          }
+          if (avg > target) {
+            budget = std::max(budget / 2, 1);
+          } else if (avg < 0.5f * target) {
+            budget = std::min(budget * 2, 10000);
+          }
+          state->ops_budget.store(budget);
+        });
+  }
+  if (profiling_enabled()) {
+    // Record the device-side execution time of the whole command buffer
+    // along with the output bytes it wrote. The GPU timestamps are on a
+    // different clock than the dispatch events, so the event is placed at
+    // completion time minus its duration; durations and the implied GB/s
+    // are exact.
+    stream.buffer->addCompletedHandler(
+        [index, bytes = stream.buffer_sizes](MTL::CommandBuffer* cbuf) {
+          uint64_t duration_us = static_cast<uint64_t>(
+              (cbuf->GPUEndTime() - cbuf->GPUStartTime()) * 1e6);
+          uint64_t end_us = detail::profile_clock_us();
+          detail::record_profile_event(
+              "command_buffer",
+              index,
+              end_us > duration_us ? end_us - duration_us : 0,
+              duration_us,
+              bytes);
+        });
+  }
   stream.buffer->commit();
   stream.buffer->release();
   stream.buffer = nullptr;
@@ -382,6 +475,16 @@ void Device::commit_command_buffer(int index) {
   stream.buffer_sizes = 0;
 }
 
+void Device::retain_buffers(
+    int index,
+    std::unordered_set<std::shared_ptr<array::Data>> buffers) {
+  auto& retained = get_stream_(index).retained_buffers;
+  retained.insert(
+      retained.end(),
+      std::make_move_iterator(buffers.begin()),
+      std::make_move_iterator(buffers.end()));
+}
+
 void Device::add_temporary(array arr, int index) {
   get_stream_(index).temporaries.push_back(std::move(arr));
 }
@@ -575,7 +678,21 @@ MTL::ComputePipelineState* Device::get_kernel_(
   NS::Error* error = nullptr;
   MTL::ComputePipelineState* kernel;
 
-  if (mtl_function) {
+  if (mtl_function && binary_archive_) {
+    // Route creation through a descriptor so the pipeline is looked up in
+    // the archive (and added to it while capturing) instead of compiled
+    auto desc = MTL::ComputePipelineDescriptor::alloc()->init();
+    desc->setComputeFunction(const_cast<MTL::Function*>(mtl_function));
+    auto archives =
+        NS::Array::array(static_cast<NS::Object*>(binary_archive_));
+    desc->setBinaryArchives(archives);
+    if (capture_binary_archive_) {
+      binary_archive_->addComputePipelineFunctions(desc, &error);
+    }
+    kernel = device_->newComputePipelineState(
+        desc, MTL::PipelineOptionNone, nullptr, &error);
+    desc->release();
+  } else if (mtl_function) {
     kernel = device_->newComputePipelineState(mtl_function, &error);
   }
 
@@ -614,6 +731,14 @@ MTL::ComputePipelineState* Device::get_kernel_(
 
   // Compile kernel to compute pipeline
   NS::Error* error = nullptr;
+  if (binary_archive_) {
+    auto archives =
+        NS::Array::array(static_cast<NS::Object*>(binary_archive_));
+    desc->setBinaryArchives(archives);
+    if (capture_binary_archive_) {
+      binary_archive_->addComputePipelineFunctions(desc, &error);
+    }
+  }
   auto kernel = device_->newComputePipelineState(
       desc, MTL::PipelineOptionNone, nullptr, &error);
 
@@ -669,6 +794,74 @@ void Device::clear_library(const std::string& name) {
   }
 }
 
+void Device::load_binary_archive(const std::string& path) {
+  auto pool = new_scoped_memory_pool();
+  auto desc = MTL::BinaryArchiveDescriptor::alloc()->init();
+  desc->setUrl(NS::URL::fileURLWithPath(
+      NS::String::string(path.c_str(), NS::UTF8StringEncoding)));
+  NS::Error* error = nullptr;
+  auto archive = device_->newBinaryArchive(desc, &error);
+  desc->release();
+  if (!archive) {
+    std::ostringstream msg;
+    msg << "[metal::Device] Unable to load binary archive from <" << path
+        << ">\n";
+    if (error) {
+      msg << error->localizedDescription()->utf8String() << "\n";
+    }
+    throw std::runtime_error(msg.str());
+  }
+  std::unique_lock wlock(kernel_mtx_);
+  if (binary_archive_) {
+    binary_archive_->release();
+  }
+  binary_archive_ = archive;
+}
+
+void Device::start_binary_archive_capture() {
+  auto pool = new_scoped_memory_pool();
+  auto desc = MTL::BinaryArchiveDescriptor::alloc()->init();
+  NS::Error* error = nullptr;
+  auto archive = device_->newBinaryArchive(desc, &error);
+  desc->release();
+  if (!archive) {
+    std::ostringstream msg;
+    msg << "[metal::Device] Unable to create binary archive.\n";
+    if (error) {
+      msg << error->localizedDescription()->utf8String() << "\n";
+    }
+    throw std::runtime_error(msg.str());
+  }
+  std::unique_lock wlock(kernel_mtx_);
+  if (binary_archive_) {
+    binary_archive_->release();
+  }
+  binary_archive_ = archive;
+  capture_binary_archive_ = true;
+}
+
+void Device::save_binary_archive(const std::string& path) {
+  auto pool = new_scoped_memory_pool();
+  std::unique_lock wlock(kernel_mtx_);
+  if (!binary_archive_) {
+    throw std::runtime_error(
+        "[metal::Device] No binary archive to save. Call "
+        "start_binary_archive_capture first.");
+  }
+  NS::Error* error = nullptr;
+  auto url = NS::URL::fileURLWithPath(
+      NS::String::string(path.c_str(), NS::UTF8StringEncoding));
+  if (!binary_archive_->serializeToURL(url, &error)) {
+    std::ostringstream msg;
+    msg << "[metal::Device] Unable to serialize binary archive to <" << path
+        << ">\n";
+    if (error) {
+      msg << error->localizedDescription()->utf8String() << "\n";
+    }
+    throw std::runtime_error(msg.str());
+  }
+}
+
 MTL::LinkedFunctions* Device::get_linked_functions_(
     const std::vector<MTL::Function*>& funcs) {
   if (funcs.empty()) {
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <Metal/Metal.hpp>
+#include <atomic>
 #include <functional>
 #include <mutex>
 #include <shared_mutex>
@@ -120,6 +121,17 @@ struct Fence {
   MTL::Fence* fence;
 };
 
+// Auto-commit state updated from command buffer completion handlers,
+// which can outlive the stream during teardown, so it is shared rather
+// than embedded in DeviceStream.
+struct CommitAutoState {
+  // Ops budget derived from measured latency; 0 until the first buffer
+  // completes
+  std::atomic<int> ops_budget{0};
+  // Smoothed GPU execution time of recent command buffers
+  std::atomic<float> avg_latency_ms{0};
+};
+
 struct DeviceStream {
   DeviceStream(MTL::CommandQueue* queue) : queue(queue) {};
   ~DeviceStream() {
@@ -139,11 +151,22 @@ struct DeviceStream {
   int buffer_ops{0};
   size_t buffer_sizes{0};
 
+  // Per-stream commit policy (see Device::set_commit_policy). Negative
+  // budgets fall back to the device-wide defaults.
+  int max_ops{-1};
+  int max_mb{-1};
+  float latency_target_ms{0};
+  std::shared_ptr<CommitAutoState> auto_state{
+      std::make_shared<CommitAutoState>()};
+
   // The command encoder, fence, and temporaries are updated between command
   // encoders
   std::unique_ptr<CommandEncoder> encoder{nullptr};
   std::shared_ptr<Fence> fence;
   std::vector<array> temporaries;
+
+  // Buffers kept alive until the current command buffer completes
+  std::vector<std::shared_ptr<array::Data>> retained_buffers;
 };
 
 class Device {
@@ -172,6 +195,16 @@ class Device {
   MTL::CommandBuffer* get_command_buffer(int index);
   bool command_buffer_needs_commit(int index);
   void commit_command_buffer(int index);
+
+  // Set the commit policy for the stream. Negative budgets restore the
+  // device-wide defaults. A positive latency target enables auto mode:
+  // the ops budget is tuned so command buffers complete in roughly
+  // `latency_target_ms` of GPU time.
+  void set_commit_policy(
+      int index,
+      int max_ops,
+      int max_mb,
+      float latency_target_ms);
   CommandEncoder& get_command_encoder(int index);
   void end_encoding(int index);
 
@@ -185,6 +218,16 @@ class Device {
 
   void clear_library(const std::string& name);
 
+  // Use a previously serialized binary archive for pipeline creation so
+  // pipelines built on an earlier run load instead of compiling
+  void load_binary_archive(const std::string& path);
+
+  // Start adding newly built pipelines to an in-memory binary archive
+  void start_binary_archive_capture();
+
+  // Serialize the captured archive to `path`
+  void save_binary_archive(const std::string& path);
+
   MTL::ComputePipelineState* get_kernel(
       const std::string& base_name,
       MTL::Library* mtl_lib,
@@ -205,6 +248,13 @@ class Device {
   void add_temporary(array arr, int index);
   void add_temporaries(std::vector<array> arrays, int index);
 
+  // Keep buffers alive until the stream's current command buffer
+  // completes; attached as a single completion handler at commit instead
+  // of one handler per op
+  void retain_buffers(
+      int index,
+      std::unordered_set<std::shared_ptr<array::Data>> buffers);
+
   void set_residency_set(const MTL::ResidencySet* residency_set);
 
  private:
@@ -255,6 +305,8 @@ class Device {
       std::unordered_map<std::string, MTL::ComputePipelineState*>>
       library_kernels_;
   const MTL::ResidencySet* residency_set_{nullptr};
+  MTL::BinaryArchive* binary_archive_{nullptr};
+  bool capture_binary_archive_{false};
   std::string arch_;
   int arch_gen_;
   int max_ops_per_buffer_;
@@ -0,0 +1,137 @@
+// Copyright © 2025 Apple Inc.
+
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
+#include "mlx/backend/metal/elementwise_tuner.h"
+#include "mlx/utils.h"
+#include "mlx/version.h"
+
+namespace mlx::core {
+
+namespace {
+
+// Measured winners, keyed by kernel family, dtypes, and size bucket.
+// Entries are loaded from the cache file once per process and appended
+// as new keys are measured, so the timing cost is only paid by the
+// first run on a given machine.
+struct TuningCache {
+  TuningCache() {
+    std::filesystem::path dir;
+    if (auto c = std::getenv("MLX_GEMM_TUNE_CACHE_DIR"); c) {
+      dir = c;
+    } else {
+      dir =
+          std::filesystem::temp_directory_path() / "mlx" / version() / "tuning";
+    }
+    std::error_code error;
+    std::filesystem::create_directories(dir, error);
+    if (error) {
+      return;
+    }
+    file_ = dir / "elementwise.txt";
+    std::ifstream f(file_);
+    std::string line;
+    while (std::getline(f, line)) {
+      std::istringstream is(line);
+      std::string key;
+      int wpt;
+      if (is >> key >> wpt) {
+        winners_[key] = wpt;
+      }
+    }
+  }
+
+  std::optional<int> find(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (auto it = winners_.find(key); it != winners_.end()) {
+      return it->second;
+    }
+    return std::nullopt;
+  }
+
+  void insert(const std::string& key, int wpt) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    winners_[key] = wpt;
+    if (!file_.empty()) {
+      std::ofstream f(file_, std::ios::app);
+      f << key << " " << wpt << std::endl;
+    }
+  }
+
+ private:
+  std::unordered_map<std::string, int> winners_;
+  std::mutex mtx_;
+  std::filesystem::path file_;
+};
+
+TuningCache& tuning_cache() {
+  static TuningCache* cache = new TuningCache();
+  return *cache;
+}
+
+} // namespace
+
+bool elementwise_tuning_enabled() {
+  static bool enabled = env::get_var("MLX_ELEMENTWISE_TUNE", 0);
+  return enabled;
+}
+
+int tuned_work_per_thread(
+    metal::Device& d,
+    const Stream& s,
+    const std::string& key,
+    const std::vector<int>& candidates,
+    const std::function<void(int, MTL::ComputeCommandEncoder*)>& encode_one,
+    int fallback) {
+  if (auto winner = tuning_cache().find(key)) {
+    return *winner;
+  }
+
+  // Benchmark each candidate in its own command buffer so the GPU start
+  // and end times bracket just that variant. The dispatches read
+  // whatever is in the input buffers which may not be the final values
+  // yet; elementwise kernels are bandwidth bound so the timing is the
+  // same either way.
+  constexpr int iterations = 5;
+  auto* queue = d.get_queue(s);
+  int best = fallback;
+  double best_time = std::numeric_limits<double>::infinity();
+  for (auto candidate : candidates) {
+    auto* cb = queue->commandBuffer();
+    if (!cb) {
+      return fallback;
+    }
+    auto* enc = cb->computeCommandEncoder();
+    for (int i = 0; i < iterations; ++i) {
+      if (i > 0) {
+        enc->memoryBarrier(MTL::BarrierScopeBuffers);
+      }
+      encode_one(candidate, enc);
+    }
+    enc->endEncoding();
+    cb->commit();
+    cb->waitUntilCompleted();
+    if (cb->status() != MTL::CommandBufferStatusCompleted) {
+      continue;
+    }
+    double elapsed = cb->GPUEndTime() - cb->GPUStartTime();
+    if (elapsed < best_time) {
+      best_time = elapsed;
+      best = candidate;
+    }
+  }
+  if (!std::isfinite(best_time)) {
+    return fallback;
+  }
+  tuning_cache().insert(key, best);
+  return best;
+}
+
+} // namespace mlx::core
@@ -0,0 +1,41 @@
+// Copyright © 2025 Apple Inc.
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "mlx/backend/metal/device.h"
+
+namespace mlx::core {
+
+// Measured work-per-thread selection is off unless MLX_ELEMENTWISE_TUNE
+// is set
+bool elementwise_tuning_enabled();
+
+// Size bucket so one measurement covers every size in the same power of
+// two; the optimum shifts with size as well as dtype and device.
+inline int work_size_bucket(size_t n) {
+  int b = 0;
+  while (n >>= 1) {
+    b++;
+  }
+  return b;
+}
+
+// The winning work-per-thread for one elementwise kernel key. The first
+// call for a key benchmarks every candidate with encode_one on the
+// device and persists the winner like the gemm tile cache. The
+// candidates must be work-per-thread values the kernel family has
+// instantiations for. Returns `fallback` when the key could not be
+// measured.
+int tuned_work_per_thread(
+    metal::Device& d,
+    const Stream& s,
+    const std::string& key,
+    const std::vector<int>& candidates,
+    const std::function<void(int, MTL::ComputeCommandEncoder*)>& encode_one,
+    int fallback);
+
+} // namespace mlx::core
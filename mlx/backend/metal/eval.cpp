@@ -29,6 +29,20 @@ inline void check_error(MTL::CommandBuffer* cbuf) {
   }
 }
 
+// Record a failed command buffer against the stream. Used from
+// completion handlers, which run on driver threads where throwing would
+// terminate the process; the error is surfaced through the stream's
+// error state and handler instead (see take_stream_error).
+inline void record_error(MTL::CommandBuffer* cbuf, const Stream& s) {
+  if (cbuf->status() == MTL::CommandBufferStatusError) {
+    std::ostringstream msg;
+    msg << "[METAL] Command buffer execution failed: "
+        << cbuf->error()->localizedDescription()->utf8String();
+    scheduler::record_stream_error(
+        s.index, std::make_exception_ptr(std::runtime_error(msg.str())));
+  }
+}
+
 void eval(array& arr) {
   auto pool = metal::new_scoped_memory_pool();
   auto s = arr.primitive().stream();
@@ -59,21 +73,21 @@ void eval(array& arr) {
     buffers.erase(it);
   }
 
+  // Hold the buffers on the stream rather than in a per-op completion
+  // handler; a single handler attached at commit releases them all. This
+  // keeps the CPU-side cost of encoding an op constant when many small
+  // dispatches accumulate in one command buffer.
+  d.retain_buffers(s.index, std::move(buffers));
+
   if (d.command_buffer_needs_commit(s.index)) {
     d.end_encoding(s.index);
     scheduler::notify_new_task(s);
-    command_buffer->addCompletedHandler(
-        [s, buffers = std::move(buffers)](MTL::CommandBuffer* cbuf) {
-          scheduler::notify_task_completion(s);
-          check_error(cbuf);
-        });
+    command_buffer->addCompletedHandler([s](MTL::CommandBuffer* cbuf) {
+      scheduler::notify_task_completion(s);
+      record_error(cbuf, s);
+    });
     d.commit_command_buffer(s.index);
     d.get_command_buffer(s.index);
-  } else {
-    command_buffer->addCompletedHandler(
-        [s, buffers = std::move(buffers)](MTL::CommandBuffer* cbuf) {
-          check_error(cbuf);
-        });
   }
 }
 
@@ -82,7 +96,8 @@ void finalize(Stream s) {
   auto& d = metal::device(s.device);
   auto cb = d.get_command_buffer(s.index);
   d.end_encoding(s.index);
-  cb->addCompletedHandler([s](MTL::CommandBuffer* cbuf) { check_error(cbuf); });
+  cb->addCompletedHandler(
+      [s](MTL::CommandBuffer* cbuf) { record_error(cbuf, s); });
   d.commit_command_buffer(s.index);
   d.get_command_buffer(s.index);
 }
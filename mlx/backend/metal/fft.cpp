@@ -1,4 +1,5 @@
 // Copyright © 2024 Apple Inc.
+#include <algorithm>
 #include <cassert>
 #include <complex>
 #include <map>
@@ -86,6 +87,26 @@ int next_fast_n(int n) {
   return next_power_of_2(n);
 }
 
+// Whether every prime factor of n is a supported radix so an
+// n-point FFT is Stockham decomposable.
+bool is_radix_composite(int n) {
+  std::set<int> supported_primes = {2, 3, 5, 7, 11, 13};
+  for (int factor : prime_factors(n)) {
+    if (supported_primes.find(factor) == supported_primes.end()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Split n into n1 * n2 for a four step FFT so that both sub-FFTs
+// run on device. Returns (-1, -1) when no valid split exists.
+// Defined after `compute_elems_per_thread` since validating a half
+// needs the thread mapping for its Stockham plan.
+std::pair<int, int> four_step_split(int n);
+// Smallest m >= n that four step decomposes into two Stockham passes.
+int next_four_step_n(int n);
+
 std::vector<int> plan_stockham_fft(int n) {
   auto radices = supported_radices();
   std::vector<int> plan(radices.size(), 0);
@@ -110,7 +131,7 @@ std::vector<int> plan_stockham_fft(int n) {
   throw std::runtime_error("Unplannable");
 }
 
-FFTPlan plan_fft(int n) {
+FFTPlan plan_fft(int n, bool real = false) {
   auto radices = supported_radices();
   std::set<int> radices_set(radices.begin(), radices.end());
 
@@ -129,9 +150,21 @@ FFTPlan plan_fft(int n) {
     plan.n1 = n / plan.n2;
     return plan;
   } else if (n > MAX_STOCKHAM_FFT_SIZE) {
-    // Otherwise we use a multi-upload Bluestein's
     plan.four_step = true;
-    plan.bluestein_n = next_fast_n(2 * n - 1);
+    // Other large composite sizes also decompose into two on-device
+    // Stockham passes. The strided real io assumes power of 2 layouts
+    // so only complex transforms take this path.
+    if (!real) {
+      auto [n1, n2] = four_step_split(n);
+      if (n1 != -1) {
+        plan.n1 = n1;
+        plan.n2 = n2;
+        return plan;
+      }
+    }
+    // Otherwise we use a multi-upload Bluestein's padded to the
+    // nearest four step decomposable size to stay on device.
+    plan.bluestein_n = next_four_step_n(2 * n - 1);
     return plan;
   }
 
@@ -228,6 +261,58 @@ int compute_elems_per_thread(FFTPlan plan) {
   return radix_vec[1];
 }
 
+// Whether n can be one half of a four step decomposition. Each half
+// must fit in threadgroup memory alongside the MIN_COALESCE_WIDTH
+// batching the four step kernels use, and must be evenly covered by
+// its threads since the strided io does no bounds handling.
+bool valid_four_step_half(int n) {
+  if (n > MAX_STOCKHAM_FFT_SIZE / MIN_COALESCE_WIDTH ||
+      n % MIN_COALESCE_WIDTH != 0 || !is_radix_composite(n)) {
+    return false;
+  }
+  return n % compute_elems_per_thread(plan_fft(n)) == 0;
+}
+
+std::pair<int, int> four_step_split(int n) {
+  // Mirror the power of 2 heuristic: larger rows for larger n.
+  int target_n2 = n > 65536 ? 1024 : 64;
+  int max_size = MAX_STOCKHAM_FFT_SIZE / MIN_COALESCE_WIDTH;
+  int best_n2 = -1;
+  for (int n2 = std::max(n / max_size, 2); n2 <= max_size; n2++) {
+    if (n % n2 == 0 && valid_four_step_half(n2) &&
+        valid_four_step_half(n / n2) &&
+        (best_n2 == -1 ||
+         std::abs(n2 - target_n2) < std::abs(best_n2 - target_n2))) {
+      best_n2 = n2;
+    }
+  }
+  if (best_n2 == -1) {
+    return {-1, -1};
+  }
+  return {n / best_n2, best_n2};
+}
+
+int next_four_step_n(int n) {
+  int max_size = MAX_STOCKHAM_FFT_SIZE / MIN_COALESCE_WIDTH;
+  std::vector<int> halves;
+  for (int i = 2; i <= max_size; i++) {
+    if (valid_four_step_half(i)) {
+      halves.push_back(i);
+    }
+  }
+  // The next power of 2 always splits so padding never degrades
+  // beyond the power of 2 Bluestein's.
+  int best = next_power_of_2(n);
+  for (int n1 : halves) {
+    auto it =
+        std::lower_bound(halves.begin(), halves.end(), (n + n1 - 1) / n1);
+    if (it != halves.end() && n1 * (*it) < best) {
+      best = n1 * (*it);
+    }
+  }
+  return best;
+}
+
 // Rader
 int mod_exp(int x, int y, int n) {
   int out = 1;
@@ -583,7 +668,7 @@ void fft_op(
     out_data_size = out_data_size / in.shape(axis) * out.shape(axis);
   }
 
-  auto plan = plan_fft(n);
+  auto plan = plan_fft(n, real);
   if (plan.four_step) {
     four_step_fft(in, out, axis, inverse, real, plan, copies, s, inplace);
     d.add_temporaries(std::move(copies), s.index);
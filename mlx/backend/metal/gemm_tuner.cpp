@@ -0,0 +1,151 @@
+// Copyright © 2025 Apple Inc.
+
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+#include "mlx/backend/metal/gemm_tuner.h"
+#include "mlx/utils.h"
+#include "mlx/version.h"
+
+namespace mlx::core {
+
+namespace {
+
+// Tile shapes worth trying. Every entry is a specialization the fused
+// kernel supports and which fits threadgroup memory at float32.
+const std::vector<GemmTileConfig>& gemm_tile_candidates() {
+  static std::vector<GemmTileConfig> candidates = {
+      {64, 64, 16, 2, 2},
+      {64, 64, 16, 1, 2},
+      {64, 32, 32, 2, 2},
+      {64, 32, 16, 2, 2},
+      {32, 64, 16, 1, 2},
+      {32, 32, 16, 2, 2},
+  };
+  return candidates;
+}
+
+// Measured winners, keyed by the gemm problem. Entries are loaded from the
+// cache file once per process and appended to it as new keys are measured
+// so the timing cost is only ever paid by the first run.
+struct TuningCache {
+  TuningCache() {
+    std::filesystem::path dir;
+    if (auto c = std::getenv("MLX_GEMM_TUNE_CACHE_DIR"); c) {
+      dir = c;
+    } else {
+      dir =
+          std::filesystem::temp_directory_path() / "mlx" / version() / "tuning";
+    }
+    std::error_code error;
+    std::filesystem::create_directories(dir, error);
+    if (error) {
+      return;
+    }
+    file_ = dir / "steel_gemm_fused.txt";
+    std::ifstream f(file_);
+    std::string line;
+    while (std::getline(f, line)) {
+      std::istringstream is(line);
+      std::string key;
+      GemmTileConfig c;
+      if (is >> key >> c.bm >> c.bn >> c.bk >> c.wm >> c.wn) {
+        winners_[key] = c;
+      }
+    }
+  }
+
+  std::optional<GemmTileConfig> find(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (auto it = winners_.find(key); it != winners_.end()) {
+      return it->second;
+    }
+    return std::nullopt;
+  }
+
+  void insert(const std::string& key, const GemmTileConfig& c) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    winners_[key] = c;
+    if (!file_.empty()) {
+      std::ofstream f(file_, std::ios::app);
+      f << key << " " << c.bm << " " << c.bn << " " << c.bk << " " << c.wm
+        << " " << c.wn << std::endl;
+    }
+  }
+
+ private:
+  std::unordered_map<std::string, GemmTileConfig> winners_;
+  std::mutex mtx_;
+  std::filesystem::path file_;
+};
+
+TuningCache& tuning_cache() {
+  static TuningCache* cache = new TuningCache();
+  return *cache;
+}
+
+} // namespace
+
+bool gemm_tuning_enabled() {
+  static bool enabled = env::get_var("MLX_GEMM_TUNE", 0);
+  return enabled;
+}
+
+std::optional<GemmTileConfig> gemm_tuned_tiles(
+    metal::Device& d,
+    const Stream& s,
+    const std::string& key,
+    const std::function<
+        void(const GemmTileConfig&, MTL::ComputeCommandEncoder*)>&
+        encode_one) {
+  if (auto winner = tuning_cache().find(key)) {
+    return winner;
+  }
+
+  // Benchmark each candidate in its own command buffer so the GPU start
+  // and end times bracket just that tile shape. The dispatches read
+  // whatever is in the input buffers which may not be the final values
+  // yet; the arithmetic takes the same time either way.
+  constexpr int iterations = 5;
+  auto* queue = d.get_queue(s);
+  GemmTileConfig best{};
+  double best_time = std::numeric_limits<double>::infinity();
+  for (auto& candidate : gemm_tile_candidates()) {
+    auto* cb = queue->commandBuffer();
+    if (!cb) {
+      return std::nullopt;
+    }
+    auto* enc = cb->computeCommandEncoder();
+    for (int i = 0; i < iterations; ++i) {
+      if (i > 0) {
+        enc->memoryBarrier(MTL::BarrierScopeBuffers);
+      }
+      encode_one(candidate, enc);
+    }
+    enc->endEncoding();
+    cb->commit();
+    cb->waitUntilCompleted();
+    if (cb->status() != MTL::CommandBufferStatusCompleted) {
+      continue;
+    }
+    double elapsed = cb->GPUEndTime() - cb->GPUStartTime();
+    if (elapsed < best_time) {
+      best_time = elapsed;
+      best = candidate;
+    }
+  }
+  if (!std::isfinite(best_time)) {
+    return std::nullopt;
+  }
+  tuning_cache().insert(key, best);
+  return best;
+}
+
+} // namespace mlx::core
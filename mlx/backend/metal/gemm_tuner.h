@@ -0,0 +1,36 @@
+// Copyright © 2025 Apple Inc.
+
+#pragma once
+
+#include <functional>
+#include <optional>
+#include <string>
+
+#include "mlx/backend/metal/device.h"
+
+namespace mlx::core {
+
+// A candidate threadgroup tile for the fused steel gemm
+struct GemmTileConfig {
+  int bm;
+  int bn;
+  int bk;
+  int wm;
+  int wn;
+};
+
+// Measured tile selection is off unless MLX_GEMM_TUNE is set
+bool gemm_tuning_enabled();
+
+// The winning tile configuration for one gemm key. The first call for a
+// key benchmarks every candidate with encode_one on the device and
+// persists the winner to disk so later processes skip the measurement.
+// Returns nullopt when the key could not be measured.
+std::optional<GemmTileConfig> gemm_tuned_tiles(
+    metal::Device& d,
+    const Stream& s,
+    const std::string& key,
+    const std::function<
+        void(const GemmTileConfig&, MTL::ComputeCommandEncoder*)>& encode_one);
+
+} // namespace mlx::core
@@ -76,8 +76,22 @@ void hadamard_mn_contiguous(
   float scale_n2 = (m == 1) ? scale : 1.0;
   float scale_m = scale;
 
+  // When m > 1 and the whole m*n vector fits in one threadgroup, fuse the
+  // 2^k stage and the size m codelet into a single launch.
+  bool fuse_nm = m > 1 && n1 == 1 &&
+      m * (n2 / max_radix_2) <= MAX_HADAMARD_THREADS_PER_GROUP &&
+      m * n2 * static_cast<int>(x.itemsize()) <= 32768;
+
+  // Batch multiple short contiguous transforms per threadgroup so that
+  // launch overhead and threadgroup occupancy don't dominate for small n
+  int rows_n2 = std::max(
+      std::min(
+          MAX_HADAMARD_THREADS_PER_GROUP / (n2 / max_radix_2),
+          32768 / (n2 * static_cast<int>(x.itemsize()))),
+      1);
+
   // n2 is a row contiguous power of 2 hadamard transform
-  MTL::Size group_dims_n2(n2 / max_radix_2, 1, 1);
+  MTL::Size group_dims_n2(n2 / max_radix_2, rows_n2, 1);
   MTL::Size grid_dims_n2(n2 / max_radix_2, x.size() / n2, 1);
 
   // n1 is a strided power of 2 hadamard transform with stride n2
@@ -96,6 +110,22 @@ void hadamard_mn_contiguous(
   concatenate(kname, "hadamard_", n * m, "_", type_to_name(x));
   auto lib = d.get_library(kname, [&]() {
     std::string kernel;
+    if (fuse_nm) {
+      concatenate(
+          kernel,
+          metal::utils(),
+          gen_hadamard_codelet(m),
+          metal::hadamard(),
+          get_template_definition(
+              "nm" + kname,
+              "hadamard_nm",
+              get_type_string(x.dtype()),
+              n2,
+              m,
+              max_radix_2,
+              read_width_m));
+      return kernel;
+    }
     concatenate(
         kernel,
         metal::utils(),
@@ -107,7 +137,9 @@ void hadamard_mn_contiguous(
             get_type_string(x.dtype()),
             n2,
             max_radix_2,
-            read_width_n2));
+            read_width_n2,
+            /* stride = */ 1,
+            rows_n2));
     if (n1 > 1) {
       kernel += get_template_definition(
           "n1" + kname,
@@ -130,6 +162,20 @@ void hadamard_mn_contiguous(
     return kernel;
   });
 
+  // Launch the fused transform for m * n2
+  if (fuse_nm) {
+    auto& compute_encoder = d.get_command_encoder(s.index);
+    auto kernel = d.get_kernel("nm" + kname, lib);
+    compute_encoder.set_compute_pipeline_state(kernel);
+    compute_encoder.set_input_array(x, 0);
+    compute_encoder.set_output_array(y, 1);
+    compute_encoder.set_bytes(scale_m, 2);
+    MTL::Size group_dims_nm(n2 / max_radix_2, m, 1);
+    MTL::Size grid_dims_nm(n2 / max_radix_2, m, x.size() / (m * n2));
+    compute_encoder.dispatch_threads(grid_dims_nm, group_dims_nm);
+    return;
+  }
+
   // Launch the strided transform for n1
   if (n1 > 1) {
     auto& compute_encoder = d.get_command_encoder(s.index);
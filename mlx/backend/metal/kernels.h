@@ -189,6 +189,20 @@ MTL::ComputePipelineState* get_steel_gemm_segmented_kernel(
     int wm,
     int wn);
 
+MTL::ComputePipelineState* get_steel_gemm_streamk_kernel(
+    metal::Device& d,
+    const std::string& kernel_name,
+    const std::string& hash_name,
+    const metal::MTLFCList& func_consts,
+    const array& a,
+    bool transpose_a,
+    bool transpose_b,
+    int bm,
+    int bn,
+    int bk,
+    int wm,
+    int wn);
+
 MTL::ComputePipelineState* get_steel_conv_kernel(
     metal::Device& d,
     const std::string& kernel_name,
@@ -246,7 +246,8 @@ template <
     const int TM, /* Thread rows (in elements) */
     const int TN, /* Thread cols (in elements) */
     const bool kDoAxpby, /* Do out = alpha * out + beta * bias */
-    typename AccT = float>
+    typename AccT = float,
+    typename OutT = T>
 struct GEMVTKernel {
   MLX_MTL_CONST int threadsM = BM * SM;
   MLX_MTL_CONST int threadsN = BN * SN;
@@ -279,16 +280,16 @@ struct GEMVTKernel {
   MLX_MTL_CONST bool needs_tgp_reduction = BM > 1;
 
   static METAL_FUNC void run(
-      const device T* mat [[buffer(0)]],
-      const device T* in_vec [[buffer(1)]],
-      const device T* bias [[buffer(2)]],
-      device T* out_vec [[buffer(3)]],
-      const constant int& in_vec_size [[buffer(4)]],
-      const constant int& out_vec_size [[buffer(5)]],
-      const constant int& marix_ld [[buffer(6)]],
-      const constant float& alpha [[buffer(7)]],
-      const constant float& beta [[buffer(8)]],
-      const constant int& bias_stride [[buffer(14)]],
+      const device T* mat,
+      const device T* in_vec,
+      const device T* bias,
+      device OutT* out_vec,
+      const int in_vec_size,
+      const int out_vec_size,
+      const int marix_ld,
+      const float alpha,
+      const float beta,
+      const int bias_stride,
       threadgroup AccT* tgp_memory [[threadgroup(0)]],
       uint3 tid [[threadgroup_position_in_grid]],
       uint3 lid [[thread_position_in_threadgroup]],
@@ -411,7 +412,7 @@ struct GEMVTKernel {
               static_cast<T>(alpha) * static_cast<T>(result[j]) +
               static_cast<T>(beta) * bias[(out_col + j) * bias_stride];
         } else {
-          out_vec[out_col + j] = static_cast<T>(result[j]);
+          out_vec[out_col + j] = static_cast<OutT>(result[j]);
         }
       }
     }
@@ -736,6 +737,76 @@ instantiate_gemv_t_blocks(float32, float);
 instantiate_gemv_t_blocks(float16, half);
 instantiate_gemv_t_blocks(bfloat16, bfloat16_t); // clang-format on
 
+template <
+    typename T,
+    const int BM, /* Threadgroup rows (in simdgroups) */
+    const int BN, /* Threadgroup cols (in simdgroups) */
+    const int SM, /* Simdgroup rows (in threads) */
+    const int SN, /* Simdgroup cols (in threads) */
+    const int TM, /* Thread rows (in elements) */
+    const int TN> /* Thread cols (in elements) */
+[[kernel, max_total_threads_per_threadgroup(BM* BN * 32)]] void gemv_t_split_k(
+    const device T* mat [[buffer(0)]],
+    const device T* in_vec [[buffer(1)]],
+    const device T* bias [[buffer(2)]],
+    device float* out_vec [[buffer(3)]],
+    const constant int& in_vec_size [[buffer(4)]],
+    const constant int& out_vec_size [[buffer(5)]],
+    const constant int& marix_ld [[buffer(6)]],
+    const constant int& split_k_partition_size [[buffer(7)]],
+    uint3 tid [[threadgroup_position_in_grid]],
+    uint3 lid [[thread_position_in_threadgroup]],
+    uint simd_gid [[simdgroup_index_in_threadgroup]],
+    uint simd_lid [[thread_index_in_simdgroup]]) {
+  using gemv_kernel = GEMVTKernel<T, BM, BN, SM, SN, TM, TN, false, float, float>;
+  threadgroup float tgp_memory
+      [gemv_kernel::tgp_mem_size == 0 ? 1 : gemv_kernel::tgp_mem_size];
+
+  // Each block along z reduces one contiguous partition of the in_vec axis
+  // and writes float partials; steel_gemm_splitk_accum combines them
+  const int k_start = tid.z * split_k_partition_size;
+  const int k_size = min(in_vec_size - k_start, split_k_partition_size);
+
+  mat += int64_t(k_start) * marix_ld;
+  in_vec += k_start;
+  out_vec += tid.z * out_vec_size;
+
+  gemv_kernel::run(
+      mat,
+      in_vec,
+      bias,
+      out_vec,
+      k_size,
+      out_vec_size,
+      marix_ld,
+      1.0f,
+      0.0f,
+      0, // Not used
+      gemv_kernel::tgp_mem_size == 0 ? nullptr : tgp_memory,
+      tid,
+      lid,
+      simd_gid,
+      simd_lid);
+}
+
+// clang-format off
+#define instantiate_gemv_t_sk_helper(                          \
+    nm, itype, bm, bn, sm, sn, tm, tn)                         \
+  instantiate_kernel(                                          \
+    "gemv_t_split_k_" #nm "_bm" #bm "_bn" #bn "_sm" #sm        \
+       "_sn" #sn "_tm" #tm "_tn" #tn,                          \
+  gemv_t_split_k, itype, bm, bn, sm, sn, tm, tn)
+
+#define instantiate_gemv_t_sk_blocks(name, itype)           \
+  instantiate_gemv_t_sk_helper(name, itype, 1, 2, 8, 4, 4, 1) \
+  instantiate_gemv_t_sk_helper(name, itype, 1, 2, 8, 4, 4, 4) \
+  instantiate_gemv_t_sk_helper(name, itype, 1, 4, 8, 4, 4, 4) // clang-format on
+
+// clang-format off
+instantiate_gemv_t_sk_blocks(float32, float);
+instantiate_gemv_t_sk_blocks(float16, half);
+instantiate_gemv_t_sk_blocks(bfloat16, bfloat16_t); // clang-format on
+
 template <
     typename T,
     const int BM, /* Threadgroup rows (in simdgroups) */
@@ -26,19 +26,12 @@ METAL_FUNC void radix_func(thread float* x) {
   }
 }
 
-template <typename T, int N, int max_radix, int read_width, int stride = 1>
-[[kernel]] void hadamard_n(
-    const device T* in [[buffer(0)]],
-    device T* out [[buffer(1)]],
-    constant const float& scale,
-    uint3 elem [[thread_position_in_grid]],
-    uint3 grid [[threads_per_grid]]) {
-  // Compute a Hadamard transform of size N = 2^k
-  //
-  // Equivalent to:
-  //    from scipy.linalg import hadamard
-  //    y = hadamard(len(x)) @ x
-
+// Threadgroup cooperative Hadamard transform of a length N = 2^k vector
+// living in threadgroup memory. `i` indexes the N / max_radix threads
+// working on this vector; the barriers synchronize the whole threadgroup
+// so several vectors can be transformed in lockstep.
+template <typename T, int N, int max_radix>
+METAL_FUNC void hadamard_radix_n(threadgroup T* buf, short i) {
   constexpr short num_threads = N / max_radix;
   constexpr short logN = __builtin_ctz(N);
   constexpr short logR = __builtin_ctz(max_radix);
@@ -46,30 +39,6 @@ template <typename T, int N, int max_radix, int read_width, int stride = 1>
   constexpr short logFinal = logN % logR;
   constexpr short final_radix = 1 << (logFinal);
 
-  int batch_idx = elem.y * N * stride + elem.z;
-  short i = elem.x;
-
-  threadgroup T buf[N];
-
-  // Read values from device
-  if (stride == 1) {
-    STEEL_PRAGMA_UNROLL
-    for (short j = 0; j < max_radix / read_width; j++) {
-      short index = j * read_width * num_threads + i * read_width;
-      STEEL_PRAGMA_UNROLL
-      for (short r = 0; r < read_width; r++) {
-        buf[index + r] = in[batch_idx + index + r];
-      }
-    }
-  } else {
-    STEEL_PRAGMA_UNROLL
-    for (short j = 0; j < max_radix; j++) {
-      buf[j * num_threads + i] = in[batch_idx + (j * num_threads + i) * stride];
-    }
-  }
-
-  threadgroup_barrier(mem_flags::mem_threadgroup);
-
   float x[max_radix];
   short h = 1;
 
@@ -118,6 +87,59 @@ template <typename T, int N, int max_radix, int read_width, int stride = 1>
     }
     threadgroup_barrier(mem_flags::mem_threadgroup);
   }
+}
+
+template <
+    typename T,
+    int N,
+    int max_radix,
+    int read_width,
+    int stride = 1,
+    int rows = 1>
+[[kernel]] void hadamard_n(
+    const device T* in [[buffer(0)]],
+    device T* out [[buffer(1)]],
+    constant const float& scale,
+    uint3 elem [[thread_position_in_grid]],
+    uint3 grid [[threads_per_grid]],
+    uint3 loc [[thread_position_in_threadgroup]]) {
+  // Compute a Hadamard transform of size N = 2^k
+  //
+  // Equivalent to:
+  //    from scipy.linalg import hadamard
+  //    y = hadamard(len(x)) @ x
+  //
+  // When `rows` > 1 a threadgroup transforms `rows` independent vectors
+  // at once so small transforms still fill a reasonable threadgroup.
+
+  constexpr short num_threads = N / max_radix;
+
+  int batch_idx = elem.y * N * stride + elem.z;
+  short i = elem.x;
+
+  threadgroup T bufs[rows * N];
+  threadgroup T* buf = bufs + loc.y * N;
+
+  // Read values from device
+  if (stride == 1) {
+    STEEL_PRAGMA_UNROLL
+    for (short j = 0; j < max_radix / read_width; j++) {
+      short index = j * read_width * num_threads + i * read_width;
+      STEEL_PRAGMA_UNROLL
+      for (short r = 0; r < read_width; r++) {
+        buf[index + r] = in[batch_idx + index + r];
+      }
+    }
+  } else {
+    STEEL_PRAGMA_UNROLL
+    for (short j = 0; j < max_radix; j++) {
+      buf[j * num_threads + i] = in[batch_idx + (j * num_threads + i) * stride];
+    }
+  }
+
+  threadgroup_barrier(mem_flags::mem_threadgroup);
+
+  hadamard_radix_n<T, N, max_radix>(buf, i);
 
   // Write values to device
   if (stride == 1) {
@@ -180,3 +202,65 @@ template <typename T, int N, int M, int read_width>
     }
   }
 }
+
+template <typename T, int N, int M, int max_radix, int read_width>
+[[kernel]] void hadamard_nm(
+    const device T* in [[buffer(0)]],
+    device T* out [[buffer(1)]],
+    constant const float& scale,
+    uint3 elem [[thread_position_in_grid]],
+    uint3 loc [[thread_position_in_threadgroup]]) {
+  // Compute a Hadamard transform of size M*N where N = 2^k in a single
+  // launch: each threadgroup stages a full M*N vector in threadgroup
+  // memory, runs the 2^k stage on each of the M length-N chunks, then
+  // applies the size M codelet across the chunks before writing out.
+  // The accumulation order matches the two-launch hadamard_n/hadamard_m
+  // pipeline exactly, so the results are bitwise identical.
+
+  constexpr short num_threads = N / max_radix;
+  constexpr int total_threads = M * num_threads;
+
+  int batch_idx = elem.z * M * N;
+  short i = loc.x;
+  short c = loc.y;
+  int tid = c * num_threads + i;
+
+  threadgroup T buf[M * N];
+
+  // Cooperative read of the whole vector
+  for (int j = tid * read_width; j < M * N; j += total_threads * read_width) {
+    STEEL_PRAGMA_UNROLL
+    for (short r = 0; r < read_width; r++) {
+      buf[j + r] = in[batch_idx + j + r];
+    }
+  }
+
+  threadgroup_barrier(mem_flags::mem_threadgroup);
+
+  // 2^k stage on this thread's chunk
+  hadamard_radix_n<T, N, max_radix>(buf + c * N, i);
+
+  // Size M codelet across the chunks
+  for (int idx = tid; idx < N; idx += total_threads) {
+    float x[M];
+    STEEL_PRAGMA_UNROLL
+    for (short k = 0; k < M; k++) {
+      x[k] = buf[k * N + idx];
+    }
+    hadamard_radix_m(x);
+    STEEL_PRAGMA_UNROLL
+    for (short k = 0; k < M; k++) {
+      buf[k * N + idx] = T(x[k] * scale);
+    }
+  }
+
+  threadgroup_barrier(mem_flags::mem_threadgroup);
+
+  // Cooperative write back to device
+  for (int j = tid * read_width; j < M * N; j += total_threads * read_width) {
+    STEEL_PRAGMA_UNROLL
+    for (short r = 0; r < read_width; r++) {
+      out[batch_idx + j + r] = buf[j + r];
+    }
+  }
+}
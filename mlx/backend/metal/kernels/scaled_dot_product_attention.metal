@@ -21,6 +21,12 @@ using namespace metal;
       type,                                                    \
       qk_dim,                                                  \
       value_dim)                                               \
+  instantiate_kernel(                                          \
+      "sdpa_vector_paged_" #type "_" #qk_dim "_" #value_dim,   \
+      sdpa_vector_paged,                                       \
+      type,                                                    \
+      qk_dim,                                                  \
+      value_dim)                                               \
   instantiate_kernel(                                          \
       "sdpa_vector_2pass_1_" #type "_" #qk_dim "_" #value_dim, \
       sdpa_vector_2pass_1,                                     \
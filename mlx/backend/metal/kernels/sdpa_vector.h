@@ -10,6 +10,7 @@ constant bool do_causal [[function_constant(22)]];
 constant bool bool_mask [[function_constant(23)]];
 constant bool float_mask [[function_constant(24)]];
 constant bool has_sinks [[function_constant(25)]];
+constant bool has_window [[function_constant(26)]];
 
 template <typename T, int D, int V = D>
 [[kernel]] void sdpa_vector(
@@ -35,6 +36,7 @@ template <typename T, int D, int V = D>
     const device T* sinks [[buffer(16), function_constant(has_sinks)]],
     const constant int& num_q_heads
     [[buffer(17), function_constant(has_sinks)]],
+    const constant int& window [[buffer(18), function_constant(has_window)]],
     uint3 tid [[threadgroup_position_in_grid]],
     uint3 tpg [[threadgroups_per_grid]],
     uint simd_gid [[simdgroup_index_in_threadgroup]],
@@ -104,6 +106,9 @@ template <typename T, int D, int V = D>
     } else if (float_mask) {
       use_key = (fmask[0] >= Limits<T>::finite_min);
     }
+    if (has_window) {
+      use_key = use_key && ((N - int(tpg.y) + int(q_seq_idx)) - i < window);
+    }
     if (use_key) {
       // Read the key
       for (int j = 0; j < qk_per_thread; j++) {
@@ -175,6 +180,125 @@ template <typename T, int D, int V = D>
   }
 }
 
+template <typename T, int D, int V = D>
+[[kernel]] void sdpa_vector_paged(
+    const device T* queries [[buffer(0)]],
+    const device T* k_pages [[buffer(1)]],
+    const device T* v_pages [[buffer(2)]],
+    device T* out [[buffer(3)]],
+    const device int32_t* page_table [[buffer(4)]],
+    const device int32_t* context_lens [[buffer(5)]],
+    const constant int& gqa_factor [[buffer(6)]],
+    const constant int& num_q_heads [[buffer(7)]],
+    const constant int& n_kv_heads [[buffer(8)]],
+    const constant int& page_size [[buffer(9)]],
+    const constant int& max_pages [[buffer(10)]],
+    const constant float& scale [[buffer(11)]],
+    uint3 tid [[threadgroup_position_in_grid]],
+    uint3 tpg [[threadgroups_per_grid]],
+    uint simd_gid [[simdgroup_index_in_threadgroup]],
+    uint simd_lid [[thread_index_in_simdgroup]]) {
+  constexpr int BN = 32;
+  constexpr int BD = 32;
+  constexpr int qk_per_thread = D / BD;
+  constexpr int v_per_thread = V / BD;
+
+  typedef float U;
+
+  thread U q[qk_per_thread];
+  thread U k[qk_per_thread];
+  thread U o[v_per_thread];
+
+  threadgroup U outputs[BN * BD];
+  threadgroup U max_scores[BN];
+  threadgroup U sum_exp_scores[BN];
+
+  // Adjust positions
+  const int q_batch_head_idx = tid.x;
+  const int q_seq_idx = tid.y;
+  const int batch_idx = q_batch_head_idx / num_q_heads;
+  const int kv_head_idx = (q_batch_head_idx % num_q_heads) / gqa_factor;
+  const int o_offset = q_batch_head_idx * tpg.y + q_seq_idx;
+  const device int32_t* table = page_table + batch_idx * max_pages;
+  const int N = context_lens[batch_idx];
+
+  queries += o_offset * D + simd_lid * qk_per_thread;
+  out += o_offset * V + simd_gid * v_per_thread;
+
+  // Read the query and 0 the output accumulator
+  for (int i = 0; i < qk_per_thread; i++) {
+    q[i] = static_cast<U>(scale) * queries[i];
+  }
+  for (int i = 0; i < v_per_thread; i++) {
+    o[i] = 0;
+  }
+
+  U max_score = -INFINITY;
+  U sum_exp_score = 0;
+
+  // For each key, addressed through the page table
+  for (int i = simd_gid; i < N; i += BN) {
+    const int page = table[i / page_size];
+    const size_t slot =
+        (size_t(page) * n_kv_heads + kv_head_idx) * page_size + i % page_size;
+    const device T* key = k_pages + slot * D + simd_lid * qk_per_thread;
+    const device T* value = v_pages + slot * V + simd_lid * v_per_thread;
+
+    // Read the key
+    for (int j = 0; j < qk_per_thread; j++) {
+      k[j] = key[j];
+    }
+
+    // Compute the i-th score
+    U score = 0;
+    for (int j = 0; j < qk_per_thread; j++) {
+      score += q[j] * k[j];
+    }
+    score = simd_sum(score);
+
+    // Update the accumulators
+    U new_max = max(max_score, score);
+    U factor = fast::exp(max_score - new_max);
+    U exp_score = fast::exp(score - new_max);
+
+    max_score = new_max;
+    sum_exp_score = sum_exp_score * factor + exp_score;
+
+    // Update the output accumulator
+    for (int j = 0; j < v_per_thread; j++) {
+      o[j] = o[j] * factor + exp_score * value[j];
+    }
+  }
+
+  // Each thread has a partial part of the output so we need to combine them.
+
+  // First let's communicate the max and sum_exp
+  if (simd_lid == 0) {
+    max_scores[simd_gid] = max_score;
+    sum_exp_scores[simd_gid] = sum_exp_score;
+  }
+  threadgroup_barrier(mem_flags::mem_threadgroup);
+  max_score = max_scores[simd_lid];
+  U new_max = simd_max(max_score);
+  U factor = fast::exp(max_score - new_max);
+  sum_exp_score = simd_sum(sum_exp_scores[simd_lid] * factor);
+
+  // Now we need to aggregate all the outputs
+  for (int i = 0; i < v_per_thread; i++) {
+    outputs[simd_lid * BD + simd_gid] = o[i];
+    threadgroup_barrier(mem_flags::mem_threadgroup);
+    o[i] = simd_sum(outputs[simd_gid * BD + simd_lid] * factor) / sum_exp_score;
+    threadgroup_barrier(mem_flags::mem_threadgroup);
+  }
+
+  // And write the output
+  if (simd_lid == 0) {
+    for (int i = 0; i < v_per_thread; i++) {
+      out[i] = static_cast<T>(o[i]);
+    }
+  }
+}
+
 template <typename T, int D, int V = D>
 [[kernel]] void sdpa_vector_2pass_1(
     const device T* queries [[buffer(0)]],
@@ -201,6 +325,7 @@ template <typename T, int D, int V = D>
     const device T* sinks [[buffer(18), function_constant(has_sinks)]],
     const constant int& num_q_heads
     [[buffer(19), function_constant(has_sinks)]],
+    const constant int& window [[buffer(20), function_constant(has_window)]],
     uint3 tid [[threadgroup_position_in_grid]],
     uint3 tpg [[threadgroups_per_grid]],
     uint simd_gid [[simdgroup_index_in_threadgroup]],
@@ -277,6 +402,9 @@ template <typename T, int D, int V = D>
     } else if (float_mask) {
       use_key = (fmask[0] >= Limits<T>::finite_min);
     }
+    if (has_window) {
+      use_key = use_key && ((N - int(tpg.y) + int(q_seq_idx)) - i < window);
+    }
     if (use_key) {
       // Read the key
       for (int i = 0; i < qk_per_thread; i++) {
@@ -12,6 +12,8 @@ constant bool align_K [[function_constant(201)]];
 constant bool has_mask [[function_constant(300)]];
 constant bool do_causal [[function_constant(301)]];
 constant bool has_sinks [[function_constant(302)]];
+constant bool do_rope [[function_constant(303)]];
+constant bool has_block_mask [[function_constant(304)]];
 
 template <typename T>
 struct TransformScale {
@@ -23,6 +25,38 @@ struct TransformScale {
   }
 };
 
+// Rotates a loaded block in threadgroup memory. Element (row, d) of the
+// block lives at block[row * LDR + d * LDC] so the same routine covers
+// the transposed K layout. Each rotation pair is owned by exactly one
+// thread so callers only need barriers on either side.
+template <typename T, short n_rows, short LDR, short LDC, short tgp_size>
+METAL_FUNC void block_rope(
+    threadgroup T* block,
+    const constant AttnRoPEParams* rope_params,
+    int pos_offset,
+    uint thread_idx) {
+  const short n_pairs = rope_params->dims / 2;
+  for (int i = thread_idx; i < n_rows * n_pairs; i += tgp_size) {
+    short row = i / n_pairs;
+    short j = i % n_pairs;
+
+    float d = float(j) / float(n_pairs);
+    float L = rope_params->scale * float(pos_offset + row);
+    float theta = L * metal::exp2(-d * rope_params->base);
+    float costheta = metal::fast::cos(theta);
+    float sintheta = metal::fast::sin(theta);
+
+    short d1 = rope_params->traditional ? 2 * j : j;
+    short d2 = rope_params->traditional ? 2 * j + 1 : j + n_pairs;
+    threadgroup T* x1 = block + row * LDR + d1 * LDC;
+    threadgroup T* x2 = block + row * LDR + d2 * LDC;
+    float rx1 = float(*x1) * costheta - float(*x2) * sintheta;
+    float rx2 = float(*x1) * sintheta + float(*x2) * costheta;
+    *x1 = static_cast<T>(rx1);
+    *x2 = static_cast<T>(rx2);
+  }
+}
+
 struct MaxOp {
   template <typename T>
   METAL_FUNC static constexpr T apply(T x, T y) {
@@ -84,6 +118,9 @@ template <
     const constant AttnMaskParams* mask_params [[buffer(5), function_constant(has_mask)]],
     const device MaskType* mask [[buffer(6), function_constant(has_mask)]],
     const device T* sinks [[buffer(7), function_constant(has_sinks)]],
+    const constant AttnRoPEParams* rope_params [[buffer(8), function_constant(do_rope)]],
+    const constant AttnBlockMaskParams* bmask_params [[buffer(9), function_constant(has_block_mask)]],
+    const device bool* block_mask [[buffer(10), function_constant(has_block_mask)]],
     uint simd_lane_id [[thread_index_in_simdgroup]],
     uint simd_group_id [[simdgroup_index_in_threadgroup]],
     uint3 tid [[threadgroup_position_in_grid]],
@@ -115,6 +152,14 @@ template <
         tidl.y * mask_params->M_strides[1]; // Head
   }
 
+  if (has_block_mask) {
+    // BQ divides the block size so this threadgroup covers one table row
+    block_mask += tidl.z * bmask_params->M_strides[0] + // Batch
+        tidl.y * bmask_params->M_strides[1] + // Head
+        (tidl.x * BQ / bmask_params->block_size) *
+            bmask_params->M_strides[2]; // Query block row
+  }
+
   // Prepare threadgroup memory
   constexpr short padQ = 16 / sizeof(T);
   constexpr short padK = 16 / sizeof(T);
@@ -222,6 +267,17 @@ template <
   }
   loader_q.apply_inplace_op(ts);
 
+  // Rotate Q block in place. The rotation is linear so the order with
+  // the scale above does not matter.
+  if (do_rope) {
+    threadgroup_barrier(mem_flags::mem_threadgroup);
+    block_rope<T, BQ, LDQ_tgp, 1, WM * WN * 32>(
+        Qs,
+        rope_params,
+        rope_params->offset + params->qL_off + tid.x * BQ,
+        simd_group_id * 32 + simd_lane_id);
+  }
+
   // Init row reduction variables
   constexpr short kRowsPT = decltype(Stile)::kRowsPerThread;
 
@@ -252,6 +308,14 @@ template <
 
   // Loop over KV seq length
   for (int kb = 0; kb < kb_lim; kb++) {
+    // Skip untouched KV tiles. The table entry is uniform across the
+    // threadgroup so no thread reaches the barriers below.
+    if (has_block_mask && !block_mask[kb * BK / bmask_params->block_size]) {
+      loader_k.next();
+      loader_v.next();
+      continue;
+    }
+
     // Load K block and apply scale
     threadgroup_barrier(mem_flags::mem_threadgroup);
     if (!align_K && kb == (params->NK_aligned)) {
@@ -260,6 +324,16 @@ template <
       loader_k.load_unsafe();
     }
 
+    // Rotate K block in place
+    if (do_rope) {
+      threadgroup_barrier(mem_flags::mem_threadgroup);
+      block_rope<T, BK, 1, LDK_tgp, WM * WN * 32>(
+          Ks,
+          rope_params,
+          rope_params->offset + kb * BK,
+          simd_group_id * 32 + simd_lane_id);
+    }
+
     // Do S = Q @ K.T
     Stile.clear();
 
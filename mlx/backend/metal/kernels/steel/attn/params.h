@@ -40,5 +40,18 @@ struct AttnMaskParams {
   int64_t M_strides[3]; ///< Mask  strides (B, H, qL, kL = 1)
 };
 
+struct AttnBlockMaskParams {
+  int block_size; ///< Tokens per block table entry (per axis)
+  int64_t M_strides[3]; ///< Block table strides (B, H, NQ blocks, NK = 1)
+};
+
+struct AttnRoPEParams {
+  int dims; ///< Number of leading head dims to rotate
+  int offset; ///< Position of the first key token
+  float base; ///< log2 of the rotation base
+  float scale; ///< Position scale
+  bool traditional; ///< Rotate interleaved pairs
+};
+
 } // namespace steel
 } // namespace mlx
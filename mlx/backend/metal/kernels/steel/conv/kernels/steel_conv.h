@@ -112,8 +112,13 @@ implicit_gemm_conv_2d(
       shape_a_cols,
       shape_b_cols>;
 
-  threadgroup T As[tgp_mem_size_a];
-  threadgroup T Bs[tgp_mem_size_b];
+  // The small channel tiles are narrow so there is threadgroup memory to
+  // spare for double buffering the loads
+  constexpr bool do_double_buffer = N_CHANNELS != 0 && N_CHANNELS <= 4;
+  constexpr short n_tgp_buffers = do_double_buffer ? 2 : 1;
+
+  threadgroup T As[n_tgp_buffers * tgp_mem_size_a];
+  threadgroup T Bs[n_tgp_buffers * tgp_mem_size_b];
 
   const int tid_y = ((tid.y) << gemm_params->swizzle_log) +
       ((tid.x) & ((1 << gemm_params->swizzle_log) - 1));
@@ -150,20 +155,50 @@ implicit_gemm_conv_2d(
   mma_t mma_op(simd_gid, simd_lid);
 
   int gemm_k_iterations = gemm_params->gemm_k_iterations;
-  for (int k = 0; k < gemm_k_iterations; k++) {
-    threadgroup_barrier(mem_flags::mem_threadgroup);
-    // Load elements into threadgroup
+  if constexpr (do_double_buffer) {
+    // Prime the first tile
     loader_a.load_unsafe();
     loader_b.load_unsafe();
-
-    threadgroup_barrier(mem_flags::mem_threadgroup);
-
-    // Multiply and accumulate threadgroup elements
-    mma_op.mma(As, Bs);
-
-    // Prepare for next iteration
     loader_a.next();
     loader_b.next();
+
+    short curr = 0;
+    for (int k = 0; k < gemm_k_iterations; k++) {
+      // Wait for the current tile and for the mma reads of the tile
+      // about to be overwritten
+      threadgroup_barrier(mem_flags::mem_threadgroup);
+
+      // Load the next tile into the other buffer while computing
+      if (k + 1 < gemm_k_iterations) {
+        loader_a.set_dst(As + (1 - curr) * tgp_mem_size_a);
+        loader_b.set_dst(Bs + (1 - curr) * tgp_mem_size_b);
+        loader_a.load_unsafe();
+        loader_b.load_unsafe();
+        loader_a.next();
+        loader_b.next();
+      }
+
+      // Multiply and accumulate threadgroup elements
+      mma_op.mma(As + curr * tgp_mem_size_a, Bs + curr * tgp_mem_size_b);
+
+      curr = 1 - curr;
+    }
+  } else {
+    for (int k = 0; k < gemm_k_iterations; k++) {
+      threadgroup_barrier(mem_flags::mem_threadgroup);
+      // Load elements into threadgroup
+      loader_a.load_unsafe();
+      loader_b.load_unsafe();
+
+      threadgroup_barrier(mem_flags::mem_threadgroup);
+
+      // Multiply and accumulate threadgroup elements
+      mma_op.mma(As, Bs);
+
+      // Prepare for next iteration
+      loader_a.next();
+      loader_b.next();
+    }
   }
 
   threadgroup_barrier(mem_flags::mem_none);
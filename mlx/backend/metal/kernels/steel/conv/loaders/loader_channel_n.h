@@ -190,6 +190,11 @@ struct Conv2DInputBlockLoaderSmallChannels {
   METAL_FUNC void next() {
     weight_hw += TCOLS;
   }
+
+  /* Retarget the loader at another threadgroup tile */
+  METAL_FUNC void set_dst(threadgroup T* dst_) {
+    dst = dst_ + bi * dst_ld + bj;
+  }
 };
 
 template <
@@ -313,6 +318,11 @@ struct Conv2DWeightBlockLoaderSmallChannels {
   METAL_FUNC void next() {
     weight_hw += TCOLS;
   }
+
+  /* Retarget the loader at another threadgroup tile */
+  METAL_FUNC void set_dst(threadgroup T* dst_) {
+    dst = dst_ + bi * dst_ld + bj;
+  }
 };
 
 } // namespace steel
@@ -264,3 +264,151 @@ template <
     }
   }
 }
+
+template <
+    typename T,
+    int BM,
+    int BN,
+    int BK,
+    int WM,
+    int WN,
+    bool transpose_a,
+    bool transpose_b,
+    typename AccumType = float>
+[[kernel, max_total_threads_per_threadgroup(WM* WN * 32)]] void gemm_streamk(
+    const device T* A [[buffer(0)]],
+    const device T* B [[buffer(1)]],
+    device AccumType* C [[buffer(2)]],
+    const constant GEMMParams* params [[buffer(3)]],
+    const constant int& num_groups [[buffer(4)]],
+    const constant int& k_iters_per_tile [[buffer(5)]],
+    uint simd_lane_id [[thread_index_in_simdgroup]],
+    uint simd_group_id [[simdgroup_index_in_threadgroup]],
+    uint3 tid [[threadgroup_position_in_grid]]) {
+  using gemm_kernel = GEMMKernel<
+      T,
+      AccumType,
+      BM,
+      BN,
+      BK,
+      WM,
+      WN,
+      transpose_a,
+      transpose_b,
+      true,
+      true,
+      AccumType>;
+
+  using loader_a_t = typename gemm_kernel::loader_a_t;
+  using loader_b_t = typename gemm_kernel::loader_b_t;
+  using mma_t = typename gemm_kernel::mma_t;
+
+  // Prepare threadgroup memory
+  threadgroup T As[gemm_kernel::tgp_mem_size_a];
+  threadgroup T Bs[gemm_kernel::tgp_mem_size_b];
+
+  // Work-centric assignment: the flattened (tile, k-iteration) space is
+  // carved into equal contiguous ranges, one per threadgroup, so the last
+  // wave stays busy on shapes where tile counts quantize badly. A tile
+  // whose reduction straddles a range boundary gets its tail accumulated
+  // into a second partial slot; the split-k accumulation pass adds the two
+  // slots. The host caps num_groups at the tile count so no tile straddles
+  // more than one boundary.
+  const int total_work = params->tiles_m * params->tiles_n * k_iters_per_tile;
+  const int work_per_group = (total_work + num_groups - 1) / num_groups;
+  int work = tid.x * work_per_group;
+  const int work_end = min(total_work, work + work_per_group);
+
+  const short lbk = short(params->K % BK);
+  const short thread_idx = short(simd_group_id * 32 + simd_lane_id);
+
+  while (work < work_end) {
+    const int tile_idx = work / k_iters_per_tile;
+    const int k_iter = work - tile_idx * k_iters_per_tile;
+    const int tile_iters = min(work_end - work, k_iters_per_tile - k_iter);
+
+    const int tile_m = tile_idx / params->tiles_n;
+    const int tile_n = tile_idx - tile_m * params->tiles_n;
+
+    // Find the block in A, B, C
+    const int c_row = tile_m * BM;
+    const int c_col = tile_n * BN;
+    const size_t k_start = size_t(k_iter) * BK;
+
+    // Prepare threadgroup bounds
+    const short tgp_bm = align_M ? BM : short(min(BM, params->M - c_row));
+    const short tgp_bn = align_N ? BN : short(min(BN, params->N - c_col));
+
+    const device T* A_tile = A +
+        (transpose_a ? (size_t(c_row) + k_start * params->lda)
+                     : (k_start + size_t(c_row) * params->lda));
+    const device T* B_tile = B +
+        (transpose_b ? (k_start + size_t(c_col) * params->ldb)
+                     : (size_t(c_col) + k_start * params->ldb));
+
+    // Prepare threadgroup mma operation
+    thread mma_t mma_op(simd_group_id, simd_lane_id);
+
+    // Prepare threadgroup loading operations
+    thread loader_a_t loader_a(
+        A_tile, params->lda, As, simd_group_id, simd_lane_id);
+    thread loader_b_t loader_b(
+        B_tile, params->ldb, Bs, simd_group_id, simd_lane_id);
+
+    for (int j = 0; j < tile_iters; j++) {
+      const bool k_aligned = lbk == 0 || (k_iter + j + 1) < k_iters_per_tile;
+      const short kb = k_aligned ? short(BK) : lbk;
+
+      threadgroup_barrier(mem_flags::mem_threadgroup);
+
+      // Load elements into threadgroup
+      if ((align_M || tgp_bm == BM) && k_aligned) {
+        loader_a.load_unsafe();
+      } else {
+        loader_a.load_safe(
+            transpose_a ? short2(tgp_bm, kb) : short2(kb, tgp_bm));
+      }
+      if ((align_N || tgp_bn == BN) && k_aligned) {
+        loader_b.load_unsafe();
+      } else {
+        loader_b.load_safe(
+            transpose_b ? short2(kb, tgp_bn) : short2(tgp_bn, kb));
+      }
+
+      threadgroup_barrier(mem_flags::mem_threadgroup);
+
+      // Multiply and accumulate threadgroup elements
+      mma_op.mma(As, Bs);
+
+      // Prepare for next iteration
+      loader_a.next();
+      loader_b.next();
+    }
+
+    // The range containing a tile's first k-iteration writes the first
+    // slot; a straddled tail goes to the fixup slot
+    const int slot = k_iter == 0 ? 0 : 1;
+    device AccumType* C_tile = C + size_t(slot) * params->batch_stride_d +
+        size_t(c_row) * params->ldd + c_col;
+
+    threadgroup_barrier(mem_flags::mem_threadgroup);
+    if ((align_M || tgp_bm == BM) && (align_N || tgp_bn == BN)) {
+      mma_op.store_result(C_tile, params->ldd);
+    } else {
+      mma_op.store_result_safe(C_tile, params->ldd, short2(tgp_bn, tgp_bm));
+    }
+
+    // A tile fully covered by one range has no tail contributor, so its
+    // fixup slot is zeroed here
+    if (slot == 0 && tile_iters == k_iters_per_tile) {
+      device AccumType* C_fix = C_tile + params->batch_stride_d;
+      for (int r = thread_idx; r < tgp_bm * tgp_bn; r += WM * WN * 32) {
+        const int i = r / tgp_bn;
+        const int j = r - i * tgp_bn;
+        C_fix[size_t(i) * params->ldd + j] = AccumType(0);
+      }
+    }
+
+    work += tile_iters;
+  }
+}
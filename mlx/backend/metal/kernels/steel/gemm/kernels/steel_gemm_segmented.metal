@@ -41,3 +41,37 @@ instantiate_segmented_mm_shapes_helper(
     bfloat16,
     bfloat16_t);
 instantiate_segmented_mm_shapes_helper(float32, float, float32, float);
+
+// clang-format off
+#define instantiate_streamk_mm(tname, trans_a, trans_b, iname, itype, bm, bn, bk, wm, wn) \
+  instantiate_kernel(                                                        \
+      "steel_streamk_mm_" #tname "_" #iname "_bm" #bm "_bn" #bn              \
+      "_bk" #bk "_wm" #wm "_wn" #wn,                                         \
+      gemm_streamk,                                                          \
+      itype,                                                                 \
+      bm,                                                                    \
+      bn,                                                                    \
+      bk,                                                                    \
+      wm,                                                                    \
+      wn,                                                                    \
+      trans_a,                                                               \
+      trans_b,                                                               \
+      float)
+
+#define instantiate_streamk_mm_transpose_helper(iname, itype, bm, bn, bk, wm, wn) \
+  instantiate_streamk_mm(nn, false, false, iname, itype, bm, bn, bk, wm, wn)      \
+  instantiate_streamk_mm(nt, false, true , iname, itype, bm, bn, bk, wm, wn)      \
+  instantiate_streamk_mm(tn, true , false, iname, itype, bm, bn, bk, wm, wn)      \
+  instantiate_streamk_mm(tt, true , true , iname, itype, bm, bn, bk, wm, wn)
+
+#define instantiate_streamk_mm_shapes_helper(iname, itype)                 \
+  instantiate_streamk_mm_transpose_helper(iname, itype, 64, 64, 16, 2, 2)  \
+  instantiate_streamk_mm_transpose_helper(iname, itype, 64, 64, 16, 1, 2)  \
+  instantiate_streamk_mm_transpose_helper(iname, itype, 64, 32, 32, 2, 2)  \
+  instantiate_streamk_mm_transpose_helper(iname, itype, 32, 64, 16, 1, 2)  \
+  instantiate_streamk_mm_transpose_helper(iname, itype, 32, 32, 16, 2, 2)
+// clang-format on
+
+instantiate_streamk_mm_shapes_helper(float16, half);
+instantiate_streamk_mm_shapes_helper(bfloat16, bfloat16_t);
+instantiate_streamk_mm_shapes_helper(float32, float);
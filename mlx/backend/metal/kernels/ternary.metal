@@ -40,3 +40,5 @@
   instantiate_ternary_base(op, complex64, complex64_t) // clang-format on
 
 instantiate_ternary_types(Select)
+instantiate_ternary_types(MaskedAdd)
+instantiate_ternary_types(MaskedMultiply)
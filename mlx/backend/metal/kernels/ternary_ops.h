@@ -8,3 +8,17 @@ struct Select {
     return condition ? x : y;
   }
 };
+
+struct MaskedAdd {
+  template <typename T>
+  T operator()(bool condition, T x, T y) {
+    return condition ? static_cast<T>(x + y) : T(0);
+  }
+};
+
+struct MaskedMultiply {
+  template <typename T>
+  T operator()(bool condition, T x, T y) {
+    return condition ? static_cast<T>(x * y) : T(0);
+  }
+};
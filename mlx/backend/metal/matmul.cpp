@@ -9,6 +9,7 @@
 #include "mlx/backend/common/matmul.h"
 #include "mlx/backend/gpu/copy.h"
 #include "mlx/backend/metal/device.h"
+#include "mlx/backend/metal/gemm_tuner.h"
 #include "mlx/backend/metal/kernels.h"
 #include "mlx/backend/metal/kernels/defines.h"
 #include "mlx/backend/metal/kernels/steel/gemm/params.h"
@@ -200,6 +201,128 @@ void steel_matmul_regular_axpby(
   char devc = d.get_architecture().back();
   GEMM_TPARAM_MACRO(devc)
 
+  const bool has_batch = (batch_shape.size() > 1);
+  const bool use_out_source = CHECK_AB && (alpha != 0.0f || beta != 1.0f);
+  const bool do_axpby = use_out_source && (alpha != 1.0f || beta != 1.0f);
+
+  // With MLX_GEMM_TUNE set, override the heuristic with the tile shape
+  // measured fastest for this problem on this device
+  if (gemm_tuning_enabled()) {
+    std::ostringstream tkey;
+    tkey << d.get_architecture() << "_" << (transpose_a ? 't' : 'n')
+         << (transpose_b ? 't' : 'n') << "_" << type_to_name(a) << "_"
+         << type_to_name(out) << "_M" << M << "_N" << N << "_K" << K << "_B"
+         << batch_size_out;
+    auto encode_one = [&](const GemmTileConfig& cfg,
+                          MTL::ComputeCommandEncoder* enc) {
+      // clang-format off
+      std::ostringstream tname;
+      tname << "steel_gemm_fused_"
+            << (transpose_a ? 't' : 'n')
+            << (transpose_b ? 't' : 'n')
+            << "_" << type_to_name(a)
+            << "_" << type_to_name(out)
+            << "_bm" << cfg.bm << "_bn" << cfg.bn << "_bk" << cfg.bk
+            << "_wm" << cfg.wm << "_wn" << cfg.wn; // clang-format on
+      std::string tbase_name = tname.str();
+
+      const bool align_M = (M % cfg.bm) == 0;
+      const bool align_N = (N % cfg.bn) == 0;
+      const bool align_K = (K % cfg.bk) == 0;
+      metal::MTLFCList func_consts = {
+          {&has_batch, MTL::DataType::DataTypeBool, 10},
+          {&use_out_source, MTL::DataType::DataTypeBool, 100},
+          {&do_axpby, MTL::DataType::DataTypeBool, 110},
+          {&align_M, MTL::DataType::DataTypeBool, 200},
+          {&align_N, MTL::DataType::DataTypeBool, 201},
+          {&align_K, MTL::DataType::DataTypeBool, 202},
+      };
+
+      // clang-format off
+      tname << "_has_batch_" << (has_batch ? 't' : 'n')
+            << "_use_out_source_" << (use_out_source ? 't' : 'n')
+            << "_do_axpby_" << (do_axpby ? 't' : 'n')
+            << "_align_M_" << (align_M ? 't' : 'n')
+            << "_align_N_" << (align_N ? 't' : 'n')
+            << "_align_K_" << (align_K ? 't' : 'n'); // clang-format on
+
+      auto kernel = get_steel_gemm_fused_kernel(
+          /* metal::Device& d = */ d,
+          /* const std::string& kernel_name = */ tbase_name,
+          /* const std::string& hash_name = */ tname.str(),
+          /* const metal::MTLFCList& func_consts = */ func_consts,
+          /* const array& out = */ out,
+          /* bool transpose_a = */ transpose_a,
+          /* bool transpose_b = */ transpose_b,
+          /* int bm = */ cfg.bm,
+          /* int bn = */ cfg.bn,
+          /* int bk = */ cfg.bk,
+          /* int wm = */ cfg.wm,
+          /* int wn = */ cfg.wn);
+      enc->setComputePipelineState(kernel);
+
+      auto buf = [](const array& x) {
+        return static_cast<const MTL::Buffer*>(x.buffer().ptr());
+      };
+      auto buf_offset = [&](const array& x) {
+        return x.data<char>() -
+            static_cast<char*>(const_cast<MTL::Buffer*>(buf(x))->contents());
+      };
+
+      int tn = (N + cfg.bn - 1) / cfg.bn;
+      int tm = (M + cfg.bm - 1) / cfg.bm;
+      GEMMParams params{
+          /* const int M = */ M,
+          /* const int N = */ N,
+          /* const int K = */ K,
+          /* const int lda = */ lda,
+          /* const int ldb = */ ldb,
+          /* const int ldd = */ ldd,
+          /* const int tiles_n = */ tn,
+          /* const int tiles_m = */ tm,
+          /* const int64_t batch_stride_a = */ A_batch_stride,
+          /* const int64_t batch_stride_b = */ B_batch_stride,
+          /* const int64_t batch_stride_d = */ matrix_stride_out,
+          /* const int swizzle_log = */ 0,
+          /* const int gemm_k_iterations_aligned = */ (K / cfg.bk),
+          /* const int batch_ndim = */ int(batch_shape.size())};
+
+      enc->setBuffer(buf(a), buf_offset(a), 0);
+      enc->setBuffer(buf(b), buf_offset(b), 1);
+      enc->setBuffer(buf(out), buf_offset(out), 3);
+      enc->setBytes(&params, sizeof(params), 4);
+      if (has_batch) {
+        enc->setBytes(
+            batch_shape.data(),
+            batch_shape.size() * sizeof(batch_shape[0]),
+            6);
+        enc->setBytes(
+            batch_strides.data(),
+            batch_strides.size() * sizeof(batch_strides[0]),
+            7);
+      }
+      if (use_out_source) {
+        GEMMAddMMParams addmm_params{
+            /* const int ldc = */ int(c.strides()[c.ndim() - 2]),
+            /* const int fdc = */ int(c.strides()[c.ndim() - 1]),
+            /* const int64_t batch_stride_c = */ C_batch_stride,
+            /* const float alpha = */ alpha,
+            /* const float beta = */ beta};
+        enc->setBuffer(buf(c), buf_offset(c), 2);
+        enc->setBytes(&addmm_params, sizeof(addmm_params), 5);
+      }
+      enc->dispatchThreadgroups(
+          MTL::Size(tn, tm, batch_size_out), MTL::Size(32, cfg.wn, cfg.wm));
+    };
+    if (auto tuned = gemm_tuned_tiles(d, s, tkey.str(), encode_one)) {
+      bm = tuned->bm;
+      bn = tuned->bn;
+      bk = tuned->bk;
+      wm = tuned->wm;
+      wn = tuned->wn;
+    }
+  }
+
   // Prepare kernel name
   std::ostringstream kname;
 
@@ -214,9 +337,6 @@ void steel_matmul_regular_axpby(
 
   std::string base_name = kname.str();
 
-  const bool has_batch = (batch_shape.size() > 1);
-  const bool use_out_source = CHECK_AB && (alpha != 0.0f || beta != 1.0f);
-  const bool do_axpby = use_out_source && (alpha != 1.0f || beta != 1.0f);
   const bool align_M = (M % bm) == 0;
   const bool align_N = (N % bn) == 0;
   const bool align_K = (K % bk) == 0;
@@ -473,6 +593,188 @@ void steel_gemm_splitk_axpby(
   d.add_temporaries(std::move(copies), s.index);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Stream-k gemm
+///////////////////////////////////////////////////////////////////////////////
+
+template <bool CHECK_AB = true>
+void steel_gemm_streamk_axpby(
+    const Stream& s,
+    metal::Device& d,
+    const array& a,
+    const array& b,
+    const array& c,
+    array& out,
+    int M,
+    int N,
+    int K,
+    int lda,
+    int ldb,
+    bool transpose_a,
+    bool transpose_b,
+    std::vector<array>& copies,
+    float alpha = 1.0f,
+    float beta = 0.0f) {
+  using namespace mlx::steel;
+
+  // Determine dispatch kernel
+  int bm = 64, bn = 64, bk = 16;
+  int wm = 2, wn = 2;
+  size_t batch_size_out = out.size() / M / N;
+
+  char devc = d.get_architecture().back();
+  GEMM_TPARAM_MACRO(devc)
+
+  const int tn = (N + bn - 1) / bn;
+  const int tm = (M + bm - 1) / bm;
+  const int tiles = tm * tn;
+  const int k_iters_per_tile = (K + bk - 1) / bk;
+
+  // One contiguous range of the flattened (tile, k-iteration) space per
+  // threadgroup; capping at the tile count keeps every tile split across
+  // at most two ranges so two partial slots suffice
+  const int num_groups = std::min(tiles, 128);
+
+  const bool align_M = (M % bm) == 0;
+  const bool align_N = (N % bn) == 0;
+
+  // Two float32 partial slots; boundary tiles put their tail in the second
+  array C_split({2, M, N}, float32, nullptr, {});
+  C_split.set_data(allocator::malloc(C_split.nbytes()));
+  copies.push_back(C_split);
+
+  // Define the kernel name
+  std::string base_name;
+  base_name.reserve(128);
+  concatenate(
+      base_name,
+      "steel_streamk_mm_",
+      transpose_a ? 't' : 'n',
+      transpose_b ? 't' : 'n',
+      "_",
+      type_to_name(a),
+      "_bm",
+      bm,
+      "_bn",
+      bn,
+      "_bk",
+      bk,
+      "_wm",
+      wm,
+      "_wn",
+      wn);
+
+  metal::MTLFCList func_consts = {
+      {&align_M, MTL::DataType::DataTypeBool, 200},
+      {&align_N, MTL::DataType::DataTypeBool, 201},
+  };
+
+  // And the kernel hash that includes the function constants
+  std::string hash_name;
+  hash_name.reserve(128);
+  concatenate(
+      hash_name,
+      base_name,
+      "_align_M_",
+      align_M ? 't' : 'n',
+      "_align_N_",
+      align_N ? 't' : 'n');
+
+  // Get and set the kernel
+  auto& compute_encoder = d.get_command_encoder(s.index);
+  auto kernel = get_steel_gemm_streamk_kernel(
+      d,
+      base_name,
+      hash_name,
+      func_consts,
+      a,
+      transpose_a,
+      transpose_b,
+      bm,
+      bn,
+      bk,
+      wm,
+      wn);
+  compute_encoder.set_compute_pipeline_state(kernel);
+
+  // Prepare the matmul params
+  steel::GEMMParams params{
+      /* const int M = */ M,
+      /* const int N = */ N,
+      /* const int K = */ K,
+      /* const int lda = */ lda,
+      /* const int ldb = */ ldb,
+      /* const int ldd = */ N,
+      /* const int tiles_n = */ tn,
+      /* const int tiles_m = */ tm,
+      /* const int64_t batch_stride_a = */ 0,
+      /* const int64_t batch_stride_b = */ 0,
+      /* const int64_t batch_stride_d = */ int64_t(M) * N,
+      /* const int swizzle_log = */ 0,
+      /* const int gemm_k_iterations_aligned = */ 0,
+      /* const int batch_ndim = */ 0};
+
+  // Prepare the grid
+  MTL::Size group_dims = MTL::Size(32, wn, wm);
+  MTL::Size grid_dims = MTL::Size(num_groups, 1, 1);
+
+  // Launch kernel
+  compute_encoder.set_input_array(a, 0);
+  compute_encoder.set_input_array(b, 1);
+  compute_encoder.set_output_array(C_split, 2);
+  compute_encoder.set_bytes(params, 3);
+  compute_encoder.set_bytes(num_groups, 4);
+  compute_encoder.set_bytes(k_iters_per_tile, 5);
+  compute_encoder.dispatch_threadgroups(grid_dims, group_dims);
+
+  // Do accum kernel
+  {
+    const bool do_axpby = CHECK_AB && (alpha != 1.0f || beta != 0.0f);
+    const int split_k_partitions = 2;
+    const int split_k_partition_stride = M * N;
+
+    auto kernel_name = "steel_gemm_splitk_accum_" + type_to_name(out) + "_" +
+        type_to_name(C_split);
+
+    if (do_axpby) {
+      kernel_name = kernel_name + "_axbpy";
+    }
+
+    auto kernel = get_steel_gemm_splitk_accum_kernel(
+        /* metal::Device& d = */ d,
+        /* const std::string& kernel_name = */ kernel_name,
+        /* const array& in = */ C_split,
+        /* const array& out = */ out,
+        /* bool axbpy = */ do_axpby);
+    compute_encoder.set_compute_pipeline_state(kernel);
+
+    // Set the arguments for the kernel
+    compute_encoder.set_input_array(C_split, 0);
+    compute_encoder.set_output_array(out, 1);
+    compute_encoder.set_bytes(split_k_partitions, 2);
+    compute_encoder.set_bytes(split_k_partition_stride, 3);
+    compute_encoder.set_bytes(N, 4);
+
+    if (do_axpby) {
+      int ldc = c.strides()[c.ndim() - 2];
+      int fdc = c.strides()[c.ndim() - 1];
+
+      compute_encoder.set_input_array(c, 5);
+      compute_encoder.set_bytes(ldc, 6);
+      compute_encoder.set_bytes(fdc, 7);
+      compute_encoder.set_bytes(alpha, 8);
+      compute_encoder.set_bytes(beta, 9);
+    }
+
+    // Launch enough thread groups for each output
+    MTL::Size grid_dims = MTL::Size(N, M, 1);
+    auto group_dims = get_block_dims(N, M, 1);
+    compute_encoder.dispatch_threads(grid_dims, group_dims);
+  }
+
+  d.add_temporaries(std::move(copies), s.index);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Split matmul routing
 ///////////////////////////////////////////////////////////////////////////////
@@ -544,6 +846,33 @@ void steel_matmul_axpby(
     }
   }
 
+  /////////////////////////////////////////////////////////////////////////////
+  // Stream-k specialization
+
+  // Work-centric decomposition for shapes whose tile count quantizes badly
+  // into waves (small M against a wide N and a long K); can be disabled
+  // with MLX_STREAMK=0
+  if (batch_size_out == 1 && M > 1 && M <= 128 && N >= 4096 && K >= 4096 &&
+      env::get_var("MLX_STREAMK", 1)) {
+    return steel_gemm_streamk_axpby<CHECK_AB>(
+        /* const Stream& s = */ s,
+        /* metal::Device& d = */ d,
+        /* const array& a = */ a,
+        /* const array& b = */ b,
+        /* const array& c = */ c,
+        /* array& out = */ out,
+        /* int M = */ M,
+        /* int N = */ N,
+        /* int K = */ K,
+        /* int lda = */ lda,
+        /* int ldb = */ ldb,
+        /* bool transpose_a = */ transpose_a,
+        /* bool transpose_b = */ transpose_b,
+        /* std::vector<array>& copies = */ copies,
+        /* float alpha = */ alpha,
+        /* float beta = */ beta);
+  }
+
   /////////////////////////////////////////////////////////////////////////////
   // Split K specialization
 
@@ -617,6 +946,106 @@ void steel_matmul_axpby(
 // GEMV dispatch
 ///////////////////////////////////////////////////////////////////////////////
 
+template <bool CHECK_AB = true>
+void gemv_split_k_axpby(
+    const Stream& s,
+    metal::Device& d,
+    const array& mat,
+    const array& vec,
+    const array& c,
+    array& out,
+    int in_vector_len,
+    int out_vector_len,
+    int mat_ld,
+    std::vector<array>& copies,
+    float alpha = 1.0f,
+    float beta = 0.0f) {
+  // Tile selection mirrors the transposed gemv for small outputs
+  int tm = 4, tn = 4;
+  int sm = 8, sn = 4;
+  int bn = out_vector_len >= 512 ? 4 : 2;
+  tn = out_vector_len < tn ? 1 : tn;
+  int n_out_per_tgp = bn * sn * tn;
+
+  int split_k_partitions = in_vector_len < 16384 ? 4 : 8;
+  int split_k_partition_size =
+      (in_vector_len + split_k_partitions - 1) / split_k_partitions;
+
+  // Accumulate partials in float32 as the steel split-k does
+  array C_split({split_k_partitions, out_vector_len}, float32, nullptr, {});
+  C_split.set_data(allocator::malloc(C_split.nbytes()));
+  copies.push_back(C_split);
+
+  std::ostringstream kname;
+  // clang-format off
+  kname << "gemv_t_split_k_" << type_to_name(out)
+        << "_bm1" << "_bn" << bn
+        << "_sm" << sm << "_sn" << sn
+        << "_tm" << tm << "_tn" << tn; // clang-format on
+
+  auto& compute_encoder = d.get_command_encoder(s.index);
+  auto kernel = d.get_kernel(kname.str());
+  compute_encoder.set_compute_pipeline_state(kernel);
+
+  int n_tgp = (out_vector_len + n_out_per_tgp - 1) / n_out_per_tgp;
+  MTL::Size group_dims = MTL::Size(32, bn, 1);
+  MTL::Size grid_dims = MTL::Size(n_tgp, 1, split_k_partitions);
+
+  compute_encoder.set_input_array(mat, 0);
+  compute_encoder.set_input_array(vec, 1);
+  compute_encoder.set_output_array(C_split, 3);
+  compute_encoder.set_bytes(in_vector_len, 4);
+  compute_encoder.set_bytes(out_vector_len, 5);
+  compute_encoder.set_bytes(mat_ld, 6);
+  compute_encoder.set_bytes(split_k_partition_size, 7);
+  compute_encoder.dispatch_threadgroups(grid_dims, group_dims);
+
+  // Do accum kernel
+  {
+    const bool do_axpby = CHECK_AB && (alpha != 1.0f || beta != 0.0f);
+
+    auto kernel_name = "steel_gemm_splitk_accum_" + type_to_name(out) + "_" +
+        type_to_name(C_split);
+
+    if (do_axpby) {
+      kernel_name = kernel_name + "_axbpy";
+    }
+
+    auto kernel = get_steel_gemm_splitk_accum_kernel(
+        /* metal::Device& d = */ d,
+        /* const std::string& kernel_name = */ kernel_name,
+        /* const array& in = */ C_split,
+        /* const array& out = */ out,
+        /* bool axbpy = */ do_axpby);
+    compute_encoder.set_compute_pipeline_state(kernel);
+
+    // Set the arguments for the kernel
+    compute_encoder.set_input_array(C_split, 0);
+    compute_encoder.set_output_array(out, 1);
+    compute_encoder.set_bytes(split_k_partitions, 2);
+    compute_encoder.set_bytes(out_vector_len, 3);
+    compute_encoder.set_bytes(out_vector_len, 4);
+
+    if (do_axpby) {
+      int ldc = 0;
+      int fdc = c.strides()[c.ndim() - 1];
+
+      compute_encoder.set_input_array(c, 5);
+      compute_encoder.set_bytes(ldc, 6);
+      compute_encoder.set_bytes(fdc, 7);
+      compute_encoder.set_bytes(alpha, 8);
+      compute_encoder.set_bytes(beta, 9);
+    }
+
+    // Launch enough thread groups for each output
+    MTL::Size grid_dims = MTL::Size(out_vector_len, 1, 1);
+    auto group_dims = get_block_dims(out_vector_len, 1, 1);
+    compute_encoder.dispatch_threads(grid_dims, group_dims);
+  }
+
+  d.add_temporaries(std::move(copies), s.index);
+}
+
 template <bool CHECK_AB = true>
 void gemv_axbpy(
     const Stream& s,
@@ -664,6 +1093,26 @@ void gemv_axbpy(
 
   int batch_ndim = batch_shape.size();
 
+  // Split the reduction over extra threadgroups for skinny decode matvecs;
+  // a long reduction feeding few outputs otherwise occupies only a handful
+  // of threadgroups per launch
+  if (transpose_mat && batch_size_out == 1 && in_vector_len >= 8192 &&
+      out_vector_len < 2048) {
+    return gemv_split_k_axpby<CHECK_AB>(
+        /* const Stream& s = */ s,
+        /* metal::Device& d = */ d,
+        /* const array& mat = */ mat,
+        /* const array& vec = */ vec,
+        /* const array& c = */ c,
+        /* array& out = */ out,
+        /* int in_vector_len = */ in_vector_len,
+        /* int out_vector_len = */ out_vector_len,
+        /* int mat_ld = */ mat_ld,
+        /* std::vector<array>& copies = */ copies,
+        /* float alpha = */ alpha,
+        /* float beta = */ beta);
+  }
+
   // Determine dispatch kernel
   int tm = 4, tn = 4;
   int sm = 1, sn = 32;
@@ -1,14 +1,54 @@
 // Copyright © 2023-2024 Apple Inc.
 #include <memory>
+#include <mutex>
 
 #include <sys/sysctl.h>
 
+#include "mlx/array.h"
 #include "mlx/backend/metal/device.h"
 #include "mlx/backend/metal/metal.h"
+#include "mlx/backend/metal/resident.h"
 #include "mlx/backend/metal/utils.h"
 
 namespace mlx::core::metal {
 
+namespace {
+
+// A named group of arrays wired into one residency set. The arrays are
+// held so their buffers stay allocated for the lifetime of the group.
+struct ResidencyGroup {
+  ResidencyGroup(MTL::Device* d) : set(d) {}
+  ResidencySet set;
+  std::vector<array> arrays;
+};
+
+auto& residency_groups() {
+  static std::unordered_map<std::string, std::unique_ptr<ResidencyGroup>>
+      groups;
+  return groups;
+}
+
+auto& residency_groups_mutex() {
+  static std::mutex mtx;
+  return mtx;
+}
+
+ResidencyGroup& find_residency_group(
+    const std::string& name,
+    const char* tag) {
+  auto& groups = residency_groups();
+  auto it = groups.find(name);
+  if (it == groups.end()) {
+    std::ostringstream msg;
+    msg << "[metal::" << tag << "] No residency set named \"" << name
+        << "\".";
+    throw std::invalid_argument(msg.str());
+  }
+  return *it->second;
+}
+
+} // namespace
+
 bool is_available() {
   return true;
 }
@@ -81,4 +121,68 @@ device_info() {
   return device_info_;
 }
 
+void make_residency_set(
+    const std::string& name,
+    const std::vector<array>& arrays) {
+  auto group = std::make_unique<ResidencyGroup>(
+      device(mlx::core::Device::gpu).mtl_device());
+  // No capacity cap; membership of the group is the policy
+  group->set.resize(SIZE_MAX);
+  for (auto& a : arrays) {
+    if (a.data<void>() == nullptr) {
+      throw std::invalid_argument(
+          "[metal::make_residency_set] Arrays must be evaluated before "
+          "they can be grouped into a residency set.");
+    }
+    group->set.insert(
+        static_cast<MTL::Buffer*>(const_cast<void*>(a.buffer().ptr())));
+    group->arrays.push_back(a);
+  }
+  std::lock_guard<std::mutex> lock(residency_groups_mutex());
+  residency_groups()[name] = std::move(group);
+}
+
+void activate_residency_set(const std::string& name) {
+  std::lock_guard<std::mutex> lock(residency_groups_mutex());
+  find_residency_group(name, "activate_residency_set")
+      .set.request_residency();
+}
+
+void deactivate_residency_set(const std::string& name) {
+  std::lock_guard<std::mutex> lock(residency_groups_mutex());
+  find_residency_group(name, "deactivate_residency_set").set.end_residency();
+}
+
+void set_commit_policy(
+    Stream s,
+    int max_ops,
+    int max_mb,
+    float latency_target_ms) {
+  if (s.device != mlx::core::Device::gpu) {
+    throw std::invalid_argument(
+        "[metal::set_commit_policy] Can only set the commit policy of a "
+        "gpu stream.");
+  }
+  device(s.device).set_commit_policy(
+      s.index, max_ops, max_mb, latency_target_ms);
+}
+
+void start_binary_archive_capture() {
+  device(mlx::core::Device::gpu).start_binary_archive_capture();
+}
+
+void save_binary_archive(const std::string& path) {
+  device(mlx::core::Device::gpu).save_binary_archive(path);
+}
+
+void load_binary_archive(const std::string& path) {
+  device(mlx::core::Device::gpu).load_binary_archive(path);
+}
+
+void release_residency_set(const std::string& name) {
+  std::lock_guard<std::mutex> lock(residency_groups_mutex());
+  find_residency_group(name, "release_residency_set");
+  residency_groups().erase(name);
+}
+
 } // namespace mlx::core::metal
@@ -5,6 +5,13 @@
 #include <string>
 #include <unordered_map>
 #include <variant>
+#include <vector>
+
+#include "mlx/stream.h"
+
+namespace mlx::core {
+class array;
+} // namespace mlx::core
 
 namespace mlx::core::metal {
 
@@ -19,4 +26,47 @@ void stop_capture();
 const std::unordered_map<std::string, std::variant<std::string, size_t>>&
 device_info();
 
+/** Group the buffers of `arrays` into a named residency set and ask the
+ * driver to keep them resident. The arrays must be evaluated and are kept
+ * alive while the set exists. */
+void make_residency_set(
+    const std::string& name,
+    const std::vector<array>& arrays);
+
+/** Ask the driver to keep the named set resident again. */
+void activate_residency_set(const std::string& name);
+
+/** Allow the named set to be paged out, e.g. while another phase's
+ * weights are in use. */
+void deactivate_residency_set(const std::string& name);
+
+/** Drop the named set and release the arrays it holds. */
+void release_residency_set(const std::string& name);
+
+/** Set the command buffer commit policy for stream `s`. `max_ops` and
+ * `max_mb` bound the ops and output megabytes encoded into one command
+ * buffer before it is committed; negative values restore the device
+ * defaults. A positive `latency_target_ms` enables auto mode: the ops
+ * budget is continuously tuned so command buffers complete in roughly
+ * that much GPU time, so long training graphs batch more work per
+ * commit while interactive decode commits often enough to stay
+ * responsive. */
+void set_commit_policy(
+    Stream s,
+    int max_ops,
+    int max_mb,
+    float latency_target_ms = 0);
+
+/** Start adding newly built compute pipelines to a binary archive. Run
+ * the model once with capture on, then save the archive and ship it. */
+void start_binary_archive_capture();
+
+/** Serialize the captured pipeline archive to an absolute file `path`. */
+void save_binary_archive(const std::string& path);
+
+/** Map a previously saved archive so pipelines load instead of
+ * compiling on first use. Also done at startup when MLX_BINARY_ARCHIVE
+ * points at an archive file. */
+void load_binary_archive(const std::string& path);
+
 } // namespace mlx::core::metal
@@ -22,6 +22,40 @@ device_info() {
       "[metal::device_info] Cannot get device info without metal backend");
 };
 
+void make_residency_set(const std::string&, const std::vector<array>&) {
+  throw std::runtime_error(
+      "[metal::make_residency_set] Cannot make a residency set without "
+      "metal backend");
+}
+
+void activate_residency_set(const std::string&) {}
+void deactivate_residency_set(const std::string&) {}
+void release_residency_set(const std::string&) {}
+
+void set_commit_policy(Stream, int, int, float) {
+  throw std::runtime_error(
+      "[metal::set_commit_policy] Cannot set a commit policy without "
+      "metal backend");
+}
+
+void start_binary_archive_capture() {
+  throw std::runtime_error(
+      "[metal::start_binary_archive_capture] Cannot capture a binary "
+      "archive without metal backend");
+}
+
+void save_binary_archive(const std::string&) {
+  throw std::runtime_error(
+      "[metal::save_binary_archive] Cannot save a binary archive without "
+      "metal backend");
+}
+
+void load_binary_archive(const std::string&) {
+  throw std::runtime_error(
+      "[metal::load_binary_archive] Cannot load a binary archive without "
+      "metal backend");
+}
+
 } // namespace metal
 
 namespace fast {
@@ -37,6 +71,21 @@ CustomKernelFunction metal_kernel(
   throw std::runtime_error("[metal_kernel] No Metal back-end.");
 }
 
+PrecompiledCustomKernelFunction precompile_metal_kernel(
+    const std::string&,
+    const std::vector<std::string>&,
+    const std::vector<Dtype>&,
+    const std::vector<int>&,
+    const std::vector<std::string>&,
+    const std::vector<Dtype>&,
+    const std::string&,
+    const std::string&,
+    const std::vector<std::pair<std::string, TemplateArg>>&,
+    bool,
+    bool) {
+  throw std::runtime_error("[precompile_metal_kernel] No Metal back-end.");
+}
+
 } // namespace fast
 
 } // namespace mlx::core
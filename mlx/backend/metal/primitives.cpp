@@ -11,6 +11,7 @@
 #include "mlx/backend/metal/device.h"
 #include "mlx/backend/metal/kernels.h"
 #include "mlx/backend/metal/utils.h"
+#include "mlx/fast_primitives.h"
 #include "mlx/primitives.h"
 #include "mlx/scheduler.h"
 #include "mlx/utils.h"
@@ -222,6 +223,10 @@ void Cholesky::eval_gpu(const std::vector<array>& inputs, array& out) {
       "[Cholesky::eval_gpu] Metal Cholesky decomposition NYI.");
 }
 
+void Bincount::eval_gpu(const std::vector<array>& inputs, array& out) {
+  throw std::runtime_error("[Bincount::eval_gpu] Metal Bincount NYI.");
+}
+
 void Eig::eval_gpu(
     const std::vector<array>& inputs,
     std::vector<array>& outputs) {
@@ -240,4 +245,47 @@ void LUF::eval_gpu(
   throw std::runtime_error("[LUF::eval_gpu] Metal LU factorization NYI.");
 }
 
+namespace fast {
+
+bool ScaledMatmul::use_fallback(Stream s) {
+  return true;
+}
+
+void ScaledMatmul::eval_gpu(const std::vector<array>& inputs, array& out) {
+  throw std::runtime_error("[ScaledMatmul::eval_gpu] Metal fp8 matmul NYI.");
+}
+
+bool SwiGLUMLP::use_fallback(Stream s) {
+  return true;
+}
+
+bool RMSNormMatmul::use_fallback(const array& x, const array& w, Stream s) {
+  return true;
+}
+
+void RMSNormMatmul::eval_gpu(const std::vector<array>& inputs, array& out) {
+  throw std::runtime_error(
+      "[RMSNormMatmul::eval_gpu] Metal norm-folded GEMM NYI.");
+}
+
+bool QuantizedSDPA::use_fallback(
+    const array& q,
+    const array& k,
+    int group_size,
+    int bits,
+    Stream s) {
+  return true;
+}
+
+void QuantizedSDPA::eval_gpu(const std::vector<array>& inputs, array& out) {
+  throw std::runtime_error(
+      "[QuantizedSDPA::eval_gpu] Metal quantized attention NYI.");
+}
+
+void SwiGLUMLP::eval_gpu(const std::vector<array>& inputs, array& out) {
+  throw std::runtime_error("[SwiGLUMLP::eval_gpu] Metal fused MLP NYI.");
+}
+
+} // namespace fast
+
 } // namespace mlx::core
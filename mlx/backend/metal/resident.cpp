@@ -90,6 +90,18 @@ void ResidencySet::resize(size_t size) {
   }
 }
 
+void ResidencySet::request_residency() {
+  if (wired_set_) {
+    wired_set_->requestResidency();
+  }
+}
+
+void ResidencySet::end_residency() {
+  if (wired_set_) {
+    wired_set_->endResidency();
+  }
+}
+
 ResidencySet::~ResidencySet() {
   if (wired_set_) {
     auto pool = new_scoped_memory_pool();
@@ -23,6 +23,10 @@ class ResidencySet {
 
   void resize(size_t size);
 
+  // Ask the driver to keep the set resident / allow it to be paged out
+  void request_residency();
+  void end_residency();
+
  private:
   MTL::ResidencySet* wired_set_{nullptr};
   std::unordered_set<const MTL::Allocation*> unwired_set_;
@@ -1,4 +1,5 @@
 // Copyright © 2024 Apple Inc.
+#include <cmath>
 #include <sstream>
 
 #include "mlx/backend/common/compiled.h"
@@ -23,7 +24,10 @@ void sdpa_full_self_attention_metal(
     array& o,
     bool do_causal_,
     const std::optional<array>& mask,
-    const std::optional<array>& sinks) {
+    const std::optional<array>& sinks,
+    const std::optional<mlx::steel::AttnRoPEParams>& rope_params =
+        std::nullopt,
+    const std::optional<array>& block_mask = std::nullopt) {
   using namespace mlx::steel;
 
   int wm = 4;
@@ -46,13 +50,17 @@ void sdpa_full_self_attention_metal(
   const bool has_mask = mask.has_value();
   const bool do_causal = do_causal_;
   const bool has_sinks = sinks.has_value();
+  const bool do_rope = rope_params.has_value();
+  const bool has_block_mask = block_mask.has_value();
 
   metal::MTLFCList func_consts = {
       {&align_Q, MTL::DataType::DataTypeBool, 200},
       {&align_K, MTL::DataType::DataTypeBool, 201},
       {&has_mask, MTL::DataType::DataTypeBool, 300},
       {&do_causal, MTL::DataType::DataTypeBool, 301},
-      {&has_sinks, MTL::DataType::DataTypeBool, 302}};
+      {&has_sinks, MTL::DataType::DataTypeBool, 302},
+      {&do_rope, MTL::DataType::DataTypeBool, 303},
+      {&has_block_mask, MTL::DataType::DataTypeBool, 304}};
 
   std::string base_name;
   concatenate(
@@ -85,7 +93,11 @@ void sdpa_full_self_attention_metal(
       "_do_causal_",
       (do_causal ? 't' : 'n'),
       "_has_sinks_",
-      (has_sinks ? 't' : 'n'));
+      (has_sinks ? 't' : 'n'),
+      "_do_rope_",
+      (do_rope ? 't' : 'n'),
+      "_block_mask_",
+      (has_block_mask ? 't' : 'n'));
 
   auto& compute_encoder = d.get_command_encoder(s.index);
   auto kernel = d.get_kernel(base_name, hash_name, func_consts);
@@ -141,6 +153,25 @@ void sdpa_full_self_attention_metal(
   if (has_sinks) {
     compute_encoder.set_input_array(*sinks, 7);
   }
+  if (do_rope) {
+    compute_encoder.set_bytes(*rope_params, 8);
+  }
+  if (has_block_mask) {
+    auto& bm = *block_mask;
+    constexpr int block_size = ScaledDotProductAttention::block_mask_size;
+    // bq = 32 and bk in {16, 32}: tiles never straddle table entries
+    static_assert(
+        block_size % 32 == 0 && block_size % 16 == 0,
+        "Attention tiles must not straddle block table entries");
+
+    AttnBlockMaskParams bmask_params{
+        /* int block_size = */ block_size,
+        /* int64_t M_strides[3] = */ {
+            bm.strides(0), bm.strides(1), bm.strides(2)}};
+
+    compute_encoder.set_bytes(bmask_params, 9);
+    compute_encoder.set_input_array(bm, 10);
+  }
 
   MTL::Size grid_dims = MTL::Size(NQ, H, B);
   MTL::Size group_dims = MTL::Size(32, wm, wn);
@@ -158,7 +189,8 @@ void sdpa_vector(
     float scale,
     bool do_causal,
     const std::optional<array>& mask,
-    const std::optional<array>& sinks) {
+    const std::optional<array>& sinks,
+    int window) {
   // Set the kernel name
   std::string kname;
   kname.reserve(64);
@@ -185,6 +217,7 @@ void sdpa_vector(
   bool float_mask = has_mask && !bool_mask;
   bool query_transposed = !q.flags().row_contiguous;
   bool has_sinks = sinks.has_value();
+  bool has_window = window > 0;
   metal::MTLFCList func_consts = {
       {&has_mask, MTL::DataType::DataTypeBool, 20},
       {&query_transposed, MTL::DataType::DataTypeBool, 21},
@@ -192,12 +225,14 @@ void sdpa_vector(
       {&bool_mask, MTL::DataType::DataTypeBool, 23},
       {&float_mask, MTL::DataType::DataTypeBool, 24},
       {&has_sinks, MTL::DataType::DataTypeBool, 25},
+      {&has_window, MTL::DataType::DataTypeBool, 26},
   };
   std::string hash_name = kname;
   hash_name += has_mask ? (bool_mask ? "_boolmask" : "_floatmask") : "_nomask";
   hash_name += query_transposed ? "_qt" : "_qnt";
   hash_name += do_causal ? "_c" : "_nc";
   hash_name += has_sinks ? "_sinks" : "_nosinks";
+  hash_name += has_window ? "_win" : "_nowin";
 
   // Get the kernel
   auto& compute_encoder = d.get_command_encoder(s.index);
@@ -232,6 +267,62 @@ void sdpa_vector(
     compute_encoder.set_input_array(*sinks, 16);
     compute_encoder.set_bytes(q.shape(1), 17);
   }
+  if (has_window) {
+    compute_encoder.set_bytes(window, 18);
+  }
+
+  // Launch
+  compute_encoder.dispatch_threadgroups(grid_dims, group_dims);
+}
+
+void sdpa_vector_paged(
+    const Stream& s,
+    metal::Device& d,
+    const array& q,
+    const array& k_pages,
+    const array& v_pages,
+    const array& page_table,
+    const array& context_lens,
+    array& out,
+    float scale) {
+  // Set the kernel name
+  std::string kname;
+  kname.reserve(64);
+  kname += "sdpa_vector_paged_";
+  kname += get_type_string(q.dtype());
+  kname += "_";
+  kname += std::to_string(q.shape(-1));
+  kname += "_";
+  kname += std::to_string(v_pages.shape(-1));
+
+  // Compute the necessary sizes
+  int num_q_heads = q.shape(1);
+  int n_kv_heads = k_pages.shape(1);
+  int gqa_factor = num_q_heads / n_kv_heads;
+  int page_size = k_pages.shape(2);
+  int max_pages = page_table.shape(1);
+
+  MTL::Size group_dims(1024, 1, 1);
+  MTL::Size grid_dims(q.shape(0) * q.shape(1), q.shape(2), 1);
+
+  // Get the kernel
+  auto& compute_encoder = d.get_command_encoder(s.index);
+  auto kernel = d.get_kernel(kname);
+  compute_encoder.set_compute_pipeline_state(kernel);
+
+  // Set its arguments
+  compute_encoder.set_input_array(q, 0);
+  compute_encoder.set_input_array(k_pages, 1);
+  compute_encoder.set_input_array(v_pages, 2);
+  compute_encoder.set_output_array(out, 3);
+  compute_encoder.set_input_array(page_table, 4);
+  compute_encoder.set_input_array(context_lens, 5);
+  compute_encoder.set_bytes(gqa_factor, 6);
+  compute_encoder.set_bytes(num_q_heads, 7);
+  compute_encoder.set_bytes(n_kv_heads, 8);
+  compute_encoder.set_bytes(page_size, 9);
+  compute_encoder.set_bytes(max_pages, 10);
+  compute_encoder.set_bytes(scale, 11);
 
   // Launch
   compute_encoder.dispatch_threadgroups(grid_dims, group_dims);
@@ -247,7 +338,8 @@ void sdpa_vector_2pass(
     float scale,
     bool do_causal,
     const std::optional<array>& mask,
-    const std::optional<array>& sinks) {
+    const std::optional<array>& sinks,
+    int window) {
   // Set the kernel name
   std::string kname;
   kname.reserve(64);
@@ -294,6 +386,7 @@ void sdpa_vector_2pass(
   bool float_mask = has_mask && !bool_mask;
   bool query_transposed = !q.flags().row_contiguous;
   bool has_sinks = sinks.has_value();
+  bool has_window = window > 0;
   metal::MTLFCList func_consts = {
       {&has_mask, MTL::DataType::DataTypeBool, 20},
       {&query_transposed, MTL::DataType::DataTypeBool, 21},
@@ -301,12 +394,14 @@ void sdpa_vector_2pass(
       {&bool_mask, MTL::DataType::DataTypeBool, 23},
       {&float_mask, MTL::DataType::DataTypeBool, 24},
       {&has_sinks, MTL::DataType::DataTypeBool, 25},
+      {&has_window, MTL::DataType::DataTypeBool, 26},
   };
   std::string hash_name = kname;
   hash_name += has_mask ? (bool_mask ? "_boolmask" : "_floatmask") : "_nomask";
   hash_name += query_transposed ? "_qt" : "_qnt";
   hash_name += do_causal ? "_c" : "_nc";
   hash_name += has_sinks ? "_sinks" : "_nosinks";
+  hash_name += has_window ? "_win" : "_nowin";
 
   // Get the kernel
   auto& compute_encoder = d.get_command_encoder(s.index);
@@ -343,6 +438,9 @@ void sdpa_vector_2pass(
     compute_encoder.set_input_array(*sinks, 18);
     compute_encoder.set_bytes(q.shape(1), 19);
   }
+  if (has_window) {
+    compute_encoder.set_bytes(window, 20);
+  }
 
   // Launch
   compute_encoder.dispatch_threadgroups(grid_dims, group_dims);
@@ -379,6 +477,7 @@ bool ScaledDotProductAttention::use_fallback(
     bool has_mask,
     bool has_arr_mask,
     bool do_causal,
+    bool do_block_sparse,
     Stream s) {
   if (detail::in_grad_tracing()) {
     return true;
@@ -409,6 +508,11 @@ bool ScaledDotProductAttention::use_fallback(
       (query_sequence_length <= key_sequence_length) &&
       sdpa_vector_supported_head_dim;
 
+  // Only the full kernel reads the block table
+  if (do_block_sparse) {
+    return !(query_sequence_length > 8 && sdpa_full_supported_head_dim);
+  }
+
   return !(supports_sdpa_full || supports_sdpa_vector);
 }
 
@@ -512,9 +616,10 @@ void ScaledDotProductAttention::eval_gpu(
     char devc = d.get_architecture().back();
     if ((devc == 'd' && k.shape(2) >= 1024) ||
         (k.shape(1) < q.shape(1) && k.shape(2) >= 4096)) {
-      sdpa_vector_2pass(s, d, q, k, v, o, scale_, do_causal, mask, sinks);
+      sdpa_vector_2pass(
+          s, d, q, k, v, o, scale_, do_causal, mask, sinks, window_);
     } else {
-      sdpa_vector(s, d, q, k, v, o, scale_, do_causal, mask, sinks);
+      sdpa_vector(s, d, q, k, v, o, scale_, do_causal, mask, sinks, window_);
     }
   }
 
@@ -542,15 +647,154 @@ void ScaledDotProductAttention::eval_gpu(
         {str_oB, str_oH, str_oL, str_oD},
         flags);
 
-    auto mask = has_arr_mask
+    auto is_row_contiguous = [](const array& arr) {
+      return arr.flags().row_contiguous;
+    };
+
+    // The array input is either an elementwise mask or, in block-sparse
+    // mode, the block table; the kernel indexes the table densely
+    auto mask = has_arr_mask && !block_sparse_
         ? std::optional<array>{copy_unless(is_matrix_contiguous, inputs[3])}
         : std::nullopt;
+    auto block_mask = has_arr_mask && block_sparse_
+        ? std::optional<array>{copy_unless(is_row_contiguous, inputs[3])}
+        : std::nullopt;
 
     sdpa_full_self_attention_metal(
-        s, d, q, k, v, scale_, o, do_causal_, mask, sinks);
+        s,
+        d,
+        q,
+        k,
+        v,
+        scale_,
+        o,
+        do_causal_,
+        mask,
+        sinks,
+        /* rope_params = */ std::nullopt,
+        block_mask);
   }
 
   d.add_temporaries(std::move(copies), s.index);
 }
 
+bool PagedAttention::use_fallback(Stream s) {
+  // Shape and head dim eligibility is checked before the primitive is
+  // constructed; here only the dispatch mode matters
+  return detail::in_grad_tracing() || s.device == Device::cpu;
+}
+
+void PagedAttention::eval_gpu(const std::vector<array>& inputs, array& out) {
+  auto& s = stream();
+  auto& d = metal::device(s.device);
+
+  std::vector<array> copies;
+  copies.reserve(inputs.size());
+
+  // The kernel indexes everything densely, so fall back to contiguous
+  // copies for oddly strided inputs
+  auto copy_unless_row_contiguous = [&copies, &s](const array& arr) -> const
+      array& {
+    if (arr.flags().row_contiguous) {
+      return arr;
+    }
+    array arr_copy = contiguous_copy_gpu(arr, s);
+    copies.push_back(std::move(arr_copy));
+    return copies.back();
+  };
+
+  const auto& q = copy_unless_row_contiguous(inputs[0]);
+  const auto& k_pages = copy_unless_row_contiguous(inputs[1]);
+  const auto& v_pages = copy_unless_row_contiguous(inputs[2]);
+  const auto& page_table = copy_unless_row_contiguous(inputs[3]);
+  const auto& context_lens = copy_unless_row_contiguous(inputs[4]);
+
+  // Donate the query if possible
+  if (q.is_donatable() && q.size() == out.size()) {
+    out.copy_shared_buffer(q);
+  } else {
+    out.set_data(allocator::malloc(out.nbytes()));
+  }
+
+  sdpa_vector_paged(
+      s, d, q, k_pages, v_pages, page_table, context_lens, out, scale_);
+
+  d.add_temporaries(std::move(copies), s.index);
+}
+
+bool RoPEAttention::use_fallback(Stream s) {
+  // Shape and head dim eligibility is checked before the primitive is
+  // constructed; here only the dispatch mode matters
+  return detail::in_grad_tracing() || s.device == Device::cpu;
+}
+
+void RoPEAttention::eval_gpu(const std::vector<array>& inputs, array& out) {
+  auto& s = stream();
+  auto& d = metal::device(s.device);
+
+  auto& o = out;
+
+  std::vector<array> copies;
+  copies.reserve(inputs.size());
+  auto copy_unless = [&copies, &s](
+                         auto predicate, const array& arr) -> const array& {
+    if (!predicate(arr)) {
+      array arr_copy = contiguous_copy_gpu(arr, s);
+      copies.push_back(std::move(arr_copy));
+      return copies.back();
+    } else {
+      return arr;
+    }
+  };
+
+  // Checks that the headdim dimension has stride 1.
+  auto is_matrix_contiguous = [](const array& arr) {
+    return arr.strides(-1) == 1;
+  };
+
+  const auto& q = copy_unless(is_matrix_contiguous, inputs[0]);
+  const auto& k = copy_unless(is_matrix_contiguous, inputs[1]);
+  const auto& v = copy_unless(is_matrix_contiguous, inputs[2]);
+
+  int64_t str_oD = 1;
+  int64_t str_oH = o.shape(3);
+  int64_t str_oL = o.shape(1) * str_oH;
+  int64_t str_oB = o.shape(2) * str_oL;
+  size_t data_size = o.shape(0) * str_oB;
+
+  array::Flags flags{
+      /* bool contiguous = */ 1,
+      /* bool row_contiguous = */ 0,
+      /* bool col_contiguous = */ 0,
+  };
+
+  o.set_data(
+      allocator::malloc(o.nbytes()),
+      data_size,
+      {str_oB, str_oH, str_oL, str_oD},
+      flags);
+
+  mlx::steel::AttnRoPEParams rope_params{
+      /* int dims = */ dims_,
+      /* int offset = */ offset_,
+      /* float base = */ std::log2(base_),
+      /* float scale = */ rope_scale_,
+      /* bool traditional = */ traditional_};
+
+  sdpa_full_self_attention_metal(
+      s,
+      d,
+      q,
+      k,
+      v,
+      scale_,
+      o,
+      do_causal_,
+      /* mask= */ std::nullopt,
+      /* sinks= */ std::nullopt,
+      rope_params);
+
+  d.add_temporaries(std::move(copies), s.index);
+}
+
 } // namespace mlx::core::fast
@@ -3,6 +3,7 @@
 #include <numeric>
 
 #include "mlx/backend/common/compiled.h"
+#include "mlx/backend/common/slicing.h"
 #include "mlx/backend/gpu/copy.h"
 #include "mlx/backend/gpu/slicing.h"
 #include "mlx/backend/metal/device.h"
@@ -16,6 +17,9 @@ void concatenate_gpu(
     array& out,
     int axis,
     const Stream& s) {
+  if (concatenate_as_view(inputs, out, axis)) {
+    return;
+  }
   std::vector<int> sizes;
   sizes.push_back(0);
   for (auto& p : inputs) {
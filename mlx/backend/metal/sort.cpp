@@ -4,6 +4,7 @@
 
 #include "mlx/backend/gpu/copy.h"
 #include "mlx/backend/metal/device.h"
+#include "mlx/backend/metal/jit/includes.h"
 #include "mlx/backend/metal/kernels.h"
 #include "mlx/backend/metal/utils.h"
 #include "mlx/primitives.h"
@@ -313,6 +314,100 @@ void gpu_merge_sort(
   }
 }
 
+constexpr const char* block_radix_select_kernel = R"(
+// Map a float onto a uint whose unsigned order matches the float order
+inline uint radix_key(float x) {
+  uint b = as_type<uint>(x);
+  return b ^ (((b >> 31) != 0) ? 0xFFFFFFFFu : 0x80000000u);
+}
+
+template <typename T>
+[[kernel]] void block_radix_select(
+    const device T* in [[buffer(0)]],
+    device T* out [[buffer(1)]],
+    constant const int& size_sorted_axis [[buffer(2)]],
+    constant const int& kth [[buffer(3)]],
+    uint3 tgid [[threadgroup_position_in_grid]],
+    uint tid [[thread_index_in_threadgroup]],
+    uint tg_size [[threads_per_threadgroup]]) {
+  in += size_t(tgid.y) * size_sorted_axis;
+  out += size_t(tgid.y) * size_sorted_axis;
+
+  threadgroup atomic_uint hist[256];
+  threadgroup uint sel[2];
+
+  // Find the key of the kth smallest element one byte per pass, keeping
+  // only the elements that match the bytes selected so far
+  uint prefix = 0;
+  uint rank = uint(kth);
+  for (int shift = 24; shift >= 0; shift -= 8) {
+    for (uint b = tid; b < 256; b += tg_size) {
+      atomic_store_explicit(&hist[b], 0u, memory_order_relaxed);
+    }
+    threadgroup_barrier(mem_flags::mem_threadgroup);
+    uint pmask = (shift == 24) ? 0u : (0xFFFFFFFFu << (shift + 8));
+    for (uint i = tid; i < uint(size_sorted_axis); i += tg_size) {
+      uint key = radix_key(static_cast<float>(in[i]));
+      if ((key & pmask) == prefix) {
+        atomic_fetch_add_explicit(
+            &hist[(key >> shift) & 0xFF], 1u, memory_order_relaxed);
+      }
+    }
+    threadgroup_barrier(mem_flags::mem_threadgroup);
+    if (tid == 0) {
+      uint cum = 0;
+      for (uint b = 0; b < 256; ++b) {
+        uint c = atomic_load_explicit(&hist[b], memory_order_relaxed);
+        if (cum + c > rank) {
+          sel[0] = b;
+          sel[1] = rank - cum;
+          break;
+        }
+        cum += c;
+      }
+    }
+    threadgroup_barrier(mem_flags::mem_threadgroup);
+    prefix |= sel[0] << shift;
+    rank = sel[1];
+  }
+  uint pivot = prefix;
+
+  // Count the elements on each side of the pivot
+  threadgroup atomic_uint cursors[3];
+  if (tid < 2) {
+    atomic_store_explicit(&cursors[tid], 0u, memory_order_relaxed);
+  }
+  threadgroup_barrier(mem_flags::mem_threadgroup);
+  for (uint i = tid; i < uint(size_sorted_axis); i += tg_size) {
+    uint key = radix_key(static_cast<float>(in[i]));
+    if (key < pivot) {
+      atomic_fetch_add_explicit(&cursors[0], 1u, memory_order_relaxed);
+    } else if (key == pivot) {
+      atomic_fetch_add_explicit(&cursors[1], 1u, memory_order_relaxed);
+    }
+  }
+  threadgroup_barrier(mem_flags::mem_threadgroup);
+  if (tid == 0) {
+    uint less = atomic_load_explicit(&cursors[0], memory_order_relaxed);
+    uint equal = atomic_load_explicit(&cursors[1], memory_order_relaxed);
+    atomic_store_explicit(&cursors[0], 0u, memory_order_relaxed);
+    atomic_store_explicit(&cursors[1], less, memory_order_relaxed);
+    atomic_store_explicit(&cursors[2], less + equal, memory_order_relaxed);
+  }
+  threadgroup_barrier(mem_flags::mem_threadgroup);
+
+  // Scatter into the three regions; order within a region is unspecified
+  // just as with nth_element
+  for (uint i = tid; i < uint(size_sorted_axis); i += tg_size) {
+    T x = in[i];
+    uint key = radix_key(static_cast<float>(x));
+    int r = key < pivot ? 0 : (key == pivot ? 1 : 2);
+    uint dst = atomic_fetch_add_explicit(&cursors[r], 1u, memory_order_relaxed);
+    out[dst] = x;
+  }
+}
+)";
+
 } // namespace
 
 void ArgSort::eval_gpu(const std::vector<array>& inputs, array& out) {
@@ -353,7 +448,6 @@ void ArgPartition::eval_gpu(const std::vector<array>& inputs, array& out) {
 }
 
 void Partition::eval_gpu(const std::vector<array>& inputs, array& out) {
-  // We direct partition to sort for now
   assert(inputs.size() == 1);
 
   out.set_data(allocator::malloc(out.nbytes()));
@@ -362,6 +456,37 @@ void Partition::eval_gpu(const std::vector<array>& inputs, array& out) {
   auto& d = metal::device(s.device);
   auto& in = inputs[0];
 
+  // Radix select long contiguous rows of floating point data (e.g. top-k
+  // over sampler logits) instead of paying for a full merge sort
+  int n = in.shape(axis_);
+  bool select_dtype =
+      in.dtype() == float32 || in.dtype() == float16 || in.dtype() == bfloat16;
+  if (select_dtype && in.flags().row_contiguous &&
+      axis_ == static_cast<int>(in.ndim()) - 1 && n >= 1024) {
+    int n_rows = in.size() / n;
+
+    std::string kname = "block_radix_select_" + type_to_name(in);
+    auto lib = d.get_library(kname, [&]() {
+      return metal::utils() + block_radix_select_kernel +
+          get_template_definition(
+                 kname, "block_radix_select", get_type_string(in.dtype()));
+    });
+    auto kernel = d.get_kernel(kname, lib);
+
+    auto& compute_encoder = d.get_command_encoder(s.index);
+    compute_encoder.set_compute_pipeline_state(kernel);
+    compute_encoder.set_input_array(in, 0);
+    compute_encoder.set_output_array(out, 1);
+    compute_encoder.set_bytes(n, 2);
+    compute_encoder.set_bytes(kth_, 3);
+
+    MTL::Size group_dims(256, 1, 1);
+    MTL::Size grid_dims(1, n_rows, 1);
+    compute_encoder.dispatch_threadgroups(grid_dims, group_dims);
+    return;
+  }
+
+  // Direct the general case to sort
   gpu_merge_sort(s, d, in, out, axis_, false);
 }
 
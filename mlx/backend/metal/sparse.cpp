@@ -0,0 +1,86 @@
+// Copyright © 2025 Apple Inc.
+
+#include "mlx/backend/gpu/copy.h"
+#include "mlx/backend/metal/device.h"
+#include "mlx/backend/metal/jit/includes.h"
+#include "mlx/backend/metal/kernels.h"
+#include "mlx/backend/metal/utils.h"
+#include "mlx/primitives.h"
+
+namespace mlx::core {
+
+constexpr const char* sparse_matmul_kernel = R"(
+template <typename T>
+[[kernel]] void sparse_matmul(
+    const device int* indptr [[buffer(0)]],
+    const device int* indices [[buffer(1)]],
+    const device T* data [[buffer(2)]],
+    const device T* b [[buffer(3)]],
+    device T* out [[buffer(4)]],
+    constant const int& N [[buffer(5)]],
+    uint2 pos [[thread_position_in_grid]]) {
+  // One thread per output element: reduce the row's segment of nonzeros
+  // against a dense column of b. Adjacent threads read adjacent columns
+  // so the gathered rows of b are loaded coalesced.
+  int row = pos.y;
+  int col = pos.x;
+  float acc = 0;
+  for (int j = indptr[row]; j < indptr[row + 1]; j++) {
+    acc += static_cast<float>(data[j]) *
+        static_cast<float>(b[static_cast<size_t>(indices[j]) * N + col]);
+  }
+  out[static_cast<size_t>(row) * N + col] = static_cast<T>(acc);
+}
+)";
+
+void SparseMatmul::eval_gpu(const std::vector<array>& inputs, array& out) {
+  auto& s = stream();
+  auto& d = metal::device(s.device);
+
+  out.set_data(allocator::malloc(out.nbytes()));
+  if (out.size() == 0) {
+    return;
+  }
+
+  std::vector<array> copies;
+  auto ensure_row_contiguous = [&](const array& x) {
+    if (x.flags().row_contiguous) {
+      return x;
+    }
+    auto xc = contiguous_copy_gpu(x, s);
+    copies.push_back(xc);
+    return xc;
+  };
+
+  auto indptr = ensure_row_contiguous(inputs[0]);
+  auto indices = ensure_row_contiguous(inputs[1]);
+  auto data = ensure_row_contiguous(inputs[2]);
+  auto b = ensure_row_contiguous(inputs[3]);
+
+  int M = out.shape(0);
+  int N = out.shape(1);
+
+  std::string kname = "sparse_matmul_" + type_to_name(out);
+  auto lib = d.get_library(kname, [&]() {
+    return metal::utils() + sparse_matmul_kernel +
+        get_template_definition(
+            kname, "sparse_matmul", get_type_string(out.dtype()));
+  });
+  auto kernel = d.get_kernel(kname, lib);
+
+  auto& compute_encoder = d.get_command_encoder(s.index);
+  compute_encoder.set_compute_pipeline_state(kernel);
+  compute_encoder.set_input_array(indptr, 0);
+  compute_encoder.set_input_array(indices, 1);
+  compute_encoder.set_input_array(data, 2);
+  compute_encoder.set_input_array(b, 3);
+  compute_encoder.set_output_array(out, 4);
+  compute_encoder.set_bytes(N, 5);
+
+  MTL::Size group_dims(std::min(N, 256), 1, 1);
+  MTL::Size grid_dims(N, M, 1);
+  compute_encoder.dispatch_threads(grid_dims, group_dims);
+  d.add_temporaries(std::move(copies), s.index);
+}
+
+} // namespace mlx::core
@@ -150,4 +150,12 @@ void Select::eval_gpu(const std::vector<array>& inputs, array& out) {
   ternary_op_gpu(inputs, out, name());
 }
 
+void MaskedAdd::eval_gpu(const std::vector<array>& inputs, array& out) {
+  ternary_op_gpu(inputs, out, name());
+}
+
+void MaskedMultiply::eval_gpu(const std::vector<array>& inputs, array& out) {
+  ternary_op_gpu(inputs, out, name());
+}
+
 } // namespace mlx::core
@@ -2,6 +2,7 @@
 
 #include "mlx/backend/common/unary.h"
 #include "mlx/backend/metal/device.h"
+#include "mlx/backend/metal/elementwise_tuner.h"
 #include "mlx/backend/metal/kernels.h"
 #include "mlx/backend/metal/utils.h"
 #include "mlx/primitives.h"
@@ -13,6 +14,54 @@
 
 namespace mlx::core {
 
+namespace {
+
+// Pick between the scalar and vectorized contiguous kernels by timing
+// both on this device. The key leaves the op out: these kernels are
+// bandwidth bound so the winner measured with whichever op arrives
+// first holds for the rest.
+int tuned_unary_work_per_thread(
+    metal::Device& d,
+    const Stream& s,
+    const array& in,
+    const array& out,
+    const char* op,
+    int work_per_thread) {
+  std::string key;
+  concatenate(
+      key,
+      "unary_",
+      type_to_name(in),
+      type_to_name(out),
+      "_n",
+      work_size_bucket(in.data_size()));
+  auto encode_one = [&](int wpt, MTL::ComputeCommandEncoder* enc) {
+    std::string kernel_name = wpt > 1 ? "vn" : "v";
+    concatenate(kernel_name, "_", op, type_to_name(in), type_to_name(out));
+    auto kernel = get_unary_kernel(d, kernel_name, in.dtype(), out.dtype(), op);
+    enc->setComputePipelineState(kernel);
+    auto buf = [](const array& x) {
+      return static_cast<const MTL::Buffer*>(x.buffer().ptr());
+    };
+    auto buf_offset = [&](const array& x) {
+      return x.data<char>() -
+          static_cast<char*>(const_cast<MTL::Buffer*>(buf(x))->contents());
+    };
+    enc->setBuffer(buf(in), buf_offset(in), 0);
+    enc->setBuffer(buf(out), buf_offset(out), 1);
+    int size = in.data_size();
+    enc->setBytes(&size, sizeof(int), 2);
+    size_t nthreads = ceildiv(in.data_size(), wpt);
+    auto tg = std::min(
+        kernel->maxTotalThreadsPerThreadgroup(), NS::UInteger(nthreads));
+    enc->dispatchThreads(MTL::Size(nthreads, 1, 1), MTL::Size(tg, 1, 1));
+  };
+  return tuned_work_per_thread(
+      d, s, key, {1, work_per_thread}, encode_one, work_per_thread);
+}
+
+} // namespace
+
 void unary_op_gpu_inplace(
     const std::vector<array>& inputs,
     array& out,
@@ -45,6 +94,10 @@ void unary_op_gpu_inplace(
   std::string kernel_name;
   if (contig) {
     work_per_thread = get_work_per_thread(in.dtype(), in.data_size());
+    if (!large && work_per_thread > 1 && elementwise_tuning_enabled()) {
+      work_per_thread = tuned_unary_work_per_thread(
+          d, s, in, out, op, work_per_thread);
+    }
     kernel_name = (large ? "v2" : (work_per_thread > 1 ? "vn" : "v"));
   } else {
     work_per_thread = large ? 4 : 1;
@@ -33,6 +33,7 @@ NO_CPU(ArgReduce)
 NO_CPU(ArgSort)
 NO_CPU(AsType)
 NO_CPU(AsStrided)
+NO_CPU(Bincount)
 NO_CPU(BitwiseBinary)
 NO_CPU(BitwiseInvert)
 NO_CPU(BlockMaskedMM)
@@ -85,6 +86,8 @@ NO_CPU(LogicalOr)
 NO_CPU(LogAddExp)
 NO_CPU(LogSumExp)
 NO_CPU_MULTI(LUF)
+NO_CPU(MaskedAdd)
+NO_CPU(MaskedMultiply)
 NO_CPU(Matmul)
 NO_CPU(Maximum)
 NO_CPU(Minimum)
@@ -114,6 +117,7 @@ NO_CPU(Slice)
 NO_CPU(SliceUpdate)
 NO_CPU(Softmax)
 NO_CPU(Sort)
+NO_CPU(SparseMatmul)
 NO_CPU_MULTI(Split)
 NO_CPU(Square)
 NO_CPU(Squeeze)
@@ -129,6 +133,7 @@ NO_CPU(Inverse)
 NO_CPU(View)
 
 namespace fast {
+NO_CPU_MULTI(CrossEntropy)
 NO_CPU_MULTI(Quantize)
 } // namespace fast
 
@@ -1,9 +1,19 @@
 // Copyright © 2023 Apple Inc.
 
+#include <sys/mman.h>
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 #include <algorithm>
 #include <mutex>
 
 #include "mlx/allocator.h"
+#include "mlx/backend/common/numa.h"
+#include "mlx/device.h"
+#include "mlx/memory.h"
 
 #ifdef __APPLE__
 #include "mlx/backend/no_gpu/apple_memory.h"
@@ -19,12 +29,51 @@ namespace mlx::core {
 
 namespace allocator {
 
+// Tag bit in the size header marking blocks that wrap external memory. The
+// header of a wrapped block is followed by the external pointer instead of
+// the data itself.
+constexpr size_t external_flag = size_t(1) << (8 * sizeof(size_t) - 1);
+
+// Tag bit in the size header marking wired blocks, which are mmap'd and
+// pinned instead of malloc'd.
+constexpr size_t wired_flag = size_t(1) << (8 * sizeof(size_t) - 2);
+
+// Tag bit in the size header marking blocks that are mmap'd but not
+// pinned, e.g. for NUMA interleaving.
+constexpr size_t mapped_flag = size_t(1) << (8 * sizeof(size_t) - 3);
+
+constexpr size_t flag_mask = external_flag | wired_flag | mapped_flag;
+
+// Buffers at least this large are spread across the NUMA nodes when
+// interleaving is on; smaller ones stay on the first-touch node.
+constexpr size_t interleave_threshold = 1UL << 21;
+
+#if defined(__linux__)
+// Best-effort: interleave the pages of [ptr, ptr + size) round-robin over
+// the NUMA nodes. Issues the raw mbind syscall rather than growing a
+// libnuma dependency, and must run before the pages are first touched.
+void interleave_pages(void* ptr, size_t size) {
+  constexpr long mpol_interleave = 3; // MPOL_INTERLEAVE
+  unsigned long nodemask = (1UL << numa_node_cpus().size()) - 1;
+  syscall(
+      SYS_mbind,
+      ptr,
+      size,
+      mpol_interleave,
+      &nodemask,
+      8 * sizeof(nodemask),
+      0);
+}
+#endif
+
 class CommonAllocator : public Allocator {
   /** A general CPU allocator. */
  public:
   virtual Buffer malloc(size_t size) override;
   virtual void free(Buffer buffer) override;
   virtual size_t size(Buffer buffer) const override;
+  virtual Buffer wrap_external(void* ptr, size_t size) override;
+  virtual Buffer malloc_wired(size_t size) override;
   size_t get_active_memory() const {
     return active_memory_;
   };
@@ -71,13 +120,37 @@ void* Buffer::raw_ptr() {
   if (!ptr_) {
     return nullptr;
   }
+  if (*static_cast<size_t*>(ptr_) & external_flag) {
+    return *reinterpret_cast<void**>(static_cast<size_t*>(ptr_) + 1);
+  }
   return static_cast<size_t*>(ptr_) + 1;
 }
 
 Buffer CommonAllocator::malloc(size_t size) {
-  void* ptr = std::malloc(size + sizeof(size_t));
-  if (ptr != nullptr) {
-    *static_cast<size_t*>(ptr) = size;
+  size_t total = size + sizeof(size_t);
+  void* ptr = nullptr;
+#if defined(__linux__)
+  if (numa_interleave() && size >= interleave_threshold) {
+    ptr = mmap(
+        nullptr,
+        total,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS,
+        -1,
+        0);
+    if (ptr == MAP_FAILED) {
+      ptr = nullptr;
+    } else {
+      interleave_pages(ptr, total);
+      *static_cast<size_t*>(ptr) = size | mapped_flag;
+    }
+  }
+#endif
+  if (ptr == nullptr) {
+    ptr = std::malloc(total);
+    if (ptr != nullptr) {
+      *static_cast<size_t*>(ptr) = size;
+    }
   }
   std::unique_lock lk(mutex_);
   active_memory_ += size;
@@ -86,8 +159,24 @@ Buffer CommonAllocator::malloc(size_t size) {
 }
 
 void CommonAllocator::free(Buffer buffer) {
+  if (buffer.ptr() == nullptr) {
+    return;
+  }
+  auto header = *static_cast<size_t*>(buffer.ptr());
   auto sz = size(buffer);
-  std::free(buffer.ptr());
+  if (header & external_flag) {
+    std::free(buffer.ptr());
+    return;
+  }
+  if (header & wired_flag) {
+    size_t total = sz + sizeof(size_t);
+    munlock(buffer.ptr(), total);
+    munmap(buffer.ptr(), total);
+  } else if (header & mapped_flag) {
+    munmap(buffer.ptr(), sz + sizeof(size_t));
+  } else {
+    std::free(buffer.ptr());
+  }
   std::unique_lock lk(mutex_);
   active_memory_ -= sz;
 }
@@ -96,7 +185,51 @@ size_t CommonAllocator::size(Buffer buffer) const {
   if (buffer.ptr() == nullptr) {
     return 0;
   }
-  return *static_cast<size_t*>(buffer.ptr());
+  return *static_cast<size_t*>(buffer.ptr()) & ~flag_mask;
+}
+
+Buffer CommonAllocator::malloc_wired(size_t size) {
+  size_t total = size + sizeof(size_t);
+  void* ptr = mmap(
+      nullptr,
+      total,
+      PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS,
+      -1,
+      0);
+  if (ptr == MAP_FAILED) {
+    return Buffer{nullptr};
+  }
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  madvise(ptr, total, MADV_HUGEPAGE);
+#endif
+#if defined(__linux__)
+  // Set the placement policy before mlock faults the pages in
+  if (numa_interleave() && size >= interleave_threshold) {
+    interleave_pages(ptr, total);
+  }
+#endif
+  // Best effort; RLIMIT_MEMLOCK may cap how much can be pinned
+  mlock(ptr, total);
+  *static_cast<size_t*>(ptr) = size | wired_flag;
+  std::unique_lock lk(mutex_);
+  active_memory_ += size;
+  peak_memory_ = std::max(active_memory_, peak_memory_);
+  return Buffer{ptr};
+}
+
+Buffer CommonAllocator::wrap_external(void* ptr, size_t size) {
+  if (ptr == nullptr || size == 0) {
+    return Buffer{nullptr};
+  }
+  // The holder is the size header followed by the external pointer; the
+  // external memory itself is untouched and stays with the caller
+  void* holder = std::malloc(sizeof(size_t) + sizeof(void*));
+  if (holder != nullptr) {
+    *static_cast<size_t*>(holder) = size | external_flag;
+    *reinterpret_cast<void**>(static_cast<size_t*>(holder) + 1) = ptr;
+  }
+  return Buffer{holder};
 }
 
 } // namespace allocator
@@ -121,12 +254,20 @@ size_t get_memory_limit() {
 size_t get_cache_memory() {
   return 0;
 }
+CacheStats get_cache_stats() {
+  return {};
+}
+void reset_cache_stats() {}
 size_t set_cache_limit(size_t) {
   return 0;
 }
+size_t set_rss_watermark(size_t) {
+  return 0;
+}
 size_t set_wired_limit(size_t) {
   return 0;
 }
 void clear_cache() {}
+void prefetch(const array&, Device) {}
 
 } // namespace mlx::core
@@ -30,6 +30,39 @@ bool fast::ScaledDotProductAttention::use_fallback(
     bool has_mask,
     bool has_arr_mask,
     bool do_causal,
+    bool do_block_sparse,
+    Stream s) {
+  return true;
+}
+
+bool fast::PagedAttention::use_fallback(Stream s) {
+  return true;
+}
+
+bool fast::RoPEAttention::use_fallback(Stream s) {
+  return true;
+}
+
+bool fast::ScaledMatmul::use_fallback(Stream s) {
+  return true;
+}
+
+bool fast::SwiGLUMLP::use_fallback(Stream s) {
+  return true;
+}
+
+bool fast::RMSNormMatmul::use_fallback(
+    const array& x,
+    const array& w,
+    Stream s) {
+  return true;
+}
+
+bool fast::QuantizedSDPA::use_fallback(
+    const array& q,
+    const array& k,
+    int group_size,
+    int bits,
     Stream s) {
   return true;
 }
@@ -50,6 +83,7 @@ NO_GPU(ArgReduce)
 NO_GPU(ArgSort)
 NO_GPU(AsType)
 NO_GPU(AsStrided)
+NO_GPU(Bincount)
 NO_GPU(BitwiseBinary)
 NO_GPU(BitwiseInvert)
 NO_GPU(BlockMaskedMM)
@@ -101,6 +135,8 @@ NO_GPU(LogicalOr)
 NO_GPU(LogAddExp)
 NO_GPU(LogSumExp)
 NO_GPU_MULTI(LUF)
+NO_GPU(MaskedAdd)
+NO_GPU(MaskedMultiply)
 NO_GPU(Matmul)
 NO_GPU(Maximum)
 NO_GPU(Minimum)
@@ -122,6 +158,7 @@ NO_GPU(Scatter)
 NO_GPU(ScatterAxis)
 NO_GPU(Select)
 NO_GPU(SegmentedMM)
+NO_GPU(SparseMatmul)
 NO_GPU(Sigmoid)
 NO_GPU(Sign)
 NO_GPU(Sin)
@@ -154,6 +191,12 @@ NO_GPU_USE_FALLBACK(RMSNorm)
 NO_GPU_MULTI(RMSNormVJP)
 NO_GPU_USE_FALLBACK(RoPE)
 NO_GPU(ScaledDotProductAttention)
+NO_GPU(PagedAttention)
+NO_GPU(RoPEAttention)
+NO_GPU(ScaledMatmul)
+NO_GPU(SwiGLUMLP)
+NO_GPU(RMSNormMatmul)
+NO_GPU(QuantizedSDPA)
 NO_GPU_MULTI(Quantize)
 NO_GPU_MULTI(CustomKernel)
 } // namespace fast
@@ -161,6 +204,8 @@ NO_GPU_MULTI(CustomKernel)
 namespace distributed {
 NO_GPU_MULTI(AllReduce)
 NO_GPU_MULTI(AllGather)
+NO_GPU_MULTI(ReduceScatter)
+NO_GPU_MULTI(Broadcast)
 NO_GPU_MULTI(Send)
 NO_GPU_MULTI(Recv)
 } // namespace distributed
@@ -0,0 +1,246 @@
+// Copyright © 2026 Apple Inc.
+
+#include <cstring>
+
+#include "mlx/c_api.h"
+#include "mlx/allocator.h"
+#include "mlx/export.h"
+#include "mlx/ops.h"
+#include "mlx/transforms.h"
+
+using namespace mlx::core;
+
+struct mlx_array_s {
+  array arr;
+};
+
+struct mlx_imported_function_s {
+  ImportedFunction fun;
+};
+
+namespace {
+
+thread_local std::string last_error;
+
+void set_last_error(const char* where, const std::exception& e) {
+  last_error = std::string(where) + ": " + e.what();
+}
+
+Dtype to_dtype(mlx_dtype dtype) {
+  switch (dtype) {
+    case MLX_BOOL:
+      return bool_;
+    case MLX_UINT8:
+      return uint8;
+    case MLX_UINT16:
+      return uint16;
+    case MLX_UINT32:
+      return uint32;
+    case MLX_UINT64:
+      return uint64;
+    case MLX_INT8:
+      return int8;
+    case MLX_INT16:
+      return int16;
+    case MLX_INT32:
+      return int32;
+    case MLX_INT64:
+      return int64;
+    case MLX_FLOAT16:
+      return float16;
+    case MLX_FLOAT32:
+      return float32;
+    case MLX_FLOAT64:
+      return float64;
+    case MLX_BFLOAT16:
+      return bfloat16;
+    case MLX_COMPLEX64:
+      return complex64;
+    default:
+      throw std::invalid_argument("[mlx_c_api] Unknown dtype.");
+  }
+}
+
+mlx_dtype from_dtype(Dtype dtype) {
+  switch (dtype.val()) {
+    case Dtype::Val::bool_:
+      return MLX_BOOL;
+    case Dtype::Val::uint8:
+      return MLX_UINT8;
+    case Dtype::Val::uint16:
+      return MLX_UINT16;
+    case Dtype::Val::uint32:
+      return MLX_UINT32;
+    case Dtype::Val::uint64:
+      return MLX_UINT64;
+    case Dtype::Val::int8:
+      return MLX_INT8;
+    case Dtype::Val::int16:
+      return MLX_INT16;
+    case Dtype::Val::int32:
+      return MLX_INT32;
+    case Dtype::Val::int64:
+      return MLX_INT64;
+    case Dtype::Val::float16:
+      return MLX_FLOAT16;
+    case Dtype::Val::float32:
+      return MLX_FLOAT32;
+    case Dtype::Val::float64:
+      return MLX_FLOAT64;
+    case Dtype::Val::bfloat16:
+      return MLX_BFLOAT16;
+    case Dtype::Val::complex64:
+      return MLX_COMPLEX64;
+  }
+  throw std::invalid_argument("[mlx_c_api] Unknown dtype.");
+}
+
+Shape to_shape(const int* shape, int ndim) {
+  if (ndim < 0 || (ndim > 0 && shape == nullptr)) {
+    throw std::invalid_argument("[mlx_c_api] Invalid shape.");
+  }
+  return Shape(shape, shape + ndim);
+}
+
+} // namespace
+
+extern "C" {
+
+const char* mlx_last_error(void) {
+  return last_error.empty() ? nullptr : last_error.c_str();
+}
+
+mlx_array* mlx_array_from_data(
+    const void* data,
+    const int* shape,
+    int ndim,
+    mlx_dtype dtype) {
+  try {
+    auto type = to_dtype(dtype);
+    array arr(to_shape(shape, ndim), type, nullptr, {});
+    arr.set_data(allocator::malloc(arr.nbytes()));
+    std::memcpy(arr.data<char>(), data, arr.nbytes());
+    arr.set_status(array::Status::available);
+    return new mlx_array_s{std::move(arr)};
+  } catch (const std::exception& e) {
+    set_last_error("mlx_array_from_data", e);
+    return nullptr;
+  }
+}
+
+mlx_array* mlx_array_wrap(
+    void* data,
+    const int* shape,
+    int ndim,
+    mlx_dtype dtype,
+    void (*deleter)(void*)) {
+  try {
+    auto type = to_dtype(dtype);
+    array arr(to_shape(shape, ndim), type, nullptr, {});
+    auto buf = allocator::wrap_external(data, arr.nbytes());
+    arr.set_data(buf, [deleter, data](allocator::Buffer b) {
+      allocator::free(b);
+      if (deleter != nullptr) {
+        deleter(data);
+      }
+    });
+    // The caller can still see this memory; never donate it to an output
+    arr.set_data_not_donatable();
+    arr.set_status(array::Status::available);
+    return new mlx_array_s{std::move(arr)};
+  } catch (const std::exception& e) {
+    set_last_error("mlx_array_wrap", e);
+    return nullptr;
+  }
+}
+
+void mlx_array_free(mlx_array* arr) {
+  delete arr;
+}
+
+int mlx_array_ndim(const mlx_array* arr) {
+  return arr->arr.ndim();
+}
+
+const int* mlx_array_shape(const mlx_array* arr) {
+  return arr->arr.shape().data();
+}
+
+mlx_dtype mlx_array_dtype(const mlx_array* arr) {
+  return from_dtype(arr->arr.dtype());
+}
+
+size_t mlx_array_size(const mlx_array* arr) {
+  return arr->arr.size();
+}
+
+size_t mlx_array_nbytes(const mlx_array* arr) {
+  return arr->arr.nbytes();
+}
+
+int mlx_array_eval(mlx_array* arr) {
+  try {
+    arr->arr.eval();
+    return 0;
+  } catch (const std::exception& e) {
+    set_last_error("mlx_array_eval", e);
+    return -1;
+  }
+}
+
+const void* mlx_array_data(mlx_array* arr) {
+  try {
+    arr->arr.eval();
+    if (!arr->arr.flags().row_contiguous) {
+      throw std::runtime_error(
+          "[mlx_array_data] Array is not contiguous; copy it first.");
+    }
+    return arr->arr.data<void>();
+  } catch (const std::exception& e) {
+    set_last_error("mlx_array_data", e);
+    return nullptr;
+  }
+}
+
+mlx_imported_function* mlx_import_function(const char* file) {
+  try {
+    return new mlx_imported_function_s{import_function(file)};
+  } catch (const std::exception& e) {
+    set_last_error("mlx_import_function", e);
+    return nullptr;
+  }
+}
+
+void mlx_imported_function_free(mlx_imported_function* fun) {
+  delete fun;
+}
+
+int mlx_imported_function_call(
+    const mlx_imported_function* fun,
+    const mlx_array* const* inputs,
+    int num_inputs,
+    mlx_array** outputs,
+    int max_outputs,
+    int* num_outputs) {
+  try {
+    Args args;
+    args.reserve(num_inputs);
+    for (int i = 0; i < num_inputs; ++i) {
+      args.push_back(inputs[i]->arr);
+    }
+    auto results = fun->fun(args);
+    if (num_outputs != nullptr) {
+      *num_outputs = static_cast<int>(results.size());
+    }
+    int n = std::min(static_cast<int>(results.size()), max_outputs);
+    for (int i = 0; i < n; ++i) {
+      outputs[i] = new mlx_array_s{std::move(results[i])};
+    }
+    return 0;
+  } catch (const std::exception& e) {
+    set_last_error("mlx_imported_function_call", e);
+    return -1;
+  }
+}
+
+} // extern "C"
@@ -0,0 +1,100 @@
+// Copyright © 2026 Apple Inc.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// A minimal C API for embedding MLX from languages with C FFI. Arrays are
+// created or wrapped without copying, functions exported with
+// `export_function` are imported and called, and results are read back
+// through zero-copy buffer access. All functions are thread safe to the
+// same extent as the underlying C++ API.
+//
+// Functions returning an int return 0 on success and -1 on failure;
+// functions returning a pointer return NULL on failure. In both cases
+// `mlx_last_error` returns a thread-local description of the failure.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct mlx_array_s mlx_array;
+typedef struct mlx_imported_function_s mlx_imported_function;
+
+typedef enum mlx_dtype {
+  MLX_BOOL = 0,
+  MLX_UINT8,
+  MLX_UINT16,
+  MLX_UINT32,
+  MLX_UINT64,
+  MLX_INT8,
+  MLX_INT16,
+  MLX_INT32,
+  MLX_INT64,
+  MLX_FLOAT16,
+  MLX_FLOAT32,
+  MLX_FLOAT64,
+  MLX_BFLOAT16,
+  MLX_COMPLEX64,
+} mlx_dtype;
+
+/* The last error raised on this thread, or NULL if none. The pointer is
+ * valid until the next failing call on the same thread. */
+const char* mlx_last_error(void);
+
+/* Create an array by copying `data`, laid out row major. */
+mlx_array* mlx_array_from_data(
+    const void* data,
+    const int* shape,
+    int ndim,
+    mlx_dtype dtype);
+
+/* Wrap caller-owned memory as an array without copying. The memory must
+ * stay valid until `deleter` is called with `data`; pass NULL to keep
+ * ownership entirely with the caller. */
+mlx_array* mlx_array_wrap(
+    void* data,
+    const int* shape,
+    int ndim,
+    mlx_dtype dtype,
+    void (*deleter)(void* data));
+
+/* Release the handle. The underlying buffer is freed once no other
+ * arrays reference it. */
+void mlx_array_free(mlx_array* arr);
+
+int mlx_array_ndim(const mlx_array* arr);
+const int* mlx_array_shape(const mlx_array* arr);
+mlx_dtype mlx_array_dtype(const mlx_array* arr);
+size_t mlx_array_size(const mlx_array* arr);
+size_t mlx_array_nbytes(const mlx_array* arr);
+
+/* Evaluate the array (and any graph it depends on). */
+int mlx_array_eval(mlx_array* arr);
+
+/* A pointer to the evaluated, contiguous row-major buffer, valid while
+ * the handle lives. Evaluates first if needed and returns NULL when the
+ * result is not contiguous. */
+const void* mlx_array_data(mlx_array* arr);
+
+/* Import a function saved with `export_function`. */
+mlx_imported_function* mlx_import_function(const char* file);
+
+void mlx_imported_function_free(mlx_imported_function* fun);
+
+/* Call an imported function on `num_inputs` arrays. Writes up to
+ * `max_outputs` new handles to `outputs` and the total count to
+ * `num_outputs`. The outputs are lazy; evaluate them or read their data
+ * to force computation. */
+int mlx_imported_function_call(
+    const mlx_imported_function* fun,
+    const mlx_array* const* inputs,
+    int num_inputs,
+    mlx_array** outputs,
+    int max_outputs,
+    int* num_outputs);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
@@ -1,6 +1,12 @@
 // Copyright © 2023-2024 Apple Inc.
+#include <cctype>
+#include <chrono>
 #include <cstdlib>
+#include <filesystem>
+#include <future>
 #include <map>
+#include <mutex>
+#include <optional>
 #include <sstream>
 #include <unordered_map>
 #include <unordered_set>
@@ -9,12 +15,16 @@
 #include "mlx/backend/common/compiled.h"
 #include "mlx/compile.h"
 #include "mlx/compile_impl.h"
+#include "mlx/export.h"
 #include "mlx/fast_primitives.h"
 #include "mlx/graph_utils.h"
+#include "mlx/ops.h"
 #include "mlx/primitives.h"
+#include "mlx/profiler.h"
 #include "mlx/transforms.h"
 #include "mlx/transforms_impl.h"
 #include "mlx/utils.h"
+#include "mlx/version.h"
 
 namespace mlx::core {
 
@@ -57,7 +67,8 @@ bool is_binary(const Primitive& p) {
 }
 
 bool is_ternary(const Primitive& p) {
-  return typeid(p) == typeid(Select);
+  return typeid(p) == typeid(Select) || typeid(p) == typeid(MaskedAdd) ||
+      typeid(p) == typeid(MaskedMultiply);
 }
 
 bool is_broadcast(const Primitive& p) {
@@ -296,6 +307,10 @@ class CompilerCache {
     std::vector<array> tape;
     bool empty{true};
     std::vector<uint64_t> constants;
+    // Axes allowed to vary between calls (per input, per axis). Non-empty
+    // for shape-polymorphic entries promoted by find when the same function
+    // keeps getting called with new shapes (MLX_COMPILE_DYNAMIC_DIMS).
+    std::vector<std::vector<bool>> dynamic_dims;
   };
 
   // Returns a reference to a CacheEntry which can be updated
@@ -340,6 +355,9 @@ class CompilerCache {
       if (entry.shapeless != shapeless) {
         continue;
       }
+      if (!entry.dynamic_dims.empty()) {
+        continue;
+      }
 
       // Check the inputs match and return if so
       if (has_same_shape_and_dtype(inputs, entry.inputs) &&
@@ -347,6 +365,76 @@ class CompilerCache {
         return entry;
       }
     }
+
+    if (!shapeless && env::compile_dynamic_dims()) {
+      // Look for a shape-polymorphic entry that matches everywhere except
+      // on its dynamic axes
+      for (CacheEntry& entry : entries) {
+        if (entry.stream != stream || entry.empty ||
+            entry.dynamic_dims.empty() || constants != entry.constants) {
+          continue;
+        }
+        auto matches = [&]() {
+          if (inputs.size() != entry.inputs.size()) {
+            return false;
+          }
+          for (size_t i = 0; i < inputs.size(); ++i) {
+            if (inputs[i].ndim() != entry.inputs[i].ndim() ||
+                inputs[i].dtype() != entry.inputs[i].dtype()) {
+              return false;
+            }
+            for (int j = 0; j < inputs[i].ndim(); ++j) {
+              if (!entry.dynamic_dims[i][j] &&
+                  inputs[i].shape(j) != entry.inputs[i].shape(j)) {
+                return false;
+              }
+            }
+          }
+          return true;
+        };
+        if (matches()) {
+          return entry;
+        }
+      }
+
+      // The same function keeps getting new shapes; on the third one promote
+      // to a shape-polymorphic entry whose dynamic axes are the ones that
+      // vary across the specialized entries. The specialized entries keep
+      // serving their exact shapes.
+      std::vector<CacheEntry*> specialized;
+      for (CacheEntry& entry : entries) {
+        if (entry.stream != stream || entry.empty ||
+            !entry.dynamic_dims.empty() || constants != entry.constants ||
+            inputs.size() != entry.inputs.size()) {
+          continue;
+        }
+        bool same = true;
+        for (size_t i = 0; i < inputs.size() && same; ++i) {
+          same = inputs[i].ndim() == entry.inputs[i].ndim() &&
+              inputs[i].dtype() == entry.inputs[i].dtype();
+        }
+        if (same) {
+          specialized.push_back(&entry);
+        }
+      }
+      if (specialized.size() >= 2) {
+        std::vector<std::vector<bool>> dynamic_dims;
+        for (size_t i = 0; i < inputs.size(); ++i) {
+          std::vector<bool> dims(inputs[i].ndim(), false);
+          for (int j = 0; j < inputs[i].ndim(); ++j) {
+            for (auto* entry : specialized) {
+              dims[j] =
+                  dims[j] | (entry->inputs[i].shape(j) != inputs[i].shape(j));
+            }
+          }
+          dynamic_dims.push_back(std::move(dims));
+        }
+        entries.push_back(CacheEntry{stream, shapeless});
+        entries.back().dynamic_dims = std::move(dynamic_dims);
+        return entries.back();
+      }
+    }
+
     // Otherwise append a new cache entry
     entries.push_back(CacheEntry{stream, shapeless});
     return entries.back();
@@ -661,6 +749,7 @@ void compile_fuse(
     std::function<void(const array&, int, const Stream&, const Shape&)> recurse;
     std::unordered_set<uintptr_t> cache;
     std::unordered_set<uintptr_t> input_set;
+    std::unordered_set<uintptr_t> shared_outputs;
     recurse = [&](const array& a,
                   int depth,
                   const Stream& s,
@@ -704,14 +793,21 @@ void compile_fuse(
         if (a.has_primitive() && is_broadcast(a.primitive())) {
           array b = split_one(a, parents_map, cache);
           recurse(b, depth, s, shape);
-        } else {
+          return;
+        }
+        if (!env::compile_multi_output() || a.shape() != shape) {
           // Possible input
           input_set.insert(a.id());
+          return;
         }
-        return;
+        // Consumed outside the section too: fuse it anyway and emit it as
+        // an extra output of the compiled kernel instead of materializing
+        // it with a kernel of its own
+        shared_outputs.insert(a.id());
       }
 
-      if (output_map.find(a.id()) != output_map.end()) {
+      if (output_map.find(a.id()) != output_map.end() ||
+          shared_outputs.find(a.id()) != shared_outputs.end()) {
         input_set.insert(a.id());
       } else {
         // Not an input anymore since fusing it
@@ -769,7 +865,8 @@ void compile_fuse(
     // of new primitive
     for (int j = 0; j < fused_tape.size() - 1; ++j) {
       auto& f = fused_tape[j];
-      if (output_map.find(f.id()) != output_map.end()) {
+      if (output_map.find(f.id()) != output_map.end() ||
+          shared_outputs.find(f.id()) != shared_outputs.end()) {
         old_outputs.push_back(f);
         // Parents are now siblings, update the parent map
         auto& pairs = parents_map[f.id()];
@@ -856,6 +953,753 @@ void compile_fuse(
   }
 }
 
+// Evaluate constant subgraphs of the traced graph once at compile time and
+// embed the results as constants (MLX_COMPILE_CONSTANT_FOLD). Graphs often
+// carry input-independent chains such as mask construction or rotary tables
+// that would otherwise be recomputed on every call of the compiled
+// function. Runs before the tape is built so folded-away producers drop out
+// of the DFS. Folded results are capped in size to keep the cache entry
+// from pinning large buffers.
+void compile_constant_fold(
+    std::vector<array>& outputs,
+    const std::vector<array>& inputs) {
+  constexpr size_t max_folded_bytes = 1 << 23;
+
+  // Gather the graph in topological order
+  std::vector<array> nodes;
+  std::unordered_set<std::uintptr_t> cache;
+  std::function<void(const array&)> recurse = [&](const array& a) {
+    if (!cache.insert(a.id()).second) {
+      return;
+    }
+    for (auto& in : a.inputs()) {
+      recurse(in);
+    }
+    nodes.push_back(a);
+  };
+  for (auto& o : outputs) {
+    recurse(o);
+  }
+
+  std::unordered_set<std::uintptr_t> input_ids;
+  for (auto& in : inputs) {
+    input_ids.insert(in.id());
+  }
+
+  // A node is foldable if everything it transitively depends on is a
+  // constant with host-available data. Loads are left alone since their
+  // data is not available until the first eval.
+  std::unordered_set<std::uintptr_t> foldable;
+  auto is_constant = [&](const array& a) {
+    return foldable.find(a.id()) != foldable.end() ||
+        (!a.has_primitive() && a.is_available() &&
+         input_ids.find(a.id()) == input_ids.end());
+  };
+  for (auto& a : nodes) {
+    if (!a.has_primitive() || !a.siblings().empty() ||
+        typeid(a.primitive()) == typeid(Load) ||
+        input_ids.find(a.id()) != input_ids.end() ||
+        a.nbytes() > max_folded_bytes) {
+      continue;
+    }
+    if (std::all_of(a.inputs().begin(), a.inputs().end(), is_constant)) {
+      foldable.insert(a.id());
+    }
+  }
+  if (foldable.empty()) {
+    return;
+  }
+
+  // Only the maximal foldable nodes (those with a non-foldable consumer, or
+  // which are outputs) need to be materialized
+  std::unordered_set<std::uintptr_t> needed;
+  for (auto& o : outputs) {
+    if (foldable.find(o.id()) != foldable.end()) {
+      needed.insert(o.id());
+    }
+  }
+  for (auto& a : nodes) {
+    if (foldable.find(a.id()) != foldable.end()) {
+      continue;
+    }
+    for (auto& in : a.inputs()) {
+      if (foldable.find(in.id()) != foldable.end()) {
+        needed.insert(in.id());
+      }
+    }
+  }
+
+  std::vector<array> roots;
+  for (auto& a : nodes) {
+    if (needed.find(a.id()) != needed.end()) {
+      roots.push_back(a);
+    }
+  }
+  if (roots.empty()) {
+    return;
+  }
+  try {
+    eval(roots);
+  } catch (const std::exception&) {
+    // Leave the subgraph to be evaluated at call time
+    return;
+  }
+  // The trace arrays are tracers so eval does not detach them
+  for (auto& a : roots) {
+    a.detach();
+  }
+}
+
+// Walk through shape-only wrappers (broadcasts and stop gradients),
+// collecting the wrapper nodes as pattern interior arrays.
+const array* norm_strip_wrappers(
+    const array* a,
+    std::vector<const array*>& interior) {
+  while (a->has_primitive() && a->siblings().empty() &&
+         (typeid(a->primitive()) == typeid(Broadcast) ||
+          typeid(a->primitive()) == typeid(BroadcastAxes) ||
+          typeid(a->primitive()) == typeid(StopGradient))) {
+    interior.push_back(a);
+    a = &a->inputs()[0];
+  }
+  return a;
+}
+
+// Read a host-available floating point scalar, e.g. a traced constant.
+std::optional<float> norm_read_scalar(const array& a) {
+  if (a.size() != 1 || !a.is_available()) {
+    return std::nullopt;
+  }
+  switch (a.dtype()) {
+    case float32:
+      return a.data<float>()[0];
+    case float16:
+      return static_cast<float>(a.data<float16_t>()[0]);
+    case bfloat16:
+      return static_cast<float>(a.data<bfloat16_t>()[0]);
+    default:
+      return std::nullopt;
+  }
+}
+
+// Match a mean over the last axis with keepdims and return the array being
+// averaged, or nullptr. Covers the form mean() lowers to (a sum scaled by a
+// host constant, or by NumberOfElements when tracing dynamically) as well as
+// an explicit division of the sum by the axis size.
+const array* match_row_mean(
+    const array* m,
+    Stream s,
+    std::vector<const array*>& interior) {
+  if (!m->has_primitive() || !m->siblings().empty() ||
+      !(m->primitive().stream() == s)) {
+    return nullptr;
+  }
+  bool is_div = typeid(m->primitive()) == typeid(Divide);
+  if (!is_div && typeid(m->primitive()) != typeid(Multiply)) {
+    return nullptr;
+  }
+  const array* red = &m->inputs()[0];
+  const array* scale = &m->inputs()[1];
+  if (!is_div &&
+      !(red->has_primitive() && typeid(red->primitive()) == typeid(Reduce))) {
+    std::swap(red, scale);
+  }
+  if (!red->has_primitive() || typeid(red->primitive()) != typeid(Reduce) ||
+      !red->siblings().empty() || !(red->primitive().stream() == s)) {
+    return nullptr;
+  }
+  auto [rt, axes] = static_cast<Reduce&>(red->primitive()).state();
+  const array* u = &red->inputs()[0];
+  int last = static_cast<int>(u->ndim()) - 1;
+  if (rt != Reduce::Sum || axes != std::vector<int>{last} ||
+      red->ndim() != u->ndim() || red->shape().back() != 1) {
+    return nullptr;
+  }
+  auto d = static_cast<float>(u->shape().back());
+  auto* sc = norm_strip_wrappers(scale, interior);
+  if (!is_div && sc->has_primitive() &&
+      typeid(sc->primitive()) == typeid(NumberOfElements)) {
+    auto [naxes, inverted, ndt] =
+        static_cast<NumberOfElements&>(sc->primitive()).state();
+    if (!inverted || naxes != std::vector<int>{last} ||
+        sc->inputs()[0].id() != u->id() || !sc->siblings().empty()) {
+      return nullptr;
+    }
+    interior.push_back(sc);
+  } else if (auto v = norm_read_scalar(*sc); v.has_value()) {
+    float scaled = is_div ? d / *v : d * *v;
+    if (std::abs(scaled - 1.0f) > 1e-3f) {
+      return nullptr;
+    }
+  } else {
+    return nullptr;
+  }
+  interior.push_back(m);
+  interior.push_back(red);
+  return u;
+}
+
+struct NormMatch {
+  const array* x{nullptr};
+  const array* w{nullptr};
+  const array* b{nullptr};
+  float eps{0.0f};
+  bool layer{false};
+  // Nodes the rewrite absorbs; they must have no consumers outside the
+  // pattern for the match to be valid
+  std::vector<const array*> interior;
+};
+
+// Match `u * rsqrt(mean(square(u), -1, keepdims=true) + eps)` rooted at a
+// multiply, where u is either the pattern input itself (rms norm) or the
+// input minus its row mean (layer norm).
+bool match_norm_core(const array& y, Stream s, NormMatch& m) {
+  if (!y.has_primitive() || typeid(y.primitive()) != typeid(Multiply) ||
+      !y.siblings().empty() || !(y.primitive().stream() == s)) {
+    return false;
+  }
+  for (int i = 0; i < 2; ++i) {
+    NormMatch trial;
+    const array* u = &y.inputs()[i];
+    auto* nf = norm_strip_wrappers(&y.inputs()[1 - i], trial.interior);
+    if (!nf->has_primitive() || typeid(nf->primitive()) != typeid(Sqrt) ||
+        !static_cast<Sqrt&>(nf->primitive()).state() ||
+        !nf->siblings().empty() || !(nf->primitive().stream() == s)) {
+      continue;
+    }
+    const array* r = &nf->inputs()[0];
+    if (!r->has_primitive() || typeid(r->primitive()) != typeid(Add) ||
+        !r->siblings().empty() || !(r->primitive().stream() == s)) {
+      continue;
+    }
+    trial.interior.push_back(nf);
+    trial.interior.push_back(r);
+    // One addend is the scalar epsilon, the other the row variance
+    for (int j = 0; j < 2; ++j) {
+      NormMatch attempt = trial;
+      auto* eps = norm_strip_wrappers(&r->inputs()[j], attempt.interior);
+      auto ev = norm_read_scalar(*eps);
+      if (!ev) {
+        continue;
+      }
+      auto* sq = match_row_mean(&r->inputs()[1 - j], s, attempt.interior);
+      if (!sq || !sq->has_primitive() ||
+          typeid(sq->primitive()) != typeid(Square) ||
+          !sq->siblings().empty() || !(sq->primitive().stream() == s) ||
+          sq->inputs()[0].id() != u->id()) {
+        continue;
+      }
+      attempt.interior.push_back(sq);
+      attempt.eps = *ev;
+      // A centered input makes this a layer norm
+      if (u->has_primitive() && typeid(u->primitive()) == typeid(Subtract) &&
+          u->siblings().empty() && u->primitive().stream() == s) {
+        std::vector<const array*> center;
+        auto* mu = match_row_mean(
+            norm_strip_wrappers(&u->inputs()[1], center), s, center);
+        if (mu && mu->id() == u->inputs()[0].id()) {
+          attempt.layer = true;
+          attempt.x = &u->inputs()[0];
+          attempt.interior.push_back(u);
+          attempt.interior.insert(
+              attempt.interior.end(), center.begin(), center.end());
+        }
+      }
+      if (!attempt.layer) {
+        attempt.x = u;
+      }
+      if (attempt.x->ndim() == 0 || !(attempt.x->shape() == y.shape()) ||
+          attempt.x->dtype() != y.dtype()) {
+        continue;
+      }
+      m = std::move(attempt);
+      return true;
+    }
+  }
+  return false;
+}
+
+// Rewrite layer-norm and rms-norm shaped subgraphs onto the fused fast::
+// primitives (MLX_COMPILE_FUSE_NORMS). compile_fuse cannot fuse across a
+// reduction, so a hand-written norm (mean, subtract, square, mean, rsqrt,
+// scale) compiles to several kernels with the loads of the input repeated;
+// the fast:: primitives run the statistics and apply passes fused. Runs on
+// the traced graph before the tape is built so absorbed nodes simply drop
+// out of the DFS, and rewrites in place on the root after proving the
+// intermediates have no other consumers, like the eval-time fusion passes.
+void compile_fuse_norms(std::vector<array>& outputs) {
+  // Gather the graph in reverse topological order along with consumer counts
+  std::vector<array> nodes;
+  std::unordered_map<std::uintptr_t, int> consumers;
+  std::unordered_set<std::uintptr_t> output_ids;
+  {
+    std::unordered_set<std::uintptr_t> cache;
+    std::function<void(const array&)> recurse = [&](const array& a) {
+      if (!cache.insert(a.id()).second) {
+        return;
+      }
+      for (auto& in : a.inputs()) {
+        consumers[in.id()]++;
+        recurse(in);
+      }
+      nodes.push_back(a);
+    };
+    for (auto& o : outputs) {
+      recurse(o);
+      output_ids.insert(o.id());
+    }
+  }
+
+  std::unordered_set<std::uintptr_t> absorbed;
+  // Visit roots before their subexpressions so an affine epilogue is folded
+  // together with the normalization below it
+  for (auto it = nodes.rbegin(); it != nodes.rend(); ++it) {
+    auto& z = *it;
+    if (!z.has_primitive() || !z.siblings().empty() ||
+        absorbed.find(z.id()) != absorbed.end()) {
+      continue;
+    }
+    if (z.dtype() != float32 && z.dtype() != float16 &&
+        z.dtype() != bfloat16) {
+      continue;
+    }
+    Stream s = z.primitive().stream();
+
+    // Match the normalization with an optional scale by a weight vector,
+    // and for layer norms an optional bias add above that
+    auto try_weighted = [&](const array& root, NormMatch& m) {
+      if (match_norm_core(root, s, m)) {
+        return true;
+      }
+      if (!root.has_primitive() ||
+          typeid(root.primitive()) != typeid(Multiply) ||
+          !root.siblings().empty() || !(root.primitive().stream() == s)) {
+        return false;
+      }
+      for (int i = 0; i < 2; ++i) {
+        NormMatch trial;
+        std::vector<const array*> bcasts;
+        auto* w = norm_strip_wrappers(&root.inputs()[i], bcasts);
+        auto& core = root.inputs()[1 - i];
+        if (w->ndim() != 1 || w->dtype() != root.dtype() ||
+            !match_norm_core(core, s, trial) ||
+            w->size() != trial.x->shape().back()) {
+          continue;
+        }
+        trial.w = w;
+        trial.interior.push_back(&core);
+        trial.interior.insert(trial.interior.end(), bcasts.begin(), bcasts.end());
+        m = std::move(trial);
+        return true;
+      }
+      return false;
+    };
+
+    NormMatch m;
+    bool matched = try_weighted(z, m);
+    if (!matched && typeid(z.primitive()) == typeid(Add)) {
+      for (int i = 0; i < 2 && !matched; ++i) {
+        NormMatch trial;
+        std::vector<const array*> bcasts;
+        auto* b = norm_strip_wrappers(&z.inputs()[i], bcasts);
+        auto& inner = z.inputs()[1 - i];
+        if (b->ndim() != 1 || b->dtype() != z.dtype() ||
+            !try_weighted(inner, trial) || !trial.layer ||
+            b->size() != trial.x->shape().back()) {
+          continue;
+        }
+        trial.b = b;
+        trial.interior.push_back(&inner);
+        trial.interior.insert(trial.interior.end(), bcasts.begin(), bcasts.end());
+        m = std::move(trial);
+        matched = true;
+      }
+    }
+    if (!matched) {
+      continue;
+    }
+    if (m.layer ? fast::LayerNorm::use_fallback(s)
+                : fast::RMSNorm::use_fallback(s)) {
+      continue;
+    }
+
+    // Every absorbed node must feed only the pattern
+    std::unordered_map<std::uintptr_t, const array*> interior;
+    for (auto* n : m.interior) {
+      interior.emplace(n->id(), n);
+    }
+    std::unordered_map<std::uintptr_t, int> required;
+    auto count_edges = [&](const array& a) {
+      for (auto& in : a.inputs()) {
+        if (interior.find(in.id()) != interior.end()) {
+          required[in.id()]++;
+        }
+      }
+    };
+    count_edges(z);
+    for (auto& [id, n] : interior) {
+      count_edges(*n);
+    }
+    bool viable = true;
+    for (auto& [id, n] : interior) {
+      if (output_ids.find(id) != output_ids.end() ||
+          absorbed.find(id) != absorbed.end() || consumers[id] != required[id]) {
+        viable = false;
+        break;
+      }
+    }
+    if (!viable) {
+      continue;
+    }
+
+    // Rewrite the root in place; copy the kept operands out first since
+    // reassigning the root's inputs may invalidate them
+    auto out_type = z.dtype();
+    array x_arr = *m.x;
+    array w_arr = (m.w != nullptr) ? *m.w : array(1, out_type);
+    bool has_weight = m.w != nullptr;
+    if (m.layer) {
+      array b_arr = (m.b != nullptr) ? *m.b : array(0, out_type);
+      bool has_bias = m.b != nullptr;
+      auto fallback = [has_weight, has_bias, eps = m.eps, out_type, s](
+                          const std::vector<array>& inputs) {
+        auto x = astype(inputs[0], float32, s);
+        auto mu = mean(x, /* axis= */ -1, /* keepdims= */ true, s);
+        auto xc = subtract(x, mu, s);
+        auto v = mean(square(xc, s), /* axis= */ -1, /* keepdims= */ true, s);
+        x = multiply(xc, rsqrt(add(v, array(eps, float32), s), s));
+        x = astype(x, out_type, s);
+        if (has_weight) {
+          x = multiply(x, inputs[1], s);
+        }
+        if (has_bias) {
+          x = add(x, inputs[2], s);
+        }
+        return std::vector<array>{x};
+      };
+      z.primitive_ptr() =
+          std::make_shared<fast::LayerNorm>(s, std::move(fallback), m.eps);
+      z.inputs() = {std::move(x_arr), std::move(w_arr), std::move(b_arr)};
+    } else {
+      auto fallback = [has_weight, eps = m.eps, out_type, s](
+                          const std::vector<array>& inputs) {
+        auto x = astype(inputs[0], float32, s);
+        x = multiply(
+            x,
+            rsqrt(
+                add(mean(square(x, s), -1, /* keepdims */ true, s),
+                    array(eps, float32),
+                    s),
+                s),
+            s);
+        x = astype(x, out_type, s);
+        if (has_weight) {
+          x = multiply(x, inputs[1], s);
+        }
+        return std::vector<array>{x};
+      };
+      z.primitive_ptr() =
+          std::make_shared<fast::RMSNorm>(s, std::move(fallback), m.eps);
+      z.inputs() = {std::move(x_arr), std::move(w_arr)};
+    }
+    for (auto& [id, n] : interior) {
+      absorbed.insert(id);
+    }
+  }
+}
+
+// Minimize layout conversions across the graph (MLX_COMPILE_LAYOUT). Op
+// lowerings prefer different layouts (convolution runs channel-last), so a
+// graph written channel-first pays a conversion on both sides of every such
+// op. The transposes themselves are free views, but each consumer of a
+// transposed intermediate materializes a contiguous copy, so the cost scales
+// with how far apart the conversions sit. This pass sinks transposes through
+// elementwise ops toward their consumers and composes adjacent ones, so the
+// conversions on a layout boundary meet and cancel and the elementwise work
+// in between runs on contiguous data. Runs on the traced graph before the
+// tape is built, rewriting in place like the norm fusion above;
+// compile_simplify then merges any duplicated subexpressions.
+void compile_layout(std::vector<array>& outputs) {
+  // Gather the graph in topological order along with consumer counts
+  std::vector<array> nodes;
+  std::unordered_map<std::uintptr_t, int> consumers;
+  std::unordered_set<std::uintptr_t> output_ids;
+  {
+    std::unordered_set<std::uintptr_t> cache;
+    std::function<void(const array&)> recurse = [&](const array& a) {
+      if (!cache.insert(a.id()).second) {
+        return;
+      }
+      for (auto& in : a.inputs()) {
+        consumers[in.id()]++;
+        recurse(in);
+      }
+      nodes.push_back(a);
+    };
+    for (auto& o : outputs) {
+      recurse(o);
+      output_ids.insert(o.id());
+    }
+  }
+
+  auto is_transpose = [](const array& a) {
+    return a.has_primitive() && a.siblings().empty() &&
+        typeid(a.primitive()) == typeid(Transpose);
+  };
+  auto transpose_axes = [](const array& a) {
+    return static_cast<const Transpose&>(a.primitive()).state();
+  };
+  // A transpose can be absorbed into its consumer when the consumer is its
+  // only reader, it is not itself an output, and no stream boundary sits
+  // between them
+  auto absorbable = [&](const array& t, const Stream& s) {
+    return is_transpose(t) && consumers[t.id()] == 1 &&
+        output_ids.find(t.id()) == output_ids.end() &&
+        t.primitive().stream() == s;
+  };
+
+  // Visit producers before consumers so a transpose hoisted out of one node
+  // keeps sinking through the nodes above it in the same pass
+  for (auto& z : nodes) {
+    if (!z.has_primitive() || !z.siblings().empty()) {
+      continue;
+    }
+    auto s = z.primitive().stream();
+    if (is_transpose(z) && absorbable(z.inputs()[0], s)) {
+      // Compose the pair into a single transpose. An identity composition
+      // stays behind as a free contiguous view.
+      auto& t = z.inputs()[0];
+      auto p1 = transpose_axes(t);
+      auto p2 = transpose_axes(z);
+      std::vector<int> axes(p2.size());
+      for (size_t i = 0; i < axes.size(); ++i) {
+        axes[i] = p1[p2[i]];
+      }
+      array x = t.inputs()[0];
+      consumers[x.id()]++;
+      z.primitive_ptr() = std::make_shared<Transpose>(s, std::move(axes));
+      z.inputs() = {std::move(x)};
+    } else if (is_unary(z.primitive()) && absorbable(z.inputs()[0], s)) {
+      // unary(transpose(x)) -> transpose(unary(x)); the elementwise op now
+      // reads contiguous data and the transpose can cancel further up
+      auto& t = z.inputs()[0];
+      auto axes = transpose_axes(t);
+      array x = t.inputs()[0];
+      consumers[x.id()]++;
+      array u(x.shape(), z.dtype(), z.primitive_ptr(), {std::move(x)});
+      consumers[u.id()] = 1;
+      z.primitive_ptr() = std::make_shared<Transpose>(s, std::move(axes));
+      z.inputs() = {std::move(u)};
+    } else if (
+        is_binary(z.primitive()) && absorbable(z.inputs()[0], s) &&
+        absorbable(z.inputs()[1], s) &&
+        transpose_axes(z.inputs()[0]) == transpose_axes(z.inputs()[1])) {
+      // Both operands arrive through the same permutation, so one transpose
+      // of the result replaces two of the inputs
+      auto axes = transpose_axes(z.inputs()[0]);
+      array a = z.inputs()[0].inputs()[0];
+      array b = z.inputs()[1].inputs()[0];
+      consumers[a.id()]++;
+      consumers[b.id()]++;
+      array u(
+          a.shape(), z.dtype(), z.primitive_ptr(), {std::move(a), std::move(b)});
+      consumers[u.id()] = 1;
+      z.primitive_ptr() = std::make_shared<Transpose>(s, std::move(axes));
+      z.inputs() = {std::move(u)};
+    }
+  }
+}
+
+// Measured CPU/GPU crossover sizes (see set_placement_cost in compile.h)
+struct PlacementCostRegistry {
+  std::mutex mtx;
+  std::unordered_map<std::string, size_t> crossovers;
+};
+
+PlacementCostRegistry& placement_cost_registry() {
+  static PlacementCostRegistry registry_;
+  return registry_;
+}
+
+// Move small elementwise segments of the trace to the CPU stream, where
+// their dispatch overhead is lower than a kernel launch. Gated behind
+// MLX_COMPILE_PLACEMENT; thresholds come from set_placement_cost with
+// MLX_PLACEMENT_CROSSOVER as the default.
+void compile_placement(std::vector<array>& outputs) {
+  if (!is_available(Device::cpu) || !is_available(Device::gpu)) {
+    return;
+  }
+
+  std::unordered_map<std::string, size_t> crossovers;
+  {
+    auto& registry = placement_cost_registry();
+    std::lock_guard<std::mutex> lock(registry.mtx);
+    crossovers = registry.crossovers;
+  }
+  size_t default_crossover = env::placement_crossover();
+  auto crossover = [&](const Primitive& p) {
+    auto it = crossovers.find(p.name());
+    return it != crossovers.end() ? it->second : default_crossover;
+  };
+
+  // Gather the graph in topological order
+  std::vector<array> nodes;
+  {
+    std::unordered_set<std::uintptr_t> cache;
+    std::function<void(const array&)> recurse = [&](const array& a) {
+      if (!cache.insert(a.id()).second) {
+        return;
+      }
+      for (auto& in : a.inputs()) {
+        recurse(in);
+      }
+      nodes.push_back(a);
+    };
+    for (auto& o : outputs) {
+      recurse(o);
+    }
+  }
+
+  // Producers first, and a node only moves when everything it reads is
+  // already off the gpu, so segments grow from the function inputs and a
+  // move never inserts a boundary inside a segment. The one transfer a
+  // moved segment does cost — the sync where its consumer re-enters the
+  // gpu stream — is part of what the measured crossovers price in, since
+  // the benchmark times each device end to end.
+  std::unordered_set<std::uintptr_t> on_cpu;
+  auto feeds_from_cpu = [&](const array& a) {
+    for (auto& in : a.inputs()) {
+      if (in.has_primitive() && on_cpu.find(in.id()) == on_cpu.end()) {
+        return false;
+      }
+    }
+    return true;
+  };
+  for (auto& z : nodes) {
+    if (!z.has_primitive() || !z.siblings().empty()) {
+      continue;
+    }
+    auto& p = z.primitive();
+    if (p.stream().device == Device::cpu) {
+      on_cpu.insert(z.id());
+      continue;
+    }
+    // Only elementwise ops move: every one has a CPU path and their cost
+    // is a clean function of the output size
+    if (!is_unary(p) && !is_binary(p)) {
+      continue;
+    }
+    if (z.size() >= crossover(p) || !feeds_from_cpu(z)) {
+      continue;
+    }
+    p.set_stream(to_stream(Device::cpu));
+    on_cpu.insert(z.id());
+  }
+}
+
+// User-registered rewrite rules (see register_rewrite_rule in compile.h)
+struct RewriteRuleRegistry {
+  std::mutex mtx;
+  std::vector<std::pair<std::string, RewriteRule>> rules;
+};
+
+RewriteRuleRegistry& rewrite_rule_registry() {
+  static RewriteRuleRegistry registry_;
+  return registry_;
+}
+
+// Apply the registered rewrite rules to the trace. Rules run on the graph
+// before the tape is built so producers that only fed a rewritten node drop
+// out in compile_dfs.
+void compile_apply_rewrite_rules(std::vector<array>& outputs) {
+  std::vector<std::pair<std::string, RewriteRule>> rules;
+  {
+    auto& registry = rewrite_rule_registry();
+    std::lock_guard<std::mutex> lock(registry.mtx);
+    rules = registry.rules;
+  }
+  if (rules.empty()) {
+    return;
+  }
+
+  // Gather the nodes in reverse postorder so roots are visited before
+  // their producers
+  std::vector<array> nodes;
+  std::unordered_set<std::uintptr_t> visited;
+  std::function<void(const array&)> recurse = [&](const array& a) {
+    if (visited.find(a.id()) != visited.end()) {
+      return;
+    }
+    visited.insert(a.id());
+    for (auto& in : a.inputs()) {
+      recurse(in);
+    }
+    nodes.push_back(a);
+  };
+  for (auto& o : outputs) {
+    recurse(o);
+  }
+
+  for (auto it = nodes.rbegin(); it != nodes.rend(); ++it) {
+    auto& a = *it;
+    if (!a.has_primitive() || !a.siblings().empty()) {
+      continue;
+    }
+    for (auto& [name, rule] : rules) {
+      auto replacement = rule(a);
+      if (!replacement) {
+        continue;
+      }
+      if (!replacement->has_primitive() || !replacement->siblings().empty()) {
+        std::ostringstream msg;
+        msg << "[compile] Rewrite rule '" << name
+            << "' must return an array produced by a single-output "
+            << "primitive.";
+        throw std::invalid_argument(msg.str());
+      }
+      if (replacement->shape() != a.shape() ||
+          replacement->dtype() != a.dtype()) {
+        std::ostringstream msg;
+        msg << "[compile] Rewrite rule '" << name
+            << "' changed the shape or dtype of the node it rewrote.";
+        throw std::invalid_argument(msg.str());
+      }
+      // Reject replacements that compute from the rewritten node itself
+      // since rewiring them in place would form a cycle
+      std::unordered_set<std::uintptr_t> seen;
+      std::function<bool(const array&)> reaches = [&](const array& r) {
+        if (r.id() == a.id()) {
+          return true;
+        }
+        if (!r.has_primitive() || !seen.insert(r.id()).second) {
+          return false;
+        }
+        for (auto& in : r.inputs()) {
+          if (reaches(in)) {
+            return true;
+          }
+        }
+        return false;
+      };
+      if (std::any_of(
+              replacement->inputs().begin(),
+              replacement->inputs().end(),
+              reaches)) {
+        std::ostringstream msg;
+        msg << "[compile] Rewrite rule '" << name
+            << "' returned a replacement that depends on the node it "
+            << "rewrote.";
+        throw std::invalid_argument(msg.str());
+      }
+
+      // Rewrite the node in place onto the replacement's primitive
+      a.primitive_ptr() = replacement->primitive_ptr();
+      a.inputs() = replacement->inputs();
+      break;
+    }
+  }
+}
+
 std::vector<array> compile_replace(
     const std::vector<array>& tape,
     const std::vector<array>& trace_inputs,
@@ -928,6 +1772,109 @@ bool skip_compile() {
       !(compile_available_for_device(default_device()));
 }
 
+// Trace |fun| on |inputs| and run the compile passes, filling the graph
+// fields of |entry|. Shape-polymorphic entries (non-empty dynamic_dims) are
+// traced like shapeless ones; if some primitive cannot be traced dynamically
+// the entry is demoted back to exact shapes.
+void compile_build_entry(
+    CompilerCache::CacheEntry& entry,
+    const std::function<std::vector<array>(const std::vector<array>&)>& fun,
+    const std::vector<array>& inputs,
+    bool shapeless) {
+  bool dynamic = !entry.dynamic_dims.empty();
+  if (dynamic) {
+    try {
+      std::tie(entry.inputs, entry.outputs) =
+          compile_trace(fun, inputs, /* shapeless = */ true);
+    } catch (const std::exception&) {
+      entry.dynamic_dims.clear();
+      dynamic = false;
+    }
+  }
+  // Trace to build the graph
+  if (!dynamic) {
+    std::tie(entry.inputs, entry.outputs) =
+        compile_trace(fun, inputs, shapeless);
+  }
+
+  // Evaluate input-independent subgraphs once and embed the results
+  if (env::compile_constant_fold() &&
+      compile_mode() != CompileMode::no_simplify) {
+    compile_constant_fold(entry.outputs, entry.inputs);
+  }
+
+  // Apply user-registered rewrite rules before the built-in fusions so
+  // plugin patterns are matched on the unfused graph
+  if (compile_mode() != CompileMode::no_fuse) {
+    compile_apply_rewrite_rules(entry.outputs);
+  }
+
+  // Rewrite norm shaped subgraphs onto their fused primitives before
+  // the tape is built
+  if (env::compile_fuse_norms() && compile_mode() != CompileMode::no_fuse) {
+    compile_fuse_norms(entry.outputs);
+  }
+
+  // Sink layout conversions together so they cancel instead of being
+  // paid around every layout-sensitive op
+  if (env::compile_layout() && compile_mode() != CompileMode::no_simplify) {
+    compile_layout(entry.outputs);
+  }
+
+  // Assign small segments to the device that dispatches them fastest
+  if (env::compile_placement() && compile_mode() != CompileMode::no_simplify) {
+    compile_placement(entry.outputs);
+  }
+
+  // DFS the graph and get a tape, and a map of array id to (parent,
+  // position in parent inputs)
+  std::unordered_map<uintptr_t, std::vector<std::pair<array, int>>>
+      parents_map;
+  std::tie(entry.tape, parents_map) =
+      compile_dfs(entry.inputs, entry.outputs, inputs);
+
+  // Simplify the tape
+  if (compile_mode() != CompileMode::no_simplify) {
+    compile_simplify(entry.tape, parents_map, entry.outputs, /* passes */ 3);
+  }
+
+  // Kernel fusion to generate Compiled primitives. The tape and
+  // new outputs must be updated accordingly
+  if (compile_mode() != CompileMode::no_fuse) {
+    compile_fuse(entry.tape, parents_map, entry.inputs, entry.outputs);
+  }
+}
+
+namespace {
+
+// In-flight background builds of one compiled function, keyed by the input
+// signature so each cache entry is built at most once. The worker never
+// touches the compiler cache; the built entry is adopted by the calling
+// thread on a later call.
+struct AsyncBuilds {
+  std::mutex mtx;
+  std::unordered_map<std::string, std::future<CompilerCache::CacheEntry>>
+      pending;
+};
+
+// Identify the cache entry being built: the stream plus the part of the
+// input signature that CompilerCache::find matches on.
+std::string async_build_key(const std::vector<array>& inputs, bool shapeless) {
+  std::ostringstream key;
+  key << default_stream(default_device()).index;
+  for (auto& in : inputs) {
+    key << ";" << in.dtype() << "," << in.ndim();
+    if (!shapeless) {
+      for (auto s : in.shape()) {
+        key << "," << s;
+      }
+    }
+  }
+  return key.str();
+}
+
+} // namespace
+
 std::function<std::vector<array>(const std::vector<array>&)> compile(
     std::function<std::vector<array>(const std::vector<array>&)> fun,
     std::uintptr_t fun_id,
@@ -944,7 +1891,9 @@ std::function<std::vector<array>(const std::vector<array>&)> compile(
   return [fun = std::move(fun),
           fun_id,
           shapeless,
-          constants = std::move(constants)](const std::vector<array>& inputs) {
+          constants = std::move(constants),
+          builds = std::make_shared<AsyncBuilds>()](
+             const std::vector<array>& inputs) {
     // If the inputs are tracers, trace the original graph
     if (std::any_of(inputs.begin(), inputs.end(), [](auto& in) {
           return in.is_tracer();
@@ -957,38 +1906,71 @@ std::function<std::vector<array>(const std::vector<array>&)> compile(
 
     // No matching cache entry existed, so compile
     if (entry.empty) {
-      // Mark the entry as not empty since we are about to fill it
-      entry.empty = false;
-      // Set the constants
-      entry.constants = std::move(constants);
-      // Trace to build the graph
-      std::tie(entry.inputs, entry.outputs) =
-          compile_trace(fun, inputs, shapeless);
-
-      // DFS the graph and get a tape, and a map of array id to (parent,
-      // position in parent inputs)
-      std::unordered_map<uintptr_t, std::vector<std::pair<array, int>>>
-          parents_map;
-      std::tie(entry.tape, parents_map) =
-          compile_dfs(entry.inputs, entry.outputs, inputs);
-
-      // Simplify the tape
-      if (compile_mode() != CompileMode::no_simplify) {
-        compile_simplify(
-            entry.tape, parents_map, entry.outputs, /* passes */ 3);
+      // Tiered compilation: build the optimized tape on a worker thread and
+      // run the uncompiled graph until it is ready. Shape-polymorphic
+      // entries are excluded since they must be proved out inline.
+      if (env::compile_async() && entry.dynamic_dims.empty()) {
+        auto key = async_build_key(inputs, shapeless);
+        std::unique_lock<std::mutex> lk(builds->mtx);
+        auto it = builds->pending.find(key);
+        if (it == builds->pending.end()) {
+          builds->pending.emplace(
+              key,
+              std::async(
+                  std::launch::async,
+                  [fun, inputs, shapeless, constants, stream = entry.stream]() {
+                    CompilerCache::CacheEntry built(stream, shapeless);
+                    built.empty = false;
+                    built.constants = constants;
+                    compile_build_entry(built, fun, inputs, shapeless);
+                    return built;
+                  }));
+          it = builds->pending.end();
+        }
+        if (it == builds->pending.end() ||
+            it->second.wait_for(std::chrono::seconds(0)) !=
+                std::future_status::ready) {
+          lk.unlock();
+          return fun(inputs);
+        }
+        auto fut = std::move(it->second);
+        builds->pending.erase(it);
+        lk.unlock();
+        try {
+          entry = fut.get();
+        } catch (const std::exception&) {
+          // Recompile inline so the error surfaces on the calling thread
+        }
       }
-
-      // Kernel fusion to generate Compiled primitives. The tape and
-      // new outputs must be updated accordingly
-      if (compile_mode() != CompileMode::no_fuse) {
-        compile_fuse(entry.tape, parents_map, entry.inputs, entry.outputs);
+      if (entry.empty) {
+        // Mark the entry as not empty since we are about to fill it
+        entry.empty = false;
+        // Set the constants
+        entry.constants = std::move(constants);
+        compile_build_entry(entry, fun, inputs, shapeless);
+
+        // Prove out a freshly promoted shape-polymorphic tape on the inputs
+        // it was traced with; a primitive that cannot re-infer its output
+        // shapes demotes the entry back to exact shapes
+        if (!entry.dynamic_dims.empty()) {
+          try {
+            return compile_replace(
+                entry.tape, entry.inputs, entry.outputs, inputs, true);
+          } catch (const std::exception&) {
+            entry.dynamic_dims.clear();
+          }
+        }
       }
     }
 
     // At this point we must have a tape, now replace the placeholders
     // with real arrays that can be evaluated
     return compile_replace(
-        entry.tape, entry.inputs, entry.outputs, inputs, shapeless);
+        entry.tape,
+        entry.inputs,
+        entry.outputs,
+        inputs,
+        shapeless || !entry.dynamic_dims.empty());
   };
 }
 
@@ -1040,6 +2022,259 @@ std::function<std::vector<array>(const std::vector<array>&)> compile(
   return detail::compile(fun, reinterpret_cast<std::uintptr_t>(fun), shapeless);
 }
 
+namespace {
+
+// Directory for persisted compile traces
+const std::filesystem::path& compile_cache_dir() {
+  static std::filesystem::path cache = []() -> std::filesystem::path {
+    std::filesystem::path cache;
+    if (auto c = std::getenv("MLX_COMPILE_CACHE_DIR"); c) {
+      cache = c;
+    } else {
+      cache = std::filesystem::temp_directory_path() / "mlx" / version() /
+          "compiled";
+    }
+    if (!std::filesystem::exists(cache)) {
+      std::error_code error;
+      if (!std::filesystem::create_directories(cache, error)) {
+        return std::filesystem::path();
+      }
+    }
+    return cache;
+  }();
+  return cache;
+}
+
+} // namespace
+
+std::function<std::vector<array>(const std::vector<array>&)> compile_persistent(
+    std::function<std::vector<array>(const std::vector<array>&)> fun,
+    const std::string& cache_key,
+    bool shapeless /* = false */) {
+  if (detail::skip_compile()) {
+    return fun;
+  }
+  auto& dir = compile_cache_dir();
+  if (dir.empty()) {
+    // No usable cache directory; behave like a plain compile
+    return compile(std::move(fun), shapeless);
+  }
+
+  struct PersistState {
+    std::filesystem::path path;
+    std::optional<ImportedFunction> imported;
+    std::optional<FunctionExporter> writer;
+    std::unordered_set<std::string> recorded;
+  };
+  auto state = std::make_shared<PersistState>();
+
+  // Sanitize the key into a file name
+  auto name = cache_key;
+  for (auto& c : name) {
+    if (!std::isalnum(static_cast<unsigned char>(c)) && c != '-' && c != '_') {
+      c = '_';
+    }
+  }
+  state->path = dir / (name + ".mlxfn");
+  if (std::filesystem::exists(state->path)) {
+    try {
+      state->imported = import_function(state->path.string());
+    } catch (const std::exception&) {
+      // Corrupt or stale file; retrace from scratch
+    }
+  }
+
+  // Build traces from the preloaded file when one matches so warm starts
+  // skip re-running the function
+  auto traced = [state, fun](const std::vector<array>& inputs) {
+    if (state->imported) {
+      try {
+        return (*state->imported)(inputs);
+      } catch (const std::invalid_argument&) {
+        // No stored trace for this signature
+      }
+    }
+    return fun(inputs);
+  };
+  auto compiled = detail::compile(
+      std::move(traced), std::hash<std::string>{}(cache_key), shapeless);
+
+  // Record specializations the file does not already cover. The export
+  // format is append-only per writer, so when a preloaded file exists new
+  // signatures are served from fresh traces and only persisted by runs that
+  // start without one.
+  return [state, fun = std::move(fun), compiled = std::move(compiled), shapeless](
+             const std::vector<array>& inputs) {
+    if (!state->imported) {
+      std::ostringstream sig;
+      for (auto& in : inputs) {
+        sig << in.dtype() << ":";
+        if (!shapeless) {
+          sig << in.shape() << ";";
+        }
+      }
+      if (state->recorded.insert(sig.str()).second) {
+        try {
+          if (!state->writer) {
+            state->writer.emplace(
+                exporter(state->path.string(), fun, shapeless));
+          }
+          (*state->writer)(inputs);
+        } catch (const std::exception&) {
+          // Persisting is best effort
+        }
+      }
+    }
+    return compiled(inputs);
+  };
+}
+
+CompileReport compile_report(
+    const std::function<std::vector<array>(const std::vector<array>&)>& fun,
+    const std::vector<array>& inputs,
+    int iterations /* = 10 */) {
+  if (iterations <= 0) {
+    throw std::invalid_argument(
+        "[compile_report] Iterations must be positive.");
+  }
+  auto compiled = compile(fun);
+
+  // Trace once to enumerate the segments the compiler produced
+  auto outputs = compiled(inputs);
+  CompileReport report;
+  std::unordered_map<std::string, size_t> segments;
+  for (auto& a : detail::compile_dfs(inputs, outputs, inputs).first) {
+    if (!a.has_primitive()) {
+      continue;
+    }
+    auto& p = a.primitive();
+    if (typeid(p) != typeid(Compiled)) {
+      continue;
+    }
+    auto& c = static_cast<const Compiled&>(p);
+    if (segments.emplace(p.name(), report.segments.size()).second) {
+      CompiledSegment segment;
+      segment.name = p.name();
+      segment.kernel = c.lib_name();
+      for (auto& t : c.tape()) {
+        segment.ops.push_back(t.primitive().name());
+      }
+      report.segments.push_back(std::move(segment));
+    }
+  }
+
+  // Warm up so kernel builds don't land in the measurement, then time
+  // with the profiler so rows line up with what eval dispatches
+  eval(outputs);
+  bool was_profiling = profiling_enabled();
+  enable_profiling(true);
+  auto first_event = profile_snapshot().size();
+  for (int i = 0; i < iterations; ++i) {
+    eval(compiled(inputs));
+  }
+  auto events = profile_snapshot();
+  enable_profiling(was_profiling);
+
+  std::unordered_map<std::string, size_t> unfused;
+  for (size_t i = first_event; i < events.size(); ++i) {
+    auto& event = events[i];
+    auto ms = event.duration_us * 1e-3;
+    if (auto it = segments.find(event.primitive); it != segments.end()) {
+      auto& segment = report.segments[it->second];
+      segment.calls++;
+      segment.duration_ms += ms;
+      report.fused_duration_ms += ms;
+    } else if (event.primitive != "command_buffer") {
+      auto [it2, inserted] =
+          unfused.emplace(event.primitive, report.unfused_ops.size());
+      if (inserted) {
+        report.unfused_ops.push_back({event.primitive, "", {}, 0, 0.0});
+      }
+      auto& op = report.unfused_ops[it2->second];
+      op.calls++;
+      op.duration_ms += ms;
+    } else {
+      continue;
+    }
+    report.total_duration_ms += ms;
+  }
+  std::sort(
+      report.unfused_ops.begin(),
+      report.unfused_ops.end(),
+      [](const auto& a, const auto& b) {
+        return a.duration_ms > b.duration_ms;
+      });
+  return report;
+}
+
+void print_compile_report(std::ostream& os, const CompileReport& report) {
+  os << "Fused segments:" << std::endl;
+  for (auto& segment : report.segments) {
+    os << "  " << segment.kernel << ": " << segment.calls << " calls, "
+       << segment.duration_ms << " ms" << std::endl
+       << "   ";
+    for (auto& op : segment.ops) {
+      os << " " << op;
+    }
+    os << std::endl;
+  }
+  os << "Unfused ops:" << std::endl;
+  for (auto& op : report.unfused_ops) {
+    os << "  " << op.name << ": " << op.calls << " calls, " << op.duration_ms
+       << " ms" << std::endl;
+  }
+  os << "Fused " << report.fused_duration_ms << " ms of "
+     << report.total_duration_ms << " ms dispatch time" << std::endl;
+}
+
+void register_rewrite_rule(const std::string& name, RewriteRule rule) {
+  if (!rule) {
+    throw std::invalid_argument(
+        "[register_rewrite_rule] Cannot register an empty rule.");
+  }
+  auto& registry = detail::rewrite_rule_registry();
+  {
+    std::lock_guard<std::mutex> lock(registry.mtx);
+    auto it = std::find_if(
+        registry.rules.begin(), registry.rules.end(), [&name](auto& r) {
+          return r.first == name;
+        });
+    if (it != registry.rules.end()) {
+      it->second = std::move(rule);
+    } else {
+      registry.rules.emplace_back(name, std::move(rule));
+    }
+  }
+  // Retrace already compiled functions so they pick up the rule
+  detail::compile_clear_cache();
+}
+
+void remove_rewrite_rule(const std::string& name) {
+  auto& registry = detail::rewrite_rule_registry();
+  {
+    std::lock_guard<std::mutex> lock(registry.mtx);
+    auto it = std::find_if(
+        registry.rules.begin(), registry.rules.end(), [&name](auto& r) {
+          return r.first == name;
+        });
+    if (it == registry.rules.end()) {
+      return;
+    }
+    registry.rules.erase(it);
+  }
+  detail::compile_clear_cache();
+}
+
+void set_placement_cost(const std::string& primitive, size_t cpu_faster_below) {
+  auto& registry = detail::placement_cost_registry();
+  {
+    std::lock_guard<std::mutex> lock(registry.mtx);
+    registry.crossovers[primitive] = cpu_faster_below;
+  }
+  // Retrace already compiled functions so placement sees the new cost
+  detail::compile_clear_cache();
+}
+
 void disable_compile() {
   detail::compile_mode() = CompileMode::disabled;
 }
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <optional>
+
 #include "mlx/array.h"
 
 namespace mlx::core {
@@ -28,6 +30,92 @@ std::function<std::vector<array>(const std::vector<array>&)> compile(
   return compile(+f, shapeless);
 }
 
+/** Compile a function with a persistent trace cache.
+ *
+ * Traced specializations are saved under ``cache_key`` in the compile cache
+ * directory (``MLX_COMPILE_CACHE_DIR``) using the export format, and
+ * preloaded on the next process start so a restart does not retrace. The
+ * key must be stable across processes and unique per function.
+ */
+std::function<std::vector<array>(const std::vector<array>&)> compile_persistent(
+    std::function<std::vector<array>(const std::vector<array>&)> fun,
+    const std::string& cache_key,
+    bool shapeless = false);
+
+/** One fused segment of a compiled function. */
+struct CompiledSegment {
+  /* Primitive name of the segment; matches the rows the profiler records. */
+  std::string name;
+  /* Name of the kernel library generated for the segment. */
+  std::string kernel;
+  /* Names of the source ops folded into the segment. */
+  std::vector<std::string> ops;
+  int calls{0};
+  double duration_ms{0.0};
+};
+
+struct CompileReport {
+  std::vector<CompiledSegment> segments;
+  /* Ops fusion left outside any segment, with dispatch counts and times.
+   * Elementwise entries here are the ones to chase when restructuring a
+   * model for fusability. */
+  std::vector<CompiledSegment> unfused_ops;
+  double fused_duration_ms{0.0};
+  double total_duration_ms{0.0};
+};
+
+/** Compile ``fun`` and run it ``iterations`` times on ``inputs``,
+ * reporting every fused segment — its source ops and generated kernel
+ * name — with its measured time, alongside the ops fusion left behind.
+ *
+ * Times come from the profiler, so they are host dispatch times; on
+ * Metal the device-side execution shows up in the profiler's
+ * ``command_buffer`` rows instead.
+ */
+CompileReport compile_report(
+    const std::function<std::vector<array>(const std::vector<array>&)>& fun,
+    const std::vector<array>& inputs,
+    int iterations = 10);
+
+/** Print a compile report in a human readable form. */
+void print_compile_report(std::ostream& os, const CompileReport& report);
+
+/** A compile-time rewrite rule.
+ *
+ * Called on each node of the trace of a function being compiled, outputs
+ * first. Return a replacement array computed from the node's subgraph
+ * inputs to rewrite the node in place, or ``std::nullopt`` to leave it
+ * alone. The replacement must have the same shape and dtype as the node
+ * and be produced by a single-output primitive — typically a custom
+ * primitive from an extension. Producers of the matched subgraph that are
+ * consumed elsewhere stay in the graph.
+ */
+using RewriteRule = std::function<std::optional<array>(const array&)>;
+
+/** Register a named rewrite rule applied during compilation.
+ *
+ * Replaces any rule already registered under ``name``. Rules are applied in
+ * registration order before the built-in fusions, and registering a rule
+ * clears the compile cache so already compiled functions retrace with it.
+ */
+void register_rewrite_rule(const std::string& name, RewriteRule rule);
+
+/** Remove a previously registered rewrite rule. */
+void remove_rewrite_rule(const std::string& name);
+
+/** Set the measured device-placement crossover for a primitive.
+ *
+ * Below ``cpu_faster_below`` output elements, ``primitive`` (named as in
+ * ``Primitive::name``) is taken to run faster on the CPU than on the GPU
+ * once dispatch overhead is counted. The placement pass (enabled with
+ * ``MLX_COMPILE_PLACEMENT``) uses these thresholds to move small segments
+ * of compiled functions to the CPU stream; primitives without an entry use
+ * the ``MLX_PLACEMENT_CROSSOVER`` default. The values are machine
+ * dependent — ``benchmarks/cpp/compare_devices.cpp`` measures them.
+ * Setting a cost clears the compile cache so compiled functions retrace.
+ */
+void set_placement_cost(const std::string& primitive, size_t cpu_faster_below);
+
 /** Globally disable compilation.
  * Setting the environment variable ``MLX_DISABLE_COMPILE`` can also
  * be used to disable compilation.
@@ -56,3 +56,13 @@ std::vector<array> compile_replace(
 void compile_validate_shapeless(const std::vector<array>& tape);
 
 } // namespace mlx::core::detail
+
+namespace mlx::core {
+
+class Primitive;
+
+// The elementwise fusability test used by compile_fuse (defined in
+// compile.cpp)
+bool is_fusable(const Primitive& p);
+
+} // namespace mlx::core
@@ -7,6 +7,7 @@
 #include "mlx/distributed/distributed_impl.h"
 #include "mlx/distributed/mpi/mpi.h"
 #include "mlx/distributed/nccl/nccl.h"
+#include "mlx/distributed/rdma/rdma.h"
 #include "mlx/distributed/ring/ring.h"
 
 namespace mlx::core::distributed {
@@ -41,6 +42,23 @@ void recv(Group group, array& out, int src, Stream stream) {
   group.raw_group()->recv(out, src, stream);
 }
 
+void reduce_scatter(
+    Group group,
+    const array& input,
+    array& output,
+    Stream stream) {
+  group.raw_group()->reduce_scatter(input, output, stream);
+}
+
+void broadcast(
+    Group group,
+    const array& input,
+    array& output,
+    int root,
+    Stream stream) {
+  group.raw_group()->broadcast(input, output, root, stream);
+}
+
 class EmptyGroup : public GroupImpl {
  public:
   Stream communication_stream(StreamOrDevice s) override {
@@ -85,12 +103,23 @@ class EmptyGroup : public GroupImpl {
     throw std::runtime_error(
         "Communication not implemented in an empty distributed group.");
   }
+
+  void reduce_scatter(const array&, array&, Stream) override {
+    throw std::runtime_error(
+        "Communication not implemented in an empty distributed group.");
+  }
+
+  void broadcast(const array&, array&, int, Stream) override {
+    throw std::runtime_error(
+        "Communication not implemented in an empty distributed group.");
+  }
 };
 
 } // namespace detail
 
 bool is_available() {
-  return mpi::is_available() || ring::is_available() || nccl::is_available();
+  return mpi::is_available() || ring::is_available() || nccl::is_available() ||
+      rdma::is_available();
 }
 
 int Group::rank() const {
@@ -123,11 +152,17 @@ Group init(bool strict /* = false */, const std::string& bk /* = "any" */) {
     group = ring::init(strict);
   } else if (bk == "nccl") {
     group = nccl::init(strict);
+  } else if (bk == "rdma") {
+    group = rdma::init(strict);
   } else if (bk == "any") {
     if (mlx::core::cu::is_available()) {
       group = nccl::init(false);
       bk_ = "nccl";
     }
+    if (group == nullptr) {
+      group = rdma::init(false);
+      bk_ = "rdma";
+    }
     if (group == nullptr) {
       group = ring::init(false);
       bk_ = "ring";
@@ -141,8 +176,8 @@ Group init(bool strict /* = false */, const std::string& bk /* = "any" */) {
     }
   } else {
     std::ostringstream msg;
-    msg << "[distributed] The only valid values for backend are 'any', 'mpi' "
-        << "and 'ring' but '" << bk << "' was provided.";
+    msg << "[distributed] The only valid values for backend are 'any', 'mpi', "
+        << "'ring', 'nccl' and 'rdma' but '" << bk << "' was provided.";
     throw std::invalid_argument(msg.str());
   }
 
@@ -28,6 +28,10 @@ class GroupImpl {
   virtual void recv(array& out, int src, Stream stream) = 0;
   virtual void all_max(const array& input, array& output, Stream stream) = 0;
   virtual void all_min(const array& input, array& output, Stream stream) = 0;
+  virtual void
+  reduce_scatter(const array& input, array& output, Stream stream) = 0;
+  virtual void
+  broadcast(const array& input, array& output, int root, Stream stream) = 0;
 };
 
 /* Define the MLX stream that the communication should happen in. */
@@ -51,4 +55,19 @@ void all_max(Group group, const array& input, array& output, Stream stream);
 /** Min reduction */
 void all_min(Group group, const array& input, array& output, Stream stream);
 
+/** Sum across ranks leaving each rank its own shard of the result */
+void reduce_scatter(
+    Group group,
+    const array& input,
+    array& output,
+    Stream stream);
+
+/** Replicate the root rank's input on every rank */
+void broadcast(
+    Group group,
+    const array& input,
+    array& output,
+    int root,
+    Stream stream);
+
 } // namespace mlx::core::distributed::detail
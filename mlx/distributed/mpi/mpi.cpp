@@ -1,5 +1,6 @@
 // Copyright © 2024 Apple Inc.
 
+#include <cstring>
 #include <dlfcn.h>
 #include <iostream>
 
@@ -122,6 +123,8 @@ struct MPIWrapper {
     LOAD_SYMBOL(MPI_Comm_free, comm_free);
     LOAD_SYMBOL(MPI_Allreduce, all_reduce);
     LOAD_SYMBOL(MPI_Allgather, all_gather);
+    LOAD_SYMBOL(MPI_Reduce_scatter_block, reduce_scatter_block);
+    LOAD_SYMBOL(MPI_Bcast, bcast);
     LOAD_SYMBOL(MPI_Send, send);
     LOAD_SYMBOL(MPI_Recv, recv);
     LOAD_SYMBOL(MPI_Type_contiguous, mpi_type_contiguous);
@@ -283,6 +286,14 @@ struct MPIWrapper {
       int,
       MPI_Datatype,
       MPI_Comm);
+  int (*reduce_scatter_block)(
+      const void*,
+      void*,
+      int,
+      MPI_Datatype,
+      MPI_Op,
+      MPI_Comm);
+  int (*bcast)(void*, int, MPI_Datatype, int, MPI_Comm);
   int (*comm_split)(MPI_Comm, int, int, MPI_Comm*);
   int (*comm_free)(MPI_Comm*);
   int (*send)(const void*, int, MPI_Datatype, int, int, MPI_Comm);
@@ -439,6 +450,42 @@ class MPIGroup : public GroupImpl {
         comm_);
   }
 
+  void reduce_scatter(const array& input, array& output, Stream stream)
+      override {
+    auto& encoder = cpu::get_command_encoder(stream);
+    encoder.set_input_array(input);
+    encoder.set_output_array(output);
+    encoder.dispatch(
+        mpi().reduce_scatter_block,
+        input.data<void>(),
+        output.data<void>(),
+        output.size(),
+        mpi().datatype(input),
+        mpi().op_sum(input),
+        comm_);
+  }
+
+  void broadcast(const array& input, array& output, int root, Stream stream)
+      override {
+    auto& encoder = cpu::get_command_encoder(stream);
+    encoder.set_input_array(input);
+    encoder.set_output_array(output);
+    encoder.dispatch([in_ptr = input.data<void>(),
+                      out_ptr = output.data<void>(),
+                      nbytes = output.nbytes(),
+                      out_size = output.size(),
+                      out_type = mpi().datatype(output),
+                      root,
+                      comm = comm_]() {
+      // MPI_Bcast operates in place so seed the output with the root's input
+      // before the call.
+      if (in_ptr != out_ptr) {
+        std::memcpy(out_ptr, in_ptr, nbytes);
+      }
+      mpi().bcast(out_ptr, out_size, out_type, root, comm);
+    });
+  }
+
   void send(const array& input, int dst, Stream stream) override {
     auto& encoder = cpu::get_command_encoder(stream);
     encoder.set_input_array(input);
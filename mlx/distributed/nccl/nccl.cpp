@@ -304,6 +304,40 @@ class NCCLGroup : public GroupImpl {
     throw std::runtime_error("[nccl] All min not supported in NCCL backend.");
   }
 
+  void reduce_scatter(const array& input, array& output, Stream stream)
+      override {
+    detail::dispatch_dtype(input, [&](auto type_tag, ncclDataType_t dt) {
+      using T = typename decltype(type_tag)::type;
+      auto& encoder = cu::get_command_encoder(stream);
+
+      CHECK_NCCL(ncclReduceScatter(
+          input.data<T>(),
+          output.data<T>(),
+          output.size(),
+          dt,
+          ncclSum,
+          comm_,
+          encoder.stream()));
+    });
+  }
+
+  void broadcast(const array& input, array& output, int root, Stream stream)
+      override {
+    detail::dispatch_dtype(input, [&](auto type_tag, ncclDataType_t dt) {
+      using T = typename decltype(type_tag)::type;
+      auto& encoder = cu::get_command_encoder(stream);
+
+      CHECK_NCCL(ncclBroadcast(
+          input.data<T>(),
+          output.data<T>(),
+          input.size(),
+          dt,
+          root,
+          comm_,
+          encoder.stream()));
+    });
+  }
+
   template <typename T>
   void all_reduce_impl(
       const array& input,
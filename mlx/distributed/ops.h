@@ -14,6 +14,40 @@ array all_sum(
     std::optional<Group> group = std::nullopt,
     StreamOrDevice s = {});
 
+/** Sum many arrays across ranks, coalescing small ones into buckets.
+ *
+ * Arrays are packed in order into fixed size fusion buffers (one per
+ * dtype, ``MLX_ALL_SUM_BUCKET_MB`` each) so hundreds of small gradients
+ * turn into a handful of collectives. Each bucket depends only on its
+ * own members, so in a lazy graph its all reduce starts as soon as
+ * those gradients are produced and overlaps with the remaining
+ * backward computation.
+ */
+std::vector<array> all_sum(
+    const std::vector<array>& xs,
+    std::optional<Group> group = std::nullopt,
+    StreamOrDevice s = {});
+
+/** Sum x across ranks sending int8 instead of full precision values.
+ *
+ * The input is quantized symmetrically in chunks of 256 elements with
+ * one scale per chunk, the quantized chunks and scales are exchanged
+ * with an all gather, and every rank dequantizes and sums locally.
+ * Traffic drops roughly 4x for float32 gradients at the cost of
+ * quantization noise in the sum.
+ *
+ * When ``error`` is given, it is added to x before quantizing and
+ * overwritten with the new local quantization residual (error
+ * feedback). Passing the same array on every call lets the rounding
+ * error accumulate into later steps instead of being lost, which keeps
+ * SGD-style training close to the uncompressed trajectory.
+ */
+array all_sum_quantized(
+    const array& x,
+    array* error = nullptr,
+    std::optional<Group> group = std::nullopt,
+    StreamOrDevice s = {});
+
 array all_gather(
     const array& x,
     std::optional<Group> group = std::nullopt,
@@ -38,6 +72,35 @@ array recv_like(
     std::optional<Group> group = std::nullopt,
     StreamOrDevice s = {});
 
+/** Send many arrays to dst as one pipelined, chunked transfer.
+ *
+ * The arrays are packed in order into contiguous chunks of roughly
+ * ``MLX_SEND_CHUNK_MB`` bytes (a chunk holds arrays of one dtype) and
+ * each chunk is sent separately, so packing the next chunk overlaps with
+ * the transfer of the previous one and many non contiguous blocks, e.g.
+ * the KV cache pages of a migrating sequence, cross the wire without a
+ * full size staging copy or a per block send. Returns a single scalar
+ * handle that completes when every chunk has been sent; evaluate it or
+ * pass it to ``wait`` to order work after the transfer.
+ */
+array send_batch(
+    const std::vector<array>& xs,
+    int dst,
+    std::optional<Group> group = std::nullopt,
+    StreamOrDevice s = {});
+
+/** Receive the arrays sent by a matching send_batch.
+ *
+ * ``xs`` only provides the shapes and dtypes of the expected arrays (its
+ * contents are never read) and must match the sender's argument so both
+ * sides derive the same chunking.
+ */
+std::vector<array> recv_batch_like(
+    const std::vector<array>& xs,
+    int src,
+    std::optional<Group> group = std::nullopt,
+    StreamOrDevice s = {});
+
 array all_max(
     const array& x,
     std::optional<Group> group = std::nullopt,
@@ -48,4 +111,64 @@ array all_min(
     std::optional<Group> group = std::nullopt,
     StreamOrDevice s = {});
 
+/** Sum x across ranks exploiting a two level topology.
+ *
+ * The group is split once (via Group::split) into node local groups of
+ * ``local_size`` ranks and a cross node group of the node leaders. The
+ * sum is computed as local all reduce, then all reduce among the
+ * leaders, then a node local broadcast, so the full tensor crosses the
+ * slow inter node link once per node instead of once per rank. With
+ * ``local_size`` of 0 the node size is read from ``MLX_LOCAL_SIZE``;
+ * ``all_sum`` on the global group routes here automatically when that
+ * variable is set. Falls back to the flat algorithm when the backend
+ * cannot split the group.
+ */
+array all_sum_hierarchical(
+    const array& x,
+    int local_size = 0,
+    std::optional<Group> group = std::nullopt,
+    StreamOrDevice s = {});
+
+/** Start an all_sum eagerly and return its output as a handle.
+ *
+ * The collective is scheduled on the communication stream right away
+ * (via async_eval) so it runs in the background while the caller keeps
+ * building the graph. Consuming the handle in a later op joins it into
+ * the graph with the usual cross-stream dependency; use ``wait`` to
+ * order unrelated computation after it explicitly.
+ */
+array all_sum_async(
+    const array& x,
+    std::optional<Group> group = std::nullopt,
+    StreamOrDevice s = {});
+
+/** Start an all_gather eagerly; see all_sum_async. */
+array all_gather_async(
+    const array& x,
+    std::optional<Group> group = std::nullopt,
+    StreamOrDevice s = {});
+
+/** Order xs after the completion of a started collective.
+ *
+ * Returns copies of xs that depend on the handle, so anything computed
+ * from them is scheduled only once the collective has finished. This is
+ * the join half of the async collective pattern:
+ *
+ *   auto h = all_gather_async(w);   // communication starts now
+ *   x = expensive_compute(x);       // overlaps with the gather
+ *   x = matmul(wait({x}, h)[0], h); // consume the gathered result
+ */
+std::vector<array> wait(const std::vector<array>& xs, const array& handle);
+
+array reduce_scatter(
+    const array& x,
+    std::optional<Group> group = std::nullopt,
+    StreamOrDevice s = {});
+
+array broadcast(
+    const array& x,
+    int root,
+    std::optional<Group> group = std::nullopt,
+    StreamOrDevice s = {});
+
 } // namespace mlx::core::distributed
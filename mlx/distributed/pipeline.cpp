@@ -0,0 +1,60 @@
+// Copyright © 2025 Apple Inc.
+
+#include "mlx/distributed/pipeline.h"
+
+namespace mlx::core::distributed {
+
+PipelineExecutor::PipelineExecutor(
+    std::function<array(const array&)> stage,
+    std::optional<Group> group /* = std::nullopt */,
+    int depth /* = 2 */)
+    : stage_(std::move(stage)),
+      group_(group.has_value() ? group.value() : distributed::init()),
+      depth_(std::max(depth, 1)) {}
+
+std::vector<array> PipelineExecutor::run(
+    const std::vector<array>& inputs,
+    const Shape& recv_shape,
+    Dtype recv_dtype,
+    StreamOrDevice s /* = {} */) {
+  int rank = group_.rank();
+  int size = group_.size();
+
+  // A single rank is a degenerate pipeline; just map the stage function.
+  if (size == 1) {
+    std::vector<array> outputs;
+    outputs.reserve(inputs.size());
+    for (auto& x : inputs) {
+      outputs.push_back(stage_(x));
+    }
+    return outputs;
+  }
+
+  bool first = (rank == 0);
+  bool last = (rank == size - 1);
+
+  // Micro batches are scheduled in the same order on every rank, so the
+  // serialized collectives on the communication stream pair up without
+  // deadlock while compute for other micro batches proceeds in parallel.
+  EvalPipeline pipeline(depth_);
+  std::vector<array> outputs;
+  for (size_t m = 0; m < inputs.size(); m++) {
+    auto x =
+        first ? inputs[m] : recv(recv_shape, recv_dtype, rank - 1, group_, s);
+    auto y = stage_(x);
+    if (!last) {
+      // The send aliases its input; tracking it forces the communication
+      // when the micro batch is evaluated.
+      y = send(y, rank + 1, group_, s);
+    }
+    pipeline.push({y});
+    if (last) {
+      outputs.push_back(std::move(y));
+    }
+  }
+  pipeline.wait_all();
+
+  return outputs;
+}
+
+} // namespace mlx::core::distributed
@@ -0,0 +1,60 @@
+// Copyright © 2025 Apple Inc.
+
+#pragma once
+
+#include <functional>
+#include <optional>
+
+#include "mlx/distributed/distributed.h"
+#include "mlx/distributed/ops.h"
+#include "mlx/transforms.h"
+
+namespace mlx::core::distributed {
+
+/**
+ * A micro-batch pipeline executor over a stage-split group.
+ *
+ * Every rank of the group runs one stage (rank r is stage r; pass a
+ * Group::split subgroup to pipeline over a subset of ranks). For each
+ * micro batch the executor builds the stage graph — receive the
+ * activation from the previous stage, apply the stage function, send the
+ * result to the next stage — and schedules it asynchronously, keeping at
+ * most `depth` micro batches in flight. With depth > 1 the communication
+ * stream exchanges one micro batch's activations while the compute
+ * stream works on another, so the stages stay busy instead of
+ * serializing on eager eval round trips.
+ *
+ * The number of micro batches must agree across ranks. The first stage
+ * consumes the entries of `inputs` as micro batches; later stages only
+ * use its length and receive their activations from the previous stage.
+ * run() returns the stage outputs of the last stage and an empty vector
+ * everywhere else.
+ */
+class PipelineExecutor {
+ public:
+  PipelineExecutor(
+      std::function<array(const array&)> stage,
+      std::optional<Group> group = std::nullopt,
+      int depth = 2);
+
+  std::vector<array> run(
+      const std::vector<array>& inputs,
+      const Shape& recv_shape,
+      Dtype recv_dtype,
+      StreamOrDevice s = {});
+
+  int stage() const {
+    return group_.rank();
+  }
+
+  int num_stages() const {
+    return group_.size();
+  }
+
+ private:
+  std::function<array(const array&)> stage_;
+  Group group_;
+  int depth_;
+};
+
+} // namespace mlx::core::distributed
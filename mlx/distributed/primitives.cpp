@@ -77,6 +77,33 @@ std::vector<array> AllGather::vjp(
   return {slice(cotangents[0], starts, stops)};
 }
 
+std::pair<std::vector<array>, std::vector<int>> ReduceScatter::vmap(
+    const std::vector<array>& inputs,
+    const std::vector<int>& axes) {
+  return {{reduce_scatter(inputs[0], group(), stream())}, axes};
+}
+
+std::vector<array> ReduceScatter::jvp(
+    const std::vector<array>& primals,
+    const std::vector<array>& tangents,
+    const std::vector<int>& argnums) {
+  return {reduce_scatter(tangents[0], group(), stream())};
+}
+
+std::vector<array> ReduceScatter::vjp(
+    const std::vector<array>& primals,
+    const std::vector<array>& cotangents,
+    const std::vector<int>& argnums,
+    const std::vector<array>& outputs) {
+  return {all_gather(cotangents[0], group(), stream())};
+}
+
+std::pair<std::vector<array>, std::vector<int>> Broadcast::vmap(
+    const std::vector<array>& inputs,
+    const std::vector<int>& axes) {
+  return {{broadcast(inputs[0], root_, group(), stream())}, axes};
+}
+
 std::pair<std::vector<array>, std::vector<int>> Send::vmap(
     const std::vector<array>& inputs,
     const std::vector<int>& axes) {
@@ -0,0 +1,20 @@
+// Copyright © 2025 Apple Inc.
+
+#include "mlx/distributed/rdma/rdma.h"
+
+namespace mlx::core::distributed::rdma {
+
+using GroupImpl = mlx::core::distributed::detail::GroupImpl;
+
+bool is_available() {
+  return false;
+}
+
+std::shared_ptr<GroupImpl> init(bool strict /* = false */) {
+  if (strict) {
+    throw std::runtime_error("Cannot initialize RDMA distributed backend.");
+  }
+  return nullptr;
+}
+
+} // namespace mlx::core::distributed::rdma
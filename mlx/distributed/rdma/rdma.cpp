@@ -0,0 +1,800 @@
+// Copyright © 2025 Apple Inc.
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+#include <infiniband/verbs.h>
+#include <json.hpp>
+
+#include "mlx/backend/cpu/encoder.h"
+#include "mlx/distributed/distributed.h"
+#include "mlx/distributed/distributed_impl.h"
+#include "mlx/distributed/rdma/rdma.h"
+#include "mlx/utils.h"
+
+#define SWITCH_TYPE(x, ...)  \
+  switch ((x).dtype()) {     \
+    case bool_: {            \
+      using T = bool;        \
+      __VA_ARGS__;           \
+    } break;                 \
+    case int8: {             \
+      using T = int8_t;      \
+      __VA_ARGS__;           \
+    } break;                 \
+    case int16: {            \
+      using T = int16_t;     \
+      __VA_ARGS__;           \
+    } break;                 \
+    case int32: {            \
+      using T = int32_t;     \
+      __VA_ARGS__;           \
+    } break;                 \
+    case int64: {            \
+      using T = int64_t;     \
+      __VA_ARGS__;           \
+    } break;                 \
+    case uint8: {            \
+      using T = uint8_t;     \
+      __VA_ARGS__;           \
+    } break;                 \
+    case uint16: {           \
+      using T = uint16_t;    \
+      __VA_ARGS__;           \
+    } break;                 \
+    case uint32: {           \
+      using T = uint32_t;    \
+      __VA_ARGS__;           \
+    } break;                 \
+    case uint64: {           \
+      using T = uint64_t;    \
+      __VA_ARGS__;           \
+    } break;                 \
+    case bfloat16: {         \
+      using T = bfloat16_t;  \
+      __VA_ARGS__;           \
+    } break;                 \
+    case float16: {          \
+      using T = float16_t;   \
+      __VA_ARGS__;           \
+    } break;                 \
+    case float32: {          \
+      using T = float;       \
+      __VA_ARGS__;           \
+    } break;                 \
+    case float64: {          \
+      using T = double;      \
+      __VA_ARGS__;           \
+    } break;                 \
+    case complex64: {        \
+      using T = complex64_t; \
+      __VA_ARGS__;           \
+    } break;                 \
+  }
+
+namespace mlx::core::distributed::rdma {
+
+constexpr const size_t BOUNCE_SIZE = 4 * 1024 * 1024;
+
+using GroupImpl = mlx::core::distributed::detail::GroupImpl;
+using json = nlohmann::json;
+
+namespace {
+
+template <typename T>
+struct SumOp {
+  void operator()(const T* input, T* output, size_t N) {
+    while (N-- > 0) {
+      *output += *input;
+      input++;
+      output++;
+    }
+  }
+};
+
+template <typename T>
+struct MaxOp {
+  void operator()(const T* input, T* output, size_t N) {
+    while (N-- > 0) {
+      *output = std::max(*output, *input);
+      input++;
+      output++;
+    }
+  }
+};
+
+template <typename T>
+struct MinOp {
+  void operator()(const T* input, T* output, size_t N) {
+    while (N-- > 0) {
+      *output = std::min(*output, *input);
+      input++;
+      output++;
+    }
+  }
+};
+
+[[noreturn]] void fail(const char* what) {
+  std::ostringstream msg;
+  msg << "[rdma] " << what << " failed (error: " << errno << ")";
+  throw std::runtime_error(msg.str());
+}
+
+/**
+ * The connection info each side needs about its peer to bring an RC queue
+ * pair to the ready-to-send state. Exchanged over the TCP bootstrap socket.
+ */
+struct QPInfo {
+  uint32_t qp_num;
+  uint16_t lid;
+  uint8_t gid[16];
+};
+
+/**
+ * Bootstrap TCP connections along the ring exactly like the ring backend:
+ * connect to the first address of the right neighbor and accept one
+ * connection on our own first address. The sockets are only used to
+ * exchange queue pair info and for teardown ordering.
+ */
+int bootstrap_connect(const std::string& ip, const std::string& port) {
+  struct addrinfo hints, *res;
+  std::memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  if (getaddrinfo(ip.c_str(), port.c_str(), &hints, &res) != 0) {
+    fail("getaddrinfo");
+  }
+
+  int sock = -1;
+  for (int attempt = 0; attempt < 30; attempt++) {
+    sock = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+    if (sock < 0) {
+      freeaddrinfo(res);
+      fail("socket");
+    }
+    if (connect(sock, res->ai_addr, res->ai_addrlen) == 0) {
+      break;
+    }
+    close(sock);
+    sock = -1;
+    sleep(1);
+  }
+  freeaddrinfo(res);
+  if (sock < 0) {
+    fail("connect");
+  }
+  return sock;
+}
+
+int bootstrap_accept(const std::string& ip, const std::string& port) {
+  struct addrinfo hints, *res;
+  std::memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  if (getaddrinfo(ip.c_str(), port.c_str(), &hints, &res) != 0) {
+    fail("getaddrinfo");
+  }
+
+  int sock = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+  if (sock < 0) {
+    freeaddrinfo(res);
+    fail("socket");
+  }
+  int enable = 1;
+  setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(int));
+  if (bind(sock, res->ai_addr, res->ai_addrlen) < 0 || listen(sock, 1) < 0) {
+    freeaddrinfo(res);
+    fail("bind/listen");
+  }
+  freeaddrinfo(res);
+
+  int peer = accept(sock, nullptr, nullptr);
+  shutdown(sock, 2);
+  close(sock);
+  if (peer < 0) {
+    fail("accept");
+  }
+  return peer;
+}
+
+void socket_exchange(int sock, const QPInfo& ours, QPInfo& theirs) {
+  if (::send(sock, &ours, sizeof(QPInfo), 0) != sizeof(QPInfo)) {
+    fail("bootstrap send");
+  }
+  if (::recv(sock, &theirs, sizeof(QPInfo), MSG_WAITALL) != sizeof(QPInfo)) {
+    fail("bootstrap recv");
+  }
+}
+
+std::pair<std::string, std::string> split_address(const std::string& ip_port) {
+  auto colon = ip_port.find(":");
+  if (colon == std::string::npos) {
+    std::ostringstream msg;
+    msg << "[rdma] Can't parse address " << ip_port;
+    throw std::runtime_error(msg.str());
+  }
+  return {ip_port.substr(0, colon), ip_port.substr(colon + 1)};
+}
+
+} // namespace
+
+class RDMAGroup : public GroupImpl {
+ public:
+  RDMAGroup(int rank, std::vector<std::string> nodes)
+      : rank_(rank), size_(nodes.size()) {
+    if (rank_ > 0 && rank_ >= size_) {
+      throw std::runtime_error(
+          "[rdma] Rank cannot be larger than the size of the group");
+    }
+
+    // Open the requested (or first) RDMA capable device and set up the
+    // protection domain and completion queue shared by both queue pairs.
+    int num_devices;
+    ibv_device** devices = ibv_get_device_list(&num_devices);
+    if (devices == nullptr || num_devices == 0) {
+      throw std::runtime_error("[rdma] No RDMA devices found");
+    }
+    const char* requested = std::getenv("MLX_RDMA_DEVICE");
+    ibv_device* device = devices[0];
+    if (requested != nullptr) {
+      device = nullptr;
+      for (int i = 0; i < num_devices; i++) {
+        if (std::strcmp(ibv_get_device_name(devices[i]), requested) == 0) {
+          device = devices[i];
+          break;
+        }
+      }
+      if (device == nullptr) {
+        std::ostringstream msg;
+        msg << "[rdma] Device " << requested << " not found";
+        ibv_free_device_list(devices);
+        throw std::runtime_error(msg.str());
+      }
+    }
+    ctx_ = ibv_open_device(device);
+    ibv_free_device_list(devices);
+    if (ctx_ == nullptr) {
+      throw std::runtime_error("[rdma] Couldn't open device");
+    }
+    pd_ = ibv_alloc_pd(ctx_);
+    cq_ = ibv_create_cq(ctx_, 256, nullptr, nullptr, 0);
+    if (pd_ == nullptr || cq_ == nullptr) {
+      throw std::runtime_error("[rdma] Couldn't allocate PD/CQ");
+    }
+
+    port_ = env::get_var("MLX_RDMA_PORT", 1);
+    gid_index_ = env::get_var("MLX_RDMA_GID_INDEX", 0);
+
+    // Registered bounce buffers for the staged data path. Buffers that can
+    // be registered directly (including CUDA buffers when GPUDirect is
+    // available) bypass these entirely.
+    bounce_send_.resize(BOUNCE_SIZE);
+    bounce_recv_.resize(BOUNCE_SIZE);
+    mr_send_ = ibv_reg_mr(
+        pd_, bounce_send_.data(), BOUNCE_SIZE, IBV_ACCESS_LOCAL_WRITE);
+    mr_recv_ = ibv_reg_mr(
+        pd_, bounce_recv_.data(), BOUNCE_SIZE, IBV_ACCESS_LOCAL_WRITE);
+    if (mr_send_ == nullptr || mr_recv_ == nullptr) {
+      throw std::runtime_error("[rdma] Couldn't register bounce buffers");
+    }
+
+    if (size_ > 1) {
+      qp_right_ = create_qp();
+      qp_left_ = create_qp();
+
+      // Same connection order as the ring backend so the two sides of each
+      // TCP bootstrap agree on who connects and who accepts.
+      int connect_to = (rank_ + 1) % size_;
+      auto [my_ip, my_port] = split_address(nodes[rank_]);
+      auto [peer_ip, peer_port] = split_address(nodes[connect_to]);
+      if (rank_ < connect_to) {
+        sock_left_ = bootstrap_accept(my_ip, my_port);
+        sock_right_ = bootstrap_connect(peer_ip, peer_port);
+      } else {
+        sock_right_ = bootstrap_connect(peer_ip, peer_port);
+        sock_left_ = bootstrap_accept(my_ip, my_port);
+      }
+
+      connect_qp(qp_right_, sock_right_);
+      connect_qp(qp_left_, sock_left_);
+    }
+  }
+
+  ~RDMAGroup() {
+    for (auto& [ptr, mr] : mr_cache_) {
+      ibv_dereg_mr(mr);
+    }
+    if (qp_right_ != nullptr) {
+      ibv_destroy_qp(qp_right_);
+    }
+    if (qp_left_ != nullptr) {
+      ibv_destroy_qp(qp_left_);
+    }
+    ibv_dereg_mr(mr_send_);
+    ibv_dereg_mr(mr_recv_);
+    ibv_destroy_cq(cq_);
+    ibv_dealloc_pd(pd_);
+    ibv_close_device(ctx_);
+    if (sock_right_ >= 0) {
+      shutdown(sock_right_, 2);
+      close(sock_right_);
+    }
+    if (sock_left_ >= 0) {
+      shutdown(sock_left_, 2);
+      close(sock_left_);
+    }
+  }
+
+  Stream communication_stream(StreamOrDevice s) override {
+    return to_stream(s, Device::cpu);
+  }
+
+  int rank() override {
+    return rank_;
+  }
+
+  int size() override {
+    return size_;
+  }
+
+  std::shared_ptr<GroupImpl> split(int color, int key = -1) override {
+    throw std::runtime_error("[rdma] Group split not supported.");
+  }
+
+  void all_sum(const array& input, array& output, Stream stream) override {
+    SWITCH_TYPE(output, all_reduce<T>(input, output, stream, SumOp<T>()));
+  }
+
+  void all_max(const array& input, array& output, Stream stream) override {
+    SWITCH_TYPE(output, all_reduce<T>(input, output, stream, MaxOp<T>()));
+  }
+
+  void all_min(const array& input, array& output, Stream stream) override {
+    SWITCH_TYPE(output, all_reduce<T>(input, output, stream, MinOp<T>()));
+  }
+
+  void all_gather(const array& input, array& output, Stream stream) override {
+    auto& encoder = cpu::get_command_encoder(stream);
+    encoder.set_input_array(input);
+    encoder.set_output_array(output);
+    encoder.dispatch([in_ptr = input.data<char>(),
+                      out_ptr = output.data<char>(),
+                      nbytes = input.nbytes(),
+                      this]() {
+      // Rotate segments around the ring; after size_ - 1 steps every rank
+      // has every segment.
+      std::memcpy(out_ptr + rank_ * nbytes, in_ptr, nbytes);
+      int send_segment = rank_;
+      int recv_segment = (rank_ + size_ - 1) % size_;
+      for (int i = 0; i < size_ - 1; i++) {
+        transfer(
+            out_ptr + send_segment * nbytes,
+            out_ptr + recv_segment * nbytes,
+            nbytes);
+        send_segment = recv_segment;
+        recv_segment = (recv_segment + size_ - 1) % size_;
+      }
+    });
+  }
+
+  void send(const array& input, int dst, Stream stream) override {
+    auto& encoder = cpu::get_command_encoder(stream);
+    encoder.set_input_array(input);
+    encoder.dispatch(
+        [in_ptr = input.data<char>(), nbytes = input.nbytes(), dst, this]() {
+          int right = (rank_ + 1) % size_;
+          int left = (rank_ + size_ - 1) % size_;
+          if (dst == right) {
+            send_bytes(qp_right_, in_ptr, nbytes);
+          } else if (dst == left) {
+            send_bytes(qp_left_, in_ptr, nbytes);
+          } else {
+            std::ostringstream msg;
+            msg << "[rdma] Send only supported to direct neighbors "
+                << "but tried to send to " << dst << " from " << rank_;
+            throw std::runtime_error(msg.str());
+          }
+        });
+  }
+
+  void recv(array& out, int src, Stream stream) override {
+    auto& encoder = cpu::get_command_encoder(stream);
+    encoder.set_output_array(out);
+    encoder.dispatch(
+        [out_ptr = out.data<char>(), nbytes = out.nbytes(), src, this]() {
+          int right = (rank_ + 1) % size_;
+          int left = (rank_ + size_ - 1) % size_;
+          if (src == left) {
+            recv_bytes(qp_left_, out_ptr, nbytes);
+          } else if (src == right) {
+            recv_bytes(qp_right_, out_ptr, nbytes);
+          } else {
+            std::ostringstream msg;
+            msg << "[rdma] Recv only supported from direct neighbors "
+                << "but tried to recv from " << src << " to " << rank_;
+            throw std::runtime_error(msg.str());
+          }
+        });
+  }
+
+  void reduce_scatter(const array& input, array& output, Stream stream)
+      override {
+    auto& encoder = cpu::get_command_encoder(stream);
+    encoder.set_input_array(input);
+    encoder.set_output_array(output);
+    encoder.dispatch([input, output, this]() mutable {
+      std::vector<char> scratch(input.nbytes());
+      SWITCH_TYPE(
+          output,
+          all_reduce_impl<T>(
+              input.data<char>(),
+              scratch.data(),
+              input.size(),
+              SumOp<T>()));
+      std::memcpy(
+          output.data<char>(),
+          scratch.data() + rank_ * output.nbytes(),
+          output.nbytes());
+    });
+  }
+
+  void broadcast(const array& input, array& output, int root, Stream stream)
+      override {
+    auto& encoder = cpu::get_command_encoder(stream);
+    encoder.set_input_array(input);
+    encoder.set_output_array(output);
+    encoder.dispatch([in_ptr = input.data<char>(),
+                      out_ptr = output.data<char>(),
+                      nbytes = output.nbytes(),
+                      root,
+                      this]() {
+      int right = (rank_ + 1) % size_;
+      int left = (rank_ + size_ - 1) % size_;
+      if (rank_ == root) {
+        std::memcpy(out_ptr, in_ptr, nbytes);
+        send_bytes(qp_right_, out_ptr, nbytes);
+      } else {
+        recv_bytes(qp_left_, out_ptr, nbytes);
+        if (right != root) {
+          send_bytes(qp_right_, out_ptr, nbytes);
+        }
+      }
+    });
+  }
+
+ private:
+  ibv_qp* create_qp() {
+    ibv_qp_init_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.send_cq = cq_;
+    attr.recv_cq = cq_;
+    attr.qp_type = IBV_QPT_RC;
+    attr.cap.max_send_wr = 64;
+    attr.cap.max_recv_wr = 64;
+    attr.cap.max_send_sge = 1;
+    attr.cap.max_recv_sge = 1;
+    ibv_qp* qp = ibv_create_qp(pd_, &attr);
+    if (qp == nullptr) {
+      throw std::runtime_error("[rdma] Couldn't create queue pair");
+    }
+    return qp;
+  }
+
+  void connect_qp(ibv_qp* qp, int sock) {
+    ibv_port_attr port_attr;
+    if (ibv_query_port(ctx_, port_, &port_attr) != 0) {
+      throw std::runtime_error("[rdma] Couldn't query port");
+    }
+    QPInfo ours, theirs;
+    ours.qp_num = qp->qp_num;
+    ours.lid = port_attr.lid;
+    ibv_gid gid;
+    std::memset(&gid, 0, sizeof(gid));
+    ibv_query_gid(ctx_, port_, gid_index_, &gid);
+    std::memcpy(ours.gid, &gid, 16);
+    socket_exchange(sock, ours, theirs);
+
+    // INIT
+    ibv_qp_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.qp_state = IBV_QPS_INIT;
+    attr.pkey_index = 0;
+    attr.port_num = port_;
+    attr.qp_access_flags = IBV_ACCESS_LOCAL_WRITE | IBV_ACCESS_REMOTE_WRITE;
+    if (ibv_modify_qp(
+            qp,
+            &attr,
+            IBV_QP_STATE | IBV_QP_PKEY_INDEX | IBV_QP_PORT |
+                IBV_QP_ACCESS_FLAGS) != 0) {
+      throw std::runtime_error("[rdma] Couldn't move queue pair to INIT");
+    }
+
+    // RTR. Over RoCE (lid 0) the address handle must carry the GRH with
+    // the peer's GID.
+    std::memset(&attr, 0, sizeof(attr));
+    attr.qp_state = IBV_QPS_RTR;
+    attr.path_mtu = IBV_MTU_1024;
+    attr.dest_qp_num = theirs.qp_num;
+    attr.rq_psn = 0;
+    attr.max_dest_rd_atomic = 1;
+    attr.min_rnr_timer = 12;
+    attr.ah_attr.dlid = theirs.lid;
+    attr.ah_attr.sl = 0;
+    attr.ah_attr.src_path_bits = 0;
+    attr.ah_attr.port_num = port_;
+    if (theirs.lid == 0) {
+      attr.ah_attr.is_global = 1;
+      std::memcpy(&attr.ah_attr.grh.dgid, theirs.gid, 16);
+      attr.ah_attr.grh.sgid_index = gid_index_;
+      attr.ah_attr.grh.hop_limit = 64;
+    }
+    if (ibv_modify_qp(
+            qp,
+            &attr,
+            IBV_QP_STATE | IBV_QP_AV | IBV_QP_PATH_MTU | IBV_QP_DEST_QPN |
+                IBV_QP_RQ_PSN | IBV_QP_MAX_DEST_RD_ATOMIC |
+                IBV_QP_MIN_RNR_TIMER) != 0) {
+      throw std::runtime_error("[rdma] Couldn't move queue pair to RTR");
+    }
+
+    // RTS. The infinite rnr retry lets receivers post their buffers lazily
+    // without a separate readiness handshake.
+    std::memset(&attr, 0, sizeof(attr));
+    attr.qp_state = IBV_QPS_RTS;
+    attr.timeout = 14;
+    attr.retry_cnt = 7;
+    attr.rnr_retry = 7;
+    attr.sq_psn = 0;
+    attr.max_rd_atomic = 1;
+    if (ibv_modify_qp(
+            qp,
+            &attr,
+            IBV_QP_STATE | IBV_QP_TIMEOUT | IBV_QP_RETRY_CNT |
+                IBV_QP_RNR_RETRY | IBV_QP_SQ_PSN | IBV_QP_MAX_QP_RD_ATOMIC) !=
+        0) {
+      throw std::runtime_error("[rdma] Couldn't move queue pair to RTS");
+    }
+  }
+
+  /**
+   * Look up or create a memory region for a user buffer. Registration
+   * pins the pages with the HCA; for buffers allocated by the CUDA
+   * allocator it succeeds exactly when GPUDirect RDMA (nvidia-peermem) is
+   * available, in which case the NIC reads and writes device memory
+   * directly and the staged copy is skipped.
+   */
+  ibv_mr* get_mr(void* ptr, size_t nbytes) {
+    std::lock_guard<std::mutex> lock(mr_mutex_);
+    if (auto it = mr_cache_.find(ptr); it != mr_cache_.end()) {
+      if (it->second->length >= nbytes) {
+        return it->second;
+      }
+      ibv_dereg_mr(it->second);
+      mr_cache_.erase(it);
+    }
+    ibv_mr* mr = ibv_reg_mr(pd_, ptr, nbytes, IBV_ACCESS_LOCAL_WRITE);
+    if (mr != nullptr) {
+      mr_cache_.emplace(ptr, mr);
+    }
+    return mr;
+  }
+
+  void post_send(ibv_qp* qp, void* ptr, size_t nbytes, uint32_t lkey) {
+    ibv_sge sge;
+    sge.addr = reinterpret_cast<uint64_t>(ptr);
+    sge.length = nbytes;
+    sge.lkey = lkey;
+    ibv_send_wr wr, *bad;
+    std::memset(&wr, 0, sizeof(wr));
+    wr.sg_list = &sge;
+    wr.num_sge = 1;
+    wr.opcode = IBV_WR_SEND;
+    wr.send_flags = IBV_SEND_SIGNALED;
+    if (ibv_post_send(qp, &wr, &bad) != 0) {
+      throw std::runtime_error("[rdma] Posting a send failed");
+    }
+  }
+
+  void post_recv(ibv_qp* qp, void* ptr, size_t nbytes, uint32_t lkey) {
+    ibv_sge sge;
+    sge.addr = reinterpret_cast<uint64_t>(ptr);
+    sge.length = nbytes;
+    sge.lkey = lkey;
+    ibv_recv_wr wr, *bad;
+    std::memset(&wr, 0, sizeof(wr));
+    wr.sg_list = &sge;
+    wr.num_sge = 1;
+    if (ibv_post_recv(qp, &wr, &bad) != 0) {
+      throw std::runtime_error("[rdma] Posting a recv failed");
+    }
+  }
+
+  /* Spin on the completion queue until `sends` send and `recvs` recv
+   * completions have drained. */
+  void wait_completions(int sends, int recvs) {
+    ibv_wc wc[16];
+    while (sends > 0 || recvs > 0) {
+      int n = ibv_poll_cq(cq_, 16, wc);
+      if (n < 0) {
+        throw std::runtime_error("[rdma] Polling the completion queue failed");
+      }
+      for (int i = 0; i < n; i++) {
+        if (wc[i].status != IBV_WC_SUCCESS) {
+          std::ostringstream msg;
+          msg << "[rdma] Work completion failed with status "
+              << ibv_wc_status_str(wc[i].status);
+          throw std::runtime_error(msg.str());
+        }
+        if (wc[i].opcode == IBV_WC_RECV) {
+          recvs--;
+        } else {
+          sends--;
+        }
+      }
+    }
+  }
+
+  /* Send to the right neighbor while receiving from the left; used as the
+   * building block of all ring collectives. */
+  void transfer(const char* src, char* dst, size_t nbytes) {
+    auto src_mr = get_mr(const_cast<char*>(src), nbytes);
+    auto dst_mr = get_mr(dst, nbytes);
+    if (src_mr != nullptr && dst_mr != nullptr) {
+      post_recv(qp_left_, dst, nbytes, dst_mr->lkey);
+      post_send(qp_right_, const_cast<char*>(src), nbytes, src_mr->lkey);
+      wait_completions(1, 1);
+      return;
+    }
+
+    // Staged path through the registered bounce buffers.
+    for (size_t offset = 0; offset < nbytes; offset += BOUNCE_SIZE) {
+      size_t n = std::min(BOUNCE_SIZE, nbytes - offset);
+      std::memcpy(bounce_send_.data(), src + offset, n);
+      post_recv(qp_left_, bounce_recv_.data(), n, mr_recv_->lkey);
+      post_send(qp_right_, bounce_send_.data(), n, mr_send_->lkey);
+      wait_completions(1, 1);
+      std::memcpy(dst + offset, bounce_recv_.data(), n);
+    }
+  }
+
+  void send_bytes(ibv_qp* qp, const char* src, size_t nbytes) {
+    if (auto mr = get_mr(const_cast<char*>(src), nbytes); mr != nullptr) {
+      post_send(qp, const_cast<char*>(src), nbytes, mr->lkey);
+      wait_completions(1, 0);
+      return;
+    }
+    for (size_t offset = 0; offset < nbytes; offset += BOUNCE_SIZE) {
+      size_t n = std::min(BOUNCE_SIZE, nbytes - offset);
+      std::memcpy(bounce_send_.data(), src + offset, n);
+      post_send(qp, bounce_send_.data(), n, mr_send_->lkey);
+      wait_completions(1, 0);
+    }
+  }
+
+  void recv_bytes(ibv_qp* qp, char* dst, size_t nbytes) {
+    if (auto mr = get_mr(dst, nbytes); mr != nullptr) {
+      post_recv(qp, dst, nbytes, mr->lkey);
+      wait_completions(0, 1);
+      return;
+    }
+    for (size_t offset = 0; offset < nbytes; offset += BOUNCE_SIZE) {
+      size_t n = std::min(BOUNCE_SIZE, nbytes - offset);
+      post_recv(qp, bounce_recv_.data(), n, mr_recv_->lkey);
+      wait_completions(0, 1);
+      std::memcpy(dst + offset, bounce_recv_.data(), n);
+    }
+  }
+
+  template <typename T, typename ReduceOp>
+  void all_reduce(
+      const array& input,
+      array& output,
+      Stream stream,
+      ReduceOp reduce_op) {
+    auto& encoder = cpu::get_command_encoder(stream);
+    encoder.set_input_array(input);
+    encoder.set_output_array(output);
+    encoder.dispatch([in_ptr = input.data<char>(),
+                      out_ptr = output.data<char>(),
+                      size = input.size(),
+                      reduce_op,
+                      this]() {
+      all_reduce_impl<T>(in_ptr, out_ptr, size, reduce_op);
+    });
+  }
+
+  template <typename T, typename ReduceOp>
+  void all_reduce_impl(
+      const char* in_ptr,
+      char* out_ptr,
+      size_t size,
+      ReduceOp reduce_op) {
+    // Rotate every rank's input around the ring and fold each arriving
+    // buffer into the local accumulator. Simpler than the two phase
+    // reduce-scatter / all-gather schedule; the wire time is dominated by
+    // the per-hop latency this backend exists to cut.
+    size_t nbytes = size * sizeof(T);
+    if (out_ptr != in_ptr) {
+      std::memcpy(out_ptr, in_ptr, nbytes);
+    }
+    std::vector<char> rotate(nbytes);
+    std::vector<char> incoming(nbytes);
+    std::memcpy(rotate.data(), in_ptr, nbytes);
+    for (int i = 0; i < size_ - 1; i++) {
+      transfer(rotate.data(), incoming.data(), nbytes);
+      reduce_op(
+          reinterpret_cast<const T*>(incoming.data()),
+          reinterpret_cast<T*>(out_ptr),
+          size);
+      std::swap(rotate, incoming);
+    }
+  }
+
+  int rank_;
+  int size_;
+  uint8_t port_;
+  int gid_index_;
+
+  ibv_context* ctx_{nullptr};
+  ibv_pd* pd_{nullptr};
+  ibv_cq* cq_{nullptr};
+  ibv_qp* qp_right_{nullptr};
+  ibv_qp* qp_left_{nullptr};
+  ibv_mr* mr_send_{nullptr};
+  ibv_mr* mr_recv_{nullptr};
+
+  int sock_right_{-1};
+  int sock_left_{-1};
+
+  std::vector<char> bounce_send_;
+  std::vector<char> bounce_recv_;
+
+  std::mutex mr_mutex_;
+  std::unordered_map<void*, ibv_mr*> mr_cache_;
+};
+
+bool is_available() {
+  int num_devices;
+  ibv_device** devices = ibv_get_device_list(&num_devices);
+  if (devices != nullptr) {
+    ibv_free_device_list(devices);
+  }
+  return devices != nullptr && num_devices > 0;
+}
+
+std::shared_ptr<GroupImpl> init(bool strict /* = false */) {
+  const char* hostfile = std::getenv("MLX_HOSTFILE");
+  const char* rank_str = std::getenv("MLX_RANK");
+
+  if (!hostfile || !rank_str || !is_available()) {
+    if (strict) {
+      throw std::runtime_error(
+          "[rdma] Initialization requires an RDMA device and both "
+          "MLX_HOSTFILE and MLX_RANK to be set");
+    }
+    return nullptr;
+  }
+
+  // The hostfile is the same json list the ring backend uses; only the
+  // first address of each rank is needed for the bootstrap.
+  std::vector<std::string> nodes;
+  std::ifstream f(hostfile);
+  json hosts = json::parse(f);
+  for (auto& h : hosts) {
+    nodes.push_back(h.at(0).get<std::string>());
+  }
+
+  return std::make_shared<RDMAGroup>(std::atoi(rank_str), nodes);
+}
+
+} // namespace mlx::core::distributed::rdma
@@ -19,10 +19,16 @@
 
 #include <json.hpp>
 
+#include "mlx/allocator.h"
 #include "mlx/backend/cpu/encoder.h"
 #include "mlx/distributed/distributed.h"
 #include "mlx/distributed/distributed_impl.h"
 #include "mlx/threadpool.h"
+#include "mlx/utils.h"
+
+#if defined(__linux__) && defined(MSG_ZEROCOPY)
+#include <linux/errqueue.h>
+#endif
 
 #ifndef SOL_TCP
 #define SOL_TCP IPPROTO_TCP
@@ -94,6 +100,7 @@ constexpr const size_t ALL_SUM_SIZE = 8 * 1024 * 1024;
 constexpr const size_t ALL_SUM_BUFFERS = 2;
 constexpr const int CONN_ATTEMPTS = 5;
 constexpr const int CONN_WAIT = 1000;
+constexpr const size_t ZEROCOPY_THRESHOLD = 16 * 1024;
 
 using GroupImpl = mlx::core::distributed::detail::GroupImpl;
 using json = nlohmann::json;
@@ -128,6 +135,13 @@ decltype(T() * U()) ceildiv(T a, U b) {
 class SocketThread {
  public:
   SocketThread(int fd) : fd_(fd), stop_(false) {
+#if defined(__linux__) && defined(MSG_ZEROCOPY)
+    if (env::get_var("MLX_RING_ZEROCOPY", 0)) {
+      int one = 1;
+      zerocopy_ =
+          setsockopt(fd, SOL_SOCKET, SO_ZEROCOPY, &one, sizeof(one)) == 0;
+    }
+#endif
     worker_ = std::thread(&SocketThread::worker, this);
     int flags = fcntl(fd, F_GETFL, 0);
     fcntl(fd, F_SETFL, flags | O_NONBLOCK);
@@ -246,16 +260,32 @@ class SocketThread {
       }
       if (!sends_.empty()) {
         auto& task = sends_.front();
-        ssize_t r = ::send(fd_, task.buffer, task.size, 0);
-        if (r > 0) {
-          task.buffer = static_cast<char*>(task.buffer) + r;
-          task.size -= r;
-          delete_send = task.size == 0;
-          error_count = 0;
-        } else if (errno != EAGAIN) {
-          error_count++;
-          log_info(true, "Sending to socket", fd_, "failed with errno", errno);
+        if (task.size > 0) {
+          int flags = 0;
+#if defined(__linux__) && defined(MSG_ZEROCOPY)
+          if (zerocopy_ && task.size >= ZEROCOPY_THRESHOLD) {
+            flags = MSG_ZEROCOPY;
+          }
+#endif
+          ssize_t r = ::send(fd_, task.buffer, task.size, flags);
+          if (r > 0) {
+            task.buffer = static_cast<char*>(task.buffer) + r;
+            task.size -= r;
+            zerocopy_outstanding_ += (flags != 0);
+            error_count = 0;
+          } else if (errno != EAGAIN && errno != ENOBUFS) {
+            error_count++;
+            log_info(
+                true, "Sending to socket", fd_, "failed with errno", errno);
+          }
+        }
+        // Zero-copy sends pin the caller's pages until the kernel reports
+        // the transmission completed, so the task (and hence the buffer)
+        // is only released once every completion has been reaped.
+        if (zerocopy_outstanding_ > 0) {
+          reap_zerocopy_completions();
         }
+        delete_send = task.size == 0 && zerocopy_outstanding_ == 0;
       }
 
       if (error_count >= 10) {
@@ -265,8 +295,36 @@ class SocketThread {
     }
   }
 
+  void reap_zerocopy_completions() {
+#if defined(__linux__) && defined(MSG_ZEROCOPY)
+    while (zerocopy_outstanding_ > 0) {
+      char control[64];
+      msghdr msg{};
+      msg.msg_control = control;
+      msg.msg_controllen = sizeof(control);
+      if (recvmsg(fd_, &msg, MSG_ERRQUEUE) < 0) {
+        return;
+      }
+      for (auto cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr;
+           cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if ((cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR) ||
+            (cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR)) {
+          auto err = reinterpret_cast<sock_extended_err*>(CMSG_DATA(cmsg));
+          if (err->ee_origin == SO_EE_ORIGIN_ZEROCOPY) {
+            size_t completed = err->ee_data - err->ee_info + 1;
+            zerocopy_outstanding_ -=
+                std::min(completed, zerocopy_outstanding_);
+          }
+        }
+      }
+    }
+#endif
+  }
+
   int fd_;
   bool stop_;
+  bool zerocopy_{false};
+  size_t zerocopy_outstanding_{0};
   std::thread worker_;
   std::mutex queue_mutex_;
   std::condition_variable condition_;
@@ -374,10 +432,17 @@ std::vector<std::vector<address_t>> load_nodes(const char* hostfile) {
 }
 
 /**
- * Create a socket and accept one connection for each of the provided
+ * Create a socket and accept `conns` connections for each of the provided
  * addresses.
+ *
+ * When more than one connection is made per address (link striping), the
+ * arrival order of the connections is not deterministic so each one is
+ * matched to its peer by the stripe index the connector sends right after
+ * connecting.
  */
-std::vector<int> accept_connections(const std::vector<address_t>& addresses) {
+std::vector<int> accept_connections(
+    const std::vector<address_t>& addresses,
+    int conns) {
   std::vector<int> sockets;
   int success;
 
@@ -421,7 +486,7 @@ std::vector<int> accept_connections(const std::vector<address_t>& addresses) {
     }
 
     // Wait for connections
-    success = listen(sock, 0);
+    success = listen(sock, conns);
     if (success < 0) {
       shutdown(sock, 2);
       close(sock);
@@ -430,75 +495,108 @@ std::vector<int> accept_connections(const std::vector<address_t>& addresses) {
       throw std::runtime_error(msg.str());
     }
 
-    int peer_socket = accept(sock, nullptr, nullptr);
-    if (peer_socket < 0) {
-      shutdown(sock, 2);
-      close(sock);
-      std::ostringstream msg;
-      msg << "[ring] Accept failed (error: " << errno << ")";
-      throw std::runtime_error(msg.str());
+    std::vector<int> stripes(conns, -1);
+    for (int i = 0; i < conns; i++) {
+      int peer_socket = accept(sock, nullptr, nullptr);
+      if (peer_socket < 0) {
+        shutdown(sock, 2);
+        close(sock);
+        std::ostringstream msg;
+        msg << "[ring] Accept failed (error: " << errno << ")";
+        throw std::runtime_error(msg.str());
+      }
+
+      if (conns == 1) {
+        stripes[0] = peer_socket;
+        continue;
+      }
+
+      // Read the stripe index so that data channel k on this side pairs
+      // with data channel k on the peer.
+      unsigned char stripe;
+      if (::recv(peer_socket, &stripe, 1, MSG_WAITALL) != 1 ||
+          stripe >= conns || stripes[stripe] >= 0) {
+        shutdown(sock, 2);
+        close(sock);
+        std::ostringstream msg;
+        msg << "[ring] Invalid stripe handshake (error: " << errno << ")";
+        throw std::runtime_error(msg.str());
+      }
+      stripes[stripe] = peer_socket;
     }
 
     // Close the listening socket
     shutdown(sock, 2);
     close(sock);
 
-    sockets.push_back(peer_socket);
+    sockets.insert(sockets.end(), stripes.begin(), stripes.end());
   }
 
   return sockets;
 }
 
 /**
- * The counterpoint of `accept_connections`. Basically connect to each of the
- * provided addresses.
+ * The counterpoint of `accept_connections`. Basically connect `conns` times
+ * to each of the provided addresses.
  */
 std::vector<int> make_connections(
     const std::vector<address_t>& addresses,
+    int conns,
     bool verbose) {
   std::vector<int> sockets;
   int success;
 
   for (auto& address : addresses) {
-    int sock;
-
-    // Attempt to connect to the peer CONN_ATTEMPTS times with exponential
-    // backoff. TODO: Do we need that?
-    for (int attempt = 0; attempt < CONN_ATTEMPTS; attempt++) {
-      // Create the socket
-      sock = socket(AF_INET, SOCK_STREAM, 0);
-      if (sock < 0) {
+    for (int i = 0; i < conns; i++) {
+      int sock;
+
+      // Attempt to connect to the peer CONN_ATTEMPTS times with exponential
+      // backoff. TODO: Do we need that?
+      for (int attempt = 0; attempt < CONN_ATTEMPTS; attempt++) {
+        // Create the socket
+        sock = socket(AF_INET, SOCK_STREAM, 0);
+        if (sock < 0) {
+          std::ostringstream msg;
+          msg << "[ring] Couldn't create socket (error: " << errno << ")";
+          throw std::runtime_error(msg.str());
+        }
+
+        if (attempt > 0) {
+          int wait = (1 << (attempt - 1)) * CONN_WAIT;
+          log_info(
+              verbose,
+              "Attempt",
+              attempt,
+              "wait",
+              wait,
+              "ms (error:",
+              errno,
+              ")");
+          std::this_thread::sleep_for(std::chrono::milliseconds(wait));
+        }
+
+        success = connect(sock, address.get(), address.len);
+        if (success == 0) {
+          break;
+        }
+      }
+      if (success < 0) {
         std::ostringstream msg;
-        msg << "[ring] Couldn't create socket (error: " << errno << ")";
+        msg << "[ring] Couldn't connect (error: " << errno << ")";
         throw std::runtime_error(msg.str());
       }
 
-      if (attempt > 0) {
-        int wait = (1 << (attempt - 1)) * CONN_WAIT;
-        log_info(
-            verbose,
-            "Attempt",
-            attempt,
-            "wait",
-            wait,
-            "ms (error:",
-            errno,
-            ")");
-        std::this_thread::sleep_for(std::chrono::milliseconds(wait));
+      if (conns > 1) {
+        unsigned char stripe = i;
+        if (::send(sock, &stripe, 1, 0) != 1) {
+          std::ostringstream msg;
+          msg << "[ring] Stripe handshake failed (error: " << errno << ")";
+          throw std::runtime_error(msg.str());
+        }
       }
 
-      success = connect(sock, address.get(), address.len);
-      if (success == 0) {
-        break;
-      }
-    }
-    if (success < 0) {
-      std::ostringstream msg;
-      msg << "[ring] Couldn't connect (error: " << errno << ")";
-      throw std::runtime_error(msg.str());
+      sockets.push_back(sock);
     }
-
-    sockets.push_back(sock);
   }
 
   return sockets;
@@ -550,18 +648,24 @@ class RingGroup : public GroupImpl {
     size_ = nodes.size();
     int connect_to = (rank_ + 1) % size_;
 
+    // Stripe each link over multiple connections so a single TCP stream
+    // doesn't cap the achievable bandwidth on fast links.
+    int conns = std::max(1, env::get_var("MLX_RING_CONNS", 1));
+
     // We define the connection order by having the rank_ == size_ - 1 connect
     // first and accept after.
     if (rank_ < connect_to) {
       log_info(verbose_, "Rank", rank_, "accepting");
-      sockets_left_ = std::move(accept_connections(nodes[rank_]));
+      sockets_left_ = std::move(accept_connections(nodes[rank_], conns));
       log_info(verbose_, "Rank", rank_, "connecting to", connect_to);
-      sockets_right_ = std::move(make_connections(nodes[connect_to], verbose));
+      sockets_right_ =
+          std::move(make_connections(nodes[connect_to], conns, verbose));
     } else {
       log_info(verbose_, "Rank", rank_, "connecting to", connect_to);
-      sockets_right_ = std::move(make_connections(nodes[connect_to], verbose));
+      sockets_right_ =
+          std::move(make_connections(nodes[connect_to], conns, verbose));
       log_info(verbose_, "Rank", rank_, "accepting");
-      sockets_left_ = std::move(accept_connections(nodes[rank_]));
+      sockets_left_ = std::move(accept_connections(nodes[rank_], conns));
     }
 
     // Failure if we couldn't make right or left sockets
@@ -587,11 +691,21 @@ class RingGroup : public GroupImpl {
       throw std::invalid_argument(msg.str());
     }
 
-    // Configure all sockets to use TCP no delay.
+    // Configure all sockets to use TCP no delay and optionally size the
+    // socket buffers explicitly. The kernel autotunes them by default but
+    // on high bandwidth-delay-product links pinning them to (roughly) the
+    // BDP avoids the slow ramp up on every large message.
     int one = 1;
+    int buf_bytes = env::get_var("MLX_RING_SOCKET_BUF_KB", 0) * 1024;
     for (int i = 0; i < sockets_right_.size(); i++) {
       setsockopt(sockets_right_[i], SOL_TCP, TCP_NODELAY, &one, sizeof(one));
       setsockopt(sockets_left_[i], SOL_TCP, TCP_NODELAY, &one, sizeof(one));
+      if (buf_bytes > 0) {
+        for (auto sock : {sockets_right_[i], sockets_left_[i]}) {
+          setsockopt(sock, SOL_SOCKET, SO_SNDBUF, &buf_bytes, sizeof(int));
+          setsockopt(sock, SOL_SOCKET, SO_RCVBUF, &buf_bytes, sizeof(int));
+        }
+      }
     }
 
     // Start the all reduce threads. One all reduce per direction per ring.
@@ -707,6 +821,50 @@ class RingGroup : public GroupImpl {
         });
   }
 
+  void reduce_scatter(const array& input, array& output, Stream stream)
+      override {
+    // The ring all sum is already bandwidth optimal so run it into a scratch
+    // buffer and keep the shard that belongs to this rank.
+    array scratch(input.shape(), input.dtype(), nullptr, {});
+    scratch.set_data(allocator::malloc(scratch.nbytes()));
+    all_sum(input, scratch, stream);
+    auto& encoder = cpu::get_command_encoder(stream);
+    encoder.set_input_array(scratch);
+    encoder.set_output_array(output);
+    encoder.dispatch([scratch_ptr = scratch.data<char>(),
+                      out_ptr = output.data<char>(),
+                      nbytes = output.nbytes(),
+                      this]() {
+      std::memcpy(out_ptr, scratch_ptr + rank_ * nbytes, nbytes);
+    });
+    encoder.add_temporary(scratch);
+  }
+
+  void broadcast(const array& input, array& output, int root, Stream stream)
+      override {
+    // Pipeline the bytes around the ring: the root seeds its right neighbor
+    // and every other rank forwards what it received unless the next rank is
+    // the root itself.
+    int right = (rank_ + 1) % size_;
+    if (rank_ == root) {
+      auto& encoder = cpu::get_command_encoder(stream);
+      encoder.set_input_array(input);
+      encoder.set_output_array(output);
+      encoder.dispatch([in_ptr = input.data<char>(),
+                        out_ptr = output.data<char>(),
+                        nbytes = input.nbytes()]() {
+        std::memcpy(out_ptr, in_ptr, nbytes);
+      });
+      send(output, right, stream);
+    } else {
+      int left = (rank_ + size_ - 1) % size_;
+      recv(output, left, stream);
+      if (right != root) {
+        send(output, right, stream);
+      }
+    }
+  }
+
   void recv(array& out, int src, Stream stream) override {
     auto& encoder = cpu::get_command_encoder(stream);
     encoder.set_output_array(out);
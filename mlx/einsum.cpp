@@ -1,4 +1,5 @@
 // Copyright © 2024 Apple Inc.
+#include <mutex>
 #include <numeric>
 #include <sstream>
 #include <unordered_map>
@@ -51,6 +52,20 @@ struct PathNode {
   std::vector<int> positions;
 };
 
+// Contraction paths cached by subscripts and operand shapes. Workloads
+// that evaluate the same einsum signature repeatedly only pay for the
+// greedy path search the first time each signature is seen.
+struct PathCache {
+  std::unordered_map<std::string, std::pair<std::vector<PathNode>, PathInfo>>
+      paths;
+  std::mutex mtx;
+};
+
+PathCache& path_cache() {
+  static PathCache cache;
+  return cache;
+}
+
 // Parse the comma separated subscripts into a vector of strings. If the
 // output subscripts are missing they are inferred.
 //
@@ -397,6 +412,36 @@ array batch_tensordot(
     return reshape(transpose(x, reorder, s), std::move(shape), s);
   };
 
+  // Check if the axes in i, j, k are already adjacent and in order, in
+  // which case the transpose is a no-op and the reshape is a view
+  auto is_identity = [](const std::vector<int>& i,
+                        const std::vector<int>& j,
+                        const std::vector<int>& k) {
+    int next = 0;
+    for (auto g : {&i, &j, &k}) {
+      for (auto ax : *g) {
+        if (ax != next++) {
+          return false;
+        }
+      }
+    }
+    return true;
+  };
+
+  // Flatten the input into a (batch, rows, columns) matrix. When the axes
+  // are laid out as (batch, columns, rows) the data is not moved: the
+  // matrix is flattened in that order and handed to the GEMM with its
+  // last two axes swapped, which the backends consume through strides.
+  auto gemm_operand = [&](const array& x,
+                          const std::vector<int>& i,
+                          const std::vector<int>& j,
+                          const std::vector<int>& k) {
+    if (!is_identity(i, j, k) && is_identity(i, k, j)) {
+      return swapaxes(transpose_reshape(x, i, k, j), -2, -1, s);
+    }
+    return transpose_reshape(x, i, j, k);
+  };
+
   Shape out_shape;
   for (auto ax : a_batch) {
     out_shape.push_back(a.shape(ax));
@@ -408,8 +453,8 @@ array batch_tensordot(
     out_shape.push_back(b.shape(ax));
   }
 
-  a = transpose_reshape(a, a_batch, a_concat, a_contract);
-  b = transpose_reshape(b, b_batch, b_contract, b_concat);
+  a = gemm_operand(a, a_batch, a_concat, a_contract);
+  b = gemm_operand(b, b_batch, b_contract, b_concat);
 
   return reshape(matmul(a, b, s), std::move(out_shape), s);
 }
@@ -637,6 +682,26 @@ std::pair<std::vector<PathNode>, PathInfo> einsum_path_helper(
     throw std::invalid_argument(msg.str());
   }
 
+  std::string cache_key;
+  {
+    std::ostringstream key;
+    key << subscripts;
+    for (auto& op : operands) {
+      key << "|";
+      for (auto d : op.shape()) {
+        key << d << ",";
+      }
+    }
+    cache_key = key.str();
+  }
+  {
+    auto& cache = path_cache();
+    std::lock_guard<std::mutex> lock(cache.mtx);
+    if (auto it = cache.paths.find(cache_key); it != cache.paths.end()) {
+      return it->second;
+    }
+  }
+
   auto [in_subscripts, out_subscript] = parse(subscripts);
 
   if (operands.size() != in_subscripts.size()) {
@@ -807,6 +872,12 @@ std::pair<std::vector<PathNode>, PathInfo> einsum_path_helper(
     // Set the final output subscript to the actual output
     path.back().output = std::move(output);
   }
+
+  {
+    auto& cache = path_cache();
+    std::lock_guard<std::mutex> lock(cache.mtx);
+    cache.paths.emplace(std::move(cache_key), std::make_pair(path, path_info));
+  }
   return {path, path_info};
 }
 
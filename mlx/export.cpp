@@ -1,9 +1,16 @@
 // Copyright © 2024 Apple Inc.
 #include "mlx/export.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
 #include <map>
+#include <optional>
+#include "mlx/backend/metal/metal.h"
 #include "mlx/compile_impl.h"
 #include "mlx/fast_primitives.h"
+#include "mlx/ops.h"
 #include "mlx/primitives.h"
+#include "mlx/transforms.h"
 #include "mlx/utils.h"
 #include "mlx/version.h"
 
@@ -233,6 +240,7 @@ struct PrimitiveFactory {
       SERIALIZE_PRIMITIVE(ArgSort),
       SERIALIZE_PRIMITIVE(AsType),
       SERIALIZE_PRIMITIVE(AsStrided),
+      SERIALIZE_PRIMITIVE(Bincount),
       SERIALIZE_PRIMITIVE(
           BitwiseBinary,
           "BitwiseAnd",
@@ -281,6 +289,8 @@ struct PrimitiveFactory {
       SERIALIZE_PRIMITIVE(LogicalOr),
       SERIALIZE_PRIMITIVE(LogAddExp),
       SERIALIZE_PRIMITIVE(LogSumExp),
+      SERIALIZE_PRIMITIVE(MaskedAdd),
+      SERIALIZE_PRIMITIVE(MaskedMultiply),
       SERIALIZE_PRIMITIVE(Matmul),
       SERIALIZE_PRIMITIVE(Maximum),
       SERIALIZE_PRIMITIVE(Minimum),
@@ -385,6 +395,10 @@ struct PrimitiveFactory {
   };
 };
 
+// Constant tensor extents are padded to page alignment so an importing
+// process can map them directly
+constexpr size_t constant_alignment = 16384;
+
 void write_header(Writer& os, int count, bool shapeless) {
   serialize(os, std::string(version()));
   serialize(os, count);
@@ -657,6 +671,14 @@ void FunctionExporter::export_function(const Args& args, const Kwargs& kwargs) {
         if (constants.insert(arr.id()).second) {
           serialize(os, arr.shape());
           serialize(os, arr.dtype());
+          // Pad so the extent starts on a page boundary and an importer
+          // can map the weights in place instead of copying them
+          auto pos = os.tell() + sizeof(uint64_t);
+          auto pad = (constant_alignment - (pos % constant_alignment)) %
+              constant_alignment;
+          serialize(os, static_cast<uint64_t>(pad));
+          std::vector<char> zero_bytes(pad, 0);
+          os.write(zero_bytes.data(), pad);
           os.write(arr.data<char>(), arr.nbytes());
         }
       } else {
@@ -730,6 +752,22 @@ void export_function(
   exporter(file, fun, shapeless)(args, kwargs);
 }
 
+std::vector<std::vector<std::pair<Shape, Dtype>>> ImportedFunction::input_specs()
+    const {
+  std::vector<std::vector<std::pair<Shape, Dtype>>> specs;
+  for (auto& [_, funs] : ftable->table) {
+    for (auto& fun : funs) {
+      auto npos = fun.inputs.size() - fun.kwarg_keys.size();
+      std::vector<std::pair<Shape, Dtype>> spec;
+      for (size_t i = 0; i < npos; ++i) {
+        spec.emplace_back(fun.inputs[i].shape(), fun.inputs[i].dtype());
+      }
+      specs.push_back(std::move(spec));
+    }
+  }
+  return specs;
+}
+
 std::vector<array> ImportedFunction::operator()(const Kwargs& kwargs) const {
   return this->operator()({}, kwargs);
 }
@@ -767,10 +805,239 @@ std::vector<array> ImportedFunction::operator()(
       fun->tape, fun->inputs, fun->outputs, inputs, ftable->shapeless);
 }
 
+void ImportedFunction::call_into(const Args& args, std::vector<array>& outputs)
+    const {
+  call_into(args, {}, outputs);
+}
+
+void ImportedFunction::call_into(
+    const Kwargs& kwargs,
+    std::vector<array>& outputs) const {
+  call_into({}, kwargs, outputs);
+}
+
+void ImportedFunction::call_into(
+    const Args& args,
+    const Kwargs& kwargs,
+    std::vector<array>& outputs) const {
+  auto results = this->operator()(args, kwargs);
+  if (results.size() != outputs.size()) {
+    std::ostringstream msg;
+    msg << "[import_function::call_into] The function has " << results.size()
+        << " outputs but " << outputs.size() << " were provided.";
+    throw std::invalid_argument(msg.str());
+  }
+  for (size_t i = 0; i < results.size(); ++i) {
+    auto& out = outputs[i];
+    auto& res = results[i];
+    if (out.shape() != res.shape() || out.dtype() != res.dtype()) {
+      std::ostringstream msg;
+      msg << "[import_function::call_into] Provided output " << i
+          << " with shape " << out.shape() << " and dtype " << out.dtype()
+          << " does not match the function output with shape " << res.shape()
+          << " and dtype " << res.dtype() << ".";
+      throw std::invalid_argument(msg.str());
+    }
+    if (!out.is_available() || !out.flags().row_contiguous) {
+      std::ostringstream msg;
+      msg << "[import_function::call_into] Provided outputs must be "
+          << "evaluated and row contiguous.";
+      throw std::invalid_argument(msg.str());
+    }
+    // Force a contiguous result so it lands in the caller's buffer with
+    // a single copy
+    res = contiguous(res);
+  }
+  eval(results);
+  for (size_t i = 0; i < results.size(); ++i) {
+    std::memcpy(
+        outputs[i].data<char>(), results[i].data<char>(), results[i].nbytes());
+  }
+}
+
 ImportedFunction import_function(const std::string& file) {
   return ImportedFunction{file};
 }
 
+namespace {
+
+std::string kernel_bundle_path(const std::string& file) {
+  return file + ".kernels";
+}
+
+} // namespace
+
+void export_kernel_bundle(const std::string& file) {
+  if (!metal::is_available()) {
+    throw std::runtime_error(
+        "[export_kernel_bundle] Pre-built kernel bundles require the Metal "
+        "backend. The CUDA backend persists compiled kernels through "
+        "MLX_PTX_CACHE_DIR instead.");
+  }
+  metal::save_binary_archive(kernel_bundle_path(file));
+}
+
+void import_kernel_bundle(const std::string& file) {
+  if (!metal::is_available()) {
+    throw std::runtime_error(
+        "[import_kernel_bundle] Pre-built kernel bundles require the Metal "
+        "backend.");
+  }
+  metal::load_binary_archive(kernel_bundle_path(file));
+}
+
+// Exponent and mantissa widths of the floating point types; complex64
+// behaves like its float32 components
+std::pair<int, int> float_widths(const Dtype& t) {
+  switch (t.val()) {
+    case Dtype::Val::float16:
+      return {5, 10};
+    case Dtype::Val::bfloat16:
+      return {8, 7};
+    case Dtype::Val::float32:
+    case Dtype::Val::complex64:
+      return {8, 23};
+    case Dtype::Val::float64:
+      return {11, 52};
+    default:
+      return {0, 0};
+  }
+}
+
+// True when casting from |from| to |to| preserves every value exactly, so
+// astype(astype(x, mid), final) can skip the intermediate cast to |to|
+bool lossless_cast(const Dtype& from, const Dtype& to) {
+  if (from == to) {
+    return true;
+  }
+  if (from == bool_) {
+    return true;
+  }
+  auto fk = kindof(from);
+  auto tk = kindof(to);
+  bool from_float = fk == Dtype::Kind::f || fk == Dtype::Kind::V;
+  bool to_float = tk == Dtype::Kind::f || tk == Dtype::Kind::V ||
+      tk == Dtype::Kind::c;
+  if (from_float) {
+    // A float is exactly representable when both the exponent and the
+    // mantissa widen; equal width floats (float16 / bfloat16) are not
+    auto [fe, fm] = float_widths(from);
+    auto [te, tm] = float_widths(to);
+    return to_float && te >= fe && tm >= fm;
+  }
+  if (fk == Dtype::Kind::u || fk == Dtype::Kind::i) {
+    int value_bits = 8 * size_of(from) - (fk == Dtype::Kind::i ? 1 : 0);
+    if (to_float) {
+      // Integers survive a float cast when they fit in the mantissa
+      return float_widths(to).second + 1 >= value_bits;
+    }
+    if (tk == fk) {
+      return size_of(to) >= size_of(from);
+    }
+    // Unsigned to signed needs a strictly wider type
+    return fk == Dtype::Kind::u && tk == Dtype::Kind::i &&
+        size_of(to) > size_of(from);
+  }
+  return false;
+}
+
+// Remove value no-op nodes from an imported tape and coalesce consecutive
+// astype / reshape chains. Traces accumulate redundant copies from the
+// export round trip which cost real copies at run time. Identity reshapes
+// are only removed for exact-shape traces since a reshape that is a no-op
+// on the traced shapes need not be one for a shapeless trace.
+void optimize_imported_tape(
+    std::vector<array>& tape,
+    std::vector<array>& trace_outputs,
+    bool shapeless) {
+  std::unordered_map<std::uintptr_t, array> replacements;
+  auto resolve = [&](const array& a) {
+    auto it = replacements.find(a.id());
+    return it == replacements.end() ? a : it->second;
+  };
+
+  for (auto& a : tape) {
+    if (!a.has_primitive()) {
+      continue;
+    }
+
+    // Rewire inputs onto the replacements of eliminated producers
+    auto inputs = a.inputs();
+    bool remapped = false;
+    for (auto& in : inputs) {
+      if (auto r = resolve(in); r.id() != in.id()) {
+        in = r;
+        remapped = true;
+      }
+    }
+    if (remapped) {
+      a.inputs() = std::move(inputs);
+    }
+    if (!a.siblings().empty()) {
+      continue;
+    }
+
+    auto& p = a.primitive();
+    if (typeid(p) == typeid(Copy)) {
+      replacements.emplace(a.id(), a.inputs()[0]);
+    } else if (typeid(p) == typeid(AsType)) {
+      auto& in = a.inputs()[0];
+      if (in.dtype() == a.dtype()) {
+        replacements.emplace(a.id(), in);
+      } else if (
+          in.has_primitive() && in.siblings().empty() &&
+          typeid(in.primitive()) == typeid(AsType) &&
+          lossless_cast(in.inputs()[0].dtype(), in.dtype())) {
+        a.inputs() = {in.inputs()[0]};
+      }
+    } else if (typeid(p) == typeid(Reshape)) {
+      auto& in = a.inputs()[0];
+      if (!shapeless && in.shape() == a.shape()) {
+        replacements.emplace(a.id(), in);
+      } else if (
+          in.has_primitive() && in.siblings().empty() &&
+          typeid(in.primitive()) == typeid(Reshape)) {
+        a.inputs() = {in.inputs()[0]};
+      }
+    } else if (typeid(p) == typeid(Contiguous)) {
+      auto& in = a.inputs()[0];
+      if (in.has_primitive() && in.siblings().empty() &&
+          typeid(in.primitive()) == typeid(Contiguous)) {
+        replacements.emplace(a.id(), in);
+      }
+    }
+  }
+  if (replacements.empty()) {
+    return;
+  }
+  for (auto& o : trace_outputs) {
+    o = resolve(o);
+  }
+
+  // Drop nodes no longer reachable from the outputs
+  std::unordered_set<std::uintptr_t> needed;
+  std::function<void(const array&)> mark = [&](const array& a) {
+    if (!needed.insert(a.id()).second) {
+      return;
+    }
+    for (auto& s : a.siblings()) {
+      needed.insert(s.id());
+    }
+    for (auto& in : a.inputs()) {
+      mark(in);
+    }
+  };
+  for (auto& o : trace_outputs) {
+    mark(o);
+  }
+  tape.erase(
+      std::remove_if(
+          tape.begin(),
+          tape.end(),
+          [&](const array& a) { return needed.find(a.id()) == needed.end(); }),
+      tape.end());
+}
+
 ImportedFunction::ImportedFunction(const std::string& file)
     : ftable(std::make_shared<FunctionTable>()) {
   auto is_ptr = std::make_shared<Reader>(file);
@@ -779,6 +1046,37 @@ ImportedFunction::ImportedFunction(const std::string& file)
     throw std::runtime_error("[import_function] Failed to open " + file);
   }
 
+  // Map pre-built kernels when a bundle was shipped alongside the graph
+  if (metal::is_available()) {
+    if (auto bundle = kernel_bundle_path(file);
+        std::filesystem::exists(bundle)) {
+      metal::load_binary_archive(bundle);
+    }
+  }
+
+  // Map the file so constant extents can be wrapped in place and page in
+  // on demand instead of being copied at load time
+  std::optional<array> mapped_base;
+#if !defined(_WIN32)
+  if (env::mmap_load() && !is_big_endian()) {
+    auto mapping = std::make_shared<io::MappedFile>(file);
+    if (mapping->data != nullptr) {
+      try {
+        auto buf = allocator::wrap_external(mapping->data, mapping->size);
+        array base(Shape{1}, uint8, nullptr, {});
+        base.set_data(
+            buf, [mapping](allocator::Buffer b) { allocator::free(b); });
+        // The mapping is read-only; donating it to an output would fault
+        base.set_data_not_donatable();
+        base.set_status(array::Status::available);
+        mapped_base = std::move(base);
+      } catch (const std::exception&) {
+        // Fall back to streaming reads when wrapping is unsupported
+      }
+    }
+  }
+#endif
+
   // Parse header
   auto mlx_version = deserialize<std::string>(is);
   auto function_count = deserialize<int>(is);
@@ -843,13 +1141,39 @@ ImportedFunction::ImportedFunction(const std::string& file)
           } else {
             auto shape = deserialize<Shape>(is);
             auto type = deserialize<Dtype>(is);
+            auto pad = deserialize<uint64_t>(is);
+            is.seek(is.tell() + pad);
             size_t offset = is.tell();
-            tape.push_back(array(
-                std::move(shape),
-                type,
-                std::make_shared<Load>(
-                    default_stream(Device::cpu), is_ptr, offset),
-                {}));
+            if (mapped_base && offset % size_of(type) == 0) {
+              // Wrap the page-aligned extent of the mapping directly
+              array arr(std::move(shape), type, nullptr, {});
+              Strides strides(arr.ndim(), 1);
+              for (int i = arr.ndim() - 2; i >= 0; --i) {
+                strides[i] = strides[i + 1] * arr.shape(i + 1);
+              }
+              array::Flags flags{
+                  /* contiguous = */ true,
+                  /* row_contiguous = */ true,
+                  /* col_contiguous = */ arr.size() <= 1 ||
+                      static_cast<size_t>(*std::max_element(
+                          arr.shape().begin(), arr.shape().end())) ==
+                          arr.size()};
+              arr.copy_shared_buffer(
+                  *mapped_base,
+                  strides,
+                  flags,
+                  arr.size(),
+                  offset / size_of(type));
+              arr.set_status(array::Status::available);
+              tape.push_back(std::move(arr));
+            } else {
+              tape.push_back(array(
+                  std::move(shape),
+                  type,
+                  std::make_shared<Load>(
+                      default_stream(Device::cpu), is_ptr, offset),
+                  {}));
+            }
             is.seek(offset + tape.back().nbytes());
             constants.insert({id, tape.back()});
           }
@@ -866,6 +1190,9 @@ ImportedFunction::ImportedFunction(const std::string& file)
     for (auto id : trace_output_ids) {
       trace_outputs.push_back(array_map.at(id));
     }
+    if (env::import_optimize()) {
+      optimize_imported_tape(tape, trace_outputs, ftable->shapeless);
+    }
     ftable->insert(
         std::move(kwarg_keys),
         std::move(trace_inputs),
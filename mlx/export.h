@@ -61,6 +61,24 @@ struct ImportedFunction;
  */
 ImportedFunction import_function(const std::string& file);
 
+/**
+ * Save the GPU kernels compiled so far alongside an exported function.
+ *
+ * Start a binary archive capture with
+ * `metal::start_binary_archive_capture`, run the function once so its
+ * pipelines are built, export it, then call this with the same file. The
+ * bundle is written to `file` + ".kernels" and `import_function` maps it
+ * automatically when present, so the importing process starts executing
+ * without compiling any kernels.
+ */
+void export_kernel_bundle(const std::string& file);
+
+/**
+ * Load a kernel bundle previously saved with `export_kernel_bundle`,
+ * without importing the function it was saved beside.
+ */
+void import_kernel_bundle(const std::string& file);
+
 } // namespace mlx::core
 
 #include "mlx/export_impl.h"
@@ -60,6 +60,26 @@ struct ImportedFunction {
   std::vector<array> operator()(const Kwargs& kwargs) const;
   std::vector<array> operator()(const Args& args, const Kwargs& kwargs) const;
 
+  /**
+   * Run the function and write the results into caller-provided,
+   * already evaluated outputs instead of returning fresh arrays.
+   *
+   * The outputs must match the results in number, shape, and dtype and
+   * must be row contiguous. Blocks until the results have been written.
+   * With fixed shapes the intermediates are served from the allocator's
+   * buffer cache, so steady-state calls perform no new allocations.
+   */
+  void call_into(const Args& args, std::vector<array>& outputs) const;
+  void call_into(const Kwargs& kwargs, std::vector<array>& outputs) const;
+  void call_into(
+      const Args& args,
+      const Kwargs& kwargs,
+      std::vector<array>& outputs) const;
+
+  /** The shape and dtype of the positional inputs of every exported
+   * trace, so a replay driver can synthesize matching inputs. */
+  std::vector<std::vector<std::pair<Shape, Dtype>>> input_specs() const;
+
  private:
   ImportedFunction(const std::string& file);
   friend ImportedFunction import_function(const std::string&);
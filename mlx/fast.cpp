@@ -1,10 +1,15 @@
 // Copyright © 2023-2024 Apple Inc.
 #include <cassert>
+#include <cmath>
+#include <limits>
 #include <numeric>
+#include <optional>
 
+#include "mlx/backend/metal/metal.h"
 #include "mlx/fast.h"
 #include "mlx/fast_primitives.h"
 #include "mlx/ops.h"
+#include "mlx/random.h"
 #include "mlx/transforms.h"
 
 namespace mlx::core::fast {
@@ -580,6 +585,7 @@ array scaled_dot_product_attention(
     const std::string& mask_mode /* = "" */,
     const std::vector<array>& mask_arrs /* = {} */,
     const std::optional<array>& sinks /* = {} */,
+    std::optional<int> sliding_window /* = std::nullopt */,
     StreamOrDevice s /* = {}*/) {
   for (const auto& tensor : {queries, keys, values}) {
     if (tensor.ndim() != 4) {
@@ -590,10 +596,11 @@ array scaled_dot_product_attention(
     }
   }
   // Check valid mask
-  if (mask_mode != "" && mask_mode != "causal" && mask_mode != "array") {
+  if (mask_mode != "" && mask_mode != "causal" && mask_mode != "array" &&
+      mask_mode != "block_sparse") {
     std::ostringstream msg;
     msg << "[scaled_dot_product_attention] Invalid mask_mode " << mask_mode
-        << ". mask_mode must be 'causal', 'array' or ''.";
+        << ". mask_mode must be 'causal', 'array', 'block_sparse' or ''.";
     throw std::invalid_argument(msg.str());
   }
 
@@ -601,6 +608,7 @@ array scaled_dot_product_attention(
   bool has_mask = false;
   bool has_arr_mask = false;
   bool has_bool_mask = false;
+  bool block_sparse = false;
 
   if (mask_mode == "causal") {
     has_mask = true;
@@ -628,6 +636,42 @@ array scaled_dot_product_attention(
     has_bool_mask = mask_arrs[0].dtype() == bool_;
   }
 
+  if (mask_mode == "block_sparse") {
+    if (mask_arrs.size() != 1) {
+      std::ostringstream msg;
+      msg << "[scaled_dot_product_attention] Invalid mask_arrs for mask_mode "
+          << "'block_sparse'. Exactly 1 block table is required, got "
+          << mask_arrs.size() << " arrays.";
+      throw std::invalid_argument(msg.str());
+    }
+    if (mask_arrs[0].dtype() != bool_) {
+      std::ostringstream msg;
+      msg << "[scaled_dot_product_attention] The block table for mask_mode "
+          << "'block_sparse' must be boolean but got "
+          << mask_arrs[0].dtype() << ".";
+      throw std::invalid_argument(msg.str());
+    }
+    has_mask = true;
+    has_arr_mask = true;
+    has_bool_mask = true;
+    block_sparse = true;
+  }
+
+  if (sliding_window.has_value()) {
+    if (*sliding_window <= 0) {
+      std::ostringstream msg;
+      msg << "[scaled_dot_product_attention] sliding_window must be positive "
+          << "but got " << *sliding_window << ".";
+      throw std::invalid_argument(msg.str());
+    }
+    if (!do_causal || has_arr_mask) {
+      throw std::invalid_argument(
+          "[scaled_dot_product_attention] sliding_window requires "
+          "mask_mode 'causal' and no mask arrays.");
+    }
+  }
+  int window = sliding_window.value_or(-1);
+
   if (has_arr_mask && (mask_arrs[0]).ndim() > 4) {
     std::ostringstream msg;
     msg << "[scaled_dot_product_attention] the mask with shape "
@@ -693,6 +737,8 @@ array scaled_dot_product_attention(
                    do_causal,
                    has_sinks,
                    has_arr_mask,
+                   block_sparse,
+                   window,
                    s](const std::vector<array>& inputs) {
     auto q = multiply(array(scale, inputs[0].dtype()), inputs[0], s);
     int n_repeats = n_q_heads / n_kv_heads;
@@ -717,7 +763,24 @@ array scaled_dot_product_attention(
           auto k_idx = arange(0, kL, s);
           q_idx = expand_dims(q_idx, 1, s);
           k_idx = expand_dims(k_idx, 0, s);
-          return greater_equal(q_idx, k_idx, s);
+          auto m = greater_equal(q_idx, k_idx, s);
+          if (window > 0) {
+            // Keys more than `window` positions behind their query fall
+            // out of the sliding window.
+            m = logical_and(
+                m, less(q_idx, add(k_idx, array(window, int32), s), s), s);
+          }
+          return m;
+        }
+        if (block_sparse) {
+          // Expand the block table into an elementwise boolean mask
+          constexpr int bs = ScaledDotProductAttention::block_mask_size;
+          auto m = repeat(repeat(inputs[3], bs, -2, s), bs, -1, s);
+          return slice(
+              m,
+              {0, 0, 0, 0},
+              {m.shape(0), m.shape(1), q.shape(-2), k.shape(-2)},
+              s);
         }
         return inputs[3];
       };
@@ -768,7 +831,22 @@ array scaled_dot_product_attention(
 
   auto stream = to_stream(s);
   std::vector<array> inputs = {q, k, v};
-  if (has_arr_mask) {
+  if (block_sparse) {
+    constexpr int bs = ScaledDotProductAttention::block_mask_size;
+    int NQb = (queries.shape(2) + bs - 1) / bs;
+    int NKb = (keys.shape(2) + bs - 1) / bs;
+    auto& mask_arr = mask_arrs[0];
+    if (mask_arr.ndim() < 2 || mask_arr.shape(-2) != NQb ||
+        mask_arr.shape(-1) != NKb) {
+      std::ostringstream msg;
+      msg << "[scaled_dot_product_attention] The block table with shape "
+          << mask_arr.shape() << " expected to have trailing dimensions ("
+          << NQb << ", " << NKb << ") for block size " << bs << ".";
+      throw std::invalid_argument(msg.str());
+    }
+    inputs.push_back(broadcast_to(
+        mask_arr, {queries.shape(0), n_q_heads, NQb, NKb}, stream));
+  } else if (has_arr_mask) {
     // Check type
     auto mask_arr = mask_arrs[0];
     has_bool_mask = mask_arr.dtype() == bool_;
@@ -801,24 +879,1484 @@ array scaled_dot_product_attention(
     inputs.push_back(astype(*sinks, final_type, stream));
   }
 
-  if (!ScaledDotProductAttention::use_fallback(
-          q, k, v, has_mask, has_arr_mask, do_causal, stream)) {
+  // The sliding window is only plumbed into the vector (decode) kernels on
+  // Metal; other configurations build the window mask in the fallback.
+  bool window_in_kernel =
+      window <= 0 || (metal::is_available() && q.shape(2) <= 8);
+  if (window_in_kernel &&
+      !ScaledDotProductAttention::use_fallback(
+          q, k, v, has_mask, has_arr_mask, do_causal, block_sparse, stream)) {
     auto out_shape = Shape{q.shape(0), q.shape(1), q.shape(2), v.shape(-1)};
     return array(
         std::move(out_shape),
         final_type,
         std::make_shared<ScaledDotProductAttention>(
-            stream, fallback, scale, do_causal, has_sinks),
+            stream, fallback, scale, do_causal, has_sinks, window, block_sparse),
         std::move(inputs));
   }
   return fallback(std::move(inputs))[0];
 }
 
-bool ScaledDotProductAttention::is_equivalent(const Primitive& other) const {
-  const ScaledDotProductAttention& a_other =
-      static_cast<const ScaledDotProductAttention&>(other);
-  return scale_ == a_other.scale_ && do_causal_ == a_other.do_causal_ &&
-      has_sinks_ == a_other.has_sinks_;
+array quantized_scaled_dot_product_attention(
+    const array& queries,
+    const array& keys,
+    const array& key_scales,
+    const array& key_biases,
+    const array& values,
+    const array& value_scales,
+    const array& value_biases,
+    const float scale,
+    const std::string& mask_mode /* = "" */,
+    int group_size /* = 64 */,
+    int bits /* = 8 */,
+    StreamOrDevice s /* = {} */) {
+  if (mask_mode != "" && mask_mode != "causal") {
+    std::ostringstream msg;
+    msg << "[quantized_scaled_dot_product_attention] Invalid mask_mode '"
+        << mask_mode << "'. mask_mode must be '' or 'causal'.";
+    throw std::invalid_argument(msg.str());
+  }
+  bool do_causal = mask_mode == "causal";
+
+  if (bits != 4 && bits != 8) {
+    std::ostringstream msg;
+    msg << "[quantized_scaled_dot_product_attention] Only 4 and 8 bit KV "
+        << "caches are supported but bits == " << bits << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  if (group_size != 32 && group_size != 64 && group_size != 128) {
+    std::ostringstream msg;
+    msg << "[quantized_scaled_dot_product_attention] The requested group size "
+        << group_size << " is not supported. The supported group sizes are "
+        << "32, 64, and 128.";
+    throw std::invalid_argument(msg.str());
+  }
+
+  for (const auto& tensor :
+       {queries,
+        keys,
+        key_scales,
+        key_biases,
+        values,
+        value_scales,
+        value_biases}) {
+    if (tensor.ndim() != 4) {
+      std::ostringstream msg;
+      msg << "[quantized_scaled_dot_product_attention] input with shape "
+          << tensor.shape() << " expected to be rank 4.";
+      throw std::invalid_argument(msg.str());
+    }
+  }
+
+  if (!issubdtype(queries.dtype(), floating)) {
+    throw std::invalid_argument(
+        "[quantized_scaled_dot_product_attention] Only real floating types "
+        "are supported for the queries.");
+  }
+  if (keys.dtype() != uint32 || values.dtype() != uint32) {
+    throw std::invalid_argument(
+        "[quantized_scaled_dot_product_attention] The quantized keys and "
+        "values should be given as uint32.");
+  }
+  for (const auto& sb : {key_scales, key_biases, value_scales, value_biases}) {
+    if (sb.dtype() != queries.dtype()) {
+      std::ostringstream msg;
+      msg << "[quantized_scaled_dot_product_attention] Scales and biases must "
+          << "have the queries' dtype " << queries.dtype() << " but got "
+          << sb.dtype() << ".";
+      throw std::invalid_argument(msg.str());
+    }
+  }
+
+  const int head_dim = queries.shape(-1);
+  if (head_dim % group_size != 0) {
+    std::ostringstream msg;
+    msg << "[quantized_scaled_dot_product_attention] The head dimension "
+        << head_dim << " must be divisible by the group size " << group_size
+        << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  if (keys.shape() != values.shape() ||
+      keys.shape(-1) != head_dim * bits / 32) {
+    std::ostringstream msg;
+    msg << "[quantized_scaled_dot_product_attention] Expected keys and values "
+        << "packed to shape (B, H_kv, L, " << head_dim * bits / 32
+        << ") but got keys with shape " << keys.shape()
+        << " and values with shape " << values.shape() << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  auto sb_shape = keys.shape();
+  sb_shape.back() = head_dim / group_size;
+  for (const auto& sb : {key_scales, key_biases, value_scales, value_biases}) {
+    if (sb.shape() != sb_shape) {
+      std::ostringstream msg;
+      msg << "[quantized_scaled_dot_product_attention] Expected scales and "
+          << "biases with shape " << sb_shape << " but got " << sb.shape()
+          << ".";
+      throw std::invalid_argument(msg.str());
+    }
+  }
+  if (queries.shape(0) != keys.shape(0) ||
+      queries.shape(1) % keys.shape(1) != 0) {
+    std::ostringstream msg;
+    msg << "[quantized_scaled_dot_product_attention] Queries with shape "
+        << queries.shape() << " are incompatible with keys of shape "
+        << keys.shape() << ".";
+    throw std::invalid_argument(msg.str());
+  }
+
+  auto stream = to_stream(s);
+  auto fallback = [scale, do_causal, group_size, bits, s = stream](
+                      const std::vector<array>& inputs) -> std::vector<array> {
+    auto& q = inputs[0];
+    auto k = astype(
+        dequantize(
+            inputs[1], inputs[2], inputs[3], group_size, bits, "affine", s),
+        q.dtype(),
+        s);
+    auto v = astype(
+        dequantize(
+            inputs[4], inputs[5], inputs[6], group_size, bits, "affine", s),
+        q.dtype(),
+        s);
+    return {scaled_dot_product_attention(
+        q,
+        std::move(k),
+        std::move(v),
+        scale,
+        do_causal ? "causal" : "",
+        /* mask_arrs = */ {},
+        /* sinks = */ std::nullopt,
+        /* sliding_window = */ std::nullopt,
+        s)};
+  };
+
+  std::vector<array> inputs = {
+      queries,
+      keys,
+      key_scales,
+      key_biases,
+      values,
+      value_scales,
+      value_biases};
+  if (!QuantizedSDPA::use_fallback(queries, keys, group_size, bits, stream)) {
+    return array(
+        queries.shape(),
+        queries.dtype(),
+        std::make_shared<QuantizedSDPA>(
+            stream, fallback, scale, do_causal, group_size, bits),
+        std::move(inputs));
+  }
+  return fallback(std::move(inputs))[0];
+}
+
+array paged_attention(
+    const array& queries,
+    const array& k_pages,
+    const array& v_pages,
+    const array& page_table,
+    const array& context_lens,
+    const float scale,
+    StreamOrDevice s /* = {} */) {
+  for (const auto& tensor : {queries, k_pages, v_pages}) {
+    if (tensor.ndim() != 4) {
+      std::ostringstream msg;
+      msg << "[paged_attention] input with shape " << tensor.shape()
+          << " expected to be rank 4";
+      throw std::invalid_argument(msg.str());
+    }
+  }
+  if (page_table.ndim() != 2 || page_table.dtype() != int32) {
+    std::ostringstream msg;
+    msg << "[paged_attention] page_table must be a rank 2 int32 array but got "
+        << page_table.shape() << " with type " << page_table.dtype() << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  if (context_lens.ndim() != 1 || context_lens.dtype() != int32) {
+    std::ostringstream msg;
+    msg << "[paged_attention] context_lens must be a rank 1 int32 array but got "
+        << context_lens.shape() << " with type " << context_lens.dtype()
+        << ".";
+    throw std::invalid_argument(msg.str());
+  }
+
+  const int batch_dim = queries.shape(0);
+  if (page_table.shape(0) != batch_dim || context_lens.shape(0) != batch_dim) {
+    std::ostringstream msg;
+    msg << "[paged_attention] page_table and context_lens expected batch dimension "
+        << batch_dim << "; got shapes " << page_table.shape() << " and "
+        << context_lens.shape() << ".";
+    throw std::invalid_argument(msg.str());
+  }
+
+  // The two pools must be laid out page for page
+  for (int i = 0; i < 3; ++i) {
+    if (k_pages.shape(i) != v_pages.shape(i)) {
+      std::ostringstream msg;
+      msg << "[paged_attention] k_pages and v_pages expected to have matching "
+          << "page count, n_kv_heads and page_size; got shapes "
+          << k_pages.shape() << " and " << v_pages.shape() << ".";
+      throw std::invalid_argument(msg.str());
+    }
+  }
+  if (queries.shape(-1) != k_pages.shape(-1)) {
+    std::ostringstream msg;
+    msg << "[paged_attention] query and key head_dim must match; found query shape "
+        << queries.shape() << " for k_pages shape " << k_pages.shape() << ".";
+    throw std::invalid_argument(msg.str());
+  }
+
+  auto n_q_heads = queries.shape(1);
+  auto n_kv_heads = k_pages.shape(1);
+  if (n_q_heads % n_kv_heads != 0) {
+    std::ostringstream msg;
+    msg << "[paged_attention] n_heads must be a multiple of n_kv_heads, found n_heads "
+        << n_q_heads << " for n_kv_heads " << n_kv_heads << ".";
+    throw std::invalid_argument(msg.str());
+  }
+
+  auto final_type = result_type(queries, k_pages, v_pages);
+  if (!issubdtype(final_type, floating)) {
+    std::ostringstream msg;
+    msg << "[paged_attention] Received unsupported type " << final_type
+        << ".";
+    throw std::invalid_argument(msg.str());
+  }
+
+  auto stream = to_stream(s);
+  auto q = astype(queries, final_type, stream);
+  auto k = astype(k_pages, final_type, stream);
+  auto v = astype(v_pages, final_type, stream);
+
+  auto fallback = [scale, s](const std::vector<array>& inputs) {
+    auto& q = inputs[0];
+    auto& k_pages = inputs[1];
+    auto& v_pages = inputs[2];
+    auto& page_table = inputs[3];
+    auto& context_lens = inputs[4];
+
+    int B = q.shape(0);
+    int max_pages = page_table.shape(1);
+    int page_size = k_pages.shape(2);
+    int max_len = max_pages * page_size;
+
+    // Gather the pages dense: (B, n_kv_heads, max_pages * page_size, D)
+    auto gather_pages = [&](const array& pages) {
+      auto dense = take(pages, flatten(page_table, 0, 1, s), 0, s);
+      dense = unflatten(dense, 0, {B, max_pages}, s);
+      dense = transpose(dense, {0, 2, 1, 3, 4}, s);
+      return flatten(dense, 2, 3, s);
+    };
+    auto k = gather_pages(k_pages);
+    auto v = gather_pages(v_pages);
+
+    // Tokens past a sequence's context length are masked out
+    auto mask = less(
+        arange(max_len, int32, s), expand_dims(context_lens, 1, s), s);
+    mask = expand_dims(mask, {1, 2}, s);
+    return std::vector<array>{scaled_dot_product_attention(
+        q, k, v, scale, "array", {mask}, std::nullopt, std::nullopt, s)};
+  };
+
+  const int query_head_dim = q.shape(-1);
+  const bool supported_head_dim = query_head_dim == v.shape(-1) &&
+      (query_head_dim == 64 || query_head_dim == 96 || query_head_dim == 128 ||
+       query_head_dim == 256);
+  const bool supports_paged_vector = q.shape(2) == 1 && supported_head_dim;
+
+  std::vector<array> inputs = {q, k, v, page_table, context_lens};
+  if (supports_paged_vector && !PagedAttention::use_fallback(stream)) {
+    auto out_shape = Shape{q.shape(0), q.shape(1), q.shape(2), v.shape(-1)};
+    return array(
+        std::move(out_shape),
+        final_type,
+        std::make_shared<PagedAttention>(stream, fallback, scale),
+        std::move(inputs));
+  }
+  return fallback(std::move(inputs))[0];
+}
+
+array rope_attention(
+    const array& queries,
+    const array& keys,
+    const array& values,
+    int dims,
+    bool traditional,
+    float base,
+    float rope_scale,
+    int offset,
+    const float scale,
+    const std::string& mask_mode /* = "" */,
+    StreamOrDevice s /* = {} */) {
+  for (const auto& tensor : {queries, keys, values}) {
+    if (tensor.ndim() != 4) {
+      std::ostringstream msg;
+      msg << "[rope_attention] input with shape " << tensor.shape()
+          << " expected to be rank 4";
+      throw std::invalid_argument(msg.str());
+    }
+  }
+  if (mask_mode != "" && mask_mode != "causal") {
+    std::ostringstream msg;
+    msg << "[rope_attention] Invalid mask_mode " << mask_mode
+        << ". mask_mode must be 'causal' or ''.";
+    throw std::invalid_argument(msg.str());
+  }
+  bool do_causal = mask_mode == "causal";
+
+  if (dims <= 0 || dims % 2 != 0 || dims > queries.shape(-1)) {
+    std::ostringstream msg;
+    msg << "[rope_attention] rotating dimensions must be an even number "
+        << "no larger than the head dim but got " << dims
+        << " for head dim " << queries.shape(-1) << ".";
+    throw std::invalid_argument(msg.str());
+  }
+
+  const size_t batch_dim = queries.shape(0);
+  for (const auto& tensor : {keys, values}) {
+    if (tensor.shape(0) != batch_dim) {
+      std::ostringstream msg;
+      msg << "[rope_attention] mismatching batch dimension for input with shape "
+          << tensor.shape() << ".";
+      throw std::invalid_argument(msg.str());
+    }
+  }
+  if (queries.shape(-1) != keys.shape(-1)) {
+    std::ostringstream msg;
+    msg << "[rope_attention] query, keys expected to have matching last dimension; found query shape "
+        << queries.shape() << " for keys shape " << keys.shape() << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  if (keys.shape(-3) != values.shape(-3)) {
+    std::ostringstream msg;
+    msg << "[rope_attention] keys, values expected to have matching n_kv_heads; found keys with n_heads "
+        << keys.shape(-3) << " for values with n_heads " << values.shape(-3)
+        << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  if (queries.shape(-3) % keys.shape(-3) != 0) {
+    std::ostringstream msg;
+    msg << "[rope_attention] n_heads must be a multiple of n_kv_heads, found n_heads "
+        << queries.shape(-3) << " for n_kv_heads " << keys.shape(-3) << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  // The queries are the trailing positions of the key sequence so the
+  // key sequence cannot be shorter
+  if (queries.shape(2) > keys.shape(2)) {
+    std::ostringstream msg;
+    msg << "[rope_attention] expected query sequence length "
+        << queries.shape(2) << " to be no longer than key sequence length "
+        << keys.shape(2) << ".";
+    throw std::invalid_argument(msg.str());
+  }
+
+  auto final_type = result_type(queries, keys, values);
+  if (!issubdtype(final_type, floating)) {
+    std::ostringstream msg;
+    msg << "[rope_attention] Received unsupported type " << final_type << ".";
+    throw std::invalid_argument(msg.str());
+  }
+
+  auto q = astype(queries, final_type, s);
+  auto k = astype(keys, final_type, s);
+  auto v = astype(values, final_type, s);
+
+  auto fallback =
+      [dims, traditional, base, rope_scale, offset, scale, do_causal, s](
+          const std::vector<array>& inputs) {
+        auto& q = inputs[0];
+        auto& k = inputs[1];
+        auto& v = inputs[2];
+        int q_offset = offset + k.shape(2) - q.shape(2);
+        auto q_rot =
+            rope(q, dims, traditional, base, rope_scale, q_offset, {}, s);
+        auto k_rot =
+            rope(k, dims, traditional, base, rope_scale, offset, {}, s);
+        return std::vector<array>{scaled_dot_product_attention(
+            q_rot, k_rot, v, scale, do_causal ? "causal" : "", {}, {}, {}, s)};
+      };
+
+  auto stream = to_stream(s);
+
+  // Only the full attention kernel applies the rotation at load time;
+  // short query sequences fall back to rope + sdpa which route to the
+  // vector kernels anyway.
+  const int query_head_dim = q.shape(-1);
+  const bool supported_head_dim = query_head_dim == v.shape(-1) &&
+      (query_head_dim == 64 || query_head_dim == 80 || query_head_dim == 128);
+  const bool supports_full = q.shape(2) > 8 && supported_head_dim;
+
+  std::vector<array> inputs = {q, k, v};
+  if (supports_full && !RoPEAttention::use_fallback(stream)) {
+    return array(
+        q.shape(),
+        final_type,
+        std::make_shared<RoPEAttention>(
+            stream,
+            fallback,
+            dims,
+            traditional,
+            base,
+            rope_scale,
+            offset,
+            scale,
+            do_causal),
+        std::move(inputs));
+  }
+  return fallback(std::move(inputs))[0];
+}
+
+namespace {
+
+// Dequantization table for 8-bit floats; the index is the bit pattern
+std::vector<float> fp8_decode_table(bool e5m2) {
+  int exp_bits = e5m2 ? 5 : 4;
+  int man_bits = 7 - exp_bits;
+  int bias = (1 << (exp_bits - 1)) - 1;
+  std::vector<float> table(256);
+  for (int i = 0; i < 256; ++i) {
+    int e = (i >> man_bits) & ((1 << exp_bits) - 1);
+    int m = i & ((1 << man_bits) - 1);
+    float v;
+    if (e == 0) {
+      // Subnormals
+      v = std::ldexp(float(m) / (1 << man_bits), 1 - bias);
+    } else if (e5m2 && e == (1 << exp_bits) - 1) {
+      v = m == 0 ? std::numeric_limits<float>::infinity()
+                 : std::numeric_limits<float>::quiet_NaN();
+    } else if (!e5m2 && e == 15 && m == 7) {
+      // E4M3 spends the top encoding on NaN and has no infinity
+      v = std::numeric_limits<float>::quiet_NaN();
+    } else {
+      v = std::ldexp(1.0f + float(m) / (1 << man_bits), e - bias);
+    }
+    table[i] = (i >> 7) ? -v : v;
+  }
+  return table;
+}
+
+} // namespace
+
+array scaled_matmul(
+    const array& a,
+    const array& b,
+    const array& a_scale,
+    const array& b_scale,
+    Dtype out_dtype /* = bfloat16 */,
+    const std::string& variant /* = "e4m3" */,
+    StreamOrDevice s /* = {} */) {
+  if (variant != "e4m3" && variant != "e5m2") {
+    std::ostringstream msg;
+    msg << "[scaled_matmul] Invalid variant '" << variant
+        << "'. Must be 'e4m3' or 'e5m2'.";
+    throw std::invalid_argument(msg.str());
+  }
+  if (a.ndim() != 2 || b.ndim() != 2) {
+    std::ostringstream msg;
+    msg << "[scaled_matmul] Expected 2-D inputs but got shapes " << a.shape()
+        << " and " << b.shape() << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  if (a.dtype() != uint8 || b.dtype() != uint8) {
+    std::ostringstream msg;
+    msg << "[scaled_matmul] Inputs hold fp8 bit patterns and must have type "
+        << "uint8 but got " << a.dtype() << " and " << b.dtype() << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  if (a.shape(1) != b.shape(1)) {
+    std::ostringstream msg;
+    msg << "[scaled_matmul] The last dimensions of the inputs must match, "
+        << "with b given as (N, K), but got shapes " << a.shape() << " and "
+        << b.shape() << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  if (a_scale.size() != 1 || b_scale.size() != 1) {
+    std::ostringstream msg;
+    msg << "[scaled_matmul] Scales must be scalars but got shapes "
+        << a_scale.shape() << " and " << b_scale.shape() << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  if (out_dtype != float32 && out_dtype != float16 && out_dtype != bfloat16) {
+    std::ostringstream msg;
+    msg << "[scaled_matmul] Unsupported output type " << out_dtype << ".";
+    throw std::invalid_argument(msg.str());
+  }
+
+  auto fallback = [out_dtype, e5m2 = (variant == "e5m2"), s](
+                      const std::vector<array>& inputs) {
+    // Dequantize through a 256-entry decode table and run a regular matmul
+    auto table_data = fp8_decode_table(e5m2);
+    array table(table_data.begin(), {256}, float32);
+    auto da = take(table, astype(inputs[0], int32, s), 0, s);
+    auto db = take(table, astype(inputs[1], int32, s), 0, s);
+    auto scale = multiply(
+        astype(inputs[2], float32, s), astype(inputs[3], float32, s), s);
+    auto out = matmul(da, transpose(db, {1, 0}, s), s);
+    return std::vector<array>{astype(multiply(out, scale, s), out_dtype, s)};
+  };
+
+  auto stream = to_stream(s);
+
+  // cublasLt has no E5M2 x E5M2 kernels and needs 16-byte aligned leading
+  // dimensions
+  const bool supported =
+      variant == "e4m3" && a.shape(1) % 16 == 0 && b.shape(0) % 16 == 0;
+
+  std::vector<array> inputs = {
+      a, b, astype(a_scale, float32, s), astype(b_scale, float32, s)};
+  if (supported && !ScaledMatmul::use_fallback(stream)) {
+    return array(
+        {a.shape(0), b.shape(0)},
+        out_dtype,
+        std::make_shared<ScaledMatmul>(stream, fallback, out_dtype),
+        std::move(inputs));
+  }
+  return fallback(std::move(inputs))[0];
+}
+
+array swiglu_mlp(
+    const array& x,
+    const array& w_gate,
+    const array& w_up,
+    const array& w_down,
+    StreamOrDevice s_ /* = {} */) {
+  if (w_gate.ndim() != 2 || w_up.ndim() != 2 || w_down.ndim() != 2) {
+    std::ostringstream msg;
+    msg << "[swiglu_mlp] The weights must be 2-D but got shapes "
+        << w_gate.shape() << ", " << w_up.shape() << " and " << w_down.shape()
+        << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  if (w_gate.shape() != w_up.shape()) {
+    std::ostringstream msg;
+    msg << "[swiglu_mlp] The gate and up weights must have the same shape "
+        << "but got " << w_gate.shape() << " and " << w_up.shape() << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  if (x.ndim() == 0 || x.shape(-1) != w_gate.shape(0) ||
+      w_down.shape(0) != w_gate.shape(1)) {
+    std::ostringstream msg;
+    msg << "[swiglu_mlp] Incompatible shapes " << x.shape() << ", "
+        << w_gate.shape() << " and " << w_down.shape() << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  auto dtype = x.dtype();
+  if (!issubdtype(dtype, floating)) {
+    std::ostringstream msg;
+    msg << "[swiglu_mlp] Received unsupported type " << dtype << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  if (w_gate.dtype() != dtype || w_up.dtype() != dtype ||
+      w_down.dtype() != dtype) {
+    std::ostringstream msg;
+    msg << "[swiglu_mlp] The input and weights must all have the same type "
+        << "but got " << dtype << ", " << w_gate.dtype() << ", "
+        << w_up.dtype() << " and " << w_down.dtype() << ".";
+    throw std::invalid_argument(msg.str());
+  }
+
+  auto s = to_stream(s_);
+  auto fallback = [s](const std::vector<array>& inputs) {
+    auto g = matmul(inputs[0], inputs[1], s);
+    auto u = matmul(inputs[0], inputs[2], s);
+    auto y = multiply(multiply(g, sigmoid(g, s), s), u, s);
+    return std::vector<array>{matmul(y, inputs[3], s)};
+  };
+
+  bool supported = dtype == float32 || dtype == float16 || dtype == bfloat16;
+  if (supported && !SwiGLUMLP::use_fallback(s)) {
+    auto out_shape = x.shape();
+    out_shape.back() = w_down.shape(1);
+    return array(
+        std::move(out_shape),
+        dtype,
+        std::make_shared<SwiGLUMLP>(s, fallback),
+        {x, w_gate, w_up, w_down});
+  }
+  return fallback({x, w_gate, w_up, w_down})[0];
+}
+
+array rms_norm_matmul(
+    const array& x,
+    const std::optional<array>& weight,
+    const array& w,
+    float eps,
+    StreamOrDevice s_ /* = {} */) {
+  bool has_weight = weight.has_value();
+  if (x.ndim() == 0) {
+    std::ostringstream msg;
+    msg << "[rms_norm_matmul] Input must have at least 1 dimension but got "
+        << "input with 0 dimensions.";
+    throw std::invalid_argument(msg.str());
+  }
+  if (w.ndim() != 2) {
+    std::ostringstream msg;
+    msg << "[rms_norm_matmul] The projection weight must be 2-D but got shape "
+        << w.shape() << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  if (w.shape(1) != x.shape(-1)) {
+    std::ostringstream msg;
+    msg << "[rms_norm_matmul] The projection weight comes pre-transposed with "
+        << "shape (N, K); got " << w.shape() << " for input with shape "
+        << x.shape() << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  if (has_weight && (weight->ndim() != 1 || weight->shape(0) != x.shape(-1))) {
+    std::ostringstream msg;
+    msg << "[rms_norm_matmul] weight must have the same size as the last "
+        << "dimension of x but has " << weight->size() << " elements.";
+    throw std::invalid_argument(msg.str());
+  }
+  auto dtype = x.dtype();
+  if (!issubdtype(dtype, floating)) {
+    std::ostringstream msg;
+    msg << "[rms_norm_matmul] Received unsupported type " << dtype << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  if (w.dtype() != dtype || (has_weight && weight->dtype() != dtype)) {
+    std::ostringstream msg;
+    msg << "[rms_norm_matmul] The input and weights must all have the same "
+        << "type but got " << dtype << " and " << w.dtype() << ".";
+    throw std::invalid_argument(msg.str());
+  }
+
+  auto s = to_stream(s_);
+  auto fallback = [has_weight, eps, s](const std::vector<array>& inputs) {
+    auto nx = rms_norm(
+        inputs[0],
+        has_weight ? std::optional<array>(inputs[1]) : std::nullopt,
+        eps,
+        s);
+    return std::vector<array>{
+        matmul(nx, swapaxes(inputs.back(), -2, -1, s), s)};
+  };
+
+  auto passed_weight = has_weight ? *weight : array(1, dtype);
+  if (!RMSNormMatmul::use_fallback(x, w, s)) {
+    auto out_shape = x.shape();
+    out_shape.back() = w.shape(0);
+    return array(
+        std::move(out_shape),
+        dtype,
+        std::make_shared<RMSNormMatmul>(s, fallback, eps),
+        {x, passed_weight, w});
+  }
+  return fallback({x, passed_weight, w})[0];
+}
+
+array append(
+    const array& cache,
+    const array& values,
+    int axis,
+    StreamOrDevice s /* = {} */) {
+  if (cache.ndim() == 0 || cache.ndim() != values.ndim()) {
+    std::ostringstream msg;
+    msg << "[append] Cache and values must have the same non-zero number of"
+        << " dimensions but got " << cache.ndim() << " and " << values.ndim()
+        << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  auto ax = normalize_axis_index(axis, cache.ndim(), "[append] ");
+  for (int i = 0; i < cache.ndim(); ++i) {
+    if (i != ax && cache.shape(i) != values.shape(i)) {
+      std::ostringstream msg;
+      msg << "[append] Cache and values must match on all dimensions except"
+          << " the append axis but got shapes " << cache.shape() << " and "
+          << values.shape() << ".";
+      throw std::invalid_argument(msg.str());
+    }
+  }
+
+  auto dtype = promote_types(cache.dtype(), values.dtype());
+  auto vals = astype(values, dtype, s);
+
+  int length = cache.shape(ax);
+  int n = values.shape(ax);
+  int total = length + n;
+
+  // If the cache is an evaluated, aligned, row-major prefix view into a
+  // larger buffer, recover its capacity along the append axis from the
+  // strides (or from the buffer size when appending along the first axis).
+  int64_t capacity = 0;
+  int64_t inner = 1;
+  if (cache.status() != array::Status::unscheduled && !cache.is_tracer() &&
+      cache.dtype() == dtype && cache.size() > 0) {
+    bool row_major_below = true;
+    for (int i = cache.ndim() - 1; i > ax; --i) {
+      if (cache.strides(i) != inner) {
+        row_major_below = false;
+        break;
+      }
+      inner *= cache.shape(i);
+    }
+    auto buf = cache.buffer();
+    if (row_major_below && cache.strides(ax) == inner &&
+        cache.data<char>() == buf.raw_ptr()) {
+      if (ax > 0) {
+        capacity = cache.strides(ax - 1) / inner;
+      } else {
+        capacity = cache.buffer_size() / (cache.itemsize() * inner);
+      }
+      // Strides above the axis must match a row-major layout of the
+      // capacity shape
+      auto expected = capacity * inner;
+      for (int i = ax - 1; i >= 0; --i) {
+        if (cache.strides(i) != expected) {
+          capacity = 0;
+          break;
+        }
+        expected *= cache.shape(i);
+      }
+    }
+  }
+
+  if (capacity >= total) {
+    auto big_shape = cache.shape();
+    big_shape[ax] = capacity;
+    array big(big_shape, dtype, nullptr, {});
+    big.copy_shared_buffer(
+        cache,
+        cache.strides(),
+        {/* contiguous = */ true,
+         /* row_contiguous = */ true,
+         /* col_contiguous = */ big.ndim() <= 1},
+        big.size());
+    big.set_status(cache.status());
+    if (cache.event().valid()) {
+      big.attach_event(cache.event());
+    }
+    Shape start(cache.ndim(), 0);
+    start[ax] = length;
+    auto stop = big_shape;
+    stop[ax] = total;
+    auto out = slice_update(big, vals, std::move(start), std::move(stop), s);
+    auto out_stop = cache.shape();
+    out_stop[ax] = total;
+    return slice(out, Shape(cache.ndim(), 0), std::move(out_stop), s);
+  }
+
+  // No room: materialize a new buffer with ~1.5x slack so subsequent
+  // appends can be done in place
+  auto pad_shape = cache.shape();
+  pad_shape[ax] = std::max(total / 2, n);
+  auto big = concatenate(
+      {astype(cache, dtype, s), vals, zeros(pad_shape, dtype, s)}, ax, s);
+  auto stop = cache.shape();
+  stop[ax] = total;
+  return slice(big, Shape(cache.ndim(), 0), std::move(stop), s);
+}
+
+array cross_entropy(
+    const array& logits,
+    const array& targets,
+    StreamOrDevice s_ /* = {} */) {
+  if (logits.ndim() == 0) {
+    std::ostringstream msg;
+    msg << "[cross_entropy] The logits must have at least 1 dimension but "
+           "got logits with 0 dimensions.";
+    throw std::invalid_argument(msg.str());
+  }
+  if (!issubdtype(logits.dtype(), floating)) {
+    std::ostringstream msg;
+    msg << "[cross_entropy] Received unsupported type " << logits.dtype()
+        << " for the logits.";
+    throw std::invalid_argument(msg.str());
+  }
+  if (!issubdtype(targets.dtype(), integer)) {
+    std::ostringstream msg;
+    msg << "[cross_entropy] The targets must be integer class indices but "
+           "have type "
+        << targets.dtype() << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  auto out_shape = Shape(logits.shape().begin(), logits.shape().end() - 1);
+  if (targets.shape() != out_shape) {
+    std::ostringstream msg;
+    msg << "[cross_entropy] The targets must have the shape of the logits "
+           "without the last axis, but got targets with shape "
+        << targets.shape() << " for logits with shape " << logits.shape()
+        << ".";
+    throw std::invalid_argument(msg.str());
+  }
+
+  auto s = to_stream(s_);
+  auto fallback = [s](const std::vector<array>& inputs) {
+    auto lse = logsumexp(inputs[0], -1, /* keepdims */ false, s);
+    auto picked = squeeze(
+        take_along_axis(inputs[0], expand_dims(inputs[1], -1, s), -1, s),
+        -1,
+        s);
+    return std::vector<array>{subtract(lse, picked, s)};
+  };
+
+  if (!CrossEntropy::use_fallback(s)) {
+    return array(
+        std::move(out_shape),
+        logits.dtype(),
+        std::make_shared<CrossEntropy>(s, fallback),
+        {logits, targets});
+  }
+  return fallback({logits, targets})[0];
+}
+
+array linear_cross_entropy(
+    const array& x,
+    const array& w,
+    const array& targets,
+    int chunk_size /* = 4096 */,
+    StreamOrDevice s_ /* = {} */) {
+  if (x.ndim() == 0 || w.ndim() != 2) {
+    std::ostringstream msg;
+    msg << "[linear_cross_entropy] The input must have at least 1 dimension "
+           "and the projection must be 2-D but got input with shape "
+        << x.shape() << " and projection with shape " << w.shape() << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  if (x.shape().back() != w.shape(1)) {
+    std::ostringstream msg;
+    msg << "[linear_cross_entropy] The last axis of the input with shape "
+        << x.shape() << " must match the feature axis of the projection "
+        << "with shape " << w.shape() << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  auto out_type = promote_types(x.dtype(), w.dtype());
+  if (!issubdtype(out_type, floating)) {
+    std::ostringstream msg;
+    msg << "[linear_cross_entropy] Received unsupported types " << x.dtype()
+        << " and " << w.dtype() << " for the input and projection.";
+    throw std::invalid_argument(msg.str());
+  }
+  if (!issubdtype(targets.dtype(), integer)) {
+    std::ostringstream msg;
+    msg << "[linear_cross_entropy] The targets must be integer class indices "
+           "but have type "
+        << targets.dtype() << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  auto out_shape = Shape(x.shape().begin(), x.shape().end() - 1);
+  if (targets.shape() != out_shape) {
+    std::ostringstream msg;
+    msg << "[linear_cross_entropy] The targets must have the shape of the "
+           "input without the last axis, but got targets with shape "
+        << targets.shape() << " for input with shape " << x.shape() << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  if (chunk_size <= 0) {
+    std::ostringstream msg;
+    msg << "[linear_cross_entropy] chunk_size must be positive but got "
+        << chunk_size << ".";
+    throw std::invalid_argument(msg.str());
+  }
+
+  auto s = to_stream(s_);
+  auto fallback = [s, chunk_size](const std::vector<array>& inputs) {
+    auto& x = inputs[0];
+    auto& w = inputs[1];
+    int V = w.shape(0);
+    int D = w.shape(1);
+    auto t = expand_dims(inputs[2], -1, s);
+    // Project one vocabulary chunk at a time, folding each chunk's maximum
+    // and sum of exponentials into running values like an online softmax,
+    // and gathering the target logit from whichever chunk contains it. The
+    // full logits never exist at once.
+    std::optional<array> m, l, zt;
+    for (int start = 0; start < V; start += chunk_size) {
+      int stop = std::min(start + chunk_size, V);
+      auto wc = slice(w, {start, 0}, {stop, D}, s);
+      auto logits = matmul(x, transpose(wc, s), s);
+      auto cm = max(logits, -1, /* keepdims */ true, s);
+      auto cl = sum(exp(subtract(logits, cm, s), s), -1, /* keepdims */ true, s);
+      auto lo = array(start, t.dtype());
+      auto in_chunk = logical_and(
+          greater_equal(t, lo, s), less(t, array(stop, t.dtype()), s), s);
+      // Out of chunk lanes index row 0 and are zeroed afterwards
+      auto local = where(in_chunk, subtract(t, lo, s), zeros_like(t, s), s);
+      auto picked = where(
+          in_chunk,
+          take_along_axis(logits, local, -1, s),
+          array(0, logits.dtype()),
+          s);
+      if (!m) {
+        m = cm;
+        l = cl;
+        zt = picked;
+      } else {
+        auto mn = maximum(*m, cm, s);
+        l = add(
+            multiply(*l, exp(subtract(*m, mn, s), s), s),
+            multiply(cl, exp(subtract(cm, mn, s), s), s),
+            s);
+        m = std::move(mn);
+        zt = add(*zt, picked, s);
+      }
+    }
+    auto lse = add(*m, log(*l, s), s);
+    return std::vector<array>{squeeze(subtract(lse, *zt, s), -1, s)};
+  };
+
+  std::vector<array> inputs = {
+      astype(x, out_type, s), astype(w, out_type, s), targets};
+  if (!LinearCrossEntropy::use_fallback(s)) {
+    return array(
+        std::move(out_shape),
+        out_type,
+        std::make_shared<LinearCrossEntropy>(s, fallback, chunk_size),
+        std::move(inputs));
+  }
+  return fallback(std::move(inputs))[0];
+}
+
+array sample_top_p(
+    const array& logits,
+    float temperature /* = 1.0f */,
+    float top_p /* = 1.0f */,
+    int top_k /* = 0 */,
+    const std::optional<array>& key /* = std::nullopt */,
+    StreamOrDevice s_ /* = {} */) {
+  if (logits.ndim() == 0) {
+    std::ostringstream msg;
+    msg << "[sample_top_p] The logits must have at least 1 dimension but "
+           "got logits with 0 dimensions.";
+    throw std::invalid_argument(msg.str());
+  }
+  if (!issubdtype(logits.dtype(), floating)) {
+    std::ostringstream msg;
+    msg << "[sample_top_p] Received unsupported type " << logits.dtype()
+        << " for the logits.";
+    throw std::invalid_argument(msg.str());
+  }
+  if (top_p <= 0 || top_p > 1) {
+    std::ostringstream msg;
+    msg << "[sample_top_p] top_p must be in (0, 1] but got " << top_p << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  if (top_k < 0 || temperature < 0) {
+    std::ostringstream msg;
+    msg << "[sample_top_p] top_k and temperature must be non-negative but "
+        << "got top_k=" << top_k << " and temperature=" << temperature << ".";
+    throw std::invalid_argument(msg.str());
+  }
+
+  auto s = to_stream(s_);
+  if (temperature == 0) {
+    return argmax(logits, -1, /* keepdims */ false, s);
+  }
+
+  auto probs = softmax(
+      divide(astype(logits, float32, s), array(temperature, float32), s),
+      -1,
+      /* precise */ true,
+      s);
+  auto order = argsort(negative(probs, s), -1, s);
+  auto sorted = take_along_axis(probs, order, -1, s);
+  auto cum = cumsum(sorted, -1, /* reverse */ false, /* inclusive */ true, s);
+
+  // Keep a token while the mass strictly before it is below top_p, so the
+  // most likely token always survives.
+  auto keep = less(subtract(cum, sorted, s), array(top_p, float32), s);
+  if (top_k > 0) {
+    keep = logical_and(
+        keep, less(arange(0, logits.shape(-1), s), array(top_k, int32), s), s);
+  }
+
+  // Gumbel-max draw over the surviving set; the unnormalized log
+  // probabilities are enough so the filtered mass is never renormalized.
+  auto scores = where(
+      keep,
+      log(sorted, s),
+      array(-std::numeric_limits<float>::infinity(), float32),
+      s);
+  auto g = random::gumbel(scores.shape(), float32, key, s);
+  auto idx = argmax(add(scores, g, s), -1, /* keepdims */ true, s);
+  return squeeze(take_along_axis(order, idx, -1, s), -1, s);
+}
+
+std::vector<array> speculative_verify(
+    const array& logits,
+    const array& draft_tokens,
+    StreamOrDevice s_ /* = {} */) {
+  if (logits.ndim() < 2) {
+    std::ostringstream msg;
+    msg << "[speculative_verify] The logits must have at least 2 dimensions "
+           "but got shape "
+        << logits.shape() << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  if (!issubdtype(logits.dtype(), floating)) {
+    std::ostringstream msg;
+    msg << "[speculative_verify] Received unsupported type " << logits.dtype()
+        << " for the logits.";
+    throw std::invalid_argument(msg.str());
+  }
+  if (!issubdtype(draft_tokens.dtype(), integer)) {
+    std::ostringstream msg;
+    msg << "[speculative_verify] The draft tokens must be integer token ids "
+           "but have type "
+        << draft_tokens.dtype() << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  auto expected = Shape(logits.shape().begin(), logits.shape().end() - 1);
+  expected.back() -= 1;
+  if (logits.shape(-2) < 2 || draft_tokens.shape() != expected) {
+    std::ostringstream msg;
+    msg << "[speculative_verify] The logits must score every draft position "
+           "plus the position after the last one, but got draft tokens with "
+           "shape "
+        << draft_tokens.shape() << " for logits with shape " << logits.shape()
+        << ".";
+    throw std::invalid_argument(msg.str());
+  }
+
+  auto s = to_stream(s_);
+  int k = draft_tokens.shape(-1);
+
+  // The target's greedy choice at every position, including the bonus
+  // position after the last draft token.
+  auto preds = argmax(logits, -1, /* keepdims */ false, s);
+
+  auto stop = preds.shape();
+  stop.back() = k;
+  auto matched = equal(
+      slice(preds, Shape(preds.ndim(), 0), std::move(stop), s),
+      astype(draft_tokens, preds.dtype(), s),
+      s);
+
+  // Count the leading run of matches; the cumulative product zeroes
+  // everything after the first mismatch.
+  auto accepted = sum(
+      cumprod(astype(matched, int32, s), -1, /* reverse */ false, true, s),
+      -1,
+      /* keepdims */ false,
+      s);
+
+  // The token the target emits at the first mismatch, or the bonus token
+  // when every draft token was accepted.
+  auto next = squeeze(
+      take_along_axis(preds, expand_dims(accepted, -1, s), -1, s), -1, s);
+  return {accepted, next};
+}
+
+namespace {
+
+// Group parameter indices by dtype so each group fuses into a single
+// contiguous tensor
+std::vector<std::pair<Dtype, std::vector<int>>> group_by_dtype(
+    const std::vector<array>& params) {
+  std::vector<std::pair<Dtype, std::vector<int>>> groups;
+  for (int i = 0; i < params.size(); ++i) {
+    auto d = params[i].dtype();
+    auto it = std::find_if(groups.begin(), groups.end(), [&d](const auto& g) {
+      return g.first == d;
+    });
+    if (it == groups.end()) {
+      groups.push_back({d, {i}});
+    } else {
+      it->second.push_back(i);
+    }
+  }
+  return groups;
+}
+
+array fuse_group(
+    const std::vector<array>& arrs,
+    const std::vector<int>& idx,
+    StreamOrDevice s) {
+  std::vector<array> flat;
+  flat.reserve(idx.size());
+  for (auto i : idx) {
+    flat.push_back(flatten(arrs[i], s));
+  }
+  return flat.size() == 1 ? flat[0] : concatenate(std::move(flat), 0, s);
+}
+
+void unfuse_group(
+    const array& fused,
+    const std::vector<array>& ref,
+    const std::vector<int>& idx,
+    std::vector<array>& out,
+    StreamOrDevice s) {
+  if (idx.size() == 1) {
+    out[idx[0]] = reshape(fused, ref[idx[0]].shape(), s);
+    return;
+  }
+  Shape offsets;
+  ShapeElem offset = 0;
+  for (int i = 0; i + 1 < idx.size(); ++i) {
+    offset += ref[idx[i]].size();
+    offsets.push_back(offset);
+  }
+  auto pieces = split(fused, offsets, 0, s);
+  for (int i = 0; i < idx.size(); ++i) {
+    out[idx[i]] = reshape(pieces[i], ref[idx[i]].shape(), s);
+  }
+}
+
+void validate_update_lists(
+    const std::vector<array>& parameters,
+    const std::vector<array>& other,
+    const char* other_name,
+    const char* fn_name) {
+  if (other.size() != parameters.size()) {
+    std::ostringstream msg;
+    msg << "[" << fn_name << "] Number of " << other_name << " ("
+        << other.size() << ") does not match number of parameters ("
+        << parameters.size() << ").";
+    throw std::invalid_argument(msg.str());
+  }
+  for (int i = 0; i < parameters.size(); ++i) {
+    if (other[i].shape() != parameters[i].shape() ||
+        other[i].dtype() != parameters[i].dtype()) {
+      std::ostringstream msg;
+      msg << "[" << fn_name << "] Entry " << i << " of " << other_name
+          << " with shape " << other[i].shape() << " and dtype "
+          << other[i].dtype() << " does not match parameter with shape "
+          << parameters[i].shape() << " and dtype " << parameters[i].dtype()
+          << ".";
+      throw std::invalid_argument(msg.str());
+    }
+  }
+}
+
+} // namespace
+
+std::vector<array> sgd_update(
+    const std::vector<array>& parameters,
+    const std::vector<array>& gradients,
+    float learning_rate,
+    StreamOrDevice s /* = {} */) {
+  if (parameters.empty()) {
+    throw std::invalid_argument(
+        "[sgd_update] At least one parameter is required.");
+  }
+  validate_update_lists(parameters, gradients, "gradients", "sgd_update");
+
+  std::vector<array> updated(parameters.begin(), parameters.end());
+  for (auto& [dtype, idx] : group_by_dtype(parameters)) {
+    auto p = fuse_group(parameters, idx, s);
+    auto g = fuse_group(gradients, idx, s);
+    p = subtract(p, multiply(array(learning_rate, dtype), g, s), s);
+    unfuse_group(p, parameters, idx, updated, s);
+  }
+  return updated;
+}
+
+std::vector<array> adam_update(
+    const std::vector<array>& parameters,
+    const std::vector<array>& gradients,
+    const std::vector<array>& m,
+    const std::vector<array>& v,
+    float learning_rate,
+    float beta1 /* = 0.9f */,
+    float beta2 /* = 0.999f */,
+    float eps /* = 1e-8f */,
+    StreamOrDevice s /* = {} */) {
+  if (parameters.empty()) {
+    throw std::invalid_argument(
+        "[adam_update] At least one parameter is required.");
+  }
+  validate_update_lists(parameters, gradients, "gradients", "adam_update");
+  validate_update_lists(parameters, m, "first moments", "adam_update");
+  validate_update_lists(parameters, v, "second moments", "adam_update");
+
+  std::vector<array> new_p(parameters.begin(), parameters.end());
+  std::vector<array> new_m(m.begin(), m.end());
+  std::vector<array> new_v(v.begin(), v.end());
+  for (auto& [dtype, idx] : group_by_dtype(parameters)) {
+    auto pf = fuse_group(parameters, idx, s);
+    auto gf = fuse_group(gradients, idx, s);
+    auto mf = fuse_group(m, idx, s);
+    auto vf = fuse_group(v, idx, s);
+
+    mf = add(
+        multiply(array(beta1, dtype), mf, s),
+        multiply(array(1.0f - beta1, dtype), gf, s),
+        s);
+    vf = add(
+        multiply(array(beta2, dtype), vf, s),
+        multiply(array(1.0f - beta2, dtype), square(gf, s), s),
+        s);
+    pf = subtract(
+        pf,
+        divide(
+            multiply(array(learning_rate, dtype), mf, s),
+            add(sqrt(vf, s), array(eps, dtype), s),
+            s),
+        s);
+
+    unfuse_group(pf, parameters, idx, new_p, s);
+    unfuse_group(mf, parameters, idx, new_m, s);
+    unfuse_group(vf, parameters, idx, new_v, s);
+  }
+
+  std::vector<array> outs = std::move(new_p);
+  outs.insert(outs.end(), new_m.begin(), new_m.end());
+  outs.insert(outs.end(), new_v.begin(), new_v.end());
+  return outs;
+}
+
+std::vector<array> grad_overflow(
+    const std::vector<array>& gradients,
+    StreamOrDevice s /* = {} */) {
+  if (gradients.empty()) {
+    throw std::invalid_argument(
+        "[grad_overflow] At least one gradient is required.");
+  }
+
+  // One abs-max and one finiteness reduction per dtype group instead of a
+  // full pass per tensor. The max reduction need not propagate nans, so
+  // finiteness is checked on the values rather than inferred from amax.
+  std::optional<array> amax;
+  std::optional<array> finite;
+  for (auto& [dtype, idx] : group_by_dtype(gradients)) {
+    auto g = fuse_group(gradients, idx, s);
+    auto group_amax = astype(max(abs(g, s), s), float32, s);
+    auto group_finite = all(isfinite(g, s), s);
+    amax = amax ? maximum(*amax, group_amax, s) : group_amax;
+    finite = finite ? logical_and(*finite, group_finite, s) : group_finite;
+  }
+  return {std::move(*amax), logical_not(std::move(*finite), s)};
+}
+
+array input_embedding(
+    const array& weights,
+    const array& indices,
+    const array& positions,
+    Dtype dtype,
+    StreamOrDevice s_ /* = {} */) {
+  if (weights.ndim() != 2) {
+    std::ostringstream msg;
+    msg << "[input_embedding] The embedding table must be 2-D but got shape "
+        << weights.shape() << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  if (!issubdtype(weights.dtype(), floating) ||
+      !issubdtype(dtype, floating)) {
+    std::ostringstream msg;
+    msg << "[input_embedding] Received unsupported types " << weights.dtype()
+        << " and " << dtype << " for the table and output.";
+    throw std::invalid_argument(msg.str());
+  }
+  if (!issubdtype(indices.dtype(), integer)) {
+    std::ostringstream msg;
+    msg << "[input_embedding] The indices must be integer token ids but "
+           "have type "
+        << indices.dtype() << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  auto out_shape = indices.shape();
+  out_shape.push_back(weights.shape(1));
+  if (positions.shape() != out_shape || positions.dtype() != weights.dtype()) {
+    std::ostringstream msg;
+    msg << "[input_embedding] The positions with shape " << positions.shape()
+        << " and dtype " << positions.dtype()
+        << " must match the gathered rows with shape " << out_shape
+        << " and dtype " << weights.dtype() << ".";
+    throw std::invalid_argument(msg.str());
+  }
+
+  auto s = to_stream(s_);
+  auto fallback = [s, dtype](const std::vector<array>& inputs) {
+    return std::vector<array>{
+        astype(add(take(inputs[0], inputs[1], 0, s), inputs[2], s), dtype, s)};
+  };
+
+  bool supported = weights.dtype() != float64 && dtype != float64;
+  if (supported && !InputEmbedding::use_fallback(s)) {
+    return array(
+        std::move(out_shape),
+        dtype,
+        std::make_shared<InputEmbedding>(s, fallback),
+        {weights, indices, positions});
+  }
+  return fallback({weights, indices, positions})[0];
+}
+
+std::vector<array> batch_merge(
+    const std::vector<array>& sequences,
+    StreamOrDevice s /* = {} */) {
+  if (sequences.empty()) {
+    throw std::invalid_argument(
+        "[batch_merge] At least one sequence is required.");
+  }
+  auto& first = sequences[0];
+  if (first.ndim() == 0) {
+    throw std::invalid_argument(
+        "[batch_merge] Sequences must have at least one axis.");
+  }
+  for (int i = 1; i < sequences.size(); ++i) {
+    auto& seq = sequences[i];
+    bool trailing_match = seq.ndim() == first.ndim() &&
+        std::equal(
+            seq.shape().begin() + 1,
+            seq.shape().end(),
+            first.shape().begin() + 1);
+    if (!trailing_match || seq.dtype() != first.dtype()) {
+      std::ostringstream msg;
+      msg << "[batch_merge] Sequence " << i << " with shape " << seq.shape()
+          << " and dtype " << seq.dtype()
+          << " does not match the first sequence with shape " << first.shape()
+          << " and dtype " << first.dtype()
+          << " in its trailing dimensions and dtype.";
+      throw std::invalid_argument(msg.str());
+    }
+  }
+
+  std::vector<int32_t> offsets(sequences.size() + 1, 0);
+  for (int i = 0; i < sequences.size(); ++i) {
+    offsets[i + 1] = offsets[i] + sequences[i].shape(0);
+  }
+  auto packed = concatenate(sequences, 0, s);
+  return {
+      std::move(packed),
+      array(
+          offsets.begin(),
+          {static_cast<ShapeElem>(offsets.size())},
+          int32)};
+}
+
+std::vector<array> batch_split(
+    const array& packed,
+    const std::vector<int>& lengths,
+    StreamOrDevice s /* = {} */) {
+  if (lengths.empty()) {
+    throw std::invalid_argument(
+        "[batch_split] At least one length is required.");
+  }
+  Shape indices;
+  ShapeElem offset = 0;
+  for (int i = 0; i + 1 < lengths.size(); ++i) {
+    offset += lengths[i];
+    indices.push_back(offset);
+  }
+  if (packed.ndim() == 0 ||
+      packed.shape(0) !=
+          std::accumulate(lengths.begin(), lengths.end(), 0)) {
+    std::ostringstream msg;
+    msg << "[batch_split] Lengths sum to "
+        << std::accumulate(lengths.begin(), lengths.end(), 0)
+        << " but the packed array has shape " << packed.shape() << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  return split(packed, indices, 0, s);
+}
+
+array ragged_scaled_dot_product_attention(
+    const array& queries,
+    const array& keys,
+    const array& values,
+    const float scale,
+    const std::vector<int>& lengths,
+    StreamOrDevice s /* = {} */) {
+  int total = std::accumulate(lengths.begin(), lengths.end(), 0);
+  for (const auto& tensor : {queries, keys, values}) {
+    if (tensor.ndim() != 4 || tensor.shape(0) != 1 ||
+        tensor.shape(2) != total) {
+      std::ostringstream msg;
+      msg << "[ragged_scaled_dot_product_attention] Input with shape "
+          << tensor.shape() << " expected to be rank 4 with shape "
+          << "(1, n_heads, total_tokens, head_dim) where the given lengths "
+          << "sum to " << total << " tokens.";
+      throw std::invalid_argument(msg.str());
+    }
+  }
+
+  // Segment id per packed token, built host side since the lengths are
+  // host known
+  std::vector<int32_t> seg_ids(total);
+  for (int i = 0, t = 0; i < lengths.size(); ++i) {
+    std::fill_n(seg_ids.begin() + t, lengths[i], i);
+    t += lengths[i];
+  }
+  auto seg = array(seg_ids.begin(), {total}, int32);
+
+  // Block-diagonal causal mask: a query attends to a key when they share
+  // a segment and the key is not in the future
+  auto pos = arange(total, int32, s);
+  auto mask = logical_and(
+      equal(reshape(seg, {total, 1}, s), reshape(seg, {1, total}, s), s),
+      greater_equal(
+          reshape(pos, {total, 1}, s), reshape(pos, {1, total}, s), s),
+      s);
+  return scaled_dot_product_attention(
+      queries, keys, values, scale, "array", {std::move(mask)}, {}, {}, s);
+}
+
+bool CrossEntropy::use_fallback(Stream s) {
+  return s.device == Device::gpu;
+}
+
+bool InputEmbedding::use_fallback(Stream s) {
+  return s.device == Device::gpu;
+}
+
+std::vector<Shape> InputEmbedding::output_shapes(
+    const std::vector<array>& inputs) {
+  auto shape = inputs[1].shape();
+  shape.push_back(inputs[0].shape(1));
+  return {std::move(shape)};
+}
+
+std::vector<Shape> CrossEntropy::output_shapes(
+    const std::vector<array>& inputs) {
+  auto shape = inputs[0].shape();
+  shape.pop_back();
+  return {std::move(shape)};
+}
+
+bool LinearCrossEntropy::use_fallback(Stream s) {
+  return s.device == Device::gpu;
+}
+
+std::vector<Shape> LinearCrossEntropy::output_shapes(
+    const std::vector<array>& inputs) {
+  auto shape = inputs[0].shape();
+  shape.pop_back();
+  return {std::move(shape)};
+}
+
+bool LinearCrossEntropy::is_equivalent(const Primitive& other) const {
+  const LinearCrossEntropy& a_other =
+      static_cast<const LinearCrossEntropy&>(other);
+  return chunk_size_ == a_other.chunk_size_;
+}
+
+bool ScaledDotProductAttention::is_equivalent(const Primitive& other) const {
+  const ScaledDotProductAttention& a_other =
+      static_cast<const ScaledDotProductAttention&>(other);
+  return scale_ == a_other.scale_ && do_causal_ == a_other.do_causal_ &&
+      has_sinks_ == a_other.has_sinks_ && window_ == a_other.window_ &&
+      block_sparse_ == a_other.block_sparse_;
+}
+
+bool RMSNormMatmul::is_equivalent(const Primitive& other) const {
+  const RMSNormMatmul& a_other = static_cast<const RMSNormMatmul&>(other);
+  return eps_ == a_other.eps_;
+}
+
+bool QuantizedSDPA::is_equivalent(const Primitive& other) const {
+  const QuantizedSDPA& a_other = static_cast<const QuantizedSDPA&>(other);
+  return scale_ == a_other.scale_ && do_causal_ == a_other.do_causal_ &&
+      group_size_ == a_other.group_size_ && bits_ == a_other.bits_;
+}
+
+bool PagedAttention::is_equivalent(const Primitive& other) const {
+  const PagedAttention& a_other = static_cast<const PagedAttention&>(other);
+  return scale_ == a_other.scale_;
+}
+
+bool RoPEAttention::is_equivalent(const Primitive& other) const {
+  const RoPEAttention& a_other = static_cast<const RoPEAttention&>(other);
+  return (
+      dims_ == a_other.dims_ && traditional_ == a_other.traditional_ &&
+      base_ == a_other.base_ && rope_scale_ == a_other.rope_scale_ &&
+      offset_ == a_other.offset_ && scale_ == a_other.scale_ &&
+      do_causal_ == a_other.do_causal_);
+}
+
+bool ScaledMatmul::is_equivalent(const Primitive& other) const {
+  const ScaledMatmul& s_other = static_cast<const ScaledMatmul&>(other);
+  return out_dtype_ == s_other.out_dtype_;
 }
 
 bool Quantize::is_equivalent(const Primitive& other) const {
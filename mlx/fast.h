@@ -42,7 +42,21 @@ array rope(
     const std::optional<array>& freqs = std::nullopt,
     StreamOrDevice s = {});
 
-/** Computes: O = softmax(Q @ K.T) @ V **/
+/** Computes: O = softmax(Q @ K.T) @ V
+ *
+ * With `sliding_window` set to a positive W, every query attends only to
+ * the W most recent keys at or before its position (plus the sink
+ * entries given via `sinks`). The window is enforced in the fused
+ * kernel's iteration bounds, so long-context decode never materializes
+ * an O(L^2) mask; it requires `mask_mode == "causal"` and no mask array.
+ *
+ * With `mask_mode == "block_sparse"` the single mask array is a boolean
+ * block table broadcastable to `(B, n_heads, ceil(L_q / 64), ceil(L_kv / 64))`
+ * at a granularity of 64 tokens per entry: entry `(i, j)` says whether
+ * queries in block `i` may attend to keys in block `j`. The fused kernel
+ * skips the KV tiles of false entries outright, so the cost scales with
+ * the number of true blocks rather than L_q * L_kv.
+ */
 array scaled_dot_product_attention(
     const array& queries,
     const array& keys,
@@ -51,6 +65,331 @@ array scaled_dot_product_attention(
     const std::string& mask_mode = "",
     const std::vector<array>& mask_arrs = {},
     const std::optional<array>& sinks = {},
+    std::optional<int> sliding_window = std::nullopt,
+    StreamOrDevice s = {});
+
+/**
+ * Scaled dot product attention over an affine-quantized KV cache.
+ *
+ * `keys` and `values` are packed `uint32` arrays produced by `quantize`
+ * with shape `(B, H_kv, L, D * bits / 32)`, and the per-group `scales`
+ * and `biases` have shape `(B, H_kv, L, D / group_size)` in the queries'
+ * dtype. The keys and values are dequantized as they are loaded inside
+ * the attention kernel, so a long-context cache is stored and streamed
+ * at `bits` bits per element instead of 16. `mask_mode` may be "" or
+ * "causal".
+ */
+array quantized_scaled_dot_product_attention(
+    const array& queries,
+    const array& keys,
+    const array& key_scales,
+    const array& key_biases,
+    const array& values,
+    const array& value_scales,
+    const array& value_biases,
+    const float scale,
+    const std::string& mask_mode = "",
+    int group_size = 64,
+    int bits = 8,
+    StreamOrDevice s = {});
+
+/**
+ * Scaled dot product attention over a paged KV cache.
+ *
+ * `k_pages` and `v_pages` are pools of fixed-size pages with shape
+ * `(num_pages, n_kv_heads, page_size, head_dim)` which many sequences
+ * share. `page_table` with shape `(B, max_pages)` holds the `int32` page
+ * indices of each sequence in order, and `context_lens` with shape `(B,)`
+ * holds the number of valid tokens per sequence. Every query attends to
+ * the first `context_lens[b]` tokens of its sequence; pages are read
+ * through the table so no gathering copy is made on the fast path.
+ * Table entries past a sequence's length must still name valid pages
+ * (page 0 is fine) — they are masked out but may be read.
+ *
+ * The pools are plain arrays: allocate a pool once, hand out page indices
+ * to sequences, and write new tokens into their pages in place.
+ */
+array paged_attention(
+    const array& queries,
+    const array& k_pages,
+    const array& v_pages,
+    const array& page_table,
+    const array& context_lens,
+    const float scale,
+    StreamOrDevice s = {});
+
+/**
+ * Pack variable-length sequences into one ragged batch.
+ *
+ * `sequences` are arrays ragged in their first axis with matching
+ * trailing dimensions and dtype. Returns `{packed, offsets}` where
+ * `packed` concatenates the sequences along the first axis and
+ * `offsets` is an `int32` array of length `B + 1` holding each
+ * sequence's start row (and the total as its last entry). Packed
+ * activations of shape `(total_tokens, dims...)` feed ordinary GEMMs
+ * with no padding — the token axis folds into M — so only attention
+ * needs to know the boundaries (see
+ * `ragged_scaled_dot_product_attention`).
+ */
+std::vector<array> batch_merge(
+    const std::vector<array>& sequences,
+    StreamOrDevice s = {});
+
+/**
+ * Split a ragged batch made with `batch_merge` back into per-sequence
+ * arrays. `lengths` holds the first-axis length of each sequence; the
+ * returned arrays are views into `packed`.
+ */
+std::vector<array> batch_split(
+    const array& packed,
+    const std::vector<int>& lengths,
+    StreamOrDevice s = {});
+
+/**
+ * Causal attention over a ragged batch of packed sequences.
+ *
+ * `queries`, `keys` and `values` have shape
+ * `(1, n_heads, total_tokens, head_dim)` with the sequences packed along
+ * the token axis and `lengths` holding each sequence's token count.
+ * Every query attends causally within its own sequence only, enforced
+ * with a block-diagonal causal mask over the packed axis, so a
+ * continuous-batching server runs one attention call per step instead of
+ * padding to the longest request or building per-request graphs. The
+ * mask is materialized at `O(total_tokens^2)` bools; keep decode steps
+ * and prefills in separately packed batches to keep it small.
+ */
+array ragged_scaled_dot_product_attention(
+    const array& queries,
+    const array& keys,
+    const array& values,
+    const float scale,
+    const std::vector<int>& lengths,
+    StreamOrDevice s = {});
+
+/**
+ * Attention with rotary position embeddings applied to the queries and
+ * keys as they are loaded, without materializing the rotated arrays.
+ *
+ * Equivalent to `rope` with a scalar `base` applied to the keys at
+ * position offset `offset` and to the queries at `offset + kL - qL`,
+ * followed by `scaled_dot_product_attention`. `mask_mode` may be ""
+ * or "causal".
+ */
+array rope_attention(
+    const array& queries,
+    const array& keys,
+    const array& values,
+    int dims,
+    bool traditional,
+    float base,
+    float rope_scale,
+    int offset,
+    const float scale,
+    const std::string& mask_mode = "",
+    StreamOrDevice s = {});
+
+/**
+ * Matrix product of fp8-quantized operands with per-tensor scales.
+ *
+ * `a` with shape `(M, K)` and `b` with shape `(N, K)` hold fp8 bit
+ * patterns in `uint8` arrays; `b` comes pre-transposed because the fp8
+ * tensor cores require both operands K-major. `variant` selects the
+ * format, "e4m3" (default) or "e5m2". The result is
+ * `(a_scale * b_scale) * (dequant(a) @ dequant(b).T)` computed with
+ * float32 accumulation and cast to `out_dtype`.
+ */
+array scaled_matmul(
+    const array& a,
+    const array& b,
+    const array& a_scale,
+    const array& b_scale,
+    Dtype out_dtype = bfloat16,
+    const std::string& variant = "e4m3",
+    StreamOrDevice s = {});
+
+/**
+ * Fused SwiGLU MLP block: `(silu(x @ w_gate) * (x @ w_up)) @ w_down`.
+ *
+ * `w_gate` and `w_up` have shape `(D, I)` and `w_down` has shape
+ * `(I, D_out)`. On the CUDA path the gate and up projections run back to
+ * back from the same input and the activation and gating product are
+ * applied in a single elementwise pass between the GEMMs, so the block
+ * makes three memory round-trips over the hidden activations instead of
+ * five.
+ */
+array swiglu_mlp(
+    const array& x,
+    const array& w_gate,
+    const array& w_up,
+    const array& w_down,
+    StreamOrDevice s = {});
+
+/**
+ * Fused `matmul(rms_norm(x, weight, eps), w.T)`.
+ *
+ * `w` has shape `(N, K)` and comes pre-transposed because the fused kernel
+ * computes `A @ B.T` from K-major tiles. The normalized activations are
+ * never materialized: the row statistics are computed in a cheap first
+ * pass and applied to the GEMM epilogue (they are constant along the
+ * reduction), while `weight` is folded into the A-operand loads. This
+ * removes one full activation write+read per norm+projection pair.
+ */
+array rms_norm_matmul(
+    const array& x,
+    const std::optional<array>& weight,
+    const array& w,
+    float eps,
+    StreamOrDevice s = {});
+
+/**
+ * Append `values` to `cache` along `axis` without copying the existing
+ * contents when the cache's buffer has spare capacity.
+ *
+ * The result views the first `cache.shape(axis) + values.shape(axis)`
+ * entries of an over-allocated buffer. When the buffer runs out of room it
+ * is reallocated with ~1.5x slack, so growing an array one step at a time
+ * (e.g. a KV cache during decoding) costs amortized O(1) copies instead of
+ * O(sequence) per step. Rebind the cache handle to the result
+ * (`cache = append(cache, v, axis)`) so the update can be done in place.
+ */
+array append(
+    const array& cache,
+    const array& values,
+    int axis,
+    StreamOrDevice s = {});
+
+/**
+ * Computes the softmax cross-entropy loss between `logits` and integer
+ * class indices `targets` over the last axis of `logits`, i.e.
+ * `logsumexp(logits, -1) - take_along_axis(logits, targets, -1)`, in a
+ * single pass over the logits.
+ */
+array cross_entropy(
+    const array& logits,
+    const array& targets,
+    StreamOrDevice s = {});
+
+/**
+ * Computes the softmax cross-entropy loss of the projection `x @ w.T`
+ * against integer class indices `targets` without materializing the full
+ * logits. The vocabulary axis of `w` (shape `(vocab, features)`) is
+ * processed `chunk_size` rows at a time, combining per-chunk maxima and
+ * sums of exponentials like an online softmax, so peak memory scales with
+ * `chunk_size` instead of the vocabulary size.
+ */
+array linear_cross_entropy(
+    const array& x,
+    const array& w,
+    const array& targets,
+    int chunk_size = 4096,
+    StreamOrDevice s = {});
+
+/**
+ * Sample token ids from logits with temperature, top-k and top-p
+ * (nucleus) filtering, entirely on device.
+ *
+ * The logits are scaled by `1 / temperature`, softmaxed over the last
+ * axis, sorted, and truncated to the smallest set of tokens whose
+ * cumulative probability reaches `top_p` (and to the `top_k` most
+ * likely when `top_k > 0`); the draw over the surviving set uses the
+ * Gumbel-max trick so no categorical host round-trip is needed. A
+ * `temperature` of 0 is greedy argmax. Returns the sampled ids with the
+ * logits' shape minus the last axis.
+ */
+array sample_top_p(
+    const array& logits,
+    float temperature = 1.0f,
+    float top_p = 1.0f,
+    int top_k = 0,
+    const std::optional<array>& key = std::nullopt,
+    StreamOrDevice s = {});
+
+/**
+ * Greedy speculative-decoding verification: score K draft tokens against
+ * the target model's logits and compute the accepted length on device.
+ *
+ * `logits` has shape `(..., K + 1, V)` — the target model's outputs for
+ * the K draft positions plus the position after them — and
+ * `draft_tokens` has shape `(..., K)`. Returns `{num_accepted,
+ * next_token}` where `num_accepted` counts the leading draft tokens
+ * matching the target's argmax and `next_token` is the target's token at
+ * the first mismatch, or the bonus token when every draft token was
+ * accepted. Both stay on device, so the accept/reject logic costs no
+ * host round-trip per draft token; feed `next_token` back into the next
+ * step and sync at most once per verification.
+ */
+std::vector<array> speculative_verify(
+    const array& logits,
+    const array& draft_tokens,
+    StreamOrDevice s = {});
+
+/**
+ * Fused decode input stage: embedding lookup, positional add, and cast
+ * in one pass.
+ *
+ * Equivalent to `astype(take(weights, indices, 0) + positions, dtype)`
+ * where `weights` is the `(V, D)` embedding table, `indices` holds the
+ * token ids, and `positions` matches the gathered shape. The tensors
+ * involved are tiny at decode time, so the win is one dispatch instead
+ * of three on the per-token critical path. Fused on the CPU; other
+ * backends run the equivalent graph.
+ */
+array input_embedding(
+    const array& weights,
+    const array& indices,
+    const array& positions,
+    Dtype dtype,
+    StreamOrDevice s = {});
+
+/**
+ * Apply an SGD step `p - lr * g` across a whole parameter list in a few
+ * fused kernels.
+ *
+ * The parameters are grouped by dtype, each group is concatenated into
+ * one contiguous tensor, and the update runs on the fused tensors, so a
+ * step over hundreds of small arrays costs a handful of launches instead
+ * of an elementwise chain per parameter. Returns the updated parameters
+ * in the input order.
+ */
+std::vector<array> sgd_update(
+    const std::vector<array>& parameters,
+    const std::vector<array>& gradients,
+    float learning_rate,
+    StreamOrDevice s = {});
+
+/**
+ * Apply an Adam step across a whole parameter list in a few fused
+ * kernels, batching the same way as `sgd_update`.
+ *
+ * `m` and `v` are the first and second moment estimates, updated as
+ * `m = b1 m + (1 - b1) g` and `v = b2 v + (1 - b2) g^2` with the
+ * parameter update `p - lr m / (sqrt(v) + eps)`. Returns the updated
+ * parameters followed by the updated `m` and `v` lists, each in the
+ * input order.
+ */
+std::vector<array> adam_update(
+    const std::vector<array>& parameters,
+    const std::vector<array>& gradients,
+    const std::vector<array>& m,
+    const std::vector<array>& v,
+    float learning_rate,
+    float beta1 = 0.9f,
+    float beta2 = 0.999f,
+    float eps = 1e-8f,
+    StreamOrDevice s = {});
+
+/**
+ * Check a whole gradient list for overflow in a few fused kernels,
+ * batching the same way as `sgd_update`.
+ *
+ * Returns `{amax, overflow}` where `amax` is the largest absolute value
+ * across every gradient as a float32 scalar and `overflow` is a bool
+ * scalar that is true when any gradient holds an inf or nan. Both stay
+ * on device, so a loss scaler can gate the next step's update and adjust
+ * its scale in the graph instead of syncing per tensor per step.
+ */
+std::vector<array> grad_overflow(
+    const std::vector<array>& gradients,
     StreamOrDevice s = {});
 
 using TemplateArg = std::variant<int, bool, Dtype>;
@@ -76,6 +415,37 @@ CustomKernelFunction metal_kernel(
     bool ensure_row_contiguous = true,
     bool atomic_outputs = false);
 
+using PrecompiledCustomKernelFunction = std::function<std::vector<array>(
+    const std::vector<array>&,
+    const std::vector<Shape>&,
+    std::tuple<int, int, int>,
+    std::tuple<int, int, int>,
+    std::optional<float>,
+    StreamOrDevice)>;
+
+/**
+ * Compile-once variant of `metal_kernel`.
+ *
+ * The generated source, kernel name, template instantiation and Metal
+ * pipeline are built when the handle is created instead of on every call,
+ * so per-token call sites only pay for recording the op. `input_dtypes`
+ * and `input_ndims` fix the input signature up front and are checked
+ * against the arrays on each call, and the output dtypes and template
+ * arguments are bound here and cannot vary per call.
+ */
+PrecompiledCustomKernelFunction precompile_metal_kernel(
+    const std::string& name,
+    const std::vector<std::string>& input_names,
+    const std::vector<Dtype>& input_dtypes,
+    const std::vector<int>& input_ndims,
+    const std::vector<std::string>& output_names,
+    const std::vector<Dtype>& output_dtypes,
+    const std::string& source,
+    const std::string& header = "",
+    const std::vector<std::pair<std::string, TemplateArg>>& template_args = {},
+    bool ensure_row_contiguous = true,
+    bool atomic_outputs = false);
+
 CustomKernelFunction cuda_kernel(
     const std::string& name,
     const std::vector<std::string>& input_names,
@@ -205,16 +205,25 @@ class RoPE : public Custom {
 
 class ScaledDotProductAttention : public Custom {
  public:
+  // Granularity (in tokens, per axis) of the block table accepted by the
+  // "block_sparse" mask mode. A multiple of every tile size the kernels use
+  // so a KV tile never straddles two table entries.
+  static constexpr int block_mask_size = 64;
+
   explicit ScaledDotProductAttention(
       Stream stream,
       std::function<std::vector<array>(std::vector<array>)> fallback,
       float scale,
       bool do_causal,
-      bool has_sinks)
+      bool has_sinks,
+      int window = -1,
+      bool block_sparse = false)
       : Custom(stream, fallback),
         scale_(scale),
         do_causal_(do_causal),
-        has_sinks_(has_sinks) {}
+        has_sinks_(has_sinks),
+        window_(window),
+        block_sparse_(block_sparse) {}
 
   static bool use_fallback(
       const array& q,
@@ -223,6 +232,7 @@ class ScaledDotProductAttention : public Custom {
       bool has_mask,
       bool has_arr_mask,
       bool do_causal,
+      bool do_block_sparse,
       Stream s);
 
   void eval_cpu(const std::vector<array>& inputs, std::vector<array>& outputs)
@@ -241,13 +251,244 @@ class ScaledDotProductAttention : public Custom {
   DEFINE_NAME(ScaledDotProductAttention);
   DEFINE_INPUT_OUTPUT_SHAPE()
   auto state() const {
-    return std::make_tuple(nullptr, scale_, do_causal_, has_sinks_);
+    return std::make_tuple(
+        nullptr, scale_, do_causal_, has_sinks_, window_, block_sparse_);
   }
 
  private:
   float scale_;
   bool do_causal_;
   bool has_sinks_;
+  // Sliding window size in keys, or -1 when every key is visible.
+  int window_;
+  // The array mask is a block table rather than an elementwise mask.
+  bool block_sparse_;
+};
+
+class RMSNormMatmul : public Custom {
+ public:
+  explicit RMSNormMatmul(
+      Stream stream,
+      std::function<std::vector<array>(std::vector<array>)> fallback,
+      float eps)
+      : Custom(stream, fallback), eps_(eps) {}
+
+  static bool use_fallback(const array& x, const array& w, Stream s);
+
+  void eval_cpu(const std::vector<array>& inputs, std::vector<array>& outputs)
+      override {
+    throw std::runtime_error("NYI");
+  }
+
+  void eval_gpu(const std::vector<array>& inputs, std::vector<array>& outputs)
+      override {
+    eval_gpu(inputs, outputs[0]);
+  }
+
+  void eval_gpu(const std::vector<array>& inputs, array& out);
+  bool is_equivalent(const Primitive& other) const override;
+
+  DEFINE_NAME(RMSNormMatmul);
+
+ private:
+  float eps_;
+};
+
+class QuantizedSDPA : public Custom {
+ public:
+  explicit QuantizedSDPA(
+      Stream stream,
+      std::function<std::vector<array>(std::vector<array>)> fallback,
+      float scale,
+      bool do_causal,
+      int group_size,
+      int bits)
+      : Custom(stream, fallback),
+        scale_(scale),
+        do_causal_(do_causal),
+        group_size_(group_size),
+        bits_(bits) {}
+
+  static bool use_fallback(
+      const array& q,
+      const array& k,
+      int group_size,
+      int bits,
+      Stream s);
+
+  void eval_cpu(const std::vector<array>& inputs, std::vector<array>& outputs)
+      override {
+    throw std::runtime_error("NYI");
+  }
+
+  void eval_gpu(const std::vector<array>& inputs, std::vector<array>& outputs)
+      override {
+    eval_gpu(inputs, outputs[0]);
+  }
+
+  void eval_gpu(const std::vector<array>& inputs, array& out);
+  bool is_equivalent(const Primitive& other) const override;
+
+  DEFINE_NAME(QuantizedSDPA);
+  DEFINE_INPUT_OUTPUT_SHAPE()
+  auto state() const {
+    return std::make_tuple(nullptr, scale_, do_causal_, group_size_, bits_);
+  }
+
+ private:
+  float scale_;
+  bool do_causal_;
+  int group_size_;
+  int bits_;
+};
+
+class PagedAttention : public Custom {
+ public:
+  explicit PagedAttention(
+      Stream stream,
+      std::function<std::vector<array>(std::vector<array>)> fallback,
+      float scale)
+      : Custom(stream, fallback), scale_(scale) {}
+
+  static bool use_fallback(Stream s);
+
+  void eval_cpu(const std::vector<array>& inputs, std::vector<array>& outputs)
+      override {
+    throw std::runtime_error("NYI");
+  }
+
+  void eval_gpu(const std::vector<array>& inputs, std::vector<array>& outputs)
+      override {
+    eval_gpu(inputs, outputs[0]);
+  }
+
+  void eval_gpu(const std::vector<array>& inputs, array& out);
+  bool is_equivalent(const Primitive& other) const override;
+
+  DEFINE_NAME(PagedAttention);
+  DEFINE_INPUT_OUTPUT_SHAPE()
+  auto state() const {
+    return std::make_tuple(nullptr, scale_);
+  }
+
+ private:
+  float scale_;
+};
+
+class RoPEAttention : public Custom {
+ public:
+  explicit RoPEAttention(
+      Stream stream,
+      std::function<std::vector<array>(std::vector<array>)> fallback,
+      int dims,
+      bool traditional,
+      float base,
+      float rope_scale,
+      int offset,
+      float scale,
+      bool do_causal)
+      : Custom(stream, fallback),
+        dims_(dims),
+        traditional_(traditional),
+        base_(base),
+        rope_scale_(rope_scale),
+        offset_(offset),
+        scale_(scale),
+        do_causal_(do_causal) {}
+
+  static bool use_fallback(Stream s);
+
+  void eval_cpu(const std::vector<array>& inputs, std::vector<array>& outputs)
+      override {
+    throw std::runtime_error("NYI");
+  }
+
+  void eval_gpu(const std::vector<array>& inputs, std::vector<array>& outputs)
+      override {
+    eval_gpu(inputs, outputs[0]);
+  }
+
+  void eval_gpu(const std::vector<array>& inputs, array& out);
+  bool is_equivalent(const Primitive& other) const override;
+
+  DEFINE_NAME(RoPEAttention);
+  DEFINE_INPUT_OUTPUT_SHAPE()
+  auto state() const {
+    return std::make_tuple(
+        nullptr,
+        dims_,
+        traditional_,
+        base_,
+        rope_scale_,
+        offset_,
+        scale_,
+        do_causal_);
+  }
+
+ private:
+  int dims_;
+  bool traditional_;
+  float base_;
+  float rope_scale_;
+  int offset_;
+  float scale_;
+  bool do_causal_;
+};
+
+class ScaledMatmul : public Custom {
+ public:
+  explicit ScaledMatmul(
+      Stream stream,
+      std::function<std::vector<array>(std::vector<array>)> fallback,
+      Dtype out_dtype)
+      : Custom(stream, fallback), out_dtype_(out_dtype) {}
+
+  static bool use_fallback(Stream s);
+
+  void eval_cpu(const std::vector<array>& inputs, std::vector<array>& outputs)
+      override {
+    throw std::runtime_error("NYI");
+  }
+
+  void eval_gpu(const std::vector<array>& inputs, std::vector<array>& outputs)
+      override {
+    eval_gpu(inputs, outputs[0]);
+  }
+
+  void eval_gpu(const std::vector<array>& inputs, array& out);
+  bool is_equivalent(const Primitive& other) const override;
+
+  DEFINE_NAME(ScaledMatmul);
+  auto state() const {
+    return std::make_pair(nullptr, out_dtype_);
+  }
+
+ private:
+  Dtype out_dtype_;
+};
+
+class SwiGLUMLP : public Custom {
+ public:
+  explicit SwiGLUMLP(
+      Stream stream,
+      std::function<std::vector<array>(std::vector<array>)> fallback)
+      : Custom(stream, fallback) {}
+
+  static bool use_fallback(Stream s);
+
+  void eval_cpu(const std::vector<array>& inputs, std::vector<array>& outputs)
+      override {
+    throw std::runtime_error("NYI");
+  }
+
+  void eval_gpu(const std::vector<array>& inputs, std::vector<array>& outputs)
+      override {
+    eval_gpu(inputs, outputs[0]);
+  }
+
+  void eval_gpu(const std::vector<array>& inputs, array& out);
+
+  DEFINE_NAME(SwiGLUMLP);
 };
 
 class Quantize : public Custom {
@@ -286,6 +527,88 @@ class Quantize : public Custom {
   bool dequantize_;
 };
 
+class CrossEntropy : public Custom {
+ public:
+  CrossEntropy(
+      Stream stream,
+      std::function<std::vector<array>(std::vector<array>)> fallback)
+      : Custom(stream, fallback) {}
+
+  static bool use_fallback(Stream stream);
+
+  void eval_cpu(const std::vector<array>& inputs, std::vector<array>& outputs)
+      override;
+  void eval_gpu(const std::vector<array>& inputs, std::vector<array>& outputs)
+      override {
+    throw std::runtime_error("NYI");
+  }
+
+  DEFINE_NAME(CrossEntropy)
+  bool is_equivalent(const Primitive& other) const override {
+    return true;
+  }
+  std::vector<Shape> output_shapes(const std::vector<array>& inputs) override;
+  auto state() const {
+    return nullptr;
+  }
+};
+
+class LinearCrossEntropy : public Custom {
+ public:
+  LinearCrossEntropy(
+      Stream stream,
+      std::function<std::vector<array>(std::vector<array>)> fallback,
+      int chunk_size)
+      : Custom(stream, fallback), chunk_size_(chunk_size) {}
+
+  static bool use_fallback(Stream stream);
+
+  void eval_cpu(const std::vector<array>& inputs, std::vector<array>& outputs)
+      override;
+  void eval_gpu(const std::vector<array>& inputs, std::vector<array>& outputs)
+      override {
+    throw std::runtime_error("NYI");
+  }
+
+  DEFINE_NAME(LinearCrossEntropy)
+  bool is_equivalent(const Primitive& other) const override;
+  std::vector<Shape> output_shapes(const std::vector<array>& inputs) override;
+  auto state() const {
+    return chunk_size_;
+  }
+
+ private:
+  // Rows of the projection processed per step by the fallback graph; the
+  // fused kernel streams the vocabulary and ignores it.
+  int chunk_size_;
+};
+
+class InputEmbedding : public Custom {
+ public:
+  InputEmbedding(
+      Stream stream,
+      std::function<std::vector<array>(std::vector<array>)> fallback)
+      : Custom(stream, fallback) {}
+
+  static bool use_fallback(Stream stream);
+
+  void eval_cpu(const std::vector<array>& inputs, std::vector<array>& outputs)
+      override;
+  void eval_gpu(const std::vector<array>& inputs, std::vector<array>& outputs)
+      override {
+    throw std::runtime_error("NYI");
+  }
+
+  DEFINE_NAME(InputEmbedding)
+  bool is_equivalent(const Primitive& other) const override {
+    return true;
+  }
+  std::vector<Shape> output_shapes(const std::vector<array>& inputs) override;
+  auto state() const {
+    return nullptr;
+  }
+};
+
 struct CustomKernelShapeInfo {
   bool shape = false;
   bool strides = false;
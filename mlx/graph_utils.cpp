@@ -6,6 +6,7 @@
 #include <unordered_map>
 #include <unordered_set>
 
+#include "mlx/compile_impl.h"
 #include "mlx/graph_utils.h"
 #include "mlx/primitives.h"
 #include "mlx/utils.h"
@@ -102,6 +103,85 @@ void print_graph(
   }
 }
 
+GraphStats graph_stats(const std::vector<array>& outputs) {
+  GraphStats stats;
+  std::unordered_map<std::uintptr_t, size_t> depths;
+
+  auto is_matmul = [](const Primitive& p) {
+    return typeid(p) == typeid(Matmul) || typeid(p) == typeid(AddMM) ||
+        typeid(p) == typeid(BlockMaskedMM) || typeid(p) == typeid(GatherMM) ||
+        typeid(p) == typeid(SegmentedMM) ||
+        typeid(p) == typeid(QuantizedMatmul) ||
+        typeid(p) == typeid(GatherQMM);
+  };
+
+  depth_first_traversal(
+      [&](const array& x) {
+        if (!x.has_primitive()) {
+          depths[x.id()] = 0;
+          return;
+        }
+        auto& p = x.primitive();
+        stats.op_counts[p.name()]++;
+        stats.num_ops++;
+        if (typeid(p) == typeid(Contiguous)) {
+          stats.layout_copies++;
+        }
+
+        uint64_t out_size = x.size();
+        stats.bytes += x.nbytes();
+        for (auto& s : x.siblings()) {
+          out_size += s.size();
+          stats.bytes += s.nbytes();
+        }
+        for (auto& in : x.inputs()) {
+          stats.bytes += in.nbytes();
+        }
+
+        if (is_matmul(p)) {
+          uint64_t k = x.inputs()[0].shape().back();
+          stats.flops += 2 * out_size * k;
+        } else if (
+            typeid(p) == typeid(Reduce) || typeid(p) == typeid(ArgReduce)) {
+          stats.flops += x.inputs()[0].size();
+        } else if (typeid(p) == typeid(Compiled)) {
+          // Count the elementwise primitives folded into the fused kernel
+          for (auto& t : static_cast<const Compiled&>(p).tape()) {
+            if (t.has_primitive() && is_fusable(t.primitive())) {
+              stats.fused_elementwise_ops++;
+              stats.flops += out_size;
+            }
+          }
+        } else {
+          if (is_fusable(p)) {
+            stats.elementwise_ops++;
+          }
+          stats.flops += out_size;
+        }
+
+        size_t depth = 0;
+        for (auto& in : x.inputs()) {
+          if (auto it = depths.find(in.id()); it != depths.end()) {
+            depth = std::max(depth, it->second);
+          }
+        }
+        depth += 1;
+        depths[x.id()] = depth;
+        for (auto& s : x.siblings()) {
+          depths[s.id()] = depth;
+        }
+        stats.critical_path = std::max(stats.critical_path, depth);
+      },
+      outputs);
+
+  if (auto total = stats.elementwise_ops + stats.fused_elementwise_ops;
+      total > 0) {
+    stats.fusion_coverage =
+        static_cast<double>(stats.fused_elementwise_ops) / total;
+  }
+  return stats;
+}
+
 void export_to_dot(
     std::ostream& os,
     NodeNamer namer,
@@ -39,6 +39,37 @@ print_graph(std::ostream& os, NodeNamer namer, Arrays&&... outputs) {
       std::vector<array>{std::forward<Arrays>(outputs)...});
 }
 
+/* Quantitative summary of a graph.
+ *
+ * FLOPs are estimated: matmul-family primitives count two ops per
+ * output element per inner dimension, reductions count one op per
+ * reduced element, and everything else counts one op per output
+ * element. Bytes are the input and output bytes of every node. Fusion
+ * coverage is the fraction of elementwise primitives that ended up
+ * inside Compiled nodes, so a compiled model can assert in CI that it
+ * stays above a floor. Layout copies count the Contiguous nodes — copies
+ * made only to repair a layout; copies a backend inserts at eval time
+ * for strided inputs are not graph nodes and are not visible here.
+ * */
+struct GraphStats {
+  std::unordered_map<std::string, size_t> op_counts;
+  size_t num_ops{0};
+  uint64_t flops{0};
+  uint64_t bytes{0};
+  size_t elementwise_ops{0};
+  size_t fused_elementwise_ops{0};
+  double fusion_coverage{1.0};
+  size_t layout_copies{0};
+  size_t critical_path{0};
+};
+
+GraphStats graph_stats(const std::vector<array>& outputs);
+
+template <typename... Arrays, typename = enable_for_arrays_t<Arrays...>>
+inline GraphStats graph_stats(Arrays&&... outputs) {
+  return graph_stats(std::vector<array>{std::forward<Arrays>(outputs)...});
+}
+
 void export_to_dot(
     std::ostream& os,
     NodeNamer namer,
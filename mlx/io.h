@@ -32,6 +32,26 @@ array load(std::shared_ptr<io::Reader> in_stream, StreamOrDevice s = {});
 /** Load array from file in .npy format */
 array load(std::string file, StreamOrDevice s = {});
 
+/** Save array to out stream in the compressed .npy-style format */
+void save_compressed(std::shared_ptr<io::Writer> out_stream, array a);
+
+/** Save array to file in the compressed .npy-style format.
+ *
+ * The tensor bytes are split into fixed size frames and each frame is
+ * compressed independently (an LZ4-style block codec) on the io thread
+ * pool. Incompressible frames are stored raw, so the file is never
+ * materially larger than the .npy it replaces.
+ */
+void save_compressed(std::string file, array a);
+
+/** Lazily load an array saved with save_compressed.
+ *
+ * The array is backed by the usual Load primitive; at eval time the
+ * frames covering the read are fetched and decompressed in parallel,
+ * overlapping disk reads with decompression.
+ */
+array load_compressed(std::string file, StreamOrDevice s = {});
+
 /** Load array map from .safetensors file format */
 SafetensorsLoad load_safetensors(
     std::shared_ptr<io::Reader> in_stream,
@@ -40,6 +60,17 @@ SafetensorsLoad load_safetensors(
     const std::string& file,
     StreamOrDevice s = {});
 
+/** Load a sharded checkpoint from a ``*.index.json`` file.
+ *
+ * The index maps tensor names to shard files next to it (the safetensors
+ * multi-file convention). Shards are opened concurrently and spread over a
+ * small pool of CPU streams so their reads overlap when the arrays are
+ * evaluated. ``load_safetensors`` routes index files here automatically.
+ */
+SafetensorsLoad load_safetensors_sharded(
+    const std::string& index_file,
+    StreamOrDevice s = {});
+
 void save_safetensors(
     std::shared_ptr<io::Writer> in_stream,
     std::unordered_map<std::string, array>,
@@ -49,10 +80,62 @@ void save_safetensors(
     std::unordered_map<std::string, array>,
     std::unordered_map<std::string, std::string> metadata = {});
 
+/** Save an array map without materializing every tensor at once.
+ *
+ * The header is written from the lazily known shapes and dtypes, then
+ * tensors are evaluated and flushed one at a time with each buffer
+ * released as soon as its bytes are written. When the map is moved in
+ * and the caller keeps no other references, peak save memory is the
+ * largest tensor instead of the sum of all of them.
+ */
+void save_safetensors_streaming(
+    std::shared_ptr<io::Writer> out_stream,
+    std::unordered_map<std::string, array> a,
+    std::unordered_map<std::string, std::string> metadata = {});
+void save_safetensors_streaming(
+    std::string file,
+    std::unordered_map<std::string, array> a,
+    std::unordered_map<std::string, std::string> metadata = {});
+
+/** Save only the chunks of each tensor that changed since a previous
+ * save.
+ *
+ * Tensors are hashed in fixed chunks against ``base_file`` (an ordinary
+ * .safetensors save or a previous incremental one) and only the changed
+ * chunks are written, along with a manifest carrying every chunk hash.
+ * Steady-state checkpoint I/O then scales with the actual change rate
+ * instead of the state size. Files get a .delta.safetensors suffix and
+ * ``load_safetensors`` routes them here automatically.
+ */
+void save_safetensors_incremental(
+    std::string file,
+    const std::string& base_file,
+    std::unordered_map<std::string, array> a,
+    std::unordered_map<std::string, std::string> metadata = {});
+
+/** Reconstruct a checkpoint written by save_safetensors_incremental,
+ * verifying every chunk against the manifest checksums. */
+SafetensorsLoad load_safetensors_incremental(
+    const std::string& file,
+    StreamOrDevice s = {});
+
 /** Load array map and metadata from .gguf file format */
 
 GGUFLoad load_gguf(const std::string& file, StreamOrDevice s = {});
 
+/** Load only the tensors whose on-disk names match a pattern.
+ *
+ * Patterns are matched with '*' wildcards against the GGUF tensor
+ * names; a pattern without a star must match exactly. The tensor index
+ * is walked without touching any weight bytes, so inspecting a couple
+ * of tensors out of a large checkpoint costs their extents rather than
+ * the whole file. An empty pattern list returns the metadata alone.
+ */
+GGUFLoad load_gguf(
+    const std::string& file,
+    const std::vector<std::string>& patterns,
+    StreamOrDevice s = {});
+
 void save_gguf(
     std::string file,
     std::unordered_map<std::string, array> array_map,
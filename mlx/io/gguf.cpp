@@ -204,7 +204,41 @@ std::unordered_map<std::string, GGUFMetaData> load_metadata(gguf_ctx* ctx) {
   return metadata;
 }
 
-std::unordered_map<std::string, array> load_arrays(gguf_ctx* ctx) {
+// Glob-style name match with '*' wildcards; a pattern without a star
+// must match exactly
+bool gguf_name_matches(
+    const char* name,
+    size_t len,
+    const std::string& pattern) {
+  size_t n = 0;
+  size_t p = 0;
+  size_t star = std::string::npos;
+  size_t mark = 0;
+  while (n < len) {
+    if (p < pattern.size() && pattern[p] == '*') {
+      star = p++;
+      mark = n;
+    } else if (p < pattern.size() && pattern[p] == name[n]) {
+      n++;
+      p++;
+    } else if (star != std::string::npos) {
+      p = star + 1;
+      n = ++mark;
+    } else {
+      return false;
+    }
+  }
+  while (p < pattern.size() && pattern[p] == '*') {
+    p++;
+  }
+  return p == pattern.size();
+}
+
+std::unordered_map<std::string, array> load_arrays(
+    gguf_ctx* ctx,
+    const std::string& file,
+    StreamOrDevice s,
+    const std::vector<std::string>* patterns = nullptr) {
   std::unordered_map<std::string, array> array_map;
   gguf_tensor tensor;
 
@@ -217,21 +251,75 @@ std::unordered_map<std::string, array> load_arrays(gguf_ctx* ctx) {
     }
   };
 
+  // Tensors materialize lazily: plain dtypes load straight from the file
+  // and quantized tensors decode from a lazy load of their raw blocks on
+  // first use, so returning from load_gguf is O(metadata)
+  bool lazy = env::lazy_gguf();
+  auto stream = to_stream(s, Device::cpu);
+  if (stream.device != Device::cpu) {
+    throw std::runtime_error("[load_gguf] Must run on a CPU stream.");
+  }
+  std::shared_ptr<io::Reader> reader;
+
+  // Walking the tensor index costs only the header entries; filtered
+  // tensors are skipped before any of their bytes are touched
+  auto matches = [&patterns](const gguf_tensor& t) {
+    if (patterns == nullptr) {
+      return true;
+    }
+    for (auto& pattern : *patterns) {
+      if (gguf_name_matches(t.name, t.namelen, pattern)) {
+        return true;
+      }
+    }
+    return false;
+  };
+
   while (gguf_get_tensor(ctx, &tensor)) {
+    if (!matches(tensor)) {
+      continue;
+    }
+    auto offset = static_cast<size_t>(
+        reinterpret_cast<const char*>(tensor.weights_data) -
+        reinterpret_cast<const char*>(ctx->data));
     if (tensor.type == GGUF_TYPE_Q4_0 || tensor.type == GGUF_TYPE_Q4_1 ||
         tensor.type == GGUF_TYPE_Q8_0) {
-      gguf_load_quantized(array_map, tensor);
+      if (lazy) {
+        if (!reader) {
+          reader = std::make_shared<io::ParallelFileReader>(file);
+        }
+        gguf_load_quantized_lazy(array_map, tensor, reader, offset, stream);
+      } else {
+        gguf_load_quantized(array_map, tensor);
+      }
     } else {
       std::string name(tensor.name, tensor.namelen);
-      const auto& [data, dtype] = extract_tensor_data(&tensor);
-      array loaded_array = array(data, get_shape(tensor), dtype);
-      check_insert(array_map.insert({name, loaded_array}));
+      if (auto dtype = gguf_type_to_dtype(tensor.type); lazy && dtype) {
+        if (!reader) {
+          reader = std::make_shared<io::ParallelFileReader>(file);
+        }
+        array loaded_array(
+            get_shape(tensor),
+            *dtype,
+            std::make_shared<Load>(
+                stream, reader, offset, /* swap_endianness = */ false),
+            {});
+        check_insert(array_map.insert({name, loaded_array}));
+      } else {
+        // Types without an MLX equivalent convert eagerly to float16
+        const auto& [data, converted] = extract_tensor_data(&tensor);
+        array loaded_array = array(data, get_shape(tensor), converted);
+        check_insert(array_map.insert({name, loaded_array}));
+      }
     }
   }
   return array_map;
 }
 
-GGUFLoad load_gguf(const std::string& file, StreamOrDevice s) {
+GGUFLoad load_gguf_impl(
+    const std::string& file,
+    const std::vector<std::string>* patterns,
+    StreamOrDevice s) {
   bool exists;
   {
     std::ifstream f(file.c_str());
@@ -247,10 +335,21 @@ GGUFLoad load_gguf(const std::string& file, StreamOrDevice s) {
     throw std::runtime_error("[load_gguf] gguf_init failed");
   }
   auto metadata = load_metadata(ctx.get());
-  auto arrays = load_arrays(ctx.get());
+  auto arrays = load_arrays(ctx.get(), file, s, patterns);
   return {arrays, metadata};
 }
 
+GGUFLoad load_gguf(const std::string& file, StreamOrDevice s) {
+  return load_gguf_impl(file, nullptr, s);
+}
+
+GGUFLoad load_gguf(
+    const std::string& file,
+    const std::vector<std::string>& patterns,
+    StreamOrDevice s) {
+  return load_gguf_impl(file, &patterns, s);
+}
+
 void append_kv_array(
     gguf_ctx* ctx,
     const std::string& key,
@@ -2,6 +2,7 @@
 #pragma once
 
 #include "mlx/io.h"
+#include "mlx/io/load.h"
 #include "mlx/primitives.h"
 #include "mlx/transforms.h"
 #include "mlx/utils.h"
@@ -17,4 +18,14 @@ void gguf_load_quantized(
     std::unordered_map<std::string, array>& a,
     const gguf_tensor& tensor);
 
+// Lazy variant: builds the dequantization graph over a load of the raw
+// tensor blocks at `offset` in the file, so the tensor decodes into the
+// packed quantized representation on first use.
+void gguf_load_quantized_lazy(
+    std::unordered_map<std::string, array>& a,
+    const gguf_tensor& tensor,
+    const std::shared_ptr<io::Reader>& reader,
+    size_t offset,
+    Stream stream);
+
 } // namespace mlx::core
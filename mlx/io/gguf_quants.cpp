@@ -5,6 +5,7 @@
 #include <numeric>
 
 #include "mlx/io/gguf.h"
+#include "mlx/ops.h"
 
 namespace mlx::core {
 
@@ -161,4 +162,117 @@ void gguf_load_quantized(
   check_insert(a.emplace(name_prefix + ".biases", std::move(biases)));
 }
 
+// The lazy equivalent of unpack_32_4: the first 16 weights of a block sit
+// in the low nibbles of its data bytes and the next 16 in the high
+// nibbles, packed back into bytes pairwise
+array unpack_32_4_lazy(const array& data, Stream s) {
+  auto nb = data.shape(0);
+  auto n = data.shape(1);
+  auto even = slice(data, {0, 0}, {nb, n}, {1, 2}, s);
+  auto odd = slice(data, {0, 1}, {nb, n}, {1, 2}, s);
+  auto lo = bitwise_or(
+      bitwise_and(even, array(0x0F, uint8), s),
+      left_shift(bitwise_and(odd, array(0x0F, uint8), s), array(4, uint8), s),
+      s);
+  auto hi = bitwise_or(
+      right_shift(even, array(4, uint8), s),
+      bitwise_and(odd, array(0xF0, uint8), s),
+      s);
+  return concatenate({lo, hi}, /* axis = */ 1, s);
+}
+
+void gguf_load_quantized_lazy(
+    std::unordered_map<std::string, array>& a,
+    const gguf_tensor& tensor,
+    const std::shared_ptr<io::Reader>& reader,
+    size_t offset,
+    Stream stream) {
+  uint64_t weights_per_byte;
+  uint64_t bytes_per_block;
+  if (tensor.type == GGUF_TYPE_Q4_0) {
+    weights_per_byte = 2;
+    bytes_per_block = 18; // 2 bytes scale, 32x0.5 byte weights
+  } else if (tensor.type == GGUF_TYPE_Q4_1) {
+    weights_per_byte = 2;
+    bytes_per_block = 20; // 2 bytes scale, 2 bytes bias, 32x0.5 byte weights
+  } else { // tensor.type == GGUF_TYPE_Q8_0
+    weights_per_byte = 1;
+    bytes_per_block = 34; // 2 bytes scale, 32x1 byte weights
+  }
+
+  std::string name(tensor.name, tensor.namelen);
+
+  auto shape = get_shape(tensor);
+  const uint64_t weights_per_block = 32;
+  if (shape[shape.size() - 1] % weights_per_block != 0) {
+    std::ostringstream msg;
+    msg << "[load_gguf] tensor " << name
+        << "has incompatible last dim shape: " << shape[shape.size() - 1];
+    throw std::runtime_error(msg.str());
+  }
+  auto nblocks =
+      static_cast<ShapeElem>(tensor.num_weights / weights_per_block);
+
+  // One lazy load of the raw blocks; the packed weights, scales and biases
+  // below all decode from it on first use
+  array raw(
+      Shape{nblocks, static_cast<ShapeElem>(bytes_per_block)},
+      uint8,
+      std::make_shared<Load>(stream, reader, offset, /* swap_endianness = */ false),
+      {});
+
+  auto weights_shape = shape;
+  weights_shape.back() /= (weights_per_byte * 4);
+  auto sb_shape = shape;
+  sb_shape.back() /= weights_per_block;
+
+  array scales = reshape(
+      view(slice(raw, {0, 0}, {nblocks, 2}, stream), float16, stream),
+      Shape(sb_shape),
+      stream);
+  array biases(0.0, float16);
+  ShapeElem data_start;
+  if (tensor.type == GGUF_TYPE_Q4_0) {
+    biases = multiply(scales, array(-8, float16), stream);
+    data_start = 2;
+  } else if (tensor.type == GGUF_TYPE_Q4_1) {
+    biases = reshape(
+        view(slice(raw, {0, 2}, {nblocks, 4}, stream), float16, stream),
+        Shape(sb_shape),
+        stream);
+    data_start = 4;
+  } else {
+    biases = multiply(scales, array(-128, float16), stream);
+    data_start = 2;
+  }
+
+  auto data = slice(
+      raw,
+      {0, data_start},
+      {nblocks, static_cast<ShapeElem>(bytes_per_block)},
+      stream);
+  array packed = (weights_per_byte == 2)
+      ? unpack_32_4_lazy(data, stream)
+      // Q8 weights are int8 with the sign bit flipped to recenter them
+      : bitwise_xor(data, array(0x80, uint8), stream);
+  array weights =
+      reshape(view(packed, uint32, stream), Shape(weights_shape), stream);
+
+  auto check_insert = [](const auto& inserted) {
+    if (!inserted.second) {
+      std::ostringstream msg;
+      msg << "[load_gguf] Duplicate parameter name " << inserted.first->second
+          << " this can happend when loading quantized tensors.";
+      throw std::runtime_error(msg.str());
+    }
+  };
+
+  a.emplace(name, std::move(weights));
+  constexpr std::string_view weight_suffix = ".weight";
+  const std::string name_prefix =
+      name.substr(0, name.length() - weight_suffix.length());
+  check_insert(a.emplace(name_prefix + ".scales", std::move(scales)));
+  check_insert(a.emplace(name_prefix + ".biases", std::move(biases)));
+}
+
 } // namespace mlx::core
@@ -1,9 +1,15 @@
 // Copyright © 2023-2024 Apple Inc.
 #include <algorithm>
+#include <cctype>
+#include <cstdlib>
 #include <cstring>
+#include <deque>
 #include <fstream>
 #include <limits>
+#include <mutex>
 #include <sstream>
+#include <thread>
+#include <unordered_map>
 
 // Used by pread implementation.
 #ifdef _WIN32
@@ -11,11 +17,16 @@
 #define NOMINMAX
 #endif
 #include <windows.h>
+#else
+// Used by the http range reader.
+#include <netdb.h>
+#include <sys/socket.h>
 #endif // _WIN32
 
 #include "mlx/io/load.h"
 #include "mlx/ops.h"
 #include "mlx/primitives.h"
+#include "mlx/transforms.h"
 #include "mlx/utils.h"
 
 // Adapted from
@@ -131,6 +142,183 @@ int64_t pread(int fd, void* buf, uint64_t size, uint64_t offset) {
 }
 #endif
 
+// Minimal LZ4-style block codec for the compressed checkpoint format:
+// greedy matching against a small hash table, 16 bit match offsets and
+// the token / length encoding of the LZ4 block spec. compress returns 0
+// when the input does not fit in `cap` so callers can store the frame
+// raw instead.
+namespace lz4 {
+
+constexpr size_t min_match = 4;
+// A match may not start in the last 12 bytes and always leaves at least
+// 5 trailing literals, which keeps the 4 byte loads below in bounds
+constexpr size_t mf_limit = 12;
+constexpr size_t last_literals = 5;
+
+inline uint32_t read32(const uint8_t* p) {
+  uint32_t v;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline uint32_t hash(uint32_t v) {
+  return (v * 2654435761u) >> 19;
+}
+
+size_t compress(const uint8_t* src, size_t n, uint8_t* dst, size_t cap) {
+  // Positions are stored + 1 so 0 means empty
+  std::vector<uint32_t> table(1 << 13, 0);
+  const uint8_t* ip = src;
+  const uint8_t* anchor = src;
+  const uint8_t* const iend = src + n;
+  uint8_t* op = dst;
+  uint8_t* const oend = dst + cap;
+
+  auto put_len = [&](size_t len) {
+    while (len >= 255) {
+      *op++ = 255;
+      len -= 255;
+    }
+    *op++ = static_cast<uint8_t>(len);
+  };
+
+  if (n > mf_limit) {
+    const uint8_t* const mflimit = iend - mf_limit;
+    const uint8_t* const mend = iend - last_literals;
+    while (ip < mflimit) {
+      uint32_t h = hash(read32(ip));
+      uint32_t cand = table[h];
+      table[h] = static_cast<uint32_t>(ip - src) + 1;
+      if (cand == 0) {
+        ip++;
+        continue;
+      }
+      const uint8_t* match = src + (cand - 1);
+      if (ip - match > 0xFFFF || read32(match) != read32(ip)) {
+        ip++;
+        continue;
+      }
+      size_t mlen = min_match;
+      while (ip + mlen < mend && ip[mlen] == match[mlen]) {
+        mlen++;
+      }
+      size_t lit = ip - anchor;
+      size_t ml = mlen - min_match;
+      if (op + lit + lit / 255 + ml / 255 + 8 > oend) {
+        return 0;
+      }
+      uint8_t* token = op++;
+      if (lit < 15) {
+        *token = static_cast<uint8_t>(lit << 4);
+      } else {
+        *token = 0xF0;
+        put_len(lit - 15);
+      }
+      std::memcpy(op, anchor, lit);
+      op += lit;
+      uint16_t off = static_cast<uint16_t>(ip - match);
+      std::memcpy(op, &off, 2);
+      op += 2;
+      if (ml < 15) {
+        *token |= static_cast<uint8_t>(ml);
+      } else {
+        *token |= 0x0F;
+        put_len(ml - 15);
+      }
+      ip += mlen;
+      anchor = ip;
+    }
+  }
+
+  // The block ends with a bare literal run
+  size_t lit = iend - anchor;
+  if (op + lit + lit / 255 + 2 > oend) {
+    return 0;
+  }
+  uint8_t* token = op++;
+  if (lit < 15) {
+    *token = static_cast<uint8_t>(lit << 4);
+  } else {
+    *token = 0xF0;
+    put_len(lit - 15);
+  }
+  std::memcpy(op, anchor, lit);
+  op += lit;
+  return op - dst;
+}
+
+size_t decompress(const uint8_t* src, size_t n, uint8_t* dst, size_t cap) {
+  const uint8_t* ip = src;
+  const uint8_t* const iend = src + n;
+  uint8_t* op = dst;
+  uint8_t* const oend = dst + cap;
+
+  auto get_len = [&](size_t len) -> size_t {
+    uint8_t b;
+    do {
+      if (ip == iend) {
+        return SIZE_MAX;
+      }
+      b = *ip++;
+      len += b;
+    } while (b == 255);
+    return len;
+  };
+
+  while (ip < iend) {
+    uint8_t token = *ip++;
+    size_t lit = token >> 4;
+    if (lit == 15 && (lit = get_len(lit)) == SIZE_MAX) {
+      return 0;
+    }
+    if (lit > static_cast<size_t>(iend - ip) ||
+        lit > static_cast<size_t>(oend - op)) {
+      return 0;
+    }
+    std::memcpy(op, ip, lit);
+    op += lit;
+    ip += lit;
+    if (ip == iend) {
+      // The last sequence is bare literals
+      break;
+    }
+    if (iend - ip < 2) {
+      return 0;
+    }
+    uint16_t off;
+    std::memcpy(&off, ip, 2);
+    ip += 2;
+    if (off == 0 || off > static_cast<size_t>(op - dst)) {
+      return 0;
+    }
+    size_t mlen = token & 0x0F;
+    if (mlen == 15 && (mlen = get_len(mlen)) == SIZE_MAX) {
+      return 0;
+    }
+    mlen += min_match;
+    if (mlen > static_cast<size_t>(oend - op)) {
+      return 0;
+    }
+    // Byte-wise so overlapping matches replicate correctly
+    const uint8_t* m = op - off;
+    for (size_t i = 0; i < mlen; ++i) {
+      op[i] = m[i];
+    }
+    op += mlen;
+  }
+  return op - dst;
+}
+
+} // namespace lz4
+
+// Compressed checkpoint container: magic and version, the array
+// protocol typestring and shape, the raw byte and frame sizes, the
+// compressed frames back to back and their sizes as a footer
+constexpr uint8_t
+    COMPRESSED_MAGIC[] = {0x93, 0x4d, 0x4c, 0x58, 0x43, 0x4d, 0x50};
+constexpr uint8_t COMPRESSED_VERSION = 1;
+constexpr size_t COMPRESSED_FRAME_RAW = 1 << 22;
+
 } // namespace
 
 /** Save array to out stream in .npy format */
@@ -210,6 +398,12 @@ void save(std::shared_ptr<io::Writer> out_stream, array a) {
 
 /** Save array to file in .npy format */
 void save(std::string file, array a) {
+  // Registered scheme writers stream straight to the store
+  if (auto writer = io::writer_for(file)) {
+    save(std::move(writer), a);
+    return;
+  }
+
   // Add .npy to file name if it is not there
   if (file.length() < 4 || file.substr(file.length() - 4, 4) != ".npy")
     file += ".npy";
@@ -325,21 +519,612 @@ array load(std::shared_ptr<io::Reader> in_stream, StreamOrDevice s) {
 
 /** Load array from file in .npy format */
 array load(std::string file, StreamOrDevice s) {
+  // Registered scheme readers stream straight from the store
+  if (auto reader = io::reader_for(file)) {
+    return load(std::move(reader), s);
+  }
   return load(std::make_shared<io::ParallelFileReader>(std::move(file)), s);
 }
 
+/** Save array to out stream in the compressed .npy-style format */
+void save_compressed(std::shared_ptr<io::Writer> out_stream, array a) {
+  ////////////////////////////////////////////////////////
+  // Check array
+
+  // Force a row major layout so the payload is the flattened tensor
+  a = contiguous(a);
+  a.eval();
+
+  if (a.nbytes() == 0) {
+    throw std::invalid_argument(
+        "[save_compressed] cannot serialize an empty array");
+  }
+
+  ////////////////////////////////////////////////////////
+  // Check file
+  if (!out_stream->good() || !out_stream->is_open()) {
+    throw std::runtime_error(
+        "[save_compressed] Failed to open " + out_stream->label());
+  }
+
+  ////////////////////////////////////////////////////////
+  // Prepare header
+  auto descr = dtype_to_array_protocol(a.dtype());
+
+  std::ostringstream header;
+  header.write(reinterpret_cast<const char*>(COMPRESSED_MAGIC), 7);
+  header.put(static_cast<char>(COMPRESSED_VERSION));
+  header.put(static_cast<char>(descr.length()));
+  header.write(descr.c_str(), descr.length());
+  uint32_t ndim = a.ndim();
+  header.write(reinterpret_cast<const char*>(&ndim), sizeof(ndim));
+  for (auto dim : a.shape()) {
+    header.write(reinterpret_cast<const char*>(&dim), sizeof(dim));
+  }
+  uint64_t raw_bytes = a.nbytes();
+  uint64_t frame_raw = COMPRESSED_FRAME_RAW;
+  header.write(reinterpret_cast<const char*>(&raw_bytes), sizeof(raw_bytes));
+  header.write(reinterpret_cast<const char*>(&frame_raw), sizeof(frame_raw));
+  out_stream->write(header.str().c_str(), header.str().length());
+
+  ////////////////////////////////////////////////////////
+  // Serialize array
+
+  // Compress a few frames ahead on the io thread pool and write them in
+  // order as they complete, overlapping compression with the disk
+  // writes. Frames the codec cannot shrink are stored raw, marked in
+  // the footer by a compressed size equal to their raw size.
+  size_t nframes = (raw_bytes + frame_raw - 1) / frame_raw;
+  const uint8_t* data = a.data<uint8_t>();
+  std::vector<uint64_t> comp_sizes(nframes);
+  std::deque<std::future<std::vector<uint8_t>>> inflight;
+  constexpr size_t depth = 8;
+  size_t next = 0;
+  for (size_t f = 0; f < nframes; ++f) {
+    while (inflight.size() < depth && next < nframes) {
+      inflight.push_back(io::thread_pool().enqueue(
+          [data, raw_bytes, frame_raw](size_t f) {
+            size_t start = f * frame_raw;
+            size_t n = std::min<size_t>(frame_raw, raw_bytes - start);
+            std::vector<uint8_t> out(n);
+            // Cap at n - 1 so a full size frame always means stored
+            if (auto m = lz4::compress(data + start, n, out.data(), n - 1)) {
+              out.resize(m);
+            } else {
+              std::memcpy(out.data(), data + start, n);
+            }
+            return out;
+          },
+          next++));
+    }
+    auto frame = inflight.front().get();
+    inflight.pop_front();
+    comp_sizes[f] = frame.size();
+    out_stream->write(
+        reinterpret_cast<const char*>(frame.data()), frame.size());
+  }
+  out_stream->write(
+      reinterpret_cast<const char*>(comp_sizes.data()),
+      nframes * sizeof(uint64_t));
+}
+
+/** Save array to file in the compressed .npy-style format */
+void save_compressed(std::string file, array a) {
+  // Add .mxz to file name if it is not there
+  if (file.length() < 4 || file.substr(file.length() - 4, 4) != ".mxz")
+    file += ".mxz";
+
+  // Serialize array
+  save_compressed(std::make_shared<io::FileWriter>(std::move(file)), a);
+}
+
+/** Lazily load an array saved with save_compressed */
+array load_compressed(std::string file, StreamOrDevice s) {
+  auto stream = to_stream(s, Device::cpu);
+  if (stream.device != Device::cpu) {
+    throw std::runtime_error("[load_compressed] Must run on a CPU stream.");
+  }
+  // The reader parses the container and presents the uncompressed
+  // payload, so the usual Load primitive reads through it unchanged
+  auto reader = std::make_shared<io::CompressedFileReader>(std::move(file));
+  return array(
+      reader->shape(),
+      reader->dtype(),
+      std::make_shared<Load>(stream, reader, /* offset = */ 0, false),
+      std::vector<array>{});
+}
+
 namespace io {
 
 ThreadPool& thread_pool() {
-  static ThreadPool pool_{4};
+  static ThreadPool pool_{4, {}, /* max_queue = */ 16};
   return pool_;
 }
 
 ThreadPool& ParallelFileReader::thread_pool() {
-  static ThreadPool thread_pool{4};
+  static ThreadPool thread_pool{4, {}, /* max_queue = */ 16};
+  return thread_pool;
+}
+
+namespace {
+
+std::string uri_scheme(const std::string& uri) {
+  auto pos = uri.find("://");
+  return (pos == std::string::npos || pos == 0) ? "" : uri.substr(0, pos);
+}
+
+std::mutex& registry_mutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::unordered_map<std::string, ReaderFactory>& reader_registry() {
+  static std::unordered_map<std::string, ReaderFactory> registry = {
+#if !defined(_WIN32)
+      {"http",
+       [](const std::string& uri) -> std::shared_ptr<Reader> {
+         return std::make_shared<HttpFileReader>(uri);
+       }},
+#endif
+  };
+  return registry;
+}
+
+std::unordered_map<std::string, WriterFactory>& writer_registry() {
+  static std::unordered_map<std::string, WriterFactory> registry;
+  return registry;
+}
+
+} // namespace
+
+void register_reader(const std::string& scheme, ReaderFactory factory) {
+  std::lock_guard<std::mutex> lock(registry_mutex());
+  reader_registry()[scheme] = std::move(factory);
+}
+
+void register_writer(const std::string& scheme, WriterFactory factory) {
+  std::lock_guard<std::mutex> lock(registry_mutex());
+  writer_registry()[scheme] = std::move(factory);
+}
+
+std::shared_ptr<Reader> reader_for(const std::string& uri) {
+  auto scheme = uri_scheme(uri);
+  if (scheme.empty()) {
+    return nullptr;
+  }
+  ReaderFactory factory;
+  {
+    std::lock_guard<std::mutex> lock(registry_mutex());
+    auto it = reader_registry().find(scheme);
+    if (it == reader_registry().end()) {
+      return nullptr;
+    }
+    factory = it->second;
+  }
+  return factory(uri);
+}
+
+std::shared_ptr<Writer> writer_for(const std::string& uri) {
+  auto scheme = uri_scheme(uri);
+  if (scheme.empty()) {
+    return nullptr;
+  }
+  WriterFactory factory;
+  {
+    std::lock_guard<std::mutex> lock(registry_mutex());
+    auto it = writer_registry().find(scheme);
+    if (it == writer_registry().end()) {
+      return nullptr;
+    }
+    factory = it->second;
+  }
+  return factory(uri);
+}
+
+#if !defined(_WIN32)
+
+ThreadPool& HttpFileReader::thread_pool() {
+  // Enough connections in flight to fill the NIC on an object store
+  static ThreadPool thread_pool{8, {}, /* max_queue = */ 32};
   return thread_pool;
 }
 
+HttpFileReader::HttpFileReader(const std::string& uri) : label_(uri) {
+  // http://host[:port]/path
+  auto pos = uri.find("://");
+  if (pos == std::string::npos) {
+    return;
+  }
+  auto rest = uri.substr(pos + 3);
+  auto slash = rest.find('/');
+  auto hostport = rest.substr(0, slash);
+  target_ = slash == std::string::npos ? "/" : rest.substr(slash);
+  if (auto colon = hostport.find(':'); colon != std::string::npos) {
+    host_ = hostport.substr(0, colon);
+    port_ = hostport.substr(colon + 1);
+  } else {
+    host_ = hostport;
+    port_ = "80";
+  }
+  if (host_.empty()) {
+    return;
+  }
+
+  // A one byte ranged GET resolves the object size; HEAD is not always
+  // allowed on object store URLs
+  char byte;
+  std::string head;
+  if (!fetch_range(0, 1, &byte, &head)) {
+    return;
+  }
+  std::transform(head.begin(), head.end(), head.begin(), [](unsigned char c) {
+    return std::tolower(c);
+  });
+  if (auto p = head.find("content-range:"); p != std::string::npos) {
+    // Content-Range: bytes 0-0/SIZE
+    if (auto sl = head.find('/', p); sl != std::string::npos) {
+      size_ = std::strtoull(head.c_str() + sl + 1, nullptr, 10);
+    }
+  } else if (auto q = head.find("content-length:"); q != std::string::npos) {
+    // The server ignored the range and replied with the whole object
+    size_ = std::strtoull(head.c_str() + q + 15, nullptr, 10);
+  }
+  good_ = size_ > 0;
+}
+
+int HttpFileReader::connect_socket() const {
+  addrinfo hints{};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  addrinfo* res = nullptr;
+  if (getaddrinfo(host_.c_str(), port_.c_str(), &hints, &res) != 0) {
+    return -1;
+  }
+  int fd = -1;
+  for (auto* p = res; p != nullptr; p = p->ai_next) {
+    fd = socket(p->ai_family, p->ai_socktype, p->ai_protocol);
+    if (fd < 0) {
+      continue;
+    }
+    if (::connect(fd, p->ai_addr, p->ai_addrlen) == 0) {
+      break;
+    }
+    close(fd);
+    fd = -1;
+  }
+  freeaddrinfo(res);
+  return fd;
+}
+
+bool HttpFileReader::fetch_range(
+    size_t offset,
+    size_t n,
+    char* dst,
+    std::string* head_out) const {
+  int fd = connect_socket();
+  if (fd < 0) {
+    return false;
+  }
+  std::ostringstream request;
+  request << "GET " << target_ << " HTTP/1.1\r\n"
+          << "Host: " << host_ << "\r\n"
+          << "Range: bytes=" << offset << "-" << offset + n - 1 << "\r\n"
+          << "Connection: close\r\n\r\n";
+  auto r = request.str();
+  const char* p = r.c_str();
+  size_t left = r.size();
+  while (left != 0) {
+    auto m = ::write(fd, p, left);
+    if (m <= 0) {
+      close(fd);
+      return false;
+    }
+    p += m;
+    left -= m;
+  }
+
+  // Read up to the end of the header block
+  std::string head;
+  size_t body_start = 0;
+  char buf[4096];
+  for (;;) {
+    auto m = ::read(fd, buf, sizeof(buf));
+    if (m <= 0) {
+      close(fd);
+      return false;
+    }
+    head.append(buf, m);
+    if (auto e = head.find("\r\n\r\n"); e != std::string::npos) {
+      body_start = e + 4;
+      break;
+    }
+    if (head.size() > (1 << 16)) {
+      close(fd);
+      return false;
+    }
+  }
+  auto sp = head.find(' ');
+  int status = sp == std::string::npos ? 0 : std::atoi(head.c_str() + sp + 1);
+  // A 200 body starts at the beginning of the object, so it only serves
+  // a range starting there
+  if (status != 206 && (status != 200 || offset != 0)) {
+    close(fd);
+    return false;
+  }
+
+  // The body bytes that arrived with the headers plus the rest of the
+  // stream
+  size_t have = std::min(head.size() - body_start, n);
+  std::memcpy(dst, head.data() + body_start, have);
+  while (have < n) {
+    auto m = ::read(fd, dst + have, n - have);
+    if (m <= 0) {
+      close(fd);
+      return false;
+    }
+    have += m;
+  }
+  close(fd);
+  if (head_out != nullptr) {
+    *head_out = head.substr(0, body_start);
+  }
+  return true;
+}
+
+void HttpFileReader::read(char* data, size_t n, size_t offset) {
+  if (n == 0) {
+    return;
+  }
+  if (offset + n > size_) {
+    std::ostringstream msg;
+    msg << "[read] Read past the end of " << label() << ".";
+    throw std::runtime_error(msg.str());
+  }
+  auto fetch = [this](size_t off, size_t m, char* dst) {
+    return fetch_range(off, m, dst, nullptr);
+  };
+  std::vector<std::future<bool>> futs;
+  while (n != 0) {
+    if (n < batch_size_) {
+      if (!fetch(offset, n, data)) {
+        throw std::runtime_error("[read] Unable to read from " + label());
+      }
+      break;
+    } else {
+      futs.emplace_back(
+          thread_pool().enqueue(fetch, offset, batch_size_, data));
+      data += batch_size_;
+      n -= batch_size_;
+      offset += batch_size_;
+    }
+  }
+  for (auto& f : futs) {
+    if (!f.get()) {
+      throw std::runtime_error("[read] Unable to read from " + label());
+    }
+  }
+}
+
+#endif // !defined(_WIN32)
+
+#if !defined(_WIN32)
+
+DirectFileWriter::DirectFileWriter(std::string file_path)
+    : label_(std::move(file_path)) {
+#ifdef O_DIRECT
+  fd_ = open(
+      label_.c_str(),
+      O_CREAT | O_WRONLY | O_TRUNC | O_BINARY | O_DIRECT,
+      0644);
+  direct_ = fd_ >= 0;
+#endif
+  if (fd_ < 0) {
+    fd_ = open(label_.c_str(), O_CREAT | O_WRONLY | O_TRUNC | O_BINARY, 0644);
+#if defined(F_NOCACHE)
+    direct_ = fd_ >= 0 && fcntl(fd_, F_NOCACHE, 1) == 0;
+#endif
+  }
+  if (direct_) {
+    for (auto& b : buffers_) {
+      void* ptr = nullptr;
+      if (posix_memalign(&ptr, alignment_, block_size_) != 0) {
+        direct_ = false;
+        break;
+      }
+      b = static_cast<char*>(ptr);
+    }
+  }
+#ifdef O_DIRECT
+  if (fd_ >= 0 && !direct_) {
+    // Direct mode did not come up; make sure plain writes are legal
+    fcntl(fd_, F_SETFL, fcntl(fd_, F_GETFL) & ~O_DIRECT);
+  }
+#endif
+}
+
+DirectFileWriter::~DirectFileWriter() {
+  if (fd_ >= 0) {
+    try {
+      drain();
+    } catch (const std::exception&) {
+      // Nothing reasonable to do with a failed flush in a destructor
+    }
+    close(fd_);
+  }
+  std::free(buffers_[0]);
+  std::free(buffers_[1]);
+}
+
+void DirectFileWriter::write_buffered(const char* data, size_t n) {
+  written_ += n;
+  while (n != 0) {
+    auto m = ::write(fd_, data, std::min(n, static_cast<size_t>(INT32_MAX)));
+    if (m <= 0) {
+      std::ostringstream msg;
+      msg << "[write] Unable to write " << n << " bytes to file.";
+      throw std::runtime_error(msg.str());
+    }
+    data += m;
+    n -= m;
+  }
+}
+
+void DirectFileWriter::flush_block() {
+  if (pending_.valid()) {
+    pending_.get();
+  }
+
+  // Rate limit the flushes so checkpointing leaves disk bandwidth for the
+  // serving path
+  std::chrono::steady_clock::time_point deadline{};
+  if (auto mbps = env::direct_write_mbps(); mbps > 0) {
+    auto now = std::chrono::steady_clock::now();
+    if (next_flush_ < now) {
+      next_flush_ = now;
+    }
+    deadline = next_flush_;
+    next_flush_ += std::chrono::nanoseconds(
+        block_size_ * 1000000000ull / (static_cast<uint64_t>(mbps) << 20));
+  }
+
+  const char* data = buffers_[cur_];
+  int fd = fd_;
+  pending_ = thread_pool().enqueue([fd, data, deadline]() mutable {
+    if (deadline.time_since_epoch().count() != 0) {
+      std::this_thread::sleep_until(deadline);
+    }
+    size_t n = block_size_;
+    while (n != 0) {
+      auto m = ::write(fd, data, n);
+      if (m <= 0) {
+        std::ostringstream msg;
+        msg << "[write] Unable to write " << n << " bytes to file.";
+        throw std::runtime_error(msg.str());
+      }
+      data += m;
+      n -= m;
+    }
+  });
+  written_ += block_size_;
+  cur_ = 1 - cur_;
+  pos_ = 0;
+}
+
+void DirectFileWriter::drain() {
+  if (pending_.valid()) {
+    pending_.get();
+  }
+  if (pos_ == 0) {
+    return;
+  }
+  // Pad the tail to the alignment for the final direct write and trim the
+  // file back to its logical size
+  size_t padded = alignment_ * ((pos_ + alignment_ - 1) / alignment_);
+  std::memset(buffers_[cur_] + pos_, 0, padded - pos_);
+  const char* data = buffers_[cur_];
+  size_t n = padded;
+  while (n != 0) {
+    auto m = ::write(fd_, data, n);
+    if (m <= 0) {
+      std::ostringstream msg;
+      msg << "[write] Unable to write " << n << " bytes to file.";
+      throw std::runtime_error(msg.str());
+    }
+    data += m;
+    n -= m;
+  }
+  if (padded != pos_ && ftruncate(fd_, written_ + pos_) != 0) {
+    throw std::runtime_error(
+        "[DirectFileWriter] Unable to trim " + label() +
+        " to its logical size.");
+  }
+  written_ += pos_;
+  pos_ = 0;
+}
+
+void DirectFileWriter::write(const char* data, size_t n) {
+  if (!direct_) {
+    write_buffered(data, n);
+    return;
+  }
+  while (n != 0) {
+    auto m = std::min(n, block_size_ - pos_);
+    std::memcpy(buffers_[cur_] + pos_, data, m);
+    pos_ += m;
+    data += m;
+    n -= m;
+    if (pos_ == block_size_) {
+      flush_block();
+    }
+  }
+}
+
+void DirectFileWriter::seek(int64_t off, std::ios_base::seekdir way) {
+  // The writer is sequential; a seek drains the staged blocks and drops
+  // back to buffered writes for whatever follows
+  drain();
+  if (direct_) {
+#ifdef O_DIRECT
+    fcntl(fd_, F_SETFL, fcntl(fd_, F_GETFL) & ~O_DIRECT);
+#endif
+    direct_ = false;
+  }
+  if (way == std::ios_base::beg) {
+    lseek(fd_, off, 0);
+  } else {
+    lseek(fd_, off, SEEK_CUR);
+  }
+  written_ = lseek(fd_, 0, SEEK_CUR);
+  pos_ = 0;
+}
+
+#endif // !defined(_WIN32)
+
+namespace {
+
+// CPU streams prefetched shards are spread over; each runs on its own
+// scheduler thread so the reads overlap with the training step
+const std::vector<Stream>& prefetch_streams() {
+  static std::vector<Stream> streams = []() {
+    std::vector<Stream> s;
+    for (int i = 0; i < std::max(env::prefetch_streams(), 1); ++i) {
+      s.push_back(new_stream(Device::cpu));
+    }
+    return s;
+  }();
+  return streams;
+}
+
+} // namespace
+
+PrefetchLoader::PrefetchLoader(std::vector<std::string> files, int depth)
+    : files_(std::move(files)), depth_(std::max(depth, 1)) {
+  fill();
+}
+
+void PrefetchLoader::fill() {
+  auto& streams = prefetch_streams();
+  while (inflight_.size() < static_cast<size_t>(depth_) &&
+         next_file_ < files_.size()) {
+    auto a = load(files_[next_file_], streams[next_file_ % streams.size()]);
+    async_eval(a);
+    inflight_.push_back(std::move(a));
+    next_file_++;
+  }
+}
+
+array PrefetchLoader::next() {
+  if (done()) {
+    throw std::out_of_range("[PrefetchLoader::next] No shards left.");
+  }
+  auto a = std::move(inflight_.front());
+  inflight_.pop_front();
+  // Top the pipeline back up before blocking on this shard
+  fill();
+  a.wait();
+  return a;
+}
+
 void ParallelFileReader::read(char* data, size_t n) {
   while (n != 0) {
     auto m = ::read(fd_, data, std::min(n, static_cast<size_t>(INT32_MAX)));
@@ -353,6 +1138,181 @@ void ParallelFileReader::read(char* data, size_t n) {
   }
 }
 
+ThreadPool& CompressedFileReader::thread_pool() {
+  static ThreadPool thread_pool{4, {}, /* max_queue = */ 16};
+  return thread_pool;
+}
+
+CompressedFileReader::CompressedFileReader(std::string file_path)
+    : fd_(open(file_path.c_str(), O_RDONLY | O_BINARY)),
+      label_(std::move(file_path)) {
+  if (fd_ < 0) {
+    throw std::runtime_error("[load_compressed] Failed to open " + label());
+  }
+  auto read_exact = [&](void* buf, size_t n) {
+    auto* p = static_cast<char*>(buf);
+    while (n != 0) {
+      auto m = ::read(fd_, p, n);
+      if (m <= 0) {
+        throw std::runtime_error(
+            "[load_compressed] Invalid header in " + label());
+      }
+      p += m;
+      n -= m;
+    }
+  };
+  auto invalid = [&]() {
+    return std::runtime_error("[load_compressed] Invalid header in " + label());
+  };
+
+  uint8_t magic[8];
+  read_exact(magic, sizeof(magic));
+  if (std::memcmp(magic, COMPRESSED_MAGIC, 7) != 0 ||
+      magic[7] != COMPRESSED_VERSION) {
+    throw invalid();
+  }
+  uint8_t descr_len;
+  read_exact(&descr_len, 1);
+  if (descr_len < 2 || descr_len > 3) {
+    throw invalid();
+  }
+  char descr[3];
+  read_exact(descr, descr_len);
+  if (descr_len == 3 && (descr[0] == '>') != is_big_endian()) {
+    throw std::runtime_error(
+        "[load_compressed] " + label() +
+        " was saved with a different byte order.");
+  }
+  dtype_ = dtype_from_array_protocol(std::string(descr, descr_len));
+  uint32_t ndim;
+  read_exact(&ndim, sizeof(ndim));
+  if (ndim > 32) {
+    throw invalid();
+  }
+  shape_.resize(ndim);
+  read_exact(shape_.data(), ndim * sizeof(ShapeElem));
+  read_exact(&raw_bytes_, sizeof(raw_bytes_));
+  read_exact(&frame_raw_, sizeof(frame_raw_));
+  uint64_t expected = size_of(dtype_);
+  for (auto dim : shape_) {
+    if (dim < 0) {
+      throw invalid();
+    }
+    expected *= dim;
+  }
+  if (frame_raw_ == 0 || raw_bytes_ == 0 || raw_bytes_ != expected) {
+    throw invalid();
+  }
+
+  // The frame table is a footer; frame offsets follow from the prefix
+  // sum of the compressed sizes
+  size_t nframes = (raw_bytes_ + frame_raw_ - 1) / frame_raw_;
+  size_t data_start = sizeof(magic) + 1 + descr_len + sizeof(ndim) +
+      ndim * sizeof(ShapeElem) + sizeof(raw_bytes_) + sizeof(frame_raw_);
+  auto file_size = lseek(fd_, 0, SEEK_END);
+  if (file_size < 0 ||
+      static_cast<size_t>(file_size) <
+          data_start + nframes * sizeof(uint64_t)) {
+    throw invalid();
+  }
+  size_t table_off = file_size - nframes * sizeof(uint64_t);
+  comp_sizes_.resize(nframes);
+  {
+    auto* p = reinterpret_cast<char*>(comp_sizes_.data());
+    size_t n = nframes * sizeof(uint64_t);
+    size_t off = table_off;
+    while (n != 0) {
+      auto m = pread(fd_, p, n, off);
+      if (m <= 0) {
+        throw invalid();
+      }
+      p += m;
+      n -= m;
+      off += m;
+    }
+  }
+  frame_offsets_.resize(nframes);
+  uint64_t off = data_start;
+  for (size_t f = 0; f < nframes; ++f) {
+    frame_offsets_[f] = off;
+    if (comp_sizes_[f] == 0 || comp_sizes_[f] > frame_size(f)) {
+      throw invalid();
+    }
+    off += comp_sizes_[f];
+  }
+  if (off != table_off) {
+    throw invalid();
+  }
+}
+
+size_t CompressedFileReader::frame_size(size_t f) const {
+  return std::min<uint64_t>(frame_raw_, raw_bytes_ - f * frame_raw_);
+}
+
+void CompressedFileReader::read(char* data, size_t n, size_t offset) {
+  if (n == 0) {
+    return;
+  }
+  if (offset + n > raw_bytes_) {
+    std::ostringstream msg;
+    msg << "[read] Read past the end of " << label() << ".";
+    throw std::runtime_error(msg.str());
+  }
+  // Decode each overlapping frame on its own task: the task reads the
+  // compressed bytes from disk and decompresses them straight into the
+  // destination, so the disk reads overlap with the decompression
+  auto decode = [this](size_t f, char* dst, size_t skip, size_t take) -> bool {
+    std::vector<uint8_t> comp(comp_sizes_[f]);
+    auto* p = comp.data();
+    size_t left = comp.size();
+    size_t off = frame_offsets_[f];
+    while (left != 0) {
+      auto m = pread(fd_, p, left, off);
+      if (m <= 0) {
+        return false;
+      }
+      p += m;
+      left -= m;
+      off += m;
+    }
+    size_t raw = frame_size(f);
+    if (comp.size() == raw) {
+      // Stored frame
+      std::memcpy(dst, comp.data() + skip, take);
+      return true;
+    }
+    if (skip == 0 && take == raw) {
+      return lz4::decompress(
+                 comp.data(),
+                 comp.size(),
+                 reinterpret_cast<uint8_t*>(dst),
+                 raw) == raw;
+    }
+    // Partially covered frame; decode to the side and copy the slice
+    std::vector<uint8_t> tmp(raw);
+    if (lz4::decompress(comp.data(), comp.size(), tmp.data(), raw) != raw) {
+      return false;
+    }
+    std::memcpy(dst, tmp.data() + skip, take);
+    return true;
+  };
+  size_t first = offset / frame_raw_;
+  size_t last = (offset + n + frame_raw_ - 1) / frame_raw_;
+  std::vector<std::future<bool>> futs;
+  for (size_t f = first; f < last; ++f) {
+    size_t start = f * frame_raw_;
+    size_t skip = offset > start ? offset - start : 0;
+    size_t end = std::min<size_t>(start + frame_size(f), offset + n);
+    futs.emplace_back(thread_pool().enqueue(
+        decode, f, data + (start + skip - offset), skip, end - start - skip));
+  }
+  for (auto& f : futs) {
+    if (!f.get()) {
+      throw std::runtime_error("[read] Unable to decompress " + label());
+    }
+  }
+}
+
 void ParallelFileReader::read(char* data, size_t n, size_t offset) {
   auto readfn = [fd = fd_](size_t offset, size_t size, char* buffer) -> bool {
     while (size != 0) {
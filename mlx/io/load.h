@@ -2,6 +2,10 @@
 
 #pragma once
 
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <future>
 #include <memory>
 #include <sstream>
 
@@ -9,10 +13,12 @@
 #ifdef _MSC_VER
 #include <io.h>
 #else
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
 #endif
 
+#include "mlx/array.h"
 #include "mlx/threadpool.h"
 
 // Strictly we need to operate on files in binary mode (to avoid \r getting
@@ -56,6 +62,29 @@ class Writer {
   virtual ~Writer() = default;
 };
 
+/** Factories producing streams for a registered URI scheme. */
+using ReaderFactory =
+    std::function<std::shared_ptr<Reader>(const std::string& uri)>;
+using WriterFactory =
+    std::function<std::shared_ptr<Writer>(const std::string& uri)>;
+
+/**
+ * Register a factory for paths of the form ``scheme://...``.
+ *
+ * The file based entry points (load, load_safetensors, save, ...) route
+ * matching paths through the factory instead of opening a local file,
+ * so checkpoints can stream straight from an object store without a
+ * staging copy. Registering a scheme again replaces its factory; an
+ * ``http`` reader backed by parallel range requests is registered by
+ * default on POSIX systems.
+ */
+void register_reader(const std::string& scheme, ReaderFactory factory);
+void register_writer(const std::string& scheme, WriterFactory factory);
+
+/** A stream for ``uri`` when its scheme is registered, nullptr otherwise. */
+std::shared_ptr<Reader> reader_for(const std::string& uri);
+std::shared_ptr<Writer> writer_for(const std::string& uri);
+
 class ParallelFileReader : public Reader {
  public:
   explicit ParallelFileReader(std::string file_path)
@@ -170,5 +199,289 @@ class FileWriter : public Writer {
   std::string label_;
 };
 
+#if !defined(_WIN32)
+
+/**
+ * A sequential writer for large checkpoint saves that bypasses the page
+ * cache (O_DIRECT on Linux, F_NOCACHE on macOS) so saving does not evict
+ * hot pages from serving traffic on the same box.
+ *
+ * Bytes are staged in a pair of aligned block buffers: while one fills,
+ * the previous one is flushed on the io thread pool, overlapping
+ * serialization with the disk writes. The unaligned tail is written and
+ * the file trimmed to its logical size when the writer closes. Set
+ * MLX_DIRECT_WRITE_MBPS to cap the flush rate in MB per second. The
+ * writer falls back to ordinary buffered writes when direct I/O is
+ * unavailable, and a seek drains the staged blocks and drops back to
+ * buffered writes for whatever follows.
+ */
+class DirectFileWriter : public Writer {
+ public:
+  explicit DirectFileWriter(std::string file_path);
+
+  DirectFileWriter(const DirectFileWriter&) = delete;
+  DirectFileWriter& operator=(const DirectFileWriter&) = delete;
+
+  ~DirectFileWriter() override;
+
+  bool is_open() const override {
+    return fd_ >= 0;
+  }
+
+  bool good() const override {
+    return is_open();
+  }
+
+  size_t tell() override {
+    return written_ + pos_;
+  }
+
+  void seek(int64_t off, std::ios_base::seekdir way = std::ios_base::beg)
+      override;
+
+  void write(const char* data, size_t n) override;
+
+  std::string label() const override {
+    return "file " + label_;
+  }
+
+ private:
+  static constexpr size_t alignment_ = 4096;
+  static constexpr size_t block_size_ = 1 << 22;
+
+  void write_buffered(const char* data, size_t n);
+  void flush_block();
+  void drain();
+
+  int fd_{-1};
+  std::string label_;
+  bool direct_{false};
+  char* buffers_[2]{nullptr, nullptr};
+  int cur_{0};
+  // Fill of the current staging buffer
+  size_t pos_{0};
+  // Bytes handed to the kernel
+  size_t written_{0};
+  std::future<void> pending_;
+  std::chrono::steady_clock::time_point next_flush_{};
+};
+
+#endif // !defined(_WIN32)
+
+#if !defined(_WIN32)
+
+/**
+ * Reader over an object served with HTTP range requests.
+ *
+ * Offset reads are split into batches issued as ranged GETs, each on
+ * its own connection from a small thread pool, so a checkpoint streams
+ * from the store at close to line rate. With the safetensors loader
+ * every tensor extent becomes its own set of range requests. The object
+ * size is resolved from a one byte ranged GET when the reader opens.
+ *
+ * Plain http only; TLS termination (https, presigned S3 URLs) belongs
+ * to a proxy or a reader registered through register_reader.
+ */
+class HttpFileReader : public Reader {
+ public:
+  explicit HttpFileReader(const std::string& uri);
+
+  bool is_open() const override {
+    return good_;
+  }
+
+  bool good() const override {
+    return good_;
+  }
+
+  size_t tell() override {
+    return pos_;
+  }
+
+  void seek(int64_t off, std::ios_base::seekdir way = std::ios_base::beg)
+      override {
+    pos_ = (way == std::ios_base::beg) ? off : pos_ + off;
+  }
+
+  void read(char* data, size_t n) override {
+    read(data, n, pos_);
+    pos_ += n;
+  }
+
+  void read(char* data, size_t n, size_t offset) override;
+
+  std::string label() const override {
+    return "url " + label_;
+  }
+
+ private:
+  static constexpr size_t batch_size_ = 1 << 23;
+  static ThreadPool& thread_pool();
+
+  int connect_socket() const;
+
+  // One ranged GET on its own connection; on success the body is in
+  // `dst` and the raw header block in `head` when it is non-null
+  bool fetch_range(size_t offset, size_t n, char* dst, std::string* head)
+      const;
+
+  std::string host_;
+  std::string port_;
+  std::string target_;
+  std::string label_;
+  size_t size_{0};
+  size_t pos_{0};
+  bool good_{false};
+};
+
+#endif // !defined(_WIN32)
+
+/**
+ * Reader over the compressed .npy-style checkpoint format written by
+ * save_compressed.
+ *
+ * The file holds the tensor bytes as independently compressed frames
+ * (an LZ4-style block codec) with a frame table at the end. The reader
+ * presents the uncompressed payload: offsets and sizes passed to read()
+ * are positions in the tensor bytes, so the lazy Load primitive works
+ * on it unchanged. A read maps its range onto the overlapping frames
+ * and decodes them in parallel on a small thread pool, each task
+ * reading its frame from disk and decompressing straight into the
+ * destination, so disk reads overlap with decompression.
+ */
+class CompressedFileReader : public Reader {
+ public:
+  explicit CompressedFileReader(std::string file_path);
+
+  ~CompressedFileReader() override {
+    if (fd_ >= 0) {
+      close(fd_);
+    }
+  }
+
+  bool is_open() const override {
+    return fd_ >= 0;
+  }
+
+  bool good() const override {
+    return is_open();
+  }
+
+  size_t tell() override {
+    return pos_;
+  }
+
+  void seek(int64_t off, std::ios_base::seekdir way = std::ios_base::beg)
+      override {
+    pos_ = (way == std::ios_base::beg) ? off : pos_ + off;
+  }
+
+  void read(char* data, size_t n) override {
+    read(data, n, pos_);
+    pos_ += n;
+  }
+
+  void read(char* data, size_t n, size_t offset) override;
+
+  std::string label() const override {
+    return "file " + label_;
+  }
+
+  const Shape& shape() const {
+    return shape_;
+  }
+
+  Dtype dtype() const {
+    return dtype_;
+  }
+
+ private:
+  static ThreadPool& thread_pool();
+
+  // Raw size of frame `f`; only the last frame can be short
+  size_t frame_size(size_t f) const;
+
+  int fd_{-1};
+  std::string label_;
+  Shape shape_;
+  Dtype dtype_ = float32;
+  uint64_t raw_bytes_{0};
+  uint64_t frame_raw_{0};
+  // File offset of each compressed frame
+  std::vector<uint64_t> frame_offsets_;
+  std::vector<uint64_t> comp_sizes_;
+  size_t pos_{0};
+};
+
+/**
+ * Read ahead over a list of .npy shard files.
+ *
+ * Up to `depth` shards are kept in flight: each is loaded lazily and
+ * scheduled with async_eval on one of a small pool of CPU streams
+ * (MLX_PREFETCH_STREAMS), so the scheduler reads the bytes into unified
+ * memory in the background while the current batch trains. next() hands
+ * the shards back in file order and only blocks when the reads have not
+ * caught up.
+ */
+class PrefetchLoader {
+ public:
+  explicit PrefetchLoader(std::vector<std::string> files, int depth = 4);
+
+  /** The next shard in file order; blocks until its bytes are resident. */
+  array next();
+
+  /** True when every file has been handed out. */
+  bool done() const {
+    return inflight_.empty() && next_file_ == files_.size();
+  }
+
+  int depth() const {
+    return depth_;
+  }
+
+ private:
+  void fill();
+
+  std::vector<std::string> files_;
+  size_t next_file_{0};
+  int depth_;
+  std::deque<array> inflight_;
+};
+
+#if !defined(_WIN32)
+
+// An open memory mapping of a file. Arrays wrapping extents of the mapping
+// keep it alive through their buffer deleter; the file is unmapped when the
+// last one is freed.
+struct MappedFile {
+  explicit MappedFile(const std::string& file) {
+    int fd = open(file.c_str(), O_RDONLY | O_BINARY);
+    if (fd < 0) {
+      return;
+    }
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+      size = static_cast<size_t>(st.st_size);
+      data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data == MAP_FAILED) {
+        data = nullptr;
+        size = 0;
+      }
+    }
+    close(fd);
+  }
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  ~MappedFile() {
+    if (data != nullptr) {
+      munmap(data, size);
+    }
+  }
+  void* data{nullptr};
+  size_t size{0};
+};
+
+#endif // !defined(_WIN32)
+
 } // namespace io
 } // namespace mlx::core
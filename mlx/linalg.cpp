@@ -291,8 +291,27 @@ svd(const array& a, bool compute_uv, StreamOrDevice s /* = {} */) {
       {a});
 }
 
+// Triangular inverse built as a graph of batched matmuls so it runs on
+// the GPU. Starting from the reciprocal diagonal X0, the residual
+// I - A X is strictly triangular, hence nilpotent, and each Newton step
+// X <- X (2I - A X) squares it, so ceil(log2(n)) steps eliminate it
+// exactly. A batch of small systems is a handful of batched GEMM
+// launches and never leaves the device.
+array tri_inv_gpu(const array& a, bool upper, StreamOrDevice s) {
+  int n = a.shape(-1);
+  auto dtype = a.dtype();
+  auto t = upper ? triu(a, 0, s) : tril(a, 0, s);
+  auto d = diagonal(t, 0, -2, -1, s);
+  auto eye_n = eye(n, dtype, s);
+  auto x = multiply(eye_n, expand_dims(reciprocal(d, s), -1, s), s);
+  auto eye_2n = multiply(eye_n, array(2, dtype), s);
+  for (int k = 1; k < n; k *= 2) {
+    x = matmul(x, subtract(eye_2n, matmul(t, x, s), s), s);
+  }
+  return x;
+}
+
 array inv_impl(const array& a, bool tri, bool upper, StreamOrDevice s) {
-  check_cpu_stream(s, "[linalg::inv]");
   check_float(a.dtype(), "[linalg::inv]");
 
   if (a.ndim() < 2) {
@@ -307,6 +326,11 @@ array inv_impl(const array& a, bool tri, bool upper, StreamOrDevice s) {
         "[linalg::inv] Inverses are only defined for square matrices.");
   }
 
+  if (tri && to_stream(s).device == Device::gpu) {
+    return tri_inv_gpu(a, upper, s);
+  }
+  check_cpu_stream(s, "[linalg::inv]");
+
   return array(
       a.shape(),
       a.dtype(),
@@ -635,7 +659,6 @@ void validate_solve(
     const array& b,
     const StreamOrDevice& stream,
     const std::string& fname) {
-  check_cpu_stream(stream, fname);
   if (a.ndim() < 2) {
     std::ostringstream msg;
     msg << fname << " First input must have >= 2 dimensions. "
@@ -678,6 +701,8 @@ void validate_solve(
 }
 
 array solve(const array& a, const array& b, StreamOrDevice s /* = {} */) {
+  // The LU factorization runs through LAPACK
+  check_cpu_stream(s, "[linalg::solve]");
   validate_solve(a, b, s, "[linalg::solve]");
 
   // P, L, U matrices
@@ -2,10 +2,16 @@
 
 #pragma once
 
+#include <cstdint>
 #include <cstdlib>
+#include <string>
+#include <vector>
 
 namespace mlx::core {
 
+class array;
+struct Device;
+
 /* Get the actively used memory in bytes.
  *
  * Note, this will not always match memory use reported by the system because
@@ -31,6 +37,31 @@ void reset_peak_memory();
  * */
 size_t get_cache_memory();
 
+/* Counters accumulated by the allocator's buffer cache.
+ *
+ * A hit is an allocation served by recycling a cached buffer; a miss had
+ * to be freshly allocated. A fragmented miss is a miss that occurred
+ * while the cache held at least the requested bytes but no single buffer
+ * fit, so a high ratio of fragmented misses to misses means the cache
+ * limit is not the problem. Evictions count buffers released to stay
+ * under the cache limit.
+ * */
+struct CacheStats {
+  size_t hits{0};
+  size_t misses{0};
+  size_t fragmented_misses{0};
+  size_t bytes_recycled{0};
+  size_t bytes_missed{0};
+  size_t evictions{0};
+};
+
+/* Snapshot the buffer cache counters, accumulated since the program
+ * started or the last reset. */
+CacheStats get_cache_stats();
+
+/* Reset the buffer cache counters. */
+void reset_cache_stats();
+
 /* Set the memory limit.
  * The memory limit is a guideline for the maximum amount of memory to use
  * during graph evaluation. If the memory limit is exceeded and there is no
@@ -61,6 +92,137 @@ size_t set_cache_limit(size_t limit);
 /* Clear the memory cache. */
 void clear_cache();
 
+/* One entry of attributed allocation telemetry: the bytes allocated while
+ * evaluating a given primitive on a given stream.
+ * */
+struct AllocationSite {
+  std::string primitive;
+  uint32_t stream;
+  size_t bytes;
+  size_t count;
+};
+
+/* Enable or disable allocation telemetry.
+ *
+ * While enabled, every allocation made during primitive evaluation is
+ * attributed to the primitive being evaluated and the stream it runs on,
+ * including scratch allocations made inside kernels. Telemetry adds one
+ * map update per allocation, so leave it off outside memory
+ * investigations. Counters accumulate across evals until cleared.
+ * */
+void enable_allocation_telemetry(bool enable = true);
+
+/* Snapshot the accumulated allocation telemetry, sorted by descending
+ * byte count. Allocations made outside primitive evaluation (e.g. array
+ * literals) are reported under the primitive name "<unattributed>".
+ * */
+std::vector<AllocationSite> allocation_telemetry_snapshot();
+
+/* Reset the accumulated allocation telemetry. */
+void clear_allocation_telemetry();
+
+/* One allocation or free on the recorded memory timeline. Frees carry the
+ * primitive, stream and bytes of the allocation they release, and
+ * ``active_bytes`` is the running total of recorded memory after the
+ * event.
+ * */
+struct MemoryEvent {
+  std::string primitive;
+  uint32_t stream;
+  uint64_t timestamp_us;
+  uintptr_t buffer;
+  size_t bytes;
+  bool is_free;
+  size_t active_bytes;
+};
+
+/* Enable or disable the memory timeline recorder.
+ *
+ * While enabled, every allocation and free is recorded with a timestamp
+ * and the (primitive, stream) attribution of the allocation. Frees of
+ * buffers allocated before recording started are not recorded. Events
+ * accumulate until cleared, one entry per allocation, so clear the
+ * timeline between investigations.
+ * */
+void enable_memory_timeline(bool enable = true);
+
+/* Snapshot the recorded memory events in order. */
+std::vector<MemoryEvent> memory_timeline_snapshot();
+
+/* Reset the recorded memory timeline. */
+void clear_memory_timeline();
+
+/* Reconstruct the allocations live at the recorded peak of the timeline,
+ * aggregated per (primitive, stream) and sorted by descending bytes —
+ * i.e. what was actually held when memory crested, rather than just the
+ * high-water mark get_peak_memory reports.
+ * */
+std::vector<AllocationSite> live_set_at_peak();
+
+/* Write the live set at the recorded peak to `file` in collapsed stack
+ * format, one "stream_N;Primitive bytes" line per site, suitable for
+ * flamegraph.pl --countname=bytes.
+ * */
+void write_memory_flamegraph(const std::string& file);
+
+/* Set the resident memory high watermark.
+ *
+ * While the resident set size of the process is above the watermark, cached
+ * buffers are released on subsequent allocations until the resident set
+ * size falls to 0.9 times the watermark or the cache is empty. The resident
+ * set size is sampled every few hundred allocations to keep the check
+ * cheap, so trimming may lag the crossing by a short burst of allocations.
+ *
+ * This keeps the cache from squeezing out co-located processes without
+ * manual clear_cache calls. Set to 0 (the default) to disable.
+ *
+ * Returns the previous watermark.
+ * */
+size_t set_rss_watermark(size_t limit);
+
+/* While alive, account allocations made on the calling thread to the
+ * named memory group. Groups give co-resident workloads separate byte
+ * budgets on one device: wrap each model's evals in its own group and
+ * set a budget per group (see set_memory_group_limit). Nested guards
+ * restore the previous group.
+ *
+ *   { ScopedMemoryGroup g("assistant"); eval(outputs); }
+ * */
+struct ScopedMemoryGroup {
+  ScopedMemoryGroup(const std::string& name);
+  ~ScopedMemoryGroup();
+
+ private:
+  std::string previous_;
+};
+
+/* Set the byte budget of a memory group.
+ *
+ * While a group is above its budget, its allocations release the buffer
+ * cache, so an over-budget workload pays the recycling misses itself
+ * instead of squeezing the working set of every other group through the
+ * global gc limit. The budget is a soft pressure guideline, not a hard
+ * cap. Set to 0 (the default) to account without applying pressure.
+ *
+ * Returns the previous budget.
+ * */
+size_t set_memory_group_limit(const std::string& name, size_t limit);
+
+/* Bytes currently held by allocations accounted to the group. */
+size_t get_memory_group_active(const std::string& name);
+
+/* Hint that the memory backing `a` should be made resident on `device`.
+ *
+ * On the CUDA backend this starts an asynchronous migration of the array's
+ * managed buffer on a dedicated copy stream, so e.g. offloaded weights can
+ * be streamed onto the device while earlier layers compute. Pass a CPU
+ * device to evict the buffer back to host memory. The call returns
+ * immediately and is only a hint: access from either device stays correct
+ * whether or not the migration has finished. Unscheduled arrays are
+ * ignored. A no-op on backends with a single physical memory (Metal, CPU).
+ * */
+void prefetch(const array& a, Device device);
+
 /* Set the wired size limit.
  *
  * Note, this function is only useful when using the Metal backend with
@@ -10,6 +10,7 @@
 #include "mlx/device.h"
 #include "mlx/distributed/distributed.h"
 #include "mlx/distributed/ops.h"
+#include "mlx/distributed/pipeline.h"
 #include "mlx/einsum.h"
 #include "mlx/export.h"
 #include "mlx/fast.h"
@@ -18,6 +19,7 @@
 #include "mlx/linalg.h"
 #include "mlx/memory.h"
 #include "mlx/ops.h"
+#include "mlx/profiler.h"
 #include "mlx/random.h"
 #include "mlx/stream.h"
 #include "mlx/transforms.h"
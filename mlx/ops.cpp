@@ -6,11 +6,14 @@
 #include <algorithm>
 #include <climits>
 #include <cmath>
+#include <list>
+#include <mutex>
 #include <numeric>
 #include <set>
 #include <sstream>
 
 #include "mlx/fast_primitives.h"
+#include "mlx/fft.h"
 #include "mlx/ops.h"
 #include "mlx/primitives.h"
 #include "mlx/transforms.h"
@@ -271,6 +274,67 @@ array as_strided(
       {flatten(std::move(a), s)});
 }
 
+array sliding_window_view(
+    const array& a,
+    int window_size,
+    int axis /* = -1 */,
+    int step /* = 1 */,
+    StreamOrDevice s /* = {} */) {
+  if (a.ndim() == 0) {
+    throw std::invalid_argument(
+        "[sliding_window_view] Cannot window a 0-d array.");
+  }
+  auto ax = normalize_axis_index(axis, a.ndim(), "[sliding_window_view] ");
+  if (window_size <= 0) {
+    std::ostringstream msg;
+    msg << "[sliding_window_view] Window size must be positive but got "
+        << window_size << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  if (step <= 0) {
+    std::ostringstream msg;
+    msg << "[sliding_window_view] Step must be positive but got " << step
+        << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  if (window_size > a.shape(ax)) {
+    std::ostringstream msg;
+    msg << "[sliding_window_view] Window size " << window_size
+        << " is larger than axis " << ax << " of array with shape "
+        << a.shape() << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  auto n_windows = (a.shape(ax) - window_size) / step + 1;
+
+  // Strides of the row-contiguous array that as_strided views into
+  Strides strides(a.ndim(), 1);
+  for (int i = a.ndim() - 2; i >= 0; --i) {
+    strides[i] = strides[i + 1] * a.shape(i + 1);
+  }
+
+  auto shape = a.shape();
+  shape[ax] = n_windows;
+  shape.push_back(window_size);
+  auto out_strides = strides;
+  out_strides[ax] = strides[ax] * step;
+  out_strides.push_back(strides[ax]);
+
+  // Check the farthest element the view can touch stays in bounds
+  int64_t last = 0;
+  for (int i = 0; i < shape.size(); ++i) {
+    last += (shape[i] - 1) * out_strides[i];
+  }
+  if (last >= static_cast<int64_t>(a.size())) {
+    std::ostringstream msg;
+    msg << "[sliding_window_view] Strided view of " << (last + 1)
+        << " elements exceeds the " << a.size()
+        << " elements of the underlying array.";
+    throw std::invalid_argument(msg.str());
+  }
+
+  return as_strided(a, std::move(shape), std::move(out_strides), 0, s);
+}
+
 array copy(array a, StreamOrDevice s /* = {} */) {
   auto copied_shape = a.shape(); // |a| will be moved
   auto dtype = a.dtype();
@@ -1701,6 +1765,38 @@ array where(
       inputs);
 }
 
+array masked_add(
+    const array& condition,
+    const array& x,
+    const array& y,
+    StreamOrDevice s /* = {} */) {
+  auto cond = astype(condition, bool_, s);
+  Dtype out_dtype = promote_types(x.dtype(), y.dtype());
+  auto inputs = broadcast_arrays(
+      {cond, astype(x, out_dtype, s), astype(y, out_dtype, s)}, s);
+  return array(
+      inputs[0].shape(),
+      out_dtype,
+      std::make_shared<MaskedAdd>(to_stream(s)),
+      inputs);
+}
+
+array masked_multiply(
+    const array& condition,
+    const array& x,
+    const array& y,
+    StreamOrDevice s /* = {} */) {
+  auto cond = astype(condition, bool_, s);
+  Dtype out_dtype = promote_types(x.dtype(), y.dtype());
+  auto inputs = broadcast_arrays(
+      {cond, astype(x, out_dtype, s), astype(y, out_dtype, s)}, s);
+  return array(
+      inputs[0].shape(),
+      out_dtype,
+      std::make_shared<MaskedMultiply>(to_stream(s)),
+      inputs);
+}
+
 array nan_to_num(
     const array& a,
     float nan /* = 0.0f */,
@@ -1891,6 +1987,29 @@ array sum(
   return out;
 }
 
+array sum(
+    const array& a,
+    const std::vector<int>& axes,
+    Dtype accum_dtype,
+    bool keepdims /* = false */,
+    StreamOrDevice s /* = {} */) {
+  if (accum_dtype == a.dtype()) {
+    return sum(a, axes, keepdims, s);
+  }
+  // Accumulate in the requested precision, then cast back to the dtype
+  // the plain sum would have produced
+  auto out = sum(astype(a, accum_dtype, s), axes, keepdims, s);
+  Dtype out_type = a.dtype();
+  if (issubdtype(a.dtype(), signedinteger)) {
+    out_type = a.dtype().size() <= 4 ? int32 : int64;
+  } else if (issubdtype(a.dtype(), unsignedinteger)) {
+    out_type = a.dtype().size() <= 4 ? uint32 : uint64;
+  } else if (a.dtype() == bool_) {
+    out_type = int32;
+  }
+  return astype(out, out_type, s);
+}
+
 array sum(
     const array& a,
     int axis,
@@ -1978,6 +2097,47 @@ array var(
   return var(a, std::vector<int>{axis}, keepdims, ddof, to_stream(s));
 }
 
+std::pair<array, array> mean_and_var(
+    const array& a,
+    const std::vector<int>& axes,
+    bool keepdims /* = false */,
+    int ddof /* = 0*/,
+    StreamOrDevice s /* = {}*/) {
+  auto dtype = at_least_float(a.dtype());
+  // Share the mean between the two statistics instead of reducing the
+  // data once for the mean and again inside var
+  auto mu = mean(a, axes, /* keepdims= */ true, s);
+  auto v = sum(square(subtract(a, mu, s), s), axes, keepdims, s);
+
+  if (ddof != 0) {
+    auto normalizer = maximum(
+        subtract(
+            number_of_elements(a, axes, false, dtype, s),
+            array(ddof, dtype),
+            s),
+        array(0, dtype),
+        s);
+    v = divide(v, normalizer, s);
+  } else {
+    auto normalizer = number_of_elements(a, axes, true, dtype, s);
+    v = multiply(v, normalizer, s);
+  }
+
+  if (!keepdims) {
+    mu = squeeze(mu, axes, s);
+  }
+  return {mu, v};
+}
+
+std::pair<array, array> mean_and_var(
+    const array& a,
+    int axis,
+    bool keepdims /* = false */,
+    int ddof /* = 0*/,
+    StreamOrDevice s /* = {} */) {
+  return mean_and_var(a, std::vector<int>{axis}, keepdims, ddof, to_stream(s));
+}
+
 array std(
     const array& a,
     bool keepdims,
@@ -2179,6 +2339,44 @@ array argmax(const array& a, bool keepdims, StreamOrDevice s /* = {} */) {
   return result;
 }
 
+std::pair<array, array> max_and_argmax(
+    const array& a,
+    int axis,
+    bool keepdims /* = false */,
+    StreamOrDevice s /* = {} */) {
+  if (a.size() == 0) {
+    throw std::invalid_argument(
+        "[max_and_argmax] Cannot reduce zero size array.");
+  }
+  // The values are gathered at the reduced indices so the data is only
+  // read once
+  auto indices = argmax(a, axis, /* keepdims = */ true, s);
+  auto values = take_along_axis(a, indices, axis, s);
+  if (!keepdims) {
+    axis = axis < 0 ? axis + a.ndim() : axis;
+    indices = squeeze(indices, axis, s);
+    values = squeeze(values, axis, s);
+  }
+  return {values, indices};
+}
+
+std::pair<array, array> max_and_argmax(
+    const array& a,
+    bool keepdims /* = false */,
+    StreamOrDevice s /* = {} */) {
+  auto [values, indices] = max_and_argmax(flatten(a, s), 0, true, s);
+  if (keepdims) {
+    std::vector<int> axes(a.ndim() - 1);
+    std::iota(axes.begin(), axes.end(), 0);
+    values = expand_dims(values, axes, s);
+    indices = expand_dims(indices, axes, s);
+  } else {
+    values = squeeze(values, s);
+    indices = squeeze(indices, s);
+  }
+  return {values, indices};
+}
+
 array argmax(
     const array& a,
     int axis,
@@ -2847,10 +3045,13 @@ array round(const array& a, int decimals, StreamOrDevice s /* = {} */) {
   return astype(result, a.dtype(), s);
 }
 
-array matmul(
+namespace {
+
+array matmul_impl(
     const array& in_a,
     const array& in_b,
-    StreamOrDevice s /* = {} */) {
+    std::optional<Dtype> accum_dtype,
+    StreamOrDevice s) {
   auto a = in_a;
   auto b = in_b;
   if (a.ndim() == 0 || b.ndim() == 0) {
@@ -2925,7 +3126,7 @@ array matmul(
   auto out = array(
       std::move(out_shape),
       out_type,
-      std::make_shared<Matmul>(to_stream(s)),
+      std::make_shared<Matmul>(to_stream(s), accum_dtype),
       {a, b});
   if (in_a.ndim() > 2 && in_b.ndim() <= 2) {
     auto orig_shape = in_a.shape();
@@ -2944,6 +3145,23 @@ array matmul(
   return axes.empty() ? out : squeeze(out, axes, s);
 }
 
+} // namespace
+
+array matmul(
+    const array& in_a,
+    const array& in_b,
+    StreamOrDevice s /* = {} */) {
+  return matmul_impl(in_a, in_b, std::nullopt, s);
+}
+
+array matmul(
+    const array& in_a,
+    const array& in_b,
+    Dtype accum_dtype,
+    StreamOrDevice s /* = {} */) {
+  return matmul_impl(in_a, in_b, accum_dtype, s);
+}
+
 array gather(
     const array& a,
     const std::vector<array>& indices,
@@ -3244,6 +3462,49 @@ array scatter_add_axis(
   return scatter_axis(a, indices, values, axis, ScatterAxis::Sum, s);
 }
 
+array bincount(const array& a, int nbins, StreamOrDevice s /* = {} */) {
+  if (!issubdtype(a.dtype(), integer)) {
+    std::ostringstream msg;
+    msg << "[bincount] Can only count integer arrays but got array with type "
+        << a.dtype() << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  if (a.ndim() == 0) {
+    throw std::invalid_argument("[bincount] Cannot count a 0-d array.");
+  }
+  if (nbins <= 0) {
+    std::ostringstream msg;
+    msg << "[bincount] Number of bins must be positive but got " << nbins
+        << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  auto stream = to_stream(s);
+  auto shape = a.shape();
+  shape.back() = nbins;
+  if (stream.device == Device::gpu) {
+    // No privatized histogram kernel on GPU yet; scatter-add keeps the op
+    // functional there
+    auto counts = zeros(shape, uint32, s);
+    return scatter_add_axis(
+        counts,
+        clip(a, array(0, a.dtype()), array(nbins - 1, a.dtype()), s),
+        astype(
+            logical_and(
+                greater_equal(a, array(0, a.dtype()), s),
+                less(a, array(nbins, a.dtype()), s),
+                s),
+            uint32,
+            s),
+        -1,
+        s);
+  }
+  return array(
+      std::move(shape),
+      uint32,
+      std::make_shared<Bincount>(stream, nbins),
+      {a});
+}
+
 /** Scatter updates to given indices */
 array scatter(
     const array& a,
@@ -3908,6 +4169,118 @@ array conv_transpose3d(
       s);
 }
 
+namespace {
+
+// FFT convolution beats the direct and GEMM paths by roughly this many
+// taps; below it the transforms don't pay for themselves
+constexpr int fft_conv_min_taps = 1024;
+
+// Kernel spectra cached across calls keyed by the weight array, the
+// transform size, and the stream. Audio graphs apply the same taps on
+// every call, so the kernel-side FFT and its twiddle work run once.
+// Entries retain the weight to pin its id — a freed weight's identity
+// could otherwise be recycled into a false hit on a stale spectrum — and
+// are evicted least-recently-used past a byte budget since spectra for
+// long kernels are large.
+struct FFTConvCache {
+  struct Entry {
+    array weight;
+    array spectrum;
+    size_t bytes;
+  };
+
+  std::mutex mtx;
+  size_t limit{
+      static_cast<size_t>(env::get_var("MLX_FFT_CONV_CACHE_MB", 64)) << 20};
+  size_t size{0};
+  std::list<std::pair<std::string, Entry>> lru;
+  std::unordered_map<
+      std::string,
+      std::list<std::pair<std::string, Entry>>::iterator>
+      map;
+};
+
+FFTConvCache& fft_conv_cache() {
+  static FFTConvCache cache;
+  return cache;
+}
+
+array fft_conv1d(
+    const array& in,
+    const array& wt,
+    int stride,
+    int padding_lo,
+    int padding_hi,
+    bool flip,
+    StreamOrDevice s) {
+  int L = in.shape(1);
+  int K = wt.shape(1);
+  int L_pad = L + padding_lo + padding_hi;
+  int n_fft = next_power_of_2(L_pad + K - 1);
+
+  auto x = in;
+  if (padding_lo > 0 || padding_hi > 0) {
+    x = pad(
+        x,
+        {1},
+        {padding_lo},
+        {padding_hi},
+        array(0, in.dtype()),
+        "constant",
+        s);
+  }
+
+  std::ostringstream key;
+  key << wt.id() << "," << n_fft << "," << flip << ","
+      << to_stream(s).index;
+  auto w_hat = [&]() {
+    auto& cache = fft_conv_cache();
+    std::lock_guard<std::mutex> lock(cache.mtx);
+    if (auto it = cache.map.find(key.str()); it != cache.map.end()) {
+      cache.lru.splice(cache.lru.begin(), cache.lru, it->second);
+      return it->second->second.spectrum;
+    }
+    // Cross-correlation is convolution with the taps reversed
+    auto w = flip
+        ? wt
+        : take(wt, arange(K - 1.0, -1.0, -1.0, int32, s), 1, s);
+    auto w_f = fft::rfft(w, n_fft, 1, s);
+    if (size_t bytes = w_f.nbytes(); bytes <= cache.limit) {
+      cache.lru.emplace_front(key.str(), FFTConvCache::Entry{wt, w_f, bytes});
+      cache.map[key.str()] = cache.lru.begin();
+      cache.size += bytes;
+      while (cache.size > cache.limit) {
+        auto& oldest = cache.lru.back();
+        cache.size -= oldest.second.bytes;
+        cache.map.erase(oldest.first);
+        cache.lru.pop_back();
+      }
+    }
+    return w_f;
+  }();
+
+  // Pointwise product in the frequency domain, summed over the input
+  // channels: (N, n_fft / 2 + 1, 1, C_in) x (n_fft / 2 + 1, C_out, C_in)
+  auto x_hat = fft::rfft(x, n_fft, 1, s);
+  auto y_hat = sum(
+      multiply(expand_dims(x_hat, 2, s), transpose(w_hat, {1, 0, 2}, s), s),
+      -1,
+      /* keepdims = */ false,
+      s);
+  auto y = fft::irfft(y_hat, n_fft, 1, s);
+
+  // Valid outputs start at tap K - 1; the stride folds into the slice
+  int out_len = (L_pad - K) / stride + 1;
+  return slice(
+      y,
+      {0, K - 1, 0},
+      {y.shape(0), K - 1 + (out_len - 1) * stride + 1, y.shape(2)},
+      {1, stride, 1},
+      s);
+}
+
+} // namespace
+
 /** General convolution with a filter */
 array conv_general(
     array in,
@@ -3996,6 +4369,16 @@ array conv_general(
     in = slice(in, std::move(starts), std::move(stops), s);
   }
 
+  // Route long 1-D convolutions through the FFT: the direct and GEMM
+  // paths cost O(L K) while FFT convolution costs O((L + K) log(L + K)),
+  // an order of magnitude for multi-thousand-tap audio filters
+  if (spatial_dims == 1 && groups == 1 && kernel_dilation[0] == 1 &&
+      input_dilation[0] == 1 && out_type == float32 &&
+      wt.shape(1) >= fft_conv_min_taps &&
+      in.shape(1) + padding_lo[0] + padding_hi[0] >= wt.shape(1)) {
+    return fft_conv1d(in, wt, stride[0], padding_lo[0], padding_hi[0], flip, s);
+  }
+
   // Get output shapes
   auto out_shape = conv_out_shape(
       in.shape(),
@@ -4022,7 +4405,7 @@ array conv_general(
 }
 
 void validate_mode(std::string_view tag, const std::string& mode) {
-  if (mode != "affine" && mode != "mxfp4") {
+  if (mode != "affine" && mode != "mxfp4" && mode != "mxfp8") {
     std::ostringstream msg;
     msg << "[" << tag << "] Invalid quantization mode '" << mode << "'.";
     throw std::invalid_argument(msg.str());
@@ -4084,6 +4467,19 @@ array quantized_matmul(
         << "x.dtype() == " << x.dtype() << ".";
     throw std::invalid_argument(msg.str());
   }
+  // No backend has fused mxfp8 matmul kernels yet; decode the weights and
+  // run a regular matmul.
+  if (mode == "mxfp8") {
+    auto wd = astype(
+        dequantize(w, scales, std::nullopt, group_size, bits, mode, s),
+        dtype,
+        s);
+    if (transpose) {
+      wd = swapaxes(wd, -2, -1, s);
+    }
+    return matmul(astype(x, dtype, s), wd, s);
+  }
+
   std::vector<array> inputs;
   if (mode == "affine") {
     inputs = {
@@ -4251,7 +4647,7 @@ std::vector<array> quantize(
 
   if (mode == "affine") {
     return affine_quantize(w, group_size, bits, s);
-  } else {
+  } else if (mode == "mxfp4") {
     if (group_size != 32) {
       std::ostringstream msg;
       msg << "[quantize] mxfp4 quantization requires group size 32 "
@@ -4300,6 +4696,54 @@ std::vector<array> quantize(
     wq = reshape(wq, new_shape, s);
     scales = reshape(scales, new_shape, s);
     return {std::move(wq), std::move(scales)};
+  } else {
+    if (group_size != 32) {
+      std::ostringstream msg;
+      msg << "[quantize] mxfp8 quantization requires group size 32 "
+          << "but got " << group_size << ".";
+      throw std::invalid_argument(msg.str());
+    }
+    if (bits != 8) {
+      std::ostringstream msg;
+      msg << "[quantize] mxfp8 quantization requires bits to be 8 "
+          << "but got " << bits << ".";
+      throw std::invalid_argument(msg.str());
+    }
+
+    auto new_shape = w.shape();
+    new_shape.back() = -1;
+    auto wq = reshape(w, {-1, group_size}, s);
+    auto scales =
+        divide(max(abs(wq, s), -1, true, s), array(448.0f, w.dtype()), s);
+    scales = astype(log2(scales, s), int32, s);
+    wq = divide(wq, power(array(2.0f, w.dtype()), scales, s), s);
+    scales = astype(add(scales, array(127, int32), s), uint8, s);
+
+    // Round each scaled value to e4m3 and assemble the byte arithmetically.
+    // The magnitude is rounded to the nearest multiple of its binade's ulp
+    // (2^(e-3), with everything below 2^-6 treated as a subnormal); a value
+    // that rounds up across a binade boundary lands exactly on the next
+    // exponent's first mantissa, so `8 * (e + 6) + frac` is always a valid
+    // e4m3 encoding.
+    wq = astype(wq, float32, s);
+    auto sign = astype(less(wq, array(0.0f), s), uint32, s);
+    auto mag = minimum(abs(wq, s), array(448.0f), s);
+    auto expo =
+        clip(floor(log2(mag, s), s), array(-6.0f), array(8.0f), s);
+    auto frac = round(
+        multiply(
+            mag, power(array(2.0f), subtract(array(3.0f), expo, s), s), s),
+        s);
+    wq = add(multiply(add(expo, array(6.0f), s), array(8.0f), s), frac, s);
+    wq = bitwise_or(
+        astype(wq, uint32, s), left_shift(sign, array(7, uint32), s), s);
+
+    auto shifts = power(array(2, uint32), arange(0, 32, 8, uint32, s), s);
+    wq = reshape(wq, {-1, group_size / 4, 4}, s);
+    wq = sum(multiply(wq, shifts, s), -1, false, s);
+    wq = reshape(wq, new_shape, s);
+    scales = reshape(scales, new_shape, s);
+    return {std::move(wq), std::move(scales)};
   }
 }
 
@@ -4430,16 +4874,17 @@ array dequantize(
   if (mode == "affine") {
     return affine_dequantize(w, scales, *biases, group_size, bits, s);
   } else {
+    int mode_bits = mode == "mxfp4" ? 4 : 8;
     if (group_size != 32) {
       std::ostringstream msg;
-      msg << "[dequantize] mxfp4 quantization requires group size 32 "
+      msg << "[dequantize] " << mode << " quantization requires group size 32 "
           << "but got " << group_size << ".";
       throw std::invalid_argument(msg.str());
     }
-    if (bits != 4) {
+    if (bits != mode_bits) {
       std::ostringstream msg;
-      msg << "[dequantize] mxfp4 quantization requires bits to be 4 "
-          << "but got " << bits << ".";
+      msg << "[dequantize] " << mode << " quantization requires bits to be "
+          << mode_bits << " but got " << bits << ".";
       throw std::invalid_argument(msg.str());
     }
 
@@ -4477,34 +4922,54 @@ array dequantize(
     }
 
     auto dtype = bfloat16;
-    auto lut = array(
-        {
-            +0.0f,
-            +0.5f,
-            +1.0f,
-            +1.5f,
-            +2.0f,
-            +3.0f,
-            +4.0f,
-            +6.0f,
-            -0.0f,
-            -0.5f,
-            -1.0f,
-            -1.5f,
-            -2.0f,
-            -3.0f,
-            -4.0f,
-            -6.0f,
-        },
-        dtype);
-
-    auto what = view(reshape(w, {-1, group_size / 8}, s), int8, s);
-
-    auto idx_lo = bitwise_and(what, array(0x0F, int8), s);
-    auto idx_hi = right_shift(what, array(4, int8), s);
-    auto lo = gather(lut, idx_lo, 0, {1}, s);
-    auto hi = gather(lut, idx_hi, 0, {1}, s);
-    what = flatten(concatenate({lo, hi}, -1, s), -2, -1, s);
+    array what({0.0f});
+    if (mode == "mxfp4") {
+      auto lut = array(
+          {
+              +0.0f,
+              +0.5f,
+              +1.0f,
+              +1.5f,
+              +2.0f,
+              +3.0f,
+              +4.0f,
+              +6.0f,
+              -0.0f,
+              -0.5f,
+              -1.0f,
+              -1.5f,
+              -2.0f,
+              -3.0f,
+              -4.0f,
+              -6.0f,
+          },
+          dtype);
+
+      what = view(reshape(w, {-1, group_size / 8}, s), int8, s);
+
+      auto idx_lo = bitwise_and(what, array(0x0F, int8), s);
+      auto idx_hi = right_shift(what, array(4, int8), s);
+      auto lo = gather(lut, idx_lo, 0, {1}, s);
+      auto hi = gather(lut, idx_hi, 0, {1}, s);
+      what = flatten(concatenate({lo, hi}, -1, s), -2, -1, s);
+    } else {
+      // Decode table for all 256 e4m3 byte patterns (0x7f/0xff are NaN).
+      std::vector<float> e4m3(256);
+      for (int b = 0; b < 256; ++b) {
+        int m = b & 0x7;
+        int e = (b >> 3) & 0xf;
+        float v = e == 0 ? std::ldexp(float(m), -9)
+                         : std::ldexp(float(8 + m), e - 10);
+        if ((b & 0x7f) == 0x7f) {
+          v = std::numeric_limits<float>::quiet_NaN();
+        }
+        e4m3[b] = (b & 0x80) ? -v : v;
+      }
+      auto lut = astype(array(e4m3.begin(), {256}, float32), dtype, s);
+
+      auto idx = view(reshape(w, {-1, group_size / 4}, s), uint8, s);
+      what = flatten(gather(lut, idx, 0, {1}, s), -2, -1, s);
+    }
     auto exponent = subtract(astype(scales, dtype, s), array(127, dtype), s);
     exponent = reshape(exponent, {-1, 1}, s);
     return reshape(
@@ -4543,6 +5008,25 @@ array gather_qmm(
     throw std::invalid_argument(msg.str());
   }
 
+  // No backend has fused mxfp8 matmul kernels yet; decode the weights and
+  // run a gathered matmul.
+  if (mode == "mxfp8") {
+    auto wd = astype(
+        dequantize(w, scales, std::nullopt, group_size, bits, mode, s),
+        out_type,
+        s);
+    if (transpose) {
+      wd = swapaxes(wd, -2, -1, s);
+    }
+    return gather_mm(
+        astype(x, out_type, s),
+        std::move(wd),
+        lhs_indices_,
+        rhs_indices_,
+        sorted_indices,
+        s);
+  }
+
   // Extract indices and broadcast them
   array lhs_indices = indices_or_default(lhs_indices_, x, s);
   array rhs_indices = indices_or_default(rhs_indices_, w, s);
@@ -5178,6 +5662,361 @@ array segmented_mm(
       {std::move(a), std::move(b), std::move(segments)});
 }
 
+array sparse_matmul(
+    const array& indptr,
+    const array& indices,
+    const array& data,
+    array b,
+    StreamOrDevice s /* = {} */) {
+  if (indptr.ndim() != 1 || indices.ndim() != 1 || data.ndim() != 1) {
+    throw std::invalid_argument(
+        "[sparse_matmul] indptr, indices, and data must be 1-D.");
+  }
+  if (indptr.dtype() != int32 || indices.dtype() != int32) {
+    std::ostringstream msg;
+    msg << "[sparse_matmul] indptr and indices must be int32 but "
+        << indptr.dtype() << " and " << indices.dtype() << " were provided.";
+    throw std::invalid_argument(msg.str());
+  }
+  if (indptr.size() < 1) {
+    throw std::invalid_argument(
+        "[sparse_matmul] indptr must have at least one entry.");
+  }
+  if (indices.size() != data.size()) {
+    std::ostringstream msg;
+    msg << "[sparse_matmul] indices and data must have the same size but "
+        << indices.size() << " and " << data.size() << " were provided.";
+    throw std::invalid_argument(msg.str());
+  }
+  if (b.ndim() != 2) {
+    throw std::invalid_argument("[sparse_matmul] Batched matmul not supported");
+  }
+
+  // Type promotion
+  auto out_type = result_type(data, b);
+  if (!issubdtype(out_type, floating)) {
+    std::ostringstream msg;
+    msg << "[sparse_matmul] Only real floating point types are supported but "
+        << data.dtype() << " and " << b.dtype()
+        << " were provided which results in " << out_type
+        << ", which is not a real floating point type.";
+    throw std::invalid_argument(msg.str());
+  }
+
+  auto data_ = astype(data, out_type, s);
+  b = astype(b, out_type, s);
+
+  Shape out_shape{indptr.shape(0) - 1, b.shape(1)};
+  return array(
+      std::move(out_shape),
+      out_type,
+      std::make_shared<SparseMatmul>(to_stream(s)),
+      {indptr, indices, std::move(data_), std::move(b)});
+}
+
+namespace {
+
+template <typename T>
+std::vector<array> dense_to_csr_impl(const array& in) {
+  int M = in.shape(0);
+  int K = in.shape(1);
+  const T* ptr = in.data<T>();
+  std::vector<int32_t> indptr(M + 1, 0);
+  std::vector<int32_t> cols;
+  std::vector<T> values;
+  for (int i = 0; i < M; ++i) {
+    for (int k = 0; k < K; ++k) {
+      auto v = ptr[static_cast<int64_t>(i) * K + k];
+      if (v != T(0)) {
+        cols.push_back(k);
+        values.push_back(v);
+      }
+    }
+    indptr[i + 1] = static_cast<int32_t>(cols.size());
+  }
+  auto nnz = static_cast<ShapeElem>(cols.size());
+  return {
+      array(indptr.begin(), Shape{M + 1}, int32),
+      array(cols.begin(), Shape{nnz}, int32),
+      array(values.begin(), Shape{nnz}, in.dtype())};
+}
+
+} // namespace
+
+std::vector<array> dense_to_csr(const array& a, StreamOrDevice s /* = {} */) {
+  if (a.ndim() != 2) {
+    throw std::invalid_argument("[dense_to_csr] Input must be a matrix.");
+  }
+  if (!issubdtype(a.dtype(), floating)) {
+    std::ostringstream msg;
+    msg << "[dense_to_csr] Only real floating point types are supported but "
+        << a.dtype() << " was provided.";
+    throw std::invalid_argument(msg.str());
+  }
+
+  // The number of nonzeros is data dependent so the conversion is eager:
+  // evaluate the input and scan it on the host
+  auto in = contiguous(a, /* allow_col_major = */ false, s);
+  in.eval();
+  switch (in.dtype()) {
+    case float32:
+      return dense_to_csr_impl<float>(in);
+    case float64:
+      return dense_to_csr_impl<double>(in);
+    case float16:
+      return dense_to_csr_impl<float16_t>(in);
+    case bfloat16:
+      return dense_to_csr_impl<bfloat16_t>(in);
+    default:
+      throw std::invalid_argument("[dense_to_csr] Unsupported type.");
+  }
+}
+
+namespace {
+
+void validate_segment_reduce(
+    const array& a,
+    const array& segment_ids,
+    int num_segments,
+    const char* fn_name) {
+  if (a.ndim() < 1) {
+    std::ostringstream msg;
+    msg << "[" << fn_name << "] Input must have at least one dimension.";
+    throw std::invalid_argument(msg.str());
+  }
+  if (segment_ids.ndim() != 1) {
+    std::ostringstream msg;
+    msg << "[" << fn_name << "] segment_ids must be 1-D but has "
+        << segment_ids.ndim() << " dimensions.";
+    throw std::invalid_argument(msg.str());
+  }
+  if (!issubdtype(segment_ids.dtype(), integer)) {
+    std::ostringstream msg;
+    msg << "[" << fn_name << "] segment_ids must be integral but "
+        << segment_ids.dtype() << " was provided.";
+    throw std::invalid_argument(msg.str());
+  }
+  if (segment_ids.shape(0) != a.shape(0)) {
+    std::ostringstream msg;
+    msg << "[" << fn_name << "] Number of segment ids ("
+        << segment_ids.shape(0) << ") does not match the first dimension of "
+        << "the input (" << a.shape(0) << ").";
+    throw std::invalid_argument(msg.str());
+  }
+  if (num_segments <= 0) {
+    std::ostringstream msg;
+    msg << "[" << fn_name << "] num_segments must be positive but "
+        << num_segments << " was provided.";
+    throw std::invalid_argument(msg.str());
+  }
+}
+
+// Rows whose id falls outside [0, num_segments) are dropped: their id is
+// redirected to segment 0 and their values are replaced with the reduction's
+// identity so they cannot scatter out of bounds. Returns the sanitized ids
+// and values.
+std::pair<array, array> mask_segment_ids(
+    const array& a,
+    const array& segment_ids,
+    int num_segments,
+    const array& init,
+    StreamOrDevice s) {
+  auto ids = astype(segment_ids, int32, s);
+  auto valid = logical_and(
+      greater_equal(ids, array(0, int32), s),
+      less(ids, array(num_segments, int32), s),
+      s);
+  auto safe_ids = astype(where(valid, ids, array(0, int32), s), uint32, s);
+  for (int i = 1; i < a.ndim(); ++i) {
+    valid = expand_dims(valid, -1, s);
+  }
+  return {std::move(safe_ids), where(valid, a, init, s)};
+}
+
+} // namespace
+
+array segment_sum(
+    const array& a,
+    const array& segment_ids,
+    int num_segments,
+    StreamOrDevice s /* = {} */) {
+  validate_segment_reduce(a, segment_ids, num_segments, "segment_sum");
+  auto out_shape = a.shape();
+  out_shape[0] = num_segments;
+  auto out = zeros(std::move(out_shape), a.dtype(), s);
+  auto [ids, vals] =
+      mask_segment_ids(a, segment_ids, num_segments, array(0, a.dtype()), s);
+  return scatter_add(out, ids, expand_dims(vals, 1, s), 0, s);
+}
+
+array segment_max(
+    const array& a,
+    const array& segment_ids,
+    int num_segments,
+    StreamOrDevice s /* = {} */) {
+  validate_segment_reduce(a, segment_ids, num_segments, "segment_max");
+  auto init = [&]() -> array {
+    switch (a.dtype()) {
+      case bool_:
+        return array(false);
+      case uint8:
+      case uint16:
+      case uint32:
+      case uint64:
+        return array(0, a.dtype());
+      case int8:
+        return array(std::numeric_limits<int8_t>::min(), int8);
+      case int16:
+        return array(std::numeric_limits<int16_t>::min(), int16);
+      case int32:
+        return array(std::numeric_limits<int32_t>::min(), int32);
+      case int64:
+        return array(std::numeric_limits<int64_t>::min(), int64);
+      case float16:
+      case float32:
+      case float64:
+      case bfloat16:
+        return array(-std::numeric_limits<float>::infinity(), a.dtype());
+      default: {
+        std::ostringstream msg;
+        msg << "[segment_max] Unsupported type " << a.dtype() << ".";
+        throw std::invalid_argument(msg.str());
+      }
+    }
+  }();
+  auto out_shape = a.shape();
+  out_shape[0] = num_segments;
+  auto out = full(std::move(out_shape), init, s);
+  auto [ids, vals] = mask_segment_ids(a, segment_ids, num_segments, init, s);
+  return scatter_max(out, ids, expand_dims(vals, 1, s), 0, s);
+}
+
+std::pair<array, array> masked_select(
+    const array& a,
+    const array& mask,
+    StreamOrDevice s /* = {} */) {
+  if (mask.dtype() != bool_) {
+    std::ostringstream msg;
+    msg << "[masked_select] Expected boolean mask but got mask with dtype "
+        << mask.dtype() << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  auto inputs = broadcast_arrays({a, mask}, s);
+  auto af = flatten(inputs[0], s);
+  auto mf = flatten(inputs[1], s);
+
+  // The destination of each selected element is the number of selected
+  // elements before it, computed with an O(n) scan rather than a sort.
+  // Unselected elements scatter a zero onto an already filled slot so
+  // only the selected values land.
+  auto selected = astype(mf, int32, s);
+  auto count = astype(sum(selected, s), uint32, s);
+  auto pos = maximum(
+      subtract(cumsum(selected, 0, false, true, s), array(1, int32), s),
+      array(0, int32),
+      s);
+  auto updates = where(mf, af, array(0, af.dtype()), s);
+  auto out = scatter_add(
+      zeros(af.shape(), af.dtype(), s),
+      astype(pos, uint32, s),
+      expand_dims(updates, 1, s),
+      0,
+      s);
+  return {out, count};
+}
+
+std::pair<array, array> nonzero(const array& a, StreamOrDevice s /* = {} */) {
+  auto mask = flatten(astype(a, bool_, s), s);
+  auto idx = arange(0.0, static_cast<double>(mask.size()), 1.0, uint32, s);
+  return masked_select(idx, mask, s);
+}
+
+std::vector<array> rle_encode(const array& a, StreamOrDevice s /* = {} */) {
+  if (a.ndim() != 1) {
+    std::ostringstream msg;
+    msg << "[rle_encode] Expected a 1-D array but got array with shape "
+        << a.shape() << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  if (!issubdtype(a.dtype(), integer) && a.dtype() != bool_) {
+    std::ostringstream msg;
+    msg << "[rle_encode] Can only encode integer or boolean arrays but got "
+        << "array with type " << a.dtype() << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  auto n = a.shape(0);
+  if (n == 0) {
+    return {a, zeros({0}, uint32, s), array(0, uint32)};
+  }
+
+  // A run starts wherever the value changes
+  auto flags = concatenate(
+      {array({true}),
+       not_equal(slice(a, {1}, {n}, s), slice(a, {0}, {n - 1}, s), s)},
+      0,
+      s);
+  auto run_idx = astype(
+      subtract(cumsum(astype(flags, int32, s), 0, false, true, s),
+               array(1, int32),
+               s),
+      uint32,
+      s);
+  auto count = astype(sum(astype(flags, uint32, s), s), uint32, s);
+
+  // Every element of a run scatters the same value, so the unordered
+  // overwrite is deterministic; the lengths accumulate one per element
+  auto values = scatter(
+      zeros({n}, a.dtype(), s), run_idx, expand_dims(a, 1, s), 0, s);
+  auto lengths = scatter_add(
+      zeros({n}, uint32, s), run_idx, ones({n, 1}, uint32, s), 0, s);
+  return {values, lengths, count};
+}
+
+array rle_decode(
+    const array& values,
+    const array& lengths,
+    int size,
+    StreamOrDevice s /* = {} */) {
+  if (values.ndim() != 1 || lengths.ndim() != 1 ||
+      values.shape(0) != lengths.shape(0)) {
+    std::ostringstream msg;
+    msg << "[rle_decode] Expected 1-D values and lengths of the same size "
+        << "but got shapes " << values.shape() << " and " << lengths.shape()
+        << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  if (!issubdtype(lengths.dtype(), integer)) {
+    std::ostringstream msg;
+    msg << "[rle_decode] Expected integer lengths but got array with type "
+        << lengths.dtype() << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  if (size < 0) {
+    std::ostringstream msg;
+    msg << "[rle_decode] Size must be non-negative but got " << size << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  if (size == 0) {
+    return zeros({0}, values.dtype(), s);
+  }
+  if (values.shape(0) == 0) {
+    throw std::invalid_argument(
+        "[rle_decode] Cannot decode empty runs into a non-empty array.");
+  }
+
+  // Mark the start of every non-empty run, then the inclusive scan of the
+  // markers numbers each output position by its run
+  auto len = astype(lengths, int32, s);
+  auto offsets = subtract(cumsum(len, 0, false, true, s), len, s);
+  auto valid = astype(greater(len, array(0, int32), s), int32, s);
+  auto idx = astype(minimum(offsets, array(size - 1, int32), s), uint32, s);
+  auto marks = scatter_add(
+      zeros({size}, int32, s), idx, expand_dims(valid, 1, s), 0, s);
+  auto run = subtract(
+      cumsum(marks, 0, false, true, s), array(1, int32), s);
+  return take(values, astype(run, uint32, s), 0, s);
+}
+
 array diagonal(
     const array& a,
     int offset /* = 0 */,
@@ -54,6 +54,21 @@ array as_strided(
     size_t offset,
     StreamOrDevice s = {});
 
+/**
+ * Create a view of sliding windows of size `window_size` along `axis`,
+ * advancing by `step` elements between windows, without copying data.
+ *
+ * The window dimension is appended as the last axis of the output. The
+ * resulting strides are validated against the size of the input so the
+ * view cannot read out of bounds.
+ */
+array sliding_window_view(
+    const array& a,
+    int window_size,
+    int axis = -1,
+    int step = 1,
+    StreamOrDevice s = {});
+
 /** Copy another array. */
 array copy(array a, StreamOrDevice s = {});
 
@@ -420,6 +435,20 @@ array where(
     const array& y,
     StreamOrDevice s = {});
 
+/** Fused `where(condition, x + y, 0)` in a single kernel. */
+array masked_add(
+    const array& condition,
+    const array& x,
+    const array& y,
+    StreamOrDevice s = {});
+
+/** Fused `where(condition, x * y, 0)` in a single kernel. */
+array masked_multiply(
+    const array& condition,
+    const array& x,
+    const array& y,
+    StreamOrDevice s = {});
+
 /** Replace NaN and infinities with finite numbers. */
 array nan_to_num(
     const array& a,
@@ -512,6 +541,15 @@ array sum(
     bool keepdims = false,
     StreamOrDevice s = {});
 
+/** Sums the elements of an array along the given axes, accumulating in
+ * `accum_dtype`. The result is cast back to the usual sum dtype. */
+array sum(
+    const array& a,
+    const std::vector<int>& axes,
+    Dtype accum_dtype,
+    bool keepdims = false,
+    StreamOrDevice s = {});
+
 /** Sums the elements of an array along the given axis. */
 array sum(
     const array& a,
@@ -563,6 +601,24 @@ array var(
     int ddof = 0,
     StreamOrDevice s = {});
 
+/** Computes the mean and the variance of the elements of an array along
+ * the given axes in one pass over the data. */
+std::pair<array, array> mean_and_var(
+    const array& a,
+    const std::vector<int>& axes,
+    bool keepdims = false,
+    int ddof = 0,
+    StreamOrDevice s = {});
+
+/** Computes the mean and the variance of the elements of an array along
+ * the given axis in one pass over the data. */
+std::pair<array, array> mean_and_var(
+    const array& a,
+    int axis,
+    bool keepdims = false,
+    int ddof = 0,
+    StreamOrDevice s = {});
+
 /** Computes the standard deviation of the elements of an array. */
 array std(const array& a, bool keepdims, int ddof = 0, StreamOrDevice s = {});
 inline array std(const array& a, StreamOrDevice s = {}) {
@@ -673,6 +729,20 @@ array argmax(
     bool keepdims = false,
     StreamOrDevice s = {});
 
+/** Returns the maximum values and their indices along a given axis
+ * without a second reduction over the data. */
+std::pair<array, array> max_and_argmax(
+    const array& a,
+    int axis,
+    bool keepdims = false,
+    StreamOrDevice s = {});
+
+/** Returns the maximum value of the flattened array and its index. */
+std::pair<array, array> max_and_argmax(
+    const array& a,
+    bool keepdims = false,
+    StreamOrDevice s = {});
+
 /** Returns a sorted copy of the flattened array. */
 array sort(const array& a, StreamOrDevice s = {});
 
@@ -930,6 +1000,18 @@ inline array round(const array& a, StreamOrDevice s = {}) {
 /** Matrix-matrix multiplication. */
 array matmul(const array& a, const array& b, StreamOrDevice s = {});
 
+/** Matrix-matrix multiplication accumulating in `accum_dtype`.
+ *
+ * A performance hint for layers which tolerate reduced precision, e.g.
+ * fp16 accumulation over fp16 operands. Backends without a kernel for
+ * the requested precision accumulate in their default (at least fp32)
+ * precision instead. */
+array matmul(
+    const array& a,
+    const array& b,
+    Dtype accum_dtype,
+    StreamOrDevice s = {});
+
 /** Gather array entries given indices and slices */
 array gather(
     const array& a,
@@ -976,6 +1058,14 @@ array put_along_axis(
     int axis,
     StreamOrDevice s = {});
 
+/**
+ * Count occurrences of each value in `[0, nbins)` along the last axis of an
+ * integer array. Values outside the range are ignored. Leading axes are
+ * treated as a batch, so an input of shape `(..., N)` produces counts of
+ * shape `(..., nbins)`.
+ */
+array bincount(const array& a, int nbins, StreamOrDevice s = {});
+
 /** Add the values into the array at the given indices along the axis */
 array scatter_add_axis(
     const array& a,
@@ -1416,6 +1506,105 @@ array gather_mm(
  */
 array segmented_mm(array a, array b, array segments, StreamOrDevice s = {});
 
+/**
+ * Matrix product of a sparse matrix in CSR form with a dense matrix.
+ *
+ * The sparse operand is given as the CSR triple `indptr`, `indices`
+ * (both `int32`) and `data`: row `i` holds the nonzero values
+ * `data[indptr[i]:indptr[i + 1]]` at the columns
+ * `indices[indptr[i]:indptr[i + 1]]`. `b` is a dense `(K, N)` matrix and
+ * every column index must be smaller than `K`. Only the stored entries
+ * are read and multiplied, so highly pruned matrices cost their nonzeros
+ * rather than their dense shape.
+ */
+array sparse_matmul(
+    const array& indptr,
+    const array& indices,
+    const array& data,
+    array b,
+    StreamOrDevice s = {});
+
+/**
+ * Convert a dense matrix to its CSR triple `{indptr, indices, data}` for
+ * use with `sparse_matmul`.
+ *
+ * The number of nonzeros is data dependent, so the conversion evaluates
+ * the input and scans it on the host; convert pruned weights once at load
+ * time rather than inside a compiled graph.
+ */
+std::vector<array> dense_to_csr(const array& a, StreamOrDevice s = {});
+
+/**
+ * Sum entries of `a` along the first axis grouped by segment.
+ *
+ * `segment_ids` holds one integer id per row of `a` and the output has
+ * shape `(num_segments, ...)` where row `j` is the sum of the rows of `a`
+ * with id `j`. Segments without any entries are zero. The ids do not need
+ * to be sorted and ids outside `[0, num_segments)` are ignored.
+ */
+array segment_sum(
+    const array& a,
+    const array& segment_ids,
+    int num_segments,
+    StreamOrDevice s = {});
+
+/**
+ * Maximum of entries of `a` along the first axis grouped by segment.
+ *
+ * Same layout as `segment_sum`. Segments without any entries are filled
+ * with the lowest value of the dtype (`-inf` for floating point types).
+ */
+array segment_max(
+    const array& a,
+    const array& segment_ids,
+    int num_segments,
+    StreamOrDevice s = {});
+
+/**
+ * Pack the elements of `a` where `mask` is true into the front of an
+ * array, in order.
+ *
+ * `a` and `mask` are broadcast against each other and flattened. Returns
+ * the packed array, which keeps the flattened input size with zeros past
+ * the selected elements, and the number of selected elements as a
+ * ``uint32`` scalar. Shapes stay data independent so the op composes
+ * with transforms; evaluate the count and slice to get a tight result.
+ */
+std::pair<array, array> masked_select(
+    const array& a,
+    const array& mask,
+    StreamOrDevice s = {});
+
+/**
+ * Indices of the nonzero elements of `a` in flattened row-major order.
+ *
+ * Returns the packed ``uint32`` indices, sized like the flattened input
+ * with zeros past the valid entries, and the number of nonzero elements
+ * as a ``uint32`` scalar.
+ */
+std::pair<array, array> nonzero(const array& a, StreamOrDevice s = {});
+
+/**
+ * Run-length encode a 1-D integer array.
+ *
+ * Returns `{values, lengths, count}` where `values` holds one entry per
+ * run, `lengths` (``uint32``) the run lengths, and `count` (``uint32``
+ * scalar) the number of runs. Both arrays keep the input size with zeros
+ * past the valid runs so shapes stay data independent; evaluate the
+ * count and slice to get the compressed result.
+ */
+std::vector<array> rle_encode(const array& a, StreamOrDevice s = {});
+
+/**
+ * Expand run-length encoded `values` and `lengths` back into an array of
+ * `size` elements, the sum of the valid run lengths.
+ */
+array rle_decode(
+    const array& values,
+    const array& lengths,
+    int size,
+    StreamOrDevice s = {});
+
 /** Extract a diagonal or construct a diagonal array */
 array diagonal(
     const array& a,
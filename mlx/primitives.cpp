@@ -342,7 +342,9 @@ std::vector<array> AddMM::jvp(
 
 bool AddMM::is_equivalent(const Primitive& other) const {
   const AddMM& a_other = static_cast<const AddMM&>(other);
-  return (alpha_ == a_other.alpha_ && beta_ == a_other.beta_);
+  return (
+      alpha_ == a_other.alpha_ && beta_ == a_other.beta_ &&
+      activation_ == a_other.activation_);
 }
 
 std::pair<std::vector<array>, std::vector<int>> AddMM::vmap(
@@ -764,6 +766,17 @@ bool AsStrided::is_equivalent(const Primitive& other) const {
       offset_ == a_other.offset_;
 }
 
+bool Bincount::is_equivalent(const Primitive& other) const {
+  const Bincount& b_other = static_cast<const Bincount&>(other);
+  return nbins_ == b_other.nbins_;
+}
+
+std::vector<Shape> Bincount::output_shapes(const std::vector<array>& inputs) {
+  auto shape = inputs[0].shape();
+  shape.back() = nbins_;
+  return {std::move(shape)};
+}
+
 bool BitwiseBinary::is_equivalent(const Primitive& other) const {
   const BitwiseBinary& a_other = static_cast<const BitwiseBinary&>(other);
   return op_ == a_other.op_;
@@ -3020,6 +3033,116 @@ std::pair<std::vector<array>, std::vector<int>> Select::vmap(
   return {{where(a, b, c, stream())}, {to_ax}};
 }
 
+std::vector<array> MaskedAdd::jvp(
+    const std::vector<array>& primals,
+    const std::vector<array>& tangents,
+    const std::vector<int>& argnums) {
+  assert(primals.size() == 3);
+  assert(tangents.size() == 3);
+
+  auto jvp_fun = [&](int i) {
+    int arg = argnums[i];
+    if (arg == 0) {
+      return zeros_like(primals[0], stream());
+    } else {
+      return multiply(
+          astype(primals[0], tangents[arg].dtype(), stream()),
+          tangents[arg],
+          stream());
+    }
+  };
+
+  array jvp = jvp_fun(0);
+  for (int i = 1; i < argnums.size(); i++) {
+    jvp = add(jvp, jvp_fun(i), stream());
+  }
+  return {jvp};
+}
+
+std::vector<array> MaskedAdd::vjp(
+    const std::vector<array>& primals,
+    const std::vector<array>& cotangents,
+    const std::vector<int>& argnums,
+    const std::vector<array>&) {
+  assert(primals.size() == 3);
+  assert(cotangents.size() == 1);
+
+  std::vector<array> vjps;
+  for (auto arg : argnums) {
+    if (arg == 0) {
+      vjps.push_back(zeros_like(primals[0], stream()));
+    } else {
+      vjps.push_back(multiply(
+          astype(primals[0], cotangents[0].dtype(), stream()),
+          cotangents[0],
+          stream()));
+    }
+  }
+  return vjps;
+}
+
+std::pair<std::vector<array>, std::vector<int>> MaskedAdd::vmap(
+    const std::vector<array>& inputs,
+    const std::vector<int>& axes) {
+  auto [a, b, c, to_ax] = vmap_ternary_op(inputs, axes, stream());
+  return {{masked_add(a, b, c, stream())}, {to_ax}};
+}
+
+std::vector<array> MaskedMultiply::jvp(
+    const std::vector<array>& primals,
+    const std::vector<array>& tangents,
+    const std::vector<int>& argnums) {
+  assert(primals.size() == 3);
+  assert(tangents.size() == 3);
+
+  auto jvp_fun = [&](int i) {
+    int arg = argnums[i];
+    if (arg == 0) {
+      return zeros_like(primals[0], stream());
+    } else if (arg == 1) {
+      return masked_multiply(primals[0], tangents[arg], primals[2], stream());
+    } else {
+      return masked_multiply(primals[0], primals[1], tangents[arg], stream());
+    }
+  };
+
+  array jvp = jvp_fun(0);
+  for (int i = 1; i < argnums.size(); i++) {
+    jvp = add(jvp, jvp_fun(i), stream());
+  }
+  return {jvp};
+}
+
+std::vector<array> MaskedMultiply::vjp(
+    const std::vector<array>& primals,
+    const std::vector<array>& cotangents,
+    const std::vector<int>& argnums,
+    const std::vector<array>&) {
+  assert(primals.size() == 3);
+  assert(cotangents.size() == 1);
+
+  std::vector<array> vjps;
+  for (auto arg : argnums) {
+    if (arg == 0) {
+      vjps.push_back(zeros_like(primals[0], stream()));
+    } else if (arg == 1) {
+      vjps.push_back(
+          masked_multiply(primals[0], cotangents[0], primals[2], stream()));
+    } else {
+      vjps.push_back(
+          masked_multiply(primals[0], cotangents[0], primals[1], stream()));
+    }
+  }
+  return vjps;
+}
+
+std::pair<std::vector<array>, std::vector<int>> MaskedMultiply::vmap(
+    const std::vector<array>& inputs,
+    const std::vector<int>& axes) {
+  auto [a, b, c, to_ax] = vmap_ternary_op(inputs, axes, stream());
+  return {{masked_multiply(a, b, c, stream())}, {to_ax}};
+}
+
 std::vector<array> Negative::vjp(
     const std::vector<array>& primals,
     const std::vector<array>& cotangents,
@@ -3112,7 +3235,29 @@ std::vector<array> Pad::jvp(
 std::pair<std::vector<array>, std::vector<int>> Pad::vmap(
     const std::vector<array>& inputs,
     const std::vector<int>& axes) {
-  throw std::runtime_error("Pad vmap is NYI.");
+  assert(inputs.size() == 2);
+  if (axes[1] >= 0) {
+    throw std::runtime_error(
+        "[Pad::vmap] vmap over the padding value is not supported.");
+  }
+  auto in = moveaxis(inputs[0], axes[0], 0, stream());
+  // Negative axes stay correct relative to the end; non-negative ones shift
+  // for the leading vmap dimension
+  auto pad_axes = axes_;
+  for (auto& ax : pad_axes) {
+    if (ax >= 0) {
+      ax++;
+    }
+  }
+  return {
+      {pad(in,
+           pad_axes,
+           low_pad_size_,
+           high_pad_size_,
+           inputs[1],
+           "constant",
+           stream())},
+      {0}};
 }
 
 bool Pad::is_equivalent(const Primitive& other) const {
@@ -3211,23 +3356,52 @@ std::pair<std::vector<array>, std::vector<int>> Power::vmap(
 std::string quantization_mode_to_string(QuantizationMode mode) {
   if (mode == QuantizationMode::Affine) {
     return "affine";
-  } else {
+  } else if (mode == QuantizationMode::Mxfp4) {
     return "mxfp4";
+  } else {
+    return "mxfp8";
   }
 }
 
 QuantizationMode string_to_quantization_mode(const std::string& mode) {
   if (mode == "affine") {
     return QuantizationMode::Affine;
-  } else {
+  } else if (mode == "mxfp4") {
     return QuantizationMode::Mxfp4;
+  } else {
+    return QuantizationMode::Mxfp8;
   }
 }
 
 std::pair<std::vector<array>, std::vector<int>> QuantizedMatmul::vmap(
     const std::vector<array>& inputs,
     const std::vector<int>& axes) {
-  throw std::runtime_error("[QuantizedMatmul::vmap] NYI");
+  // Batching over the activations maps onto the batched matmul the op
+  // already supports; the packed weights, scales and biases must be shared
+  // across the vmap
+  for (int i = 1; i < axes.size(); ++i) {
+    if (axes[i] >= 0) {
+      throw std::runtime_error(
+          "[QuantizedMatmul::vmap] vmap over the quantized weights is not supported.");
+    }
+  }
+  auto x = moveaxis(inputs[0], axes[0], 0, stream());
+  std::optional<array> biases = std::nullopt;
+  if (inputs.size() == 4) {
+    biases = inputs[3];
+  }
+  return {
+      {quantized_matmul(
+          std::move(x),
+          inputs[1],
+          inputs[2],
+          std::move(biases),
+          transpose_,
+          group_size_,
+          bits_,
+          quantization_mode_to_string(mode_),
+          stream())},
+      {0}};
 }
 
 std::vector<array> QuantizedMatmul::vjp(
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <optional>
 #include <unordered_set>
 
 #include "mlx/array.h"
@@ -59,6 +60,16 @@ class Primitive {
     return stream_;
   }
 
+  /**
+   * Reassign the stream the primitive will run on.
+   *
+   * Used by the concurrent eval mode to balance same-level primitives
+   * across CPU streams just before dispatch.
+   */
+  void set_stream(Stream stream) {
+    stream_ = stream;
+  }
+
   /**
    * A primitive must know how to evaluate itself on
    * the CPU/GPU for the given inputs and populate the output arrays.
@@ -151,7 +162,7 @@ class UnaryPrimitive : public Primitive {
   UnaryPrimitive& operator=(UnaryPrimitive&& other) = delete;
 };
 
-enum class QuantizationMode { Affine, Mxfp4 };
+enum class QuantizationMode { Affine, Mxfp4, Mxfp8 };
 
 std::string quantization_mode_to_string(QuantizationMode mode);
 QuantizationMode string_to_quantization_mode(const std::string& mode);
@@ -186,8 +197,20 @@ class Add : public UnaryPrimitive {
 
 class AddMM : public UnaryPrimitive {
  public:
-  explicit AddMM(Stream stream, float alpha, float beta)
-      : UnaryPrimitive(stream), alpha_(alpha), beta_(beta) {}
+  // Activation folded into the gemm's epilogue. Only the eval-time fusion
+  // pass (MLX_FUSE_GEMM_EPILOGUE) sets it, on streams whose backend applies
+  // it, so it never appears in traced graphs or transforms.
+  enum class Activation { None, Relu };
+
+  explicit AddMM(
+      Stream stream,
+      float alpha,
+      float beta,
+      Activation activation = Activation::None)
+      : UnaryPrimitive(stream),
+        alpha_(alpha),
+        beta_(beta),
+        activation_(activation) {}
 
   void eval_cpu(const std::vector<array>& inputs, array& out) override;
   void eval_gpu(const std::vector<array>& inputs, array& out) override;
@@ -200,10 +223,14 @@ class AddMM : public UnaryPrimitive {
   std::pair<float, float> state() const {
     return {alpha_, beta_};
   };
+  Activation activation() const {
+    return activation_;
+  }
 
  private:
   const float alpha_;
   const float beta_;
+  const Activation activation_;
 };
 
 class Arange : public UnaryPrimitive {
@@ -481,6 +508,25 @@ class BitwiseBinary : public UnaryPrimitive {
   Op op_;
 };
 
+class Bincount : public UnaryPrimitive {
+ public:
+  explicit Bincount(Stream stream, int nbins)
+      : UnaryPrimitive(stream), nbins_(nbins) {}
+
+  void eval_cpu(const std::vector<array>& inputs, array& out) override;
+  void eval_gpu(const std::vector<array>& inputs, array& out) override;
+
+  DEFINE_NAME(Bincount)
+  bool is_equivalent(const Primitive& other) const override;
+  std::vector<Shape> output_shapes(const std::vector<array>& inputs) override;
+  auto state() const {
+    return nbins_;
+  }
+
+ private:
+  int nbins_;
+};
+
 class BitwiseInvert : public UnaryPrimitive {
  public:
   explicit BitwiseInvert(Stream stream) : UnaryPrimitive(stream) {}
@@ -558,6 +604,17 @@ class SegmentedMM : public UnaryPrimitive {
   DEFINE_NAME(SegmentedMM)
 };
 
+class SparseMatmul : public UnaryPrimitive {
+ public:
+  explicit SparseMatmul(Stream stream) : UnaryPrimitive(stream) {}
+
+  void eval_cpu(const std::vector<array>& inputs, array& out) override;
+  void eval_gpu(const std::vector<array>& inputs, array& out) override;
+
+  DEFINE_NAME(SparseMatmul)
+  DEFINE_DEFAULT_IS_EQUIVALENT()
+};
+
 class BroadcastAxes : public UnaryPrimitive {
  public:
   explicit BroadcastAxes(Stream stream, std::vector<int> ignore_axes = {})
@@ -654,6 +711,10 @@ class Compiled : public Primitive {
     return kernel_lib_;
   }
 
+  const std::vector<array>& tape() const {
+    return tape_;
+  }
+
  private:
   const std::vector<array> inputs_;
   const std::vector<array> outputs_;
@@ -935,6 +996,34 @@ class Select : public UnaryPrimitive {
   DEFINE_INPUT_OUTPUT_SHAPE()
 };
 
+class MaskedAdd : public UnaryPrimitive {
+ public:
+  explicit MaskedAdd(Stream stream) : UnaryPrimitive(stream) {}
+
+  void eval_cpu(const std::vector<array>& inputs, array& out) override;
+  void eval_gpu(const std::vector<array>& inputs, array& out) override;
+
+  DEFINE_VMAP()
+  DEFINE_GRADS()
+  DEFINE_NAME(MaskedAdd)
+  DEFINE_DEFAULT_IS_EQUIVALENT()
+  DEFINE_INPUT_OUTPUT_SHAPE()
+};
+
+class MaskedMultiply : public UnaryPrimitive {
+ public:
+  explicit MaskedMultiply(Stream stream) : UnaryPrimitive(stream) {}
+
+  void eval_cpu(const std::vector<array>& inputs, array& out) override;
+  void eval_gpu(const std::vector<array>& inputs, array& out) override;
+
+  DEFINE_VMAP()
+  DEFINE_GRADS()
+  DEFINE_NAME(MaskedMultiply)
+  DEFINE_DEFAULT_IS_EQUIVALENT()
+  DEFINE_INPUT_OUTPUT_SHAPE()
+};
+
 class Remainder : public UnaryPrimitive {
  public:
   explicit Remainder(Stream stream) : UnaryPrimitive(stream) {}
@@ -1416,7 +1505,10 @@ class LogSumExp : public UnaryPrimitive {
 
 class Matmul : public UnaryPrimitive {
  public:
-  explicit Matmul(Stream stream) : UnaryPrimitive(stream) {}
+  explicit Matmul(
+      Stream stream,
+      std::optional<Dtype> accum_dtype = std::nullopt)
+      : UnaryPrimitive(stream), accum_dtype_(accum_dtype) {}
 
   void eval_cpu(const std::vector<array>& inputs, array& out) override;
   void eval_gpu(const std::vector<array>& inputs, array& out) override;
@@ -1424,8 +1516,19 @@ class Matmul : public UnaryPrimitive {
   DEFINE_GRADS()
   DEFINE_VMAP()
   DEFINE_NAME(Matmul)
-  DEFINE_DEFAULT_IS_EQUIVALENT()
+  bool is_equivalent(const Primitive& other) const override {
+    return accum_dtype_ == static_cast<const Matmul&>(other).accum_dtype_;
+  }
   std::vector<Shape> output_shapes(const std::vector<array>& inputs) override;
+
+  std::optional<Dtype> accum_dtype() const {
+    return accum_dtype_;
+  }
+
+ private:
+  // Requested accumulation precision; backends without a matching kernel
+  // accumulate in their default (at least fp32) precision
+  std::optional<Dtype> accum_dtype_;
 };
 
 class Maximum : public UnaryPrimitive {
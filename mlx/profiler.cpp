@@ -0,0 +1,149 @@
+// Copyright © 2025 Apple Inc.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+
+#include "mlx/profiler.h"
+
+namespace mlx::core {
+
+namespace {
+
+struct Profiler {
+  std::atomic<bool> enabled{false};
+  std::chrono::steady_clock::time_point origin;
+  std::vector<ProfileEvent> events;
+  std::mutex mtx;
+};
+
+Profiler& profiler() {
+  static Profiler profiler_;
+  return profiler_;
+}
+
+struct StartupTrace {
+  std::mutex mtx;
+  std::vector<InitStage> stages;
+};
+
+StartupTrace& startup_trace_() {
+  static StartupTrace trace_;
+  return trace_;
+}
+
+} // namespace
+
+void enable_profiling(bool enable /* = true */) {
+  auto& p = profiler();
+  std::lock_guard<std::mutex> lock(p.mtx);
+  if (enable && !p.enabled.load(std::memory_order_relaxed)) {
+    p.origin = std::chrono::steady_clock::now();
+  }
+  p.enabled.store(enable, std::memory_order_relaxed);
+}
+
+bool profiling_enabled() {
+  return profiler().enabled.load(std::memory_order_relaxed);
+}
+
+std::vector<ProfileEvent> profile_snapshot() {
+  auto& p = profiler();
+  std::lock_guard<std::mutex> lock(p.mtx);
+  return p.events;
+}
+
+std::vector<ProfileSummaryEntry> profile_summary() {
+  std::vector<ProfileSummaryEntry> summary;
+  for (auto& e : profile_snapshot()) {
+    auto it = std::find_if(summary.begin(), summary.end(), [&e](auto& entry) {
+      return entry.primitive == e.primitive;
+    });
+    if (it == summary.end()) {
+      summary.push_back({e.primitive, 1, e.duration_us, e.bytes, 0.0});
+    } else {
+      it->count++;
+      it->duration_us += e.duration_us;
+      it->bytes += e.bytes;
+    }
+  }
+  for (auto& entry : summary) {
+    entry.gigabytes_per_second = entry.duration_us == 0
+        ? 0.0
+        : (entry.bytes * 1e-3) / static_cast<double>(entry.duration_us);
+  }
+  std::sort(summary.begin(), summary.end(), [](auto& a, auto& b) {
+    return a.duration_us > b.duration_us;
+  });
+  return summary;
+}
+
+void clear_profile() {
+  auto& p = profiler();
+  std::lock_guard<std::mutex> lock(p.mtx);
+  p.events.clear();
+}
+
+std::vector<InitStage> startup_trace() {
+  auto& t = startup_trace_();
+  std::lock_guard<std::mutex> lock(t.mtx);
+  return t.stages;
+}
+
+void write_chrome_trace(const std::string& file) {
+  std::ofstream f(file);
+  if (!f.is_open()) {
+    std::ostringstream msg;
+    msg << "[write_chrome_trace] Unable to open " << file << " for writing.";
+    throw std::runtime_error(msg.str());
+  }
+  auto events = profile_snapshot();
+  f << "{\"traceEvents\":[";
+  for (size_t i = 0; i < events.size(); ++i) {
+    auto& e = events[i];
+    if (i > 0) {
+      f << ",";
+    }
+    f << "{\"name\":\"" << e.primitive << "\",\"cat\":\"primitive\","
+      << "\"ph\":\"X\",\"pid\":0,\"tid\":" << e.stream
+      << ",\"ts\":" << e.start_us << ",\"dur\":" << e.duration_us
+      << ",\"args\":{\"bytes\":" << e.bytes << "}}";
+  }
+  f << "]}";
+}
+
+namespace detail {
+
+uint64_t profile_clock_us() {
+  auto& p = profiler();
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - p.origin)
+      .count();
+}
+
+void record_profile_event(
+    const char* primitive,
+    uint32_t stream,
+    uint64_t start_us,
+    uint64_t duration_us,
+    uint64_t bytes) {
+  auto& p = profiler();
+  std::lock_guard<std::mutex> lock(p.mtx);
+  p.events.push_back({primitive, stream, start_us, duration_us, bytes});
+}
+
+void record_init_stage(
+    const char* name,
+    uint64_t start_us,
+    uint64_t duration_us) {
+  auto& t = startup_trace_();
+  std::lock_guard<std::mutex> lock(t.mtx);
+  t.stages.push_back({name, start_us, duration_us});
+}
+
+} // namespace detail
+
+} // namespace mlx::core
@@ -0,0 +1,115 @@
+// Copyright © 2025 Apple Inc.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mlx::core {
+
+/* One recorded primitive dispatch: the wall time spent dispatching the
+ * primitive from eval and the bytes of its outputs.
+ * */
+struct ProfileEvent {
+  std::string primitive;
+  uint32_t stream;
+  uint64_t start_us;
+  uint64_t duration_us;
+  uint64_t bytes;
+};
+
+/* Enable or disable per-primitive profiling.
+ *
+ * While enabled, every primitive dispatched from eval is recorded with
+ * its stream, its dispatch wall time and its output bytes. Events
+ * accumulate across evals until cleared. Recording is one timestamp pair
+ * and one vector push per primitive, so the overhead is small but not
+ * zero; leave it off outside performance investigations.
+ * */
+void enable_profiling(bool enable = true);
+
+/* Check if profiling is currently enabled. */
+bool profiling_enabled();
+
+/* One row of the aggregated profile: all events with the same name
+ * folded together, with the achieved bandwidth implied by their bytes
+ * and duration.
+ * */
+struct ProfileSummaryEntry {
+  std::string primitive;
+  size_t count;
+  uint64_t duration_us;
+  uint64_t bytes;
+  double gigabytes_per_second;
+};
+
+/* Snapshot the recorded events in dispatch order. */
+std::vector<ProfileEvent> profile_snapshot();
+
+/* Aggregate the recorded events by name, sorted by descending total
+ * duration. On Metal the "command_buffer" rows carry device-side
+ * execution times and bytes, so their bandwidth column is the achieved
+ * GB/s to compare against the roofline; per-primitive rows carry host
+ * dispatch times.
+ * */
+std::vector<ProfileSummaryEntry> profile_summary();
+
+/* Reset the recorded events. */
+void clear_profile();
+
+/* Write the recorded events to `file` as chrome://tracing JSON. Streams
+ * show up as threads so per-stream timelines line up in the viewer.
+ * */
+void write_chrome_trace(const std::string& file);
+
+/* One stage of library initialization: scheduler thread creation, Metal
+ * device load, kernel library load, and so on.
+ * */
+struct InitStage {
+  std::string name;
+  uint64_t start_us;
+  uint64_t duration_us;
+};
+
+/* The initialization stages recorded so far, in order. Stages are always
+ * recorded — they run once and there are only a handful — so the cost of
+ * a cold start can be broken down after the fact.
+ * */
+std::vector<InitStage> startup_trace();
+
+namespace detail {
+
+/* Microseconds since profiling was enabled. */
+uint64_t profile_clock_us();
+
+/* Append one stage to the startup trace. */
+void record_init_stage(
+    const char* name,
+    uint64_t start_us,
+    uint64_t duration_us);
+
+/* Records the enclosing scope as one init stage. */
+struct ScopedInitStage {
+  explicit ScopedInitStage(const char* name)
+      : name_(name), start_us_(profile_clock_us()) {}
+  ~ScopedInitStage() {
+    record_init_stage(name_, start_us_, profile_clock_us() - start_us_);
+  }
+
+ private:
+  const char* name_;
+  uint64_t start_us_;
+};
+
+/* Append one event to the profile. */
+void record_profile_event(
+    const char* primitive,
+    uint32_t stream,
+    uint64_t start_us,
+    uint64_t duration_us,
+    uint64_t bytes);
+
+} // namespace detail
+
+} // namespace mlx::core
@@ -11,16 +11,21 @@
 
 namespace mlx::core::random {
 
-KeySequence::KeySequence(uint64_t seed) : key_(key(seed)) {}
+KeySequence::KeySequence(uint64_t seed) : seed_(seed), counter_(0) {}
 
 void KeySequence::seed(uint64_t seed) {
-  key_ = key((seed));
+  seed_ = seed;
+  counter_ = 0;
 }
 
 array KeySequence::next() {
-  auto out = split(key_);
-  key_ = out.first;
-  return out.second;
+  // Mix the seed with a per-call counter on the host rather than building a
+  // key-split graph per call. The mix is splitmix64 so nearby counters still
+  // give well separated keys.
+  uint64_t z = seed_ + counter_++ * 0x9E3779B97F4A7C15ull;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return key(z ^ (z >> 31));
 }
 
 void seed(uint64_t seed) {
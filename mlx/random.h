@@ -25,7 +25,8 @@ class KeySequence {
   }
 
  private:
-  array key_;
+  uint64_t seed_;
+  uint64_t counter_;
   static uint64_t get_current_time_seed() {
     auto now = std::chrono::system_clock::now();
     return std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -1,5 +1,7 @@
 // Copyright © 2023 Apple Inc.
 
+#include <chrono>
+
 #include "mlx/scheduler.h"
 #include "mlx/backend/gpu/available.h"
 #include "mlx/backend/gpu/eval.h"
@@ -34,10 +36,22 @@ Stream new_stream(Device d) {
   return scheduler::scheduler().new_stream(d);
 }
 
+Stream new_stream(Device d, StreamPriority priority) {
+  if (!gpu::is_available() && d == Device::gpu) {
+    throw std::invalid_argument(
+        "[new_stream] Cannot make gpu stream without gpu backend.");
+  }
+  return scheduler::scheduler().new_stream(d, priority);
+}
+
 Stream new_stream() {
   return scheduler::scheduler().new_stream(default_device());
 }
 
+StreamPriority get_stream_priority(int index) {
+  return scheduler::scheduler().get_stream_priority(index);
+}
+
 void synchronize(Stream s) {
   if (s.device == mlx::core::Device::cpu) {
     auto p = std::make_shared<std::promise<void>>();
@@ -55,6 +69,148 @@ void synchronize() {
 
 namespace scheduler {
 
+namespace {
+
+// Number of task timings retained per stream. Old entries are overwritten
+// so a long run keeps a recent window rather than growing without bound.
+constexpr size_t task_ring_size = 1024;
+
+struct StreamQueueStats {
+  // Tasks enqueued but not yet completed, including the running one
+  std::atomic<int> depth{0};
+  std::mutex mtx;
+  std::vector<TaskTiming> ring{std::vector<TaskTiming>(task_ring_size)};
+  // Total tasks recorded; ring[count % task_ring_size] is the next slot
+  size_t count{0};
+};
+
+struct QueueStats {
+  std::atomic<bool> enabled{false};
+  std::chrono::steady_clock::time_point origin{
+      std::chrono::steady_clock::now()};
+  std::mutex mtx;
+  std::vector<std::unique_ptr<StreamQueueStats>> streams;
+
+  StreamQueueStats& for_stream(int index) {
+    std::lock_guard<std::mutex> lk(mtx);
+    while (streams.size() <= static_cast<size_t>(index)) {
+      streams.push_back(std::make_unique<StreamQueueStats>());
+    }
+    return *streams[index];
+  }
+};
+
+QueueStats& queue_stats() {
+  static QueueStats stats;
+  return stats;
+}
+
+// Per-stream error state. Errors are recorded from worker and driver
+// completion threads and queried from user threads, so every entry has
+// its own lock.
+struct StreamErrorState {
+  std::mutex mtx;
+  std::exception_ptr error;
+  StreamErrorHandler handler;
+};
+
+struct StreamErrors {
+  std::mutex mtx;
+  std::vector<std::unique_ptr<StreamErrorState>> streams;
+
+  StreamErrorState& for_stream(int index) {
+    std::lock_guard<std::mutex> lk(mtx);
+    while (streams.size() <= static_cast<size_t>(index)) {
+      streams.push_back(std::make_unique<StreamErrorState>());
+    }
+    return *streams[index];
+  }
+};
+
+StreamErrors& stream_errors() {
+  static StreamErrors errors;
+  return errors;
+}
+
+} // namespace
+
+void enable_queue_stats(bool enable /* = true */) {
+  queue_stats().enabled = enable;
+}
+
+bool queue_stats_enabled() {
+  return queue_stats().enabled.load(std::memory_order_relaxed);
+}
+
+uint64_t queue_clock_us() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - queue_stats().origin)
+      .count();
+}
+
+void note_task_enqueued(int stream_index) {
+  queue_stats().for_stream(stream_index).depth.fetch_add(
+      1, std::memory_order_relaxed);
+}
+
+void record_task_timing(int stream_index, const TaskTiming& timing) {
+  auto& stats = queue_stats().for_stream(stream_index);
+  stats.depth.fetch_sub(1, std::memory_order_relaxed);
+  std::lock_guard<std::mutex> lk(stats.mtx);
+  stats.ring[stats.count++ % task_ring_size] = timing;
+}
+
+int queue_depth(const Stream& stream) {
+  return queue_stats().for_stream(stream.index).depth.load(
+      std::memory_order_relaxed);
+}
+
+std::vector<TaskTiming> queue_timings(const Stream& stream) {
+  auto& stats = queue_stats().for_stream(stream.index);
+  std::lock_guard<std::mutex> lk(stats.mtx);
+  auto n = std::min(stats.count, task_ring_size);
+  std::vector<TaskTiming> timings;
+  timings.reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    timings.push_back(stats.ring[(stats.count - n + i) % task_ring_size]);
+  }
+  return timings;
+}
+
+std::vector<size_t> queue_latency_histogram(const Stream& stream) {
+  // Enough power-of-two buckets to cover waits up to ~17 minutes
+  std::vector<size_t> histogram(30, 0);
+  for (auto& timing : queue_timings(stream)) {
+    auto wait = timing.start_us - timing.enqueue_us;
+    size_t bucket = 0;
+    while ((wait >> (bucket + 1)) != 0 && bucket + 1 < histogram.size()) {
+      bucket++;
+    }
+    histogram[bucket]++;
+  }
+  return histogram;
+}
+
+void record_stream_error(int stream_index, std::exception_ptr error) {
+  auto& state = stream_errors().for_stream(stream_index);
+  StreamErrorHandler handler;
+  {
+    std::lock_guard<std::mutex> lk(state.mtx);
+    if (!state.error) {
+      state.error = error;
+    }
+    handler = state.handler;
+  }
+  if (handler) {
+    // The handler runs on whatever thread hit the failure; a throwing
+    // handler would take that thread down, so swallow its errors
+    try {
+      handler(scheduler().get_stream(stream_index), error);
+    } catch (...) {
+    }
+  }
+}
+
 /** A singleton scheduler to manage devices, streams, and task execution. */
 Scheduler& scheduler() {
   // Leak the scheduler on Windows to avoid joining threads on exit, can be
@@ -70,4 +226,25 @@ Scheduler& scheduler() {
 }
 
 } // namespace scheduler
+
+bool stream_has_error(const Stream& s) {
+  auto& state = scheduler::stream_errors().for_stream(s.index);
+  std::lock_guard<std::mutex> lk(state.mtx);
+  return state.error != nullptr;
+}
+
+std::exception_ptr take_stream_error(const Stream& s) {
+  auto& state = scheduler::stream_errors().for_stream(s.index);
+  std::lock_guard<std::mutex> lk(state.mtx);
+  auto error = state.error;
+  state.error = nullptr;
+  return error;
+}
+
+void set_stream_error_handler(const Stream& s, StreamErrorHandler handler) {
+  auto& state = scheduler::stream_errors().for_stream(s.index);
+  std::lock_guard<std::mutex> lk(state.mtx);
+  state.handler = std::move(handler);
+}
+
 } // namespace mlx::core
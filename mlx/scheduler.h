@@ -4,24 +4,102 @@
 
 #include <atomic>
 #include <future>
+#include <memory>
 #include <queue>
 #include <thread>
 #include <unordered_map>
 
+#include "mlx/backend/common/numa.h"
 #include "mlx/backend/gpu/eval.h"
 #include "mlx/device.h"
+#include "mlx/profiler.h"
 #include "mlx/stream.h"
+#include "mlx/utils.h"
+
+#if defined(__APPLE__)
+#include <pthread.h>
+#elif defined(__linux__)
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 namespace mlx::core::scheduler {
 
+// Apply a stream priority to the calling thread. This is a best-effort
+// hint: on Apple platforms it maps to QoS classes, on Linux to niceness
+// (raising priority may be denied without privileges and is ignored).
+inline void set_current_thread_priority(StreamPriority priority) {
+  if (priority == StreamPriority::normal) {
+    return;
+  }
+#if defined(__APPLE__)
+  pthread_set_qos_class_self_np(
+      priority == StreamPriority::high ? QOS_CLASS_USER_INTERACTIVE
+                                       : QOS_CLASS_BACKGROUND,
+      0);
+#elif defined(__linux__)
+  setpriority(
+      PRIO_PROCESS,
+      static_cast<id_t>(syscall(SYS_gettid)),
+      priority == StreamPriority::high ? -5 : 10);
+#endif
+}
+
+/* Timestamps of one scheduled task, in microseconds on the queue-stats
+ * clock: when it was enqueued, when a worker picked it up, and when it
+ * finished. The gap between the first two is time in the scheduler
+ * queue; anything past that is the task itself (for GPU work, the
+ * command encoding, not the kernel).
+ * */
+struct TaskTiming {
+  uint64_t enqueue_us;
+  uint64_t start_us;
+  uint64_t end_us;
+};
+
+/* Enable or disable per-stream queue instrumentation. While enabled
+ * every task enqueued on a stream gets enqueue/dequeue/complete
+ * timestamps kept in a fixed-size ring per stream. */
+void enable_queue_stats(bool enable = true);
+
+bool queue_stats_enabled();
+
+/* Microseconds on the queue-stats clock. */
+uint64_t queue_clock_us();
+
+void note_task_enqueued(int stream_index);
+
+void record_task_timing(int stream_index, const TaskTiming& timing);
+
+/* Tasks currently queued or running on the stream. */
+int queue_depth(const Stream& stream);
+
+/* The most recent task timings for the stream, oldest first. */
+std::vector<TaskTiming> queue_timings(const Stream& stream);
+
+/* Histogram of time-in-queue for the retained tasks of a stream with
+ * power-of-two buckets: entry i counts tasks that waited in
+ * [2^i, 2^(i+1)) microseconds. */
+std::vector<size_t> queue_latency_histogram(const Stream& stream);
+
+/* Record a failure from work running on the stream. Keeps the first
+ * unretrieved error (see take_stream_error) and invokes the stream's
+ * error handler when one is registered. */
+void record_stream_error(int stream_index, std::exception_ptr error);
+
 struct StreamThread {
   std::mutex mtx;
   std::queue<std::function<void()>> q;
   std::condition_variable cond;
   bool stop;
+  StreamPriority priority;
   std::thread thread;
 
-  StreamThread() : stop(false), thread(&StreamThread::thread_fn, this) {}
+  explicit StreamThread(StreamPriority priority = StreamPriority::normal)
+      : stop(false),
+        priority(priority),
+        thread(&StreamThread::thread_fn, this) {}
 
   ~StreamThread() {
     {
@@ -33,6 +111,8 @@ struct StreamThread {
   }
 
   void thread_fn() {
+    set_current_thread_priority(priority);
+    bind_current_thread_to_numa_node();
     while (true) {
       std::function<void()> task;
       {
@@ -63,12 +143,143 @@ struct StreamThread {
   }
 };
 
+// When MLX_CPU_WORK_STEALING is set, CPU streams share a pool of workers
+// instead of each stream owning a dedicated thread. Every stream keeps its
+// own FIFO queue and any idle worker may claim and drain it, so a backlog on
+// one stream is balanced across cores while other streams are quiet. Tasks
+// within a stream still run one at a time and in submission order; stealing
+// happens at stream granularity because the CPU encoder relies on in-order
+// execution within a stream.
+class WorkStealingPool {
+ public:
+  explicit WorkStealingPool(int num_workers) : stop_(false) {
+    for (int i = 0; i < num_workers; ++i) {
+      workers_.emplace_back(&WorkStealingPool::worker_fn, this);
+    }
+  }
+
+  ~WorkStealingPool() {
+    {
+      std::lock_guard<std::mutex> lk(mtx_);
+      stop_ = true;
+    }
+    cond_.notify_all();
+    for (auto& w : workers_) {
+      w.join();
+    }
+  }
+
+  int add_queue() {
+    std::lock_guard<std::mutex> lk(mtx_);
+    queues_.push_back(std::make_unique<StreamQueue>());
+    return queues_.size() - 1;
+  }
+
+  template <typename F>
+  void enqueue(int index, F&& f) {
+    StreamQueue* sq;
+    {
+      std::lock_guard<std::mutex> lk(mtx_);
+      if (stop_) {
+        throw std::runtime_error(
+            "Cannot enqueue work after stream is stopped.");
+      }
+      sq = queues_[index].get();
+    }
+    {
+      std::lock_guard<std::mutex> lk(sq->mtx);
+      sq->q.emplace(std::forward<F>(f));
+    }
+    {
+      std::lock_guard<std::mutex> lk(mtx_);
+      ready_.push(index);
+    }
+    cond_.notify_one();
+  }
+
+ private:
+  struct StreamQueue {
+    std::mutex mtx;
+    std::queue<std::function<void()>> q;
+    std::atomic<bool> active{false};
+  };
+
+  void worker_fn() {
+    bind_current_thread_to_numa_node();
+    while (true) {
+      StreamQueue* sq;
+      {
+        std::unique_lock<std::mutex> lk(mtx_);
+        cond_.wait(lk, [this] { return !ready_.empty() || stop_; });
+        if (ready_.empty() && stop_) {
+          return;
+        }
+        sq = queues_[ready_.front()].get();
+        ready_.pop();
+      }
+      run_queue(sq);
+    }
+  }
+
+  void run_queue(StreamQueue* sq) {
+    while (true) {
+      // Only one worker drains a stream at a time so tasks keep their
+      // submission order. Losing the claim is fine: the active worker loops
+      // until the queue is empty and will pick up the task behind this
+      // ticket.
+      if (sq->active.exchange(true)) {
+        return;
+      }
+      while (true) {
+        std::function<void()> task;
+        {
+          std::lock_guard<std::mutex> lk(sq->mtx);
+          if (sq->q.empty()) {
+            break;
+          }
+          task = std::move(sq->q.front());
+          sq->q.pop();
+        }
+        task();
+      }
+      sq->active.store(false);
+      // Re-check for tasks enqueued between the final empty check and the
+      // release above; their tickets may have been dropped by other workers
+      // while this one still held the claim.
+      {
+        std::lock_guard<std::mutex> lk(sq->mtx);
+        if (sq->q.empty()) {
+          return;
+        }
+      }
+    }
+  }
+
+  std::mutex mtx_;
+  std::condition_variable cond_;
+  bool stop_;
+  std::queue<int> ready_;
+  std::vector<std::unique_ptr<StreamQueue>> queues_;
+  std::vector<std::thread> workers_;
+};
+
 class Scheduler {
  public:
   Scheduler() : n_active_tasks_(0) {
-    if (is_available(Device::gpu)) {
-      default_streams_.insert({Device::gpu, new_stream(Device::gpu)});
+    detail::ScopedInitStage stage("scheduler");
+    if (env::cpu_work_stealing()) {
+      // One worker per CPU of the configured NUMA node, or of the machine
+      // when unpinned
+      int num_workers = std::max(
+          1,
+          static_cast<int>(
+              thread_affinity_cpus().empty()
+                  ? std::thread::hardware_concurrency()
+                  : thread_affinity_cpus().size()));
+      pool_ = std::make_unique<WorkStealingPool>(num_workers);
     }
+    // The GPU default stream is made lazily in get_default_stream so
+    // CPU-only work never pays for backend device initialization
     default_streams_.insert({Device::cpu, new_stream(Device::cpu)});
   }
 
@@ -78,22 +289,41 @@ class Scheduler {
   Scheduler& operator=(const Scheduler&) = delete;
   Scheduler& operator=(Scheduler&&) = delete;
 
-  Stream new_stream(const Device& d) {
+  Stream new_stream(
+      const Device& d,
+      StreamPriority priority = StreamPriority::normal) {
     streams_.emplace_back(streams_.size(), d);
+    // Record the priority before the backend stream exists so backends can
+    // consult it during stream creation
+    priorities_.push_back(priority);
     if (d == Device::gpu) {
       threads_.push_back(nullptr);
+      queue_ids_.push_back(-1);
       gpu::new_stream(streams_.back());
+    } else if (pool_) {
+      threads_.push_back(nullptr);
+      queue_ids_.push_back(pool_->add_queue());
     } else {
-      threads_.push_back(new StreamThread{});
+      threads_.push_back(new StreamThread{priority});
+      queue_ids_.push_back(-1);
     }
     return streams_.back();
   }
 
+  StreamPriority get_stream_priority(int index) const {
+    return priorities_.at(index);
+  }
+
   template <typename F>
   void enqueue(const Stream& stream, F&& f);
 
-  Stream get_default_stream(const Device& d) const {
-    return default_streams_.at(d.type);
+  Stream get_default_stream(const Device& d) {
+    if (auto it = default_streams_.find(d.type); it != default_streams_.end()) {
+      return it->second;
+    }
+    auto s = new_stream(d);
+    default_streams_.insert({d.type, s});
+    return s;
   }
   Stream get_stream(int index) const {
     return streams_.at(index);
@@ -146,7 +376,10 @@ class Scheduler {
 
  private:
   int n_active_tasks_;
+  std::unique_ptr<WorkStealingPool> pool_;
   std::vector<StreamThread*> threads_;
+  std::vector<int> queue_ids_;
+  std::vector<StreamPriority> priorities_;
   std::vector<Stream> streams_;
   std::unordered_map<Device::DeviceType, Stream> default_streams_;
   std::condition_variable completion_cv;
@@ -155,7 +388,40 @@ class Scheduler {
 
 template <typename F>
 void Scheduler::enqueue(const Stream& stream, F&& f) {
-  threads_[stream.index]->enqueue(std::forward<F>(f));
+  // Catch failures on the worker thread so they surface through the
+  // stream's error state (see take_stream_error) instead of unwinding
+  // into the worker loop and terminating the process.
+  auto task = [f = std::forward<F>(f), index = stream.index]() mutable {
+    try {
+      f();
+    } catch (...) {
+      record_stream_error(index, std::current_exception());
+    }
+  };
+  if (queue_stats_enabled()) {
+    note_task_enqueued(stream.index);
+    auto timed_task = [task = std::move(task),
+                       index = stream.index,
+                       enqueue_us = queue_clock_us()]() mutable {
+      TaskTiming timing;
+      timing.enqueue_us = enqueue_us;
+      timing.start_us = queue_clock_us();
+      task();
+      timing.end_us = queue_clock_us();
+      record_task_timing(index, timing);
+    };
+    if (pool_ && stream.device == Device::cpu) {
+      pool_->enqueue(queue_ids_[stream.index], std::move(timed_task));
+    } else {
+      threads_[stream.index]->enqueue(std::move(timed_task));
+    }
+    return;
+  }
+  if (pool_ && stream.device == Device::cpu) {
+    pool_->enqueue(queue_ids_[stream.index], std::move(task));
+  } else {
+    threads_[stream.index]->enqueue(std::move(task));
+  }
 }
 
 Scheduler& scheduler();
@@ -30,12 +30,36 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <type_traits>
 #include <utility>
 
 namespace mlx::core {
 
+namespace detail {
+
+// Counts how often a SmallVector spills from inline to heap storage. The
+// counter only ticks on the (already allocating) grow path, so it costs
+// nothing on the inline fast path; it exists to audit that hot shape and
+// stride manipulation stays allocation free.
+inline std::atomic<size_t>& small_vector_spills() {
+  static std::atomic<size_t> spills{0};
+  return spills;
+}
+
+} // namespace detail
+
+/** The number of times a SmallVector has spilled its inline storage. */
+inline size_t small_vector_spill_count() {
+  return detail::small_vector_spills().load(std::memory_order_relaxed);
+}
+
+/** Reset the SmallVector spill counter, e.g. around a region under audit. */
+inline void reset_small_vector_spill_count() {
+  detail::small_vector_spills().store(0, std::memory_order_relaxed);
+}
+
 #if defined(__has_builtin)
 #define MLX_HAS_BUILTIN(x) __has_builtin(x)
 #else
@@ -444,6 +468,9 @@ class SmallVector {
   // Grows the backing store by a factor of two, and at least to {min_capacity}.
   // TODO: Move to private after removing external code using this method.
   MLX_NOINLINE void grow(size_t min_capacity = 0) {
+    if (!is_big()) {
+      detail::small_vector_spills().fetch_add(1, std::memory_order_relaxed);
+    }
     size_t new_capacity = std::max(min_capacity, 2 * capacity());
     // Round up to power of 2.
     new_capacity--;
@@ -2,6 +2,9 @@
 
 #pragma once
 
+#include <exception>
+#include <functional>
+
 #include "mlx/device.h"
 
 namespace mlx::core {
@@ -18,9 +21,24 @@ Stream default_stream(Device d);
 /** Make the stream the default for its device. */
 void set_default_stream(Stream s);
 
+/**
+ * Relative scheduling priority for work on a stream.
+ *
+ * High priority streams are dispatched ahead of bulk background work where
+ * the platform exposes a knob (thread scheduling for CPU streams, stream
+ * priorities for CUDA). The priority is a hint and is best effort.
+ */
+enum class StreamPriority : int { low = -1, normal = 0, high = 1 };
+
 /** Make a new stream on the given device. */
 Stream new_stream(Device d);
 
+/** Make a new stream on the given device with the given priority. */
+Stream new_stream(Device d, StreamPriority priority);
+
+/** Get the priority of the stream with the given index. */
+StreamPriority get_stream_priority(int index);
+
 /** Get the stream with the given index. */
 Stream get_stream(int index);
 
@@ -32,6 +50,24 @@ inline bool operator!=(const Stream& lhs, const Stream& rhs) {
   return !(lhs == rhs);
 }
 
+/**
+ * Callback invoked when work scheduled on a stream fails. The callback
+ * runs on the stream's worker (or driver completion) thread and must not
+ * throw.
+ */
+using StreamErrorHandler = std::function<void(Stream, std::exception_ptr)>;
+
+/* Whether the stream has an unretrieved error. Never blocks. */
+bool stream_has_error(const Stream& s);
+
+/* Take the first error captured on the stream since the last take, or
+ * null when the stream is healthy. Never blocks. */
+std::exception_ptr take_stream_error(const Stream& s);
+
+/* Register a handler called when work on the stream fails. Pass nullptr
+ * to remove the handler. */
+void set_stream_error_handler(const Stream& s, StreamErrorHandler handler);
+
 /* Synchronize with the default stream. */
 void synchronize();
 
@@ -32,9 +32,18 @@
 #include <thread>
 #include <vector>
 
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 class ThreadPool {
  public:
-  ThreadPool(size_t);
+  // Workers are pinned round-robin over `cpus` when it is non-empty (and
+  // the platform supports thread affinity). When `max_queue` is non-zero,
+  // enqueue blocks once that many tasks are waiting so producers that
+  // outrun the workers see backpressure instead of unbounded queue growth.
+  ThreadPool(size_t threads, std::vector<int> cpus = {}, size_t max_queue = 0);
   template <class F, class... Args>
   auto enqueue(F&& f, Args&&... args)
       -> std::future<typename std::invoke_result_t<F, Args...>>;
@@ -46,13 +55,20 @@ class ThreadPool {
   void start_threads(size_t);
 
   std::vector<std::thread> workers;
+  std::vector<int> cpu_affinity;
   std::queue<std::function<void()>> tasks;
+  size_t max_queue;
   std::mutex queue_mutex;
   std::condition_variable condition;
+  std::condition_variable space;
   bool stop;
 };
 
-inline ThreadPool::ThreadPool(size_t threads) : stop(false) {
+inline ThreadPool::ThreadPool(
+    size_t threads,
+    std::vector<int> cpus,
+    size_t max_queue)
+    : cpu_affinity(std::move(cpus)), max_queue(max_queue), stop(false) {
   start_threads(threads);
 }
 
@@ -68,6 +84,10 @@ auto ThreadPool::enqueue(F&& f, Args&&... args)
   {
     std::unique_lock<std::mutex> lock(queue_mutex);
 
+    if (max_queue > 0) {
+      space.wait(
+          lock, [this] { return stop || tasks.size() < max_queue; });
+    }
     if (stop) {
       throw std::runtime_error(
           "[ThreadPool::enqueue] Not allowed on stopped ThreadPool");
@@ -101,6 +121,7 @@ inline void ThreadPool::stop_and_wait() {
     stop = true;
   }
   condition.notify_all();
+  space.notify_all();
   for (std::thread& worker : workers) {
     worker.join();
   }
@@ -125,9 +146,21 @@ inline void ThreadPool::start_threads(size_t threads) {
           task = std::move(this->tasks.front());
           this->tasks.pop();
         }
+        if (this->max_queue > 0) {
+          this->space.notify_one();
+        }
 
         task();
       }
     });
+#if defined(__linux__)
+    if (!cpu_affinity.empty()) {
+      cpu_set_t set;
+      CPU_ZERO(&set);
+      CPU_SET(cpu_affinity[(workers.size() - 1) % cpu_affinity.size()], &set);
+      pthread_setaffinity_np(
+          workers.back().native_handle(), sizeof(set), &set);
+    }
+#endif
   }
 }
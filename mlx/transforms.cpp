@@ -2,6 +2,7 @@
 #include <algorithm>
 #include <deque>
 #include <future>
+#include <list>
 #include <numeric>
 #include <set>
 #include <sstream>
@@ -9,12 +10,15 @@
 #include <unordered_map>
 #include <unordered_set>
 
+#include "mlx/backend/cpu/encoder.h"
 #include "mlx/backend/cpu/eval.h"
+#include "mlx/backend/cuda/cuda.h"
 #include "mlx/backend/gpu/eval.h"
 #include "mlx/fence.h"
 #include "mlx/memory.h"
 #include "mlx/ops.h"
 #include "mlx/primitives.h"
+#include "mlx/profiler.h"
 #include "mlx/scheduler.h"
 #include "mlx/transforms.h"
 #include "mlx/transforms_impl.h"
@@ -22,6 +26,9 @@
 
 namespace mlx::core {
 
+// Defined in compile.cpp; true for cheap elementwise primitives
+bool is_fusable(const Primitive& p);
+
 static constexpr int MAX_ACTIVE_TASKS = 10;
 
 /* This class is only meant to be used in eval
@@ -43,11 +50,498 @@ class Synchronizer : public Primitive {
 // function which returns true if we are forced to retain the graph during
 // evaluation.
 std::vector<std::pair<char, char>>& detail::InTracing::trace_stack() {
-  static std::vector<std::pair<char, char>> trace_stack_;
+  static thread_local std::vector<std::pair<char, char>> trace_stack_;
   return trace_stack_;
 }
-int detail::InTracing::grad_counter{0};
-int detail::RetainGraph::tracing_counter{0};
+thread_local int detail::InTracing::grad_counter{0};
+thread_local int detail::RetainGraph::tracing_counter{0};
+
+// Eval-time peephole fusion of back-to-back float32 unary ops on CPU
+// streams (MLX_FUSE_UNARY). Chains are rewritten onto one primitive that
+// applies all ops a cache-resident block at a time, so interactive
+// (non-compiled) chains stop paying a full buffer write per op.
+namespace {
+
+using UnaryFn = float (*)(float);
+
+class FusedUnary : public UnaryPrimitive {
+ public:
+  FusedUnary(Stream stream, std::vector<UnaryFn> ops)
+      : UnaryPrimitive(stream), ops_(std::move(ops)) {}
+
+  void eval_cpu(const std::vector<array>& inputs, array& out) override {
+    auto& in = inputs[0];
+    // The fusion pass guarantees a row contiguous float32 input
+    if (in.is_donatable()) {
+      out.copy_shared_buffer(in);
+    } else {
+      out.set_data(allocator::malloc(out.nbytes()));
+    }
+    auto& encoder = cpu::get_command_encoder(stream());
+    encoder.set_input_array(in);
+    encoder.set_output_array(out);
+    encoder.dispatch([src = in.data<float>(),
+                      dst = out.data<float>(),
+                      size = in.data_size(),
+                      ops = ops_]() {
+      constexpr size_t block_size = 4096;
+      for (size_t i = 0; i < size; i += block_size) {
+        size_t n = std::min(block_size, size - i);
+        const float* s = src + i;
+        float* d = dst + i;
+        auto f = ops[0];
+        for (size_t j = 0; j < n; ++j) {
+          d[j] = f(s[j]);
+        }
+        for (size_t k = 1; k < ops.size(); ++k) {
+          f = ops[k];
+          for (size_t j = 0; j < n; ++j) {
+            d[j] = f(d[j]);
+          }
+        }
+      }
+    });
+  }
+
+  void eval_gpu(const std::vector<array>&, array&) override {
+    throw std::runtime_error("[FusedUnary] GPU evaluation is not supported.");
+  }
+
+  DEFINE_NAME(FusedUnary);
+
+  const std::vector<UnaryFn>& ops() const {
+    return ops_;
+  }
+
+ private:
+  std::vector<UnaryFn> ops_;
+};
+
+// Stateless float unary primitives safe to execute through a plain
+// function; parameterized ones (Sqrt's recip, Log's base) are excluded.
+UnaryFn fusable_unary_op(const Primitive& p) {
+  if (typeid(p) == typeid(Abs)) {
+    return [](float x) { return std::fabs(x); };
+  } else if (typeid(p) == typeid(Negative)) {
+    return [](float x) { return -x; };
+  } else if (typeid(p) == typeid(Exp)) {
+    return [](float x) { return std::exp(x); };
+  } else if (typeid(p) == typeid(Square)) {
+    return [](float x) { return x * x; };
+  } else if (typeid(p) == typeid(Sigmoid)) {
+    return [](float x) { return 1.0f / (1.0f + std::exp(-x)); };
+  } else if (typeid(p) == typeid(Erf)) {
+    return [](float x) { return std::erf(x); };
+  } else if (typeid(p) == typeid(Sin)) {
+    return [](float x) { return std::sin(x); };
+  } else if (typeid(p) == typeid(Cos)) {
+    return [](float x) { return std::cos(x); };
+  } else if (typeid(p) == typeid(Tanh)) {
+    return [](float x) { return std::tanh(x); };
+  }
+  return nullptr;
+}
+
+// Rewrite eligible unary chains in the tape onto FusedUnary primitives.
+// `extra_refs` accounts for bookkeeping copies of tape nodes held by the
+// caller (e.g. the eval plan cache) when checking for external references.
+void fuse_unary_chains(std::deque<array>& tape, int extra_refs) {
+  std::unordered_map<std::uintptr_t, int> consumers;
+  std::unordered_set<std::uintptr_t> in_tape;
+  for (auto& a : tape) {
+    in_tape.insert(a.id());
+    for (auto& in : a.inputs()) {
+      consumers[in.id()]++;
+    }
+  }
+
+  std::unordered_set<std::uintptr_t> fused;
+  // The tape executes back to front; visit in execution order so already
+  // fused producers extend into their consumers
+  for (int i = static_cast<int>(tape.size()) - 1; i >= 0; --i) {
+    auto& x = tape[i];
+    if (!x.has_primitive() || x.dtype() != float32 ||
+        x.inputs().size() != 1 || !x.siblings().empty()) {
+      continue;
+    }
+    auto fx = fusable_unary_op(x.primitive());
+    if (!fx) {
+      continue;
+    }
+    array y = x.inputs()[0];
+    if (y.dtype() != float32 || !(y.shape() == x.shape()) ||
+        y.status() != array::Status::unscheduled || !y.has_primitive() ||
+        y.inputs().size() != 1 || !y.siblings().empty()) {
+      continue;
+    }
+    if (in_tape.find(y.id()) == in_tape.end() || consumers[y.id()] != 1) {
+      continue;
+    }
+    auto& ys = y.primitive().stream();
+    if (ys.device != Device::cpu || !(ys == x.primitive().stream())) {
+      continue;
+    }
+    auto fy = fusable_unary_op(y.primitive());
+    bool y_is_fused = typeid(y.primitive()) == typeid(FusedUnary);
+    if (!fy && !y_is_fused) {
+      continue;
+    }
+    // The chain reads its base input with a contiguous kernel: the base is
+    // either already materialized row contiguous, or produced by a unary
+    // in this tape (whose CPU kernels write contiguous outputs)
+    array base = y.inputs()[0];
+    if (base.dtype() != float32 || !(base.shape() == y.shape())) {
+      continue;
+    }
+    bool base_ok;
+    if (base.status() != array::Status::unscheduled) {
+      base_ok = base.flags().row_contiguous;
+    } else {
+      base_ok = base.has_primitive() &&
+          (fusable_unary_op(base.primitive()) != nullptr ||
+           typeid(base.primitive()) == typeid(FusedUnary));
+    }
+    if (!base_ok) {
+      continue;
+    }
+    // Anyone else holding y still needs it materialized. Expected holders:
+    // the tape, x's input list, and our local copy.
+    if (y.use_count() > 3 + extra_refs) {
+      continue;
+    }
+
+    std::vector<UnaryFn> ops;
+    if (fy) {
+      ops.push_back(fy);
+    } else {
+      ops = static_cast<FusedUnary&>(y.primitive()).ops();
+    }
+    ops.push_back(fx);
+    x.primitive_ptr() =
+        std::make_shared<FusedUnary>(x.primitive().stream(), std::move(ops));
+    x.inputs()[0] = std::move(base);
+    fused.insert(y.id());
+  }
+
+  if (!fused.empty()) {
+    std::deque<array> new_tape;
+    for (auto& a : tape) {
+      if (fused.find(a.id()) == fused.end()) {
+        new_tape.push_back(std::move(a));
+      }
+    }
+    tape = std::move(new_tape);
+  }
+}
+
+// Return whether |x| is a (possibly broadcast) scalar zero whose value is
+// already known on the host.
+bool is_zero_scalar(array x) {
+  while (x.has_primitive() &&
+         (typeid(x.primitive()) == typeid(Broadcast) ||
+          typeid(x.primitive()) == typeid(BroadcastAxes))) {
+    x = x.inputs()[0];
+  }
+  if (x.size() != 1 || !x.is_available()) {
+    return false;
+  }
+  switch (x.dtype()) {
+    case float32:
+      return x.data<float>()[0] == 0.0f;
+    case float16:
+      return static_cast<float>(x.data<float16_t>()[0]) == 0.0f;
+    case bfloat16:
+      return static_cast<float>(x.data<bfloat16_t>()[0]) == 0.0f;
+    default:
+      return false;
+  }
+}
+
+// Eval-time fusion of gemm epilogues on CUDA streams
+// (MLX_FUSE_GEMM_EPILOGUE). A broadcast add following a matmul is rewritten
+// to AddMM so it hits the cublasLt bias epilogue, and a relu (maximum with
+// zero) following an AddMM is folded into the gemm's epilogue, so
+// matmul + bias + relu chains run as a single gemm instead of paying a
+// full read and write of the activations per op. Structured like
+// fuse_unary_chains above: rewrites happen in place on the consumer after
+// proving the intermediate has no other users.
+void fuse_gemm_epilogues(std::deque<array>& tape, int extra_refs) {
+  std::unordered_map<std::uintptr_t, int> consumers;
+  std::unordered_set<std::uintptr_t> in_tape;
+  for (auto& a : tape) {
+    in_tape.insert(a.id());
+    for (auto& in : a.inputs()) {
+      consumers[in.id()]++;
+    }
+  }
+
+  std::unordered_set<std::uintptr_t> fused;
+  // The tape executes back to front; visit in execution order so a matmul
+  // rewritten into an AddMM can still pick up a following relu
+  for (int i = static_cast<int>(tape.size()) - 1; i >= 0; --i) {
+    auto& x = tape[i];
+    if (!x.has_primitive() || x.inputs().size() != 2 ||
+        !x.siblings().empty()) {
+      continue;
+    }
+    if (x.dtype() != float32 && x.dtype() != float16 &&
+        x.dtype() != bfloat16) {
+      continue;
+    }
+    bool is_add = typeid(x.primitive()) == typeid(Add);
+    bool is_max = typeid(x.primitive()) == typeid(Maximum);
+    if (!is_add && !is_max) {
+      continue;
+    }
+
+    // Find the gemm operand
+    auto is_gemm = [&](const array& y) {
+      return y.has_primitive() && y.siblings().empty() &&
+          (is_add ? typeid(y.primitive()) == typeid(Matmul)
+                  : typeid(y.primitive()) == typeid(AddMM));
+    };
+    int gemm_idx = is_gemm(x.inputs()[0]) ? 0 : (is_gemm(x.inputs()[1]) ? 1 : -1);
+    if (gemm_idx < 0) {
+      continue;
+    }
+    array y = x.inputs()[gemm_idx];
+    array other = x.inputs()[1 - gemm_idx];
+    if (y.dtype() != x.dtype() || !(y.shape() == x.shape()) ||
+        y.status() != array::Status::unscheduled) {
+      continue;
+    }
+    if (in_tape.find(y.id()) == in_tape.end() || consumers[y.id()] != 1) {
+      continue;
+    }
+    auto& ys = y.primitive().stream();
+    if (ys.device != Device::gpu || !(ys == x.primitive().stream())) {
+      continue;
+    }
+    // Anyone else holding y still needs it materialized. Expected holders:
+    // the tape, x's input list, and our local copy.
+    if (y.use_count() > 3 + extra_refs) {
+      continue;
+    }
+
+    if (is_add) {
+      // The addend broadcasts against the matmul output; AddMM handles any
+      // layout and its eval uses the bias epilogue for row vectors
+      if (!(other.shape() == x.shape())) {
+        continue;
+      }
+      auto inputs = y.inputs();
+      inputs.push_back(std::move(other));
+      x.primitive_ptr() = std::make_shared<AddMM>(
+          x.primitive().stream(), /* alpha = */ 1.0f, /* beta = */ 1.0f);
+      x.inputs() = std::move(inputs);
+    } else {
+      auto& addmm = static_cast<AddMM&>(y.primitive());
+      if (addmm.activation() != AddMM::Activation::None ||
+          !is_zero_scalar(other)) {
+        continue;
+      }
+      auto [alpha, beta] = addmm.state();
+      x.primitive_ptr() = std::make_shared<AddMM>(
+          x.primitive().stream(), alpha, beta, AddMM::Activation::Relu);
+      x.inputs() = y.inputs();
+    }
+    fused.insert(y.id());
+  }
+
+  if (!fused.empty()) {
+    std::deque<array> new_tape;
+    for (auto& a : tape) {
+      if (fused.find(a.id()) == fused.end()) {
+        new_tape.push_back(std::move(a));
+      }
+    }
+    tape = std::move(new_tape);
+  }
+}
+
+// Greedily reorder the tape to reduce peak allocated bytes
+// (MLX_MEMORY_PLAN). The dispatch loop detaches each node's inputs right
+// after it runs, so scheduling the last consumer of an intermediate earlier
+// also frees that intermediate earlier; no explicit free points are needed.
+// Among ready nodes the pass picks the one with the smallest net
+// allocation, i.e. output bytes minus the bytes of inputs it is the last
+// in-tape consumer of, falling back to the original order on ties. Any
+// topological order is valid for dispatch since cross-stream dependencies
+// are synchronized per input with fences.
+void plan_memory_order(std::deque<array>& tape) {
+  int n = tape.size();
+  if (n < 3) {
+    return;
+  }
+
+  // Execution order is the reverse of the deque order
+  std::vector<array> exec(tape.rbegin(), tape.rend());
+
+  std::unordered_map<std::uintptr_t, int> producer;
+  for (int i = 0; i < n; ++i) {
+    producer.emplace(exec[i].id(), i);
+    for (auto& s : exec[i].siblings()) {
+      producer.emplace(s.id(), i);
+    }
+  }
+
+  // In-tape dependency edges with inputs deduplicated per node, the number
+  // of distinct consumer nodes per produced array, and per node output bytes
+  std::vector<std::vector<std::pair<std::uintptr_t, size_t>>> in_edges(n);
+  std::vector<std::vector<int>> succs(n);
+  std::vector<int> indegree(n, 0);
+  std::vector<size_t> out_bytes(n, 0);
+  std::unordered_map<std::uintptr_t, int> remaining_consumers;
+  for (int i = 0; i < n; ++i) {
+    auto& a = exec[i];
+    out_bytes[i] = a.nbytes();
+    for (auto& s : a.siblings()) {
+      out_bytes[i] += s.nbytes();
+    }
+    for (auto& in : a.inputs()) {
+      auto it = producer.find(in.id());
+      if (it == producer.end() || it->second == i) {
+        continue;
+      }
+      auto& edges = in_edges[i];
+      bool seen = false;
+      for (auto& [id, bytes] : edges) {
+        seen |= (id == in.id());
+      }
+      if (!seen) {
+        edges.emplace_back(in.id(), in.nbytes());
+        succs[it->second].push_back(i);
+        indegree[i]++;
+        remaining_consumers[in.id()]++;
+      }
+    }
+  }
+
+  std::vector<int> ready;
+  for (int i = 0; i < n; ++i) {
+    if (indegree[i] == 0) {
+      ready.push_back(i);
+    }
+  }
+
+  std::vector<int> order;
+  order.reserve(n);
+  while (!ready.empty()) {
+    size_t best = 0;
+    int64_t best_cost = 0;
+    for (size_t r = 0; r < ready.size(); ++r) {
+      int i = ready[r];
+      int64_t cost = out_bytes[i];
+      for (auto& [id, bytes] : in_edges[i]) {
+        if (remaining_consumers[id] == 1) {
+          cost -= bytes;
+        }
+      }
+      if (r == 0 || cost < best_cost ||
+          (cost == best_cost && i < ready[best])) {
+        best = r;
+        best_cost = cost;
+      }
+    }
+    int i = ready[best];
+    ready[best] = ready.back();
+    ready.pop_back();
+    order.push_back(i);
+    for (auto& [id, bytes] : in_edges[i]) {
+      remaining_consumers[id]--;
+    }
+    for (auto s : succs[i]) {
+      if (--indegree[s] == 0) {
+        ready.push_back(s);
+      }
+    }
+  }
+
+  // A scheduling bug must not drop nodes; keep the original order if the
+  // graph did not fully drain
+  if (static_cast<int>(order.size()) != n) {
+    return;
+  }
+
+  tape.clear();
+  for (int k = n - 1; k >= 0; --k) {
+    tape.push_back(std::move(exec[order[k]]));
+  }
+}
+
+} // namespace
+
+// Cache of tape orderings for repeated identical graphs
+// (MLX_EVAL_PLAN_CACHE). Entries are keyed on a structural hash of the
+// dependency walk and hold a permutation from node discovery order to tape
+// order, so re-evaluating the same topology (e.g. a training step) skips
+// the BFS scheduling pass. Replayed orders are validated topologically
+// before use so a hash collision degrades to a cache miss.
+namespace {
+
+inline uint64_t plan_hash_combine(uint64_t h, uint64_t v) {
+  return h ^ (v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2));
+}
+
+struct EvalPlanCache {
+  static constexpr size_t max_plans = 64;
+  std::mutex mtx;
+  std::unordered_map<uint64_t, std::vector<uint32_t>> plans;
+
+  bool find(uint64_t key, std::vector<uint32_t>& perm) {
+    std::lock_guard<std::mutex> lk(mtx);
+    if (auto it = plans.find(key); it != plans.end()) {
+      perm = it->second;
+      return true;
+    }
+    return false;
+  }
+
+  void insert(uint64_t key, std::vector<uint32_t> perm) {
+    std::lock_guard<std::mutex> lk(mtx);
+    if (plans.size() >= max_plans) {
+      plans.clear();
+    }
+    plans[key] = std::move(perm);
+  }
+};
+
+EvalPlanCache& eval_plan_cache() {
+  static EvalPlanCache cache;
+  return cache;
+}
+
+} // namespace
+
+// Pool of CPU streams used by the concurrent eval mode. Lane 0 is the
+// default CPU stream so single-branch graphs behave exactly as before; the
+// remaining lanes are created once on first use.
+static const std::vector<Stream>& cpu_eval_streams(int lanes) {
+  static std::vector<Stream> streams = [lanes]() {
+    std::vector<Stream> s;
+    s.push_back(default_stream(Device::cpu));
+    for (int i = 1; i < lanes; ++i) {
+      s.push_back(new_stream(Device::cpu));
+    }
+    return s;
+  }();
+  return streams;
+}
+
+// Pool of GPU streams for the concurrent eval mode on CUDA builds, where
+// each lane maps to its own CUDA stream and cross-lane dependencies become
+// device-side event waits.
+static const std::vector<Stream>& gpu_eval_streams(int lanes) {
+  static std::vector<Stream> streams = [lanes]() {
+    std::vector<Stream> s;
+    s.push_back(default_stream(Device::gpu));
+    for (int i = 1; i < lanes; ++i) {
+      s.push_back(new_stream(Device::gpu));
+    }
+    return s;
+  }();
+  return streams;
+}
 
 array eval_impl(std::vector<array> outputs, bool async) {
   std::deque<array> tape;
@@ -79,12 +573,22 @@ array eval_impl(std::vector<array> outputs, bool async) {
     events.emplace(stream.index, std::move(e));
   }
 
+  bool use_plan_cache = env::eval_plan_cache();
+  // Nodes in discovery order and their indices, used to key and replay
+  // cached tape orderings
+  std::vector<array> nodes;
+  std::unordered_map<std::uintptr_t, uint32_t> discovery;
+
   {
     // Record the degree of each input
     std::unordered_map<std::uintptr_t, int> cache;
 
     std::stack<std::pair<std::reference_wrapper<array>, int>> dfs;
     dfs.emplace(synchronizer, 0);
+    if (use_plan_cache) {
+      discovery.emplace(synchronizer.id(), 0);
+      nodes.push_back(synchronizer);
+    }
     while (!dfs.empty()) {
       auto& [a_ref, idx] = dfs.top();
       auto& a = a_ref.get();
@@ -123,6 +627,13 @@ array eval_impl(std::vector<array> outputs, bool async) {
         if (cache_it == cache.end()) {
           dfs.emplace(in, 0);
           cache.insert({in.id(), 1});
+          if (use_plan_cache && in.status() == array::Status::unscheduled) {
+            discovery.emplace(in.id(), nodes.size());
+            for (auto& s : in.siblings()) {
+              discovery.emplace(s.id(), nodes.size());
+            }
+            nodes.push_back(in);
+          }
           for (auto& s : in.siblings()) {
             cache.insert({s.id(), 1});
           }
@@ -142,49 +653,194 @@ array eval_impl(std::vector<array> outputs, bool async) {
       dfs.pop();
     }
 
-    // Build the tape in BFS order with a width limit
-    int max_width = env::bfs_max_width();
-    dfs = std::stack<std::pair<std::reference_wrapper<array>, int>>();
-    tape.push_back(synchronizer);
-    for (int i = 0; !cache.empty() && (i < tape.size() || !dfs.empty());) {
-      auto& a = (i >= tape.size()) ? dfs.top().first.get() : tape[i];
-      int j = 0;
-      if (i >= tape.size()) {
-        j = dfs.top().second;
-        dfs.pop();
-      } else {
-        i++;
+    bool planned = false;
+    uint64_t plan_key = 0;
+    if (use_plan_cache) {
+      plan_key = nodes.size();
+      for (auto& a : nodes) {
+        plan_key = plan_hash_combine(
+            plan_key, reinterpret_cast<uint64_t>(a.primitive().name()));
+        plan_key = plan_hash_combine(plan_key, a.primitive().stream().index);
+        plan_key =
+            plan_hash_combine(plan_key, static_cast<uint64_t>(a.dtype().val()));
+        for (auto d : a.shape()) {
+          plan_key = plan_hash_combine(plan_key, d);
+        }
+        for (auto& in : a.inputs()) {
+          auto it = discovery.find(in.id());
+          plan_key = plan_hash_combine(
+              plan_key, it == discovery.end() ? ~uint64_t(0) : it->second);
+        }
       }
-      for (; j < a.inputs().size(); ++j) {
-        auto& in = a.inputs()[j];
-        if (in.status() != array::Status::unscheduled) {
-          continue;
+
+      std::vector<uint32_t> perm;
+      if (eval_plan_cache().find(plan_key, perm) &&
+          perm.size() == nodes.size()) {
+        // The tape is executed back to front so every in-eval input has to
+        // come later in the tape than its consumer. A collision fails this
+        // check and falls through to the BFS pass below.
+        std::vector<uint32_t> pos(perm.size());
+        for (uint32_t i = 0; i < perm.size(); ++i) {
+          pos[perm[i]] = i;
         }
+        bool valid = true;
+        for (uint32_t i = 0; valid && i < perm.size(); ++i) {
+          for (auto& in : nodes[perm[i]].inputs()) {
+            if (auto it = discovery.find(in.id());
+                it != discovery.end() && pos[it->second] <= i) {
+              valid = false;
+              break;
+            }
+          }
+        }
+        if (valid) {
+          for (auto p : perm) {
+            tape.push_back(nodes[p]);
+          }
+          planned = true;
+        }
+      }
+    }
 
-        // If the width limit is exceeded, push the array on the stack
-        // and go down a level
-        if ((tape.size() - i) >= max_width) {
-          dfs.emplace(a, j);
-          break;
+    if (!planned) {
+      // Build the tape in BFS order with a width limit
+      int max_width = env::bfs_max_width();
+      dfs = std::stack<std::pair<std::reference_wrapper<array>, int>>();
+      tape.push_back(synchronizer);
+      for (int i = 0; !cache.empty() && (i < tape.size() || !dfs.empty());) {
+        auto& a = (i >= tape.size()) ? dfs.top().first.get() : tape[i];
+        int j = 0;
+        if (i >= tape.size()) {
+          j = dfs.top().second;
+          dfs.pop();
+        } else {
+          i++;
         }
+        for (; j < a.inputs().size(); ++j) {
+          auto& in = a.inputs()[j];
+          if (in.status() != array::Status::unscheduled) {
+            continue;
+          }
+
+          // If the width limit is exceeded, push the array on the stack
+          // and go down a level
+          if ((tape.size() - i) >= max_width) {
+            dfs.emplace(a, j);
+            break;
+          }
 
-        auto it = cache.find(in.id());
-        it->second -= 1;
+          auto it = cache.find(in.id());
+          it->second -= 1;
 
-        if (it->second != 0) {
+          if (it->second != 0) {
+            for (auto& s : in.siblings()) {
+              cache[s.id()] -= 1;
+            }
+            continue;
+          }
+
+          // Remove input and siblings from cache
+          cache.erase(it);
           for (auto& s : in.siblings()) {
-            cache[s.id()] -= 1;
+            cache.erase(s.id());
           }
-          continue;
+
+          tape.push_back(in);
         }
+      }
+
+      if (use_plan_cache && tape.size() == nodes.size()) {
+        std::vector<uint32_t> perm(tape.size());
+        bool complete = true;
+        for (size_t i = 0; i < tape.size(); ++i) {
+          if (auto it = discovery.find(tape[i].id()); it != discovery.end()) {
+            perm[i] = it->second;
+          } else {
+            complete = false;
+            break;
+          }
+        }
+        if (complete) {
+          eval_plan_cache().insert(plan_key, std::move(perm));
+        }
+      }
+    }
+  }
+
+  // With MLX_FUSE_UNARY=1, collapse chains of contiguous float unary ops on
+  // the same CPU stream into single fused dispatches before execution. The
+  // plan cache above holds an extra reference to each tape entry while
+  // enabled, which the fuser's external-reference check must account for.
+  if (env::fuse_unary() && !tape.empty()) {
+    fuse_unary_chains(tape, use_plan_cache ? 1 : 0);
+  }
 
-        // Remove input and siblings from cache
-        cache.erase(it);
-        for (auto& s : in.siblings()) {
-          cache.erase(s.id());
+  // With MLX_FUSE_GEMM_EPILOGUE=1 on CUDA builds, fold broadcast bias adds
+  // and relus following a gemm into the cublasLt epilogue so matmul + bias
+  // + activation chains run as one gemm call.
+  if (env::fuse_gemm_epilogue() && cu::is_available() && !tape.empty()) {
+    fuse_gemm_epilogues(tape, use_plan_cache ? 1 : 0);
+  }
+
+  // With MLX_MEMORY_PLAN=1, reorder independent primitives to reduce peak
+  // allocated bytes.
+  if (env::memory_plan()) {
+    plan_memory_order(tape);
+  }
+
+  // With MLX_CONCURRENT_EVAL=N (N > 1), partition the tape into topological
+  // levels and spread each level's default-stream CPU primitives over a pool
+  // of N streams so independent branches of the graph run concurrently.
+  // On CUDA builds the same rebalancing applies to default-stream GPU
+  // primitives: each lane is its own CUDA stream, so independent small
+  // kernels overlap on the device instead of serializing in issue order.
+  // Cross-stream dependencies introduced by the rebalancing are handled by
+  // the same fence machinery used for explicit multi-stream graphs.
+  if (int lanes = env::concurrent_eval(); lanes > 1) {
+    auto& pool = cpu_eval_streams(lanes);
+    auto default_cpu = default_stream(Device::cpu);
+    // Metal serializes command buffers per queue, so GPU lanes are CUDA only
+    const std::vector<Stream>* gpu_pool =
+        cu::is_available() ? &gpu_eval_streams(lanes) : nullptr;
+
+    // The tape is executed back to front; compute each node's level as one
+    // past the deepest of its in-tape inputs.
+    std::unordered_map<std::uintptr_t, int> levels;
+    std::unordered_map<int, int> next_lane;
+    std::unordered_map<int, int> next_gpu_lane;
+    for (auto it = tape.rbegin(); it != tape.rend(); ++it) {
+      auto& a = *it;
+      int level = 0;
+      for (auto& in : a.inputs()) {
+        if (auto lit = levels.find(in.id()); lit != levels.end()) {
+          level = std::max(level, lit->second + 1);
         }
+      }
+      levels[a.id()] = level;
+      for (auto& s : a.siblings()) {
+        levels.emplace(s.id(), level);
+      }
+      if (a.id() == synchronizer.id()) {
+        continue;
+      }
+      if (a.primitive().stream() == default_cpu) {
+        a.primitive().set_stream(pool[next_lane[level]++ % lanes]);
+      } else if (
+          gpu_pool && a.primitive().stream() == gpu_pool->front()) {
+        a.primitive().set_stream((*gpu_pool)[next_gpu_lane[level]++ % lanes]);
+      }
+    }
 
-        tape.push_back(in);
+    // Recompute the fence requirements with the assigned streams
+    needs_fence.clear();
+    for (auto& a : tape) {
+      auto s = a.primitive().stream();
+      for (auto& in : a.inputs()) {
+        if (levels.find(in.id()) != levels.end() &&
+            in.status() == array::Status::unscheduled &&
+            in.primitive().stream() != s) {
+          needs_fence.emplace(in.id(), in.primitive().stream().index);
+        }
       }
     }
   }
@@ -227,12 +883,39 @@ array eval_impl(std::vector<array> outputs, bool async) {
       }
     }
 
+    // Attribute allocations made while evaluating this primitive
+    bool telemetry = allocator::allocation_telemetry_enabled();
+    if (telemetry) {
+      allocator::set_allocation_site(arr.primitive().name(), stream.index);
+    }
+
+    bool profiling = profiling_enabled();
+    uint64_t profile_start = profiling ? detail::profile_clock_us() : 0;
+
     if (arr.primitive().device() == Device::gpu) {
       gpu::eval(arr);
     } else {
       cpu::eval(arr);
     }
 
+    if (profiling) {
+      uint64_t profile_end = detail::profile_clock_us();
+      uint64_t bytes = arr.nbytes();
+      for (auto& sib : arr.siblings()) {
+        bytes += sib.nbytes();
+      }
+      detail::record_profile_event(
+          arr.primitive().name(),
+          stream.index,
+          profile_start,
+          profile_end - profile_start,
+          bytes);
+    }
+
+    if (telemetry) {
+      allocator::set_allocation_site(nullptr, 0);
+    }
+
     if (scheduler::n_active_tasks() > MAX_ACTIVE_TASKS ||
         (get_active_memory() > get_memory_limit() &&
          scheduler::n_active_tasks() > 0)) {
@@ -241,6 +924,8 @@ array eval_impl(std::vector<array> outputs, bool async) {
         auto s = get_stream(i);
         if (s.device == Device::gpu) {
           gpu::finalize(s);
+        } else {
+          cpu::get_command_encoder(s).flush_retired();
         }
       }
       scheduler::wait_for_one();
@@ -281,6 +966,8 @@ array eval_impl(std::vector<array> outputs, bool async) {
     }
     if (s.device == Device::gpu) {
       gpu::finalize(s);
+    } else {
+      cpu::get_command_encoder(s).flush_retired();
     }
   }
 
@@ -301,6 +988,37 @@ void async_eval(std::vector<array> outputs) {
   eval_impl(std::move(outputs), true);
 }
 
+void async_eval(std::vector<array> outputs, std::function<void()> callback) {
+  if (!callback) {
+    async_eval(std::move(outputs));
+    return;
+  }
+
+  if (outputs.empty() ||
+      std::none_of(outputs.begin(), outputs.end(), [](array& x) {
+        return x.status() == array::Status::unscheduled;
+      })) {
+    // Nothing new to schedule; fire once anything still in flight lands
+    detail::enqueue_readback([outputs = std::move(outputs),
+                              callback = std::move(callback)]() mutable {
+      for (auto& x : outputs) {
+        x.wait();
+      }
+      callback();
+    });
+    return;
+  }
+
+  // Waiting on the synchronizer waits for the tape's final event, so the
+  // callback fires exactly when this round of work has completed
+  auto synchronizer = eval_impl(std::move(outputs), true);
+  detail::enqueue_readback([synchronizer = std::move(synchronizer),
+                            callback = std::move(callback)]() mutable {
+    synchronizer.wait();
+    callback();
+  });
+}
+
 void eval(std::vector<array> outputs) {
   if (outputs.empty()) {
     return;
@@ -318,11 +1036,269 @@ void eval(std::vector<array> outputs) {
   eval_impl(std::move(outputs), false).wait();
 }
 
+namespace {
+
+// Flattened, retained copy of a subgraph used to key and verify memoized
+// results. Nodes are stored in DFS post-order; inputs refer to earlier
+// nodes by index. Small available leaves are captured by value so freshly
+// built constants (scalars feeding an arange, say) still match across
+// steps; larger leaves are identified by node identity and retained by
+// the cache entry so a freed identity cannot be recycled into a false
+// match.
+struct MemoNode {
+  std::shared_ptr<Primitive> primitive; // null for leaves
+  Dtype::Val dtype{};
+  Shape shape;
+  std::vector<uint32_t> inputs;
+  std::vector<char> bytes;
+  std::uintptr_t leaf_id{0};
+};
+
+constexpr size_t memo_leaf_capture_bytes = 64;
+
+bool memo_flatten(
+    const array& root,
+    std::vector<MemoNode>& nodes,
+    std::vector<array>& leaves,
+    uint64_t& key) {
+  std::unordered_map<std::uintptr_t, uint32_t> index;
+  std::stack<std::pair<array, int>> dfs;
+  dfs.emplace(root, 0);
+  while (!dfs.empty()) {
+    auto& [a, idx] = dfs.top();
+    // Multi-output primitives are not memoized; their outputs alias
+    // sibling state that the cache does not track
+    if (!a.siblings().empty()) {
+      return false;
+    }
+    bool is_leaf = a.status() != array::Status::unscheduled;
+    if (!is_leaf && idx < a.inputs().size()) {
+      auto& in = a.inputs()[idx++];
+      if (index.find(in.id()) == index.end()) {
+        dfs.emplace(in, 0);
+      }
+      continue;
+    }
+    if (index.find(a.id()) == index.end()) {
+      MemoNode n;
+      n.dtype = a.dtype().val();
+      n.shape = a.shape();
+      if (is_leaf) {
+        if (a.is_available() && a.nbytes() <= memo_leaf_capture_bytes &&
+            a.flags().row_contiguous) {
+          auto p = a.data<char>();
+          n.bytes.assign(p, p + a.nbytes());
+        } else {
+          n.leaf_id = a.id();
+          leaves.push_back(a);
+        }
+      } else {
+        if (!a.has_primitive()) {
+          return false;
+        }
+        n.primitive = a.primitive_ptr();
+        for (auto& in : a.inputs()) {
+          n.inputs.push_back(index.at(in.id()));
+        }
+      }
+      index.emplace(a.id(), nodes.size());
+      nodes.push_back(std::move(n));
+    }
+    dfs.pop();
+  }
+
+  key = nodes.size();
+  for (auto& n : nodes) {
+    key = plan_hash_combine(
+        key,
+        n.primitive ? reinterpret_cast<uint64_t>(n.primitive->name()) : 0);
+    key = plan_hash_combine(key, static_cast<uint64_t>(n.dtype));
+    for (auto d : n.shape) {
+      key = plan_hash_combine(key, d);
+    }
+    for (auto i : n.inputs) {
+      key = plan_hash_combine(key, i);
+    }
+    for (char c : n.bytes) {
+      key = plan_hash_combine(key, static_cast<unsigned char>(c));
+    }
+    key = plan_hash_combine(key, n.leaf_id);
+  }
+  return true;
+}
+
+bool memo_match(
+    const std::vector<MemoNode>& a,
+    const std::vector<MemoNode>& b) {
+  if (a.size() != b.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < a.size(); ++i) {
+    auto& x = a[i];
+    auto& y = b[i];
+    if ((x.primitive == nullptr) != (y.primitive == nullptr) ||
+        x.dtype != y.dtype || !(x.shape == y.shape) ||
+        x.inputs != y.inputs || x.bytes != y.bytes ||
+        x.leaf_id != y.leaf_id) {
+      return false;
+    }
+    if (x.primitive) {
+      auto& px = *x.primitive;
+      auto& py = *y.primitive;
+      if (typeid(px) != typeid(py) || !px.is_equivalent(py)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+struct MemoCache {
+  struct Entry {
+    std::vector<MemoNode> nodes;
+    // Leaves referenced by id are retained to pin those ids for the
+    // entry's lifetime; they are usually shared with the caller so their
+    // bytes are not charged against the cache budget.
+    std::vector<array> leaves;
+    array result;
+    size_t bytes;
+  };
+
+  std::mutex mtx;
+  size_t limit{
+      static_cast<size_t>(env::get_var("MLX_MEMO_CACHE_LIMIT_MB", 256)) << 20};
+  size_t size{0};
+  std::list<std::pair<uint64_t, Entry>> lru;
+  std::unordered_map<uint64_t, std::list<std::pair<uint64_t, Entry>>::iterator>
+      map;
+};
+
+MemoCache& memo_cache() {
+  static MemoCache* cache = new MemoCache();
+  return *cache;
+}
+
+} // namespace
+
+array memoize(array a) {
+  std::vector<MemoNode> nodes;
+  std::vector<array> leaves;
+  uint64_t key = 0;
+  if (a.is_available() || !memo_flatten(a, nodes, leaves, key)) {
+    if (a.status() == array::Status::unscheduled) {
+      eval({a});
+    }
+    return a;
+  }
+
+  auto& cache = memo_cache();
+  {
+    std::lock_guard<std::mutex> lk(cache.mtx);
+    if (auto it = cache.map.find(key); it != cache.map.end() &&
+        memo_match(it->second->second.nodes, nodes)) {
+      cache.lru.splice(cache.lru.begin(), cache.lru, it->second);
+      return it->second->second.result;
+    }
+  }
+
+  eval({a});
+
+  {
+    std::lock_guard<std::mutex> lk(cache.mtx);
+    size_t bytes = a.nbytes();
+    if (cache.map.find(key) == cache.map.end() && bytes <= cache.limit) {
+      cache.lru.emplace_front(
+          key, MemoCache::Entry{std::move(nodes), std::move(leaves), a, bytes});
+      cache.map[key] = cache.lru.begin();
+      cache.size += bytes;
+      while (cache.size > cache.limit) {
+        auto& oldest = cache.lru.back();
+        cache.size -= oldest.second.bytes;
+        cache.map.erase(oldest.first);
+        cache.lru.pop_back();
+      }
+    }
+  }
+  return a;
+}
+
+size_t set_memo_cache_limit(size_t limit) {
+  auto& cache = memo_cache();
+  std::lock_guard<std::mutex> lk(cache.mtx);
+  auto old = cache.limit;
+  cache.limit = limit;
+  while (cache.size > cache.limit && !cache.lru.empty()) {
+    auto& oldest = cache.lru.back();
+    cache.size -= oldest.second.bytes;
+    cache.map.erase(oldest.first);
+    cache.lru.pop_back();
+  }
+  return old;
+}
+
+size_t get_memo_cache_size() {
+  auto& cache = memo_cache();
+  std::lock_guard<std::mutex> lk(cache.mtx);
+  return cache.size;
+}
+
+void clear_memo_cache() {
+  auto& cache = memo_cache();
+  std::lock_guard<std::mutex> lk(cache.mtx);
+  cache.lru.clear();
+  cache.map.clear();
+  cache.size = 0;
+}
+
+namespace detail {
+
+void enqueue_readback(std::function<void()> task) {
+  // Lazily created low priority CPU stream that services host readbacks, so
+  // waiting on an event never occupies a compute stream
+  static Stream stream = new_stream(Device::cpu, StreamPriority::low);
+  scheduler::enqueue(stream, std::move(task));
+}
+
+} // namespace detail
+
+void EvalPipeline::push(std::vector<array> outputs) {
+  async_eval(outputs);
+  batches_.push_back(std::move(outputs));
+  // The batch arrays share state with the caller's copies, so dropping a
+  // batch here only releases the pipeline's bookkeeping; the caller still
+  // sees the evaluated results.
+  while (batches_.size() > static_cast<size_t>(depth_)) {
+    for (auto& x : batches_.front()) {
+      x.wait();
+    }
+    batches_.pop_front();
+  }
+}
+
+std::vector<array> EvalPipeline::pop() {
+  if (batches_.empty()) {
+    return {};
+  }
+  auto batch = std::move(batches_.front());
+  batches_.pop_front();
+  for (auto& x : batch) {
+    x.wait();
+  }
+  return batch;
+}
+
+void EvalPipeline::wait_all() {
+  while (!batches_.empty()) {
+    pop();
+  }
+}
+
 std::pair<std::vector<array>, std::vector<array>> vjp(
     const std::function<std::vector<array>(const std::vector<array>&)>& fun,
     const std::vector<array>& primals,
     const std::vector<array>& cotans,
-    const std::vector<int>& argnums) {
+    const std::vector<int>& argnums,
+    const std::vector<array>& grads = {}) {
   // Set the global tracing flag.
   detail::InTracing in_tracing{false, true};
 
@@ -426,6 +1402,34 @@ std::pair<std::vector<array>, std::vector<array>> vjp(
     recurse(out);
   }
 
+  // Optionally rebuild cheap primal chains inside the cotangent graph
+  // instead of referencing the forward's intermediates (MLX_GRAD_REMAT).
+  // An activation produced by elementwise ops is cloned (sharing the
+  // primitives, not the buffers) up to the configured depth, so the
+  // backward recomputes it from its cheaper ancestors and the forward
+  // value can be freed as soon as the forward is done with it. The depth
+  // is the bytes-vs-flops policy: each level trades one more elementwise
+  // recompute per activation for not keeping that activation live.
+  int remat_depth = env::grad_remat();
+  std::unordered_map<std::uintptr_t, array> remat_cache;
+  std::function<array(const array&, int)> remat =
+      [&](const array& a, int depth) -> array {
+    if (depth <= 0 || a.is_available() || !a.has_primitive() ||
+        !a.siblings().empty() || !is_fusable(a.primitive())) {
+      return a;
+    }
+    if (auto it = remat_cache.find(a.id()); it != remat_cache.end()) {
+      return it->second;
+    }
+    std::vector<array> inputs;
+    for (auto& in : a.inputs()) {
+      inputs.push_back(remat(in, depth - 1));
+    }
+    array clone(a.shape(), a.dtype(), a.primitive_ptr(), std::move(inputs));
+    remat_cache.emplace(a.id(), clone);
+    return clone;
+  };
+
   // Run the tape backwards, computing vector-jacobian
   // products for each primitive
   std::unordered_map<std::uintptr_t, array> cotan_map;
@@ -435,6 +1439,41 @@ std::pair<std::vector<array>, std::vector<array>> vjp(
                                : default_stream(default_device());
     cotan_map.insert({o.id(), astype(cotans[cotan_idx], o.dtype(), s)});
   }
+
+  // Seed the cotangents of the differentiated primals with the gradients
+  // being accumulated so the products are added onto them inside the
+  // backward graph. The adds donate the gradient buffers at evaluation
+  // when the caller rebinds them to the returned vjps.
+  if (!grads.empty()) {
+    if (grads.size() != argnums.size()) {
+      std::ostringstream msg;
+      msg << "[vjp] Number of gradients to accumulate into (" << grads.size()
+          << ") does not match number of arguments (" << argnums.size()
+          << ").";
+      throw std::invalid_argument(msg.str());
+    }
+    for (int i = 0; i < argnums.size(); ++i) {
+      auto& primal = primals_[argnums[i]];
+      if (grads[i].shape() != primal.shape() ||
+          grads[i].dtype() != primal.dtype()) {
+        std::ostringstream msg;
+        msg << "[vjp] Gradient " << i << " with shape " << grads[i].shape()
+            << " and dtype " << grads[i].dtype()
+            << " does not match primal with shape " << primal.shape()
+            << " and dtype " << primal.dtype() << ".";
+        throw std::invalid_argument(msg.str());
+      }
+      auto s = primal.has_primitive() ? primal.primitive().stream()
+                                      : default_stream(default_device());
+      if (auto cotan_it = cotan_map.find(primal.id());
+          cotan_it != cotan_map.end()) {
+        cotan_it->second = add(grads[i], cotan_it->second, s);
+      } else {
+        cotan_map.insert({primal.id(), grads[i]});
+      }
+    }
+  }
+
   for (auto it = tape.rbegin(); it != tape.rend(); ++it) {
     auto& a = *it;
 
@@ -470,7 +1509,22 @@ std::pair<std::vector<array>, std::vector<array>> vjp(
     std::vector<array> vjps;
     {
       detail::RetainGraph retain;
-      vjps = a.primitive().vjp(a.inputs(), cotangents, argnums, outputs);
+      if (remat_depth > 0) {
+        // Reference recomputed clones from the backward; bookkeeping below
+        // stays keyed on the original primals
+        std::vector<array> remat_inputs;
+        for (auto& in : a.inputs()) {
+          remat_inputs.push_back(remat(in, remat_depth));
+        }
+        std::vector<array> remat_outputs;
+        for (auto& o : outputs) {
+          remat_outputs.push_back(remat(o, remat_depth));
+        }
+        vjps = a.primitive().vjp(
+            remat_inputs, cotangents, argnums, remat_outputs);
+      } else {
+        vjps = a.primitive().vjp(a.inputs(), cotangents, argnums, outputs);
+      }
     }
     // Accumulate the vector-jacobian products for each input
     for (int i = 0; i < argnums.size(); ++i) {
@@ -517,6 +1571,25 @@ std::pair<array, array> vjp(
   return {outputs[0], vjps[0]};
 }
 
+std::pair<std::vector<array>, std::vector<array>> vjp(
+    const std::function<std::vector<array>(const std::vector<array>&)>& fun,
+    const std::vector<array>& primals,
+    const std::vector<array>& cotans,
+    const std::vector<array>& grads) {
+  std::vector<int> argnums(primals.size());
+  std::iota(argnums.begin(), argnums.end(), 0);
+  return vjp(fun, primals, cotans, argnums, grads);
+}
+
+std::vector<array> zero_grad(const std::vector<array>& grads) {
+  std::vector<array> zeros;
+  zeros.reserve(grads.size());
+  for (auto& g : grads) {
+    zeros.push_back(zeros_like(g));
+  }
+  return zeros;
+}
+
 std::pair<std::vector<array>, std::vector<array>> jvp(
     const std::function<std::vector<array>(const std::vector<array>&)>& fun,
     const std::vector<array>& primals,
@@ -937,6 +2010,136 @@ std::function<array(const array&)> vmap(
   return [vfun](const array& a) { return vfun({a})[0]; };
 }
 
+std::vector<std::string> vmap_slow_primitives(
+    const std::function<std::vector<array>(const std::vector<array>&)>& fun,
+    const std::vector<array>& inputs,
+    const std::vector<int>& in_axes_ /* = {} */) {
+  auto in_axes = in_axes_;
+  if (in_axes.empty()) {
+    in_axes.resize(inputs.size(), 0);
+  }
+  auto [s_inputs, s_outputs] = detail::vmap_trace(fun, inputs, in_axes);
+
+  int vmap_size = -1;
+  for (int i = 0; i < inputs.size(); ++i) {
+    if (in_axes[i] >= 0) {
+      vmap_size = inputs[i].shape(in_axes[i]);
+      break;
+    }
+  }
+
+  // Topologically sort the graph, mirroring vmap_replace
+  std::unordered_map<std::uintptr_t, std::pair<array, int>> tmap;
+  std::unordered_set<std::uintptr_t> needs_vmap;
+  std::unordered_set<std::uintptr_t> cache;
+  for (int i = 0; i < s_inputs.size(); ++i) {
+    auto in = s_inputs[i];
+    if (in_axes[i] != -1) {
+      tmap.insert({in.id(), {inputs[i], in_axes[i]}});
+      needs_vmap.insert(in.id());
+      in.set_tracer(false);
+    }
+    cache.insert(in.id());
+  }
+
+  std::vector<array> tape;
+  std::function<void(const array&)> recurse;
+  recurse = [&](const array& a) {
+    if (auto id = a.id(); !cache.insert(id).second) {
+      return;
+    }
+    for (auto& s : a.siblings()) {
+      cache.insert(s.id());
+    }
+    for (auto& input : a.inputs()) {
+      recurse(input);
+    }
+    for (auto& input : a.inputs()) {
+      if (needs_vmap.find(input.id()) != needs_vmap.end()) {
+        tape.push_back(a);
+        tape.back().set_tracer(false);
+        needs_vmap.insert(a.id());
+        for (auto s : a.siblings()) {
+          needs_vmap.insert(s.id());
+          s.set_tracer(false);
+        }
+        break;
+      }
+    }
+  };
+  for (auto& out : s_outputs) {
+    if (out.has_primitive()) {
+      recurse(out);
+    }
+  }
+
+  // Run each primitive's vmap and inspect what it produced
+  std::vector<std::string> slow;
+  std::unordered_set<std::string> seen;
+  for (auto& a : tape) {
+    std::vector<array> v_inputs;
+    std::vector<int> v_axes;
+    for (auto& in : a.inputs()) {
+      if (auto map_it = tmap.find(in.id()); map_it != tmap.end()) {
+        v_inputs.push_back(map_it->second.first);
+        v_axes.push_back(map_it->second.second);
+      } else {
+        v_inputs.push_back(in);
+        v_axes.push_back(-1);
+      }
+    }
+
+    std::pair<std::vector<array>, std::vector<int>> res;
+    try {
+      res = a.primitive().vmap(v_inputs, v_axes);
+    } catch (const std::exception&) {
+      if (seen.insert(a.primitive().name()).second) {
+        slow.push_back(
+            std::string(a.primitive().name()) + " (no batched lowering)");
+      }
+      // Stand in the unbatched trace so the scan can continue
+      for (auto& o : a.outputs()) {
+        tmap.insert({o.id(), {o, -1}});
+      }
+      continue;
+    }
+    auto& [v_outputs, v_out_axes] = res;
+
+    // A batched lowering emits a handful of ops; one that loops over the
+    // vmapped axis emits at least one per element
+    std::unordered_set<std::uintptr_t> known;
+    for (auto& in : v_inputs) {
+      known.insert(in.id());
+    }
+    int new_ops = 0;
+    std::function<void(const array&)> count = [&](const array& arr) {
+      if (!known.insert(arr.id()).second) {
+        return;
+      }
+      if (arr.has_primitive()) {
+        new_ops++;
+        for (auto& in : arr.inputs()) {
+          count(in);
+        }
+      }
+    };
+    for (auto& o : v_outputs) {
+      count(o);
+    }
+    if (vmap_size > 1 && new_ops >= vmap_size &&
+        seen.insert(a.primitive().name()).second) {
+      slow.push_back(
+          std::string(a.primitive().name()) + " (expands per element)");
+    }
+
+    auto outputs = a.outputs();
+    for (int i = 0; i < v_outputs.size(); ++i) {
+      tmap.insert({outputs[i].id(), {v_outputs[i], v_out_axes[i]}});
+    }
+  }
+  return slow;
+}
+
 std::function<std::vector<array>(const std::vector<array>&)> custom_function(
     std::function<std::vector<array>(const std::vector<array>&)> fun,
     std::optional<std::function<std::vector<array>(
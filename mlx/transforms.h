@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <deque>
+#include <future>
 #include <optional>
 
 #include "mlx/array.h"
@@ -15,6 +17,19 @@ void async_eval(Arrays&&... outputs) {
   async_eval(std::vector<array>{std::forward<Arrays>(outputs)...});
 }
 
+/**
+ * Schedule `outputs` for evaluation and invoke `callback` when they are
+ * ready.
+ *
+ * Like async_eval(), the calling thread returns as soon as the work is
+ * dispatched. The callback runs on the dedicated low priority readback
+ * stream once the tape's final event signals, so an event loop can be
+ * notified of completion — e.g. by posting to itself from the callback —
+ * without parking a thread on synchronize(). Callbacks fire in the order
+ * they were scheduled.
+ */
+void async_eval(std::vector<array> outputs, std::function<void()> callback);
+
 void eval(std::vector<array> outputs);
 
 template <typename... Arrays, typename = enable_for_arrays_t<Arrays...>>
@@ -22,6 +37,104 @@ void eval(Arrays&&... outputs) {
   eval(std::vector<array>{std::forward<Arrays>(outputs)...});
 }
 
+namespace detail {
+
+/** Enqueue a task on the dedicated low priority readback stream. */
+void enqueue_readback(std::function<void()> task);
+
+} // namespace detail
+
+/**
+ * Memoize the evaluated result of a subgraph.
+ *
+ * The subgraph producing `a` is hashed structurally (primitives, shapes,
+ * dtypes, small constants by value, other leaves by buffer identity) and
+ * looked up in a process-wide cache. A hit is verified exactly against the
+ * recorded subgraph — including Primitive::is_equivalent — and returns the
+ * previously evaluated array, so identical subexpressions rebuilt every
+ * step (positional tables, masks) are computed once. A miss evaluates `a`
+ * and caches it. Subgraphs containing multi-output primitives are
+ * evaluated but not cached.
+ */
+array memoize(array a);
+
+/** Set the memo cache byte budget; returns the previous budget. Entries
+ * are evicted least-recently-used when the budget is exceeded. */
+size_t set_memo_cache_limit(size_t limit);
+
+/** The number of bytes currently held by the memo cache. */
+size_t get_memo_cache_size();
+
+/** Drop all memoized results. */
+void clear_memo_cache();
+
+/**
+ * Asynchronously fetch the value of a scalar array.
+ *
+ * Schedules the array for evaluation if needed and enqueues the host read
+ * on a dedicated low priority CPU stream, returning immediately with a
+ * future for the value. Unlike item<T>(), the calling thread never blocks
+ * on the graph, so e.g. metrics collection does not stall dispatch.
+ */
+template <typename T>
+std::future<T> async_item(array a) {
+  if (a.size() != 1) {
+    throw std::invalid_argument(
+        "[async_item] can only be called on arrays of size 1.");
+  }
+  auto promise = std::make_shared<std::promise<T>>();
+  auto future = promise->get_future();
+  if (a.status() == array::Status::unscheduled) {
+    async_eval(a);
+  }
+  detail::enqueue_readback(
+      [a = std::move(a), promise = std::move(promise)]() mutable {
+        try {
+          a.wait();
+          promise->set_value(*a.template data<T>());
+        } catch (...) {
+          promise->set_exception(std::current_exception());
+        }
+      });
+  return future;
+}
+
+/**
+ * A bounded multi-step evaluation pipeline.
+ *
+ * Each push() schedules its batch of outputs with async_eval and keeps at
+ * most `depth` batches in flight: pushing past the depth blocks until the
+ * oldest batch has finished, giving backpressure without hand-rolled
+ * async_eval / wait bookkeeping. pop() waits for and returns the oldest
+ * batch still tracked by the pipeline.
+ */
+class EvalPipeline {
+ public:
+  explicit EvalPipeline(int depth) : depth_(std::max(depth, 1)) {}
+
+  /** Schedule a batch, blocking if `depth` batches are already in flight. */
+  void push(std::vector<array> outputs);
+
+  /** Wait for and return the oldest in-flight batch. */
+  std::vector<array> pop();
+
+  /** Wait for all in-flight batches. */
+  void wait_all();
+
+  /** The number of batches currently tracked by the pipeline. */
+  size_t size() const {
+    return batches_.size();
+  }
+
+  int depth() const {
+    return depth_;
+  }
+
+ private:
+  int depth_;
+  std::deque<std::vector<array>> batches_;
+};
+
 /**
  *  Computes the output and vector-Jacobian product (VJP) of a function.
  *
@@ -42,6 +155,26 @@ std::pair<array, array> vjp(
     const array& primal,
     const array& cotangent);
 
+/**
+ *  Computes the output and vector-Jacobian product (VJP) of a function,
+ *  accumulating the products onto existing gradients.
+ *
+ *  The i-th returned VJP is `grads[i]` plus the VJP for `primals[i]`, with
+ *  the addition folded into the backward graph, so accumulating over
+ *  micro-batches does not cost a separate full-tensor addition per step.
+ *  Rebind the persistent gradient arrays to the returned VJPs so the adds
+ *  can donate their buffers and run in place; reset them between optimizer
+ *  steps with `zero_grad`.
+ **/
+std::pair<std::vector<array>, std::vector<array>> vjp(
+    const std::function<std::vector<array>(const std::vector<array>&)>& fun,
+    const std::vector<array>& primals,
+    const std::vector<array>& cotangents,
+    const std::vector<array>& grads);
+
+/** Zero gradients shaped like `grads` to reset accumulation. */
+std::vector<array> zero_grad(const std::vector<array>& grads);
+
 /**
  *  Computes the output and Jacobian-vector product (JVP) of a function.
  *
@@ -185,6 +318,17 @@ std::function<std::vector<array>(const std::vector<array>&)> vmap(
     const std::vector<int>& in_axes = {},
     const std::vector<int>& out_axes = {});
 
+/**
+ * Trace `fun` under vmap and return the names of primitives whose batched
+ * lowering hits a slow path: either no batched implementation at all (the
+ * primitive's vmap throws) or a lowering that expands into per-element ops
+ * instead of a batched primitive.
+ */
+std::vector<std::string> vmap_slow_primitives(
+    const std::function<std::vector<array>(const std::vector<array>&)>& fun,
+    const std::vector<array>& inputs,
+    const std::vector<int>& in_axes = {});
+
 /**
  * Redefine the transformations of `fun` according to the provided functions.
  *
@@ -42,7 +42,9 @@ struct InTracing {
   }
 
  private:
-  static int grad_counter;
+  // Thread local so a background compilation thread can trace without
+  // touching the tracing state of the thread that launched it
+  static thread_local int grad_counter;
   static std::vector<std::pair<char, char>>& trace_stack();
 };
 
@@ -59,7 +61,7 @@ struct RetainGraph {
   }
 
  private:
-  static int tracing_counter;
+  static thread_local int tracing_counter;
 };
 
 /** Return true if we are currently performing a function transformation in
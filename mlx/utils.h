@@ -165,6 +165,154 @@ inline bool enable_tf32() {
   return enable_tf32_;
 }
 
+inline bool cudnn_autotune() {
+  static bool cudnn_autotune_ = get_var("MLX_CUDNN_AUTOTUNE", 0);
+  return cudnn_autotune_;
+}
+
+inline bool compile_dynamic_dims() {
+  static bool compile_dynamic_dims_ = get_var("MLX_COMPILE_DYNAMIC_DIMS", 0);
+  return compile_dynamic_dims_;
+}
+
+inline bool compile_constant_fold() {
+  static bool compile_constant_fold_ = get_var("MLX_COMPILE_CONSTANT_FOLD", 0);
+  return compile_constant_fold_;
+}
+
+inline bool compile_multi_output() {
+  static bool compile_multi_output_ = get_var("MLX_COMPILE_MULTI_OUTPUT", 0);
+  return compile_multi_output_;
+}
+
+inline bool compile_fuse_norms() {
+  static bool compile_fuse_norms_ = get_var("MLX_COMPILE_FUSE_NORMS", 0);
+  return compile_fuse_norms_;
+}
+
+inline bool compile_layout() {
+  static bool compile_layout_ = get_var("MLX_COMPILE_LAYOUT", 0);
+  return compile_layout_;
+}
+
+inline bool compile_placement() {
+  static bool compile_placement_ = get_var("MLX_COMPILE_PLACEMENT", 0);
+  return compile_placement_;
+}
+
+// Default element count under which a primitive is presumed faster on the
+// CPU; per-primitive values from set_placement_cost take precedence
+inline int placement_crossover() {
+  static int placement_crossover_ =
+      get_var("MLX_PLACEMENT_CROSSOVER", 1 << 14);
+  return placement_crossover_;
+}
+
+inline bool compile_async() {
+  static bool compile_async_ = get_var("MLX_COMPILE_ASYNC", 0);
+  return compile_async_;
+}
+
+inline bool import_optimize() {
+  static bool import_optimize_ = get_var("MLX_IMPORT_OPTIMIZE", 1);
+  return import_optimize_;
+}
+
+inline bool load_dedup() {
+  static bool load_dedup_ = get_var("MLX_LOAD_DEDUP", 0);
+  return load_dedup_;
+}
+
+inline bool mmap_load() {
+  static bool mmap_load_ = get_var("MLX_MMAP_LOAD", 0);
+  return mmap_load_;
+}
+
+inline bool zero_copy_import() {
+  static bool zero_copy_import_ = get_var("MLX_ZERO_COPY_IMPORT", 0);
+  return zero_copy_import_;
+}
+
+inline bool save_direct() {
+  static bool save_direct_ = get_var("MLX_SAVE_DIRECT", 0);
+  return save_direct_;
+}
+
+inline int direct_write_mbps() {
+  static int direct_write_mbps_ = get_var("MLX_DIRECT_WRITE_MBPS", 0);
+  return direct_write_mbps_;
+}
+
+inline int shard_load_streams() {
+  static int shard_load_streams_ = get_var("MLX_SHARD_LOAD_STREAMS", 4);
+  return shard_load_streams_;
+}
+
+inline int prefetch_streams() {
+  static int prefetch_streams_ = get_var("MLX_PREFETCH_STREAMS", 2);
+  return prefetch_streams_;
+}
+
+inline bool lazy_gguf() {
+  static bool lazy_gguf_ = get_var("MLX_LAZY_GGUF", 1);
+  return lazy_gguf_;
+}
+
+inline bool stream_buffer_pools() {
+  static bool stream_buffer_pools_ = get_var("MLX_STREAM_BUFFER_POOLS", 0);
+  return stream_buffer_pools_;
+}
+
+inline bool async_teardown() {
+  static bool async_teardown_ = get_var("MLX_ASYNC_TEARDOWN", 0);
+  return async_teardown_;
+}
+
+inline int grad_remat() {
+  static int grad_remat_ = get_var("MLX_GRAD_REMAT", 0);
+  return grad_remat_;
+}
+
+inline bool fuse_unary() {
+  static bool fuse_unary_ = get_var("MLX_FUSE_UNARY", 0);
+  return fuse_unary_;
+}
+
+inline bool fuse_gemm_epilogue() {
+  static bool fuse_gemm_epilogue_ = get_var("MLX_FUSE_GEMM_EPILOGUE", 0);
+  return fuse_gemm_epilogue_;
+}
+
+inline bool memory_plan() {
+  static bool memory_plan_ = get_var("MLX_MEMORY_PLAN", 0);
+  return memory_plan_;
+}
+
+inline bool eval_plan_cache() {
+  static bool eval_plan_cache_ = get_var("MLX_EVAL_PLAN_CACHE", 0);
+  return eval_plan_cache_;
+}
+
+inline int concurrent_eval() {
+  static int concurrent_eval_ = get_var("MLX_CONCURRENT_EVAL", 0);
+  return concurrent_eval_;
+}
+
+inline bool cpu_work_stealing() {
+  static bool cpu_work_stealing_ = get_var("MLX_CPU_WORK_STEALING", 0);
+  return cpu_work_stealing_;
+}
+
+inline int all_sum_bucket_mb() {
+  static int all_sum_bucket_mb_ = get_var("MLX_ALL_SUM_BUCKET_MB", 25);
+  return all_sum_bucket_mb_;
+}
+
+inline int send_chunk_mb() {
+  static int send_chunk_mb_ = get_var("MLX_SEND_CHUNK_MB", 4);
+  return send_chunk_mb_;
+}
+
 } // namespace env
 
 } // namespace mlx::core
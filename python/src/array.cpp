@@ -495,7 +495,7 @@ void init_array(nb::module_& m) {
           "memo"_a)
       .def(
           "__add__",
-          [](const mx::array& a, const ScalarOrArray v) {
+          [](const mx::array& a, const ScalarOrArray& v) {
             if (!is_comparable_with_array(v)) {
               throw_invalid_operation("addition", v);
             }
@@ -505,7 +505,7 @@ void init_array(nb::module_& m) {
           "other"_a)
       .def(
           "__iadd__",
-          [](mx::array& a, const ScalarOrArray v) -> mx::array& {
+          [](mx::array& a, const ScalarOrArray& v) -> mx::array& {
             if (!is_comparable_with_array(v)) {
               throw_invalid_operation("inplace addition", v);
             }
@@ -516,7 +516,7 @@ void init_array(nb::module_& m) {
           nb::rv_policy::none)
       .def(
           "__radd__",
-          [](const mx::array& a, const ScalarOrArray v) {
+          [](const mx::array& a, const ScalarOrArray& v) {
             if (!is_comparable_with_array(v)) {
               throw_invalid_operation("addition", v);
             }
@@ -525,7 +525,7 @@ void init_array(nb::module_& m) {
           "other"_a)
       .def(
           "__sub__",
-          [](const mx::array& a, const ScalarOrArray v) {
+          [](const mx::array& a, const ScalarOrArray& v) {
             if (!is_comparable_with_array(v)) {
               throw_invalid_operation("subtraction", v);
             }
@@ -534,7 +534,7 @@ void init_array(nb::module_& m) {
           "other"_a)
       .def(
           "__isub__",
-          [](mx::array& a, const ScalarOrArray v) -> mx::array& {
+          [](mx::array& a, const ScalarOrArray& v) -> mx::array& {
             if (!is_comparable_with_array(v)) {
               throw_invalid_operation("inplace subtraction", v);
             }
@@ -545,7 +545,7 @@ void init_array(nb::module_& m) {
           nb::rv_policy::none)
       .def(
           "__rsub__",
-          [](const mx::array& a, const ScalarOrArray v) {
+          [](const mx::array& a, const ScalarOrArray& v) {
             if (!is_comparable_with_array(v)) {
               throw_invalid_operation("subtraction", v);
             }
@@ -554,7 +554,7 @@ void init_array(nb::module_& m) {
           "other"_a)
       .def(
           "__mul__",
-          [](const mx::array& a, const ScalarOrArray v) {
+          [](const mx::array& a, const ScalarOrArray& v) {
             if (!is_comparable_with_array(v)) {
               throw_invalid_operation("multiplication", v);
             }
@@ -563,7 +563,7 @@ void init_array(nb::module_& m) {
           "other"_a)
       .def(
           "__imul__",
-          [](mx::array& a, const ScalarOrArray v) -> mx::array& {
+          [](mx::array& a, const ScalarOrArray& v) -> mx::array& {
             if (!is_comparable_with_array(v)) {
               throw_invalid_operation("inplace multiplication", v);
             }
@@ -574,7 +574,7 @@ void init_array(nb::module_& m) {
           nb::rv_policy::none)
       .def(
           "__rmul__",
-          [](const mx::array& a, const ScalarOrArray v) {
+          [](const mx::array& a, const ScalarOrArray& v) {
             if (!is_comparable_with_array(v)) {
               throw_invalid_operation("multiplication", v);
             }
@@ -583,7 +583,7 @@ void init_array(nb::module_& m) {
           "other"_a)
       .def(
           "__truediv__",
-          [](const mx::array& a, const ScalarOrArray v) {
+          [](const mx::array& a, const ScalarOrArray& v) {
             if (!is_comparable_with_array(v)) {
               throw_invalid_operation("division", v);
             }
@@ -592,7 +592,7 @@ void init_array(nb::module_& m) {
           "other"_a)
       .def(
           "__itruediv__",
-          [](mx::array& a, const ScalarOrArray v) -> mx::array& {
+          [](mx::array& a, const ScalarOrArray& v) -> mx::array& {
             if (!is_comparable_with_array(v)) {
               throw_invalid_operation("inplace division", v);
             }
@@ -607,7 +607,7 @@ void init_array(nb::module_& m) {
           nb::rv_policy::none)
       .def(
           "__rtruediv__",
-          [](const mx::array& a, const ScalarOrArray v) {
+          [](const mx::array& a, const ScalarOrArray& v) {
             if (!is_comparable_with_array(v)) {
               throw_invalid_operation("division", v);
             }
@@ -616,7 +616,7 @@ void init_array(nb::module_& m) {
           "other"_a)
       .def(
           "__div__",
-          [](const mx::array& a, const ScalarOrArray v) {
+          [](const mx::array& a, const ScalarOrArray& v) {
             if (!is_comparable_with_array(v)) {
               throw_invalid_operation("division", v);
             }
@@ -625,7 +625,7 @@ void init_array(nb::module_& m) {
           "other"_a)
       .def(
           "__rdiv__",
-          [](const mx::array& a, const ScalarOrArray v) {
+          [](const mx::array& a, const ScalarOrArray& v) {
             if (!is_comparable_with_array(v)) {
               throw_invalid_operation("division", v);
             }
@@ -634,7 +634,7 @@ void init_array(nb::module_& m) {
           "other"_a)
       .def(
           "__floordiv__",
-          [](const mx::array& a, const ScalarOrArray v) {
+          [](const mx::array& a, const ScalarOrArray& v) {
             if (!is_comparable_with_array(v)) {
               throw_invalid_operation("floor division", v);
             }
@@ -643,7 +643,7 @@ void init_array(nb::module_& m) {
           "other"_a)
       .def(
           "__ifloordiv__",
-          [](mx::array& a, const ScalarOrArray v) -> mx::array& {
+          [](mx::array& a, const ScalarOrArray& v) -> mx::array& {
             if (!is_comparable_with_array(v)) {
               throw_invalid_operation("inplace floor division", v);
             }
@@ -654,7 +654,7 @@ void init_array(nb::module_& m) {
           nb::rv_policy::none)
       .def(
           "__rfloordiv__",
-          [](const mx::array& a, const ScalarOrArray v) {
+          [](const mx::array& a, const ScalarOrArray& v) {
             if (!is_comparable_with_array(v)) {
               throw_invalid_operation("floor division", v);
             }
@@ -664,7 +664,7 @@ void init_array(nb::module_& m) {
           "other"_a)
       .def(
           "__mod__",
-          [](const mx::array& a, const ScalarOrArray v) {
+          [](const mx::array& a, const ScalarOrArray& v) {
             if (!is_comparable_with_array(v)) {
               throw_invalid_operation("modulus", v);
             }
@@ -673,7 +673,7 @@ void init_array(nb::module_& m) {
           "other"_a)
       .def(
           "__imod__",
-          [](mx::array& a, const ScalarOrArray v) -> mx::array& {
+          [](mx::array& a, const ScalarOrArray& v) -> mx::array& {
             if (!is_comparable_with_array(v)) {
               throw_invalid_operation("inplace modulus", v);
             }
@@ -684,7 +684,7 @@ void init_array(nb::module_& m) {
           nb::rv_policy::none)
       .def(
           "__rmod__",
-          [](const mx::array& a, const ScalarOrArray v) {
+          [](const mx::array& a, const ScalarOrArray& v) {
             if (!is_comparable_with_array(v)) {
               throw_invalid_operation("modulus", v);
             }
@@ -703,7 +703,7 @@ void init_array(nb::module_& m) {
           "other"_a)
       .def(
           "__lt__",
-          [](const mx::array& a, const ScalarOrArray v) -> mx::array {
+          [](const mx::array& a, const ScalarOrArray& v) -> mx::array {
             if (!is_comparable_with_array(v)) {
               throw_invalid_operation("less than", v);
             }
@@ -712,7 +712,7 @@ void init_array(nb::module_& m) {
           "other"_a)
       .def(
           "__le__",
-          [](const mx::array& a, const ScalarOrArray v) -> mx::array {
+          [](const mx::array& a, const ScalarOrArray& v) -> mx::array {
             if (!is_comparable_with_array(v)) {
               throw_invalid_operation("less than or equal", v);
             }
@@ -721,7 +721,7 @@ void init_array(nb::module_& m) {
           "other"_a)
       .def(
           "__gt__",
-          [](const mx::array& a, const ScalarOrArray v) -> mx::array {
+          [](const mx::array& a, const ScalarOrArray& v) -> mx::array {
             if (!is_comparable_with_array(v)) {
               throw_invalid_operation("greater than", v);
             }
@@ -730,7 +730,7 @@ void init_array(nb::module_& m) {
           "other"_a)
       .def(
           "__ge__",
-          [](const mx::array& a, const ScalarOrArray v) -> mx::array {
+          [](const mx::array& a, const ScalarOrArray& v) -> mx::array {
             if (!is_comparable_with_array(v)) {
               throw_invalid_operation("greater than or equal", v);
             }
@@ -740,7 +740,7 @@ void init_array(nb::module_& m) {
       .def(
           "__ne__",
           [](const mx::array& a,
-             const ScalarOrArray v) -> std::variant<mx::array, bool> {
+             const ScalarOrArray& v) -> std::variant<mx::array, bool> {
             if (!is_comparable_with_array(v)) {
               return true;
             }
@@ -773,7 +773,7 @@ void init_array(nb::module_& m) {
           nb::rv_policy::none)
       .def(
           "__pow__",
-          [](const mx::array& a, const ScalarOrArray v) {
+          [](const mx::array& a, const ScalarOrArray& v) {
             if (!is_comparable_with_array(v)) {
               throw_invalid_operation("power", v);
             }
@@ -782,7 +782,7 @@ void init_array(nb::module_& m) {
           "other"_a)
       .def(
           "__rpow__",
-          [](const mx::array& a, const ScalarOrArray v) {
+          [](const mx::array& a, const ScalarOrArray& v) {
             if (!is_comparable_with_array(v)) {
               throw_invalid_operation("power", v);
             }
@@ -791,7 +791,7 @@ void init_array(nb::module_& m) {
           "other"_a)
       .def(
           "__ipow__",
-          [](mx::array& a, const ScalarOrArray v) -> mx::array& {
+          [](mx::array& a, const ScalarOrArray& v) -> mx::array& {
             if (!is_comparable_with_array(v)) {
               throw_invalid_operation("inplace power", v);
             }
@@ -814,7 +814,7 @@ void init_array(nb::module_& m) {
           })
       .def(
           "__and__",
-          [](const mx::array& a, const ScalarOrArray v) {
+          [](const mx::array& a, const ScalarOrArray& v) {
             if (!is_comparable_with_array(v)) {
               throw_invalid_operation("bitwise and", v);
             }
@@ -829,7 +829,7 @@ void init_array(nb::module_& m) {
           "other"_a)
       .def(
           "__iand__",
-          [](mx::array& a, const ScalarOrArray v) -> mx::array& {
+          [](mx::array& a, const ScalarOrArray& v) -> mx::array& {
             if (!is_comparable_with_array(v)) {
               throw_invalid_operation("inplace bitwise and", v);
             }
@@ -846,7 +846,7 @@ void init_array(nb::module_& m) {
           nb::rv_policy::none)
       .def(
           "__or__",
-          [](const mx::array& a, const ScalarOrArray v) {
+          [](const mx::array& a, const ScalarOrArray& v) {
             if (!is_comparable_with_array(v)) {
               throw_invalid_operation("bitwise or", v);
             }
@@ -861,7 +861,7 @@ void init_array(nb::module_& m) {
           "other"_a)
       .def(
           "__ior__",
-          [](mx::array& a, const ScalarOrArray v) -> mx::array& {
+          [](mx::array& a, const ScalarOrArray& v) -> mx::array& {
             if (!is_comparable_with_array(v)) {
               throw_invalid_operation("inplace bitwise or", v);
             }
@@ -878,7 +878,7 @@ void init_array(nb::module_& m) {
           nb::rv_policy::none)
       .def(
           "__lshift__",
-          [](const mx::array& a, const ScalarOrArray v) {
+          [](const mx::array& a, const ScalarOrArray& v) {
             if (!is_comparable_with_array(v)) {
               throw_invalid_operation("left shift", v);
             }
@@ -893,7 +893,7 @@ void init_array(nb::module_& m) {
           "other"_a)
       .def(
           "__ilshift__",
-          [](mx::array& a, const ScalarOrArray v) -> mx::array& {
+          [](mx::array& a, const ScalarOrArray& v) -> mx::array& {
             if (!is_comparable_with_array(v)) {
               throw_invalid_operation("inplace left shift", v);
             }
@@ -910,7 +910,7 @@ void init_array(nb::module_& m) {
           nb::rv_policy::none)
       .def(
           "__rshift__",
-          [](const mx::array& a, const ScalarOrArray v) {
+          [](const mx::array& a, const ScalarOrArray& v) {
             if (!is_comparable_with_array(v)) {
               throw_invalid_operation("right shift", v);
             }
@@ -925,7 +925,7 @@ void init_array(nb::module_& m) {
           "other"_a)
       .def(
           "__irshift__",
-          [](mx::array& a, const ScalarOrArray v) -> mx::array& {
+          [](mx::array& a, const ScalarOrArray& v) -> mx::array& {
             if (!is_comparable_with_array(v)) {
               throw_invalid_operation("inplace right shift", v);
             }
@@ -942,7 +942,7 @@ void init_array(nb::module_& m) {
           nb::rv_policy::none)
       .def(
           "__xor__",
-          [](const mx::array& a, const ScalarOrArray v) {
+          [](const mx::array& a, const ScalarOrArray& v) {
             if (!is_comparable_with_array(v)) {
               throw_invalid_operation("bitwise xor", v);
             }
@@ -957,7 +957,7 @@ void init_array(nb::module_& m) {
           "other"_a)
       .def(
           "__ixor__",
-          [](mx::array& a, const ScalarOrArray v) -> mx::array& {
+          [](mx::array& a, const ScalarOrArray& v) -> mx::array& {
             if (!is_comparable_with_array(v)) {
               throw_invalid_operation("inplace bitwise xor", v);
             }
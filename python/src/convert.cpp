@@ -40,9 +40,36 @@ mx::array nd_array_to_mlx_contiguous(
     nb::ndarray<nb::ro, nb::c_contig, nb::device::cpu> nd_array,
     const mx::Shape& shape,
     mx::Dtype dtype) {
+  auto data_ptr = nd_array.data();
+  // With MLX_ZERO_COPY_IMPORT set, share the provider's buffer instead of
+  // copying it when no dtype conversion is needed. The array then aliases
+  // caller-owned memory: the provider is kept alive until the buffer is
+  // released and the buffer is never donated to an output, but mutating
+  // the source while a graph referencing it is pending is undefined.
+  if constexpr (!std::is_same_v<T, mx::complex128_t>) {
+    if (mx::env::zero_copy_import() && nd_array.size() > 0 &&
+        dtype == mx::TypeToDtype<T>{}) {
+      try {
+        mx::array arr(shape, dtype, nullptr, {});
+        auto buf = mx::allocator::wrap_external(
+            const_cast<void*>(data_ptr), arr.nbytes());
+        arr.set_data(buf, [nd_array](mx::allocator::Buffer b) mutable {
+          mx::allocator::free(b);
+          // The last reference can be dropped off the main thread
+          nb::gil_scoped_acquire acquire;
+          nd_array = {};
+        });
+        arr.set_data_not_donatable();
+        arr.set_status(mx::array::Status::available);
+        return arr;
+      } catch (const std::exception&) {
+        // Fall through to a copy when wrapping is unsupported (e.g. the
+        // Metal allocator requires page-aligned memory)
+      }
+    }
+  }
   // Make a copy of the numpy buffer
   // Get buffer ptr pass to array constructor
-  auto data_ptr = nd_array.data();
   return mx::array(static_cast<const T*>(data_ptr), shape, dtype);
 }
 
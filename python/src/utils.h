@@ -18,11 +18,12 @@ namespace nb = nanobind;
 
 using IntOrVec = std::variant<std::monostate, int, std::vector<int>>;
 using ScalarOrArray = std::variant<
+    // Arrays are by far the most common argument so try them first to keep
+    // the conversion cheap on the hot path. Must be above ndarray.
+    mx::array,
     nb::bool_,
     nb::int_,
     nb::float_,
-    // Must be above ndarray
-    mx::array,
     // Must be above complex
     nb::ndarray<nb::ro, nb::c_contig, nb::device::cpu>,
     std::complex<float>,
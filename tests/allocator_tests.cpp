@@ -1,5 +1,7 @@
 // Copyright © 2023 Apple Inc.
 
+#include <unistd.h>
+#include <cstdlib>
 #include <stdexcept>
 
 #include "doctest/doctest.h"
@@ -39,3 +41,38 @@ TEST_CASE("test large allocations") {
     allocator::free(buffer);
   }
 }
+
+TEST_CASE("test wrap external") {
+  // Page aligned so the test also passes on the Metal allocator
+  size_t page_size = sysconf(_SC_PAGESIZE);
+  void* data = nullptr;
+  REQUIRE_EQ(posix_memalign(&data, page_size, page_size), 0);
+  auto fdata = static_cast<float*>(data);
+  fdata[0] = 1.0f;
+
+  auto buffer = allocator::wrap_external(data, page_size);
+  CHECK_EQ(buffer.raw_ptr(), data);
+  CHECK_EQ(allocator::allocator().size(buffer), page_size);
+
+  // Freeing the buffer releases the wrapper, not the external memory
+  allocator::free(buffer);
+  CHECK_EQ(fdata[0], 1.0f);
+  ::free(data);
+}
+
+TEST_CASE("test wired allocations") {
+  auto buffer = allocator::malloc_wired(4096);
+  auto ptr = static_cast<float*>(buffer.raw_ptr());
+  ptr[0] = 1.0f;
+  CHECK_EQ(ptr[0], 1.0f);
+  CHECK_EQ(allocator::allocator().size(buffer), 4096);
+  allocator::free(buffer);
+
+  // Allocations inside a ScopedWired guard are routed to the wired class
+  {
+    allocator::ScopedWired wired;
+    auto b = allocator::malloc(128);
+    CHECK(b.raw_ptr() != nullptr);
+    allocator::free(b);
+  }
+}
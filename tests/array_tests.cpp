@@ -608,3 +608,19 @@ TEST_CASE("test make empty array") {
   CHECK_EQ(a.size(), 0);
   CHECK_EQ(a.dtype(), bool_);
 }
+
+TEST_CASE("test consumable array donation") {
+  auto a = array({1.0f, 2.0f});
+  auto b = a;
+
+  // A second handle normally blocks donation
+  CHECK(!a.is_donatable());
+
+  // Marking the array consumable forgives exactly one external handle
+  a.set_consumable();
+  CHECK(a.is_consumable());
+  CHECK(a.is_donatable());
+
+  auto c = a;
+  CHECK(!a.is_donatable());
+}
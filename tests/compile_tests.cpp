@@ -804,3 +804,30 @@ TEST_CASE("test compile with no-ops") {
   auto out = compile(fun)({in})[0];
   CHECK_EQ(out.inputs()[0].id(), in.id());
 }
+
+TEST_CASE("test memoize") {
+  clear_memo_cache();
+
+  auto build = []() { return multiply(arange(16), array(2)); };
+
+  auto a = memoize(build());
+  CHECK(a.is_available());
+  auto cached_bytes = get_memo_cache_size();
+  CHECK(cached_bytes >= a.nbytes());
+
+  // A structurally identical subgraph returns the cached result
+  auto b = memoize(build());
+  CHECK_EQ(a.id(), b.id());
+  CHECK_EQ(get_memo_cache_size(), cached_bytes);
+
+  // A different constant is a different subgraph
+  auto c = memoize(multiply(arange(16), array(3)));
+  CHECK(c.id() != a.id());
+  CHECK(array_equal(c, multiply(arange(16), array(3))).item<bool>());
+
+  // Eviction respects the byte budget
+  auto old_limit = set_memo_cache_limit(0);
+  CHECK_EQ(get_memo_cache_size(), 0);
+  set_memo_cache_limit(old_limit);
+  clear_memo_cache();
+}
@@ -91,3 +91,78 @@ TEST_CASE("test eval graph retention when not tracing") {
   CHECK(!a.has_primitive());
   CHECK(a.is_available());
 }
+
+TEST_CASE("test eval pipeline") {
+  EvalPipeline pipeline(2);
+  std::vector<array> batches;
+  for (int i = 0; i < 5; ++i) {
+    auto x = full({4, 4}, static_cast<float>(i));
+    auto y = x + x;
+    pipeline.push({y});
+    batches.push_back(y);
+  }
+  CHECK(pipeline.size() <= 2);
+  pipeline.wait_all();
+  CHECK_EQ(pipeline.size(), 0);
+  for (int i = 0; i < 5; ++i) {
+    CHECK(
+        array_equal(batches[i], full({4, 4}, 2.0f * i)).item<bool>());
+  }
+
+  // Popping an empty pipeline is a no-op
+  CHECK(pipeline.pop().empty());
+}
+
+TEST_CASE("test async item") {
+  auto x = full({8}, 2.0f);
+  auto loss = sum(x * x);
+  auto f = async_item<float>(loss);
+  CHECK_EQ(f.get(), 32.0f);
+
+  // Already evaluated arrays resolve without re-scheduling
+  auto y = array(7);
+  y.eval();
+  CHECK_EQ(async_item<int>(y).get(), 7);
+
+  CHECK_THROWS(async_item<float>(full({2}, 1.0f)));
+}
+
+TEST_CASE("test async eval callback") {
+  auto x = full({8}, 2.0f);
+  auto y = x + x;
+  std::promise<void> done;
+  async_eval({y}, [&done]() { done.set_value(); });
+  done.get_future().wait();
+  CHECK(y.is_available());
+  CHECK(array_equal(y, full({8}, 4.0f)).item<bool>());
+
+  // Already scheduled work still gets its callback
+  std::promise<void> again;
+  async_eval({y}, [&again]() { again.set_value(); });
+  again.get_future().wait();
+
+  // As does an empty batch
+  std::promise<void> empty;
+  async_eval(std::vector<array>{}, [&empty]() { empty.set_value(); });
+  empty.get_future().wait();
+}
+
+TEST_CASE("test allocation telemetry") {
+  enable_allocation_telemetry();
+  clear_allocation_telemetry();
+
+  auto a = ones({128});
+  auto b = ones({128});
+  eval(a + b);
+
+  auto sites = allocation_telemetry_snapshot();
+  enable_allocation_telemetry(false);
+
+  bool found = false;
+  for (auto& site : sites) {
+    found |= (site.primitive == "Add" && site.bytes >= 128 * sizeof(float) &&
+              site.count >= 1);
+  }
+  CHECK(found);
+  clear_allocation_telemetry();
+}
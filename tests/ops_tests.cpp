@@ -2420,6 +2420,24 @@ TEST_CASE("test scatter") {
         reshape(array({0, 0, 0, 0, 0, 0, 1, 2, 0, 0, 3, 4}), {3, 4});
     CHECK(array_equal(out, expected).item<bool>());
   }
+
+  // Scatter add accumulates into a donated destination without copying.
+  // zeros() evaluates to a broadcast scalar, so materialize a dense
+  // destination with an elementwise op; synchronize so the deferred
+  // frees from its eval have drained and the buffer is donatable.
+  {
+    auto dst = multiply(ones({8, 4}, float32), array(0.0f));
+    eval(dst);
+    synchronize();
+    auto dst_ptr = dst.data<float>();
+    dst.set_consumable();
+    auto idx = array({1, 1, 6}, uint32);
+    auto updates = ones({3, 1, 4}, float32);
+    auto out = scatter_add(dst, idx, updates, 0);
+    eval(out);
+    CHECK_EQ(out.data<float>(), dst_ptr);
+    CHECK_EQ(sum(out).item<float>(), 12.0f);
+  }
 }
 
 TEST_CASE("test is positive infinity") {
@@ -2596,6 +2614,75 @@ TEST_CASE("test as_strided op") {
   CHECK(array_equal(y, expected).item<bool>());
 }
 
+TEST_CASE("test bincount") {
+  auto x = array({0, 1, 1, 3, 1, 0});
+  auto counts = bincount(x, 4);
+  CHECK_EQ(counts.dtype(), uint32);
+  CHECK(array_equal(counts, array({2u, 3u, 0u, 1u})).item<bool>());
+
+  // Leading axes are batched
+  x = array({0, 0, 1, 2, 2, 2}, {2, 3});
+  counts = bincount(x, 3);
+  CHECK_EQ(counts.shape(), Shape{2, 3});
+  CHECK(array_equal(counts, array({2u, 1u, 0u, 0u, 0u, 3u}, {2, 3}))
+            .item<bool>());
+
+  // Out of range values are ignored
+  x = array({-1, 0, 5, 1});
+  counts = bincount(x, 2);
+  CHECK(array_equal(counts, array({1u, 1u})).item<bool>());
+
+  CHECK_THROWS(bincount(array({1.0f, 2.0f}), 3));
+  CHECK_THROWS(bincount(array(1), 3));
+  CHECK_THROWS(bincount(array({1, 2}), 0));
+}
+
+TEST_CASE("test run length encoding") {
+  auto x = array({7, 7, 3, 5, 5, 5});
+  auto rle = rle_encode(x);
+  CHECK_EQ(rle[2].item<uint32_t>(), 3);
+  CHECK(array_equal(rle[0], array({7, 3, 5, 0, 0, 0})).item<bool>());
+  CHECK(
+      array_equal(rle[1], array({2u, 1u, 3u, 0u, 0u, 0u})).item<bool>());
+
+  // Round trip through the padded representation
+  auto y = rle_decode(rle[0], rle[1], x.size());
+  CHECK(array_equal(y, x).item<bool>());
+
+  // And through the tight representation
+  auto values = array({7, 3, 5});
+  auto lengths = array({2u, 1u, 3u});
+  y = rle_decode(values, lengths, 6);
+  CHECK(array_equal(y, x).item<bool>());
+
+  CHECK_THROWS(rle_encode(array({1.0f, 2.0f})));
+  CHECK_THROWS(rle_encode(zeros({2, 2}, int32)));
+  CHECK_THROWS(rle_decode(values, array({2u, 1u}), 6));
+}
+
+TEST_CASE("test sliding window view") {
+  auto x = arange(8);
+  auto y = sliding_window_view(x, 4, 0, 2);
+  auto expected = array({0, 1, 2, 3, 2, 3, 4, 5, 4, 5, 6, 7}, {3, 4});
+  CHECK(array_equal(y, expected).item<bool>());
+
+  // Window dimension goes last for multi-dimensional inputs
+  x = reshape(arange(12), {2, 6});
+  y = sliding_window_view(x, 3, 1, 3);
+  CHECK_EQ(y.shape(), Shape{2, 2, 3});
+  expected = array({0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11}, {2, 2, 3});
+  CHECK(array_equal(y, expected).item<bool>());
+
+  // Overlapping frames along the default last axis
+  y = sliding_window_view(x, 5);
+  CHECK_EQ(y.shape(), Shape{2, 2, 5});
+
+  CHECK_THROWS(sliding_window_view(x, 7, 1));
+  CHECK_THROWS(sliding_window_view(x, 0, 1));
+  CHECK_THROWS(sliding_window_view(x, 2, 1, 0));
+  CHECK_THROWS(sliding_window_view(array(1.0f), 1));
+}
+
 TEST_CASE("test scan op") {
   auto x = array({1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f}, {2, 3});
   auto y = cumsum(x, 1, false, true);
@@ -3722,6 +3809,65 @@ TEST_CASE("test conv1d") {
   }
 }
 
+TEST_CASE("test fft conv1d") {
+  // Float32 1-D convolutions with >= 1024 taps route through the FFT;
+  // compare against a direct as_strided + matmul reference
+  int N = 2;
+  int L = 1400;
+  int K = 1024;
+  int C_in = 2;
+  int C_out = 3;
+
+  auto direct_conv1d = [&](const array& x, const array& w, int stride) {
+    int L_pad = x.shape(1);
+    int out_len = (L_pad - K) / stride + 1;
+    auto windows = as_strided(
+        x,
+        {N, out_len, K, C_in},
+        {static_cast<int64_t>(L_pad) * C_in, stride * C_in, C_in, 1},
+        0);
+    auto y = matmul(
+        reshape(windows, {N * out_len, K * C_in}),
+        transpose(reshape(w, {C_out, K * C_in})));
+    return reshape(y, {N, out_len, C_out});
+  };
+
+  random::seed(7);
+  auto x = random::uniform(-1.0, 1.0, {N, L, C_in});
+  auto w = multiply(random::uniform(-1.0, 1.0, {C_out, K, C_in}), array(0.03f));
+  eval(x, w);
+
+  {
+    auto out = conv1d(x, w, /* stride= */ 1);
+    auto expected = direct_conv1d(x, w, 1);
+    CHECK(allclose(out, expected, 1e-4, 1e-4).item<bool>());
+  }
+
+  {
+    int stride = 3;
+    int padding = 6;
+    auto out = conv1d(x, w, stride, padding);
+    auto xp = pad(x, {1}, {padding}, {padding}, array(0.0f));
+    auto expected = direct_conv1d(xp, w, stride);
+    CHECK(allclose(out, expected, 1e-4, 1e-4).item<bool>());
+  }
+
+  // The kernel spectrum cache keys on the weight's identity; a new weight
+  // allocated after an old one is freed must not hit the old spectrum
+  {
+    auto run = [&](float scale) {
+      auto wt =
+          multiply(random::uniform(-1.0, 1.0, {C_out, K, C_in}), array(scale));
+      eval(wt);
+      auto out = conv1d(x, wt, /* stride= */ 1);
+      auto expected = direct_conv1d(x, wt, 1);
+      CHECK(allclose(out, expected, 1e-4, 1e-4).item<bool>());
+    };
+    run(0.03f);
+    run(0.05f);
+  }
+}
+
 TEST_CASE("test conv2d") {
   auto in = array(
       {0.57429284,
@@ -4032,3 +4178,351 @@ TEST_CASE("test conv_transpose3d with output_padding") {
       {1, 2, 4, 4, 1});
   CHECK(array_equal(out, expected).item<bool>());
 }
+
+TEST_CASE("test segment reduce") {
+  auto a = array({1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f}, {3, 2});
+
+  // Unsorted ids; segments 1 and 3 are empty
+  {
+    auto ids = array({2, 0, 2}, int32);
+    auto out = segment_sum(a, ids, 4);
+    auto expected =
+        array({3.0f, 4.0f, 0.0f, 0.0f, 6.0f, 8.0f, 0.0f, 0.0f}, {4, 2});
+    CHECK(array_equal(out, expected).item<bool>());
+
+    float neg_inf = -std::numeric_limits<float>::infinity();
+    out = segment_max(a, ids, 4);
+    expected =
+        array({3.0f, 4.0f, neg_inf, neg_inf, 5.0f, 6.0f, neg_inf, neg_inf},
+              {4, 2});
+    CHECK(array_equal(out, expected).item<bool>());
+  }
+
+  // 1-D input
+  {
+    auto x = array({1, 2, 3, 4}, int32);
+    auto ids = array({1, 1, 0, 1}, int32);
+    CHECK(array_equal(segment_sum(x, ids, 2), array({3, 7}, int32))
+              .item<bool>());
+    CHECK(array_equal(segment_max(x, ids, 2), array({3, 4}, int32))
+              .item<bool>());
+  }
+
+  // Ids outside [0, num_segments) are ignored
+  {
+    auto ids = array({0, -1, 5}, int32);
+    auto out = segment_sum(a, ids, 2);
+    auto expected = array({1.0f, 2.0f, 0.0f, 0.0f}, {2, 2});
+    CHECK(array_equal(out, expected).item<bool>());
+
+    float neg_inf = -std::numeric_limits<float>::infinity();
+    out = segment_max(a, ids, 2);
+    expected = array({1.0f, 2.0f, neg_inf, neg_inf}, {2, 2});
+    CHECK(array_equal(out, expected).item<bool>());
+  }
+
+  // Shape and argument validation
+  CHECK_THROWS(segment_sum(a, array({0, 1}, int32), 2));
+  CHECK_THROWS(segment_sum(a, array({0, 0, 1}, int32), 0));
+  CHECK_THROWS(segment_max(a, astype(a, int32), 2));
+}
+
+TEST_CASE("test max and argmax") {
+  auto a = array({1.0f, 5.0f, 3.0f, 5.0f, 2.0f, 4.0f, 6.0f, 0.0f}, {2, 4});
+
+  // Ties resolve to the first occurrence, matching argmax
+  {
+    auto [values, indices] = max_and_argmax(a, 1);
+    CHECK(array_equal(values, array({5.0f, 6.0f})).item<bool>());
+    CHECK(array_equal(indices, array({1, 2}, uint32)).item<bool>());
+  }
+
+  // Axis 0 and negative axis
+  {
+    auto [values, indices] = max_and_argmax(a, 0);
+    CHECK(array_equal(values, array({2.0f, 5.0f, 6.0f, 5.0f})).item<bool>());
+    CHECK(array_equal(indices, array({1, 0, 1, 0}, uint32)).item<bool>());
+
+    auto [v_neg, i_neg] = max_and_argmax(a, -1);
+    CHECK(array_equal(v_neg, array({5.0f, 6.0f})).item<bool>());
+    CHECK(array_equal(i_neg, array({1, 2}, uint32)).item<bool>());
+  }
+
+  // keepdims keeps the reduced axis
+  {
+    auto [values, indices] = max_and_argmax(a, 1, true);
+    CHECK_EQ(values.shape(), Shape{2, 1});
+    CHECK_EQ(indices.shape(), Shape{2, 1});
+  }
+
+  // Flattened overload reduces over all elements
+  {
+    auto [values, indices] = max_and_argmax(a);
+    CHECK_EQ(values.item<float>(), 6.0f);
+    CHECK_EQ(indices.item<uint32_t>(), 6);
+
+    auto [vk, ik] = max_and_argmax(a, /* keepdims = */ true);
+    CHECK_EQ(vk.shape(), Shape{1, 1});
+    CHECK_EQ(ik.shape(), Shape{1, 1});
+  }
+
+  // All-equal input picks index 0
+  {
+    auto [values, indices] = max_and_argmax(full({5}, 2.0f), 0);
+    CHECK_EQ(values.item<float>(), 2.0f);
+    CHECK_EQ(indices.item<uint32_t>(), 0);
+  }
+
+  CHECK_THROWS(max_and_argmax(zeros({0}), 0));
+}
+
+TEST_CASE("test mean and var") {
+  auto a = array({1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f}, {2, 3});
+
+  {
+    auto [m, v] = mean_and_var(a, 1);
+    CHECK(allclose(m, array({2.0f, 5.0f})).item<bool>());
+    CHECK(allclose(v, array({2.0f / 3, 2.0f / 3})).item<bool>());
+
+    auto [m1, v1] = mean_and_var(a, 1, /* keepdims = */ false, /* ddof = */ 1);
+    CHECK(allclose(v1, array({1.0f, 1.0f})).item<bool>());
+  }
+
+  {
+    auto [m, v] = mean_and_var(a, {0, 1}, /* keepdims = */ true);
+    CHECK_EQ(m.shape(), Shape{1, 1});
+    CHECK_EQ(v.shape(), Shape{1, 1});
+    CHECK(allclose(m, array(3.5f)).item<bool>());
+    CHECK(allclose(v, array(35.0f / 12)).item<bool>());
+  }
+
+  // Matches the unfused reductions on a bigger input
+  {
+    random::seed(3);
+    auto x = random::uniform(-1.0, 1.0, {3, 4, 5});
+    for (auto& axes : std::vector<std::vector<int>>{{0}, {2}, {0, 2}}) {
+      for (bool keepdims : {false, true}) {
+        auto [m, v] = mean_and_var(x, axes, keepdims);
+        CHECK(allclose(m, mean(x, axes, keepdims)).item<bool>());
+        CHECK(allclose(v, var(x, axes, keepdims), 1e-4, 1e-6).item<bool>());
+      }
+    }
+  }
+}
+
+TEST_CASE("test masked select and nonzero") {
+  auto a = array({1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f}, {2, 3});
+
+  {
+    auto mask = array({false, true, false, true, true, false}, {2, 3});
+    auto [packed, count] = masked_select(a, mask);
+    CHECK_EQ(packed.shape(), Shape{6});
+    CHECK_EQ(count.item<uint32_t>(), 3);
+    CHECK(array_equal(packed, array({2.0f, 4.0f, 5.0f, 0.0f, 0.0f, 0.0f}))
+              .item<bool>());
+  }
+
+  // Nothing selected and everything selected
+  {
+    auto [packed, count] = masked_select(a, full({2, 3}, false));
+    CHECK_EQ(count.item<uint32_t>(), 0);
+    CHECK(array_equal(packed, zeros({6})).item<bool>());
+
+    auto [all, all_count] = masked_select(a, full({2, 3}, true));
+    CHECK_EQ(all_count.item<uint32_t>(), 6);
+    CHECK(array_equal(all, flatten(a)).item<bool>());
+  }
+
+  // The mask broadcasts against the input
+  {
+    auto [packed, count] = masked_select(a, array({true, false, true}));
+    CHECK_EQ(count.item<uint32_t>(), 4);
+    auto expected = array({1.0f, 3.0f, 4.0f, 6.0f, 0.0f, 0.0f});
+    CHECK(array_equal(packed, expected).item<bool>());
+  }
+
+  // Non-contiguous input packs in flattened row-major order
+  {
+    auto at = transpose(a);
+    auto [packed, count] = masked_select(at, full({3, 2}, true));
+    CHECK_EQ(count.item<uint32_t>(), 6);
+    auto expected = array({1.0f, 4.0f, 2.0f, 5.0f, 3.0f, 6.0f});
+    CHECK(array_equal(packed, expected).item<bool>());
+  }
+
+  CHECK_THROWS(masked_select(a, astype(a, int32)));
+
+  {
+    auto x = array({0, 3, 0, 2, 0, 1}, int32);
+    auto [indices, count] = nonzero(x);
+    CHECK_EQ(count.item<uint32_t>(), 3);
+    CHECK(array_equal(indices, array({1, 3, 5, 0, 0, 0}, uint32))
+              .item<bool>());
+  }
+
+  // No nonzeros
+  {
+    auto [indices, count] = nonzero(zeros({4}, int32));
+    CHECK_EQ(count.item<uint32_t>(), 0);
+    CHECK(array_equal(indices, zeros({4}, uint32)).item<bool>());
+  }
+
+  // Indices follow the flattened row-major order of a transposed view
+  {
+    auto x = transpose(array({1, 0, 0, 2}, {2, 2}));
+    auto [indices, count] = nonzero(x);
+    CHECK_EQ(count.item<uint32_t>(), 2);
+    CHECK(array_equal(
+              slice(indices, {0}, {2}), array({0, 3}, uint32))
+              .item<bool>());
+  }
+}
+
+TEST_CASE("test sparse matmul") {
+  // CSR matmul agrees with the dense product on random sparsity patterns
+  {
+    random::seed(11);
+    int M = 17;
+    int K = 23;
+    int N = 9;
+    auto dense = where(
+        less(random::uniform({M, K}), array(0.3f)),
+        random::uniform(-1.0, 1.0, {M, K}),
+        zeros({M, K}));
+    // Force a few empty rows
+    dense = multiply(
+        dense,
+        expand_dims(
+            astype(not_equal(remainder(arange(M), array(5)), array(0)), float32),
+            1));
+    auto b = random::uniform(-1.0, 1.0, {K, N});
+    eval(dense, b);
+
+    auto csr = dense_to_csr(dense);
+    auto out = sparse_matmul(csr[0], csr[1], csr[2], b);
+    CHECK(allclose(out, matmul(dense, b), 1e-5, 1e-6).item<bool>());
+  }
+
+  // A matrix with no nonzeros has all-empty rows
+  {
+    auto dense = zeros({3, 4});
+    auto b = ones({4, 2});
+    auto csr = dense_to_csr(dense);
+    CHECK_EQ(csr[1].size(), 0);
+    auto out = sparse_matmul(csr[0], csr[1], csr[2], b);
+    CHECK(array_equal(out, zeros({3, 2})).item<bool>());
+  }
+
+  // indptr and indices must be int32
+  {
+    auto dense = eye(3);
+    auto csr = dense_to_csr(dense);
+    CHECK_THROWS(
+        sparse_matmul(astype(csr[0], int64), csr[1], csr[2], eye(3)));
+  }
+}
+
+TEST_CASE("test fused optimizer updates") {
+  random::seed(17);
+  float lr = 0.1f;
+
+  // Mixed dtypes and shapes so the updates batch into multiple groups
+  std::vector<array> params = {
+      random::uniform(-1.0, 1.0, {4, 3}),
+      astype(random::uniform(-1.0, 1.0, {7}), float16),
+      random::uniform(-1.0, 1.0, {2, 2, 5})};
+  std::vector<array> grads;
+  for (auto& p : params) {
+    grads.push_back(astype(random::uniform(-1.0, 1.0, p.shape()), p.dtype()));
+  }
+
+  {
+    auto updated = fast::sgd_update(params, grads, lr);
+    REQUIRE_EQ(updated.size(), params.size());
+    for (int i = 0; i < params.size(); ++i) {
+      auto lr_s = array(lr, params[i].dtype());
+      auto expected = subtract(params[i], multiply(lr_s, grads[i]));
+      CHECK_EQ(updated[i].dtype(), params[i].dtype());
+      double tol = params[i].dtype() == float16 ? 1e-2 : 1e-5;
+      CHECK(allclose(updated[i], expected, tol, tol).item<bool>());
+    }
+  }
+
+  {
+    float b1 = 0.9f;
+    float b2 = 0.999f;
+    float eps = 1e-8f;
+    std::vector<array> m;
+    std::vector<array> v;
+    for (auto& p : params) {
+      m.push_back(astype(random::uniform(-1.0, 1.0, p.shape()), p.dtype()));
+      v.push_back(astype(random::uniform(0.0, 1.0, p.shape()), p.dtype()));
+    }
+    auto updated = fast::adam_update(params, grads, m, v, lr, b1, b2, eps);
+    REQUIRE_EQ(updated.size(), 3 * params.size());
+    for (int i = 0; i < params.size(); ++i) {
+      auto dt = params[i].dtype();
+      auto g = grads[i];
+      auto m2 = add(
+          multiply(array(b1, dt), m[i]),
+          multiply(array(1.0f - b1, dt), g));
+      auto v2 = add(
+          multiply(array(b2, dt), v[i]),
+          multiply(array(1.0f - b2, dt), square(g)));
+      auto p2 = subtract(
+          params[i],
+          divide(
+              multiply(array(lr, dt), m2), add(sqrt(v2), array(eps, dt))));
+      double tol = dt == float16 ? 1e-2 : 1e-5;
+      CHECK(allclose(updated[i], p2, tol, tol).item<bool>());
+      CHECK(allclose(updated[params.size() + i], m2, tol, tol).item<bool>());
+      CHECK(
+          allclose(updated[2 * params.size() + i], v2, tol, tol).item<bool>());
+    }
+  }
+}
+
+TEST_CASE("test fast append") {
+  // Repeated appends match concatenate while growing one step at a time,
+  // crossing several capacity reallocation boundaries
+  {
+    auto cache = zeros({0, 3});
+    auto expected = cache;
+    for (int i = 0; i < 20; ++i) {
+      auto chunk = full({1, 3}, static_cast<float>(i));
+      cache = fast::append(cache, chunk, 0);
+      expected = concatenate({expected, chunk}, 0);
+      eval(cache);
+      CHECK_EQ(cache.shape(), Shape{i + 1, 3});
+      CHECK(array_equal(cache, expected).item<bool>());
+    }
+  }
+
+  // Appending along a middle axis and in larger steps
+  {
+    auto cache = ones({2, 1, 4});
+    auto chunk = full({2, 3, 4}, 2.0f);
+    auto out = fast::append(cache, chunk, 1);
+    CHECK(
+        array_equal(out, concatenate({cache, chunk}, 1)).item<bool>());
+    auto out2 = fast::append(out, chunk, 1);
+    CHECK(array_equal(out2, concatenate({cache, chunk, chunk}, 1))
+              .item<bool>());
+  }
+
+  // Earlier results view their own prefix and are unaffected by growth
+  {
+    auto c0 = full({1, 2}, 1.0f);
+    auto c1 = fast::append(c0, full({1, 2}, 2.0f), 0);
+    eval(c1);
+    auto c2 = c1;
+    for (int i = 0; i < 10; ++i) {
+      c2 = fast::append(c2, full({1, 2}, static_cast<float>(3 + i)), 0);
+      eval(c2);
+    }
+    CHECK(
+        array_equal(c1, array({1.0f, 1.0f, 2.0f, 2.0f}, {2, 2}))
+            .item<bool>());
+    CHECK_EQ(c2.shape(), Shape{12, 2});
+  }
+}
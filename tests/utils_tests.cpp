@@ -65,3 +65,22 @@ TEST_CASE("test iinfo") {
   CHECK_EQ(iinfo(uint64).min, 0);
   CHECK_EQ(iinfo(int64).min, std::numeric_limits<int64_t>::min());
 }
+
+TEST_CASE("test small vector spill counter") {
+  reset_small_vector_spill_count();
+
+  // Inline capacity covers common ranks without touching the heap
+  Shape s{1, 2, 3, 4, 5, 6};
+  Strides st{6, 5, 4, 3, 2, 1};
+  CHECK_EQ(small_vector_spill_count(), 0);
+
+  // Growing past the inline capacity registers a spill
+  Shape big;
+  for (int i = 0; i < 32; ++i) {
+    big.push_back(i);
+  }
+  CHECK(small_vector_spill_count() > 0);
+
+  reset_small_vector_spill_count();
+  CHECK_EQ(small_vector_spill_count(), 0);
+}